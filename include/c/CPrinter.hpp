@@ -1,22 +1,21 @@
 #pragma once
 
-#include <c/ast/CStatement.hpp>
 #include <c/ast/CProgram.hpp>
-#include <c/ast/CType.hpp>
+#include <io/OutputBuffer.hpp>
 
-#include <filesystem/File.hpp>
 
-
-// The parser consumes the output of the scanner and emits the AST components while controlling the parsing context.
+// Prints the C AST as source text.
+//
+// Types are printed with C declarator syntax, and expressions with the parentheses needed by the
+// precedence of their operators, along with those suggested by `-Wparentheses`.
 class CPrinter {
 private:
-    File &_out;
-    String _tab;
+    OutputBuffer &_out;
     u32 _depth = 0;
 public:
 
 
-    CPrinter(File &out) : _out(out), _tab("    ") {}
+    CPrinter(OutputBuffer &out) : _out(out) {}
 
 
     void indent() {
@@ -32,11 +31,7 @@ public:
 
 
     void newline(u32 n = 1) {
-        _out.write('\n', n);
-
-        for (u32 i = 0; i < _depth; i++) {
-            _out.write(_tab);
-        }
+        _out.newline(n, _depth);
     }
 
 
@@ -45,10 +40,21 @@ public:
     }
 
 
-    void print(StringView format, ...);
+    void write(const char *string) {
+        _out.write(string);
+    }
+
+
+    void write(i64 value);
+
 
+    /// Print the declaration of a name with a type, or the type alone if the name is empty.
+    void print_declaration(const CType &type, StringView name);
 
-    void print(const CType &type, const String &name, bool is_reference, bool is_mutable);
+
+    void print_type_name(const CType &type) {
+        print_declaration(type, "");
+    }
 
 
     void print(const CExpression &expression);
@@ -56,8 +62,7 @@ public:
 
     void print(const CStatement &statement);
     void print(const CBlockStatement &statement);
-    void print(const CBreakStatement &statement);
-    void print(const CContinueStatement &statement);
+    void print(const CDeclarationStatement &statement);
     void print(const CDoWhileStatement &statement);
     void print(const CForStatement &statement);
     void print(const CIfStatement &statement);
@@ -69,7 +74,8 @@ public:
     void print(const CVariable &variable);
 
 
-    void print(const CMember &member);
+    /// Print the signature of a function, without a body.
+    void print_function_declaration(const CFunction &function);
 
 
     void print(const CFunction &function);
@@ -78,30 +84,44 @@ public:
     void print(const CEnumerationType &enum_type);
 
 
+    /// Print a `typedef` of the tag of a structure or union to its name, so that it may be referred
+    /// to before its definition.
+    void print_type_declaration(const CBasicType &type);
+
+
     /// @brief Print a structure type definition.
     ///
-    /// Structures have no constructors, destructors, methods, or operators.
-    /// They may be named or anonymous.
-    /// They may be generic (only is not anonymous)
+    /// Structures have no constructors, destructors, methods, or operators. The members are printed
+    /// in order of offset with explicit padding between them, and the size and alignment of the
+    /// structure are checked by static assertions.
     ///
     /// @param structure_type The structure type.
     void print(const CStructureType &structure_type);
 
 
-    void print_type_name(const CType &type) noexcept;
-    void print_type_declaration(const CType &type) noexcept;
-    void print_type_definition(const CType &type) noexcept;
+    void print(const CUnionType &union_type);
 
 
-    void print_structure_type_name(const CStructureType &type) noexcept;
-    void print_structure_type_declaration(const CStructureType &type) noexcept;
-    void print_structure_type_definition(const CStructureType &type) noexcept;
+    /// Print the types, function declarations and function definitions of a translation unit.
+    void print(const CTranslationUnit &translation_unit);
 
 
+private:
 
-    void print(const CUnionType &union_type);
+
+    /// Return the declaration of a name with a type.
+    String declaration_of(const CType &type, StringView name);
+
+
+    /// Print an expression, in parentheses if its operator has a greater precedence level.
+    void print(const CExpression &expression, u32 precedence);
+
+
+    /// Print the members of an aggregate in order of offset, with explicit padding between them
+    /// and up to the size of the aggregate.
+    void print_members(const CBasicType &type, const std::vector<CMember> &members, bool is_packed);
 
 
-    /// @brief Create all module files in the program hierarchy.
-    void print(const CProgram &program);
+    /// Print static assertions of the size and alignment of a type.
+    void print_layout_assertions(const CBasicType &type);
 };
@@ -7,75 +7,21 @@
 // product of the base type size and the array size.
 class CArrayType : public CDerivedType {
 private:
-    CExpression array_size_;
-    const CType &base_type_;
-    u32 size_;
-    u32 alignment_;
-    bool is_const_;
-    bool is_volatile_;
+    u32 array_size_;
 public:
 
 
     CArrayType(
         const CType &base_type,
-        CExpression array_size,
-        u32 size,
-        u32 alignment,
-        bool is_const,
-        bool is_volatile
+        u32 array_size
     ) :
-        array_size_(array_size),
-        base_type_(base_type),
-        size_(size),
-        alignment_(alignment),
-        is_const_(is_const),
-        is_volatile_(is_volatile)
-    {
-        // create constructor and destructor
-    }
-
-
-    ~CArrayType() {}
-
-
-    /// \brief Return the size of the type in bytes.
-    u32 size() const {
-        return size_;
-    }
+        CDerivedType(CTypeKind::ARRAY, base_type, {}, base_type.size() * array_size, base_type.alignment()),
+        array_size_(array_size)
+    {}
 
 
-    /// \brief Return the size of the type in bytes.
-    const CExpression &array_size() const {
+    /// \brief Return the number of elements of the array.
+    u32 array_size() const {
         return array_size_;
     }
-
-
-    /// \brief Return the alignment of the type in bytes.
-    u32 alignment() const {
-        return alignment_;
-    }
-
-
-    /// \brief Return true if the type is 'const' qualified.
-    bool is_const() const {
-        return is_const_;
-    }
-
-
-    /// \brief Return true if the type is 'volatile' qualified.
-    bool is_volatile() const {
-        return is_volatile_;
-    }
-
-
-    /// \brief Return the 'const' qualified derivation of the type.
-    const CType &const_qualified_derivation() const {
-        return;
-    }
-
-
-    /// \brief Return the 'volatile' qualified derivation of the type.
-    const CType &volatile_qualified_derivation() const {
-        return;
-    }
 };
@@ -6,29 +6,36 @@
 // A 'Basic Type' is a named type which is a terminal unit of type expressions,
 // upon which, derived types may be declared.
 class CBasicType : public CType {
+private:
+    String _name; // The spelling of the type, such as `int64_t`, or the typedef name of an aggregate
 public:
 
 
-    virtual ~CBasicType() = default;
+    CBasicType(CTypeKind type, StringView name, CTypeFlags flags, u32 size, u32 alignment) noexcept :
+        CType(type, flags, size, alignment),
+        _name(reinterpret_cast<const char *>(name.data()), name.size())
+    {}
 
 
-    virtual const CTypeName &name() const = 0;
+    /// The unqualified `void` type.
+    static const CBasicType VOID;
 
 
-    virtual const CComment &comment() const = 0;
-
-
-    bool has_comment() const {
-        return !comment().text().is_empty();
+    StringView name() const noexcept {
+        return StringView(reinterpret_cast<const u8 *>(_name.data()), _name.size());
     }
 
 
-    bool is_anonymous() const {
-        return name().string().is_empty();
+    bool is_anonymous() const noexcept {
+        return _name.empty();
     }
 };
 
 
+inline const CBasicType CBasicType::VOID(CTypeKind::VOID, "void", {}, 0, 1);
+
+
+#include <c/ast/CIntegerType.hpp>
 #include <c/ast/CEnumerationType.hpp>
 #include <c/ast/CStructureType.hpp>
 #include <c/ast/CUnionType.hpp>
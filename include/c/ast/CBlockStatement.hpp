@@ -2,10 +2,13 @@
 
 #include <c/ast/CStatement.hpp>
 
+#include <memory>
+#include <vector>
+
 
 class CBlockStatement : public CStatement {
 private:
-    Vector<CStatement *> statements_;
+    std::vector<std::unique_ptr<CStatement>> statements_;
 public:
 
 
@@ -17,17 +20,28 @@ public:
     }
 
 
-    Vector<CStatement *> &statements() {
+    bool is_empty() const {
+        return statements_.empty();
+    }
+
+
+    const std::vector<std::unique_ptr<CStatement>> &statements() const {
         return statements_;
     }
 
 
-    bool is_deterministic() const {
-        return false;
+    /// Construct a statement at the end of the block and return it.
+    template<class T, class... Args>
+    T &append(Args &&...args) {
+        statements_.push_back(std::make_unique<T>(std::forward<Args>(args)...));
+        return static_cast<T &>(*statements_.back());
     }
 
 
-    const Vector<CStatement *> &statements() const {
-        return statements_;
+    /// Construct a statement at the start of the block and return it.
+    template<class T, class... Args>
+    T &prepend(Args &&...args) {
+        statements_.insert(statements_.begin(), std::make_unique<T>(std::forward<Args>(args)...));
+        return static_cast<T &>(*statements_.front());
     }
 };
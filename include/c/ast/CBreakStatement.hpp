@@ -4,25 +4,13 @@
 
 
 class CBreakStatement : public CStatement {
-private:
-    u32 depth_;
 public:
 
 
-    CBreakStatement(u32 depth) : depth_(depth) {}
+    CBreakStatement() {}
 
 
     CStatementType statement_type() const {
         return CStatementType::BREAK;
     }
-
-
-    bool is_deterministic() const {
-        return false;
-    }
-
-
-    u32 depth() const {
-        return depth_;
-    }
 };
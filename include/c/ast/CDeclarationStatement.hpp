@@ -0,0 +1,29 @@
+#pragma once
+
+#include <c/ast/CStatement.hpp>
+#include <c/ast/CVariable.hpp>
+
+
+// $type $name = $initializer;
+class CDeclarationStatement : public CStatement {
+private:
+    CVariable variable_;
+public:
+
+
+    CDeclarationStatement(
+        CVariable variable
+    ) :
+        variable_(std::move(variable))
+    {}
+
+
+    CStatementType statement_type() const {
+        return CStatementType::DECLARATION;
+    }
+
+
+    const CVariable &variable() const {
+        return variable_;
+    }
+};
@@ -1,17 +1,29 @@
 #pragma once
 
-#include <c/ast/CExpression.hpp>
-#include <c/ast/CStatement.hpp>
 #include <c/ast/CType.hpp>
 
 
 // A 'Derived Type' is an anonymous type which builds upon another Basic or
 // Derived type.
 class CDerivedType : public CType {
+private:
+    const CType &_base_type;
+protected:
+
+
+    CDerivedType(CTypeKind type, const CType &base_type, CTypeFlags flags, u32 size, u32 alignment) noexcept :
+        CType(type, flags, size, alignment),
+        _base_type(base_type)
+    {}
+
+
 public:
 
 
-    virtual ~CDerivedType() = default;
+    /// The type pointed to, the element type of an array or the return type of a function.
+    const CType &base_type() const noexcept {
+        return _base_type;
+    }
 };
 
 
@@ -1,28 +1,23 @@
 #pragma once
 
+#include <c/ast/CBlockStatement.hpp>
 #include <c/ast/CExpression.hpp>
-#include <c/ast/CStatement.hpp>
 
 
 // A 'do-while' statement is a structured unit of conditional execution.
 //
-// do $statement while ($condition) while_block
+// do $block while ($condition);
 class CDoWhileStatement : public CStatement {
 private:
-    CBlockStatement *do_block_;
-    CBlockStatement *while_block_;
-    CExpression *condition_;
+    CBlockStatement block_;
+    CExpression condition_;
 public:
 
 
     CDoWhileStatement(
-        CExpression &condition,
-        CBlockStatement &do_block,
-        CBlockStatement &while_block
+        CExpression condition
     ) :
-        do_block_(&do_block),
-        while_block_(&while_block),
-        condition_(&condition)
+        condition_(std::move(condition))
     {}
 
 
@@ -31,15 +26,7 @@ public:
     }
 
 
-    bool is_deterministic() const {
-        return false;
-    }
-
-
-    CBlockStatement &do_block() { return *do_block_; }
-    const CBlockStatement &do_block() const { return *do_block_; }
-    CBlockStatement &while_block() { return *while_block_; }
-    const CBlockStatement &while_block() const { return *while_block_; }
-    CExpression &condition() { return *condition_; }
-    const CExpression &condition() const { return *condition_; }
+    CBlockStatement &block() { return block_; }
+    const CBlockStatement &block() const { return block_; }
+    const CExpression &condition() const { return condition_; }
 };
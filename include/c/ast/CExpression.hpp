@@ -4,26 +4,51 @@
 #include <c/ast/COperator.hpp>
 #include <c/ast/CType.hpp>
 
+#include <vector>
+
 
 // An expression is a structured unit of evaluation.
+//
+// Identifiers and literals are terminal expressions holding their text. The operands of an operator
+// are its terms, with the callee followed by the arguments for calls. An empty expression stands
+// for an omitted one, such as the value of `return;`.
 struct CExpression : public CStatement {
 protected:
-    Vector<CExpression> terms_; // The terms of the expression
-    const COperator &op_;          // The operator of the expression
-    bool is_deterministic_ = false; // If true, the expression is deterministic
+    std::vector<CExpression> terms_;  // The terms of the expression
+    const COperator *op_ = nullptr;   // The operator of the expression, or null if terminal
+    const CType *type_ = nullptr;     // The type of a cast
+    String text_;                     // The identifier or literal
 public:
 
 
+    CExpression() {}
+
+
     CExpression(
-        const COperator &op
+        StringView text
     ) :
-        op_(op)
+        text_(reinterpret_cast<const char *>(text.data()), text.size())
     {}
-public:
 
 
-    const CType &type() const {
-        return op_.type();
+    CExpression(
+        const COperator &op,
+        std::vector<CExpression> terms
+    ) :
+        terms_(std::move(terms)),
+        op_(&op)
+    {}
+
+
+    /// Create a cast of an expression to a type.
+    CExpression(
+        const CType &type,
+        CExpression term
+    ) :
+        op_(&COperator::CAST),
+        type_(&type)
+    {
+        terms_.push_back(std::move(term));
     }
 
 
@@ -32,17 +57,45 @@ public:
     }
 
 
-    bool is_deterministic() const {
-        return is_deterministic_;
+    bool is_empty() const {
+        return op_ == nullptr && text_.empty();
     }
 
 
-    const CExpression &reduce() const {
-        return *this;
+    bool is_terminal() const {
+        return op_ == nullptr;
     }
 
 
-    const CExpression &evaluate() const {
-        return *this;
+    const COperator &op() const {
+        return *op_;
+    }
+
+
+    const std::vector<CExpression> &terms() const {
+        return terms_;
+    }
+
+
+    const CType &type() const {
+        return *type_;
+    }
+
+
+    StringView text() const {
+        return StringView(reinterpret_cast<const u8 *>(text_.data()), text_.size());
     }
 };
+
+
+#include <c/ast/CBlockStatement.hpp>
+#include <c/ast/CBreakStatement.hpp>
+#include <c/ast/CContinueStatement.hpp>
+#include <c/ast/CDeclarationStatement.hpp>
+#include <c/ast/CDoWhileStatement.hpp>
+#include <c/ast/CForStatement.hpp>
+#include <c/ast/CGotoStatement.hpp>
+#include <c/ast/CIfStatement.hpp>
+#include <c/ast/CSwitchStatement.hpp>
+#include <c/ast/CReturnStatement.hpp>
+#include <c/ast/CWhileStatement.hpp>
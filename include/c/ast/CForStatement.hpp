@@ -1,28 +1,29 @@
 #pragma once
 
+#include <c/ast/CBlockStatement.hpp>
 #include <c/ast/CExpression.hpp>
-#include <c/ast/CStatement.hpp>
 
 
+// for ($initializer; $condition; $expression) $block
+//
+// Any of the initializer, condition and expression may be empty.
 class CForStatement : public CStatement {
 private:
-    CStatement &statement_;
-    CBlockStatement &block_;
-    CExpression &expression_;
-    CExpression &condition_;
+    CExpression initializer_;
+    CExpression condition_;
+    CExpression expression_;
+    CBlockStatement block_;
 public:
 
 
     CForStatement(
-        CExpression &expression,
-        CExpression &condition,
-        CStatement &statement,
-        CBlockStatement &block
+        CExpression initializer,
+        CExpression condition,
+        CExpression expression
     ) :
-        statement_(statement),
-        condition_(condition),
-        block_(block),
-        expression_(expression)
+        initializer_(std::move(initializer)),
+        condition_(std::move(condition)),
+        expression_(std::move(expression))
     {}
 
 
@@ -31,18 +32,18 @@ public:
     }
 
 
-    bool is_deterministic() const {
-        return false;
+    const CExpression &initializer() const {
+        return initializer_;
     }
 
 
-    CStatement &statement() {
-        return statement_;
+    const CExpression &condition() const {
+        return condition_;
     }
 
 
-    const CStatement &statement() const {
-        return statement_;
+    const CExpression &expression() const {
+        return expression_;
     }
 
 
@@ -54,14 +55,4 @@ public:
     const CBlockStatement &block() const {
         return block_;
     }
-
-
-    CExpression &expression() {
-        return expression_;
-    }
-
-
-    const CExpression &expression() const {
-        return expression_;
-    }
 };
@@ -1,89 +1,84 @@
 #pragma once
 
-#include <c/ast/CType.hpp>
+#include <c/ast/CStatement.hpp>
+#include <c/ast/CVariable.hpp>
 
+#include <vector>
 
-class CFunctionParameter : public CVariable {
+
+/// @brief An `CFunction` is a block statement associated with a name, a return type and parameters.
+///
+/// External functions are defined in another translation unit and only declared.
+class CFunction {
+private:
+    String name_;
+    const CType *return_type_;
+    std::vector<CVariable> parameters_;
+    CBlockStatement body_;
+    bool is_static_;
+    bool is_inline_;
+    bool is_external_;
 public:
-    const CType &type_;
-    const CToken *name_;
-    CExpression *default_value_;
 
 
-    CFunctionParameter(
-        const CType &type,
-        const CToken *name,
-        CExpression *default_value
+    CFunction(
+        StringView name,
+        const CType &return_type,
+        bool is_static,
+        bool is_inline,
+        bool is_external = false
     ) :
-        type_(type),
-        name_(name),
-        default_value_(default_value)
+        name_(reinterpret_cast<const char *>(name.data()), name.size()),
+        return_type_(&return_type),
+        is_static_(is_static),
+        is_inline_(is_inline),
+        is_external_(is_external)
     {}
 
 
-    bool has_name() const {
-        return name_ != nullptr;
+    // The function name
+    StringView name() const {
+        return StringView(reinterpret_cast<const u8 *>(name_.data()), name_.size());
     }
 
 
-    bool has_default_value() const {
-        return default_value_ != nullptr;
+    const CType &return_type() const {
+        return *return_type_;
     }
 
 
-    const CToken &name() const {
-        return *name_;
+    const std::vector<CVariable> &parameters() const {
+        return parameters_;
     }
 
 
-    const CType &type() const {
-        return type_;
+    CBlockStatement &body() {
+        return body_;
     }
 
 
-    const CExpression &default_value() const {
-        return *default_value_;
+    const CBlockStatement &body() const {
+        return body_;
     }
 
 
-    CExpression &default_value() {
-        return *default_value_;
+    // The function has internal linkage
+    bool is_static() const {
+        return is_static_;
     }
 
 
-    void set_default_value(CExpression &expression) {
-        default_value_ = &expression;
+    bool is_inline() const {
+        return is_inline_;
     }
-};
-
-
-class CFunctionParameterList {
-public:
-    Vector<CFunctionParameter> parameters_;
-};
-
-
-/// @brief An `CFunction` is an `CStatement` object associated with a name and an `CFunctionType`.
-class CFunction {
-public:
-
-
-    virtual ~CFunction() = default;
-
-
-    // The comment associated with the variable
-    virtual const CComment &comment() const = 0;
 
 
-    // The variable name
-    virtual const CToken &name() const = 0;
-
-
-    // The variable type
-    virtual const CFunctionType &type() const = 0;
+    bool is_external() const {
+        return is_external_;
+    }
 
 
-    // The temporary sequence of tokens that make the definition
-    virtual const List<const CToken *> &tokens() const = 0;
+    void add_parameter(const CType &type, StringView name) {
+        parameters_.emplace_back(type, name);
+    }
 };
-
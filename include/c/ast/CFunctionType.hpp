@@ -1,21 +1,33 @@
 #pragma once
 
-#include <c/ast/CVariable.hpp>
 #include <c/ast/CDerivedType.hpp>
 
+#include <vector>
 
+
+// The base type of a function type is its return type. Function types are only used through
+// pointers.
 class CFunctionType : public CDerivedType {
+private:
+    std::vector<const CType *> parameter_types_;
 public:
 
 
-    virtual ~CFunctionType() = default;
-
-
-    virtual const Vector<CVariable> parameters() const = 0;
+    CFunctionType(
+        const CType &return_type,
+        std::vector<const CType *> parameter_types
+    ) :
+        CDerivedType(CTypeKind::FUNCTION, return_type, {}, 0, 1),
+        parameter_types_(std::move(parameter_types))
+    {}
 
 
-    virtual const CBlockStatement &statement() const = 0;
+    const CType &return_type() const {
+        return base_type();
+    }
 
 
-    virtual const CExpression &expression() const = 0;
+    const std::vector<const CType *> &parameter_types() const {
+        return parameter_types_;
+    }
 };
@@ -3,13 +3,14 @@
 #include <c/ast/CStatement.hpp>
 
 
+// goto $label;
 class CGotoStatement : public CStatement {
 private:
-    u32 depth_;
+    String label_;
 public:
 
 
-    CGotoStatement(u32 depth) : depth_(depth) {}
+    CGotoStatement(StringView label) : label_(reinterpret_cast<const char *>(label.data()), label.size()) {}
 
 
     CStatementType statement_type() const {
@@ -17,12 +18,28 @@ public:
     }
 
 
-    bool is_deterministic() const {
-        return false;
+    StringView label() const {
+        return StringView(reinterpret_cast<const u8 *>(label_.data()), label_.size());
+    }
+};
+
+
+// $label:
+class CLabelStatement : public CStatement {
+private:
+    String label_;
+public:
+
+
+    CLabelStatement(StringView label) : label_(reinterpret_cast<const char *>(label.data()), label.size()) {}
+
+
+    CStatementType statement_type() const {
+        return CStatementType::LABEL;
     }
 
 
-    u32 depth() const {
-        return depth_;
+    StringView label() const {
+        return StringView(reinterpret_cast<const u8 *>(label_.data()), label_.size());
     }
 };
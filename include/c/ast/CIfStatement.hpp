@@ -1,15 +1,16 @@
 #pragma once
 
+#include <c/ast/CBlockStatement.hpp>
 #include <c/ast/CExpression.hpp>
-#include <c/ast/CStatement.hpp>
 
 
 // An 'if' statement is a structured unit of conditional execution.
 //
-// if ($condition) $statement else $else_statement
+// if ($condition) $if_block else $else_block
+//
+// The else block is omitted if it is empty.
 class CIfStatement : public CStatement {
 private:
-    CStatement &init_statement_;
     CExpression condition_;
     CBlockStatement if_block_;
     CBlockStatement else_block_;
@@ -17,15 +18,9 @@ public:
 
 
     CIfStatement(
-        CStatement &init_statement,
-        CExpression condition,
-        CBlockStatement if_block,
-        CBlockStatement else_block
+        CExpression condition
     ) :
-        init_statement_(init_statement),
-        condition_(condition),
-        if_block_(if_block),
-        else_block_(else_block)
+        condition_(std::move(condition))
     {}
 
 
@@ -34,13 +29,13 @@ public:
     }
 
 
-    bool is_deterministic() const {
-        return false;
+    const CExpression &condition() const {
+        return condition_;
     }
 
 
-    const CExpression &condition() const {
-        return condition_;
+    CBlockStatement &if_block() {
+        return if_block_;
     }
 
 
@@ -49,6 +44,11 @@ public:
     }
 
 
+    CBlockStatement &else_block() {
+        return else_block_;
+    }
+
+
     const CBlockStatement &else_block() const {
         return else_block_;
     }
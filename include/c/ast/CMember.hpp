@@ -0,0 +1,15 @@
+#pragma once
+
+#include <core/Common.hpp>
+#include <core/String.hpp>
+
+
+class CType;
+
+
+/// A member of a structure or union, at a fixed offset.
+struct CMember {
+    String name;
+    const CType *type;
+    u32 offset; // The offset of the member in bytes
+};
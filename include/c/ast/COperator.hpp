@@ -1,10 +1,10 @@
 #pragma once
 
-#include <c/ast/CToken.hpp>
+#include <core/Common.hpp>
 
 
+/// An operator of C expressions, with its precedence level in the C grammar.
 struct COperator {
-    static const COperator SCOPE; // _::_
     static const COperator INC; // _++
     static const COperator DEC; // _--
     static const COperator CALL; // _(_)
@@ -27,7 +27,6 @@ struct COperator {
     static const COperator SUB; // _-_
     static const COperator LSL; // _<<_
     static const COperator ASR; // _>>_
-    static const COperator LSR; // _>>>_
     static const COperator LES; // _<_
     static const COperator GTR; // _>_
     static const COperator LEQ; // _<=_
@@ -38,35 +37,29 @@ struct COperator {
     static const COperator XOR; // _^_
     static const COperator OR; // _|_
     static const COperator LAND; // _&&_
-    static const COperator LXOR; // _^^_
     static const COperator LOR; // _||_
+    static const COperator TERNARY; // _?_:_
     static const COperator SET; // _=_
     static const COperator MUL_SET; // _*=_
     static const COperator DIV_SET; // _/=_
     static const COperator MOD_SET; // _%=_
     static const COperator ADD_SET; // _+=_
     static const COperator SUB_SET; // _-=_
-    static const COperator LSL_SET; // _>>=_
-    static const COperator ASR_SET; // _<<=_
-    static const COperator LSR_SET; // _>>>=_
+    static const COperator LSL_SET; // _<<=_
+    static const COperator ASR_SET; // _>>=_
     static const COperator AND_SET; // _&=_
     static const COperator XOR_SET; // _^=_
     static const COperator OR_SET; // _|=_
-    static const COperator TERNARY; // _?_:_
     static const COperator COMMA; // _,_
 
-    const CToken &name; // The operator name
-    const u32 lbp;       // The left hand operand binding power
-    const u32 rbp;       // The right hand operand binding power
+    const char *name; // The operator spelling
+    const u8 precedence; // From 1 for postfix operators to 15 for the comma operator
+    const u8 arity;      // The number of operands
+    const bool is_right_associative;
 
 
-    COperator(
-        const CToken &name,
-        u32 lbp,
-        u32 rbp
-    ) :
-        name(name),
-        lbp(lbp),
-        rbp(rbp)
-    {}
+    /// Return true if the operator is written after its only operand.
+    bool is_postfix() const noexcept {
+        return arity == 1 && precedence == 1;
+    }
 };
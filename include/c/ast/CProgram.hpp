@@ -1,42 +1,36 @@
 #pragma once
 
-#include <c/ast/CFunction.hpp>
+#include <c/ast/CTranslationUnit.hpp>
 
 
 /// @brief A Program is an executable without a platform.
-/// It lists dependencies and has a startup and a main function.
+/// It has one translation unit per module.
 class CProgram {
 private:
     String name_;
-    List<CImport> imports_;
-    CFunction startup_function_;
-    CFunction main_function_;
+    std::vector<std::unique_ptr<CTranslationUnit>> translation_units_;
 public:
 
 
     CProgram(
         StringView name
     ) :
-        name_(name)
-    {
-        //add_builtins()
-    }
+        name_(reinterpret_cast<const char *>(name.data()), name.size())
+    {}
 
 
-    void export_source(const Path &path) {
+    StringView name() const {
+        return StringView(reinterpret_cast<const u8 *>(name_.data()), name_.size());
+    }
 
-        // Write module dependencies.
-        //for (CModule &mod : scope.modules) {
-        //    mod.save(obj);
-        //}
 
-        // Write types.
+    const std::vector<std::unique_ptr<CTranslationUnit>> &translation_units() const {
+        return translation_units_;
+    }
 
-        // Write identifiers.
 
-        // Write data.
-        //for (const String &line : obj) {
-            //
-        //}
+    CTranslationUnit &add_translation_unit(StringView name) {
+        translation_units_.push_back(std::make_unique<CTranslationUnit>(name));
+        return *translation_units_.back();
     }
 };
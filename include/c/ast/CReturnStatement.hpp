@@ -1,7 +1,6 @@
 #pragma once
 
 #include <c/ast/CExpression.hpp>
-#include <c/ast/CStatement.hpp>
 
 
 // return $value;
@@ -12,9 +11,9 @@ public:
 
 
     CReturnStatement(
-        CExpression value
+        CExpression value = {}
     ) :
-        value_(value)
+        value_(std::move(value))
     {}
 
 
@@ -23,11 +22,6 @@ public:
     }
 
 
-    bool is_deterministic() const {
-        return false;
-    }
-
-
     const CExpression &value() const {
         return value_;
     }
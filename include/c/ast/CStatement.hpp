@@ -1,17 +1,19 @@
 #pragma once
 
-#include <c/ast/CToken.hpp>
+#include <core/Common.hpp>
 
 
 enum class CStatementType : u8 {
     BLOCK,
     BREAK,
     CONTINUE,
+    DECLARATION,
     DO_WHILE,
     EXPRESSION,
     FOR,
     GOTO,
     IF,
+    LABEL,
     SWITCH,
     RETURN,
     WHILE,
@@ -27,19 +29,8 @@ public:
 
 
     virtual CStatementType statement_type() const = 0;
-
-
-    virtual bool is_deterministic() const = 0;
 };
 
 
-#include <c/ast/CBlockStatement.hpp>
-#include <c/ast/CBreakStatement.hpp>
-#include <c/ast/CContinueStatement.hpp>
-#include <c/ast/CDoWhileStatement.hpp>
-#include <c/ast/CForStatement.hpp>
-#include <c/ast/CGotoStatement.hpp>
-#include <c/ast/CIfStatement.hpp>
-#include <c/ast/CSwitchStatement.hpp>
-#include <c/ast/CReturnStatement.hpp>
-#include <c/ast/CWhileStatement.hpp>
+// Expressions are statements, and the other statements contain expressions.
+#include <c/ast/CExpression.hpp>
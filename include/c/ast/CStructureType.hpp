@@ -1,90 +1,44 @@
 #pragma once
 
 #include <c/ast/CBasicType.hpp>
+#include <c/ast/CMember.hpp>
+
+#include <vector>
 
 
 // Not a class. A data container only. no methods, no properties, no shared.
+//
+// The layout of the structure is fixed by its source language: members are at the given offsets,
+// which need not be in declaration order, and the size and alignment include any padding.
 class CStructureType : public CBasicType {
 private:
-    Vector<CType> derivations_; // The derived types
-    Vector<CMember *> members_; // Members
-    const CTypeName &name_;     // The type identifier sequence (TODO)
-    const CComment &comment_;   // The type documentation comment
-    u32 size_;             // The type size in bytes
-    u32 alignment_;        // The type alignment in bytes
-    const bool is_const_;        // The type mutability. Memory may not be modified through this type
-    const bool is_volatile_;     // The type volatility. Memory may be modified outside of the program
+    std::vector<CMember> members_; // Members, in order of offset
 public:
 
 
     CStructureType(
-        const CTypeName &name,
-        const CComment &comment,
-        bool is_const,
-        bool is_volatile
+        StringView name,
+        u32 size,
+        u32 alignment,
+        CTypeFlags flags = {}
     ) :
-        name_(name),
-        comment_(comment),
-        is_const_(is_const),
-        is_volatile_(is_volatile)
-    {
-        size_ = 0;
-        alignment_ = 0;
-
-        for (CMember *member : members_) {
-            size_ = std::max(size_, member->size());
-            alignment_ = std::max(alignment_, member->size());
-        }
-    }
-
-
-    const CTypeName &name() const {
-        return name_;
-    }
-
-
-    const CComment &comment() const {
-        return comment_;
-    }
-
-
-    /// \brief Return the size of the type in bytes.
-    u32 size() const {
-        return size_;
-    }
-
-
-    /// \brief Return the alignment of the type in bytes.
-    u32 alignment() const {
-        return alignment_;
-    }
-
-
-    /// \brief Return true if the type is 'const' qualified.
-    bool is_const() const {
-        return is_const_;
-    }
-
-
-    /// \brief Return true if the type is 'volatile' qualified.
-    bool is_volatile() const {
-        return is_volatile_;
-    }
+        CBasicType(CTypeKind::STRUCTURE, name, flags, size, alignment)
+    {}
 
 
-    const Vector<CMember *> &members() const {
+    const std::vector<CMember> &members() const {
         return members_;
     }
 
 
-    /// \brief Return the 'const' qualified derivation of the type.
-    const CType &const_qualified_derivation() const {
-        return;
-    }
+    /// Add a member, keeping the members in order of offset.
+    void add_member(StringView name, const CType &type, u32 offset) {
+        auto it = members_.end();
 
+        while (it != members_.begin() && (it - 1)->offset > offset) {
+            --it;
+        }
 
-    /// \brief Return the 'volatile' qualified derivation of the type.
-    const CType &volatile_qualified_derivation() const {
-        return;
+        members_.insert(it, {String(reinterpret_cast<const char *>(name.data()), name.size()), &type, offset});
     }
 };
@@ -1,26 +1,46 @@
 #pragma once
 
+#include <c/ast/CBlockStatement.hpp>
 #include <c/ast/CExpression.hpp>
-#include <c/ast/CStatement.hpp>
 
 
+// case $value: $block
+//
+// The `default` case has an empty value.
 struct CWhenStatement {
-    CExpression &condition;
-    CStatement &statement;
+    CExpression value;
+    CBlockStatement block;
 };
 
 
 class CSwitchStatement : public CStatement {
 private:
-    Vector<CWhenStatement> cases_;
-    CExpression &expression_;
+    std::vector<CWhenStatement> cases_;
+    CExpression expression_;
 public:
 
 
-    CSwitchStatement(CExpression &expression) : expression_(expression) {}
+    CSwitchStatement(CExpression expression) : expression_(std::move(expression)) {}
 
 
     CStatementType statement_type() const {
         return CStatementType::SWITCH;
     }
+
+
+    const CExpression &expression() const {
+        return expression_;
+    }
+
+
+    const std::vector<CWhenStatement> &cases() const {
+        return cases_;
+    }
+
+
+    /// Add a case and return its block. The block should end with a `break` unless it falls through.
+    CBlockStatement &add_case(CExpression value) {
+        cases_.push_back({std::move(value), {}});
+        return cases_.back().block;
+    }
 };
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <c/ast/CFunction.hpp>
+#include <c/ast/CType.hpp>
+
+#include <memory>
+#include <vector>
+
+
+/// A translation unit is the C source file of one module.
+///
+/// It owns the types used by its declarations. Types are kept in order of creation, so a type
+/// created from its members is defined after them.
+class CTranslationUnit {
+private:
+    String name_;
+    std::vector<String> includes_;
+    std::vector<std::unique_ptr<CType>> types_;
+    std::vector<std::unique_ptr<CFunction>> functions_;
+public:
+
+
+    CTranslationUnit(
+        StringView name
+    ) :
+        name_(reinterpret_cast<const char *>(name.data()), name.size())
+    {}
+
+
+    StringView name() const {
+        return StringView(reinterpret_cast<const u8 *>(name_.data()), name_.size());
+    }
+
+
+    /// The system headers included by the unit, such as `stdint.h`.
+    const std::vector<String> &includes() const {
+        return includes_;
+    }
+
+
+    const std::vector<std::unique_ptr<CType>> &types() const {
+        return types_;
+    }
+
+
+    const std::vector<std::unique_ptr<CFunction>> &functions() const {
+        return functions_;
+    }
+
+
+    void add_include(StringView header) {
+        includes_.emplace_back(reinterpret_cast<const char *>(header.data()), header.size());
+    }
+
+
+    /// Construct a type owned by the unit and return it.
+    template<class T, class... Args>
+    T &add_type(Args &&...args) {
+        types_.push_back(std::make_unique<T>(std::forward<Args>(args)...));
+        return static_cast<T &>(*types_.back());
+    }
+
+
+    template<class... Args>
+    CFunction &add_function(Args &&...args) {
+        functions_.push_back(std::make_unique<CFunction>(std::forward<Args>(args)...));
+        return *functions_.back();
+    }
+};
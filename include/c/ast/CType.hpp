@@ -1,9 +1,8 @@
 #pragma once
 
-#include <c/ast/CComment.hpp>
-#include <c/ast/COperator.hpp>
-#include <c/ast/CFunction.hpp>
-#include <c/ast/CVariable.hpp>
+#include <core/Common.hpp>
+#include <core/Enum.hpp>
+#include <core/String.hpp>
 
 
 /*
@@ -29,22 +28,16 @@ char *[7]*()**[8][] foo;
 */
 
 
-
-
-
-
-#include <core/Enum.hpp>
-
-
 template<class CTypeKind>
 struct CTypeKindValues {
     static constexpr CTypeKind VOID{0};
-    static constexpr CTypeKind ARRAY{1};
-    static constexpr CTypeKind FUNCTION{2};
-    static constexpr CTypeKind POINTER{3};
-    static constexpr CTypeKind STRUCTURE{4};
-    static constexpr CTypeKind UNION{5};
-    static constexpr CTypeKind ENUMERATION{6};
+    static constexpr CTypeKind INTEGER{1};
+    static constexpr CTypeKind ENUMERATION{2};
+    static constexpr CTypeKind STRUCTURE{3};
+    static constexpr CTypeKind UNION{4};
+    static constexpr CTypeKind ARRAY{5};
+    static constexpr CTypeKind FUNCTION{6};
+    static constexpr CTypeKind POINTER{7};
 };
 
 
@@ -57,107 +50,117 @@ public:
     CTypeKind(u8 id) noexcept : Enum(id) {}
 
 
+    /// Return true if the type is named rather than derived from another type.
     constexpr
-    bool is_basic() noexcept {
-        return _id;
+    bool is_basic() const noexcept {
+        return _id <= UNION;
     }
 
 
     constexpr
-    bool is_derived() noexcept {
-        return _id;
+    bool is_derived() const noexcept {
+        return _id >= ARRAY;
     }
 
 
     constexpr
-    bool is_builtin() noexcept {
-        return _id;
+    bool is_builtin() const noexcept {
+        return _id <= INTEGER;
     }
-};
-
-
-
 
 
+    /// Return true if the type is defined by a `struct` or `union` declaration.
+    constexpr
+    bool is_aggregate() const noexcept {
+        return _id == STRUCTURE || _id == UNION;
+    }
+};
 
 
+/// The qualifiers of one level of a type.
 struct CTypeFlags {
-    u32 is_const : 1;
-    u32 is_volatile : 1;
-    u32 is_safe : 1;
+    u8 is_const : 1 = false;
+    u8 is_volatile : 1 = false;
+    u8 is_restrict : 1 = false; // Only for pointers
 };
 
 
-/// @brief An `CTypeName` consists of a name.
-class CTypeName {
+/// @brief An `CType` is defines the properties of an `CObject`.
+///
+/// Types are owned by their translation unit and referred to by pointer. Qualifiers belong to each
+/// level of a type, so a qualified type is a distinct object from the unqualified type.
+class CType {
 private:
-    const CToken &identifier_;
-public:
+    CTypeKind _type;
+    CTypeFlags _flags;
+    u32 _size;
+    u32 _alignment;
+protected:
 
 
-    CTypeName(
-        const CToken &identifier
-    ) :
-        identifier_(identifier)
+    CType(CTypeKind type, CTypeFlags flags, u32 size, u32 alignment) noexcept :
+        _type(type),
+        _flags(flags),
+        _size(size),
+        _alignment(alignment)
     {}
-};
 
 
-/// @brief An `CType` is defines the properties of an `CObject`.
-class CType {
-    CTypeKind _type;
-protected:
-    static const Vector<CMember *> MEMBERS;
-    static const Vector<COperator *> OPERATORS;
 public:
 
 
     virtual ~CType() = default;
 
 
-    /// @brief Return the size of the type in bytes.
+    /// @brief Return the kind of the type.
     CTypeKind type() const noexcept {
         return _type;
     }
 
 
+    CTypeFlags flags() const noexcept {
+        return _flags;
+    }
+
+
     /// @brief Return the size of the type in bytes.
-    virtual u32 size() const = 0;
+    u32 size() const noexcept {
+        return _size;
+    }
 
 
     /// @brief Return the alignment of the type in bytes.
-    virtual u32 alignment() const = 0;
+    u32 alignment() const noexcept {
+        return _alignment;
+    }
 
 
     /// @brief Return true if the type is 'const' qualified.
-    virtual bool is_const() const = 0;
+    bool is_const() const noexcept {
+        return _flags.is_const;
+    }
 
 
     /// \brief Return true if the type is 'volatile' qualified.
-    virtual bool is_volatile() const = 0;
-
-
-    /// @brief Return the list of member variables defined by the type.
-    virtual const Vector<CMember *> &members() const {
-        return MEMBERS;
+    bool is_volatile() const noexcept {
+        return _flags.is_volatile;
     }
 
 
-    /// @brief Return the list of operators defined by the type.
-    virtual const Vector<COperator *> &operators() const {
-        return OPERATORS;
+    /// \brief Return true if the type is 'restrict' qualified.
+    bool is_restrict() const noexcept {
+        return _flags.is_restrict;
     }
 
 
-    virtual const CScope &shared() const = 0;
-
-
-    /// @brief Return the 'const' qualified derivation of the type.
-    virtual const CType &const_qualified_derivation() const = 0;
+protected:
 
 
-    /// @brief Return the 'volatile' qualified derivation of the type.
-    virtual const CType &volatile_qualified_derivation() const = 0;
+    /// Let derived types complete their layout after their members are known.
+    void set_layout(u32 size, u32 alignment) noexcept {
+        _size = size;
+        _alignment = alignment;
+    }
 };
 
 
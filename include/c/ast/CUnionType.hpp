@@ -1,43 +1,34 @@
 #pragma once
 
 #include <c/ast/CBasicType.hpp>
+#include <c/ast/CMember.hpp>
 
+#include <vector>
 
+
+// The members of a union are all at offset zero.
 class CUnionType : public CBasicType {
 private:
-    Vector<CUnionType *> derivations_; // The derived types
-    Vector<CMember *> members_; // Members
-    const CTypeName &name_;     // The type identifier sequence (TODO)
-    const CComment &comment_;   // The type documentation comment
-    u32 size_;             // The type size in bytes
-    u32 alignment_;        // The type alignment in bytes
-    const bool is_const_;        // The type mutability. Memory may not be modified through this type
-    const bool is_volatile_;     // The type volatility. Memory may be modified outside of the program
+    std::vector<CMember> members_;
 public:
 
 
     CUnionType(
-        const CTypeName &name,
-        Vector<CMember *> members,
-        const CComment &comment,
-        bool is_const,
-        bool is_volatile
+        StringView name,
+        u32 size,
+        u32 alignment,
+        CTypeFlags flags = {}
     ) :
-        name_(name),
-        comment_(comment)
+        CBasicType(CTypeKind::UNION, name, flags, size, alignment)
     {}
 
 
-    ~CUnionType() = default;
-
-
-    const CTypeName &name() const {
-        return name_;
+    const std::vector<CMember> &members() const {
+        return members_;
     }
 
 
-    /// @brief Return the comment.
-    const CComment &comment() const {
-        return comment_;
+    void add_member(StringView name, const CType &type) {
+        members_.push_back({String(reinterpret_cast<const char *>(name.data()), name.size()), &type, 0});
     }
 };
@@ -1,49 +1,58 @@
 #pragma once
 
-#include <c/ast/CObject.hpp>
-
-
-/// @brief An `CVariable` is an `CObject` associated with an identifier.
-class CVariable : public CObject {
+#include <c/ast/CExpression.hpp>
+#include <c/ast/CType.hpp>
+
+
+/// @brief An `CVariable` is an object of a type associated with an identifier.
+///
+/// Variables are declared by declaration statements, as function parameters or at file scope.
+class CVariable {
+private:
+    const CType *type_;
+    String name_;
+    CExpression initializer_; // Empty if the variable is not initialized
+    bool is_static_;
 public:
 
 
-    virtual ~CVariable() = default;
+    CVariable(
+        const CType &type,
+        StringView name,
+        CExpression initializer = {},
+        bool is_static = false
+    ) :
+        type_(&type),
+        name_(reinterpret_cast<const char *>(name.data()), name.size()),
+        initializer_(std::move(initializer)),
+        is_static_(is_static)
+    {}
 
 
-    bool has_comment() const {
-        return !comment().text().is_empty();
+    // The variable type
+    const CType &type() const {
+        return *type_;
     }
 
 
-    // The comment associated with the variable
-    virtual const CComment &comment() const = 0;
-
-
     // The variable name
-    virtual const CToken &name() const = 0;
-
-
-    // The temporary sequence of tokens that make the definition
-    virtual const List<const CToken *> &definition() const = 0;
-
-
-    // The absolute address of the variable storage
-    virtual u64 address() const = 0;
-
-
-    // The memory will not be modified
-    virtual bool is_literal() const = 0;
+    StringView name() const {
+        return StringView(reinterpret_cast<const u8 *>(name_.data()), name_.size());
+    }
 
 
-    // The memory may be be modified even when const
-    virtual bool is_safe() const = 0;
+    bool has_initializer() const {
+        return !initializer_.is_empty();
+    }
 
 
-    // The variable is a reference (storage is indeterminate)
-    virtual bool is_reference() const = 0;
+    const CExpression &initializer() const {
+        return initializer_;
+    }
 
 
-    // The variable is a reference (storage is not needed)
-    virtual bool is_alias() const = 0;
+    // The variable has internal linkage, or static storage in a function
+    bool is_static() const {
+        return is_static_;
+    }
 };
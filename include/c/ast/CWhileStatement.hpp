@@ -1,7 +1,7 @@
 #pragma once
 
+#include <c/ast/CBlockStatement.hpp>
 #include <c/ast/CExpression.hpp>
-#include <c/ast/CStatement.hpp>
 
 
 // A 'while' statement is a structured unit of conditional execution.
@@ -9,17 +9,15 @@
 // while (CONDITION) STATEMENT
 class CWhileStatement : public CStatement {
 private:
+    CExpression condition_;
     CBlockStatement block_;
-    CExpression &condition_;
 public:
 
 
     CWhileStatement(
-        CExpression &condition,
-        CBlockStatement block
+        CExpression condition
     ) :
-        block_(block),
-        condition_(condition)
+        condition_(std::move(condition))
     {}
 
 
@@ -28,13 +26,13 @@ public:
     }
 
 
-    bool is_deterministic() const {
-        return false;
+    const CExpression &condition() const {
+        return condition_;
     }
 
 
-    const CExpression &condition() const {
-        return condition_;
+    CBlockStatement &block() {
+        return block_;
     }
 
 
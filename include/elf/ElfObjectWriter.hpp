@@ -0,0 +1,81 @@
+#pragma once
+
+#include <core/Common.hpp>
+#include <core/Slice.hpp>
+#include <core/StringView.hpp>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+
+/// Writes an ELF64 relocatable object for x86-64 with one code section.
+///
+/// The symbols are global functions, defined in the code section or undefined and resolved by the
+/// linker. The relocations of the code refer to them by index.
+class ElfObjectWriter {
+private:
+
+    struct Symbol {
+        std::string name;
+        u32 offset;
+        u32 size;
+        bool is_defined;
+    };
+
+
+    struct Relocation {
+        u32 offset;
+        u32 symbol;
+        u32 type;
+        i64 addend;
+    };
+
+
+    std::vector<u8> _text;
+    std::vector<Symbol> _symbols;
+    std::vector<Relocation> _relocations;
+public:
+
+
+    /// A 32-bit displacement to a function, through the procedure linkage table if needed.
+    static constexpr u32 R_X86_64_PLT32 = 4;
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    ElfObjectWriter() noexcept {}
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// Add an undefined symbol and return its index.
+    u32 add_symbol(StringView name) noexcept;
+
+
+    /// Define a symbol as a function in the code section.
+    void define_symbol(u32 symbol, u32 offset, u32 size) noexcept {
+        _symbols[symbol].offset = offset;
+        _symbols[symbol].size = size;
+        _symbols[symbol].is_defined = true;
+    }
+
+
+    void set_text(Slice<const u8> text) noexcept {
+        _text.assign(text.begin(), text.end());
+    }
+
+
+    void add_relocation(u32 offset, u32 symbol, u32 type, i64 addend) noexcept {
+        _relocations.push_back({offset, symbol, type, addend});
+    }
+
+
+    Error write(const std::filesystem::path &file_path) const noexcept;
+};
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <ir/ast/IrFunction.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+
+/// Builds a function in SSA form from reads and writes of variables.
+///
+/// Phi instructions are placed on demand when a variable is read in a block without a definition,
+/// following Braun et al., "Simple and Efficient Construction of Static Single Assignment Form". A
+/// block is sealed once all of its predecessors are known. Reads in blocks which are not sealed
+/// create incomplete phi instructions, completed when the block is sealed.
+///
+/// Instructions may be added to blocks in any order. `finish()` removes the trivial phi
+/// instructions and lays the instructions out block by block.
+class IrBuilder {
+private:
+
+    struct Block {
+        std::vector<u32> head;            // The phi, parameter and undefined values
+        std::vector<u32> body;            // The other instructions, ending with the terminator
+        std::vector<u32> predecessors;
+        std::vector<std::pair<u32, u32>> incomplete_phis; // The variable and phi of each read before sealing
+        u32 successors[2] = {IrBasicBlock::NONE, IrBasicBlock::NONE};
+        bool is_sealed = false;
+    };
+
+
+    std::vector<IrInstruction> _values;
+    std::vector<std::vector<u32>> _operands;   // The operands of each phi and call value
+    std::vector<u32> _replacements;            // The value replacing each value, for trivial phi instructions
+    std::vector<u32> _value_blocks;            // The block of each value
+    std::vector<Block> _blocks;
+    std::unordered_map<u64, u32> _definitions; // The current value of a variable in a block
+    u32 _block = 0;
+    u32 _parameter_count = 0;
+public:
+
+
+    static constexpr u32 NONE = 0xFFFFFFFFu;
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    /// Create a builder with an empty, sealed entry block.
+    IrBuilder() noexcept;
+
+
+    ///
+    /// Properties
+    ///
+
+
+    /// The block instructions are appended to.
+    u32 block() const noexcept {
+        return _block;
+    }
+
+
+    /// Return true if the current block ends with a terminator.
+    bool is_terminated() const noexcept {
+        const std::vector<u32> &body = _blocks[_block].body;
+        return !body.empty() && _values[body.back()].opcode.is_terminator();
+    }
+
+
+    ///
+    /// Methods
+    ///
+
+
+    u32 create_block() noexcept;
+
+
+    void set_block(u32 block) noexcept {
+        _block = block;
+    }
+
+
+    /// Mark a block as having all of its predecessors, completing its phi instructions.
+    void seal_block(u32 block) noexcept;
+
+
+    void write_variable(u32 variable, u32 value) noexcept {
+        write_variable(variable, _block, value);
+    }
+
+
+    u32 read_variable(u32 variable) noexcept {
+        return read_variable(variable, _block);
+    }
+
+
+    /// Add the next parameter at the head of the entry block, so that it is live from the entry of
+    /// the function wherever it is added.
+    u32 parameter() noexcept;
+
+
+    u32 constant(i64 immediate) noexcept;
+
+
+    u32 undefined() noexcept;
+
+
+    u32 unary(IrOpcode opcode, u32 value) noexcept;
+
+
+    u32 binary(IrOpcode opcode, u32 lhs, u32 rhs) noexcept;
+
+
+    u32 call(u32 function_id, std::vector<u32> arguments) noexcept;
+
+
+    void jump(u32 target) noexcept;
+
+
+    void branch(u32 condition, u32 true_target, u32 false_target) noexcept;
+
+
+    /// Return a value, or nothing if the value is `NONE`.
+    void return_value(u32 value) noexcept;
+
+
+    /// Return the function. Blocks without a terminator end with an unreachable instruction.
+    IrFunction finish() noexcept;
+
+
+private:
+
+
+    u32 append(u32 block, IrInstruction instruction, bool is_head = false) noexcept;
+
+
+    void add_edge(u32 successor) noexcept;
+
+
+    void write_variable(u32 variable, u32 block, u32 value) noexcept {
+        _definitions[u64(variable) << 32 | block] = value;
+    }
+
+
+    u32 read_variable(u32 variable, u32 block) noexcept;
+
+
+    u32 read_variable_recursive(u32 variable, u32 block) noexcept;
+
+
+    void add_phi_operands(u32 variable, u32 phi) noexcept;
+
+
+    /// Return the value replacing a value, following chains of removed phi instructions.
+    u32 resolve(u32 value) noexcept;
+};
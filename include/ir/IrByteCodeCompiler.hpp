@@ -0,0 +1,118 @@
+#pragma once
+
+#include <ir/ast/IrByteCodeFunction.hpp>
+#include <ir/ast/IrFunction.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+
+/// Compiles a function in SSA form to register based byte code.
+///
+/// Every value gets its own register, and the parameters are the first registers. Phi
+/// instructions become moves on the edges into their block, sequentialized through temporary
+/// registers when the moves overlap. Edges from a branch into a block with phi instructions get
+/// their own block of moves.
+///
+/// Common pairs of instructions become superinstructions: a comparison used only by the branch
+/// ending its block becomes a compare and branch, and an addition or subtraction of a small
+/// constant becomes an addition of an immediate. Blocks are laid out in order and jumps to the next
+/// instruction are omitted.
+class IrByteCodeCompiler {
+private:
+
+    struct Fixup {
+        u32 offset; // The instruction whose target is the label
+        u32 label;  // A block, or an edge block after the blocks
+    };
+
+
+    struct Edge {
+        u32 block;
+        u32 successor; // The index of the successor in the successors of the block
+    };
+
+
+    const IrFunction &_function;
+    const std::unordered_map<u32, u32> &_function_indices;
+    IrByteCodeFunction _byte_code;
+    std::vector<u32> _registers;       // The register of each value, or `NONE`
+    std::vector<u32> _use_counts;      // The number of instructions using each value
+    std::vector<u32> _labels;          // The offset of each label
+    std::vector<Fixup> _fixups;
+    std::vector<Edge> _edges;          // The edges needing a block of moves, after the blocks
+    u32 _temporary_register = 0;       // The first register for overlapping moves
+    u32 _argument_register = 0;        // The first register for call arguments
+    u32 _next_block = 0;               // The block laid out after the current block
+    Error _error = Error::SUCCESS;
+public:
+
+
+    static constexpr u32 NONE = 0xFFFFFFFFu;
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    /// Create a compiler. Calls resolve the ID of their function to an index in `function_indices`.
+    IrByteCodeCompiler(const IrFunction &function, const std::unordered_map<u32, u32> &function_indices) noexcept :
+        _function(function),
+        _function_indices(function_indices)
+    {}
+
+
+    ///
+    /// Methods
+    ///
+
+
+    Error compile(IrByteCodeFunction &byte_code) noexcept;
+
+
+private:
+
+
+    /// Count the uses of every value and choose the values fused into their users.
+    void count_uses() noexcept;
+
+
+    /// Assign a register to every value which is not fused.
+    void assign_registers() noexcept;
+
+
+    /// Return true if the value is a constant which fits in a 16-bit immediate.
+    bool is_small_constant(u32 value) const noexcept;
+
+
+    /// Return true if the value is a comparison fused into the branch ending its block.
+    bool is_fused_comparison(u32 value) const noexcept;
+
+
+    void compile_block(u32 block) noexcept;
+
+
+    void compile_instruction(u32 value) noexcept;
+
+
+    void compile_terminator(u32 block) noexcept;
+
+
+    /// Emit the moves into the phi registers of a successor of a block.
+    void compile_edge_moves(u32 block, u32 successor) noexcept;
+
+
+    /// Return the label of an edge: the successor, or an edge block if the edge has moves.
+    u32 edge_label(u32 block, u32 successor) noexcept;
+
+
+    void emit(IrByteCodeOpcode opcode, u32 a, u32 b, u32 c) noexcept;
+
+
+    /// Emit a jump or branch to a label.
+    void emit_jump(IrByteCodeOpcode opcode, u32 a, u32 b, u32 label) noexcept;
+
+
+    void error(const char *message) noexcept;
+};
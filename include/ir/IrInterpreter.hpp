@@ -0,0 +1,71 @@
+#pragma once
+
+#include <ir/ast/IrByteCodeFunction.hpp>
+
+#include <vector>
+
+
+template<class IrDispatch>
+struct IrDispatchValues {
+    static constexpr IrDispatch THREADED{0}; // Jump from each instruction to the next through a table of labels
+    static constexpr IrDispatch SWITCH{1};   // Return to a switch statement after each instruction
+};
+
+
+struct IrDispatch : public Enum<u8>, public IrDispatchValues<IrDispatch> {
+
+    constexpr
+    explicit
+    IrDispatch(u8 id) noexcept : Enum(id) {}
+};
+
+
+/// Runs byte code functions.
+///
+/// The frames of all calls share one array of registers. The threaded dispatch uses the labels as
+/// values extension of GCC and Clang and is the switch dispatch elsewhere.
+class IrInterpreter {
+private:
+
+    struct Frame {
+        const IrByteCodeFunction *function;
+        const IrByteCodeInstruction *return_address; // The call instruction
+        i64 *registers;
+    };
+
+
+    Slice<const IrByteCodeFunction> _functions;
+    std::vector<i64> _registers;
+    std::vector<Frame> _frames;
+public:
+
+
+    static constexpr u32 DEFAULT_REGISTER_COUNT = 1 << 20;
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    IrInterpreter(Slice<const IrByteCodeFunction> functions, u32 register_count = DEFAULT_REGISTER_COUNT) noexcept :
+        _functions(functions),
+        _registers(register_count)
+    {}
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// Call a function and store its return value, or zero if it returns nothing.
+    Error run(u32 function, Slice<const i64> arguments, i64 &result, IrDispatch dispatch = IrDispatch::THREADED) noexcept;
+
+
+private:
+
+
+    template<u8 DISPATCH>
+    Error execute(const IrByteCodeFunction *function, i64 &result) noexcept;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <ir/IrBuilder.hpp>
+#include <mj/ast/MjExpressionTree.hpp>
+#include <mj/ast/MjSourceFile.hpp>
+#include <mj/ast/MjTokenView.hpp>
+
+#include <vector>
+
+
+class MjBlockStatement;
+class MjIfStatement;
+class MjStatement;
+class MjVariable;
+class MjWhileLoop;
+
+
+/// Lowers the body of a function from the AST to SSA form.
+///
+/// Local variables are identified by the string ID of their name in the source file. Integers,
+/// booleans, arithmetic, comparisons, assignments, calls, `if` statements and `while` loops are
+/// lowered. Other constructs are reported and lowered to undefined values. Calls use the string ID
+/// of the name of the callee as the ID of the function.
+class IrLowering {
+private:
+
+    struct Loop {
+        u32 continue_block;
+        u32 break_block;
+    };
+
+
+    const MjSourceFile &_file;
+    const MjTokenView &_tokens;
+    IrBuilder _builder;
+    std::vector<Loop> _loops;
+    u32 _temporary_count = 0;
+    Error _error = Error::SUCCESS;
+public:
+
+
+    /// Temporary variables have IDs above the string IDs of the source file.
+    static constexpr u32 TEMPORARY = 0x80000000u;
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    IrLowering(const MjSourceFile &file, const MjTokenView &tokens) noexcept : _file(file), _tokens(tokens) {}
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// Lower a function body. The parameters are the first values of the function, in order.
+    Error lower(Slice<const MjVariable *const> parameters, const MjBlockStatement &body, IrFunction &function) noexcept;
+
+
+private:
+
+
+    void lower_statement(const MjStatement *statement) noexcept;
+
+
+    void lower_block(const MjBlockStatement *block) noexcept;
+
+
+    void lower_if(const MjIfStatement *statement) noexcept;
+
+
+    void lower_while(const MjWhileLoop *loop) noexcept;
+
+
+    /// End the current block with a jump unless it is terminated.
+    void jump(u32 target) noexcept;
+
+
+    /// Continue in a new block without predecessors, after a terminator.
+    void start_unreachable_block() noexcept;
+
+
+    u32 lower_node(const MjExpressionTree &tree, u32 index) noexcept;
+
+
+    u32 lower_literal(const MjExpressionNode &node) noexcept;
+
+
+    u32 lower_unary(const MjExpressionTree &tree, const MjExpressionNode &node) noexcept;
+
+
+    u32 lower_binary(const MjExpressionTree &tree, const MjExpressionNode &node) noexcept;
+
+
+    u32 lower_call(const MjExpressionTree &tree, const MjExpressionNode &node) noexcept;
+
+
+    /// Lower `a && b` and `a || b`, evaluating `b` only if needed.
+    u32 lower_logical(const MjExpressionTree &tree, const MjExpressionNode &node) noexcept;
+
+
+    /// Return the variable named by a node, or `NONE` if the node is not a variable.
+    u32 variable_of(const MjExpressionTree &tree, u32 index) const noexcept;
+
+
+    u32 error(const MjExpressionNode &node, const char *message) noexcept;
+};
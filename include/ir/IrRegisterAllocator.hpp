@@ -0,0 +1,125 @@
+#pragma once
+
+#include <ir/ast/IrFunction.hpp>
+
+#include <algorithm>
+#include <vector>
+
+
+/// The location of a value: a register, a stack slot, or none.
+struct IrLocation {
+    u32 index = NONE;      // The register or the stack slot
+    bool is_stack = false;
+
+
+    static constexpr u32 NONE = 0xFFFFFFFFu;
+
+
+    constexpr
+    bool is_none() const noexcept {
+        return index == NONE;
+    }
+
+
+    constexpr
+    bool is_register() const noexcept {
+        return index != NONE && !is_stack;
+    }
+};
+
+
+/// Assigns registers to the values of a function by linear scan.
+///
+/// Each value is live over one interval of the instruction array, from its definition to its last
+/// use, widened over the blocks it is live through. The intervals are scanned in order of their
+/// start. When every register is taken, the interval ending last is spilled to the stack, as in
+/// Poletto and Sarkar, "Linear Scan Register Allocation".
+///
+/// Registers are numbered with the caller saved registers first. Values live across a call only
+/// get callee saved registers, so calls never need to save registers.
+///
+/// The moves into the phi instructions of a block happen at the end of its predecessors, so phi
+/// instructions are live from there.
+class IrRegisterAllocator {
+private:
+
+    struct Interval {
+        u32 value;
+        u32 start;
+        u32 end;
+    };
+
+
+    const IrFunction &_function;
+    u32 _caller_saved_count;
+    u32 _callee_saved_count;
+    std::vector<u32> _starts;
+    std::vector<u32> _ends;
+    std::vector<u32> _call_positions;
+    std::vector<IrLocation> _locations;
+    u32 _stack_slot_count = 0;
+    u32 _used_registers = 0;
+public:
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    IrRegisterAllocator(const IrFunction &function, u32 caller_saved_count, u32 callee_saved_count) noexcept :
+        _function(function),
+        _caller_saved_count(caller_saved_count),
+        _callee_saved_count(callee_saved_count)
+    {}
+
+
+    ///
+    /// Properties
+    ///
+
+
+    const IrLocation &location(u32 value) const noexcept {
+        return _locations[value];
+    }
+
+
+    u32 stack_slot_count() const noexcept {
+        return _stack_slot_count;
+    }
+
+
+    /// The mask of the registers assigned to any value.
+    u32 used_registers() const noexcept {
+        return _used_registers;
+    }
+
+
+    ///
+    /// Methods
+    ///
+
+
+    void allocate() noexcept;
+
+
+private:
+
+
+    /// Compute the live interval of every value from the liveness of the blocks.
+    void compute_intervals() noexcept;
+
+
+    void extend(u32 value, u32 position) noexcept {
+        _starts[value] = std::min(_starts[value], position);
+        _ends[value] = std::max(_ends[value], position);
+    }
+
+
+    /// Return true if a call is strictly inside the interval of a value.
+    bool is_live_across_call(u32 value) const noexcept;
+
+
+    /// Assign the registers `first_register` to `first_register + register_count` to intervals.
+    void scan(std::vector<Interval> &intervals, u32 first_register, u32 register_count) noexcept;
+};
@@ -1,18 +0,0 @@
-#pragma once
-
-#include <mj/ast/MjFunctionDefinition.hpp>
-
-
-class BasicBlock {
-private:
-public:
-
-
-    constexpr
-    BasicBlock() noexcept {}
-
-
-    ///
-    /// Properties
-    ///
-};
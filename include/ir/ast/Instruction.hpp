@@ -1,18 +0,0 @@
-#pragma once
-
-#include <mj/ast/MjFunctionDefinition.hpp>
-
-
-class Instruction {
-private:
-public:
-
-
-    constexpr
-    Instruction() noexcept {}
-
-
-    ///
-    /// Properties
-    ///
-};
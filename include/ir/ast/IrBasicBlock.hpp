@@ -0,0 +1,40 @@
+#pragma once
+
+#include <ir/ast/IrInstruction.hpp>
+
+
+/// A basic block of an SSA function: a range of the instruction array of its function.
+///
+/// The phi instructions of a block come first and the block ends with a terminator. The
+/// predecessors are a range of the predecessor array of the function, in the order of the operands
+/// of the phi instructions.
+struct IrBasicBlock {
+    u32 first_instruction;
+    u32 instruction_count;
+    u32 phi_count;
+    u32 first_predecessor;
+    u32 predecessor_count;
+    u32 successors[2];     // The targets of the terminator, or `NONE`
+
+
+    static constexpr u32 NONE = 0xFFFFFFFFu;
+
+
+    constexpr
+    u32 end_instruction() const noexcept {
+        return first_instruction + instruction_count;
+    }
+
+
+    /// The index of the terminator instruction.
+    constexpr
+    u32 terminator() const noexcept {
+        return end_instruction() - 1;
+    }
+
+
+    constexpr
+    u32 successor_count() const noexcept {
+        return (successors[0] != NONE) + (successors[1] != NONE);
+    }
+};
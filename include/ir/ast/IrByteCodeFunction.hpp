@@ -0,0 +1,68 @@
+#pragma once
+
+#include <ir/ast/IrByteCodeInstruction.hpp>
+#include <core/Slice.hpp>
+
+#include <vector>
+
+
+/// A function in register based byte code.
+///
+/// Each call has a frame of `register_count` registers, the first of which hold the parameters.
+/// The arguments of a call are the last registers of the frame of the caller, which become the
+/// first registers of the frame of the callee.
+class IrByteCodeFunction {
+    friend class IrByteCodeCompiler;
+private:
+    std::vector<IrByteCodeInstruction> _code;
+    std::vector<i64> _constants;
+    u32 _parameter_count = 0;
+    u32 _register_count = 0;
+public:
+
+
+    /// The largest number of instructions, registers or constants of a function.
+    static constexpr u32 MAX_SIZE = 0x10000;
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    IrByteCodeFunction() noexcept {}
+
+
+    ///
+    /// Properties
+    ///
+
+
+    u32 parameter_count() const noexcept {
+        return _parameter_count;
+    }
+
+
+    u32 register_count() const noexcept {
+        return _register_count;
+    }
+
+
+    Slice<const IrByteCodeInstruction> code() const noexcept {
+        return {_code.data(), u32(_code.size())};
+    }
+
+
+    Slice<const i64> constants() const noexcept {
+        return {_constants.data(), u32(_constants.size())};
+    }
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// Print the function in the human readable byte code assembly format.
+    void print() const noexcept;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <core/Common.hpp>
+#include <core/Enum.hpp>
+
+
+template<class IrByteCodeOpcode>
+struct IrByteCodeOpcodeValues {
+
+    // Values
+    static constexpr IrByteCodeOpcode MOVE{0};           // r[a] = r[b]
+    static constexpr IrByteCodeOpcode LOAD_INTEGER{1};   // r[a] = i16(b)
+    static constexpr IrByteCodeOpcode LOAD_CONSTANT{2};  // r[a] = constants[b]
+
+    // Unary
+    static constexpr IrByteCodeOpcode NEG{3};            // r[a] = -r[b]
+    static constexpr IrByteCodeOpcode NOT{4};            // r[a] = ~r[b]
+
+    // Binary, in the order of the binary IR opcodes
+    static constexpr IrByteCodeOpcode ADD{5};            // r[a] = r[b] + r[c]
+    static constexpr IrByteCodeOpcode SUB{6};            // r[a] = r[b] - r[c]
+    static constexpr IrByteCodeOpcode MUL{7};            // r[a] = r[b] * r[c]
+    static constexpr IrByteCodeOpcode DIV{8};            // r[a] = r[b] / r[c]
+    static constexpr IrByteCodeOpcode REM{9};            // r[a] = r[b] % r[c]
+    static constexpr IrByteCodeOpcode AND{10};           // r[a] = r[b] & r[c]
+    static constexpr IrByteCodeOpcode OR{11};            // r[a] = r[b] | r[c]
+    static constexpr IrByteCodeOpcode XOR{12};           // r[a] = r[b] ^ r[c]
+    static constexpr IrByteCodeOpcode SHL{13};           // r[a] = r[b] << r[c]
+    static constexpr IrByteCodeOpcode SHR{14};           // r[a] = r[b] >> r[c] (arithmetic)
+    static constexpr IrByteCodeOpcode EQ{15};            // r[a] = r[b] == r[c]
+    static constexpr IrByteCodeOpcode NE{16};            // r[a] = r[b] != r[c]
+    static constexpr IrByteCodeOpcode LT{17};            // r[a] = r[b] < r[c]
+    static constexpr IrByteCodeOpcode LE{18};            // r[a] = r[b] <= r[c]
+    static constexpr IrByteCodeOpcode GT{19};            // r[a] = r[b] > r[c]
+    static constexpr IrByteCodeOpcode GE{20};            // r[a] = r[b] >= r[c]
+
+    // Superinstructions
+    static constexpr IrByteCodeOpcode ADD_INTEGER{21};   // r[a] = r[b] + i16(c), for a constant and an addition
+    static constexpr IrByteCodeOpcode BRANCH_EQ{22};     // Continue at c if r[a] == r[b], for a comparison and a branch
+    static constexpr IrByteCodeOpcode BRANCH_NE{23};     // Continue at c if r[a] != r[b]
+    static constexpr IrByteCodeOpcode BRANCH_LT{24};     // Continue at c if r[a] < r[b]
+    static constexpr IrByteCodeOpcode BRANCH_LE{25};     // Continue at c if r[a] <= r[b]
+    static constexpr IrByteCodeOpcode BRANCH_GT{26};     // Continue at c if r[a] > r[b]
+    static constexpr IrByteCodeOpcode BRANCH_GE{27};     // Continue at c if r[a] >= r[b]
+
+    // Control
+    static constexpr IrByteCodeOpcode JUMP{28};          // Continue at c
+    static constexpr IrByteCodeOpcode BRANCH_TRUE{29};   // Continue at c if r[a] is not zero
+    static constexpr IrByteCodeOpcode BRANCH_FALSE{30};  // Continue at c if r[a] is zero
+    static constexpr IrByteCodeOpcode CALL{31};          // r[a] = functions[c](r[b], r[b + 1], ...)
+    static constexpr IrByteCodeOpcode RETURN{32};        // Return r[a]
+    static constexpr IrByteCodeOpcode RETURN_VOID{33};   // Return nothing
+    static constexpr IrByteCodeOpcode UNREACHABLE{34};   // Stop with an error
+};
+
+
+struct IrByteCodeOpcode : public Enum<u8>, public IrByteCodeOpcodeValues<IrByteCodeOpcode> {
+    static constexpr u32 COUNT = 35;
+
+
+    constexpr
+    explicit
+    IrByteCodeOpcode(u8 id) noexcept : Enum(id) {}
+
+
+    constexpr
+    bool is_fused_branch() const noexcept {
+        return u32(_id - BRANCH_EQ) <= u32(BRANCH_GE - BRANCH_EQ);
+    }
+
+
+    /// Return true if `c` is the offset of an instruction.
+    constexpr
+    bool has_target() const noexcept {
+        return is_fused_branch() || _id == JUMP || _id == BRANCH_TRUE || _id == BRANCH_FALSE;
+    }
+
+
+    /// Return the fused branch taken when the branch is not taken.
+    constexpr
+    IrByteCodeOpcode inverse_branch() const noexcept {
+        return IrByteCodeOpcode(_id <= BRANCH_NE ? _id ^ 1 : BRANCH_LT + BRANCH_GE - _id);
+    }
+
+
+    const char *name() const noexcept {
+        static constexpr const char *NAMES[COUNT] = {
+            "move", "load_integer", "load_constant", "neg", "not",
+            "add", "sub", "mul", "div", "rem", "and", "or", "xor", "shl", "shr",
+            "eq", "ne", "lt", "le", "gt", "ge", "add_integer",
+            "branch_eq", "branch_ne", "branch_lt", "branch_le", "branch_gt", "branch_ge",
+            "jump", "branch_true", "branch_false", "call", "return", "return_void", "unreachable",
+        };
+
+        return NAMES[_id];
+    }
+};
+
+
+/// An instruction of a register based byte code function.
+///
+/// Operands are register indices in the frame of the function, 16-bit immediates, or instruction
+/// offsets in the code of the function, depending on the opcode.
+struct IrByteCodeInstruction {
+    IrByteCodeOpcode opcode;
+    u8 reserved = 0;
+    u16 a;
+    u16 b;
+    u16 c;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <ir/ast/IrBasicBlock.hpp>
+#include <core/Slice.hpp>
+
+#include <vector>
+
+
+/// A function in SSA form.
+///
+/// The instructions of every block are stored contiguously in one array, block by block, so that
+/// blocks are index ranges and values are instruction indices. Block 0 is the entry block.
+class IrFunction {
+    friend class IrBuilder;
+private:
+    std::vector<IrInstruction> _instructions;
+    std::vector<IrBasicBlock> _blocks;
+    std::vector<u32> _operands;     // The operands of phi and call instructions
+    std::vector<u32> _predecessors; // The predecessors of each block
+    u32 _parameter_count = 0;
+public:
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    IrFunction() noexcept {}
+
+
+    ///
+    /// Properties
+    ///
+
+
+    u32 parameter_count() const noexcept {
+        return _parameter_count;
+    }
+
+
+    Slice<const IrInstruction> instructions() const noexcept {
+        return {_instructions.data(), u32(_instructions.size())};
+    }
+
+
+    Slice<const IrBasicBlock> blocks() const noexcept {
+        return {_blocks.data(), u32(_blocks.size())};
+    }
+
+
+    const IrInstruction &instruction(u32 index) const noexcept {
+        return _instructions[index];
+    }
+
+
+    const IrBasicBlock &block(u32 index) const noexcept {
+        return _blocks[index];
+    }
+
+
+    /// The instructions of a block, starting with its phi instructions.
+    Slice<const IrInstruction> instructions(const IrBasicBlock &block) const noexcept {
+        return {_instructions.data() + block.first_instruction, block.instruction_count};
+    }
+
+
+    Slice<const u32> predecessors(const IrBasicBlock &block) const noexcept {
+        return {_predecessors.data() + block.first_predecessor, block.predecessor_count};
+    }
+
+
+    /// The operands of a phi or call instruction.
+    Slice<const u32> operands(const IrInstruction &instruction) const noexcept {
+        return {_operands.data() + instruction.b, instruction.operand_count};
+    }
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// Print the function in the human readable IR assembly format.
+    void print() const noexcept;
+};
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <core/Common.hpp>
+#include <core/Enum.hpp>
+
+
+template<class IrOpcode>
+struct IrOpcodeValues {
+
+    // Values
+    static constexpr IrOpcode PARAMETER{0};    // The parameter with index `a`
+    static constexpr IrOpcode CONSTANT{1};     // The immediate `b << 32 | a`
+    static constexpr IrOpcode UNDEFINED{2};    // A variable read before its first write
+    static constexpr IrOpcode PHI{3};          // One operand per predecessor of the block, in predecessor order
+
+    // Unary
+    static constexpr IrOpcode NEG{4};          // -a
+    static constexpr IrOpcode NOT{5};          // ~a
+
+    // Binary
+    static constexpr IrOpcode ADD{6};          // a + b
+    static constexpr IrOpcode SUB{7};          // a - b
+    static constexpr IrOpcode MUL{8};          // a * b
+    static constexpr IrOpcode DIV{9};          // a / b
+    static constexpr IrOpcode REM{10};         // a % b
+    static constexpr IrOpcode AND{11};         // a & b
+    static constexpr IrOpcode OR{12};          // a | b
+    static constexpr IrOpcode XOR{13};         // a ^ b
+    static constexpr IrOpcode SHL{14};         // a << b
+    static constexpr IrOpcode SHR{15};         // a >> b (arithmetic)
+    static constexpr IrOpcode EQ{16};          // a == b
+    static constexpr IrOpcode NE{17};          // a != b
+    static constexpr IrOpcode LT{18};          // a < b
+    static constexpr IrOpcode LE{19};          // a <= b
+    static constexpr IrOpcode GT{20};          // a > b
+    static constexpr IrOpcode GE{21};          // a >= b
+
+    // Calls
+    static constexpr IrOpcode CALL{22};        // The function with ID `a`, with the arguments in the operand array
+
+    // Terminators
+    static constexpr IrOpcode JUMP{23};        // Continue at the first successor
+    static constexpr IrOpcode BRANCH{24};      // Continue at the first successor if `a` is not zero, else at the second
+    static constexpr IrOpcode RETURN{25};      // Return `a`, or nothing if `a` is `NONE`
+    static constexpr IrOpcode UNREACHABLE{26}; // The end of a block control never reaches
+};
+
+
+struct IrOpcode : public Enum<u8>, public IrOpcodeValues<IrOpcode> {
+    static constexpr u32 COUNT = 27;
+
+
+    constexpr
+    explicit
+    IrOpcode(u8 id) noexcept : Enum(id) {}
+
+
+    constexpr
+    bool is_unary() const noexcept {
+        return _id == NEG || _id == NOT;
+    }
+
+
+    constexpr
+    bool is_binary() const noexcept {
+        return u32(_id - ADD) <= u32(GE - ADD);
+    }
+
+
+    constexpr
+    bool is_comparison() const noexcept {
+        return u32(_id - EQ) <= u32(GE - EQ);
+    }
+
+
+    /// Return true if the instruction ends a basic block.
+    constexpr
+    bool is_terminator() const noexcept {
+        return _id >= JUMP;
+    }
+
+
+    /// Return true if the operand array holds the operands of the instruction.
+    constexpr
+    bool has_operand_array() const noexcept {
+        return _id == PHI || _id == CALL;
+    }
+
+
+    /// Return true if `a` is a value.
+    constexpr
+    bool has_value_a() const noexcept {
+        return is_unary() || is_binary() || _id == BRANCH || _id == RETURN;
+    }
+
+
+    /// Return true if `b` is a value.
+    constexpr
+    bool has_value_b() const noexcept {
+        return is_binary();
+    }
+
+
+    const char *name() const noexcept {
+        static constexpr const char *NAMES[COUNT] = {
+            "parameter", "constant", "undefined", "phi", "neg", "not",
+            "add", "sub", "mul", "div", "rem", "and", "or", "xor", "shl", "shr",
+            "eq", "ne", "lt", "le", "gt", "ge", "call", "jump", "branch", "return", "unreachable",
+        };
+
+        return NAMES[_id];
+    }
+};
+
+
+template<class IrValueType>
+struct IrValueTypeValues {
+    static constexpr IrValueType VOID{0};
+    static constexpr IrValueType I1{1};
+    static constexpr IrValueType I64{2};
+};
+
+
+struct IrValueType : public Enum<u8>, public IrValueTypeValues<IrValueType> {
+
+    constexpr
+    explicit
+    IrValueType(u8 id) noexcept : Enum(id) {}
+};
+
+
+/// An instruction of an SSA function.
+///
+/// The value defined by an instruction is its index in the instruction array of its function, so
+/// operands are instruction indices. Phi and call instructions keep their operands in the operand
+/// array of the function, starting at `first_operand`.
+struct IrInstruction {
+    IrOpcode opcode;
+    IrValueType type;
+    u16 operand_count; // The number of operands in the operand array
+    u32 a;
+    u32 b;             // The first operand in the operand array, for phi and call instructions
+
+
+    static constexpr u32 NONE = 0xFFFFFFFFu;
+
+
+    constexpr
+    u32 first_operand() const noexcept {
+        return b;
+    }
+
+
+    /// The immediate of a constant instruction.
+    constexpr
+    i64 immediate() const noexcept {
+        return i64(u64(b) << 32 | a);
+    }
+};
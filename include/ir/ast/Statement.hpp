@@ -1,18 +0,0 @@
-#pragma once
-
-#include <mj/ast/MjFunctionDefinition.hpp>
-
-
-class Statement {
-private:
-public:
-
-
-    constexpr
-    Statement() noexcept {}
-
-
-    ///
-    /// Properties
-    ///
-};
@@ -1,14 +1,39 @@
 #pragma once
 
 #include <mj/ast/MjProgram.hpp>
+#include <ir/ast/IrFunction.hpp>
 
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
+
+/// Assembles the functions of a program into an x86-64 ELF relocatable object.
+///
+/// Functions are identified by the IDs their calls refer to. A declared function without a body
+/// is an undefined symbol, resolved by the linker.
 class MjAssembler {
 private:
+
+    struct Function {
+        u32 id;
+        const IrFunction *body;
+    };
+
+
     MjProgram &program_;
+    std::vector<std::string> _names;
+    std::unordered_map<u32, u32> _symbols;   // The symbol of each function ID
+    std::vector<Function> _functions;
 public:
 
 
+    ///
+    /// Constructors
+    ///
+
+
     MjAssembler(
         MjProgram &program
     ) :
@@ -16,6 +41,24 @@ public:
     {}
 
 
-    void assemble(const Path &path) {
+    ///
+    /// Methods
+    ///
+
+
+    /// Declare the name of a function.
+    void declare_function(u32 function_id, StringView name) noexcept {
+        _symbols[function_id] = _names.size();
+        _names.emplace_back(reinterpret_cast<const char *>(name.data()), name.size());
+    }
+
+
+    /// Add the body of a declared function. The function must outlive the assembler.
+    void add_function(u32 function_id, const IrFunction &function) noexcept {
+        _functions.push_back({function_id, &function});
     }
+
+
+    /// Write the object file.
+    Error assemble(const std::filesystem::path &path) noexcept;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mj/ast/MjSourceFile.hpp>
+#include <mj/ast/MjTokenView.hpp>
 #include <mj/MjFormatterConfig.hpp>
 
 #include <filesystem>
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <core/Common.hpp>
+
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+/// A single threaded arena for AST items.
+///
+/// Small objects are carved from pages dedicated to a size class, so that items of similar sizes
+/// are packed together and a freed slot can be reused by any item of the same class. Objects larger
+/// than the largest size class are allocated individually. Everything is released at once by
+/// `clear()` or when the arena is destroyed, after running the destructors of the objects which
+/// need one in reverse order of creation.
+class MjItemArena {
+private:
+
+    struct Page {
+        Page *next;
+    };
+
+    struct FreeSlot {
+        FreeSlot *next;
+    };
+
+    struct SizeClass {
+        u8 *cursor = nullptr;
+        u8 *end = nullptr;
+        FreeSlot *free_slots = nullptr;
+    };
+
+    struct Destructor {
+        void (*destroy)(void *object);
+        void *object;
+    };
+
+
+    static constexpr u32 PAGE_SIZE = 64 * 1024;
+    static constexpr u32 ALIGNMENT = 16;
+    static constexpr u32 PAGE_HEADER_SIZE = (sizeof(Page) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    static constexpr u32 SIZE_CLASS_COUNT = 8;
+    static constexpr u32 SIZE_CLASSES[SIZE_CLASS_COUNT] = {16, 32, 48, 64, 96, 128, 192, 256};
+    static constexpr u32 MAX_SMALL_SIZE = SIZE_CLASSES[SIZE_CLASS_COUNT - 1];
+
+
+    /// The size class index of each size in units of `ALIGNMENT`, rounded up.
+    struct SizeClassTable {
+        u8 classes[MAX_SMALL_SIZE / ALIGNMENT + 1] = {};
+
+        constexpr
+        SizeClassTable() noexcept {
+            u32 size_class = 0;
+
+            for (u32 i = 0; i <= MAX_SMALL_SIZE / ALIGNMENT; ++i) {
+                while (SIZE_CLASSES[size_class] < i * ALIGNMENT) {
+                    size_class += 1;
+                }
+
+                classes[i] = size_class;
+            }
+        }
+    };
+
+
+    static const SizeClassTable SIZE_CLASS_TABLE;
+
+
+    SizeClass _classes[SIZE_CLASS_COUNT];
+    Page *_pages = nullptr;
+    std::vector<void *> _large_objects;
+    std::vector<Destructor> _destructors;
+    u64 _page_count = 0;
+public:
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    MjItemArena() noexcept {}
+
+
+    MjItemArena(const MjItemArena &) = delete;
+
+
+    ///
+    /// Destructor
+    ///
+
+
+    ~MjItemArena() {
+        clear();
+    }
+
+
+    ///
+    /// Operators
+    ///
+
+
+    MjItemArena &operator=(const MjItemArena &) = delete;
+
+
+    ///
+    /// Properties
+    ///
+
+
+    /// The number of bytes reserved for small objects.
+    u64 reserved_size() const noexcept {
+        return _page_count * PAGE_SIZE;
+    }
+
+
+    /// The number of objects allocated individually.
+    u32 large_object_count() const noexcept {
+        return _large_objects.size();
+    }
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// Create an object in the arena. The object is destroyed when the arena is cleared.
+    template<class T, class... Args>
+    T *create(Args &&... args) noexcept {
+        static_assert(alignof(T) <= ALIGNMENT, "Over-aligned arena object!");
+        T *object = new (allocate(sizeof(T))) T(std::forward<Args>(args)...);
+
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            _destructors.push_back({[](void *object) { static_cast<T *>(object)->~T(); }, object});
+        }
+
+        return object;
+    }
+
+
+    /// Destroy an object before the arena is cleared and reuse its memory.
+    ///
+    /// The destructor record of the object is searched from the most recent, which is cheap for
+    /// short lived objects. Prefer clearing the arena when discarding many objects.
+    template<class T>
+    void destroy(T *object) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (u32 i = _destructors.size(); i-- > 0;) {
+                if (_destructors[i].object == object) {
+                    _destructors[i].object = nullptr;
+                    break;
+                }
+            }
+
+            object->~T();
+        }
+
+        deallocate(object, sizeof(T));
+    }
+
+
+    /// Allocate memory for an object of the given size aligned to `ALIGNMENT`.
+    void *allocate(u32 size) noexcept {
+        if (size > MAX_SMALL_SIZE) {
+            return allocate_large(size);
+        }
+
+        u32 class_index = SIZE_CLASS_TABLE.classes[(size + ALIGNMENT - 1) / ALIGNMENT];
+        SizeClass &size_class = _classes[class_index];
+
+        if (size_class.free_slots != nullptr) {
+            FreeSlot *slot = size_class.free_slots;
+            size_class.free_slots = slot->next;
+            return slot;
+        }
+
+        if (size_class.cursor == size_class.end) {
+            allocate_page(size_class, SIZE_CLASSES[class_index]);
+        }
+
+        void *data = size_class.cursor;
+        size_class.cursor += SIZE_CLASSES[class_index];
+        return data;
+    }
+
+
+    /// Return memory of the given size to the arena.
+    void deallocate(void *data, u32 size) noexcept;
+
+
+    /// Destroy every object and release all memory.
+    void clear() noexcept;
+
+
+private:
+
+
+    /// Allocate a new page for the size class.
+    void allocate_page(SizeClass &size_class, u32 slot_size) noexcept;
+
+
+    /// Allocate an object larger than the largest size class.
+    void *allocate_large(u32 size) noexcept;
+};
+
+
+inline constexpr MjItemArena::SizeClassTable MjItemArena::SIZE_CLASS_TABLE{};
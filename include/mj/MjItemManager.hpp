@@ -1,12 +1,44 @@
 #pragma once
 
-#include <mj/ast/MjProgram.hpp>
+#include <mj/ast/MjItem.hpp>
+#include <mj/ast/MjExpressionTree.hpp>
+#include <mj/MjItemArena.hpp>
 #include <mj/MjSourceManager.hpp>
 
+#include <memory>
+#include <mutex>
+#include <thread>
 
+
+/// The item manager owns the AST items of every module.
+///
+/// Each module has an arena per thread which parses it, so that a module can be discarded and
+/// parsed again without touching the items of the other modules. Modules are identified by their
+/// index, such as their index in the module graph.
 class MjItemManager {
 private:
+
+    struct ThreadArena {
+        u32 module_id;
+        std::thread::id thread_id;
+        std::unique_ptr<MjItemArena> arena;
+    };
+
+    // The arena last used by this thread, and the IDs of the manager and module which own it.
+    struct ArenaCache {
+        u64 manager_id = 0;
+        u32 module_id = 0;
+        MjItemArena *arena = nullptr;
+    };
+
+
+    static thread_local ArenaCache _arena_cache;
+
     MjSourceManager _source_manager;
+    std::mutex _sources_mutex;
+    std::mutex _arenas_mutex;
+    std::vector<ThreadArena> _arenas;
+    const u64 _id;
 public:
 
 
@@ -15,6 +47,9 @@ public:
     ///
 
 
+    MjItemManager() noexcept;
+
+
     MjItemManager(const MjItemManager &) = delete;
 
 
@@ -45,13 +80,57 @@ public:
     }
 
 
+    /// The total number of bytes reserved by the arenas of all modules and threads.
+    u64 reserved_size() noexcept;
+
+
     ///
     /// Methods
     ///
 
 
+    /// Add the source file of a module and return its source ID, which locates the items parsed
+    /// from it. Threads may add files concurrently, but not while the sources are queried.
+    u32 add_source_file(const MjSourceFile *source_file) noexcept {
+        std::lock_guard lock(_sources_mutex);
+        return _source_manager.add_source_file(source_file);
+    }
+
+
+    /// Create an item of a module in the arena of the calling thread. Items live until their
+    /// module is cleared or the manager is destroyed, so threads may parse in parallel without
+    /// contending on the heap.
     template<IsMjItem T, class... Args>
-    T *new_item(Args... args) noexcept {
-        return new T(args...);
+    T *new_item(u32 module_id, Args... args) noexcept {
+        return arena(module_id).create<T>(args...);
     }
+
+
+    /// Create an expression tree of a module in the arena of the calling thread. It lives as long
+    /// as the items which view it.
+    MjExpressionTree *new_expression_tree(u32 module_id) noexcept {
+        return arena(module_id).create<MjExpressionTree>();
+    }
+
+
+    /// Destroy every item of a module at once, such as when the module is discarded. The items of
+    /// other modules are kept. No other thread may create items of the module while it is cleared.
+    void clear(u32 module_id) noexcept;
+
+
+private:
+
+
+    /// Return the arena of a module for the calling thread.
+    MjItemArena &arena(u32 module_id) noexcept {
+        if (_arena_cache.manager_id == _id && _arena_cache.module_id == module_id) {
+            return *_arena_cache.arena;
+        }
+
+        return attach_arena(module_id);
+    }
+
+
+    /// Find or create the arena of a module for the calling thread and cache it.
+    MjItemArena &attach_arena(u32 module_id) noexcept;
 };
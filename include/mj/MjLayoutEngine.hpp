@@ -0,0 +1,130 @@
+#pragma once
+
+#include <mj/ast/MjType.hpp>
+
+#include <vector>
+
+
+class MjAnnotation;
+class MjMember;
+class MjSourceManager;
+
+
+/// Computes the size, alignment, padding and member offsets of types.
+///
+/// The layout of each type is computed once and cached in the type, so that the layout of nested
+/// types is not recomputed by every type containing them. Members are laid out in declaration
+/// order, each at the next offset satisfying its alignment. The layout is controlled by the
+/// following annotations:
+///
+/// - `@alignment(N)` on a type or member raises its alignment to `N`, which is a power of two.
+/// - `@offset(N)` on a member places it at offset `N`, after the previous member.
+/// - `@size(N)` on a type pads it to `N` bytes.
+///
+/// A type containing itself by value, directly or through its members, has no layout. Pointers,
+/// slices and functions do not depend on the layout of the types they refer to.
+///
+/// When member reordering is enabled, the members of structure and class types are placed in order
+/// of decreasing alignment if that makes the type smaller. The declaration order is kept, and only
+/// the offsets of the members change. Types with a member pinned by `@offset` are laid out in
+/// declaration order.
+class MjLayoutEngine {
+public:
+
+    struct Saving {
+        const MjType *type;
+        u32 declared_size;                  // The size of the type in declaration order
+        u32 size;                           // The size of the type with its members reordered
+    };
+private:
+
+    struct Placement {
+        MjMember *member;
+        u32 size;
+        u32 alignment;
+        u32 offset;                         // The pinned offset or `NONE`
+    };
+
+
+    const MjSourceManager &_sources;
+    std::vector<const MjType *> _stack;     // The types whose layout is being computed, outermost first
+    std::vector<Saving> _savings;           // The types made smaller by reordering their members
+    bool _reorder_members = false;
+public:
+
+
+    static constexpr u32 POINTER_SIZE = 8;
+    static constexpr u32 NONE = 0xFFFFFFFFu;
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    MjLayoutEngine(const MjSourceManager &sources) noexcept : _sources(sources) {}
+
+
+    ///
+    /// Properties
+    ///
+
+
+    bool reorders_members() const noexcept {
+        return _reorder_members;
+    }
+
+
+    /// The types made smaller by reordering their members, in the order they were laid out.
+    const std::vector<Saving> &savings() const noexcept {
+        return _savings;
+    }
+
+
+    ///
+    /// Methods
+    ///
+
+
+    void set_reorder_members(bool reorder_members) noexcept {
+        _reorder_members = reorder_members;
+    }
+
+
+    /// Compute the layout of a type and of the types of its members, unless already computed.
+    Error layout(MjType *type) noexcept;
+
+
+    /// Print the bytes saved by reordering the members of each type, followed by the total.
+    void print_savings() const noexcept;
+
+
+private:
+
+
+    Error layout_aggregate(MjType *type) noexcept;
+
+
+    /// Assign the offsets of the members in the given order, along with the alignment and padding
+    /// of the type, and return the size occupied by the members.
+    Error place(MjType *type, const std::vector<Placement> &placements, u32 &used_size) noexcept;
+
+
+    Error layout_union(MjType *type) noexcept;
+
+
+    /// Copy the layout of the type stored in place of the given type.
+    Error layout_as(MjType *type, MjType *base_type) noexcept;
+
+
+    /// Apply the `@alignment` and `@size` annotations of a type to its natural layout.
+    Error apply_type_annotations(MjType *type, u32 used_size) noexcept;
+
+
+    /// Find an annotation by name and parse its argument. Return false if there is no annotation.
+    bool find_annotation(Slice<MjAnnotation *const> annotations, StringView name, u32 &value, Error &error) const noexcept;
+
+
+    /// Print a layout error along with the chain of types being laid out.
+    void error(const MjType *type, const char *message) const noexcept;
+};
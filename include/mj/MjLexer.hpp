@@ -1,11 +1,10 @@
 #pragma once
 
 #include <mj/MjLexerError.hpp>
-#include <mj/MjLexerState.hpp>
+#include <mj/MjLexerCheckpoint.hpp>
 #include <mj/ast/MjSourceFile.hpp>
 
 #include <vector>
-#include <stack>
 #include <filesystem>
 
 
@@ -16,63 +15,85 @@
 /// contexts by tracking state and indentation.
 class MjLexer {
 private:
-    std::vector<u16> _string_ids; // The string IDs referenced in this file. (used for symbol lookup and removal)
-    std::vector<u8> _data;
+    std::vector<u32> _string_ids; // The string IDs referenced in this file. (used for symbol lookup and removal)
     const u8 *_ch;
 
     MjSourceFile &_file;
 
     std::vector<MjLexerError> _errors;
+    Error _error = Error::SUCCESS; // Set when the file can not be lexed at all
 
     u32 _line_index = 0;
-    u32 _token_offset = 0;
     u8 _line_indent = 0;
     u8 _last_indent = 0;
+    u32 _recorded_line_count = 0; // The number of lines when the last line start was recorded.
 
-    std::stack<MjLexerState> _states;
+    MjLexerStateStack _states;
     MjLexerState _state = MjLexerState::NONE;
     bool _emit_subtokens;
-    bool _has_leading_whitespace;
-    bool _has_trailing_whitespace;
-    bool _skip_comments;
+    bool _records_line_starts;
+    bool _has_leading_whitespace = true; // Set if the next token is preceded by spaces or starts a line.
 
     static constexpr u32 INDENT_WIDTH = 4;
+
+    // The number of line starts a chunk is lexed past its end, to overlap with the next chunk.
+    static constexpr u32 CHUNK_OVERLAP_LINE_COUNT = 4;
 public:
 
 
+    /// Load and tokenize the file at the given path.
+    ///
+    /// The file text is mapped rather than copied, and it is followed by a null byte which acts as
+    /// a sentinel value for detecting and handling the end of the file by failing to satisfy all
+    /// parse rules. The returned source file keeps the text for the lifetime of the file.
+    ///
+    /// If `records_line_starts` is set, the lexer state is recorded at the start of every line so
+    /// that the file can be edited incrementally with `parse_edit()`.
     static
-    MjSourceFile *parse_file(std::filesystem::path file_path, bool emit_subtokens = false) noexcept;
+    MjSourceFile *parse_file(std::filesystem::path file_path, bool emit_subtokens = false, bool records_line_starts = false) noexcept;
 
 
-private:
+    /// Tokenize the already loaded text of the file at the given path.
+    static
+    MjSourceFile *parse_text(
+        std::filesystem::path file_path,
+        MjSourceText &&text,
+        bool emit_subtokens = false,
+        bool records_line_starts = false
+    ) noexcept;
 
 
-    /// Load the file data into the internal buffer and append a null byte which will act as a
-    /// sentinel value for detecting and handling the end of the file by failing to satisfy all
-    /// parse rules.
+    /// Apply a text edit to a file lexed with line starts recorded, and re-lex only the lines
+    /// from the nearest line start before the edit until the lexer state matches an unchanged
+    /// line start again. The tokens of the unchanged lines are spliced back into the stream.
     static
-    std::vector<u8> load_file_data(std::filesystem::path file_path) noexcept;
+    Error parse_edit(MjSourceFile &file, const MjTextEdit &edit, bool emit_subtokens = false) noexcept;
 
 
-private:
+    /// Lex a chunk of the text of a file from the zero-indent line at `begin` until a few line
+    /// starts past `end`, recording a checkpoint at every line start. The chunk may be the file
+    /// itself or a file sharing a view of its text, so that chunks can be lexed concurrently.
+    static
+    Error parse_chunk(MjSourceFile &chunk, u32 begin, u32 end, bool emit_subtokens = false) noexcept;
 
 
-    MjLexer(MjSourceFile &file, bool emit_subtokens = false) noexcept :
-        _file(file),
-        _emit_subtokens(emit_subtokens)
-    {}
+    /// Merge the next chunk into a file lexed up to and past the start of the chunk.
+    ///
+    /// The tokens of the chunk are appended from the first line start where both were lexed in the
+    /// same state, so the result is the same as lexing the file serially. If there is no such line
+    /// start, the file is lexed on serially through the chunk instead, and `is_merged` is cleared.
+    static
+    Error merge_chunk(MjSourceFile &file, const MjSourceFile &chunk, bool &is_merged, bool emit_subtokens = false) noexcept;
 
 
-    ///
-    /// Properties
-    ///
+private:
 
 
-    /// @brief Parse any token.
-    /// @return The type of token was parsed.
-    MjToken token() noexcept {
-        return &_file.tokens().back();
-    }
+    MjLexer(MjSourceFile &file, bool emit_subtokens = false, bool records_line_starts = false) noexcept :
+        _file(file),
+        _emit_subtokens(emit_subtokens),
+        _records_line_starts(records_line_starts)
+    {}
 
 
     ///
@@ -84,59 +105,59 @@ private:
     Error parse() noexcept;
 
 
-    /// @brief Parse any token.
-    /// @return The type of token was parsed.
-    Error parse_token(MjTokenKind token_kind) noexcept;
+    /// Parse from the line at `begin` until `CHUNK_OVERLAP_LINE_COUNT` line starts past `end`.
+    Error parse_range(u32 begin, u32 end) noexcept;
 
 
-    /// Parse the next token or sequence of associated tokens.
+    /// Parse the next token or sequence of associated tokens, or the end of the line.
+    ///
+    /// The kind of a token is decided by its text, the text next to it, and the lexer state, and
+    /// never by the tokens already emitted, so that lexing can resume from any line start.
     Error parse_token() noexcept;
 
 
-    /// Parse a type expression.
-    ///
-    /// A type expression begins with either a type name or a CV-qualifier and is followed by zero
-    /// or more type qualifiers.
-    Error parse_type_expression() noexcept;
-    Error parse_shell_option() noexcept;
-    Error parse_shell_token() noexcept;
+    /// Parse an operator, a separator, a bracket, a comment, or a string literal.
+    Error parse_operator() noexcept;
 
 
-    Error parse_annotation() noexcept;
+    /// Parse a line comment or a block comment up to the end of the line.
+    Error parse_comment() noexcept;
 
 
+    /// Parse the name of an annotation after the `@`.
     Error parse_annotation_name() noexcept;
 
 
-    Error parse_constant_name() noexcept;
-    Error parse_variable_name() noexcept;
-
-
-    /// Parse an identifier. Either a keyword, function, type, constant, module, literal, or variable.
+    /// Parse a word starting with a lowercase letter or an underscore. Either a keyword, a
+    /// builtin type, a function, a module, or a variable name.
     Error parse_identifier() noexcept;
 
 
-    Error parse_keyword() noexcept;
-
-    // Parse a user-defined type or module name. (Will not check for keywords)
+    /// Parse a word starting with an uppercase letter. Either a type or a constant name.
     Error parse_type_name() noexcept;
 
 
-    /// Parse a numeric literal.
+    /// Parse a numeric literal, and a unit expression after it.
     Error parse_numeric_literal() noexcept;
 
 
-    /// Return the size in bytes of the next token if it is a valid numeric type name or zero.
+    /// Return the size in bytes of the numeric type name at the given text if it is valid, or
+    /// zero. A lone `f`, `i`, or `u` is a suffix of size one.
     /// NOTE: The end of word boundary is not tested.
-    u32 peek_numeric_type_name_size() noexcept;
+    static
+    u32 peek_numeric_type_name_size(const u8 *ch) noexcept;
 
 
-    /// Parse a unit expression.
+    /// Parse a unit expression. Nothing is consumed if there is none.
     Error parse_unit_expression() noexcept;
 
 
-    /// Parse an interpolated string literal.
-    Error parse_interpolated_string_literal() noexcept;
+    /// Parse a string literal, which is interpolated if it has escape sequences or `{}` blocks.
+    Error parse_string_literal() noexcept;
+
+
+    /// Parse a raw string literal up to the next `'` on the line.
+    Error parse_raw_string_literal() noexcept;
 
 
     ///
@@ -144,24 +165,22 @@ private:
     ///
 
 
-    /// Skip all leading whitespace characters, moving to the next non-empty line.
+    /// Skip the spaces before a token.
     ///
-    /// The fast path is to parse zero or one space characters.
-    /// Any whitespaces not implicitly encoded by relative whitespace rules are represented by a whitespace token.
-    /// The whitespace token is ignored by all token stream processing operations, and only serves to encode
-    /// The offset of subsequent tokens within the source line.
-    /// spaces at the end of a line are not stored in the token stream.
-    /// Whitespace tokens and empty line tokens can be omitted, but the resulting token stream would not
-    /// be an accurate representation of all token source locations.
+    /// The whitespace between tokens is implied by their kinds, as given by
+    /// `MjTokenKind::has_whitespace()`, so it is not stored in the token stream. Only the
+    /// indentation of a line which is not a multiple of `INDENT_WIDTH` is stored, as a whitespace
+    /// token after the indent token.
     void parse_whitespace() noexcept;
 
 
-    /// Parse the indentation of the current line, skipping empty lines.
+    /// Parse the indentation of the current line and append its indent token. Empty lines and
+    /// lines of only spaces have no indentation.
     void parse_indent() noexcept;
 
 
-    /// Move the parser to the next line.
-    bool parse_newline() noexcept;
+    /// Move the parser past the end of the current line to the start of the next one.
+    void parse_newline() noexcept;
 
 
     /// Return true if the end of the file has been reached.
@@ -170,82 +189,114 @@ private:
     }
 
 
+    /// Return true if the text at `_ch` ends a line, with or without a carriage return.
+    bool is_end_of_line() const noexcept {
+        return *_ch == '\n' || *_ch == '\0' || (*_ch == '\r' && _ch[1] == '\n');
+    }
+
+
+    /// Return true if the token at `_ch` is attached to an operand before it, as with a postfix
+    /// operator or an infix operator written without spaces.
+    bool follows_operand() const noexcept;
+
+
     ///
     /// State Control
     ///
 
 
+    /// Enter a state without the given state, as with `push_state()`.
     void clear_state(MjLexerState state) noexcept {
-        _state &= ~state;
-        _states.push(state);
+        MjLexerState cleared = _state;
+        cleared &= ~state;
+        push_state(cleared);
     }
 
 
+    /// Enter a nested state, saving the current state until the matching `pop_state()`.
     void push_state(MjLexerState state) noexcept {
-        //_state |= state;
-        _states.push(state);
+        _states.push(_state);
+        _state = state;
     }
 
 
+    /// Leave the current state and return to the state it was entered from.
     void pop_state() noexcept {
         _state = _states.top();
         _states.pop();
     }
 
 
-
-    /// @brief Save the Lexer state so that the current position can be restored if a subsequent parse operation fails.
-    //MjLexerPosition save() noexcept {
-    //    return {
-    //        static_cast<u32>(_file.tokens().size()),
-    //        _line_index,
-    //        static_cast<u16>(_file.line(_line_index).size() - _line.size()),
-    //        _line_indent,
-    //        _last_indent
-    //    };
-    //}
-
-
-    /// @brief Restore the lexer state from a previously saved position.
-    /// @param position The lexer position.
-    //void restore(const MjLexerPosition &position) noexcept {
-    //    _file.tokens().resize(position.tokens_size);
-    //    _line = _file.line(position.line_index) + position.byte_offset;
-    //    _line_index = position.line_index;
-    //    _line_indent = position.indent;
-    //    _last_indent = position.last_indent;
-    //}
+    /// Leave the state of a bracket at a closing bracket, or record an error if the bracket was
+    /// never opened. Template argument lists left open inside the bracket are closed with it.
+    void close_bracket(MjLexerState state, StringView message) noexcept;
 
 
     ///
-    /// Error Handling
+    /// Checkpoints
     ///
 
 
-    void error(MjToken token, MjSubToken subtoken, StringView message) noexcept;
-
+    /// Save the lexer state so that the current position can be restored if a subsequent parse
+    /// operation fails. Saving does not allocate unless brackets nest past the inline capacity of
+    /// the state stack.
+    MjLexerCheckpoint save() const noexcept {
+        return {
+            .text_offset = u32(_ch - _file.text().data()),
+            .token_offset = u32(_file.tokens().size()),
+            .line_count = _file.line_count(),
+            .state = _state,
+            .line_indent = _line_indent,
+            .last_indent = _last_indent,
+            .last_token_byte = _file.tokens().empty() ? u8(0) : _file.tokens().back(),
+            .has_leading_whitespace = _has_leading_whitespace,
+            .states = _states,
+        };
+    }
 
-    void error(MjToken token, StringView message) noexcept;
 
+    /// Restore the lexer state from a previously saved checkpoint, removing any tokens and lines
+    /// added since.
+    void restore(const MjLexerCheckpoint &checkpoint) noexcept {
+        _file.truncate_tokens(checkpoint.token_offset, checkpoint.line_count);
+        _ch = _file.text().data() + checkpoint.text_offset;
+        _state = checkpoint.state;
+        _states = checkpoint.states;
+        _line_indent = checkpoint.line_indent;
+        _last_indent = checkpoint.last_indent;
+        _has_leading_whitespace = checkpoint.has_leading_whitespace;
 
-    void error(StringView message) noexcept {
-        error(token(), message);
+        // Every indent token starts a new line, so the line index is the number of lines so far.
+        _line_index = checkpoint.line_count;
     }
 
 
-private:
+    /// Record a checkpoint if a line has started since the last record, and return true if one
+    /// was recorded. This is called between tokens, where the state is complete, so lexing can
+    /// resume from any record.
+    bool record_line_start() noexcept;
 
 
-    static
-    constexpr
-    bool id_is_reserved_name(u16 id) noexcept {
-        return id < MjTokenKind::reserved_names().size();
+    ///
+    /// Error Handling
+    ///
+
+
+    /// Record an error at the given text.
+    void error(const u8 *token_data, u32 token_size, StringView message) noexcept {
+        _errors.emplace_back(u32(token_data - _file.text().data()), token_size, message);
     }
 
 
-    static
-    constexpr
-    MjTokenKind from_id(u16 id) noexcept {
-        return MjTokenKind(MjTokenKind::AND + id);
+    /// Print the recorded errors with the lines they are on.
+    void print_errors() const noexcept;
+
+
+    /// Append a string token, or fail the file once it has run out of string IDs.
+    void append_string_token(MjTokenKind token_kind, StringView token_text) noexcept {
+        if (_file.append_string_token(token_kind, token_text).is_failure() && _error.is_success()) {
+            printf("Failed to lex file! '%s' has more than %u strings.\n", _file.path().c_str(), MjSourceFile::MAX_STRING_COUNT);
+            _error = Error::FAILURE;
+        }
     }
 };
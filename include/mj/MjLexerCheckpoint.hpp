@@ -0,0 +1,143 @@
+#pragma once
+
+#include <mj/MjLexerState.hpp>
+
+#include <vector>
+
+
+/// A stack of lexer states stored inline up to a fixed depth, so that it can be copied into a
+/// checkpoint without allocating. Deeper states spill to the heap.
+class MjLexerStateStack {
+public:
+    static constexpr u32 INLINE_CAPACITY = 24;
+private:
+    u16 _states[INLINE_CAPACITY] = {}; // The state IDs from the bottom of the stack.
+    std::vector<u16> _spilled_states;  // The state IDs past the inline capacity.
+    u32 _size = 0;
+public:
+
+
+    ///
+    /// Operators
+    ///
+
+
+    constexpr
+    bool operator==(const MjLexerStateStack &other) const noexcept {
+        if (_size != other._size) {
+            return false;
+        }
+
+        for (u32 i = 0; i < _size && i < INLINE_CAPACITY; ++i) {
+            if (_states[i] != other._states[i]) {
+                return false;
+            }
+        }
+
+        return _spilled_states == other._spilled_states;
+    }
+
+
+    ///
+    /// Properties
+    ///
+
+
+    constexpr
+    u32 size() const noexcept {
+        return _size;
+    }
+
+
+    constexpr
+    bool is_empty() const noexcept {
+        return _size == 0;
+    }
+
+
+    /// The state on top of the stack, or `NONE` if the stack is empty.
+    constexpr
+    MjLexerState top() const noexcept {
+        if (_size == 0) {
+            return MjLexerState::NONE;
+        }
+
+        if (_size > INLINE_CAPACITY) {
+            return MjLexerState(_spilled_states.back());
+        }
+
+        return MjLexerState(_states[_size - 1]);
+    }
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// Push a state, spilling it to the heap past the inline capacity.
+    constexpr
+    void push(MjLexerState state) noexcept {
+        if (_size < INLINE_CAPACITY) {
+            _states[_size] = state;
+        } else {
+            _spilled_states.push_back(state);
+        }
+
+        _size += 1;
+    }
+
+
+    /// Pop a state, unless the stack is empty, as when a closing bracket has no opening one.
+    constexpr
+    void pop() noexcept {
+        if (_size > INLINE_CAPACITY) {
+            _spilled_states.pop_back();
+        }
+
+        if (_size != 0) {
+            _size -= 1;
+        }
+    }
+};
+
+
+/// A snapshot of the lexer, from which lexing can resume.
+///
+/// A checkpoint only allocates when brackets nest past the inline capacity of the state stack,
+/// so it can be stored at every line start of a file for incremental lexing, or taken before a
+/// speculative sub-parse and restored if it fails.
+struct MjLexerCheckpoint {
+    u32 text_offset;  // The offset of the lexer in the source text in bytes.
+    u32 token_offset; // The size of the token stream.
+    u32 line_count;   // The number of line offsets.
+    MjLexerState state;
+    u8 line_indent;
+    u8 last_indent;
+    u8 last_token_byte; // The last byte of the token stream, which is restored ahead of a re-lexed edit.
+    bool has_leading_whitespace;
+    MjLexerStateStack states;
+
+
+    ///
+    /// Properties
+    ///
+
+
+    /// Return true if lexing from both checkpoints behaves the same given the same text.
+    ///
+    /// Only the state which the lexer reads after a line start is compared. The indentation of the
+    /// previous line is recorded but never read, so checkpoints of a chunk, which starts without a
+    /// previous line, can match those of the whole file.
+    constexpr
+    bool has_same_state(const MjLexerCheckpoint &other) const noexcept {
+        return (
+            state == other.state &&
+            line_indent == other.line_indent &&
+            last_token_byte == other.last_token_byte &&
+            has_leading_whitespace == other.has_leading_whitespace &&
+            states == other.states
+        );
+    }
+};
+
@@ -9,16 +9,41 @@
 // Semantics  Lexer
 class MjLexerError {
 private:
-    MjToken _token;
+    u32 _text_offset; // The offset of the erroneous text in bytes.
+    u32 _size;        // The size of the erroneous text in bytes.
     StringView _message;
 public:
 
 
     constexpr
-    MjLexerError(MjToken token, StringView message) noexcept :
-        _token(token),
+    MjLexerError(u32 text_offset, u32 size, StringView message) noexcept :
+        _text_offset(text_offset),
+        _size(size),
         _message(message)
     {}
+
+
+    ///
+    /// Properties
+    ///
+
+
+    constexpr
+    u32 text_offset() const noexcept {
+        return _text_offset;
+    }
+
+
+    constexpr
+    u32 size() const noexcept {
+        return _size;
+    }
+
+
+    constexpr
+    StringView message() const noexcept {
+        return _message;
+    }
 };
 
 
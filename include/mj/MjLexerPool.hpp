@@ -0,0 +1,135 @@
+#pragma once
+
+#include <mj/MjLexer.hpp>
+#include <mj/MjStringInterner.hpp>
+#include <mj/MjTokenCache.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <vector>
+
+
+/// Lex many independent source files in parallel.
+///
+/// Each source file owns its strings and tokens, so files are lexed without any shared state. The
+/// files are ordered largest first and dealt round-robin to one queue per worker. A worker takes
+/// work from the front of its own queue and, when it runs dry, steals from the back of another,
+/// which leaves the small files at the end of every queue to balance the tail.
+class MjLexerPool {
+private:
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<u32> file_indices;
+    };
+
+
+    const std::vector<std::filesystem::path> &_file_paths;
+    std::vector<MjSourceFile *> _files;
+    std::vector<u64> *_durations;
+    std::vector<WorkQueue> _queues;
+    const MjTokenCache *_cache;
+    MjStringInterner *_interner;
+    bool _emit_subtokens;
+
+    // A single file is only split into chunks of at least this size.
+    static constexpr u32 MIN_CHUNK_SIZE = 1u << 20;
+public:
+
+
+    /// Lex the files at the given paths using up to `thread_count` threads, including the calling
+    /// thread. The returned files are in the order of the given paths, so that source IDs assigned
+    /// from them are deterministic. Files which failed to load are null.
+    ///
+    /// Unchanged files are decoded from the token cache if one is given, in which case the cache
+    /// decides whether subtokens are emitted. The strings of each file are interned on the worker
+    /// thread if an interner is given.
+    ///
+    /// If `durations` is given, it is set to the time spent on each file in nanoseconds, in the
+    /// order of the given paths.
+    static
+    std::vector<MjSourceFile *> parse_files(
+        const std::vector<std::filesystem::path> &file_paths,
+        u32 thread_count,
+        const MjTokenCache *cache = nullptr,
+        MjStringInterner *interner = nullptr,
+        bool emit_subtokens = false,
+        std::vector<u64> *durations = nullptr
+    ) noexcept;
+
+
+    /// Lex a single large file using up to `thread_count` threads, including the calling thread.
+    ///
+    /// The text is split into chunks at lines without indentation, which are lexed concurrently into
+    /// separate token streams and string sets, each running a few lines into the next chunk. The
+    /// chunks are then merged in order where their lexer states agree, remapping the string IDs
+    /// and concatenating the line offsets, so the result is identical to `MjLexer::parse_file()`.
+    /// Return null if the file failed to load.
+    ///
+    /// If `relexed_chunk_count` is given, it is set to the number of chunks whose tokens were
+    /// discarded because the file was lexed serially through them instead.
+    static
+    MjSourceFile *parse_file_chunks(
+        const std::filesystem::path &file_path,
+        u32 thread_count,
+        bool emit_subtokens = false,
+        u32 *relexed_chunk_count = nullptr
+    ) noexcept;
+
+
+    /// The offsets of the zero-indent lines at which `parse_file_chunks()` splits the text for the
+    /// given thread count, followed by the size of the text. There is at most one chunk per thread
+    /// and per `MIN_CHUNK_SIZE` bytes.
+    static
+    std::vector<u32> chunk_offsets(const MjSourceText &text, u32 thread_count) noexcept;
+
+
+private:
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    MjLexerPool(
+        const std::vector<std::filesystem::path> &file_paths,
+        u32 thread_count,
+        const MjTokenCache *cache,
+        MjStringInterner *interner,
+        bool emit_subtokens,
+        std::vector<u64> *durations
+    ) noexcept :
+        _file_paths(file_paths),
+        _files(file_paths.size(), nullptr),
+        _durations(durations),
+        _queues(std::clamp<u32>(thread_count, 1, std::max<u32>(file_paths.size(), 1))),
+        _cache(cache),
+        _interner(interner),
+        _emit_subtokens(emit_subtokens)
+    {}
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// Run the workers on the calling thread and `_queues.size() - 1` new threads.
+    std::vector<MjSourceFile *> run() noexcept;
+
+
+    /// Deal the files to the worker queues, largest first.
+    void schedule() noexcept;
+
+
+    /// Lex files until every queue is empty.
+    void work(u32 worker_index) noexcept;
+
+
+    /// Take the next file index for the worker, stealing from other workers if its own queue is
+    /// empty. Return false when there is no work left.
+    bool take(u32 worker_index, u32 &file_index) noexcept;
+};
@@ -3,18 +3,19 @@
 #include <mj/ast/MjToken.hpp>
 
 
+/// The lexer states are distinct bits, so that a state can be tested with a mask.
 template<class MjLexerState>
 struct MjLexerStateValues {
     static constexpr MjLexerState NONE{0};
-    static constexpr MjLexerState IN_ANNOTATION{5 << 1};
-    static constexpr MjLexerState IN_TYPE_EXPRESSION{6 << 1};
-    static constexpr MjLexerState IN_TYPE_CAST{7 << 1};
-    static constexpr MjLexerState IN_PARENTHESES{8 << 1};
-    static constexpr MjLexerState IN_SQUARE_BRACKETS{9 << 1};
-    static constexpr MjLexerState IN_ANGLE_BRACKETS{10 << 1};
-    static constexpr MjLexerState IN_CURLY_BRACES{11 << 1};
-    static constexpr MjLexerState IN_SUBSHELL{12 << 1};
-    static constexpr MjLexerState IN_SHELL{13 << 1};
+    static constexpr MjLexerState IN_ANNOTATION{1 << 0};
+    static constexpr MjLexerState IN_TYPE_EXPRESSION{1 << 1};
+    static constexpr MjLexerState IN_TYPE_CAST{1 << 2};
+    static constexpr MjLexerState IN_PARENTHESES{1 << 3};
+    static constexpr MjLexerState IN_SQUARE_BRACKETS{1 << 4};
+    static constexpr MjLexerState IN_ANGLE_BRACKETS{1 << 5};
+    static constexpr MjLexerState IN_CURLY_BRACES{1 << 6};
+    static constexpr MjLexerState IN_SUBSHELL{1 << 7};
+    static constexpr MjLexerState IN_SHELL{1 << 8};
 };
 
 
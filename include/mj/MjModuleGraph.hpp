@@ -0,0 +1,143 @@
+#pragma once
+
+#include <mj/ast/MjSourceFile.hpp>
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+/// The dependency graph of the modules of a source tree.
+///
+/// Every directory of the tree is a module, named by its path from the root such as `format::json`.
+/// The files of an `@internal` directory belong to the module of its parent directory. A module
+/// depends on the modules named by the import directives of its files, which must form a DAG.
+///
+/// Phases run on a pool of threads in topological order, so a module is processed only after every
+/// module it imports while independent modules are processed concurrently. The time spent on each
+/// module is recorded to report the critical path, which bounds the wall time of the phase.
+class MjModuleGraph {
+public:
+
+    struct Module {
+        std::string name;
+        std::filesystem::path directory_path;
+        std::vector<std::filesystem::path> file_paths;
+        std::vector<MjSourceFile *> files;   // The lexed files, in the order of `file_paths`
+        std::vector<u32> dependencies;       // The modules imported by the module
+        std::vector<u32> dependents;         // The modules importing the module
+        u32 parent;
+        u64 weight = 0;                      // The estimated cost of the module and its dependents
+        u64 duration = 0;                    // The time spent on the module in the last phase, and any file durations added since, in ns
+    };
+
+
+    struct CriticalPath {
+        std::vector<u32> module_indices;     // From the first module to run to the last
+        u64 duration = 0;                    // The sum of the durations of the modules in ns
+    };
+private:
+    std::vector<Module> _modules;
+    std::vector<u32> _order;
+public:
+
+
+    static constexpr u32 NONE = 0xFFFFFFFFu;
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    MjModuleGraph() noexcept {}
+
+
+    MjModuleGraph(const MjModuleGraph &) = delete;
+
+
+    ///
+    /// Operators
+    ///
+
+
+    MjModuleGraph &operator=(const MjModuleGraph &) = delete;
+
+
+    ///
+    /// Properties
+    ///
+
+
+    const std::vector<Module> &modules() const noexcept {
+        return _modules;
+    }
+
+
+    std::vector<Module> &modules() noexcept {
+        return _modules;
+    }
+
+
+    /// The module indices in a topological order, imported modules first.
+    const std::vector<u32> &order() const noexcept {
+        return _order;
+    }
+
+
+    /// The paths of the files of every module, in module order.
+    std::vector<std::filesystem::path> file_paths() const noexcept;
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// List the modules and source files under the root directory.
+    Error load(const std::filesystem::path &root_path) noexcept;
+
+
+    /// Assign the lexed files, in the order of `file_paths()`, and connect the modules named by
+    /// their import directives. Imports of modules outside of the tree are ignored. Fail if the
+    /// imports form a cycle.
+    Error resolve(const std::vector<MjSourceFile *> &files) noexcept;
+
+
+    /// Run a phase on every module using up to `thread_count` threads, including the calling thread.
+    ///
+    /// A module is started once all of its dependencies have finished. Among the ready modules, the
+    /// one with the heaviest chain of dependents is started first.
+    void run(u32 thread_count, const std::function<void(Module &)> &phase) noexcept;
+
+
+    /// Add the time spent on each file in a phase run outside of the graph, in the order of
+    /// `file_paths()`, to the durations of their modules, so that the critical path includes it.
+    /// Lexing runs before the imports are known, so it is timed per file and added after `run()`.
+    void add_file_durations(const std::vector<u64> &durations) noexcept;
+
+
+    /// Return the index of the module with the given name, or `NONE`.
+    u32 find_module(const std::string &name) const noexcept;
+
+
+    /// Return the chain of dependent modules with the longest total duration in the last phase.
+    CriticalPath critical_path() const noexcept;
+
+
+    /// Print the modules with their dependencies, followed by the critical path of the last phase.
+    void print() const noexcept;
+
+
+private:
+
+
+    /// Add the module of a directory and, recursively, of its subdirectories.
+    void add_module(const std::filesystem::path &directory_path, std::string name, u32 parent) noexcept;
+
+
+    /// Return the module named by an import in the given module. The name is searched relative to
+    /// the module and then to each of its ancestors up to the root.
+    u32 resolve_import(u32 module_index, const std::string &name) const noexcept;
+};
@@ -2,61 +2,82 @@
 
 #include <mj/MjItemManager.hpp>
 
+#include <mj/ast/MjModule.hpp>
 #include <mj/ast/MjSourceFile.hpp>
-#include <mj/ast/MjProgram.hpp>
-#include <mj/ast/MjTypeAlias.hpp>
-#include <mj/ast/MjTypeTemplate.hpp>
-#include <mj/ast/MjClassType.hpp>
-#include <mj/ast/MjBitfieldType.hpp>
-#include <mj/ast/MjStructureType.hpp>
-#include <mj/ast/MjUnionType.hpp>
-#include <mj/ast/MjTypeEnumeration.hpp>
-#include <mj/ast/MjTypeImplementation.hpp>
-#include <mj/ast/MjInterfaceType.hpp>
+#include <mj/ast/MjTokenView.hpp>
 
-//#include <mj/internal/MjParserError.hpp>
+#include <string_view>
+#include <unordered_map>
 
-#include <filesystem>
 
+class MjBlockStatement;
+class MjStatement;
 
-// syntax errors (matching braces, termination, sequence)
+
+/// A syntax error at a token.
 class MjParseError {
 private:
-    MjToken _token;
-    StringView _message;
+    u32 _token_index;
+    const char *_message;
 public:
 
 
-    MjParseError(MjToken token, StringView message) noexcept :
-        _token(token),
+    MjParseError(u32 token_index, const char *message) noexcept :
+        _token_index(token_index),
         _message(message)
     {}
+
+
+    /// The index of the token in the token view of the file.
+    u32 token_index() const noexcept {
+        return _token_index;
+    }
+
+
+    const char *message() const noexcept {
+        return _message;
+    }
 };
 
 
-// The parser consumes the output of the lexer and emits the AST components while controlling the parsing context.
+/// The parser consumes the tokens of a source file and creates the items of its module.
+///
+/// Declarations and statements are parsed by recursive descent. Expressions are parsed by a Pratt
+/// parser into the expression tree of the function containing them, so that an expression creates a
+/// single item rather than one per operand and operator. Lines end statements, except within
+/// parentheses and brackets.
+///
+/// Type names are resolved within the module. Every reference to a name shares one type alias,
+/// which is resolved once the module defines the name; names the module does not define, such as
+/// imported types, remain unresolved aliases. Template arguments are checked but not stored yet.
 class MjParser {
 private:
     MjItemManager &_item_manager;
+    const u32 _module_id;                   // The module which owns the parsed items
+    const u32 _source_id;                   // The source of the parsed items in the source manager
     const MjSourceFile &_file;
+    MjTokenView _tokens;
+    u32 _token_index = 0;
     Vector<MjParseError> _errors;
-    MjProgram _program;
-    MjToken _token;
+    MjModule *_module = nullptr;
+    MjFunction *_function = nullptr;        // The function whose body is being parsed
+    MjExpressionTree *_expressions = nullptr;
+    Vector<MjComment *> _comments;          // The comments preceding the next declaration
+    Vector<MjAnnotation *> _annotations;    // The annotations preceding the next declaration
+    std::unordered_map<std::string_view, MjType *> _types; // The builtin types and the aliases of type names
 public:
 
 
-    static    
-    MjProgram parse(MjItemManager &item_manager, const MjSourceFile &file) noexcept;
+    /// Parse a source file into the items of a module. The file is added to the source manager of
+    /// the item manager. Print the syntax errors and return null if there are any.
+    static
+    MjModule *parse(MjItemManager &item_manager, u32 module_id, const MjSourceFile &file) noexcept;
 
 
 private:
 
 
-    MjParser(MjItemManager &item_manager, const MjSourceFile &file) noexcept :
-        _item_manager(item_manager),
-        _file(file),
-        _token(_file.tokens().data())
-    {}
+    MjParser(MjItemManager &item_manager, u32 module_id, const MjSourceFile &file) noexcept;
 
 
     ///
@@ -64,18 +85,31 @@ private:
     ///
 
 
+    /// Create an item located at a token.
     template<IsMjItem T, class... Args>
-    T *new_item(Args... args) noexcept {
-        return _item_manager.new_item<T>(args...);
+    T *new_item(u32 token_index, Args... args) noexcept {
+        T *item = _item_manager.new_item<T>(_module_id, args...);
+        item->set_location(_source_id, _tokens.offset(token_index));
+        return item;
     }
 
 
     ///
-    /// Error
+    /// Errors
     ///
 
 
-    void error(StringView message) noexcept;
+    void error(const char *message) noexcept {
+        error(_token_index, message);
+    }
+
+
+    void error(u32 token_index, const char *message) noexcept {
+        _errors.push_back({token_index, message});
+    }
+
+
+    void print_errors() const noexcept;
 
 
     ///
@@ -83,205 +117,167 @@ private:
     ///
 
 
-    void reset(MjToken token) noexcept {
-        _token = token;
+    /// Return true if the parser steps over tokens of this kind: whitespace, line comments, and the
+    /// subtokens of literals.
+    static
+    constexpr
+    bool is_trivia(MjTokenKind kind) noexcept {
+        return kind == MjTokenKind::WHITESPACE || kind == MjTokenKind::LINE_COMMENT || kind == MjTokenKind::FORMATTED_LINE_COMMENT || kind.encoding() == MjTokenEncoding::SUBTOKEN;
     }
 
 
-    void skip_token() noexcept {
-        _token += 1;
-    }
+    /// Return the index of the token following a token, other than trivia.
+    u32 next_index(u32 token_index) const noexcept {
+        if (_tokens.kind(token_index) == MjTokenKind::NONE) {
+            return token_index;
+        }
 
+        do {
+            token_index += 1;
+        } while (is_trivia(_tokens.kind(token_index)));
 
-    StringView token_text() noexcept {
-        return nullptr;//_file.line(_token->line).slice(_token->offset, _token->size);
+        return token_index;
     }
 
 
-    MjToken peek_token() noexcept {
-        return _token + 1;
+    MjTokenKind kind() const noexcept {
+        return _tokens.kind(_token_index);
     }
 
 
-    MjToken peek_token(MjTokenKind type) noexcept {
-        MjToken token = _token + 1;
-        return token.kind() == type ? token : nullptr;
+    MjTokenKind kind(u32 token_index) const noexcept {
+        return _tokens.kind(token_index);
     }
 
 
-    MjToken parse_token() noexcept {
-        return _token;
+    MjToken token() const noexcept {
+        return _tokens.token(_token_index);
     }
 
 
-    MjToken parse_token(MjTokenKind type) noexcept {
-        return _token.kind() == type ? _token : nullptr;
+    StringView token_text(u32 token_index) const noexcept {
+        return _file.text_of(_tokens.token(token_index));
     }
 
 
-    constexpr
-    bool match_token(MjTokenKind type) const noexcept {
-        return _token.kind() == type;
+    void skip_token() noexcept {
+        _token_index = next_index(_token_index);
     }
 
 
-    constexpr
-    Slice<MjToken> tokens_since(MjToken start) const noexcept {
-        return Slice<MjToken>(start, u32(_token - start));
+    bool match_token(MjTokenKind kind) const noexcept {
+        return this->kind() == kind;
     }
 
 
-    ///
-    /// Structure Parsing
-    ///
-
-
-    /// @brief Parse a module
-    /// @return 
-    MjModule *parse_module(std::filesystem::path path) noexcept;
-
-
-    /// @brief Parse a file
-    /// @return 
-    void parse_file(MjModule &module, std::filesystem::path path) noexcept;
-
-
-    /// @brief Parse an item.
-    /// @return 
-    MjItem *parse_item() noexcept;
-
-
-    /// @brief Parse an item.
-    /// @return 
-    MjDirective *parse_directive() noexcept;
+    /// Skip the token if it is of the given kind, and return true if it was.
+    bool parse_token(MjTokenKind kind) noexcept {
+        if (!match_token(kind)) {
+            return false;
+        }
 
+        skip_token();
+        return true;
+    }
 
-    MjAnnotation *parse_annotation() noexcept;
 
+    /// Return true at the start of a line or at the end of the file.
+    bool is_line_end() const noexcept {
+        return match_token(MjTokenKind::INDENT) || match_token(MjTokenKind::NONE);
+    }
 
-    MjComment *parse_comment() noexcept;
 
+    /// Skip the line starts before the next token, within parentheses and brackets.
+    void skip_line_ends() noexcept {
+        while (match_token(MjTokenKind::INDENT)) {
+            skip_token();
+        }
+    }
 
-    ///
-    /// Type Declarations
-    ///
 
+    void skip_line() noexcept {
+        while (!is_line_end()) {
+            skip_token();
+        }
+    }
 
 
-    ///
-    /// Type Definitions
-    ///
+    /// Skip the rest of the line after a syntax error, along with the block it opens, if any.
+    void recover() noexcept;
 
 
-    /// @brief Parse any type declaration
-    /// @return 
-    MjType *parse_type_definition() noexcept;
+    /// Return the index of the token following the tokens of a type starting at a token, or
+    /// `U32_MAX` if the tokens do not form a type. Only the tokens are inspected.
+    u32 skip_type(u32 token_index) const noexcept;
 
 
-    /// @brief Parse a type enumeration.
     ///
-    /// ```mj
-    /// bitfield<BaseType> TypeName {
-    ///     [n:m] field
-    /// }
-    /// ```
+    /// Declarations
     ///
-    /// @return 
-    void parse_bitfield_type_definition(MjType &type) noexcept;
 
 
-    // Parse a class definition:
-    //
-    // - Parse the class type declaration (class Name<>)
-    // - Parse the class definition scope ({...})
-    //     - Parse import statements <-- IN PLACE!!!
-    //     - Parse type aliases
-    //     - Parse the member, shared, and implementation declarations (everything before '{', '=', or ';')
-    //     - Verify type references
-    //     - Parse the member, shared, and implementation definitions
-    MjClassType *parse_class_type_definition() noexcept;
+    void parse_module() noexcept;
 
 
-    MjInterfaceType *parse_interface_type_definition() noexcept;
+    /// Parse a declaration of a module or a type, or a comment or annotation preceding one.
+    void parse_declaration(MjDeclaration *owner) noexcept;
 
 
-    MjStructureType *parse_structure_type_definition() noexcept;
+    /// Parse a `///` comment, which documents the next declaration.
+    void parse_comment() noexcept;
 
 
-    MjUnionType *parse_union_type_definition() noexcept;
+    /// Parse an annotation such as `@alignment(8)`, which applies to the next declaration.
+    void parse_annotation() noexcept;
 
 
-    ///
-    /// Meta Type Parsing Methods
-    ///
+    /// Hand the comments and annotations preceding a declaration to it.
+    void attach_prefix(MjDeclaration *declaration) noexcept;
 
 
-    /// @brief Parse a type alias.
+    /// Parse a structure, class or union definition.
     ///
-    /// ```mj
-    /// type<TypeExpression> NewType
     /// ```
-    ///
-    /// @return 
-    MjTypeAlias *parse_type_alias() noexcept;
+    /// class Name {
+    ///     Declarations
+    /// }
+    /// ```
+    MjType *parse_type_definition() noexcept;
 
 
-    /// @brief Parse a type alias template.
+    /// Parse a variable or a function, which both start with a type.
     ///
-    /// ```mj
-    /// type<TypeExpression> NewType<TemplateParameterList>
     /// ```
-    ///
-    /// @return 
-    void parse_type_alias_template() noexcept;
+    /// Type name = Expression
+    /// Type name(Type parameter, ...) { Statements }
+    /// ```
+    void parse_variable_or_function(MjDeclaration *owner) noexcept;
 
 
-    /// @brief Parse a type enumeration.
-    ///
-    /// ```mj
-    /// enum<IndexType> BaseType {
-    ///     VAL
-    ///     VAL = ...
-    ///     [key] VAL
-    ///     [key] VAL = ...
-    /// }
-    /// ```
-    ///
-    /// @return 
-    MjTypeEnumeration *parse_type_enumeration() noexcept;
+    MjFunction *parse_function(u32 token_index, MjType *return_type) noexcept;
 
 
-    /// @brief Parse a type implementation.
     ///
-    /// ```mj
-    /// impl<InterfaceType> BaseType {
-    ///     ...
-    /// }
-    /// ```
+    /// Types
     ///
-    /// @return 
-    MjTypeImplementation *parse_type_implementation() noexcept;
 
 
-    ///
-    /// Type Expressions
-    ///
+    /// Parse a type, such as `const u8*`, `u32[4]` or `Vector<u32>[]`. Qualifiers apply to the
+    /// named type, and pointer, array and slice modifiers apply to everything before them.
+    MjType *parse_type() noexcept;
 
 
-    /// @brief Parse a type expression.
-    MjTypeExpression *parse_type_expression() noexcept;
+    /// Return the builtin type or the type alias of a type name.
+    MjType *named_type(u32 token_index) noexcept;
 
 
-    /// @brief Parse a generic type name.
-    ///
-    /// ```mj
-    /// TypeName<TypeArguments>
-    /// TypeName<TypeParameters>
-    /// ```
-    MjTypeName *parse_type_name() noexcept;
+    /// Resolve the type alias of a type name to the type defined by the module.
+    void define_type(u32 token_index, MjType *type) noexcept;
 
 
-    MjType *parse_type() noexcept;
+    /// Parse template arguments, which are checked but not stored: every specialization of a
+    /// template refers to the template by name until templates are instantiated.
+    void parse_template_argument_list() noexcept;
 
 
     ///
@@ -289,49 +285,54 @@ private:
     ///
 
 
-    MjStatement *parse_statement() noexcept;
-
+    /// Parse the body of a function into a new expression tree, and hand the body and the tree to
+    /// the function.
+    MjBlockStatement *parse_function_body(MjFunction *function) noexcept;
 
-    MjStatement *parse_variable_declaration() noexcept;
 
+    MjBlockStatement *parse_block_statement() noexcept;
 
-    ///
-    /// Expressions
-    ///
 
+    /// Parse a statement. Return null for lines which create no statement, such as comments.
+    MjStatement *parse_statement() noexcept;
 
-    MjExpression *parse_expression(u32 min_bp = 0) noexcept;
 
+    MjStatement *parse_if_statement() noexcept;
 
-    ///
-    /// Templates
-    ///
 
+    MjStatement *parse_while_loop() noexcept;
 
-    MjTemplateArgument *parse_template_argument() noexcept;
 
+    /// Parse a local variable of the function, such as `u32 a = 1`. The variable is added to the
+    /// function and its initialization is parsed as the assignment `a = 1`.
+    MjStatement *parse_local_variable() noexcept;
 
-    MjTemplateArgumentList *parse_template_argument_list() noexcept;
 
-    MjTemplateParameterList *parse_template_parameter_list() noexcept;
+    /// Parse the expression following a keyword such as `return`, if there is one.
+    MjExpression *parse_optional_expression() noexcept;
 
 
     ///
-    /// Type Templates
+    /// Expressions
     ///
 
 
-    ///
-    /// Function Templates
-    ///
+    MjExpression *parse_expression(u32 min_bp = 0) noexcept;
 
 
-    ///
-    /// Functions
-    ///
+    /// Parse an expression into the current expression tree and return the index of its root node.
+    u32 parse_expression_node(u32 min_bp) noexcept;
+
+
+    /// Parse the arguments of a call following its opening parenthesis and return the call node.
+    u32 parse_call_arguments(MjOperatorKind operator_kind, u32 token_index, u32 callee) noexcept;
 
 
-    MjFunctionArgumentList *parse_function_argument_list() noexcept;
+    /// Parse the elements of an array following its opening bracket and return the array node.
+    u32 parse_array(u32 token_index) noexcept;
 
-    MjFunctionParameterList *parse_function_parameter_list() noexcept;
+
+    u32 append_expression_node(MjExpressionNodeKind kind, MjOperatorKind operator_kind, u32 token_index, u32 lhs, u32 rhs) noexcept {
+        return _expressions->append({kind, operator_kind, 0, token_index, _token_index - token_index, lhs, rhs, MjExpressionTree::NONE});
+    }
 };
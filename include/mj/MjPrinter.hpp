@@ -6,22 +6,21 @@
 #include <mj/ast/MjType.hpp>
 #include <mj/ast/MjTypeImplementation.hpp>
 #include <mj/ast/MjTypeEnumeration.hpp>
+#include <io/OutputBuffer.hpp>
 
 
 // The parser consumes the output of the scanner and emits the AST components while controlling the parsing context.
 class MjPrinter {
 private:
-    File &_out;
-    String _tab;
+    OutputBuffer &_out;
     u32 _depth = 0;
 public:
 
 
     MjPrinter(
-        File &out
+        OutputBuffer &out
     ) :
-        _out(out),
-        _tab("    ")
+        _out(out)
     {}
 
 
@@ -38,11 +37,7 @@ public:
 
 
     void newline(u32 n = 1) {
-        _out.write('\n', n);
-
-        for (u32 i = 0; i < _depth; i++) {
-            _out.write(_tab);
-        }
+        _out.newline(n, _depth);
     }
 
 
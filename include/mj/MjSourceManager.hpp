@@ -1,10 +1,10 @@
 #pragma once
 
-#include <mj/ast/MjTemplate.hpp>
 #include <mj/ast/MjTokenSpan.hpp>
 #include <mj/ast/MjItem.hpp>
 #include <mj/ast/MjSourceFile.hpp>
 #include <mj/ast/MjSourceLocation.hpp>
+#include <mj/MjStringInterner.hpp>
 
 #include <container/Vector.hpp>
 
@@ -12,6 +12,8 @@
 class MjSourceManager {
 protected:
     Vector<const MjSourceFile *> _sources;
+    MjStringInterner _strings;
+public:
 
 
     ///
@@ -19,16 +21,12 @@ protected:
     ///
 
 
-    constexpr
     MjSourceManager() noexcept {}
 
 
     MjSourceManager(const MjSourceManager &) = delete;
 
 
-public:
-
-
     ///
     /// Operators
     ///
@@ -43,11 +41,23 @@ public:
 
 
     constexpr
-    Vector<const MjSourceFile *> sources() const noexcept {
+    const Vector<const MjSourceFile *> &sources() const noexcept {
         return _sources;
     }
 
 
+    /// The strings shared by every source file.
+    MjStringInterner &strings() noexcept {
+        return _strings;
+    }
+
+
+    /// The strings shared by every source file.
+    const MjStringInterner &strings() const noexcept {
+        return _strings;
+    }
+
+
     ///
     /// Source Query Methods
     ///
@@ -55,7 +65,7 @@ public:
 
     /// Return the source ID of the item info.
     u32 source_id_of(MjItemInfo item_info) const noexcept {
-        return (item_info.data() >> 50) & 0xFFFFu;
+        return item_info.source_id();
     }
 
 
@@ -77,43 +87,35 @@ public:
     }
 
 
-    u32 start_token_offset_of(MjItemInfo item_info) const noexcept {
-        return 0;
-    }
-
-
-    u32 end_token_offset_of(MjItemInfo item_info) const noexcept {
-        return 0;
-    }
-
-
-    constexpr
+    /// Return the token at an offset of a source.
     MjToken token_of(u32 source_id, u32 token_offset) const noexcept {
-        return source_of(source_id)->token_at(token_offset);
+        return _sources[source_id]->token_at(token_offset);
     }
 
 
-    constexpr
-    MjTokenSpan tokens_of(u32 source_id, u32 token_offset) const noexcept {
-        return {source_of(source_id)->token_at(token_offset), };
+    /// Return the first token of the item info.
+    MjToken token_of(MjItemInfo item_info) const noexcept {
+        return token_of(item_info.source_id(), item_info.token_offset());
     }
 
 
-    constexpr
-    MjTokenSpan tokens_of(MjItemInfo item_info) const noexcept {
-        return {source_of(item_info)->token_at(token(item_info)), item_info.};
+    /// Return the first token of the item.
+    MjToken token_of(const MjItem *item) const noexcept {
+        return token_of(item->item_info());
     }
 
 
-    constexpr
-    MjTokenSpan tokens_of(const MjItem *item) const noexcept {
-        return tokens_of(item->item_info());
+    /// Return the global string ID of the string token in the source. Equal names in different
+    /// sources have equal global string IDs.
+    u32 global_string_id_of(u32 source_id, MjToken token) const noexcept {
+        return _sources[source_id]->global_string_id(token);
     }
 
 
-    /// Return the source location of the item info.
+    /// Return the source location of the item info, which spans the first token of the item.
     MjSourceLocation source_location_of(MjItemInfo item_info) const noexcept {
-        return MjSourceLocation(source_of(item_info), tokens_of(item_info));
+        MjToken token = token_of(item_info);
+        return MjSourceLocation(source_of(item_info), MjTokenSpan(token, token.size()));
     }
 
 
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <mj/MjStringSet.hpp>
+
+#include <mutex>
+
+
+/// A string set shared by every source file of a program.
+///
+/// Each source file interns its strings once after lexing and keeps a table from its local string
+/// IDs to the global IDs, so later phases compare names across files by ID. The set is split into
+/// `SHARD_COUNT` shards by the hash of the string, each with its own lock, so that files lexed on
+/// different threads rarely contend. A global ID holds the shard index in its low bits and the ID
+/// within the shard in the rest.
+///
+/// Global IDs depend on the order of insertion, so they are stable for the lifetime of the
+/// interner but must not be persisted. The text of a string may be read without locking once no
+/// more strings are being inserted.
+class MjStringInterner {
+private:
+
+    struct Shard {
+        mutable std::mutex mutex;
+        MjLargeStringSet strings;
+    };
+
+
+    static constexpr u32 LOG2_SHARD_COUNT = 6;
+    static constexpr u32 SHARD_COUNT = 1u << LOG2_SHARD_COUNT;
+
+    Shard _shards[SHARD_COUNT];
+public:
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    MjStringInterner() noexcept {}
+
+
+    MjStringInterner(const MjStringInterner &) = delete;
+
+
+    ///
+    /// Operators
+    ///
+
+
+    MjStringInterner &operator=(const MjStringInterner &) = delete;
+
+
+    StringView operator[](u32 id) const noexcept {
+        return string(id);
+    }
+
+
+    ///
+    /// Properties
+    ///
+
+
+    /// The number of strings in all shards. This locks every shard.
+    u32 size() noexcept;
+
+
+    /// The text of the string with the given global ID.
+    StringView string(u32 id) const noexcept {
+        return _shards[id & (SHARD_COUNT - 1)].strings.string(id >> LOG2_SHARD_COUNT);
+    }
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// Intern the string and return its global ID.
+    u32 insert(StringView string) noexcept;
+
+
+    /// Intern the strings and write the global ID of each string to `ids`. The strings are grouped
+    /// by shard so that each shard is locked at most once.
+    void insert(const StringView *strings, u32 *ids, u32 size) noexcept;
+
+
+    /// Return the global ID of the string, or `U32_MAX` if it has not been interned.
+    u32 search(StringView string) const noexcept;
+
+
+private:
+
+
+    /// Return the shard index of the string.
+    static
+    constexpr
+    u32 shard_of(StringView string) noexcept {
+
+        // Calculate the 32 bit FNV-1a hash of the given string.
+        u32 hash = 0x811C9DC5u;
+
+        for (u8 ch : string) {
+            hash = (hash ^ ch) * 0x01000193u;
+        }
+
+        // Use the top bits of a fibonacci hash, which are independent of the bucket index bits
+        // used within the shard.
+        return (hash * 11400714819323198485llu) >> (64 - LOG2_SHARD_COUNT);
+    }
+};
@@ -17,40 +17,39 @@
 /// - Open addressing
 /// - Fibonacci hashing
 /// - FNV-1a hashing
-/// - 255 character string max
-/// - 65535 element max
-/// - 
-class MjStringSet {
+/// - `StringId` sized string max
+/// - `StringId` sized element and string data max
+///
+/// The string ID type sets the width of the string references and, with the hash type, the width
+/// of the buckets. The hash type must be wide enough to index every bucket.
+template<class StringId, class StringHash>
+class MjBasicStringSet {
 private:
 
     struct StringRef {
-        u8 size;
-        u8 chunk;
-        u16 offset;
-
-        constexpr
-        StringRef(u8 size, u16 offset) noexcept : size(size), offset(offset) {}
+        StringId offset;
+        StringId size;
     };
 
     struct Bucket {
-        u16 string_id;   // The string ID (index into `_string_refs`)
-        u16 string_hash; // The hash of the string.
-        u8 string_size;  // The duplicated string size for efficient bucket comparisons on hash collisions
-        u8 psl;          // The Probe Sequence Length of the bucket
+        StringId string_id;     // The string ID (index into `_string_refs`)
+        StringHash string_hash; // The hash of the string.
+        u8 string_size;         // The string size clamped to 255 for efficient bucket comparisons on hash collisions
+        u8 psl;                 // The Probe Sequence Length of the bucket
     };
 
     Bucket *_buckets;
     StringRef *_string_refs; // indexed from token stream. do not re-order
     std::vector<u8> _string_data; // append only bump allocator. indicies stored in `_ids`
     f32 _max_load_factor;
-    u16 _grow_threshold;
-    u16 _capacity; // The allocated size of `_buckets`
-    u16 _size; // The current size of both `_string_refs` and _buckets`
+    u32 _grow_threshold;
+    u32 _capacity; // The allocated size of `_buckets`
+    u32 _size; // The current size of both `_string_refs` and _buckets`
     u8 _log2_capacity;
 public:
 
 
-    MjStringSet(u16 initial_capacity = 8, f32 max_load_factor = 0.75) noexcept :
+    MjBasicStringSet(u32 initial_capacity = 8, f32 max_load_factor = 0.75) noexcept :
         _max_load_factor(max_load_factor),
         _capacity(1),
         _log2_capacity(0)
@@ -68,7 +67,7 @@ public:
     }
 
 
-    ~MjStringSet() {
+    ~MjBasicStringSet() {
         free(_string_refs);
         free(_buckets);
     }
@@ -79,7 +78,7 @@ public:
     ///
 
 
-    StringView operator[](u16 id) const noexcept {
+    StringView operator[](StringId id) const noexcept {
         return string(id);
     }
 
@@ -94,57 +93,63 @@ public:
     }
 
 
-    u16 size() const noexcept {
+    u32 size() const noexcept {
         return _size;
     }
 
 
-    u16 capacity() const noexcept {
+    u32 capacity() const noexcept {
         return _grow_threshold;
     }
 
 
-    u16 real_capacity() const noexcept {
+    u32 real_capacity() const noexcept {
         return _capacity;
     }
 
 
-    u16 space() const noexcept {
+    u32 space() const noexcept {
         return _grow_threshold - _size;
     }
 
 
-    u16 real_space() const noexcept {
+    u32 real_space() const noexcept {
         return _capacity - _size;
     }
 
 
+    /// The total size of the string data in bytes.
+    u32 data_size() const noexcept {
+        return _string_data.size();
+    }
+
+
     f32 load_factor() const noexcept {
         return f32(_size) / _capacity;
     }
 
 
-    StringView string(u16 id) const noexcept {
+    StringView string(StringId id) const noexcept {
         return {string_data(id), string_size(id)};
     }
 
 
-    const u8 *string_data(u16 id) const noexcept {
+    const u8 *string_data(StringId id) const noexcept {
         return &_string_data[_string_refs[id].offset];
     }
 
 
-    u8 string_size(u16 id) const noexcept {
+    StringId string_size(StringId id) const noexcept {
         return _string_refs[id].size;
     }
 
 
-    StringView string_or_null(u16 id) const noexcept {
+    StringView string_or_null(StringId id) const noexcept {
         return has_string_id(id) ? string(id) : nullptr;
     }
 
 
-    bool has_string_id(u16 id) const noexcept {
+    bool has_string_id(StringId id) const noexcept {
         return id < _size;
     }
 
@@ -154,7 +159,7 @@ public:
     }
 
 
-    u16 id_of(StringView string) const noexcept {
+    StringId id_of(StringView string) const noexcept {
         return search(string);
     }
 
@@ -165,7 +170,7 @@ public:
 
 
     void set_max_load_factor(f32 max_load_factor) noexcept {
-        u16 old_grow_threshold = _grow_threshold;
+        u32 old_grow_threshold = _grow_threshold;
         _max_load_factor = max_load_factor;
         _grow_threshold = _capacity * _max_load_factor;
 
@@ -190,17 +195,18 @@ public:
     }
 
 
-    u16 search(StringView string) const noexcept {
-        u16 string_hash = hash(string);
-        u16 bucket_index = index_from_hash(string_hash, _log2_capacity);
+    StringId search(StringView string) const noexcept {
+        StringHash string_hash = hash(string);
+        u32 bucket_index = index_from_hash(string_hash, _log2_capacity);
         Bucket *bucket = &_buckets[bucket_index];
         u8 psl = 1;
 
         while (psl <= bucket->psl) {
             if (
                 string_hash == bucket->string_hash &&
-                string.size() == bucket->string_size &&
-                !std::memcmp(string.data(), string_data(bucket->string_id), bucket->string_size)
+                clamp_size(string.size()) == bucket->string_size &&
+                (bucket->string_size < 0xFFu || string.size() == string_size(bucket->string_id)) &&
+                !std::memcmp(string.data(), string_data(bucket->string_id), string.size())
             ) {
                 return bucket->string_id;
             }
@@ -230,8 +236,8 @@ public:
     }
 
 
-    u16 insert2(StringView string) noexcept {
-        u16 string_id = search(string);
+    StringId insert2(StringView string) noexcept {
+        StringId string_id = search(string);
 
         if (string_id == _size) {
             insert_unique(string);
@@ -241,16 +247,17 @@ public:
     }
 
 
-    u16 insert(StringView string) noexcept {
-        Bucket probe{_size, hash(string), u8(string.size()), 1};
-        u16 bucket_index = index_from_hash(probe.string_hash, _log2_capacity);
+    StringId insert(StringView string) noexcept {
+        Bucket probe{StringId(_size), hash(string), clamp_size(string.size()), 1};
+        u32 bucket_index = index_from_hash(probe.string_hash, _log2_capacity);
         Bucket *bucket = &_buckets[bucket_index];
 
         while (probe.psl <= bucket->psl) {
             if (
                 probe.string_hash == bucket->string_hash &&
                 probe.string_size == bucket->string_size &&
-                !std::memcmp(string.data(), string_data(bucket->string_id), bucket->string_size)
+                (bucket->string_size < 0xFFu || string.size() == string_size(bucket->string_id)) &&
+                !std::memcmp(string.data(), string_data(bucket->string_id), string.size())
             ) {
                 return bucket->string_id;
             }
@@ -280,13 +287,13 @@ public:
         }
 
         *bucket = probe;
-        _string_refs[_size] = {u8(string.size()), u16(_string_data.size())};
+        _string_refs[_size] = {StringId(_string_data.size()), StringId(string.size())};
         _string_data.insert(_string_data.end(), string.begin(), string.end());
         return _size++;
     }
 
 
-    u16 insert_unique(StringView string) noexcept {
+    StringId insert_unique(StringView string) noexcept {
         if (_size >= _grow_threshold) {
             grow();
         }
@@ -309,9 +316,9 @@ public:
     }
 
 
-    u16 insert_unique_no_grow(StringView string) noexcept {
-        rehash_bucket({_size, hash(string), u8(string.size()), 1});
-        _string_refs[_size] = {u8(string.size()), u16(_string_data.size())};
+    StringId insert_unique_no_grow(StringView string) noexcept {
+        rehash_bucket({StringId(_size), hash(string), clamp_size(string.size()), 1});
+        _string_refs[_size] = {StringId(_string_data.size()), StringId(string.size())};
         _string_data.insert(_string_data.end(), string.begin(), string.end());
         return _size++;
     }
@@ -332,7 +339,7 @@ public:
     void reserve(u32 count) {
 
         // Calculate the maximum capacity we need to be able to store without growing.
-        u16 required_capacity = (_size + count) / _max_load_factor;
+        u32 required_capacity = (_size + count) / _max_load_factor;
 
         // Do nothing if we already have enough space.
         if (required_capacity < _capacity) {
@@ -344,7 +351,7 @@ public:
 
         do {
             new_log2_capacity += 1;
-        } while ((1 << new_log2_capacity) < required_capacity);
+        } while ((1u << new_log2_capacity) < required_capacity);
 
         grow(new_log2_capacity - _log2_capacity);
     }
@@ -361,7 +368,7 @@ public:
             }
 
             StringView string = this->string(bucket.string_id);
-            printf("[%4u] [%2u, %04X] %4u: '%.*s'\n", bucket_index, bucket.psl - 1, bucket.string_hash, bucket.string_id, string.size(), string.data());
+            printf("[%4u] [%2u, %04X] %4u: '%.*s'\n", bucket_index, bucket.psl - 1, u32(bucket.string_hash), u32(bucket.string_id), string.size(), string.data());
         }
 
         //printf("Data: [%u] '%.*s'\n", u32(_string_data.size()), u32(_string_data.size()), _string_data.data());
@@ -415,7 +422,7 @@ private:
     void rehash_bucket(Bucket probe) noexcept {
 
         // Initialize the probe with the string metadata.
-        u16 bucket_index = index_from_hash(probe.string_hash, _log2_capacity);
+        u32 bucket_index = index_from_hash(probe.string_hash, _log2_capacity);
         Bucket *bucket = &_buckets[bucket_index];
 
         // Look for the next open bucket.
@@ -434,10 +441,18 @@ private:
     }
 
 
+    /// Return the size stored in a bucket for a string of the given size.
+    static
+    constexpr
+    u8 clamp_size(u32 size) noexcept {
+        return size < 0xFFu ? size : 0xFFu;
+    }
+
+
     /// Map the given hash to a bucket index using the desired index bit width.
     static
     constexpr
-    u16 index_from_hash(u16 hash, u32 index_bit_width) {
+    u32 index_from_hash(StringHash hash, u32 index_bit_width) {
 
         // Apply a fibonacci hash to the given hash to fit the hash in the given number of bits.
         // This becomes the index into the bucket collection whose size is a power of 2.
@@ -448,7 +463,7 @@ private:
     /// Return the hash of the given string.
     static
     constexpr
-    u16 hash(StringView string) noexcept {
+    StringHash hash(StringView string) noexcept {
 
         // Calculate the 32 bit FNV-1a hash of the given string.
         u32 hash = 0x811C9DC5u;
@@ -457,7 +472,18 @@ private:
             hash = (hash ^ ch) * 0x01000193u;
         }
 
-        // Apply a fibonacci hash to the result to fit the hash in 16 bits.
-        return (hash * 11400714819323198485llu) >> 48;
+        // Apply a fibonacci hash to the result to fit the hash in the bits of the hash type.
+        return (hash * 11400714819323198485llu) >> (64 - 8 * sizeof(StringHash));
     }
 };
+
+
+/// The compact string set, with 6 byte buckets and 4 byte string references. The IDs, the string
+/// sizes, and the offsets into the string data are limited to 16 bits, so the total size of the
+/// strings must stay below 64 KiB.
+using MjStringSet = MjBasicStringSet<u16, u16>;
+
+
+/// The large string set, with 12 byte buckets and 8 byte string references, for string data of up
+/// to 4 GiB.
+using MjLargeStringSet = MjBasicStringSet<u32, u32>;
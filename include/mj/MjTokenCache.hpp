@@ -0,0 +1,55 @@
+#pragma once
+
+#include <mj/MjLexer.hpp>
+
+#include <filesystem>
+
+
+/// A directory of tokenized files keyed by the hash of their source text.
+///
+/// Unchanged files are decoded from the cache instead of being lexed again. Because the key is the
+/// content of the file rather than its path, moved and duplicated files hit the cache as well.
+/// Entries are written to a temporary file and renamed into place, so the cache may be shared by
+/// concurrent lexer threads and compiler processes.
+class MjTokenCache {
+private:
+    std::filesystem::path _dir;
+    bool _emit_subtokens;
+public:
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    /// Create a cache in the given directory, which is created if it does not exist.
+    MjTokenCache(std::filesystem::path dir, bool emit_subtokens = false) noexcept;
+
+
+    ///
+    /// Properties
+    ///
+
+
+    const std::filesystem::path &dir() const noexcept {
+        return _dir;
+    }
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// Decode the tokenized file for the source file at the given path, or lex the file and add it
+    /// to the cache if it has not been seen before.
+    MjSourceFile *parse_file(std::filesystem::path file_path) const noexcept;
+
+
+private:
+
+
+    /// The path of the cache entry for the source text with the given hash.
+    std::filesystem::path entry_path(u64 hash) const noexcept;
+};
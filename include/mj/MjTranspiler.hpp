@@ -1,26 +1,166 @@
 #pragma once
 
 #include <mj/ast/MjProgram.hpp>
+#include <mj/ast/MjExpressionTree.hpp>
+#include <mj/ast/MjSourceFile.hpp>
+#include <mj/ast/MjTokenView.hpp>
+#include <c/ast/CProgram.hpp>
 
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+
+class MjBlockStatement;
+class MjFunction;
+class MjIfStatement;
+class MjStatement;
+class MjVariable;
+class MjWhileLoop;
+
+
+/// Transpiles the modules of a program to C, with one translation unit per module.
+///
+/// Structures and unions keep the layout computed by the layout engine. Functions which are not
+/// exported are `static inline`. The pointer parameters of a function annotated `@restrict` are
+/// `restrict`: the annotation promises that, during a call, memory accessed through one of them is
+/// not accessed through any other name. Other pointers are never `restrict`, since nothing proves
+/// that they do not alias. Local variables are declared with their types at the start of the body,
+/// and names assigned without a declaration are `int64_t`, as in the IR lowering.
 class MjTranspiler {
 private:
+
+    struct Unit {
+        CTranslationUnit *translation_unit;
+        std::unordered_map<const MjType *, const CType *> types; // The C type of each type
+        std::unordered_map<const MjType *, const CType *> restrict_pointer_types;
+        const CType *integer_types[2][4] = {}; // The `<stdint.h>` types by signedness and size
+    };
+
+
     MjProgram &program_;
+    CProgram _program;
+    std::vector<Unit> _units;
+
+    // The state of the function being lowered.
+    const MjSourceFile *_file = nullptr;
+    const MjTokenView *_tokens = nullptr;
+    Unit *_unit = nullptr;
+    std::unordered_set<std::string> _names;  // The parameters and local variables
+    std::vector<CVariable> _locals;          // The local variables, in order of declaration or first use
+    u32 _loop_depth = 0;
+    Error _error = Error::SUCCESS;
 public:
 
 
+    ///
+    /// Constructors
+    ///
+
+
     MjTranspiler(
         MjProgram &program
     ) :
-        program_(program)
+        program_(program),
+        _program("program")
     {}
 
 
-    ~MjTranspiler() {
-        ;
-    }
+    ///
+    /// Methods
+    ///
+
+
+    /// Add the translation unit of a module and return its index.
+    u32 add_translation_unit(StringView module_name) noexcept;
+
+
+    /// Define a structure or union type in a translation unit, with its computed layout. The types
+    /// of its members must be defined first.
+    Error add_type(u32 unit, const MjType &type, StringView name, const MjSourceFile &file) noexcept;
+
+
+    /// Define a function in a translation unit. Functions which are not exported have internal
+    /// linkage.
+    Error add_function(
+        u32 unit,
+        const MjFunction &function,
+        Slice<const MjVariable *const> parameters,
+        const MjSourceFile &file,
+        const MjTokenView &tokens,
+        bool is_exported
+    ) noexcept;
+
+
+    /// Declare a function of another module in a translation unit.
+    Error declare_function(
+        u32 unit,
+        const MjFunction &function,
+        Slice<const MjVariable *const> parameters,
+        const MjSourceFile &file
+    ) noexcept;
+
+
+    /// Write the translation units as `<module>.c` files in a directory.
+    Error transpile(const std::filesystem::path &directory) noexcept;
+
+
+private:
+
+
+    /// Create a function with its parameters in the current unit.
+    CFunction *create_function(const MjFunction &function, Slice<const MjVariable *const> parameters, bool is_external, bool is_exported) noexcept;
+
+
+    /// Return the C type of a type, or null if it has none. A pointer is `restrict` qualified if
+    /// `is_restrict` is true. Structures and unions have the C type they were added with.
+    const CType *lower_type(const MjType *type, bool is_restrict = false) noexcept;
+
+
+    /// Return true if the function is annotated `@restrict`.
+    bool is_restrict(const MjFunction &function) const noexcept;
+
+
+    const CType &integer_type(u32 size, bool is_signed) noexcept;
+
+
+    void lower_statement(const MjStatement *statement, CBlockStatement &block) noexcept;
+
+
+    /// Lower the statements of a block, or a single statement, into a block.
+    void lower_body(const MjStatement *statement, CBlockStatement &block) noexcept;
+
+
+    void lower_if(const MjIfStatement *statement, CBlockStatement &block) noexcept;
+
+
+    void lower_while(const MjWhileLoop *loop, CBlockStatement &block) noexcept;
+
+
+    CExpression lower_node(const MjExpressionTree &tree, u32 index) noexcept;
+
+
+    CExpression lower_literal(const MjExpressionNode &node) noexcept;
+
+
+    CExpression lower_unary(const MjExpressionTree &tree, const MjExpressionNode &node) noexcept;
+
+
+    CExpression lower_binary(const MjExpressionTree &tree, const MjExpressionNode &node) noexcept;
+
+
+    CExpression lower_call(const MjExpressionTree &tree, const MjExpressionNode &node) noexcept;
+
+
+    /// Return the name of a variable, declaring it as a local variable on first use.
+    CExpression variable(const MjExpressionNode &node) noexcept;
+
+
+    /// Return true if evaluating an expression may modify an object or call a function.
+    bool has_side_effects(const MjExpressionTree &tree, u32 index) const noexcept;
 
 
-    void transpile(const Path &path) {
-    }
+    CExpression error(const MjExpressionNode &node, const char *message) noexcept;
 };
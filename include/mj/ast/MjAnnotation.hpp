@@ -2,8 +2,10 @@
 
 #include <mj/ast/MjItem.hpp>
 
+#include <container/Vector.hpp>
 
-using MjAnnotationArgumentList = Vector<const MjToken *>;
+
+using MjAnnotationArgumentList = Vector<MjToken>;
 
 
 template<class MjAnnotationType>
@@ -34,27 +36,41 @@ public:
 /// @brief An annotation is a semantic element attached to definitions and statements.
 class MjAnnotation : public MjItem {
 private:
-    const MjToken *_name;
+    MjToken _name;
     MjAnnotationArgumentList _argument_list;
 public:
 
 
-    static
-    constexpr
-    MjItemKind item_kind() noexcept {
-        return MjItemKind::ANNOTATION;
-    }
-
-
     ///
     /// Constructors
     ///
 
 
-    MjAnnotation(const MjToken *name) noexcept : MjItem(item_kind()), _name(name) {}
+    MjAnnotation(MjToken name) noexcept : MjItem(MjItemKind::ANNOTATION), _name(name) {}
 
 
-    MjAnnotation(const MjToken *name, MjAnnotationArgumentList argument_list) noexcept :
-        MjItem(item_kind()), _name(name), _argument_list(argument_list)
+    MjAnnotation(MjToken name, MjAnnotationArgumentList argument_list) noexcept :
+        MjItem(MjItemKind::ANNOTATION), _name(name), _argument_list(argument_list)
     {}
+
+
+    /// An annotation known to the compiler, such as `PURE_ANNOTATION` for `@pure`.
+    MjAnnotation(MjItemKind item_kind, MjToken name, MjAnnotationArgumentList argument_list) noexcept :
+        MjItem(item_kind), _name(name), _argument_list(argument_list)
+    {}
+
+
+    ///
+    /// Properties
+    ///
+
+
+    const MjToken *name() const noexcept {
+        return &_name;
+    }
+
+
+    const MjAnnotationArgumentList &argument_list() const noexcept {
+        return _argument_list;
+    }
 };
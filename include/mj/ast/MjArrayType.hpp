@@ -3,34 +3,45 @@
 #include <mj/ast/MjDerivedType.hpp>
 
 
+/// An array of a fixed number of elements of the base type, such as `u32[4]`.
 class MjArrayType : public MjDerivedType {
 private:
     u32 _array_size;
-protected:
+public:
+
+
+    ///
+    /// Constructors
+    ///
 
 
     constexpr
-    MjArrayType(
-        MjType *base_type,
-        u32 array_size,
-        MjTypeQualifiers type_qualifiers = MjTypeQualifiers::NONE
-    ) noexcept :
-        MjDerivedType(MjTypeType::ARRAY, base_type, type_qualifiers),
+    MjArrayType(MjType *base_type, u32 array_size, Slice<const MjToken> tokens = nullptr) noexcept :
+        MjDerivedType(MjItemKind::ARRAY_TYPE, base_type, tokens),
         _array_size(array_size)
     {}
 
 
-public:
+    ///
+    /// Shared Properties
+    ///
 
 
+    static
     constexpr
-    const MjType *base_type() const noexcept {
-        return _base_type;
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::ARRAY_TYPE;
     }
 
 
+    ///
+    /// Properties
+    ///
+
+
+    /// The number of elements of the array.
     constexpr
-    MjType *base_type() noexcept {
-        return _base_type;
+    u32 array_size() const noexcept {
+        return _array_size;
     }
 };
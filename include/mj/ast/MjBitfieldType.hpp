@@ -8,18 +8,38 @@ private:
     MjIntegerType *_base_type;
     u32 _start : 12;
     u32 _end : 12;
-protected:
+public:
+
+
+    ///
+    /// Constructors
+    ///
 
 
     constexpr
     MjBitfieldType(MjIntegerType *base_type, u32 start, u32 end) noexcept :
+        MjType(MjItemKind::BITFIELD_TYPE),
         _base_type(base_type),
         _start(start),
         _end(end)
     {}
- 
 
-public:
+
+    ///
+    /// Shared Properties
+    ///
+
+
+    static
+    constexpr
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::BITFIELD_TYPE;
+    }
+
+
+    ///
+    /// Properties
+    ///
 
 
     constexpr
@@ -35,8 +55,14 @@ public:
 
 
     constexpr
-    u32 size() const noexcept {
-        return _base_type->size();
+    const MjIntegerType *base_type() const noexcept {
+        return _base_type;
+    }
+
+
+    constexpr
+    MjIntegerType *base_type() noexcept {
+        return _base_type;
     }
 
 
@@ -56,20 +82,4 @@ public:
     u32 end() const noexcept {
         return _end;
     }
-
-
-
-
-    /// @brief Return the size of the type in bytes.
-    u32 size() const noexcept {
-        return _base_type->alignment();
-    }
-
-
-    /// @brief Return the alignment of the type in bytes.
-    u32 alignment() const noexcept {
-        return _base_type->alignment();
-    }
-
-
 };
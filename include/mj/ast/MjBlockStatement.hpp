@@ -2,6 +2,8 @@
 
 #include <mj/ast/MjStatement.hpp>
 
+#include <container/Vector.hpp>
+
 
 // A statement is a structured unit of execution.
 class MjBlockStatement : public MjStatement {
@@ -23,7 +25,19 @@ public:
 
 
     constexpr
-    MjBlockStatement() noexcept : MjStatement(item_kind()) {}
+    MjBlockStatement(Slice<const MjToken> tokens = nullptr) noexcept : MjStatement(item_kind(), tokens) {}
+
+
+    ///
+    /// Shared Properties
+    ///
+
+
+    static
+    constexpr
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::BLOCK_STATEMENT;
+    }
 
 
     ///
@@ -33,10 +47,6 @@ public:
 
     constexpr
     bool is_deterministic() const noexcept final {
-        if (false) {
-            return _is_deterministic;
-        }
-
         for (const MjStatement *statement : _statements) {
             if (!statement->is_deterministic()) {
                 return false;
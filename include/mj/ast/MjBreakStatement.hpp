@@ -1,6 +1,6 @@
 #pragma once
 
-#include <mj/ast/MjStatement.hpp>
+#include <mj/ast/MjExpression.hpp>
 
 
 // A statement is a structured unit of execution.
@@ -16,7 +16,10 @@ public:
 
 
     constexpr
-    MjBreakStatement() noexcept : MjStatement() {}
+    MjBreakStatement(MjExpression *depth = nullptr, Slice<const MjToken> tokens = nullptr) noexcept :
+        MjStatement(MjItemKind::BREAK_STATEMENT, tokens),
+        _expression(depth)
+    {}
 
 
     ///
@@ -26,10 +29,6 @@ public:
 
     constexpr
     bool is_deterministic() const noexcept final {
-        if (false) {
-            return _is_deterministic;
-        }
-
         return _expression == nullptr || _expression->is_deterministic();
     }
 
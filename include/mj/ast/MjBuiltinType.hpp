@@ -3,18 +3,30 @@
 #include <mj/ast/MjType.hpp>
 
 
+/// A type built into the language, such as `void` or `f64`, which is created with its size.
 class MjBuiltinType : public MjType {
-protected:
+public:
+
+
+    ///
+    /// Constructors
+    ///
 
 
     constexpr
-    MjBuiltinType(
-        MjTypeType type_type,
-        MjTypeQualifiers type_qualifiers = MjTypeQualifiers::NONE
-    ) noexcept :
-        MjType(type_type, type_qualifiers, nullptr)
-    {}
+    MjBuiltinType(MjItemKind item_kind, u32 size) noexcept : MjType(item_kind) {
+        _size = size;
+    }
 
 
-public:
+    ///
+    /// Shared Properties
+    ///
+
+
+    static
+    constexpr
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind().is_builtin();
+    }
 };
@@ -2,15 +2,11 @@
 
 #include <mj/ast/MjType.hpp>
 
-class MjClassTypeTemplate;
-class MjTemplateArgumentList;
-class MjVariable;
-class MjMethod;
-class MjFunction;
-
 
+/// A class type, whose members are laid out in order like those of a structure.
+///
+/// The name, members, functions and nested types are children of the type.
 class MjClassType : public MjType {
-private:
 public:
 
 
@@ -19,28 +15,18 @@ public:
     ///
 
 
-    MjClassType() noexcept : MjType(MjTypeKind::CLASS) {}
+    constexpr
+    MjClassType(Slice<const MjToken> tokens = nullptr) noexcept : MjType(MjItemKind::CLASS_TYPE, tokens) {}
 
 
     ///
-    /// Destructor
+    /// Shared Properties
     ///
 
 
-    ~MjClassType() {
-        for (auto &constructor : constructors()) {
-            Object::destroy(constructor);
-        }
-
-        if (has_destructor()) {
-            Object::destroy(*destructor());
-        }
+    static
+    constexpr
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::CLASS_TYPE;
     }
-
-
-    ///
-    /// Methods
-    ///
-
-
 };
@@ -1,11 +1,9 @@
 #pragma once
 
-#include <mj/ast/MjType.hpp>
+#include <mj/ast/MjDerivedType.hpp>
 
 
-class MjConstantType : public MjType {
-private:
-    MjType *_base_type;
+class MjConstantType : public MjDerivedType {
 public:
 
 
@@ -14,23 +12,19 @@ public:
     ///
 
 
-    MjConstantType(MjType *base_type) noexcept : MjType(MjItemKind::CONSTANT_TYPE), _base_type(base_type) {}
+    constexpr
+    MjConstantType(MjType *base_type) noexcept : MjDerivedType(MjItemKind::CONSTANT_TYPE, base_type) {}
 
 
     ///
-    /// Properties
+    /// Shared Properties
     ///
 
 
+    static
     constexpr
-    const MjType *base_type() const noexcept {
-        return _base_type;
-    }
-
-
-    constexpr
-    MjType *base_type() noexcept {
-        return _base_type;
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::CONSTANT_TYPE;
     }
 
 
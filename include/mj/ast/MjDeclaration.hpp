@@ -4,12 +4,144 @@
 #include <mj/ast/MjItemIterator.hpp>
 
 #include <container/Vector.hpp>
+#include <core/Slice.hpp>
 #include <core/Where.hpp>
 
+#include <type_traits>
+
+
+class MjAnnotation;
+class MjComment;
+class MjConstructor;
+class MjDeclaration;
+class MjDestructor;
+class MjFunction;
+class MjMember;
+class MjMethod;
+class MjTemplate;
+class MjTemplateArgumentList;
+class MjType;
+class MjTypeName;
+class MjTypeTemplate;
+class MjVariable;
+
+
+template<class MjDeclarationSegment>
+struct MjDeclarationSegmentValues {
+    static constexpr MjDeclarationSegment COMMENT{0};
+    static constexpr MjDeclarationSegment ANNOTATION{1};
+    static constexpr MjDeclarationSegment TYPE_NAME{2};
+    static constexpr MjDeclarationSegment TEMPLATE{3};
+    static constexpr MjDeclarationSegment TEMPLATE_ARGUMENT_LIST{4};
+    static constexpr MjDeclarationSegment CONSTRUCTOR{5};
+    static constexpr MjDeclarationSegment DESTRUCTOR{6};
+    static constexpr MjDeclarationSegment MEMBER{7};
+    static constexpr MjDeclarationSegment VARIABLE{8};
+    static constexpr MjDeclarationSegment METHOD{9};
+    static constexpr MjDeclarationSegment FUNCTION{10};
+    static constexpr MjDeclarationSegment TYPE_TEMPLATE{11};
+    static constexpr MjDeclarationSegment TYPE{12};
+    static constexpr MjDeclarationSegment OTHER{13};
+};
+
+
+/// The group of children of a declaration an item is stored in.
+struct MjDeclarationSegment : public Enum<u8>, public MjDeclarationSegmentValues<MjDeclarationSegment> {
+    static constexpr u32 COUNT = 14;
+
+
+    constexpr
+    explicit
+    MjDeclarationSegment(u8 id) noexcept : Enum(id) {}
+
+
+    /// Return the segment an item of a given kind is stored in.
+    static
+    constexpr
+    MjDeclarationSegment of(MjItemKind item_kind) noexcept {
+        switch (item_kind) {
+            case MjItemKind::TYPE_NAME: return TYPE_NAME;
+            case MjItemKind::FUNCTION_TEMPLATE: return TEMPLATE;
+            case MjItemKind::TEMPLATE_ARGUMENT_LIST: return TEMPLATE_ARGUMENT_LIST;
+            case MjItemKind::CONSTRUCTOR: return CONSTRUCTOR;
+            case MjItemKind::DESTRUCTOR: return DESTRUCTOR;
+            case MjItemKind::MEMBER: return MEMBER;
+            case MjItemKind::VARIABLE: return VARIABLE;
+            case MjItemKind::CONSTANT: return VARIABLE;
+            case MjItemKind::METHOD: return METHOD;
+            case MjItemKind::FUNCTION: return FUNCTION;
+            default: break;
+        }
+
+        if (item_kind.is_comment()) {
+            return COMMENT;
+        }
+
+        if (item_kind.is_annotation()) {
+            return ANNOTATION;
+        }
+
+        if (item_kind.is_type_template()) {
+            return TYPE_TEMPLATE;
+        }
+
+        if (item_kind.is_type()) {
+            return TYPE;
+        }
 
+        return OTHER;
+    }
+
+
+    /// Return the segment queried for the items of a given class. It agrees with the kinds of the
+    /// items of the class, e.g. `MjMember` is `MEMBER`. Exact matches are resolved first so that the
+    /// class does not need to be complete.
+    template<class T>
+    static
+    constexpr
+    MjDeclarationSegment of() noexcept {
+        using U = std::remove_cv_t<T>;
+
+        if constexpr (std::is_same_v<U, MjComment>) { return COMMENT; }
+        else if constexpr (std::is_same_v<U, MjAnnotation>) { return ANNOTATION; }
+        else if constexpr (std::is_same_v<U, MjTypeName>) { return TYPE_NAME; }
+        else if constexpr (std::is_same_v<U, MjTemplate>) { return TEMPLATE; }
+        else if constexpr (std::is_same_v<U, MjTemplateArgumentList>) { return TEMPLATE_ARGUMENT_LIST; }
+        else if constexpr (std::is_same_v<U, MjConstructor>) { return CONSTRUCTOR; }
+        else if constexpr (std::is_same_v<U, MjDestructor>) { return DESTRUCTOR; }
+        else if constexpr (std::is_same_v<U, MjMember>) { return MEMBER; }
+        else if constexpr (std::is_same_v<U, MjVariable>) { return VARIABLE; }
+        else if constexpr (std::is_same_v<U, MjMethod>) { return METHOD; }
+        else if constexpr (std::is_same_v<U, MjFunction>) { return FUNCTION; }
+        else if constexpr (std::is_same_v<U, MjTypeTemplate>) { return TYPE_TEMPLATE; }
+        else if constexpr (std::is_same_v<U, MjType>) { return TYPE; }
+
+        // Derived classes belong to the segment of their most derived base.
+        else if constexpr (std::is_base_of_v<MjComment, U>) { return COMMENT; }
+        else if constexpr (std::is_base_of_v<MjAnnotation, U>) { return ANNOTATION; }
+        else if constexpr (std::is_base_of_v<MjTypeTemplate, U>) { return TYPE_TEMPLATE; }
+        else if constexpr (std::is_base_of_v<MjTemplate, U>) { return TEMPLATE; }
+        else if constexpr (std::is_base_of_v<MjConstructor, U>) { return CONSTRUCTOR; }
+        else if constexpr (std::is_base_of_v<MjDestructor, U>) { return DESTRUCTOR; }
+        else if constexpr (std::is_base_of_v<MjMember, U>) { return MEMBER; }
+        else if constexpr (std::is_base_of_v<MjVariable, U>) { return VARIABLE; }
+        else if constexpr (std::is_base_of_v<MjMethod, U>) { return METHOD; }
+        else if constexpr (std::is_base_of_v<MjFunction, U>) { return FUNCTION; }
+        else if constexpr (std::is_base_of_v<MjType, U>) { return TYPE; }
+        else { return OTHER; }
+    }
+};
+
+
+/// A declaration and its children.
+///
+/// The children are stored in a single vector grouped by segment, in declaration order within each
+/// segment, with a table of the offset of each segment. Looking up the children of a class is a
+/// range lookup rather than a scan of every child.
 class MjDeclaration : public MjItem {
 protected:
     Vector<MjItem *> _items;
+    u32 _segment_offsets[MjDeclarationSegment::COUNT + 1] = {};
 
 
     ///
@@ -21,9 +153,15 @@ protected:
     MjDeclaration(MjItemInfo item_info) noexcept : MjItem(item_info) {}
 
 
+    constexpr
+    MjDeclaration(MjItemKind item_kind, Slice<const MjToken> tokens = nullptr) noexcept :
+        MjItem(item_kind, tokens)
+    {}
+
+
 public:
- 	MjDeclaration(MjDeclaration &&) = delete;
- 	MjDeclaration(const MjDeclaration &) = delete;
+    MjDeclaration(MjDeclaration &&) = delete;
+    MjDeclaration(const MjDeclaration &) = delete;
 
 
     ///
@@ -40,30 +178,28 @@ public:
     ///
 
 
-    template<IsMjItem T>
+    template<class T>
     constexpr
     bool has_item() const noexcept {
-        for (MjItem *item : _items) {
-            if (item->is<T>()) {
-                return true;
-            }
-        }
-
-        return false;
+        constexpr u32 segment = MjDeclarationSegment::of<T>();
+        return _segment_offsets[segment + 1] != _segment_offsets[segment];
     }
 
 
-    template<IsMjItem T>
-    constexpr
-    MjItemIterator<const T> items() const noexcept {
-        return _items.data();
+    /// Return the children of a class in declaration order.
+    template<class T>
+    Slice<T *const> items() const noexcept {
+        constexpr u32 segment = MjDeclarationSegment::of<T>();
+        u32 offset = _segment_offsets[segment];
+        return {reinterpret_cast<T *const *>(_items.data() + offset), _segment_offsets[segment + 1] - offset};
     }
 
 
-    template<IsMjItem T>
-    constexpr
-    MjItemIterator<T> items() noexcept {
-        return _items.data();
+    /// Return the first child of a class, or `nullptr`.
+    template<class T>
+    T *item() const noexcept {
+        constexpr u32 segment = MjDeclarationSegment::of<T>();
+        return has_item<T>() ? reinterpret_cast<T *>(_items[_segment_offsets[segment]]) : nullptr;
     }
 
 
@@ -72,7 +208,15 @@ public:
     ///
 
 
+    /// Append a child to the end of the segment of its kind.
     void append(MjItem *item) noexcept {
-        _items.push_back(item);
+        assert(item->item_kind() != MjItemKind::UNKNOWN && "The child has no kind!");
+
+        u32 segment = MjDeclarationSegment::of(item->item_kind());
+        _items.insert(_items.begin() + _segment_offsets[segment + 1], item);
+
+        for (u32 i = segment + 1; i <= MjDeclarationSegment::COUNT; ++i) {
+            _segment_offsets[i] += 1;
+        }
     }
 };
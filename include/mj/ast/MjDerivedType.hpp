@@ -0,0 +1,56 @@
+#pragma once
+
+#include <mj/ast/MjType.hpp>
+
+
+/// A type derived from a single base type, such as a pointer, a slice, an array or a 'const'
+/// qualified type.
+class MjDerivedType : public MjType {
+protected:
+    MjType *_base_type;
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    constexpr
+    MjDerivedType(MjItemKind item_kind, MjType *base_type, Slice<const MjToken> tokens = nullptr) noexcept :
+        MjType(item_kind, tokens),
+        _base_type(base_type)
+    {}
+
+
+public:
+
+
+    ///
+    /// Shared Properties
+    ///
+
+
+    static
+    constexpr
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::CONSTANT_TYPE || item->item_kind() == MjItemKind::ARRAY_TYPE
+            || item->item_kind() == MjItemKind::POINTER_TYPE || item->item_kind() == MjItemKind::SLICE_TYPE;
+    }
+
+
+    ///
+    /// Properties
+    ///
+
+
+    constexpr
+    const MjType *base_type() const noexcept {
+        return _base_type;
+    }
+
+
+    constexpr
+    MjType *base_type() noexcept {
+        return _base_type;
+    }
+};
@@ -40,10 +40,6 @@ public:
 
     constexpr
     bool is_deterministic() const noexcept final {
-        if (false) {
-            return _is_deterministic;
-        }
-
         return _body->is_deterministic();
     }
 
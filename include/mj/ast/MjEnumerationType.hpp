@@ -25,6 +25,18 @@ public:
     {}
 
 
+    ///
+    /// Shared Properties
+    ///
+
+
+    static
+    constexpr
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::ENUMERATION_TYPE;
+    }
+
+
     ///
     /// Properties
     ///
@@ -54,15 +66,9 @@ public:
     }
 
 
-    constexpr
-    Slice<const MjVariable *> &values() const noexcept {
-        return _items;
-    }
-
-
-    constexpr
-    Slice<MjVariable *> &values() noexcept {
-        return _items;
+    /// The values of the enumeration, in order.
+    Slice<MjVariable *const> values() const noexcept {
+        return items<MjVariable>();
     }
 
 
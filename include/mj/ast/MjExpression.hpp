@@ -23,12 +23,6 @@ public:
     ///
 
 
-    constexpr
-    Slice<const MjToken> tokens() const noexcept {
-        return _tokens;
-    }
-
-
     virtual
     const MjType *result_type() const noexcept = 0;
 
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <mj/ast/MjExpression.hpp>
+#include <mj/ast/MjOperatorKind.hpp>
+
+#include <vector>
+
+
+template<class MjExpressionNodeKind>
+struct MjExpressionNodeKindValues {
+    static constexpr MjExpressionNodeKind NONE{0};          // The null node
+    static constexpr MjExpressionNodeKind INVALID{1};       // An operand which failed to parse
+
+    // Terminals
+    static constexpr MjExpressionNodeKind VARIABLE{2};      // `a`
+    static constexpr MjExpressionNodeKind CONSTANT{3};      // `A`
+    static constexpr MjExpressionNodeKind LITERAL{4};       // `true`, `1`, `"a"`, ...
+    static constexpr MjExpressionNodeKind NULL_{5};         // `null`
+    static constexpr MjExpressionNodeKind UNINITIALIZED{6}; // `uninitialized`
+    static constexpr MjExpressionNodeKind FUNCTION{7};      // `f`
+    static constexpr MjExpressionNodeKind TYPE{8};          // `T`
+
+    // Operators
+    static constexpr MjExpressionNodeKind UNARY{9};         // `-a`, `a++`
+    static constexpr MjExpressionNodeKind BINARY{10};       // `a + b`, `a[b]`
+    static constexpr MjExpressionNodeKind CALL{11};         // `a(b, c)`
+    static constexpr MjExpressionNodeKind CAST{12};         // `(T: a)`
+    static constexpr MjExpressionNodeKind ARRAY{13};        // `[a, b]`
+};
+
+
+struct MjExpressionNodeKind : public Enum<u8>, public MjExpressionNodeKindValues<MjExpressionNodeKind> {
+
+    constexpr
+    explicit
+    MjExpressionNodeKind(u8 id) noexcept : Enum(id) {}
+
+
+    /// Return true if the node has no operands.
+    constexpr
+    bool is_terminal() const noexcept {
+        return _id < UNARY;
+    }
+};
+
+
+/// A node of an expression tree. Nodes refer to their operands by index within the same tree.
+struct MjExpressionNode {
+    MjExpressionNodeKind kind;
+    MjOperatorKind operator_kind;
+    u16 argument_count; // The number of arguments of a call, or the number of elements of an array
+    u32 token_index;    // The index of the first token of the expression in the token view
+    u32 token_count;    // The number of tokens of the expression
+    u32 lhs;            // The operand of unary and cast nodes, the left operand and the callee
+    u32 rhs;            // The right operand, the first argument or element, or the type index of cast and type nodes
+    u32 next;           // The next argument of a call or element of an array
+};
+
+
+/// The expressions of a function, stored as a flat array of nodes linked by index.
+///
+/// Nodes are appended in post-order, so the operands of a node always precede it and every
+/// subtree occupies a contiguous range of nodes ending at its root. Index 0 is the null node.
+class MjExpressionTree {
+private:
+    std::vector<MjExpressionNode> _nodes;
+    std::vector<MjType *> _types;
+public:
+
+
+    static constexpr u32 NONE = 0;
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    MjExpressionTree() noexcept {
+        clear();
+    }
+
+
+    MjExpressionTree(const MjExpressionTree &) = delete;
+
+
+    ///
+    /// Operators
+    ///
+
+
+    MjExpressionTree &operator=(const MjExpressionTree &) = delete;
+
+
+    ///
+    /// Properties
+    ///
+
+
+    /// The number of nodes, including the null node.
+    u32 size() const noexcept {
+        return _nodes.size();
+    }
+
+
+    const MjExpressionNode &node(u32 index) const noexcept {
+        return _nodes[index];
+    }
+
+
+    MjExpressionNode &node(u32 index) noexcept {
+        return _nodes[index];
+    }
+
+
+    MjType *type(u32 index) const noexcept {
+        return _types[index];
+    }
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// Append a node and return its index.
+    u32 append(const MjExpressionNode &node) noexcept {
+        _nodes.push_back(node);
+        return _nodes.size() - 1;
+    }
+
+
+    /// Append a type referred to by cast and type nodes and return its index.
+    u32 append_type(MjType *type) noexcept {
+        _types.push_back(type);
+        return _types.size() - 1;
+    }
+
+
+    /// Remove every node except the null node.
+    void clear() noexcept {
+        _nodes.clear();
+        _types.clear();
+        _nodes.push_back({MjExpressionNodeKind::NONE, MjOperatorKind::NONE, 0, 0, 0, NONE, NONE, NONE});
+    }
+};
+
+
+/// An item viewing a subtree of an expression tree.
+///
+/// The parser creates a single item per expression rather than one per operand and operator. The
+/// operands are visited by index through the tree.
+class MjTreeExpression : public MjExpression {
+private:
+    const MjExpressionTree *_tree;
+    u32 _first_index;
+    u32 _index;
+public:
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    MjTreeExpression(const MjExpressionTree *tree, u32 first_index, u32 index) noexcept :
+        MjExpression(item_kind_of(tree->node(index))),
+        _tree(tree),
+        _first_index(first_index),
+        _index(index)
+    {}
+
+
+    ///
+    /// Shared Methods
+    ///
+
+
+    /// Return the item kind corresponding to the root node of an expression.
+    static
+    MjItemKind item_kind_of(const MjExpressionNode &node) noexcept {
+        switch (node.kind) {
+        case MjExpressionNodeKind::VARIABLE:
+        case MjExpressionNodeKind::CONSTANT:
+        case MjExpressionNodeKind::FUNCTION:
+        case MjExpressionNodeKind::TYPE: return MjItemKind::NAME_EXPRESSION;
+        case MjExpressionNodeKind::LITERAL:
+        case MjExpressionNodeKind::ARRAY: return MjItemKind::LITERAL_EXPRESSION;
+        case MjExpressionNodeKind::NULL_: return MjItemKind::NULL_EXPRESSION;
+        case MjExpressionNodeKind::UNINITIALIZED: return MjItemKind::UNINITIALIZED_EXPRESSION;
+        case MjExpressionNodeKind::UNARY: return MjItemKind::UNARY_EXPRESSION;
+        case MjExpressionNodeKind::BINARY: return MjItemKind::BINARY_EXPRESSION;
+        case MjExpressionNodeKind::CALL: return MjItemKind::FUNCTION_CALL_EXPRESSION;
+        case MjExpressionNodeKind::CAST: return MjItemKind::TYPE_CAST_EXPRESSION;
+        default: return MjItemKind::INVALID_EXPRESSION;
+        }
+    }
+
+
+    ///
+    /// Properties
+    ///
+
+
+    const MjExpressionTree &tree() const noexcept {
+        return *_tree;
+    }
+
+
+    /// The index of the root node of the expression.
+    u32 index() const noexcept {
+        return _index;
+    }
+
+
+    /// The root node of the expression.
+    const MjExpressionNode &node() const noexcept {
+        return _tree->node(_index);
+    }
+
+
+    /// The nodes of the expression in post-order, ending with the root node.
+    Slice<const MjExpressionNode> nodes() const noexcept {
+        return {&_tree->node(_first_index), _index - _first_index + 1};
+    }
+
+
+    bool is_deterministic() const noexcept final {
+        for (const MjExpressionNode &node : nodes()) {
+            if (node.kind == MjExpressionNodeKind::CALL || (!node.kind.is_terminal() && node.operator_kind.has_side_effects())) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    const MjType *result_type() const noexcept final {
+        return nullptr;
+    }
+
+
+    const MjType *result_type(const MjType *) const noexcept final {
+        return nullptr;
+    }
+};
@@ -1,82 +1,84 @@
 #pragma once
 
-#include <mj/ast/MjFunctionType.hpp>
+#include <mj/ast/MjType.hpp>
+#include <mj/ast/MjVariable.hpp>
 #include <mj/ast/MjFunctionArgumentList.hpp>
 
 
 class MjFunctionTemplate;
 class MjBlockStatement;
+class MjExpressionTree;
 
 
 /// @brief A function is a named expression accepting arguments and returning a result.
-class MjFunction : public MjItem {
+///
+/// The comment, the annotations and the parameters of the function are stored as its children.
+/// The parameters are the variables of the function, in order.
+class MjFunction : public MjDeclaration {
 private:
-    MjFunctionType *_type;
-    MjBlockStatement *_block_statement;
-
-    u16 _comment_offset;
-    u16 _template_offset;
-    u16 _name_offset;
-    u16 _template_argument_list_offset;
-    u16 _parameter_list_offset;
-    u16 _return_type_offset;
-
-    u16 _annotations_offset;
-    u8 _annotations_size;
+    MjToken _name;
+    MjType *_return_type;
+    MjBlockStatement *_block_statement = nullptr;
+    MjExpressionTree *_expressions = nullptr; // The nodes of the expressions of the body
+    Vector<MjVariable *> _locals;
 public:
 
 
     constexpr
-    MjFunction(const MjToken *name, Slice<const MjToken> tokens = nullptr) noexcept :
-        MjItem(MjItemKind::FUNCTION_TYPE, tokens)
+    MjFunction(MjToken name, MjType *return_type, Slice<const MjToken> tokens = nullptr) noexcept :
+        MjDeclaration(MjItemKind::FUNCTION, tokens),
+        _name(name),
+        _return_type(return_type)
     {}
 
 
     ///
-    /// Properties
+    /// Shared Properties
     ///
 
 
+    static
     constexpr
-    bool has_comment() const noexcept {
-        return _comment_offset > 0;
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::FUNCTION;
     }
 
 
-    const MjComment &comment() const noexcept {
-        return *reinterpret_cast<const MjComment *>(&_items[_comment_offset]);
+    ///
+    /// Properties
+    ///
+
+
+    constexpr
+    bool has_comment() const noexcept {
+        return has_item<MjComment>();
     }
 
 
-    MjComment &comment() noexcept {
-        return *reinterpret_cast<MjComment *>(&_items[_comment_offset]);
+    MjComment *comment() const noexcept {
+        return item<MjComment>();
     }
 
 
     constexpr
     bool has_annotations() const noexcept {
-        return _annotations_size > 0;
+        return has_item<MjAnnotation>();
     }
 
 
     Slice<MjAnnotation *const> annotations() const noexcept {
-        return {reinterpret_cast<MjAnnotation *const *>(&_items[_annotations_offset]), _annotations_size};
-    }
-
-
-    Slice<MjAnnotation *> annotations() noexcept {
-        return {reinterpret_cast<MjAnnotation **>(&_items[_annotations_offset]), _annotations_size};
+        return items<MjAnnotation>();
     }
 
 
     constexpr
     bool has_name() const noexcept {
-        return _name_offset != 0;
+        return bool(_name);
     }
 
 
     const MjToken *name() const noexcept {
-        return *reinterpret_cast<const MjToken *const *>(&_items[_name_offset]);
+        return &_name;
     }
 
 
@@ -88,67 +90,79 @@ public:
 
     constexpr
     bool is_template_specialization() const noexcept {
-        return _template_offset > 0;
+        return has_item<MjTemplateArgumentList>();
     }
 
 
-    MjFunctionTemplate *function_template() const noexcept {
-        return *reinterpret_cast<MjFunctionTemplate *const *>(&_items[_template_offset]);
+    MjTemplateArgumentList *template_argument_list() const noexcept {
+        return item<MjTemplateArgumentList>();
     }
 
 
-    MjFunctionTemplate *function_template() noexcept {
-        return *reinterpret_cast<MjFunctionTemplate **>(&_items[_template_offset]);
+    /// The parameters of the function, in order.
+    Slice<const MjVariable *const> parameters() const noexcept {
+        return items<const MjVariable>();
     }
 
 
-
-    constexpr
-    bool has_template_argument_list() const noexcept {
-        return _template_argument_list_offset > 0;
+    /// The number of parameters of the function.
+    u32 arity() const noexcept {
+        return parameters().size();
     }
 
 
-    MjTemplateArgumentList *template_argument_list() const noexcept {
-        return *reinterpret_cast<MjTemplateArgumentList *const *>(&_items[_template_argument_list_offset]);
+    constexpr
+    bool has_return_type() const noexcept {
+        return _return_type != nullptr && !_return_type->is_void_type();
     }
 
 
-    MjTemplateArgumentList *template_argument_list() noexcept {
-        return *reinterpret_cast<MjTemplateArgumentList **>(&_items[_template_argument_list_offset]);
+    constexpr
+    MjType *return_type() const noexcept {
+        return _return_type;
     }
 
 
-    MjFunctionParameterList *parameter_list() const noexcept {
-        return *reinterpret_cast<MjFunctionParameterList *const *>(&_items[_parameter_list_offset]);
+    constexpr
+    MjBlockStatement *body() const noexcept {
+        return _block_statement;
     }
 
 
-    MjFunctionParameterList *parameter_list() noexcept {
-        return *reinterpret_cast<MjFunctionParameterList **>(&_items[_parameter_list_offset]);
+    /// The local variables declared in the body, in declaration order.
+    Slice<MjVariable *const> locals() const noexcept {
+        return {_locals.data(), u32(_locals.size())};
     }
 
 
+    /// The expression tree holding the expressions of the body.
     constexpr
-    bool has_return_type() const noexcept {
-        return _return_type_offset > 0;
+    MjExpressionTree *expressions() const noexcept {
+        return _expressions;
     }
 
 
-    constexpr
-    MjType *return_type() const noexcept {
-        return _type ? _type->return_type() : nullptr;
-    }
+    /// Return true if calling the function with the arguments has no side effects.
+    bool is_deterministic(const MjFunctionArgumentList &argument_list) const noexcept;
 
 
-    constexpr
-    MjBlockStatement *body() const noexcept {
-        return _block_statement;
-    }
+    bool supports_arguments(const MjFunctionArgumentList &argument_list) const noexcept;
 
 
-    bool is_deterministic(const MjFunctionArgumentList &argument_list) const noexcept;
+    ///
+    /// Methods
+    ///
 
 
-    bool supports_arguments(const MjFunctionArgumentList &argument_list) const noexcept;
+    /// Set the body and the expression tree which its expressions were parsed into.
+    constexpr
+    void set_body(MjBlockStatement *body, MjExpressionTree *expressions) noexcept {
+        _block_statement = body;
+        _expressions = expressions;
+    }
+
+
+    void append_local(MjVariable *variable) noexcept {
+        _locals.push_back(variable);
+    }
 };
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <mj/ast/MjExpression.hpp>
+#include <mj/ast/MjFunctionArgumentList.hpp>
+
+
+/// An argument passed to a function, method or operator.
+class MjFunctionArgument {
+private:
+    MjExpression *_expression;
+public:
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    constexpr
+    MjFunctionArgument(MjExpression *expression) noexcept : _expression(expression) {}
+
+
+    ///
+    /// Properties
+    ///
+
+
+    constexpr
+    const MjExpression *expression() const noexcept {
+        return _expression;
+    }
+
+
+    constexpr
+    MjExpression *expression() noexcept {
+        return _expression;
+    }
+
+
+    /// Return true if evaluating the argument has no side effects.
+    bool is_deterministic() const noexcept {
+        return _expression->is_deterministic();
+    }
+};
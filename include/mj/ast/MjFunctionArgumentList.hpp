@@ -1,7 +1,9 @@
 #pragma once
 
-#include <mj/ast/MjFunctionArgument.hpp>
 #include <container/Vector.hpp>
 
 
+class MjFunctionArgument;
+
+
 using MjFunctionArgumentList = Vector<MjFunctionArgument *>;
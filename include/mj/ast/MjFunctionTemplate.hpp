@@ -16,7 +16,7 @@ public:
 
     constexpr
     MjFunctionTemplate(MjToken name, Slice<const MjToken> tokens = nullptr) noexcept :
-        MjTemplate(MjItemKind::FUNCTION_TYPE, tokens),
+        MjTemplate(MjItemKind::FUNCTION_TEMPLATE, tokens),
         _name(name)
     {}
 
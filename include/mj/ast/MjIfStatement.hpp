@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mj/ast/MjExpression.hpp>
 #include <mj/ast/MjThenStatement.hpp>
 #include <mj/ast/MjElseStatement.hpp>
 
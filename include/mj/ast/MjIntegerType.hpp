@@ -1,39 +1,51 @@
 #pragma once
 
-#include <mj/ast/MjType.hpp>
+#include <mj/ast/MjBuiltinType.hpp>
 
 
-class MjIntegerType : public MjType {
+class MjIntegerType : public MjBuiltinType {
 private:
-    u32 _is_unsigned : 1;
-    u32 _size : 24;
-protected:
+    bool _is_unsigned;
+public:
+
+
+    ///
+    /// Constructors
+    ///
 
 
     constexpr
     MjIntegerType(bool is_unsigned, u32 size) noexcept :
-        _is_unsigned(is_unsigned),
-        _size(size)
+        MjBuiltinType(MjItemKind::INTEGER_TYPE, size),
+        _is_unsigned(is_unsigned)
     {}
- 
 
-public:
 
+    ///
+    /// Shared Properties
+    ///
 
+
+    static
     constexpr
-    bool is_unsigned() const noexcept {
-        return _is_unsigned;
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::INTEGER_TYPE;
     }
 
 
+    ///
+    /// Properties
+    ///
+
+
     constexpr
-    bool is_signed() const noexcept {
-        return !_is_unsigned;
+    bool is_unsigned() const noexcept {
+        return _is_unsigned;
     }
 
 
     constexpr
-    u32 size() const noexcept {
-        return _size;
+    bool is_signed() const noexcept {
+        return !_is_unsigned;
     }
 };
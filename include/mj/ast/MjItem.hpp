@@ -7,6 +7,8 @@
 #include <core/Slice.hpp>
 #include <core/Where.hpp>
 
+#include <cassert>
+
 
 class MjItem {
 protected:
@@ -30,9 +32,16 @@ protected:
     {}
 
 
+    /// Only the first token is stored, see `set_location`.
+    constexpr
+    MjItem(MjItemKind item_kind, Slice<const MjToken>) noexcept :
+        _item_info(item_kind)
+    {}
+
+
 public:
- 	MjItem(MjItem &&) = delete;
- 	MjItem(const MjItem &) = delete;
+    MjItem(MjItem &&) = delete;
+    MjItem(const MjItem &) = delete;
 
 
     ///
@@ -79,7 +88,7 @@ public:
 
 
     template<class T, class = Where::is_derived_from<MjItem, T>>
-    bool is() noexcept {
+    bool is() const noexcept {
         return T::is_type_of(this);
     }
 
@@ -116,19 +125,19 @@ public:
 
 
     constexpr
-    bool is_basic_type() noexcept {
+    bool is_basic_type() const noexcept {
         return item_kind().is_basic();
     }
 
 
     constexpr
-    bool is_derived_type() noexcept {
+    bool is_derived_type() const noexcept {
         return item_kind().is_derived();
     }
 
 
     constexpr
-    bool is_builtin_type() noexcept {
+    bool is_builtin_type() const noexcept {
         return item_kind().is_builtin();
     }
 
@@ -234,13 +243,10 @@ public:
     ///
 
 
-    void set_tokens(Slice<const MjToken> tokens) noexcept {
-        //_tokens = tokens;
-    }
-
-
-    void set_end_token(const MjToken &token) noexcept {
-        //_tokens.set_end(token);
+    /// Set the source file of the item and the offset of its first token in the file.
+    constexpr
+    void set_location(u32 source_id, u64 token_offset) noexcept {
+        _item_info.set_location(source_id, token_offset);
     }
 };
 
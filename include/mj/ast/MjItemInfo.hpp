@@ -3,6 +3,9 @@
 #include <mj/ast/MjItemKind.hpp>
 
 
+/// The kind and the source location of an item packed in 64 bits: the kind in the top 8 bits, the
+/// source ID in the next 16 bits, and the offset of the first token of the item in its source file
+/// in the low 40 bits.
 class MjItemInfo {
 private:
     u64 _data;
@@ -19,7 +22,7 @@ public:
 
 
     constexpr
-    MjItemInfo(MjItemKind item_kind) noexcept : _data(item_kind << 56) {}
+    MjItemInfo(MjItemKind item_kind) noexcept : _data(u64(item_kind) << 56) {}
 
 
     ///
@@ -62,6 +65,20 @@ public:
     }
 
 
+    /// The ID of the source file of the item in the source manager.
+    constexpr
+    u32 source_id() const noexcept {
+        return (_data >> 40) & 0xFFFFu;
+    }
+
+
+    /// The offset of the first token of the item in its source file.
+    constexpr
+    u64 token_offset() const noexcept {
+        return _data & 0xFFFFFFFFFFu;
+    }
+
+
     ///
     /// Methods
     ///
@@ -75,6 +92,12 @@ public:
 
     constexpr
     void set_item_kind(MjItemKind item_kind) noexcept {
-        _data = (_data & (0xFF << 56)) | (item_kind << 56);
+        _data = (_data & ~(u64(0xFF) << 56)) | (u64(item_kind) << 56);
+    }
+
+
+    constexpr
+    void set_location(u32 source_id, u64 token_offset) noexcept {
+        _data = (_data & (u64(0xFF) << 56)) | (u64(source_id & 0xFFFFu) << 40) | (token_offset & 0xFFFFFFFFFFu);
     }
 };
@@ -17,12 +17,12 @@ public:
 
 
     bool operator!=(std::nullptr_t) const noexcept {
-        return _item != nullptr;
+        return *_item != nullptr;
     }
 
 
     T &operator*() const noexcept {
-        return *_item->as<T>();
+        return *(*_item)->template as<T>();
     }
 
 
@@ -35,7 +35,7 @@ private:
 
 
     void next() noexcept {
-        while (*_item != nullptr && !(*_item)->is<T>()) {
+        while (*_item != nullptr && !(*_item)->template is<T>()) {
             ++_item;
         }
     }
@@ -56,12 +56,12 @@ public:
 
 
     bool operator!=(std::nullptr_t) const noexcept {
-        return _item != nullptr;
+        return *_item != nullptr;
     }
 
 
     const T &operator*() const noexcept {
-        return *_item->as<T>();
+        return *(*_item)->template as<T>();
     }
 
 
@@ -74,7 +74,7 @@ private:
 
 
     void next() noexcept {
-        while (*_item != nullptr && !(*_item)->is<T>()) {
+        while (*_item != nullptr && !(*_item)->template is<T>()) {
             ++_item;
         }
     }
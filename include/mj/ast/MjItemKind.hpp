@@ -5,92 +5,104 @@
 
 template<class MjItemKind>
 struct MjItemKindValues {
-    static constexpr MjItemKind UNKNOWN{};
+    static constexpr MjItemKind UNKNOWN{0};
 
-    static constexpr MjItemKind FILE{};
-    static constexpr MjItemKind MODULE{};
-    static constexpr MjItemKind VARIABLE{};
-    static constexpr MjItemKind CONSTANT{};
+    static constexpr MjItemKind FILE{1};
+    static constexpr MjItemKind MODULE{2};
+    static constexpr MjItemKind VARIABLE{3};
+    static constexpr MjItemKind CONSTANT{4};
+    static constexpr MjItemKind MEMBER{5};
 
-    static constexpr MjItemKind METHOD{};
-    static constexpr MjItemKind FUNCTION{};
+    static constexpr MjItemKind METHOD{6};
+    static constexpr MjItemKind FUNCTION{7};
+    static constexpr MjItemKind CONSTRUCTOR{8};
+    static constexpr MjItemKind DESTRUCTOR{9};
+
+    static constexpr MjItemKind FUNCTION_TEMPLATE{10};
+    static constexpr MjItemKind TEMPLATE_ARGUMENT_LIST{11};
+    static constexpr MjItemKind TEMPLATE_PARAMETER_LIST{12};
 
 
     ///
     /// Comment
     ///
 
-    static constexpr MjItemKind BLOCK_COMMENT{};
-    static constexpr MjItemKind FORMATTED_BLOCK_COMMENT{};
-    static constexpr MjItemKind FORMATTED_LINE_COMMENT{};
-    static constexpr MjItemKind LINE_COMMENT{};
+    static constexpr MjItemKind COMMENT{13};
+    static constexpr MjItemKind BLOCK_COMMENT{14};
+    static constexpr MjItemKind FORMATTED_BLOCK_COMMENT{15};
+    static constexpr MjItemKind FORMATTED_LINE_COMMENT{16};
+    static constexpr MjItemKind LINE_COMMENT{17};
 
 
     ///
     /// Annotation
     ///
 
-    static constexpr MjItemKind ALIGNMENT_ANNOTATION{};
-    static constexpr MjItemKind API_ANNOTATION{};
-    static constexpr MjItemKind INTERNAL_ANNOTATION{};
-    static constexpr MjItemKind OFFSET_ANNOTATION{};
-    static constexpr MjItemKind PURE_ANNOTATION{};
-    static constexpr MjItemKind SHARED_ANNOTATION{};
-    static constexpr MjItemKind SIZE_ANNOTATION{};
+    static constexpr MjItemKind ANNOTATION{18};
+    static constexpr MjItemKind ALIGNMENT_ANNOTATION{19};
+    static constexpr MjItemKind API_ANNOTATION{20};
+    static constexpr MjItemKind INTERNAL_ANNOTATION{21};
+    static constexpr MjItemKind OFFSET_ANNOTATION{22};
+    static constexpr MjItemKind PURE_ANNOTATION{23};
+    static constexpr MjItemKind SHARED_ANNOTATION{24};
+    static constexpr MjItemKind SIZE_ANNOTATION{25};
 
 
     ///
     /// Directive
     ///
 
-    static constexpr MjItemKind IMPORT_DIRECTIVE{};
+    static constexpr MjItemKind IMPORT_DIRECTIVE{26};
 
 
     ///
     /// Statement
     ///
 
-    static constexpr MjItemKind BLOCK_STATEMENT{};
-    static constexpr MjItemKind BREAK_STATEMENT{};
-    static constexpr MjItemKind CONTINUE_STATEMENT{};
-    static constexpr MjItemKind DO_LOOP{};
-    static constexpr MjItemKind DO_UNTIL_LOOP{};
-    static constexpr MjItemKind DO_WHILE_LOOP{};
-    static constexpr MjItemKind FOR_LOOP{};
-    static constexpr MjItemKind IF_STATEMENT{};
-    static constexpr MjItemKind ELSE_STATEMENT{};
-    static constexpr MjItemKind CASE_STATEMENT{};
-    static constexpr MjItemKind THEN_STATEMENT{};
-    static constexpr MjItemKind MATCH_STATEMENT{};
-    static constexpr MjItemKind RETURN_STATEMENT{};
-    static constexpr MjItemKind TRY_STATEMENT{};
-    static constexpr MjItemKind UNTIL_LOOP{};
-    static constexpr MjItemKind WHILE_LOOP{};
-    static constexpr MjItemKind YIELD_STATEMENT{};
+    static constexpr MjItemKind BLOCK_STATEMENT{27};
+    static constexpr MjItemKind BREAK_STATEMENT{28};
+    static constexpr MjItemKind CONTINUE_STATEMENT{29};
+    static constexpr MjItemKind DO_LOOP{30};
+    static constexpr MjItemKind DO_UNTIL_LOOP{31};
+    static constexpr MjItemKind DO_WHILE_LOOP{32};
+    static constexpr MjItemKind FOR_LOOP{33};
+    static constexpr MjItemKind IF_STATEMENT{34};
+    static constexpr MjItemKind ELSE_STATEMENT{35};
+    static constexpr MjItemKind CASE_STATEMENT{36};
+    static constexpr MjItemKind THEN_STATEMENT{37};
+    static constexpr MjItemKind MATCH_STATEMENT{38};
+    static constexpr MjItemKind RETURN_STATEMENT{39};
+    static constexpr MjItemKind TRY_STATEMENT{40};
+    static constexpr MjItemKind UNTIL_LOOP{41};
+    static constexpr MjItemKind WHILE_LOOP{42};
+    static constexpr MjItemKind YIELD_STATEMENT{43};
 
 
     ///
     /// Expression
     ///
 
-    static constexpr MjItemKind BINARY_EXPRESSION{};
-    static constexpr MjItemKind BLOCK_EXPRESSION{};
-    static constexpr MjItemKind CASE_EXPRESSION{};
-    static constexpr MjItemKind CATCH_EXPRESSION{};
-    static constexpr MjItemKind ELSE_EXPRESSION{};
-    static constexpr MjItemKind FUNCTION_CALL_EXPRESSION{};
-    static constexpr MjItemKind IF_EXPRESSION{};
-    static constexpr MjItemKind LAMBDA_EXPRESSION{};
-    static constexpr MjItemKind MATCH_EXPRESSION{};
-    static constexpr MjItemKind METHOD_CALL_EXPRESSION{};
-    static constexpr MjItemKind NULL_EXPRESSION{};
-    static constexpr MjItemKind OPERATOR_CALL_EXPRESSION{};
-    static constexpr MjItemKind UNINITIALIZED_EXPRESSION{};
-    static constexpr MjItemKind THEN_EXPRESSION{};
-    static constexpr MjItemKind TRY_EXPRESSION{};
-    static constexpr MjItemKind TYPE_CAST_EXPRESSION{};
-    static constexpr MjItemKind USE_EXPRESSION{};
-    static constexpr MjItemKind UNARY_EXPRESSION{};
+    static constexpr MjItemKind BINARY_EXPRESSION{44};
+    static constexpr MjItemKind BLOCK_EXPRESSION{45};
+    static constexpr MjItemKind CASE_EXPRESSION{46};
+    static constexpr MjItemKind CATCH_EXPRESSION{47};
+    static constexpr MjItemKind ELSE_EXPRESSION{48};
+    static constexpr MjItemKind FUNCTION_CALL_EXPRESSION{49};
+    static constexpr MjItemKind IF_EXPRESSION{50};
+    static constexpr MjItemKind LAMBDA_EXPRESSION{51};
+    static constexpr MjItemKind MATCH_EXPRESSION{52};
+    static constexpr MjItemKind METHOD_CALL_EXPRESSION{53};
+    static constexpr MjItemKind NULL_EXPRESSION{54};
+    static constexpr MjItemKind OPERATOR_CALL_EXPRESSION{55};
+    static constexpr MjItemKind UNINITIALIZED_EXPRESSION{56};
+    static constexpr MjItemKind THEN_EXPRESSION{57};
+    static constexpr MjItemKind TRY_EXPRESSION{58};
+    static constexpr MjItemKind TYPE_CAST_EXPRESSION{59};
+    static constexpr MjItemKind USE_EXPRESSION{60};
+    static constexpr MjItemKind UNARY_EXPRESSION{61};
+    static constexpr MjItemKind NAME_EXPRESSION{62};
+    static constexpr MjItemKind LITERAL_EXPRESSION{63};
+    static constexpr MjItemKind INVALID_EXPRESSION{64};
 
 
     ///
@@ -102,59 +114,64 @@ struct MjItemKindValues {
     /// Built-in Type
     ///
 
-    static constexpr MjItemKind VOID_TYPE{};
+    static constexpr MjItemKind VOID_TYPE{65};
+    static constexpr MjItemKind INTEGER_TYPE{66};
+    static constexpr MjItemKind FLOAT_TYPE{67};
+
+    static constexpr MjItemKind TYPE_ALIAS{68};
 
-    static constexpr MjItemKind TYPE_ALIAS{};
+    static constexpr MjItemKind TYPE_NAME{69};
 
-    static constexpr MjItemKind TYPE_NAME{};
+    static constexpr MjItemKind TYPE_EXPRESSION{70};
 
-    static constexpr MjItemKind TYPE_EXPRESSION{};
+    static constexpr MjItemKind TYPE_IMPLEMENTATION{71};
 
-    static constexpr MjItemKind CONSTANT_TYPE{};
-    static constexpr MjItemKind ARRAY_TYPE{};
-    static constexpr MjItemKind POINTER_TYPE{};
-    static constexpr MjItemKind SLICE_TYPE{};
-    static constexpr MjItemKind FUNCTION_TYPE{};
-    static constexpr MjItemKind METHOD_TYPE{};
+    static constexpr MjItemKind QUALIFIED_TYPE{72};
+    static constexpr MjItemKind CONSTANT_TYPE{73};
+    static constexpr MjItemKind ARRAY_TYPE{74};
+    static constexpr MjItemKind POINTER_TYPE{75};
+    static constexpr MjItemKind SLICE_TYPE{76};
+    static constexpr MjItemKind FUNCTION_TYPE{77};
+    static constexpr MjItemKind METHOD_TYPE{78};
 
-    static constexpr MjItemKind BITFIELD_TYPE{};
-    static constexpr MjItemKind CLASS_TYPE{};
-    static constexpr MjItemKind ENUMERATION_TYPE{};
-    static constexpr MjItemKind INTERFACE_TYPE{};
-    static constexpr MjItemKind REFERENCE_TYPE{};
-    static constexpr MjItemKind SAFE_TYPE{};
-    static constexpr MjItemKind STRUCTURE_TYPE{};
-    static constexpr MjItemKind UNION_TYPE{};
+    static constexpr MjItemKind BITFIELD_TYPE{79};
+    static constexpr MjItemKind CLASS_TYPE{80};
+    static constexpr MjItemKind ENUMERATION_TYPE{81};
+    static constexpr MjItemKind INTERFACE_TYPE{82};
+    static constexpr MjItemKind REFERENCE_TYPE{83};
+    static constexpr MjItemKind SAFE_TYPE{84};
+    static constexpr MjItemKind STRUCTURE_TYPE{85};
+    static constexpr MjItemKind UNION_TYPE{86};
 
-    static constexpr MjItemKind CONSTRUCTOR_TYPE{};
-    static constexpr MjItemKind DESTRUCTOR_TYPE{};
-    static constexpr MjItemKind OPERATOR_TYPE{};
+    static constexpr MjItemKind CONSTRUCTOR_TYPE{87};
+    static constexpr MjItemKind DESTRUCTOR_TYPE{88};
+    static constexpr MjItemKind OPERATOR_TYPE{89};
 
 
     ///
     /// Type Template Specialization
     ///
 
-    static constexpr MjItemKind TYPE_ALIAS_TEMPLATE_SPECIALIZATION{};
+    static constexpr MjItemKind TYPE_ALIAS_TEMPLATE_SPECIALIZATION{90};
 
-    static constexpr MjItemKind TYPE_EXPRESSION_TEMPLATE_SPECIALIZATION{};
-    static constexpr MjItemKind ARRAY_TYPE_TEMPLATE_SPECIALIZATION{};
-    static constexpr MjItemKind FUNCTION_TYPE_TEMPLATE_SPECIALIZATION{};
-    static constexpr MjItemKind METHOD_TYPE_TEMPLATE_SPECIALIZATION{};
-    static constexpr MjItemKind POINTER_TYPE_TEMPLATE_SPECIALIZATION{};
-    static constexpr MjItemKind SLICE_TYPE_TEMPLATE_SPECIALIZATION{};
+    static constexpr MjItemKind TYPE_EXPRESSION_TEMPLATE_SPECIALIZATION{91};
+    static constexpr MjItemKind ARRAY_TYPE_TEMPLATE_SPECIALIZATION{92};
+    static constexpr MjItemKind FUNCTION_TYPE_TEMPLATE_SPECIALIZATION{93};
+    static constexpr MjItemKind METHOD_TYPE_TEMPLATE_SPECIALIZATION{94};
+    static constexpr MjItemKind POINTER_TYPE_TEMPLATE_SPECIALIZATION{95};
+    static constexpr MjItemKind SLICE_TYPE_TEMPLATE_SPECIALIZATION{96};
 
-    static constexpr MjItemKind BITFIELD_TYPE_TEMPLATE_SPECIALIZATION{};
-    static constexpr MjItemKind CLASS_TYPE_TEMPLATE_SPECIALIZATION{};
-    static constexpr MjItemKind ENUMERATION_TYPE_TEMPLATE_SPECIALIZATION{};
-    static constexpr MjItemKind INTERFACE_TYPE_TEMPLATE_SPECIALIZATION{};
-    static constexpr MjItemKind REFERENCE_TYPE_TEMPLATE_SPECIALIZATION{};
-    static constexpr MjItemKind STRUCTURE_TYPE_TEMPLATE_SPECIALIZATION{};
-    static constexpr MjItemKind UNION_TYPE_TEMPLATE_SPECIALIZATION{};
+    static constexpr MjItemKind BITFIELD_TYPE_TEMPLATE_SPECIALIZATION{97};
+    static constexpr MjItemKind CLASS_TYPE_TEMPLATE_SPECIALIZATION{98};
+    static constexpr MjItemKind ENUMERATION_TYPE_TEMPLATE_SPECIALIZATION{99};
+    static constexpr MjItemKind INTERFACE_TYPE_TEMPLATE_SPECIALIZATION{100};
+    static constexpr MjItemKind REFERENCE_TYPE_TEMPLATE_SPECIALIZATION{101};
+    static constexpr MjItemKind STRUCTURE_TYPE_TEMPLATE_SPECIALIZATION{102};
+    static constexpr MjItemKind UNION_TYPE_TEMPLATE_SPECIALIZATION{103};
 
-    static constexpr MjItemKind CONSTRUCTOR_TYPE_TEMPLATE_SPECIALIZATION{};
-    static constexpr MjItemKind DESTRUCTOR_TYPE_TEMPLATE_SPECIALIZATION{};
-    static constexpr MjItemKind OPERATOR_TYPE_TEMPLATE_SPECIALIZATION{};
+    static constexpr MjItemKind CONSTRUCTOR_TYPE_TEMPLATE_SPECIALIZATION{104};
+    static constexpr MjItemKind DESTRUCTOR_TYPE_TEMPLATE_SPECIALIZATION{105};
+    static constexpr MjItemKind OPERATOR_TYPE_TEMPLATE_SPECIALIZATION{106};
 
 
     ///
@@ -167,26 +184,26 @@ struct MjItemKindValues {
     ///
 
 
-    static constexpr MjItemKind TYPE_ALIAS_TEMPLATE{};
+    static constexpr MjItemKind TYPE_ALIAS_TEMPLATE{107};
 
-    static constexpr MjItemKind TYPE_EXPRESSION_TEMPLATE{};
-    static constexpr MjItemKind ARRAY_TYPE_TEMPLATE{};
-    static constexpr MjItemKind FUNCTION_TYPE_TEMPLATE{};
-    static constexpr MjItemKind METHOD_TYPE_TEMPLATE{};
-    static constexpr MjItemKind POINTER_TYPE_TEMPLATE{};
-    static constexpr MjItemKind SLICE_TYPE_TEMPLATE{};
+    static constexpr MjItemKind TYPE_EXPRESSION_TEMPLATE{108};
+    static constexpr MjItemKind ARRAY_TYPE_TEMPLATE{109};
+    static constexpr MjItemKind FUNCTION_TYPE_TEMPLATE{110};
+    static constexpr MjItemKind METHOD_TYPE_TEMPLATE{111};
+    static constexpr MjItemKind POINTER_TYPE_TEMPLATE{112};
+    static constexpr MjItemKind SLICE_TYPE_TEMPLATE{113};
 
-    static constexpr MjItemKind BITFIELD_TYPE_TEMPLATE{};
-    static constexpr MjItemKind CLASS_TYPE_TEMPLATE{};
-    static constexpr MjItemKind ENUMERATION_TYPE_TEMPLATE{1};
-    static constexpr MjItemKind INTERFACE_TYPE_TEMPLATE{};
-    static constexpr MjItemKind REFERENCE_TYPE_TEMPLATE{};
-    static constexpr MjItemKind STRUCTURE_TYPE_TEMPLATE{};
-    static constexpr MjItemKind UNION_TYPE_TEMPLATE{};
+    static constexpr MjItemKind BITFIELD_TYPE_TEMPLATE{114};
+    static constexpr MjItemKind CLASS_TYPE_TEMPLATE{115};
+    static constexpr MjItemKind ENUMERATION_TYPE_TEMPLATE{116};
+    static constexpr MjItemKind INTERFACE_TYPE_TEMPLATE{117};
+    static constexpr MjItemKind REFERENCE_TYPE_TEMPLATE{118};
+    static constexpr MjItemKind STRUCTURE_TYPE_TEMPLATE{119};
+    static constexpr MjItemKind UNION_TYPE_TEMPLATE{120};
 
-    static constexpr MjItemKind CONSTRUCTOR_TYPE_TEMPLATE{};
-    static constexpr MjItemKind DESTRUCTOR_TYPE_TEMPLATE{};
-    static constexpr MjItemKind OPERATOR_TYPE_TEMPLATE{};
+    static constexpr MjItemKind CONSTRUCTOR_TYPE_TEMPLATE{121};
+    static constexpr MjItemKind DESTRUCTOR_TYPE_TEMPLATE{122};
+    static constexpr MjItemKind OPERATOR_TYPE_TEMPLATE{123};
 
 };
 
@@ -204,21 +221,70 @@ struct MjItemKind : public Enum<u8>, public MjItemKindValues<MjItemKind> {
     ///
 
 
+    /// The kind is a comment.
+    constexpr
+    bool is_comment() const noexcept {
+        return _id >= MjItemKind::COMMENT && _id <= MjItemKind::LINE_COMMENT;
+    }
+
+
+    /// The kind is an annotation.
+    constexpr
+    bool is_annotation() const noexcept {
+        return _id >= MjItemKind::ANNOTATION && _id <= MjItemKind::SIZE_ANNOTATION;
+    }
+
+
+    /// The kind is a statement, which includes every expression.
+    constexpr
+    bool is_statement() const noexcept {
+        return _id >= MjItemKind::BLOCK_STATEMENT && _id <= MjItemKind::INVALID_EXPRESSION;
+    }
+
+
     constexpr
-    bool is_basic() noexcept {
-        return _id;
+    bool is_expression() const noexcept {
+        return _id >= MjItemKind::BINARY_EXPRESSION && _id <= MjItemKind::INVALID_EXPRESSION;
     }
 
 
+    /// The kind is a type, which includes every type template specialization.
     constexpr
-    bool is_derived() noexcept {
-        return _id;
+    bool is_type() const noexcept {
+        return _id >= MjItemKind::VOID_TYPE && _id <= MjItemKind::OPERATOR_TYPE_TEMPLATE_SPECIALIZATION;
     }
 
 
     constexpr
-    bool is_builtin() noexcept {
-        return _id;
+    bool is_type_template() const noexcept {
+        return _id >= MjItemKind::TYPE_ALIAS_TEMPLATE && _id <= MjItemKind::OPERATOR_TYPE_TEMPLATE;
+    }
+
+
+    constexpr
+    bool is_template() const noexcept {
+        return _id == MjItemKind::FUNCTION_TEMPLATE || is_type_template();
+    }
+
+
+    /// The type is built into the language.
+    constexpr
+    bool is_builtin() const noexcept {
+        return _id >= MjItemKind::VOID_TYPE && _id <= MjItemKind::FLOAT_TYPE;
+    }
+
+
+    /// The type is derived from a base type, e.g. a pointer or an array.
+    constexpr
+    bool is_derived() const noexcept {
+        return _id >= MjItemKind::QUALIFIED_TYPE && _id <= MjItemKind::METHOD_TYPE;
+    }
+
+
+    /// The type is not derived from another type.
+    constexpr
+    bool is_basic() const noexcept {
+        return is_type() && !is_derived();
     }
 
 
@@ -227,6 +293,7 @@ struct MjItemKind : public Enum<u8>, public MjItemKindValues<MjItemKind> {
     ///
 
 
+    constexpr
     bool is_type_alias() const noexcept {
         return _id == MjItemKind::TYPE_ALIAS;
     }
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <mj/ast/MjVariable.hpp>
+#include <mj/ast/MjAnnotation.hpp>
+
+
+class MjLayoutEngine;
+
+
+/// @brief An `MjMember` is a variable stored in every object of the type declaring it.
+class MjMember : public MjVariable {
+    friend class MjLayoutEngine;
+private:
+    Vector<MjAnnotation *> _annotations;
+    u32 _offset = 0; // The offset of the member in the object in bytes, assigned by the layout engine
+public:
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    constexpr
+    MjMember(
+        MjToken name,
+        MjType *type,
+        Slice<const MjToken> tokens = nullptr
+    ) noexcept :
+        MjVariable(name, type, MjItemKind::MEMBER, tokens)
+    {}
+
+
+    ///
+    /// Properties
+    ///
+
+
+    constexpr
+    bool has_annotations() const noexcept {
+        return !_annotations.empty();
+    }
+
+
+    Slice<MjAnnotation *const> annotations() const noexcept {
+        return {_annotations.data(), u32(_annotations.size())};
+    }
+
+
+    /// The offset of the member in the object in bytes. Valid once the layout of the owner is computed.
+    constexpr
+    u32 offset() const noexcept {
+        return _offset;
+    }
+
+
+    ///
+    /// Methods
+    ///
+
+
+    void append(MjAnnotation *annotation) noexcept {
+        _annotations.push_back(annotation);
+    }
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <core/Common.hpp>
+#include <core/Enum.hpp>
+#include <core/Slice.hpp>
+
+#include <vector>
+
+
+class MjItem;
+
+
+template<class MjMemberKind>
+struct MjMemberKindValues {
+    static constexpr MjMemberKind TYPE{0};
+    static constexpr MjMemberKind TYPE_TEMPLATE{1};
+    static constexpr MjMemberKind MEMBER{2};
+    static constexpr MjMemberKind VARIABLE{3};
+    static constexpr MjMemberKind FUNCTION{4};
+    static constexpr MjMemberKind METHOD{5};
+    static constexpr MjMemberKind OPERATOR{6};
+};
+
+
+/// The kind of declaration a member index entry refers to. Each kind has its own name space.
+struct MjMemberKind : public Enum<u8>, public MjMemberKindValues<MjMemberKind> {
+
+    constexpr
+    explicit
+    MjMemberKind(u8 id) noexcept : Enum(id) {}
+};
+
+
+/// An open addressing hash table from the names declared by a type to its items.
+///
+/// Entries are keyed by the member kind, the global string ID of the name and, for functions,
+/// methods and operators, the number of parameters, so that each overload bucket holds only the
+/// overloads of one arity. Items with equal keys are kept in declaration order.
+class MjMemberIndex {
+public:
+
+    struct Entry {
+        u64 key;
+        MjItem *item;
+    };
+private:
+
+    struct Slot {
+        u64 key;
+        u32 first_item;
+        u32 item_count;
+    };
+
+
+    static constexpr u64 EMPTY_KEY = ~u64(0);
+    static constexpr u32 MIN_SLOT_COUNT = 8;
+
+
+    std::vector<Slot> _slots;
+    std::vector<MjItem *> _items;
+    u32 _shift = 64;
+public:
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    constexpr
+    MjMemberIndex() noexcept {}
+
+
+    ///
+    /// Shared Methods
+    ///
+
+
+    /// Return the key of a member. Operators use the operator kind as their name ID.
+    static
+    constexpr
+    u64 key(MjMemberKind member_kind, u32 name_id, u32 arity = 0) noexcept {
+        return u64(member_kind) << 56 | u64(arity & 0xFFFFFFu) << 32 | name_id;
+    }
+
+
+    ///
+    /// Properties
+    ///
+
+
+    /// The number of indexed items.
+    u32 size() const noexcept {
+        return _items.size();
+    }
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// Replace the contents of the index with the given entries.
+    void build(std::vector<Entry> entries) noexcept;
+
+
+    /// Return the items with the given key in declaration order.
+    Slice<MjItem *const> find(u64 key) const noexcept {
+        if (_slots.empty()) {
+            return nullptr;
+        }
+
+        u32 mask = _slots.size() - 1;
+
+        for (u32 i = hash(key); ; i = (i + 1) & mask) {
+            const Slot &slot = _slots[i];
+
+            if (slot.key == key) {
+                return {&_items[slot.first_item], slot.item_count};
+            }
+
+            if (slot.key == EMPTY_KEY) {
+                return nullptr;
+            }
+        }
+    }
+
+
+    /// Return the first item with the given key, or `nullptr`.
+    MjItem *find_first(u64 key) const noexcept {
+        Slice<MjItem *const> items = find(key);
+        return items.is_empty() ? nullptr : items[0];
+    }
+
+
+    void clear() noexcept {
+        _slots.clear();
+        _items.clear();
+        _shift = 64;
+    }
+
+
+private:
+
+
+    /// Return the home slot of a key using the top bits of a fibonacci hash.
+    u32 hash(u64 key) const noexcept {
+        return (key * 11400714819323198485llu) >> _shift;
+    }
+};
@@ -60,6 +60,13 @@ public:
     }
 
 
+    /// The number of parameters of the method, not counting the instance parameter.
+    u32 arity() const noexcept {
+        u32 parameter_count = _type ? _type->function_parameter_list().size() : 0;
+        return parameter_count > 0 ? parameter_count - 1 : 0;
+    }
+
+
     constexpr
     bool is_constructor() const noexcept {
         return false;
@@ -1,17 +1,15 @@
 #pragma once
 
 #include <mj/ast/MjType.hpp>
-#include <mj/ast/MjTemplate.hpp>
 #include <mj/ast/MjFunction.hpp>
 #include <mj/ast/MjModuleName.hpp>
-#include <mj/MjStringSet.hpp>
-
-#include <filesystem/File.hpp>
 
 
 /// Modules participate in the module dependency graph for compilation order.
 /// They are built from source files and object files.
 /// Modules also declare their platform requirements.
+///
+/// The types, functions and variables declared by the module are stored as its children.
 class MjModule : public MjDeclaration {
 private:
     MjModuleName _name;
@@ -23,39 +21,27 @@ public:
     ///
 
 
-    MjModule(MjModuleName name) noexcept :
-        MjDeclaration(),
+    MjModule(MjModuleName name = nullptr, Slice<const MjToken> tokens = nullptr) noexcept :
+        MjDeclaration(MjItemKind::MODULE, tokens),
         _name(name)
     {}
 
 
     ///
-    /// Properties
+    /// Shared Properties
     ///
 
 
+    static
     constexpr
-    const FilePath &directory_path() const noexcept {
-        return _directory_path;
-    }
-
-
-    constexpr
-    bool has_parent() const noexcept {
-        return _parent != nullptr;
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::MODULE;
     }
 
 
-    constexpr
-    const MjModule *parent() const noexcept {
-        return _parent;
-    }
-
-
-    constexpr
-    MjModule *parent() noexcept {
-        return _parent;
-    }
+    ///
+    /// Properties
+    ///
 
 
     constexpr
@@ -64,23 +50,20 @@ public:
     }
 
 
-    /// @brief Return the list of member variables defined by the type.
-    constexpr
-    MjItemIterator<const MjModule> modules() const noexcept {
-        return ;
+    /// The types defined by the module, in declaration order.
+    Slice<MjType *const> types() const noexcept {
+        return items<MjType>();
     }
 
 
-    /// @brief Return the list of member variables defined by the type.
-    constexpr
-    Vector<MjModule *> &modules() noexcept {
-        return ;
+    /// The functions defined by the module, in declaration order.
+    Slice<MjFunction *const> functions() const noexcept {
+        return items<MjFunction>();
     }
 
 
-    ///
-    /// Methods
-    ///
-
-
+    /// The variables and constants defined by the module, in declaration order.
+    Slice<MjVariable *const> variables() const noexcept {
+        return items<MjVariable>();
+    }
 };
@@ -1,163 +1,172 @@
 #pragma once
 
+#include <mj/ast/MjTokenKind.hpp>
+
 #include <core/Enum.hpp>
 
 
 template<class MjOperatorKind>
 struct MjOperatorKindValues {
-    static constexpr MjOperatorKind SET{0}; // _=_
-    static constexpr MjOperatorKind MUL_SET{0}; // _*=_
-    static constexpr MjOperatorKind DIV_SET{0}; // _/=_
-    static constexpr MjOperatorKind MOD_SET{0}; // _%=_
-    static constexpr MjOperatorKind ADD_SET{0}; // _+=_
-    static constexpr MjOperatorKind SUB_SET{0}; // _-=_
-    static constexpr MjOperatorKind LSL_SET{0}; // _>>=_
-    static constexpr MjOperatorKind ASR_SET{0}; // _<<=_
-    static constexpr MjOperatorKind LSR_SET{0}; // _>>>=_
-    static constexpr MjOperatorKind AND_SET{0}; // _&=_
-    static constexpr MjOperatorKind XOR_SET{0}; // _^=_
-    static constexpr MjOperatorKind OR_SET{0}; // _|=_
-
-
-
-    static constexpr MjOperatorKind SCOPE_MEMBER_ACCESS{0};   // T::m
-    static constexpr MjOperatorKind MEMBER_ACCESS{0};         // a.m
-    static constexpr MjOperatorKind SUBSCRIPT{0};             // a[b]
-    static constexpr MjOperatorKind SLICE{0};                 // a[b:c]
-    static constexpr MjOperatorKind FUNCTION_CALL{0};         // a(...)
-    static constexpr MjOperatorKind CONSTRUCTOR_CALL{0};      // T(...)
-    static constexpr MjOperatorKind BITWISE_CAST{0};          // (T: a)
-    static constexpr MjOperatorKind REFERENCE{0};             // &a
-    static constexpr MjOperatorKind DEREFERENCE{0};           // *a
-    static constexpr MjOperatorKind SAFE_DEREFERENCE{0};      // ^a
-    static constexpr MjOperatorKind NEGATION{0};              // -a
-    static constexpr MjOperatorKind INVERSION{0};             // ~a
-    static constexpr MjOperatorKind NOT{0};                   // !a
-    static constexpr MjOperatorKind POST_INCREMENT{0};        // a++
-    static constexpr MjOperatorKind POST_DECREMENT{0};        // a--
-    static constexpr MjOperatorKind SHIFT_LEFT{0};            // a << b
-    static constexpr MjOperatorKind SHIFT_RIGHT{0};           // a >> b
-    static constexpr MjOperatorKind SLIDE_LEFT{0};            // a <<< b
-    static constexpr MjOperatorKind SLIDE_RIGHT{0};           // a >>> b
-    static constexpr MjOperatorKind MULTIPLICATION{0};        // a * b
-    static constexpr MjOperatorKind DIVISION{0};              // a / b
-    static constexpr MjOperatorKind REMAINDER{0};             // a % b
-    static constexpr MjOperatorKind ADDITION{0};              // a + b
-    static constexpr MjOperatorKind SUBTRACTION{0};           // a - b
-    static constexpr MjOperatorKind BITWISE_AND{0};           // a & b
-    static constexpr MjOperatorKind BITWISE_XOR{0};           // a ^ b
-    static constexpr MjOperatorKind BITWISE_OR{0};            // a | b
-    static constexpr MjOperatorKind LOGICAL_AND{0};           // a && b
-    static constexpr MjOperatorKind LOGICAL_XOR{0};           // a ^^ b
-    static constexpr MjOperatorKind LOGICAL_OR{0};            // a || b
-    static constexpr MjOperatorKind EQUAL{0};                 // a == b
-    static constexpr MjOperatorKind NOT_EQUAL{0};             // a != b
-    static constexpr MjOperatorKind COMPARISON{0};            // a <=> b
-    static constexpr MjOperatorKind GREATER_THAN{0};          // a > b
-    static constexpr MjOperatorKind GREATER_THAN_OR_EQUAL{0}; // a >= b
-    static constexpr MjOperatorKind LESS_THAN{0};             // a < b
-    static constexpr MjOperatorKind LESS_THAN_OR_EQUAL{0};    // a <= b
-    static constexpr MjOperatorKind CONDITIONAL{0};           // a ? b : c
-    static constexpr MjOperatorKind LAMBDA{0};                // a => b
+    static constexpr MjOperatorKind SET{0};      // _=_
+    static constexpr MjOperatorKind MUL_SET{1};  // _*=_
+    static constexpr MjOperatorKind DIV_SET{2};  // _/=_
+    static constexpr MjOperatorKind MOD_SET{3};  // _%=_
+    static constexpr MjOperatorKind ADD_SET{4};  // _+=_
+    static constexpr MjOperatorKind SUB_SET{5};  // _-=_
+    static constexpr MjOperatorKind LSL_SET{6};  // _<<=_
+    static constexpr MjOperatorKind ASR_SET{7};  // _>>=_
+    static constexpr MjOperatorKind LSR_SET{8};  // _>>>=_
+    static constexpr MjOperatorKind AND_SET{9};  // _&=_
+    static constexpr MjOperatorKind XOR_SET{10}; // _^=_
+    static constexpr MjOperatorKind OR_SET{11};  // _|=_
+
+
+
+    static constexpr MjOperatorKind SCOPE_MEMBER_ACCESS{12};   // T::m
+    static constexpr MjOperatorKind MEMBER_ACCESS{13};         // a.m
+    static constexpr MjOperatorKind SUBSCRIPT{14};             // a[b]
+    static constexpr MjOperatorKind SLICE{15};                 // a[b:c]
+    static constexpr MjOperatorKind FUNCTION_CALL{16};         // a(...)
+    static constexpr MjOperatorKind CONSTRUCTOR_CALL{17};      // T(...)
+    static constexpr MjOperatorKind BITWISE_CAST{18};          // (T: a)
+    static constexpr MjOperatorKind REFERENCE{19};             // &a
+    static constexpr MjOperatorKind DEREFERENCE{20};           // *a
+    static constexpr MjOperatorKind SAFE_DEREFERENCE{21};      // ^a
+    static constexpr MjOperatorKind NEGATION{22};              // -a
+    static constexpr MjOperatorKind INVERSION{23};             // ~a
+    static constexpr MjOperatorKind NOT{24};                   // !a
+    static constexpr MjOperatorKind POST_INCREMENT{25};        // a++
+    static constexpr MjOperatorKind POST_DECREMENT{26};        // a--
+    static constexpr MjOperatorKind SHIFT_LEFT{27};            // a << b
+    static constexpr MjOperatorKind SHIFT_RIGHT{28};           // a >> b
+    static constexpr MjOperatorKind SLIDE_LEFT{29};            // a <<< b
+    static constexpr MjOperatorKind SLIDE_RIGHT{30};           // a >>> b
+    static constexpr MjOperatorKind MULTIPLICATION{31};        // a * b
+    static constexpr MjOperatorKind DIVISION{32};              // a / b
+    static constexpr MjOperatorKind REMAINDER{33};             // a % b
+    static constexpr MjOperatorKind ADDITION{34};              // a + b
+    static constexpr MjOperatorKind SUBTRACTION{35};           // a - b
+    static constexpr MjOperatorKind BITWISE_AND{36};           // a & b
+    static constexpr MjOperatorKind BITWISE_XOR{37};           // a ^ b
+    static constexpr MjOperatorKind BITWISE_OR{38};            // a | b
+    static constexpr MjOperatorKind LOGICAL_AND{39};           // a && b
+    static constexpr MjOperatorKind LOGICAL_XOR{40};           // a ^^ b
+    static constexpr MjOperatorKind LOGICAL_OR{41};            // a || b
+    static constexpr MjOperatorKind EQUAL{42};                 // a == b
+    static constexpr MjOperatorKind NOT_EQUAL{43};             // a != b
+    static constexpr MjOperatorKind COMPARISON{44};            // a <=> b
+    static constexpr MjOperatorKind GREATER_THAN{45};          // a > b
+    static constexpr MjOperatorKind GREATER_THAN_OR_EQUAL{46}; // a >= b
+    static constexpr MjOperatorKind LESS_THAN{47};             // a < b
+    static constexpr MjOperatorKind LESS_THAN_OR_EQUAL{48};    // a <= b
+    static constexpr MjOperatorKind CONDITIONAL{49};           // a ? b : c
+    static constexpr MjOperatorKind LAMBDA{50};                // a => b
+
+    static constexpr MjOperatorKind NONE{51}; // Not an operator
 };
 
 
 class MjOperatorKind : public Enum<u8>, public MjOperatorKindValues<MjOperatorKind> {
 private:
-    static
-    constexpr
-    struct {
-        u8 left_bp;            // The left hand operand binding power
-        u8 right_bp;           // The right hand operand binding power
-    } DATA[] {
-        {21, 20}, // T::m
-
-        {14, 13}, // a.m
-        {11,  0}, // a[b]
-        {11,  0}, // a[b:c]
-        {11,  0}, // a(...)
-        {11,  0}, // T(...)
-        {11,  0}, // T{...}
-        { 0,  9}, // a++
-        { 0,  9}, // a--
-
-        { 0,  9}, // &a
-        { 0,  9}, // *a
-        { 0,  9}, // -a
-        { 0,  9}, // ~a
-        { 0,  9}, // !a
-        { 0,  9}, // ++a
-        { 0,  9}, // --a
 
-        { 0,  9}, // a.*b
+    /// The operator introduced by each token kind before an operand and after an operand.
+    struct TokenTable {
+        u8 prefix[256] = {};
+        u8 infix[256] = {};
 
-        { 7,  8}, // a * b
-        { 7,  8}, // a / b
-        { 7,  8}, // a % b
+        constexpr
+        TokenTable() noexcept;
+    };
 
-        { 5,  6}, // a + b
-        { 5,  6}, // a - b
 
-        { 5,  6}, // a << b
-        { 5,  6}, // a >> b
-        { 5,  6}, // a <<< b
-        { 5,  6}, // a >>> b
+    static const TokenTable TOKEN_TABLE;
 
-        { 5,  6}, // a <=> b
 
-        { 5,  6}, // a < b
-        { 5,  6}, // a <= b
-        { 5,  6}, // a > b
-        { 5,  6}, // a >= b
+    static
+    constexpr
+    struct {
+        u8 left_bp;            // The left hand operand binding power
+        u8 right_bp;           // The right hand operand binding power
+    } DATA[] {
+        { 2,  1}, // _=_
+        { 2,  1}, // _*=_
+        { 2,  1}, // _/=_
+        { 2,  1}, // _%=_
+        { 2,  1}, // _+=_
+        { 2,  1}, // _-=_
+        { 2,  1}, // _<<=_
+        { 2,  1}, // _>>=_
+        { 2,  1}, // _>>>=_
+        { 2,  1}, // _&=_
+        { 2,  1}, // _^=_
+        { 2,  1}, // _|=_
+        {31, 32}, // T::m
+        {29, 30}, // a.m
+        {27,  0}, // a[b]
+        {27,  0}, // a[b:c]
+        {27,  0}, // a(...)
+        {27,  0}, // T(...)
+        { 0, 25}, // (T: a)
+        { 0, 25}, // &a
+        { 0, 25}, // *a
+        { 0, 25}, // ^a
+        { 0, 25}, // -a
+        { 0, 25}, // ~a
+        { 0, 25}, // !a
+        {27,  0}, // a++
+        {27,  0}, // a--
+        {19, 20}, // a << b
+        {19, 20}, // a >> b
+        {19, 20}, // a <<< b
+        {19, 20}, // a >>> b
+        {23, 24}, // a * b
+        {23, 24}, // a / b
+        {23, 24}, // a % b
+        {21, 22}, // a + b
+        {21, 22}, // a - b
+        {17, 18}, // a & b
+        {15, 16}, // a ^ b
+        {13, 14}, // a | b
+        { 9, 10}, // a && b
+        { 7,  8}, // a ^^ b
+        { 5,  6}, // a || b
+        {11, 12}, // a == b
+        {11, 12}, // a != b
+        {11, 12}, // a <=> b
+        {11, 12}, // a > b
+        {11, 12}, // a >= b
+        {11, 12}, // a < b
+        {11, 12}, // a <= b
+        { 4,  3}, // a ? b : c
+        { 2,  1}, // a => b
 
-        { 5,  6}, // a == b
-        { 5,  6}, // a != b
+        { 0,  0}, // Not an operator
+    };
+public:
 
-        { 4,  3}, // a & b
 
-        { 4,  3}, // a ^ b
+    constexpr
+    explicit
+    MjOperatorKind(u8 id) noexcept : Enum(id) {}
 
-        { 4,  3}, // a | b
 
-        { 4,  3}, // a && b
+    ///
+    /// Shared Methods
+    ///
 
-        { 4,  3}, // a || b
 
-        { 4,  3}, // a ? b : c
-        { 2,  1}, // a = b
-        { 2,  1}, // a += b
-        { 2,  1}, // a -= b
-        { 2,  1}, // a *= b
-        { 2,  1}, // a /= b
-        { 2,  1}, // a %= b
-        { 2,  1}, // a <<= b
-        { 2,  1}, // a >>= b
-        { 2,  1}, // a <<<= b
-        { 2,  1}, // a >>>= b
-        { 2,  1}, // a &= b
-        { 2,  1}, // a ^= b
-        { 2,  1}, // a |= b
-        { 2,  1}, // a &&= b
-        { 2,  1}, // a ||= b
-
-        { 1,  1}, // a => b
-
-        {1, 1}, // a
-        {1, 1}, // a
-        {1, 1}, // a
-        {1, 1}, // a
-        {1, 1}, // a
-        {1, 1}, // a
-        {1, 1}, // a
-        {1, 1}, // a
-        {1, 1}, // a
-    };
-public:
+    /// Return the prefix operator introduced by a token before an operand, or `NONE`.
+    static
+    MjOperatorKind from_prefix_token(MjTokenKind token_kind) noexcept {
+        return MjOperatorKind(TOKEN_TABLE.prefix[token_kind]);
+    }
 
 
-    constexpr
-    explicit
-    MjOperatorKind(u8 id) noexcept : Enum(id) {}
+    /// Return the infix or postfix operator introduced by a token after an operand, or `NONE`.
+    static
+    MjOperatorKind from_infix_token(MjTokenKind token_kind) noexcept {
+        return MjOperatorKind(TOKEN_TABLE.infix[token_kind]);
+    }
 
 
     ///
@@ -183,6 +192,20 @@ public:
     }
 
 
+    /// Return true if the operator assigns to its left hand operand.
+    constexpr
+    bool is_assignment() const noexcept {
+        return _id <= OR_SET;
+    }
+
+
+    /// Return true if evaluating the operator may modify an object or call a function.
+    constexpr
+    bool has_side_effects() const noexcept {
+        return is_assignment() || *this == POST_INCREMENT || *this == POST_DECREMENT || *this == FUNCTION_CALL || *this == CONSTRUCTOR_CALL;
+    }
+
+
     /// Return true if the operator is a unary prefix operator.
     constexpr
     bool is_prefix() const noexcept {
@@ -231,3 +254,64 @@ public:
         return DATA[_id].right_bp < DATA[_id].left_bp;
     }
 };
+
+
+constexpr
+MjOperatorKind::TokenTable::TokenTable() noexcept {
+    for (u32 i = 0; i < 256; ++i) {
+        prefix[i] = MjOperatorKind::NONE;
+        infix[i] = MjOperatorKind::NONE;
+    }
+
+    prefix[MjTokenKind::NEGATE] = MjOperatorKind::NEGATION;
+    prefix[MjTokenKind::INVERT] = MjOperatorKind::INVERSION;
+    prefix[MjTokenKind::NOT] = MjOperatorKind::NOT;
+    prefix[MjTokenKind::DEREFERENCE] = MjOperatorKind::DEREFERENCE;
+    prefix[MjTokenKind::REFERENCE] = MjOperatorKind::REFERENCE;
+    prefix[MjTokenKind::OPEN_CAST] = MjOperatorKind::BITWISE_CAST;
+
+    infix[MjTokenKind::SET] = MjOperatorKind::SET;
+    infix[MjTokenKind::MULTIPLY_SET] = MjOperatorKind::MUL_SET;
+    infix[MjTokenKind::DIVIDE_SET] = MjOperatorKind::DIV_SET;
+    infix[MjTokenKind::REMAINDER_SET] = MjOperatorKind::MOD_SET;
+    infix[MjTokenKind::PLUS_SET] = MjOperatorKind::ADD_SET;
+    infix[MjTokenKind::MINUS_SET] = MjOperatorKind::SUB_SET;
+    infix[MjTokenKind::LEFT_SHIFT_SET] = MjOperatorKind::LSL_SET;
+    infix[MjTokenKind::RIGHT_SHIFT_SET] = MjOperatorKind::ASR_SET;
+    infix[MjTokenKind::BITWISE_AND_SET] = MjOperatorKind::AND_SET;
+    infix[MjTokenKind::BITWISE_XOR_SET] = MjOperatorKind::XOR_SET;
+    infix[MjTokenKind::BITWISE_OR_SET] = MjOperatorKind::OR_SET;
+
+    infix[MjTokenKind::SCOPE] = MjOperatorKind::SCOPE_MEMBER_ACCESS;
+    infix[MjTokenKind::DOT] = MjOperatorKind::MEMBER_ACCESS;
+    infix[MjTokenKind::OPEN_SQUARE_BRACKET] = MjOperatorKind::SUBSCRIPT;
+    infix[MjTokenKind::OPEN_PARENTHESIS] = MjOperatorKind::FUNCTION_CALL;
+    infix[MjTokenKind::INCREMENT] = MjOperatorKind::POST_INCREMENT;
+    infix[MjTokenKind::DECREMENT] = MjOperatorKind::POST_DECREMENT;
+
+    infix[MjTokenKind::MULTIPLY] = MjOperatorKind::MULTIPLICATION;
+    infix[MjTokenKind::DIVIDE] = MjOperatorKind::DIVISION;
+    infix[MjTokenKind::REMAINDER] = MjOperatorKind::REMAINDER;
+    infix[MjTokenKind::PLUS] = MjOperatorKind::ADDITION;
+    infix[MjTokenKind::MINUS] = MjOperatorKind::SUBTRACTION;
+    infix[MjTokenKind::LEFT_SHIFT] = MjOperatorKind::SHIFT_LEFT;
+    infix[MjTokenKind::RIGHT_SHIFT] = MjOperatorKind::SHIFT_RIGHT;
+    infix[MjTokenKind::BITWISE_AND] = MjOperatorKind::BITWISE_AND;
+    infix[MjTokenKind::BITWISE_XOR] = MjOperatorKind::BITWISE_XOR;
+    infix[MjTokenKind::BITWISE_OR] = MjOperatorKind::BITWISE_OR;
+    infix[MjTokenKind::AND] = MjOperatorKind::LOGICAL_AND;
+    infix[MjTokenKind::OR] = MjOperatorKind::LOGICAL_OR;
+    infix[MjTokenKind::LOGICAL_AND] = MjOperatorKind::LOGICAL_AND;
+    infix[MjTokenKind::LOGICAL_OR] = MjOperatorKind::LOGICAL_OR;
+    infix[MjTokenKind::EQUAL] = MjOperatorKind::EQUAL;
+    infix[MjTokenKind::NOT_EQUAL] = MjOperatorKind::NOT_EQUAL;
+    infix[MjTokenKind::SPACESHIP] = MjOperatorKind::COMPARISON;
+    infix[MjTokenKind::GREATER_THAN] = MjOperatorKind::GREATER_THAN;
+    infix[MjTokenKind::GREATER_THAN_OR_EQUAL] = MjOperatorKind::GREATER_THAN_OR_EQUAL;
+    infix[MjTokenKind::LESS_THAN] = MjOperatorKind::LESS_THAN;
+    infix[MjTokenKind::LESS_THAN_OR_EQUAL] = MjOperatorKind::LESS_THAN_OR_EQUAL;
+    infix[MjTokenKind::LAMBDA] = MjOperatorKind::LAMBDA;
+}
+
+
+inline constexpr MjOperatorKind::TokenTable MjOperatorKind::TOKEN_TABLE{};
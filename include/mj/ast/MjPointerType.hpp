@@ -1,32 +1,31 @@
 #pragma once
 
-#include <mj/ast/MjType.hpp>
+#include <mj/ast/MjDerivedType.hpp>
 
 
-class MjPointerType : public MjType {
-private:
-    MjType *_base_type;
-protected:
+class MjPointerType : public MjDerivedType {
+public:
 
 
-    constexpr
-    MjPointerType(MjType *base_type, MjTypeQualifiers type_qualifiers = MjTypeQualifiers::NONE) noexcept :
-        MjType(MjItemKind::POINTER_TYPE),
-        _base_type(base_type)
-    {}
+    ///
+    /// Constructors
+    ///
 
 
-public:
+    constexpr
+    MjPointerType(MjType *base_type) noexcept :
+        MjDerivedType(MjItemKind::POINTER_TYPE, base_type)
+    {}
 
 
-    constexpr
-    const MjType *base_type() const noexcept {
-        return _base_type;
-    }
+    ///
+    /// Shared Properties
+    ///
 
 
+    static
     constexpr
-    MjType *base_type() noexcept {
-        return _base_type;
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::POINTER_TYPE;
     }
 };
@@ -2,6 +2,8 @@
 
 #include <mj/ast/MjModule.hpp>
 
+#include <filesystem>
+
 
 /// @brief A Program is an executable without a platform.
 /// It lists dependencies and has a startup and a main function.
@@ -13,7 +15,7 @@ private:
 public:
 
 
-    void export_source(const FilePath &file_path) noexcept {
+    void export_source([[maybe_unused]] const std::filesystem::path &file_path) noexcept {
 
         // Write module dependencies.
         //for (MjModule &mod : scope.modules) {
@@ -16,7 +16,7 @@ public:
 
 
     MjQualifiedType(MjType *base_type, MjTypeQualifiers type_qualifiers) noexcept :
-        MjType(MjTypeKind::QUALIFIED),
+        MjType(MjItemKind::QUALIFIED_TYPE),
         _base_type(base_type),
         _type_qualifiers(type_qualifiers)
     {}
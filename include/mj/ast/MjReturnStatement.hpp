@@ -1,6 +1,6 @@
 #pragma once
 
-#include <mj/ast/MjStatement.hpp>
+#include <mj/ast/MjExpression.hpp>
 
 
 // A statement is a structured unit of execution.
@@ -16,14 +16,22 @@ public:
 
 
     constexpr
-    MjReturnStatement(MjItemInfo item_info) noexcept : MjStatement(item_info) {}
+    MjReturnStatement(MjExpression *result = nullptr, Slice<const MjToken> tokens = nullptr) noexcept :
+        MjStatement(MjItemKind::RETURN_STATEMENT, tokens),
+        _result(result)
+    {}
+
 
+    ///
+    /// Shared Properties
+    ///
 
+
+    static
     constexpr
-    MjReturnStatement(MjItemInfo item_info, MjExpression *result) noexcept :
-        MjStatement(item_info),
-        _result(result)
-    {}
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::RETURN_STATEMENT;
+    }
 
 
     ///
@@ -14,15 +14,29 @@ public:
     ///
 
 
+    /// Safe memory is never changed through the type, so the type refers to the 'const' qualified
+    /// base type.
     constexpr
     MjSafeType(
-        MjType *base_type
+        MjConstantType *constant_type
     ) noexcept :
         MjType(MjItemKind::SAFE_TYPE),
-        _constant_type(base_type->is<MjConstantType>() ? base_type->as<MjConstantType>() : new MjConstantType(base_type))
+        _constant_type(constant_type)
     {}
 
 
+    ///
+    /// Shared Properties
+    ///
+
+
+    static
+    constexpr
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::SAFE_TYPE;
+    }
+
+
     ///
     /// Properties
     ///
@@ -1,34 +1,31 @@
 #pragma once
 
-#include <mj/ast/MjType.hpp>
+#include <mj/ast/MjDerivedType.hpp>
 
 
-class MjSliceType : public MjType {
-private:
-    MjType *_base_type;
-protected:
+class MjSliceType : public MjDerivedType {
+public:
 
 
-    constexpr
-    MjSliceType(
-        MjType *base_type,
-        MjTypeQualifiers type_qualifiers = MjTypeQualifiers::NONE
-    ) noexcept :
-        MjType(MjItemKind::SLICE_TYPE)
-    {}
+    ///
+    /// Constructors
+    ///
 
 
-public:
+    constexpr
+    MjSliceType(MjType *base_type) noexcept :
+        MjDerivedType(MjItemKind::SLICE_TYPE, base_type)
+    {}
 
 
-    constexpr
-    const MjType *base_type() const noexcept {
-        return _base_type;
-    }
+    ///
+    /// Shared Properties
+    ///
 
 
+    static
     constexpr
-    MjType *base_type() noexcept {
-        return _base_type;
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::SLICE_TYPE;
     }
 };
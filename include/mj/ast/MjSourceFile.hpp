@@ -1,10 +1,17 @@
 #pragma once
 
 #include <mj/ast/MjToken.hpp>
+#include <mj/ast/MjSourceText.hpp>
+#include <mj/ast/MjTextEdit.hpp>
+#include <mj/MjLexerCheckpoint.hpp>
 #include <mj/MjStringSet.hpp>
+#include <mj/MjStringInterner.hpp>
 
 #include <filesystem>
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <mutex>
 
 
 /// A source file object represented as a sequence of tokens and efficient string data.
@@ -12,22 +19,86 @@
 /// during the lexer phase are recorded.
 class MjSourceFile {
 private:
-    const std::filesystem::path _path;
+
+    /// The header of a tokenized file.
+    ///
+    /// The header is followed by the line offsets, the string sizes, the string data, and the
+    /// token data, in that order. Every section is stored in its in-memory representation, so a
+    /// mapped tokenized file can be decoded without parsing.
+    struct EncodingHeader {
+        u8 magic[4];          // `ENCODING_MAGIC`
+        u16 version;          // `ENCODING_VERSION`
+        u16 flags;            // Reserved
+        u32 source_size;      // The size of the source text in bytes.
+        u32 line_count;       // The number of line offsets.
+        u32 string_count;     // The number of strings.
+        u32 string_data_size; // The total size of the strings in bytes.
+        u32 token_data_size;  // The size of the token data in bytes.
+        u32 reserved;
+        u64 source_hash;      // The hash of the source text.
+    };
+
+    std::filesystem::path _path;
+    MjSourceText _text;
+
+    // Only one of the string sets is used, chosen by the size of the file. An edited file moves
+    // to the large string set once its strings outgrow the compact one.
     MjStringSet _strings;
+    MjLargeStringSet _large_strings;
+    bool _has_large_strings;
+
+    // The number of string tokens referring to each string, counted on the first edit so that the
+    // strings of removed tokens can be reclaimed, and the number of strings no longer referred to.
+    std::vector<u32> _string_refs;
+    u32 _dead_string_count = 0;
 
-    // The string IDs referenced in this file. (used for symbol lookup and removal)
-    std::vector<u16> string_ids;
+    // The global string ID of each string in this file, indexed by the local string ID.
+    std::vector<u32> _global_string_ids;
 
     // The token data
     std::vector<u8> _tokens;
 
     // The offsets of each indent token in the token stream.
     /// An extra entry to allow calculations using the index of the line after the last line.
-    std::vector<u16> _line_offsets;
+    std::vector<u32> _line_offsets;
+
+    // A lexer checkpoint at the first token boundary of each line, recorded only when the file is
+    // lexed for incremental editing or as a chunk of a larger file.
+    std::vector<MjLexerCheckpoint> _line_starts;
+
+    // The offsets of the string tokens, recorded only when the file is lexed as a chunk of a
+    // larger file, so that their string IDs can be remapped when the chunk is merged.
+    std::vector<u32> _string_token_offsets;
+    bool _records_string_tokens = false;
+
+    // The index of the line containing the start of each `LINE_INDEX_BLOCK_SIZE` bytes of the token
+    // stream, built on first use by `line_index()`.
+    mutable std::vector<u32> _line_index;
+    mutable std::atomic<bool> _has_line_index = false;
+    mutable std::mutex _line_index_mutex;
 
     // The size of the file in bytes.
-    const u32 _size = 0;
+    u32 _size = 0;
 public:
+    static constexpr u8 ENCODING_MAGIC[4] = {'M', 'J', 'T', 'K'};
+
+    // Incremented whenever the token encoding or the tokenized file layout changes.
+    static constexpr u16 ENCODING_VERSION = 4;
+
+    // Every line starts with an indent token of 2 bytes, so a block of the token stream contains
+    // the starts of at most `LINE_INDEX_BLOCK_SIZE / 2` lines.
+    static constexpr u32 LINE_INDEX_BLOCK_SIZE = 16;
+
+    // Files of at least this size use the large string set. Every string is a piece of the file
+    // text or a keyword, so the strings of a smaller file always fit in the compact string set.
+    static constexpr u32 LARGE_STRINGS_MIN_SIZE = 60 * 1024;
+
+    // String IDs are encoded in 2 bytes below this limit and in 3 bytes up to `MAX_STRING_COUNT`.
+    static constexpr u32 SHORT_STRING_ID_LIMIT = 1u << 15;
+    static constexpr u32 MAX_STRING_COUNT = 1u << 23;
+
+    // The strings of an edited file are compacted once more than this percentage of them is dead.
+    static constexpr u32 MAX_DEAD_STRING_PERCENT = 50;
 
 
     ///
@@ -40,10 +111,25 @@ public:
         u32 size = 0
     ) noexcept :
         _path(path),
+        _has_large_strings(size >= LARGE_STRINGS_MIN_SIZE),
         _size(size)
     {}
 
 
+    /// Create a source file which refers to its loaded text for the lifetime of the file. The
+    /// large string set is used regardless of the size of the text if `has_large_strings` is set.
+    MjSourceFile(
+        std::filesystem::path path,
+        MjSourceText &&text,
+        bool has_large_strings = false
+    ) noexcept :
+        _path(path),
+        _text(std::move(text)),
+        _has_large_strings(has_large_strings || _text.size() >= LARGE_STRINGS_MIN_SIZE),
+        _size(_text.size())
+    {}
+
+
     ///
     /// Operators
     ///
@@ -64,12 +150,19 @@ public:
 
 
     /// Encode this object into a tokenized file.
-    Error encode(std::filesystem::path file_path) noexcept;
+    Error encode(std::filesystem::path file_path) const noexcept;
 
 
-    /// Decode a tokenized file.
+    /// Decode a tokenized file for the source file at the given path. The source text is kept if
+    /// it is loaded, and is left untouched if decoding fails. Return null if the tokenized file is
+    /// invalid, was encoded by a different version, or does not match the size and hash of the
+    /// loaded text, so that the caller can lex the text again.
     static
-    Result<MjSourceFile> decode(std::filesystem::path file_path) noexcept;
+    MjSourceFile *decode(
+        std::filesystem::path file_path,
+        std::filesystem::path source_path,
+        MjSourceText &&text = MjSourceText()
+    ) noexcept;
 
 
     ///
@@ -102,6 +195,24 @@ public:
     }
 
 
+    /// The source text of the file, if it is still loaded.
+    const MjSourceText &text() const noexcept {
+        return _text;
+    }
+
+
+    /// Return true if the strings are stored in the large string set.
+    bool has_large_strings() const noexcept {
+        return _has_large_strings;
+    }
+
+
+    /// The number of distinct strings in the file.
+    u32 string_count() const noexcept {
+        return _has_large_strings ? _large_strings.size() : _strings.size();
+    }
+
+
     /// The number of lines in the file.
     constexpr
     u32 line_count() const noexcept {
@@ -111,27 +222,82 @@ public:
 
     /// The offset of the line in bytes by index.
     constexpr
-    u16 line_offset(u16 index) const noexcept {
+    u32 line_offset(u32 index) const noexcept {
         return _line_offsets[index];
     }
 
 
-    /// The offset of the line in bytes by index.
-    constexpr
-    u16 line_offset(MjToken token) const noexcept {
-        return *std::upper_bound(_line_offsets.begin(), _line_offsets.end(), u16(token.ptr() - _tokens.data()));
+    /// The offset of the line containing the given token in bytes.
+    u32 line_offset(MjToken token) const noexcept {
+        return _line_offsets[line_index(token)];
+    }
+
+
+    /// Return true if the lexer state was recorded at every line start for incremental lexing.
+    bool has_line_starts() const noexcept {
+        return !_line_starts.empty();
+    }
+
+
+    /// The lexer checkpoints recorded at the line starts.
+    const std::vector<MjLexerCheckpoint> &line_starts() const noexcept {
+        return _line_starts;
+    }
+
+
+    /// The index of the last line start at or before the given text offset.
+    u32 find_line_start(u32 text_offset) const noexcept {
+        auto it = std::upper_bound(_line_starts.begin(), _line_starts.end(), text_offset, [](u32 offset, const MjLexerCheckpoint &line_start) {
+            return offset < line_start.text_offset;
+        });
+
+        return it == _line_starts.begin() ? 0 : u32(it - _line_starts.begin()) - 1;
+    }
+
+
+    /// The index of the line containing the given token.
+    ///
+    /// The first call builds a side index of the token stream, so that every lookup takes a table
+    /// read and a scan over at most `LINE_INDEX_BLOCK_SIZE / 2` line offsets. Use
+    /// `search_line_index()` for a one-off lookup which should not pay for the index.
+    u32 line_index(MjToken token) const noexcept {
+        if (!_has_line_index.load(std::memory_order_acquire)) {
+            build_line_index();
+        }
+
+        u32 offset = token.ptr() - _tokens.data();
+        u32 index = _line_index[offset / LINE_INDEX_BLOCK_SIZE];
+
+        while (index + 1 < _line_offsets.size() && _line_offsets[index + 1] <= offset) {
+            index += 1;
+        }
+
+        return index;
+    }
+
+
+    /// The index of the line containing the given token by binary search.
+    u32 search_line_index(MjToken token) const noexcept {
+        u32 offset = token.ptr() - _tokens.data();
+        auto it = std::upper_bound(_line_offsets.begin(), _line_offsets.end(), offset);
+        return it == _line_offsets.begin() ? 0 : u32(it - _line_offsets.begin()) - 1;
+    }
+
+
+    /// Return true if the side index used by `line_index()` has been built.
+    bool has_line_index() const noexcept {
+        return _has_line_index.load(std::memory_order_acquire);
     }
 
 
     /// The token at the start the line at the given index.
     constexpr
-    MjToken line(u16 index) const noexcept {
+    MjToken line(u32 index) const noexcept {
         return &_tokens[line_offset(index)];
     }
 
 
     /// The token at the start the line containing the given token.
-    constexpr
     MjToken line(MjToken token) const noexcept {
         return &_tokens[line_offset(token)];
     }
@@ -139,7 +305,7 @@ public:
 
     /// The size in bytes of the line by index.
     constexpr
-    u32 line_size(u16 index) const noexcept {
+    u32 line_size(u32 index) const noexcept {
         return _line_offsets[index + 1] - _line_offsets[index] - 1;
     }
 
@@ -151,13 +317,17 @@ public:
             return token.builtin_text();
         }
 
-        return _strings[token.string_id()];
+        if (token.kind().encoding() == MjTokenEncoding::INLINE) {
+            return token.inline_text();
+        }
+
+        return string(token.string_id());
     }
 
 
     /// The token at the given offset.
     constexpr
-    MjToken token_at(u16 offset) const noexcept {
+    MjToken token_at(u32 offset) const noexcept {
         return &_tokens[offset];
     }
 
@@ -167,23 +337,44 @@ public:
     ///
 
 
-    u16 insert_string(StringView token_text) noexcept {
-        return _strings.insert(token_text);
+    /// Insert a string and return its ID. Fails once the file has `MAX_STRING_COUNT` strings,
+    /// since larger IDs do not fit in a string token.
+    Error insert_string(StringView token_text, u32 &id) noexcept {
+        if (string_count() == MAX_STRING_COUNT && !has_string(token_text)) {
+            return Error::FAILURE;
+        }
+
+        if (!_has_large_strings && (_strings.size() == U16_MAX || _strings.data_size() + token_text.size() > U16_MAX)) {
+            use_large_strings();
+        }
+
+        id = _has_large_strings ? _large_strings.insert(token_text) : _strings.insert(token_text);
+        return Error::SUCCESS;
     }
 
 
-    u32 append_string_token(MjTokenKind token_kind, u16 id) noexcept {
+    /// Append a string token with the given string ID.
+    u32 append_string_token(MjTokenKind token_kind, u32 id) noexcept {
         u32 token_index = _tokens.size();
-        _tokens.insert(_tokens.end(), {token_kind, u8(id & 0xFFu), u8(id >> 8)});
+
+        if (_records_string_tokens) {
+            _string_token_offsets.push_back(token_index);
+        }
+
+        encode_string_token(_tokens, token_kind, id);
         return token_index;
     }
 
 
-    u32 append_string_token(MjTokenKind token_kind, StringView token_text) noexcept {
-        u32 token_index = _tokens.size();
-        u16 id = _strings.insert(token_text);
-        _tokens.insert(_tokens.end(), {token_kind, u8(id & 0xFFu), u8(id >> 8)});
-        return token_index;
+    Error append_string_token(MjTokenKind token_kind, StringView token_text) noexcept {
+        u32 id;
+
+        if (insert_string(token_text, id).is_failure()) {
+            return Error::FAILURE;
+        }
+
+        append_string_token(token_kind, id);
+        return Error::SUCCESS;
     }
 
 
@@ -224,27 +415,189 @@ public:
     }
 
 
+    /// Record the lexer checkpoint at a line start.
+    void append_line_start(const MjLexerCheckpoint &line_start) noexcept {
+        _line_starts.push_back(line_start);
+    }
+
+
+    /// Drop the recorded line starts once the file will no longer be lexed incrementally.
+    void clear_line_starts() noexcept {
+        _line_starts.clear();
+        _line_starts.shrink_to_fit();
+    }
+
+
+    /// Record the offset of every string token appended from now on.
+    void record_string_tokens() noexcept {
+        _records_string_tokens = true;
+    }
+
+
+    ///
+    /// Incremental Editing
+    ///
+
+
+    /// Apply a text edit and re-lex the lines it touches, starting from the nearest line start
+    /// before the edit and stopping as soon as the lexer state matches an unchanged line again.
+    ///
+    /// The file must have been lexed with line starts recorded and its text must be loaded.
+    /// Strings of removed tokens stay in the string set until more than
+    /// `MAX_DEAD_STRING_PERCENT` of the strings are dead. The strings are then compacted, which
+    /// changes the string IDs and drops the global string IDs.
+    Error edit(const MjTextEdit &edit, bool emit_subtokens = false) noexcept;
+
+
+    /// Replace a byte range of the source text without re-lexing.
+    void replace_text(const MjTextEdit &edit) noexcept {
+        _text.replace(edit.offset, edit.size, edit.text);
+        _size = _text.size();
+    }
+
+
+    /// Remove every token and line record, so that the file can be lexed again from the start.
+    void clear_tokens() noexcept {
+        _tokens.clear();
+        _line_offsets.clear();
+        _line_starts.clear();
+        _string_token_offsets.clear();
+        _string_refs.clear();
+        _dead_string_count = 0;
+        _has_line_index.store(false, std::memory_order_release);
+    }
+
+
+    /// Remove the tokens and line offsets after the given sizes, as when a lexer checkpoint is
+    /// restored. Recorded line starts are kept.
+    void truncate_tokens(u32 token_offset, u32 line_count) noexcept {
+        _tokens.resize(token_offset);
+        _line_offsets.resize(line_count);
+        truncate_string_token_offsets(token_offset);
+        _has_line_index.store(false, std::memory_order_release);
+    }
+
+
+    /// Remove the tokens and line records from the given line start to the end of the file.
+    void truncate(u32 line_start_index) noexcept;
+
+
+    /// Replace the lines from line start `begin` up to line start `end` in place with the lines
+    /// lexed into `lines`, and move the text offsets of the lines after them by `text_delta`.
+    ///
+    /// The lines are lexed into a file sharing the edited text, from a copy of line start `begin`
+    /// whose token offset and line count are 1 and 0, after a single byte standing in for the
+    /// last token before them. Fails if the file runs out of string IDs.
+    Error replace_lines(const MjSourceFile &lines, u32 begin, u32 end, i64 text_delta) noexcept;
+
+
+    /// Append the tokens and line records of a chunk of this file from the given line start of the
+    /// chunk. The strings of the appended tokens are inserted in order of appearance, so the
+    /// string IDs are the same as if the whole file had been lexed at once. Fails if the file
+    /// runs out of string IDs.
+    Error append_chunk(const MjSourceFile &chunk, u32 line_start_index) noexcept;
+
+
     ///
     /// Type Names
     ///
 
 
-    StringView string(u16 id) const noexcept {
-        return _strings[id];
+    StringView string(u32 id) const noexcept {
+        return _has_large_strings ? _large_strings[id] : _strings[id];
     }
 
 
-    bool has_string_id(u16 id) const noexcept {
-        return _strings.has_string_id(id);
+    bool has_string_id(u32 id) const noexcept {
+        return id < string_count();
     }
 
 
     bool has_string(StringView string) const noexcept {
-        return _strings.has_string(string);
+        return _has_large_strings ? _large_strings.has_string(string) : _strings.has_string(string);
+    }
+
+
+    u32 string_id(StringView string) const noexcept {
+        return _has_large_strings ? _large_strings.id_of(string) : _strings.id_of(string);
+    }
+
+
+    ///
+    /// Global Strings
+    ///
+
+
+    /// Return true if the strings of this file have been interned.
+    bool is_interned() const noexcept {
+        return _global_string_ids.size() == string_count();
+    }
+
+
+    /// Return the global string ID of the given local string ID.
+    u32 global_string_id(u32 id) const noexcept {
+        return _global_string_ids[id];
+    }
+
+
+    /// Return the global string ID of the given string token.
+    u32 global_string_id(MjToken token) const noexcept {
+        return _global_string_ids[token.string_id()];
     }
 
 
-    u16 string_id(StringView string) const noexcept {
-        return _strings.id_of(string);
+    /// Intern every string of this file and record the mapping from local to global string IDs.
+    void intern(MjStringInterner &interner) noexcept {
+        std::vector<StringView> strings;
+        strings.reserve(string_count());
+
+        for (u32 id = _global_string_ids.size(); id < string_count(); ++id) {
+            strings.push_back(string(id));
+        }
+
+        u32 offset = _global_string_ids.size();
+        _global_string_ids.resize(string_count());
+        interner.insert(strings.data(), _global_string_ids.data() + offset, strings.size());
     }
+
+
+private:
+
+
+    /// Build the side index used by `line_index()`, unless another thread already has.
+    void build_line_index() const noexcept;
+
+
+    /// Drop the recorded string token offsets at or after the given token offset.
+    void truncate_string_token_offsets(u32 token_offset) noexcept {
+        while (!_string_token_offsets.empty() && _string_token_offsets.back() >= token_offset) {
+            _string_token_offsets.pop_back();
+        }
+    }
+
+
+    /// Encode a string token. IDs below `SHORT_STRING_ID_LIMIT` take 2 bytes. Larger IDs set the
+    /// high bit of the second byte and take a third byte for the upper bits.
+    static
+    void encode_string_token(std::vector<u8> &tokens, MjTokenKind token_kind, u32 id) noexcept {
+        assert(id < MAX_STRING_COUNT);
+
+        if (id < SHORT_STRING_ID_LIMIT) {
+            tokens.insert(tokens.end(), {token_kind, u8(id & 0xFFu), u8(id >> 8)});
+        } else {
+            tokens.insert(tokens.end(), {token_kind, u8(id & 0xFFu), u8(0x80u | ((id >> 8) & 0x7Fu)), u8(id >> 15)});
+        }
+    }
+
+
+    /// Move the strings to the large string set, keeping their IDs.
+    void use_large_strings() noexcept;
+
+
+    /// Count the string tokens referring to each string.
+    void count_string_refs() noexcept;
+
+
+    /// Remove the strings which no string token refers to, and renumber the others in order.
+    void compact_strings() noexcept;
 };
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <core/Error.hpp>
+#include <core/StringView.hpp>
+#include <format/ASCII/AsciiScanner.hpp>
+
+#include <filesystem>
+#include <vector>
+
+
+/// The raw text of a source file.
+///
+/// The text is followed by a null byte which acts as a sentinel value for the lexer, and then by
+/// `PADDING` zeroed bytes so that vectorized scans may load whole vectors at the end of the text.
+///
+/// Regular files are memory mapped without copying. The mapping is placed over a zeroed anonymous
+/// reservation, so when the file ends too close to a page boundary for the kernel zero-fill of the
+/// last partial page to hold the sentinel and padding, the following anonymous page provides them.
+/// Anything that cannot be mapped is read into a padded heap buffer instead.
+class MjSourceText {
+private:
+    std::vector<u8> _buffer; // The fallback copy of the text when it could not be mapped.
+    const u8 *_data = nullptr;
+    u32 _size = 0;
+    u32 _mapped_size = 0; // The size of the mapping in bytes or zero if the text is not mapped.
+public:
+    static constexpr u32 PADDING = Ascii::SCAN_PADDING;
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    MjSourceText() noexcept {}
+
+
+    MjSourceText(MjSourceText &&other) noexcept :
+        _buffer(std::move(other._buffer)),
+        _data(other._data),
+        _size(other._size),
+        _mapped_size(other._mapped_size)
+    {
+        other._data = nullptr;
+        other._size = 0;
+        other._mapped_size = 0;
+    }
+
+
+    MjSourceText(const MjSourceText &) = delete;
+
+
+    ///
+    /// Destructor
+    ///
+
+
+    ~MjSourceText() {
+        unload();
+    }
+
+
+    ///
+    /// Operators
+    ///
+
+
+    MjSourceText &operator=(MjSourceText &&other) noexcept {
+        if (this != &other) {
+            unload();
+            _buffer = std::move(other._buffer);
+            _data = other._data;
+            _size = other._size;
+            _mapped_size = other._mapped_size;
+            other._data = nullptr;
+            other._size = 0;
+            other._mapped_size = 0;
+        }
+
+        return *this;
+    }
+
+
+    MjSourceText &operator=(const MjSourceText &) = delete;
+
+
+    ///
+    /// Factory
+    ///
+
+
+    /// Load the text of the file at the given path.
+    Error load(const std::filesystem::path &path) noexcept;
+
+
+    ///
+    /// Properties
+    ///
+
+
+    /// Return true if the text has been loaded.
+    bool is_loaded() const noexcept {
+        return _data != nullptr;
+    }
+
+
+    /// Return true if the text refers to a mapping of the file.
+    bool is_mapped() const noexcept {
+        return _mapped_size != 0;
+    }
+
+
+    /// The null terminated text.
+    const u8 *data() const noexcept {
+        return _data;
+    }
+
+
+    /// The size of the text in bytes, excluding the sentinel.
+    u32 size() const noexcept {
+        return _size;
+    }
+
+
+    /// The whole text.
+    StringView text() const noexcept {
+        return {_data, _size};
+    }
+
+
+    /// The text in the given byte range.
+    StringView text(u32 offset, u32 size) const noexcept {
+        return {_data + offset, size};
+    }
+
+
+    /// The 64 bit FNV-1a hash of the text.
+    u64 hash() const noexcept;
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// Return a view of the text which does not own it. The text must outlive the view.
+    MjSourceText view() const noexcept {
+        MjSourceText text;
+        text._data = _data;
+        text._size = _size;
+        return text;
+    }
+
+
+    /// Replace the given byte range of the text in place, moving only the text after it. The
+    /// text is copied into the padded fallback buffer on the first edit, so a mapped text is no
+    /// longer mapped afterwards.
+    void replace(u32 offset, u32 size, StringView text) noexcept;
+
+
+private:
+
+
+    /// Map the regular file open on the given descriptor.
+    Error map(i32 fd, u32 size) noexcept;
+
+
+    /// Read the file open on the given descriptor into the padded fallback buffer in chunks until
+    /// the end of the file, so that pipes and other files without a known size can be read.
+    Error read(i32 fd, const std::filesystem::path &path) noexcept;
+
+
+    void unload() noexcept;
+};
@@ -19,6 +19,10 @@ protected:
     MjStatement(MjItemInfo item_info) noexcept : MjItem(item_info) {}
 
 
+    constexpr
+    MjStatement(MjItemKind item_kind, Slice<const MjToken> tokens) noexcept : MjItem(item_kind, tokens) {}
+
+
     ///
     /// Destructor
     ///
@@ -39,7 +43,7 @@ public:
     static
     constexpr
     bool is_type_of(const MjItem *item) {
-        return item->item_kind() == MjItemKind::STATEMENT;
+        return item->item_kind().is_statement();
     }
 
 
@@ -10,9 +10,13 @@ public:
 
 
     constexpr
-    MjTemplateArgumentList(std::nullptr_t = nullptr) noexcept : _value(nullptr) {}
+    MjTemplateArgumentList(std::nullptr_t = nullptr) noexcept :
+        MjItem(MjItemKind::TEMPLATE_ARGUMENT_LIST), _value(nullptr)
+    {}
 
 
     constexpr
-    MjTemplateArgumentList(MjItem *value) noexcept : _value(value) {}
+    MjTemplateArgumentList(MjItem *value) noexcept :
+        MjItem(MjItemKind::TEMPLATE_ARGUMENT_LIST), _value(value)
+    {}
 };
@@ -10,9 +10,13 @@ public:
 
 
     constexpr
-    MjTemplateParameterList(std::nullptr_t = nullptr) noexcept : _value(nullptr) {}
+    MjTemplateParameterList(std::nullptr_t = nullptr) noexcept :
+        MjItem(MjItemKind::TEMPLATE_PARAMETER_LIST), _value(nullptr)
+    {}
 
 
     constexpr
-    MjTemplateParameterList(MjDeclaration *value) noexcept : _value(value) {}
+    MjTemplateParameterList(MjDeclaration *value) noexcept :
+        MjItem(MjItemKind::TEMPLATE_PARAMETER_LIST), _value(value)
+    {}
 };
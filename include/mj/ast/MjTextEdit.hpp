@@ -0,0 +1,25 @@
+#pragma once
+
+#include <core/StringView.hpp>
+
+
+/// A replacement of a byte range of a source text, as sent by an editor.
+struct MjTextEdit {
+    u32 offset;      // The offset of the replaced range in bytes.
+    u32 size;        // The size of the replaced range in bytes.
+    StringView text; // The replacement text.
+
+
+    /// The offset of the end of the replaced range in bytes.
+    constexpr
+    u32 end() const noexcept {
+        return offset + size;
+    }
+
+
+    /// The change in the size of the text in bytes.
+    constexpr
+    i64 size_delta() const noexcept {
+        return i64(text.size()) - size;
+    }
+};
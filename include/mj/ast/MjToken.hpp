@@ -72,9 +72,14 @@ public:
     }
 
 
-    constexpr
-    u8 size() const noexcept {
-        return kind().encoded_size();
+    /// The size of the token in the token stream in bytes.
+    constexpr
+    u32 size() const noexcept {
+        switch (kind().encoding()) {
+        case MjTokenEncoding::STRING: return _ptr[2] & 0x80u ? 4 : 3;
+        case MjTokenEncoding::INLINE: return 3 + (u32(_ptr[1]) | u32(_ptr[2]) << 8);
+        default: return kind().encoded_size();
+        }
     }
 
 
@@ -104,10 +109,18 @@ public:
     }
 
 
-    /// The ID of the token.
+    /// The ID of the token. A set high bit in the second byte marks a 3 byte ID.
+    constexpr
+    u32 string_id() const noexcept {
+        u32 id = u32(_ptr[1]) | u32(_ptr[2] & 0x7Fu) << 8;
+        return _ptr[2] & 0x80u ? id | u32(_ptr[3]) << 15 : id;
+    }
+
+
+    /// The text stored after the header of an inline token.
     constexpr
-    u16 string_id() const noexcept {
-        return u16(_ptr[1]) | u16(_ptr[2]);
+    StringView inline_text() const noexcept {
+        return {_ptr + 3, u32(_ptr[1]) | u32(_ptr[2]) << 8};
     }
 
 
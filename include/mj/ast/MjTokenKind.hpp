@@ -25,6 +25,25 @@ struct MjTokenStringKind : public Enum<u8>, public MjTokenStringKindValues<MjTok
 };
 
 
+/// The layout of a token in the token stream.
+template<class MjTokenEncoding>
+struct MjTokenEncodingValues {
+    static constexpr MjTokenEncoding FIXED{0};    // `[kind]`
+    static constexpr MjTokenEncoding BYTE{1};     // `[kind, value]`
+    static constexpr MjTokenEncoding STRING{2};   // `[kind, id[7:0], id[14:8]]` or `[kind, id[7:0], 0x80 | id[14:8], id[22:15]]`
+    static constexpr MjTokenEncoding INLINE{3};   // `[kind, size[7:0], size[15:8], text...]`
+    static constexpr MjTokenEncoding SUBTOKEN{4}; // `[kind, char_offset, size]`
+};
+
+
+struct MjTokenEncoding : public Enum<u8>, public MjTokenEncodingValues<MjTokenEncoding> {
+
+    constexpr
+    explicit
+    MjTokenEncoding(u8 id) noexcept : Enum(id) {}
+};
+
+
 struct MjNumberTokenInfo {
     u8 has_fraction : 1;
     u8 has_exponent : 1;
@@ -58,38 +77,38 @@ struct MjTokenKindValues {
     ///
 
 
-    static constexpr MjTokenKind AND{4};         // `and`
-    static constexpr MjTokenKind AS{4};          // `as`
-    static constexpr MjTokenKind ASM{5};         // `asm`
-    static constexpr MjTokenKind BITFIELD{6};    // `bitfield`
-    static constexpr MjTokenKind BREAK{7};       // `break`
-    static constexpr MjTokenKind CASE{8};        // `case`
-    static constexpr MjTokenKind CLASS{8};       // `class`
-    static constexpr MjTokenKind CONTINUE{9};    // `continue`
-    static constexpr MjTokenKind DO{10};         // `do`
-    static constexpr MjTokenKind ELSE{11};       // `else`
-    static constexpr MjTokenKind ENUM{12};       // `enum`
-    static constexpr MjTokenKind FAIL{13};       // `fail`
-    static constexpr MjTokenKind FOR{14};        // `for`
-    static constexpr MjTokenKind IF{15};         // `if`
-    static constexpr MjTokenKind IMPL{16};       // `impl`
-    static constexpr MjTokenKind IMPORT{17};     // `import`
-    static constexpr MjTokenKind IN{18};         // `in`
-    static constexpr MjTokenKind INTERFACE{19};  // `interface`
-    static constexpr MjTokenKind IS{20};         // `is`
-    static constexpr MjTokenKind MATCH{22};      // `match`
-    static constexpr MjTokenKind NOT{57};        // `not`
-    static constexpr MjTokenKind OR{22};         // `or`
-    static constexpr MjTokenKind RETURN{23};     // `return`
-    static constexpr MjTokenKind STRUCT{24};     // `struct`
-    static constexpr MjTokenKind TYPE{25};       // `type`
-    static constexpr MjTokenKind THEN{25};       // `then`
-    static constexpr MjTokenKind UNION{26};      // `union`
-    static constexpr MjTokenKind UNIT{27};       // `unit`
-    static constexpr MjTokenKind UNTIL{28};      // `until`
-    static constexpr MjTokenKind WHERE{30};      // `where`
-    static constexpr MjTokenKind WHILE{31};      // `while`
-    static constexpr MjTokenKind YIELD{32};      // `yield`
+    static constexpr MjTokenKind AND{4};        // `and`
+    static constexpr MjTokenKind AS{5};         // `as`
+    static constexpr MjTokenKind ASM{6};        // `asm`
+    static constexpr MjTokenKind BITFIELD{7};   // `bitfield`
+    static constexpr MjTokenKind BREAK{8};      // `break`
+    static constexpr MjTokenKind CASE{9};       // `case`
+    static constexpr MjTokenKind CLASS{10};     // `class`
+    static constexpr MjTokenKind CONTINUE{11};  // `continue`
+    static constexpr MjTokenKind DO{12};        // `do`
+    static constexpr MjTokenKind ELSE{13};      // `else`
+    static constexpr MjTokenKind ENUM{14};      // `enum`
+    static constexpr MjTokenKind FAIL{15};      // `fail`
+    static constexpr MjTokenKind FOR{16};       // `for`
+    static constexpr MjTokenKind IF{17};        // `if`
+    static constexpr MjTokenKind IMPL{18};      // `impl`
+    static constexpr MjTokenKind IMPORT{19};    // `import`
+    static constexpr MjTokenKind IN{20};        // `in`
+    static constexpr MjTokenKind INTERFACE{21}; // `interface`
+    static constexpr MjTokenKind IS{22};        // `is`
+    static constexpr MjTokenKind MATCH{23};     // `match`
+    static constexpr MjTokenKind NOT{24};       // `not`
+    static constexpr MjTokenKind OR{25};        // `or`
+    static constexpr MjTokenKind RETURN{26};    // `return`
+    static constexpr MjTokenKind STRUCT{27};    // `struct`
+    static constexpr MjTokenKind THEN{28};      // `then`
+    static constexpr MjTokenKind TYPE{29};      // `type`
+    static constexpr MjTokenKind UNION{30};     // `union`
+    static constexpr MjTokenKind UNIT{31};      // `unit`
+    static constexpr MjTokenKind UNTIL{32};     // `until`
+    static constexpr MjTokenKind WHERE{33};     // `where`
+    static constexpr MjTokenKind WHILE{34};     // `while`
+    static constexpr MjTokenKind YIELD{35};     // `yield`
 
 
     ///
@@ -97,9 +116,10 @@ struct MjTokenKindValues {
     ///
 
 
-    static constexpr MjTokenKind CONST{33};    // `const`
-    static constexpr MjTokenKind MUTABLE{34};  // `mutable`
-    static constexpr MjTokenKind SAFE{35};     // `safe`
+    static constexpr MjTokenKind CONST{36};    // `const`
+    static constexpr MjTokenKind MUTABLE{37};  // `mutable`
+    static constexpr MjTokenKind SAFE{38};     // `safe`
+    static constexpr MjTokenKind VOLATILE{39}; // `volatile`
 
 
     ///
@@ -107,10 +127,10 @@ struct MjTokenKindValues {
     ///
 
 
-    static constexpr MjTokenKind TRUE{37};          // `true`
-    static constexpr MjTokenKind FALSE{38};         // `false`
-    static constexpr MjTokenKind NULL_{39};         // `null`
-    static constexpr MjTokenKind UNINITIALIZED{40}; // `uninitialized`
+    static constexpr MjTokenKind TRUE{40};          // `true`
+    static constexpr MjTokenKind FALSE{41};         // `false`
+    static constexpr MjTokenKind NULL_{42};         // `null`
+    static constexpr MjTokenKind UNINITIALIZED{43}; // `uninitialized`
 
 
     ///
@@ -118,14 +138,15 @@ struct MjTokenKindValues {
     ///
 
 
-    static constexpr MjTokenKind INVALID_IDENTIFIER{41}; // `.*`
-    static constexpr MjTokenKind ANNOTATION_NAME{42};    // `[a-z0-9][a-z0-9.+-]*`
-    static constexpr MjTokenKind VARIABLE_NAME{43};      // `[a-z0-9_]*[a-z][a-z0-9_]*`
-    static constexpr MjTokenKind FUNCTION_NAME{44};      // `[a-z0-9_]*[a-z][a-z0-9_]*(?=[(<&])`
-    static constexpr MjTokenKind CONSTANT_NAME{45};      // `[A-Z0-9_]*[A-Z][A-Z0-9_]*`
-    static constexpr MjTokenKind TYPE_NAME{46};          // `[A-Z0-9][A-Z0-9+-]*[a-z][A-Za-z0-9+-]*`
-    static constexpr MjTokenKind NUMERIC_LITERAL{48};    // `<number>`
-    static constexpr MjTokenKind UNIT_EXPRESSION{49};    // `(?:[A-Za-zµΩÅ°'\"]|\\^g|1/)[A-Za-z0-9⁰¹²³⁴⁵⁶⁷⁸⁹⁻⸍µΩÅ°'\"·^*/-]*`
+    static constexpr MjTokenKind INVALID_IDENTIFIER{44}; // `.*`
+    static constexpr MjTokenKind ANNOTATION_NAME{45};    // `[a-z0-9][a-z0-9.+-]*`
+    static constexpr MjTokenKind VARIABLE_NAME{46};      // `[a-z0-9_]*[a-z][a-z0-9_]*`
+    static constexpr MjTokenKind FUNCTION_NAME{47};      // `[a-z0-9_]*[a-z][a-z0-9_]*(?=[(<&])`
+    static constexpr MjTokenKind CONSTANT_NAME{48};      // `[A-Z0-9_]*[A-Z][A-Z0-9_]*`
+    static constexpr MjTokenKind TYPE_NAME{49};          // `[A-Z0-9][A-Z0-9+-]*[a-z][A-Za-z0-9+-]*`
+    static constexpr MjTokenKind MODULE_NAME{50};        // `[a-z0-9_]*[a-z][a-z0-9_]*(?=::)`
+    static constexpr MjTokenKind NUMERIC_LITERAL{51};    // `<number>`
+    static constexpr MjTokenKind UNIT_EXPRESSION{52};    // `(?:[A-Za-zµΩÅ°'\"]|\\^g|1/)[A-Za-z0-9⁰¹²³⁴⁵⁶⁷⁸⁹⁻⸍µΩÅ°'\"·^*/-]*`
 
 
     ///
@@ -133,9 +154,9 @@ struct MjTokenKindValues {
     ///
 
 
-    static constexpr MjTokenKind RAW_STRING_LITERAL{50};          // `'.*'`
-    static constexpr MjTokenKind STRING_LITERAL{51};              // `".*"`
-    static constexpr MjTokenKind INTERPOLATED_STRING_LITERAL{52}; // `".*"` (with escape sequences)
+    static constexpr MjTokenKind RAW_STRING_LITERAL{53};          // `'.*'`
+    static constexpr MjTokenKind STRING_LITERAL{54};              // `".*"`
+    static constexpr MjTokenKind INTERPOLATED_STRING_LITERAL{55}; // `".*"` (with escape sequences)
 
 
     ///
@@ -143,10 +164,10 @@ struct MjTokenKindValues {
     ///
 
 
-    static constexpr MjTokenKind LINE_COMMENT{53};            // '// .*'
-    static constexpr MjTokenKind FORMATTED_LINE_COMMENT{54};  // '// .*(`.*`.*)+' (with formatting)
-    static constexpr MjTokenKind BLOCK_COMMENT{55};           // '/// .*'
-    static constexpr MjTokenKind FORMATTED_BLOCK_COMMENT{56}; // '/// .*(`.*`.*)+' (with formatting)
+    static constexpr MjTokenKind LINE_COMMENT{56};            // '// .*'
+    static constexpr MjTokenKind FORMATTED_LINE_COMMENT{57};  // '// .*(`.*`.*)+' (with formatting)
+    static constexpr MjTokenKind BLOCK_COMMENT{58};           // '/// .*'
+    static constexpr MjTokenKind FORMATTED_BLOCK_COMMENT{59}; // '/// .*(`.*`.*)+' (with formatting)
 
 
     ///
@@ -154,12 +175,12 @@ struct MjTokenKindValues {
     ///
 
 
-    static constexpr MjTokenKind INVERT{58};                 // `~a`
-    static constexpr MjTokenKind NEGATE{59};                 // `-a`
-    static constexpr MjTokenKind DEREFERENCE{60};            // `*a`
-    static constexpr MjTokenKind REFERENCE{61};              // `&a`
-    static constexpr MjTokenKind SHELL_SHORT_OPTION{62};     // `-a`
-    static constexpr MjTokenKind SHELL_LONG_OPTION{63};      // `--a`
+    static constexpr MjTokenKind INVERT{60};             // `~a`
+    static constexpr MjTokenKind NEGATE{61};             // `-a`
+    static constexpr MjTokenKind DEREFERENCE{62};        // `*a`
+    static constexpr MjTokenKind REFERENCE{63};          // `&a`
+    static constexpr MjTokenKind SHELL_SHORT_OPTION{64}; // `-a`
+    static constexpr MjTokenKind SHELL_LONG_OPTION{65};  // `--a`
 
 
     ///
@@ -167,13 +188,13 @@ struct MjTokenKindValues {
     ///
 
 
-    static constexpr MjTokenKind INCREMENT{64};               // `a++`
-    static constexpr MjTokenKind DECREMENT{65};               // `a--`
-    static constexpr MjTokenKind FUNCTION_REFERENCE{66};      // `f&`
-    static constexpr MjTokenKind POINTER_TYPE_MODIFIER{67};   // `T*`
-    static constexpr MjTokenKind REFERENCE_TYPE_MODIFIER{68}; // `T&`
-    static constexpr MjTokenKind FALLIBLE_TYPE_MODIFIER{69};  // `T?`
-    static constexpr MjTokenKind NO_RETURN_TYPE_MODIFIER{70}; // `T!`
+    static constexpr MjTokenKind INCREMENT{66};               // `a++`
+    static constexpr MjTokenKind DECREMENT{67};               // `a--`
+    static constexpr MjTokenKind FUNCTION_REFERENCE{68};      // `f&`
+    static constexpr MjTokenKind POINTER_TYPE_MODIFIER{69};   // `T*`
+    static constexpr MjTokenKind REFERENCE_TYPE_MODIFIER{70}; // `T&`
+    static constexpr MjTokenKind FALLIBLE_TYPE_MODIFIER{71};  // `T?`
+    static constexpr MjTokenKind NO_RETURN_TYPE_MODIFIER{72}; // `T!`
 
 
     ///
@@ -181,35 +202,37 @@ struct MjTokenKindValues {
     ///
 
 
-    static constexpr MjTokenKind SET{71};                    // `a = b`
-    static constexpr MjTokenKind EQUAL{72};                  // `a == b`
-    static constexpr MjTokenKind LAMBDA{73};                 // `a => b`
-    static constexpr MjTokenKind LESS_THAN{74};              // `a < b`
-    static constexpr MjTokenKind LEFT_SHIFT{75};             // `a << b`
-    static constexpr MjTokenKind LEFT_SHIFT_SET{76};         // `a <<= b`
-    static constexpr MjTokenKind LESS_THAN_OR_EQUAL{77};     // `a <= b`
-    static constexpr MjTokenKind SPACESHIP{78};              // `a <=> b`
-    static constexpr MjTokenKind GREATER_THAN{79};           // `a > b`
-    static constexpr MjTokenKind RIGHT_SHIFT{80};            // `a >> b`
-    static constexpr MjTokenKind RIGHT_SHIFT_SET{81};        // `a >>= b`
-    static constexpr MjTokenKind GREATER_THAN_OR_EQUAL{82};  // `a >= b`
-    static constexpr MjTokenKind MULTIPLY{83};               // `a * b`
-    static constexpr MjTokenKind MULTIPLY_SET{84};           // `a *= b`
-    static constexpr MjTokenKind DIVIDE{85};                 // `a / b`
-    static constexpr MjTokenKind DIVIDE_SET{86};             // `a /= b`
-    static constexpr MjTokenKind REMAINDER{87};              // `a % b`
-    static constexpr MjTokenKind REMAINDER_SET{88};          // `a %= b`
-    static constexpr MjTokenKind PLUS{89};                   // `a + b`
-    static constexpr MjTokenKind PLUS_SET{90};               // `a += b`
-    static constexpr MjTokenKind MINUS{91};                  // `a - b`
-    static constexpr MjTokenKind MINUS_SET{92};              // `a -= b`
-    static constexpr MjTokenKind BITWISE_AND{93};            // `a & b`
-    static constexpr MjTokenKind BITWISE_AND_SET{94};        // `a &= b`
-    static constexpr MjTokenKind BITWISE_OR{95};             // `a | b`
-    static constexpr MjTokenKind BITWISE_OR_SET{96};         // `a |= b`
-    static constexpr MjTokenKind BITWISE_XOR{97};            // `a ^ b`
-    static constexpr MjTokenKind BITWISE_XOR_SET{98};        // `a ^= b`
-    static constexpr MjTokenKind NOT_EQUAL{101};             // `a != b`
+    static constexpr MjTokenKind SET{73};                   // `a = b`
+    static constexpr MjTokenKind EQUAL{74};                 // `a == b`
+    static constexpr MjTokenKind LAMBDA{75};                // `a => b`
+    static constexpr MjTokenKind LESS_THAN{76};             // `a < b`
+    static constexpr MjTokenKind LEFT_SHIFT{77};            // `a << b`
+    static constexpr MjTokenKind LEFT_SHIFT_SET{78};        // `a <<= b`
+    static constexpr MjTokenKind LESS_THAN_OR_EQUAL{79};    // `a <= b`
+    static constexpr MjTokenKind SPACESHIP{80};             // `a <=> b`
+    static constexpr MjTokenKind GREATER_THAN{81};          // `a > b`
+    static constexpr MjTokenKind RIGHT_SHIFT{82};           // `a >> b`
+    static constexpr MjTokenKind RIGHT_SHIFT_SET{83};       // `a >>= b`
+    static constexpr MjTokenKind GREATER_THAN_OR_EQUAL{84}; // `a >= b`
+    static constexpr MjTokenKind MULTIPLY{85};              // `a * b`
+    static constexpr MjTokenKind MULTIPLY_SET{86};          // `a *= b`
+    static constexpr MjTokenKind DIVIDE{87};                // `a / b`
+    static constexpr MjTokenKind DIVIDE_SET{88};            // `a /= b`
+    static constexpr MjTokenKind REMAINDER{89};             // `a % b`
+    static constexpr MjTokenKind REMAINDER_SET{90};         // `a %= b`
+    static constexpr MjTokenKind PLUS{91};                  // `a + b`
+    static constexpr MjTokenKind PLUS_SET{92};              // `a += b`
+    static constexpr MjTokenKind MINUS{93};                 // `a - b`
+    static constexpr MjTokenKind MINUS_SET{94};             // `a -= b`
+    static constexpr MjTokenKind BITWISE_AND{95};           // `a & b`
+    static constexpr MjTokenKind BITWISE_AND_SET{96};       // `a &= b`
+    static constexpr MjTokenKind BITWISE_OR{97};            // `a | b`
+    static constexpr MjTokenKind BITWISE_OR_SET{98};        // `a |= b`
+    static constexpr MjTokenKind BITWISE_XOR{99};           // `a ^ b`
+    static constexpr MjTokenKind BITWISE_XOR_SET{100};      // `a ^= b`
+    static constexpr MjTokenKind LOGICAL_AND{101};          // `a && b`
+    static constexpr MjTokenKind LOGICAL_OR{102};           // `a || b`
+    static constexpr MjTokenKind NOT_EQUAL{103};            // `a != b`
 
 
     ///
@@ -217,16 +240,16 @@ struct MjTokenKindValues {
     ///
 
 
-    static constexpr MjTokenKind SCOPE{104};                // `T::m`
-    static constexpr MjTokenKind DOT{105};                  // `a.m`
+    static constexpr MjTokenKind SCOPE{104}; // `T::m`
+    static constexpr MjTokenKind DOT{105};   // `a.m`
 
-    static constexpr MjTokenKind COMMA{106};                // `,`
-    static constexpr MjTokenKind SEMICOLON{107};            // `;`
-    static constexpr MjTokenKind COLON{108};                // `:`
+    static constexpr MjTokenKind COMMA{106};     // `,`
+    static constexpr MjTokenKind SEMICOLON{107}; // `;`
+    static constexpr MjTokenKind COLON{108};     // `:`
 
-    static constexpr MjTokenKind HASH{109};                 // `#`
-    static constexpr MjTokenKind DOLLAR_SIGN{110};          // `$`
-    static constexpr MjTokenKind AT{111};                   // `@`
+    static constexpr MjTokenKind HASH{109};        // `#`
+    static constexpr MjTokenKind DOLLAR_SIGN{110}; // `$`
+    static constexpr MjTokenKind AT{111};          // `@`
 
     static constexpr MjTokenKind OPEN_PARENTHESIS{112};     // `(`
     static constexpr MjTokenKind CLOSE_PARENTHESIS{113};    // `)`
@@ -237,10 +260,10 @@ struct MjTokenKindValues {
     static constexpr MjTokenKind OPEN_ANGLE_BRACKET{118};   // `<`
     static constexpr MjTokenKind CLOSE_ANGLE_BRACKET{119};  // `>`
 
-    static constexpr MjTokenKind OPEN_CAST{120};     // `(`
-    static constexpr MjTokenKind CLOSE_CAST{121};    // `)`
-    static constexpr MjTokenKind OPEN_TYPE{122};     // `(`
-    static constexpr MjTokenKind CLOSE_TYPE{123};    // `)`
+    static constexpr MjTokenKind OPEN_CAST{120};  // `(`
+    static constexpr MjTokenKind CLOSE_CAST{121}; // `)`
+    static constexpr MjTokenKind OPEN_TYPE{122};  // `(`
+    static constexpr MjTokenKind CLOSE_TYPE{123}; // `)`
 
 
     ///
@@ -274,96 +297,88 @@ private:
     struct Data {
         StringView name;
         StringView text;
-        struct Flags {
-            u8 can_be_variable : 1;
-            u8 can_be_template : 1;
-            u8 can_be_function : 1;
-            u8 keyword_always  : 1;
-            u8 keyword_if_type : 1;
-            u8 keyword_if_angle : 1;
-            u8 keyword_if_brace : 1;
-            u8 keyword_if_variable : 1;
-            u8 keyword_if_expression : 1;
-        } flags;
     } DATA[] {
-        {"NONE",       nullptr},
-        {"INVALID",    nullptr},
-        {"INDENT",     nullptr},
-        {"WHITESPACE", nullptr},
-
-        {"AND",                    "and",               },
-        {"AS",                     "as",                },
-        {"ASM",                    "asm",               },
-        {"BREAK",                  "break",             },
-        {"BITFIELD",               "bitfield",          },
-        {"CLASS",                  "class",             },
-        {"CONTINUE",               "continue",          },
-        {"DO",                     "do",                },
-        {"ELSE",                   "else",              },
-        {"ENUM",                   "enum",              },
-        {"FAIL",                   "fail",              },
-        {"FOR",                    "for",               },
-        {"IF",                     "if",                },
-        {"IMPL",                   "impl",              },
-        {"IMPORT",                 "import",            },
-        {"IN",                     "in",                },
-        {"INTERFACE",              "interface",         },
-        {"IS",                     "is",                },
-        {"MATCH",                  "match",             },
-        {"NOT",                    "not",               },
-        {"OR",                     "or",                },
-        {"RETURN",                 "return",            },
-        {"STRUCT",                 "struct",            },
-        {"TYPE",                   "type",              },
-        {"UNION",                  "union",             },
-        {"UNIT",                   "unit",              },
-        {"UNTIL",                  "until",             },
-        {"WHERE",                  "where",             },
-        {"WHILE",                  "while",             },
-        {"YIELD",                  "yield",             },
-
-        {"CONST",                  "const",             },
-        {"MUTABLE",                "mutable",           },
-        {"SAFE",                   "safe",              },
-
-        {"TRUE",                    "true",             },
-        {"FALSE",                   "false",            },
-        {"NULL",                    "null",             },
-        {"UNINITIALIZED",           "uninitialized",    },
-
-        {"INVALID_IDENTIFIER",      nullptr},
-        {"ANNOTATION_NAME",         nullptr},
-        {"VARIABLE_NAME",           nullptr},
-        {"FUNCTION_NAME",           nullptr},
-        {"CONSTANT_NAME",           nullptr},
-        {"TYPE_NAME",               nullptr},
-        {"MODULE_NAME",             nullptr},
-        {"NUMERIC_LITERAL",         nullptr},
-        {"UNIT_EXPRESSION",         nullptr},
-
-        {"RAW_STRING_LITERAL",          nullptr},
-        {"STRING_LITERAL",              nullptr},
-        {"INTERPOLATED_STRING_LITERAL", nullptr},
-
-        {"LINE_COMMENT",            nullptr},
-        {"FORMATTED_LINE_COMMENT",  nullptr},
-        {"BLOCK_COMMENT",           nullptr},
-        {"FORMATTED_BLOCK_COMMENT", nullptr},
-
-        {"INVERT",                 "~"},
-        {"NEGATE",                 "-"},
-        {"DEREFERENCE",            "*"},
-        {"REFERENCE",              "&"},
-        {"SHELL_SHORT_OPTION",     "-"},
-        {"SHELL_LONG_OPTION",      "--"},
-
-        {"INCREMENT",               "++"},
-        {"DECREMENT",               "--"},
-        {"FUNCTION_REFERENCE",      "&"},
-        {"POINTER_TYPE_MODIFIER",   "*"},
-        {"REFERENCE_TYPE_MODIFIER", "&"},
-        {"FALLIBLE_TYPE_MODIFIER",  "?"},
-        {"NO_RETURN_TYPE_MODIFIER", "!"},
+        {"NONE",        nullptr},
+        {"INVALID",     nullptr},
+        {"INDENT",      nullptr},
+        {"WHITESPACE",  nullptr},
+
+        {"AND",        "and"},
+        {"AS",         "as"},
+        {"ASM",        "asm"},
+        {"BITFIELD",   "bitfield"},
+        {"BREAK",      "break"},
+        {"CASE",       "case"},
+        {"CLASS",      "class"},
+        {"CONTINUE",   "continue"},
+        {"DO",         "do"},
+        {"ELSE",       "else"},
+        {"ENUM",       "enum"},
+        {"FAIL",       "fail"},
+        {"FOR",        "for"},
+        {"IF",         "if"},
+        {"IMPL",       "impl"},
+        {"IMPORT",     "import"},
+        {"IN",         "in"},
+        {"INTERFACE",  "interface"},
+        {"IS",         "is"},
+        {"MATCH",      "match"},
+        {"NOT",        "not"},
+        {"OR",         "or"},
+        {"RETURN",     "return"},
+        {"STRUCT",     "struct"},
+        {"THEN",       "then"},
+        {"TYPE",       "type"},
+        {"UNION",      "union"},
+        {"UNIT",       "unit"},
+        {"UNTIL",      "until"},
+        {"WHERE",      "where"},
+        {"WHILE",      "while"},
+        {"YIELD",      "yield"},
+
+        {"CONST",     "const"},
+        {"MUTABLE",   "mutable"},
+        {"SAFE",      "safe"},
+        {"VOLATILE",  "volatile"},
+
+        {"TRUE",           "true"},
+        {"FALSE",          "false"},
+        {"NULL",           "null"},
+        {"UNINITIALIZED",  "uninitialized"},
+
+        {"INVALID_IDENTIFIER",  nullptr},
+        {"ANNOTATION_NAME",     nullptr},
+        {"VARIABLE_NAME",       nullptr},
+        {"FUNCTION_NAME",       nullptr},
+        {"CONSTANT_NAME",       nullptr},
+        {"TYPE_NAME",           nullptr},
+        {"MODULE_NAME",         nullptr},
+        {"NUMERIC_LITERAL",     nullptr},
+        {"UNIT_EXPRESSION",     nullptr},
+
+        {"RAW_STRING_LITERAL",           nullptr},
+        {"STRING_LITERAL",               nullptr},
+        {"INTERPOLATED_STRING_LITERAL",  nullptr},
+
+        {"LINE_COMMENT",             nullptr},
+        {"FORMATTED_LINE_COMMENT",   nullptr},
+        {"BLOCK_COMMENT",            nullptr},
+        {"FORMATTED_BLOCK_COMMENT",  nullptr},
+
+        {"INVERT",              "~"},
+        {"NEGATE",              "-"},
+        {"DEREFERENCE",         "*"},
+        {"REFERENCE",           "&"},
+        {"SHELL_SHORT_OPTION",  "-"},
+        {"SHELL_LONG_OPTION",   "--"},
+
+        {"INCREMENT",                "++"},
+        {"DECREMENT",                "--"},
+        {"FUNCTION_REFERENCE",       "&"},
+        {"POINTER_TYPE_MODIFIER",    "*"},
+        {"REFERENCE_TYPE_MODIFIER",  "&"},
+        {"FALLIBLE_TYPE_MODIFIER",   "?"},
+        {"NO_RETURN_TYPE_MODIFIER",  "!"},
 
         {"SET",                    "="},
         {"EQUAL",                  "=="},
@@ -377,13 +392,6 @@ private:
         {"RIGHT_SHIFT",            ">>"},
         {"RIGHT_SHIFT_SET",        ">>="},
         {"GREATER_THAN_OR_EQUAL",  ">="},
-        {"DEREFERENCE",            "*"},
-        {"NULLABLE_POINTER",       "^"},
-        {"REFERENCE",              "&"},
-        {"INVERT",                 "~"},
-        {"NEGATE",                 "-"},
-        {"INCREMENT",              "++"},
-        {"DECREMENT",              "--"},
         {"MULTIPLY",               "*"},
         {"MULTIPLY_SET",           "*="},
         {"DIVIDE",                 "/"},
@@ -402,40 +410,50 @@ private:
         {"BITWISE_XOR_SET",        "^="},
         {"LOGICAL_AND",            "&&"},
         {"LOGICAL_OR",             "||"},
-
         {"NOT_EQUAL",              "!="},
 
-        {"SCOPE",                  "::"},
-        {"DOT",                    "."},
-        {"COMMA",                  ","},
-        {"SEMICOLON",              ";"},
-        {"COLON",                  ":"},
-        {"HASH",                   "#"},
-        {"DOLLAR_SIGN",            "$"},
-        {"AT",                     "@"},
-        {"OPEN_CAST",              "("},
-        {"CLOSE_CAST",             ")"},
-        {"OPEN_TYPE",              "("},
-        {"CLOSE_TYPE",             ")"},
-        {"OPEN_PARENTHESIS",       "("},
-        {"CLOSE_PARENTHESIS",      ")"},
-        {"OPEN_SQUARE_BRACKET",    "["},
-        {"CLOSE_SQUARE_BRACKET",   "]"},
-        {"OPEN_CURLY_BRACE",       "{"},
-        {"CLOSE_CURLY_BRACE",      "}"},
-        {"OPEN_ANGLE_BRACKET",     "<"},
-        {"CLOSE_ANGLE_BRACKET",    ">"},
-
-        {"GLOBAL_LIFETIME",        "\""},
-        {"LOCAL_LIFETIME",         "'"},
-
-        {"NUMERIC_LITERAL_PREFIX",           nullptr},
-        {"NUMERIC_LITERAL_SUFFIX",           nullptr},
-        {"CHARACTER_ESCAPE_SEQUENCE",        nullptr},
+        {"SCOPE",                 "::"},
+        {"DOT",                   "."},
+        {"COMMA",                 ","},
+        {"SEMICOLON",             ";"},
+        {"COLON",                 ":"},
+        {"HASH",                  "#"},
+        {"DOLLAR_SIGN",           "$"},
+        {"AT",                    "@"},
+        {"OPEN_PARENTHESIS",      "("},
+        {"CLOSE_PARENTHESIS",     ")"},
+        {"OPEN_SQUARE_BRACKET",   "["},
+        {"CLOSE_SQUARE_BRACKET",  "]"},
+        {"OPEN_CURLY_BRACE",      "{"},
+        {"CLOSE_CURLY_BRACE",     "}"},
+        {"OPEN_ANGLE_BRACKET",    "<"},
+        {"CLOSE_ANGLE_BRACKET",   ">"},
+        {"OPEN_CAST",             "("},
+        {"CLOSE_CAST",            ")"},
+        {"OPEN_TYPE",             "("},
+        {"CLOSE_TYPE",            ")"},
+
+        {"GLOBAL_LIFETIME",  "\""},
+        {"LOCAL_LIFETIME",   "'"},
+
+        {"NUMERIC_LITERAL_PREFIX",     nullptr},
+        {"NUMERIC_LITERAL_SUFFIX",     nullptr},
+        {"CHARACTER_ESCAPE_SEQUENCE",  nullptr},
+        {"INVALID_ESCAPE_SEQUENCE",    nullptr},
     };
 public:
 
 
+    ///
+    /// Constructors
+    ///
+
+
+    constexpr
+    explicit
+    MjTokenKind(u8 id) noexcept : Enum(id) {}
+
+
     ///
     /// Shared
     ///
@@ -462,16 +480,6 @@ public:
     }
 
 
-    ///
-    /// Constructors
-    ///
-
-
-    constexpr
-    explicit
-    MjTokenKind(u8 id) noexcept : Enum(id) {}
-
-
     ///
     /// Properties
     ///
@@ -495,45 +503,92 @@ public:
     }
 
 
+    /// Return true if this is a known token kind, as when checking decoded token data.
+    constexpr
+    bool is_valid() const noexcept {
+        return _id <= INVALID_ESCAPE_SEQUENCE;
+    }
+
+
     constexpr
     bool is_operator() const noexcept {
-        return _id - INVALID < CLOSE_ANGLE_BRACKET - INVALID;
+        return u32(_id - INVERT) <= u32(NOT_EQUAL - INVERT);
+    }
+
+
+    constexpr
+    bool is_prefix_operator() const noexcept {
+        return u32(_id - INVERT) <= u32(SHELL_LONG_OPTION - INVERT);
+    }
+
+
+    constexpr
+    bool is_postfix_operator() const noexcept {
+        return u32(_id - INCREMENT) <= u32(NO_RETURN_TYPE_MODIFIER - INCREMENT);
+    }
+
+
+    constexpr
+    bool is_infix_operator() const noexcept {
+        return u32(_id - SET) <= u32(NOT_EQUAL - SET) || _id == AND || _id == OR || _id == AS || _id == IS || _id == IN;
+    }
+
+
+    constexpr
+    bool is_open_bracket() const noexcept {
+        return (
+            _id == OPEN_PARENTHESIS || _id == OPEN_SQUARE_BRACKET || _id == OPEN_CURLY_BRACE ||
+            _id == OPEN_ANGLE_BRACKET || _id == OPEN_CAST || _id == OPEN_TYPE
+        );
+    }
+
+
+    constexpr
+    bool is_close_bracket() const noexcept {
+        return (
+            _id == CLOSE_PARENTHESIS || _id == CLOSE_SQUARE_BRACKET || _id == CLOSE_CURLY_BRACE ||
+            _id == CLOSE_ANGLE_BRACKET || _id == CLOSE_CAST || _id == CLOSE_TYPE
+        );
     }
 
 
     constexpr
     bool is_keyword() const noexcept {
-        return _id - AS < YIELD - AS;
+        return u32(_id - AND) <= u32(YIELD - AND);
     }
 
 
     constexpr
     bool is_type_qualifier() const noexcept {
-        return _id - CONST < VOLATILE - CONST;
+        return u32(_id - CONST) <= u32(VOLATILE - CONST);
     }
 
 
     constexpr
     bool is_identifier() const noexcept {
-        return _id - INVALID_IDENTIFIER < TYPE_NAME - INVALID_IDENTIFIER;
+        return u32(_id - INVALID_IDENTIFIER) <= u32(MODULE_NAME - INVALID_IDENTIFIER);
     }
 
 
     constexpr
     bool is_literal() const noexcept {
-        return true;
+        return (
+            u32(_id - TRUE) <= u32(UNINITIALIZED - TRUE) ||
+            _id == NUMERIC_LITERAL ||
+            u32(_id - RAW_STRING_LITERAL) <= u32(INTERPOLATED_STRING_LITERAL - RAW_STRING_LITERAL)
+        );
     }
 
 
     constexpr
     bool is_whitespace() const noexcept {
-        return _id & (WHITESPACE | INDENT);
+        return _id == INDENT || _id == WHITESPACE;
     }
 
 
     constexpr
     bool is_fixed_size() const noexcept {
-        return DATA[_id].text.is_empty();
+        return encoding() != MjTokenEncoding::STRING && encoding() != MjTokenEncoding::INLINE;
     }
 
 
@@ -543,34 +598,97 @@ public:
     }
 
 
-    //constexpr
-    //u8 encoded_size() const noexcept {
-    //    return DATA[_id].flags & 3;
-    //}
+    /// The layout of tokens of this kind in the token stream.
+    constexpr
+    MjTokenEncoding encoding() const noexcept {
+        if (_id == INDENT || _id == WHITESPACE) {
+            return MjTokenEncoding::BYTE;
+        }
 
+        if (_id == INVALID || _id == RAW_STRING_LITERAL || u32(_id - LINE_COMMENT) <= u32(FORMATTED_BLOCK_COMMENT - LINE_COMMENT)) {
+            return MjTokenEncoding::INLINE;
+        }
+
+        if (u32(_id - INVALID_IDENTIFIER) <= u32(UNIT_EXPRESSION - INVALID_IDENTIFIER) || _id == STRING_LITERAL || _id == INTERPOLATED_STRING_LITERAL) {
+            return MjTokenEncoding::STRING;
+        }
+
+        if (u32(_id - NUMERIC_LITERAL_PREFIX) <= u32(INVALID_ESCAPE_SEQUENCE - NUMERIC_LITERAL_PREFIX)) {
+            return MjTokenEncoding::SUBTOKEN;
+        }
+
+        return MjTokenEncoding::FIXED;
+    }
 
+
+    /// The size in bytes of the fixed part of tokens of this kind. String tokens with a 3 byte ID
+    /// take one more byte, and inline tokens are followed by their text.
     constexpr
-    u8 has_builtin_text() const noexcept {
-        return;
+    u8 encoded_size() const noexcept {
+        constexpr u8 SIZES[] = {1, 2, 3, 3, 3};
+        return SIZES[encoding()];
     }
 
 
     constexpr
-    MjTokenStringKind string_kind() const noexcept {
-        return;
+    bool has_builtin_text() const noexcept {
+        return !DATA[_id].text.is_empty();
     }
 
 
+    /// The kind of the strings of tokens of this kind, or `NONE` if they have no string.
     constexpr
-    bool has_whitespace(MjTokenKind other) noexcept {
-        return MjTokenKind::whitespace(*this, other);
+    MjTokenStringKind string_kind() const noexcept {
+        switch (_id) {
+        case ANNOTATION_NAME:
+        case VARIABLE_NAME:
+        case FUNCTION_NAME:
+        case MODULE_NAME:
+            return MjTokenStringKind::LOWERCASE;
+        case CONSTANT_NAME:
+            return MjTokenStringKind::UPPERCASE;
+        case INVALID_IDENTIFIER:
+        case TYPE_NAME:
+            return MjTokenStringKind::MIXEDCASE;
+        case NUMERIC_LITERAL:
+            return MjTokenStringKind::NUMBER_LITERALS;
+        case STRING_LITERAL:
+        case INTERPOLATED_STRING_LITERAL:
+            return MjTokenStringKind::STRING_LITERALS;
+        case UNIT_EXPRESSION:
+            return MjTokenStringKind::UNIT_EXPRESSIONS;
+        default:
+            return MjTokenStringKind::NONE;
+        }
     }
 
 
-    /// Return true if there is canonical whitespace between the given tokens.
-    //static
-    //constexpr
-    //bool whitespace(MjTokenKind a, MjTokenKind b) noexcept {
-    //    return DATA[a].flags & DATA[b].flags;
-    //}
+    /// Return true if there is canonical whitespace between a token of the given kind and a
+    /// following token of this kind.
+    ///
+    /// The lexer tells prefix, postfix, and infix operators apart by their whitespace, so this is
+    /// the whitespace which lexes back into the same kinds.
+    constexpr
+    bool has_whitespace(MjTokenKind before) const noexcept {
+        if (
+            before.is_whitespace() || before == NONE || before.is_prefix_operator() || before.is_open_bracket() ||
+            before == DOT || before == SCOPE || before == AT || before == HASH || before == DOLLAR_SIGN
+        ) {
+            return false;
+        }
+
+        if (
+            is_whitespace() || encoding() == MjTokenEncoding::SUBTOKEN || is_close_bracket() || is_postfix_operator() ||
+            _id == COMMA || _id == SEMICOLON || _id == COLON || _id == DOT || _id == SCOPE
+        ) {
+            return false;
+        }
+
+        // Calls, subscripts, and template arguments are attached to what they apply to.
+        if (_id == OPEN_PARENTHESIS || _id == OPEN_SQUARE_BRACKET || _id == OPEN_ANGLE_BRACKET) {
+            return before.is_keyword() || before.is_infix_operator() || before == COMMA || before == SEMICOLON || before == COLON;
+        }
+
+        return true;
+    }
 };
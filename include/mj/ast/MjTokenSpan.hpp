@@ -3,6 +3,7 @@
 #include <mj/ast/MjToken.hpp>
 
 
+/// A contiguous range of the token stream, given by its first token and its size in bytes.
 class MjTokenSpan {
 private:
     MjToken _start;
@@ -16,43 +17,31 @@ public:
 
 
     constexpr
-    MjTokenSpan(MjToken start, u32 size) noexcept : _start(start), _size(size) {}
-
-
-    ///
-    /// Operators
-    ///
+    MjTokenSpan() noexcept : _start(nullptr), _size(0) {}
 
 
     constexpr
-    explicit
-    operator bool() const noexcept {
-        return _ptr != nullptr;
-    }
+    MjTokenSpan(MjToken start, u32 size) noexcept : _start(start), _size(size) {}
 
 
     constexpr
-    bool operator==(MjToken other) const noexcept {
-        return _ptr == other._ptr;
-    }
+    MjTokenSpan(MjToken start, MjToken end) noexcept : _start(start), _size(u32(end.ptr() - start.ptr())) {}
 
 
-    constexpr
-    std::strong_ordering operator<=>(MjToken other) const noexcept {
-        return _ptr <=> other._ptr;
-    }
+    ///
+    /// Operators
+    ///
 
 
     constexpr
-    void operator+=(u32 offset) noexcept {
-        _ptr += offset;
+    explicit
+    operator bool() const noexcept {
+        return bool(_start);
     }
 
 
     constexpr
-    void operator++() noexcept {
-        ++_ptr;
-    }
+    bool operator==(const MjTokenSpan &other) const noexcept = default;
 
 
     ///
@@ -60,67 +49,36 @@ public:
     ///
 
 
+    /// The first token of the span.
     constexpr
-    const u8 *ptr() const noexcept {
-        return _ptr;
-    }
-
-
-    constexpr
-    u8 size() const noexcept {
-        return kind().encoded_size();
-    }
-
-
-    /// The kind of the token.
-    constexpr
-    MjTokenKind kind() const noexcept {
-        return MjTokenKind(*_ptr);
-    }
-
-
-    /// The string kind of the token.
-    constexpr
-    u8 string_kind() const noexcept {
-        return kind().string_kind();
-    }
-
-
-    constexpr
-    u8 indent() const noexcept {
-        return _ptr[1];
-    }
-
-
-    constexpr
-    u8 spaces() const noexcept {
-        return _ptr[1];
+    MjToken start() const noexcept {
+        return _start;
     }
 
 
-    /// The ID of the token.
+    /// The token following the last token of the span.
     constexpr
-    u16 string_id() const noexcept {
-        return u16(_ptr[1]) | u16(_ptr[2]);
+    MjToken end() const noexcept {
+        return MjToken(_start.ptr() + _size);
     }
 
 
-    /// The kind of the token.
+    /// The size of the span in the token stream in bytes.
     constexpr
-    bool has_builtin_text() const noexcept {
-        return kind().has_builtin_text();
+    u32 size() const noexcept {
+        return _size;
     }
 
 
-    /// The kind of the token.
     constexpr
-    StringView builtin_text() const noexcept {
-        return kind().builtin_text();
+    bool is_empty() const noexcept {
+        return _size == 0;
     }
 
 
+    /// Return true if the token lies within the span.
     constexpr
-    bool has_whitespace(MjToken other) const noexcept {
-        return kind().has_whitespace(other.kind());
+    bool contains(MjToken token) const noexcept {
+        return token >= _start && token < end();
     }
 };
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <mj/ast/MjToken.hpp>
+
+#include <vector>
+
+
+class MjSourceFile;
+
+
+/// A structure-of-arrays view of the token stream of a source file.
+///
+/// The compact token stream stays the storage and cache format. The view is decoded from it in a
+/// single pass so that the parser and the formatter can index tokens and look ahead in constant
+/// time without decoding variable length tokens again. The view refers to the token stream and is
+/// invalidated when the stream is modified.
+class MjTokenView {
+private:
+    const u8 *_stream = nullptr;
+    std::vector<u8> _kinds;
+    std::vector<u32> _payloads;
+    std::vector<u32> _offsets;
+public:
+
+
+    /// The number of `NONE` tokens following the last token, so that lookahead needs no bounds check.
+    static constexpr u32 LOOKAHEAD_SIZE = 4;
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    MjTokenView() noexcept {}
+
+
+    /// Decode the token stream of the file.
+    explicit
+    MjTokenView(const MjSourceFile &file) noexcept;
+
+
+    ///
+    /// Properties
+    ///
+
+
+    /// The number of tokens, not counting the lookahead padding.
+    u32 size() const noexcept {
+        return _offsets.size();
+    }
+
+
+    bool is_empty() const noexcept {
+        return _offsets.empty();
+    }
+
+
+    /// The kind of the token at the index, or `NONE` past the last token.
+    MjTokenKind kind(u32 index) const noexcept {
+        return MjTokenKind(_kinds[index]);
+    }
+
+
+    /// The decoded payload of the token at the index.
+    ///
+    /// This is the string ID of string tokens, the value of indent and whitespace tokens, the text
+    /// size of inline tokens and the character offset and size of subtokens packed as `offset | size << 8`.
+    u32 payload(u32 index) const noexcept {
+        return _payloads[index];
+    }
+
+
+    /// The string ID of the string token at the index.
+    u32 string_id(u32 index) const noexcept {
+        return _payloads[index];
+    }
+
+
+    /// The offset of the token at the index in the token stream.
+    u32 offset(u32 index) const noexcept {
+        return _offsets[index];
+    }
+
+
+    /// The token at the index, or null past the last token.
+    MjToken token(u32 index) const noexcept {
+        return index < size() ? MjToken(_stream + _offsets[index]) : MjToken(nullptr);
+    }
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// The index of the token at the offset in the token stream, or of the next token.
+    u32 index_of(u32 offset) const noexcept;
+
+
+    /// The index of the token in the token stream.
+    u32 index_of(MjToken token) const noexcept {
+        return index_of(u32(token.ptr() - _stream));
+    }
+};
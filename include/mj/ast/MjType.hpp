@@ -3,18 +3,72 @@
 #include <mj/ast/MjItem.hpp>
 #include <mj/ast/MjDeclaration.hpp>
 #include <mj/ast/MjAnnotation.hpp>
+#include <mj/ast/MjFunctionArgumentList.hpp>
 #include <mj/ast/MjComment.hpp>
 #include <mj/ast/MjOperatorKind.hpp>
 #include <mj/ast/MjTypeQualifiers.hpp>
+#include <mj/ast/MjMemberIndex.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 
 class MjTypeName;
+class MjSourceManager;
+class MjLayoutEngine;
+
+
+template<class MjLayoutState>
+struct MjLayoutStateValues {
+    static constexpr MjLayoutState NONE{0};        // The layout has not been computed
+    static constexpr MjLayoutState IN_PROGRESS{1}; // The layout of the type or of one of its members is being computed
+    static constexpr MjLayoutState COMPLETE{2};    // The size, alignment and member offsets are valid
+    static constexpr MjLayoutState INVALID{3};     // The layout is recursive or its annotations are invalid
+};
+
+
+struct MjLayoutState : public Enum<u8>, public MjLayoutStateValues<MjLayoutState> {
+
+    constexpr
+    explicit
+    MjLayoutState(u8 id) noexcept : Enum(id) {}
+};
 
 
 class MjType : public MjDeclaration {
+    friend class MjLayoutEngine;
 protected:
-    u32 _size;
-    u32 _alignment;
+    // The layout of the type, computed once by the layout engine.
+    u32 _size = 0;
+    u32 _alignment = 0;
+    u32 _padding = 0;
+    MjLayoutState _layout_state = MjLayoutState::NONE;
+
+    /// The index of the names declared by the type, and the indexes it replaced.
+    ///
+    /// A cleared index is replaced by a new one rather than rebuilt in place, since readers may
+    /// still hold it. A replaced index is freed once a quiescent point has passed since it was
+    /// replaced, as marked by `advance_member_index_generation()`.
+    struct MemberIndexState {
+        struct RetiredIndex {
+            std::unique_ptr<const MjMemberIndex> index;
+            u32 generation; // The generation in which the index was replaced.
+        };
+
+        std::mutex mutex;
+        std::atomic<const MjMemberIndex *> index = nullptr;
+        std::unique_ptr<const MjMemberIndex> owned_index;
+        std::vector<RetiredIndex> retired_indexes;
+    };
+
+    // Incremented at every quiescent point, when no thread holds a member index.
+    static inline std::atomic<u32> _member_index_generation = 0;
+
+    // Allocated on the first lookup, since most types, such as pointer, builtin and qualified
+    // types, never have their members looked up.
+    mutable std::atomic<MemberIndexState *> _member_index_state = nullptr;
 
 
     ///
@@ -26,9 +80,32 @@ protected:
     MjType(MjItemInfo item_info) noexcept : MjDeclaration(item_info) {}
 
 
+    constexpr
+    MjType(MjItemKind item_kind, Slice<const MjToken> tokens) noexcept : MjDeclaration(item_kind, tokens) {}
+
+
+    ~MjType() noexcept {
+        delete _member_index_state.load(std::memory_order_relaxed);
+    }
+
+
 public:
 
 
+    ///
+    /// Shared
+    ///
+
+
+    /// Mark a quiescent point, at which no thread holds a member index of any type, so that the
+    /// indexes replaced before it can be freed. The indexes are freed by the next clear or
+    /// rebuild of the index of their type.
+    static
+    void advance_member_index_generation() noexcept {
+        _member_index_generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+
     ///
     /// Properties
     ///
@@ -37,13 +114,21 @@ public:
     /// Return true if the type is 'const' qualified.
     constexpr
     bool is_const_qualified() const noexcept {
-        return is<MjConstantType>();
+        return item_kind() == MjItemKind::CONSTANT_TYPE;
     }
 
 
+    /// Return true if the type is 'safe' qualified.
     constexpr
     bool is_safe_qualified() const noexcept {
-        return is<MjSafeType>();
+        return item_kind() == MjItemKind::SAFE_TYPE;
+    }
+
+
+    /// Return true if the type is 'volatile' qualified.
+    constexpr
+    bool is_volatile_qualified() const noexcept {
+        return type_qualifiers() == MjTypeQualifiers::VOLATILE;
     }
 
 
@@ -69,7 +154,6 @@ public:
     bool is_trivially_destructible() const noexcept;
     bool is_default_destructible() const noexcept;
 
-    bool has_destructor() const noexcept;
     bool has_default_destructor() const noexcept;
     bool has_virtual_destructor() const noexcept;
 
@@ -113,10 +197,8 @@ public:
 
 
     /// Return the comment or `nullptr`.
-    constexpr
     MjComment *comment() const noexcept {
-        Slice<MjComment *const> comments = items<MjComment>();
-        return !comments.is_empty() ? *comments : nullptr;
+        return item<MjComment>();
     }
 
 
@@ -138,7 +220,7 @@ public:
 
 
     const MjTypeName *name() const noexcept {
-        return items<MjTypeName>();
+        return item<MjTypeName>();
     }
 
 
@@ -155,11 +237,9 @@ public:
     }
 
 
-    /// Return the comment or `nullptr`.
-    constexpr
-    MjComment *base_template() const noexcept {
-        Slice<MjComment *const> comments = items<MjComment>();
-        return !comments.is_empty() ? *comments : nullptr;
+    /// Return the template or `nullptr`.
+    MjTemplate *base_template() const noexcept {
+        return item<MjTemplate>();
     }
 
 
@@ -176,18 +256,13 @@ public:
 
 
     MjTemplateArgumentList *template_argument_list() const noexcept {
-        return items<MjTemplateArgumentList>();
-    }
-
-
-    MjTemplateArgumentList *template_argument_list() noexcept {
-        return items<MjTemplateArgumentList>();
+        return item<MjTemplateArgumentList>();
     }
 
 
     constexpr
     bool has_constructors() const noexcept {
-        return _constructors_size > 0;
+        return has_item<MjConstructor>();
     }
 
 
@@ -199,23 +274,18 @@ public:
     }
 
 
-    Slice<MjConstructor *> constructors() noexcept {
-        return items<MjConstructor>();
-    }
-
-
     constexpr
     bool has_destructor() const noexcept {
         return has_item<MjDestructor>();
     }
 
 
-    MjFunction *destructor() const noexcept {
-        return items<MjDestructor>();
+    MjDestructor *destructor() const noexcept {
+        return item<MjDestructor>();
     }
 
 
-    Slice<MjVariable *const> members() const noexcept {
+    Slice<MjMember *const> members() const noexcept {
         return items<MjMember>();
     }
 
@@ -268,20 +338,41 @@ public:
     }
 
 
-    /// @brief Return the size of the type in bytes.
+    /// Return true if the layout of the type has been computed.
+    constexpr
+    bool has_layout() const noexcept {
+        return _layout_state == MjLayoutState::COMPLETE;
+    }
+
+
     constexpr
+    MjLayoutState layout_state() const noexcept {
+        return _layout_state;
+    }
+
+
+    /// @brief Return the size of the type in bytes.
+    ///
+    /// Until the layout is computed, the size is the declared size, which has no padding.
     u32 size() const noexcept {
-        return _size;
+        return has_layout() || is_builtin_type() ? _size : declared_size();
     }
 
 
-    /// @brief Return the alignment of the type in bytes.
+    /// @brief Return the alignment of the type in bytes. Valid once the layout is computed.
     constexpr
     u32 alignment() const noexcept {
         return _alignment;
     }
 
 
+    /// The number of bytes of padding between the members of the type and after the last member.
+    constexpr
+    u32 padding() const noexcept {
+        return _padding;
+    }
+
+
     ///
     /// Methods
     ///
@@ -290,26 +381,62 @@ public:
 
 
 
-    const MjType *find_type(MjToken name) const noexcept;
+    /// Return the index of the names declared by the type, building it on first use. Names are
+    /// looked up by global string ID, so that names declared in one source are found from another.
+    const MjMemberIndex &member_index(const MjSourceManager &sources) const noexcept {
+        MemberIndexState *state = _member_index_state.load(std::memory_order_acquire);
+        const MjMemberIndex *member_index = state != nullptr ? state->index.load(std::memory_order_acquire) : nullptr;
+
+        if (member_index == nullptr) {
+            member_index = build_member_index(sources);
+        }
+
+        return *member_index;
+    }
+
+
+    /// Drop the member index after members are added. A new index is built on the next lookup,
+    /// while lookups already using the old index finish with it.
+    void clear_member_index() noexcept;
+
+
+    const MjType *find_type(const MjSourceManager &sources, u32 name_id) const noexcept;
 
 
-    const MjType *find_type_template(MjToken name, const MjTemplateArgumentList &argument_list) const noexcept;
+    const MjType *find_type_template(const MjSourceManager &sources, u32 name_id, const MjTemplateArgumentList &argument_list) const noexcept;
 
 
     /// A variable may be a member or a shared member. It may be a constant as well.
-    const MjVariable *find_variable(MjToken name) const noexcept;
+    const MjVariable *find_variable(const MjSourceManager &sources, u32 name_id) const noexcept;
 
 
-    const MjVariable *find_member(MjToken name) const noexcept;
+    const MjVariable *find_member(const MjSourceManager &sources, u32 name_id) const noexcept;
 
 
     /// A function may be a method or a shared function.
-    const MjFunction *find_function(MjToken name, const MjFunctionArgumentList &argument_list) const noexcept;
+    const MjFunction *find_function(const MjSourceManager &sources, u32 name_id, const MjFunctionArgumentList &argument_list) const noexcept;
 
 
-    const MjMethod *find_method(MjToken name, const MjFunctionArgumentList &argument_list) const noexcept;
+    const MjMethod *find_method(const MjSourceManager &sources, u32 name_id, const MjFunctionArgumentList &argument_list) const noexcept;
 
 
     /// A method or a function.
-    const MjFunction *find_operator(MjOperatorKind kind, const MjFunctionArgumentList &argument_list) const noexcept;
+    const MjFunction *find_operator(const MjSourceManager &sources, MjOperatorKind kind, const MjFunctionArgumentList &argument_list) const noexcept;
+
+
+private:
+
+
+    /// Return the size of the members of the type without padding: the sum of the member sizes of
+    /// a structure or class, the largest member size of a union, and the size of the base type of
+    /// other types. The type must not contain itself.
+    u32 declared_size() const noexcept;
+
+
+    /// Return the member index state, allocating it unless another thread already has.
+    MemberIndexState *member_index_state() const noexcept;
+
+
+    /// Build and return the member index, unless another thread already has.
+    const MjMemberIndex *build_member_index(const MjSourceManager &sources) const noexcept;
 };
@@ -3,6 +3,10 @@
 #include <mj/ast/MjType.hpp>
 
 
+/// A name standing for another type.
+///
+/// A type which is named before any definition of it in the parsed file, such as an imported
+/// type, is an alias without a base type until names are resolved.
 class MjTypeAlias : public MjType {
 private:
     MjType *_base_type;
@@ -14,7 +18,23 @@ public:
     ///
 
 
-    MjTypeAlias(MjType *base_type) noexcept : MjType(), _base_type(base_type) {}
+    constexpr
+    MjTypeAlias(MjType *base_type, Slice<const MjToken> tokens = nullptr) noexcept :
+        MjType(MjItemKind::TYPE_ALIAS, tokens),
+        _base_type(base_type)
+    {}
+
+
+    ///
+    /// Shared Properties
+    ///
+
+
+    static
+    constexpr
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::TYPE_ALIAS;
+    }
 
 
     ///
@@ -22,6 +42,13 @@ public:
     ///
 
 
+    /// Return true if the alias refers to a type, which is false until an unresolved name is resolved.
+    constexpr
+    bool is_resolved() const noexcept {
+        return _base_type != nullptr;
+    }
+
+
     constexpr
     const MjType *base_type() const noexcept {
         return _base_type;
@@ -39,4 +66,7 @@ public:
     ///
 
 
+    void set_base_type(MjType *base_type) noexcept {
+        _base_type = base_type;
+    }
 };
@@ -1,39 +1,69 @@
 #pragma once
 
-#include <mj/ast/MjType.hpp>
+#include <mj/ast/MjItem.hpp>
 
 
-class MjTypeName {
+/// The name of a named type, stored among the children of the type.
+class MjTypeName : public MjItem {
 private:
-    u32 _id;
+    MjToken _token;
+    StringView _text;
 public:
 
 
+    static
     constexpr
-    MjTypeName(StringView text) noexcept {}
+    MjItemKind item_kind() noexcept {
+        return MjItemKind::TYPE_NAME;
+    }
+
+
+    ///
+    /// Constructors
+    ///
 
 
+    /// The text must outlive the name, such as the text of a string token of the source file.
     constexpr
-    StringView text() const noexcept {
-        return MjTypeName::names[_id];
+    MjTypeName(MjToken token, StringView text) noexcept :
+        MjItem(item_kind()),
+        _token(token),
+        _text(text)
+    {}
+
+
+    ///
+    /// Shared Properties
+    ///
+
+
+    static
+    constexpr
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::TYPE_NAME;
     }
-};
 
 
-///
-/// Relational Operators
-///
+    ///
+    /// Properties
+    ///
 
 
-/// @brief Return true if the contents of the slices are equal.
-constexpr
-bool operator==(MjTypeName lhs, MjTypeName rhs) noexcept {
-    return lhs.is_equal(rhs);
-}
+    /// The name token in the source of the type.
+    constexpr
+    MjToken token() const noexcept {
+        return _token;
+    }
+
+
+    constexpr
+    StringView text() const noexcept {
+        return _text;
+    }
 
 
-/// @brief Return true if the contents of the slices are not equal.
-constexpr
-bool operator!=(MjTypeName lhs, MjTypeName rhs) noexcept {
-    return !(lhs == rhs);
-}
+    constexpr
+    bool is_equal(const MjTypeName &other) const noexcept {
+        return _text.is_equal(other._text);
+    }
+};
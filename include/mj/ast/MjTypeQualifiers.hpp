@@ -9,6 +9,7 @@ struct MjTypeQualifiersValues {
     static constexpr MjTypeQualifiers CONST{1};
     static constexpr MjTypeQualifiers MUTABLE{2};
     static constexpr MjTypeQualifiers SAFE{3};
+    static constexpr MjTypeQualifiers VOLATILE{4};
 };
 
 
@@ -1,12 +1,12 @@
 #pragma once
 
-#include <mj/ast/MjVariable.hpp>
+#include <mj/ast/MjType.hpp>
 
 
+/// A union type, whose members share the storage of the largest member.
+///
+/// The name, members, functions and nested types are children of the type.
 class MjUnionType : public MjType {
-private:
-    Vector<MjVariable *> _members;
-    MjToken _name;
 public:
 
 
@@ -16,36 +16,17 @@ public:
 
 
     constexpr
-    MjUnionType(MjToken name, Slice<const MjToken> tokens = nullptr) noexcept :
-        MjType(tokens), _name(name)
-    {}
+    MjUnionType(Slice<const MjToken> tokens = nullptr) noexcept : MjType(MjItemKind::UNION_TYPE, tokens) {}
 
 
     ///
-    /// Properties
+    /// Shared Properties
     ///
 
 
+    static
     constexpr
-    u32 alignment() const noexcept {
-        return 0;
-    }
-
-
-    constexpr
-    u32 size() const noexcept {
-        return 0;
-    }
-
-
-    constexpr
-    const Vector<MjVariable *> &members() const noexcept {
-        return _members;
-    }
-
-
-    constexpr
-    Vector<MjVariable *> &members() noexcept {
-        return _members;
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::UNION_TYPE;
     }
 };
@@ -3,6 +3,9 @@
 #include <mj/ast/MjType.hpp>
 
 
+class MjExpression;
+
+
 /// lifetime
 template<class MjStorageClass>
 struct MjStorageLifetimeValues {
@@ -48,6 +51,8 @@ class MjVariable : public MjItem {
 private:
     MjToken _name;
     MjType *_type;        // The type that owns the member
+    MjComment *_comment;
+    MjExpression *_value; // The initial value of the variable, if any
     bool _is_mutable;     // The property does not inherit the 'const'-ness of its owner (does not apply to references)
 public:
 
@@ -58,12 +63,32 @@ public:
         MjType *type,
         Slice<const MjToken> tokens = nullptr
     ) noexcept :
-        MjItem(MjItemKind::VARIABLE, tokens),
+        MjVariable(name, type, MjItemKind::VARIABLE, tokens)
+    {}
+
+
+protected:
+
+
+    constexpr
+    MjVariable(
+        MjToken name,
+        MjType *type,
+        MjItemKind item_kind,
+        Slice<const MjToken> tokens = nullptr
+    ) noexcept :
+        MjItem(item_kind, tokens),
         _name(name),
-        _type(type)
+        _type(type),
+        _comment(nullptr),
+        _value(nullptr),
+        _is_mutable(false)
     {}
 
 
+public:
+
+
     ///
     /// Properties
     ///
@@ -78,67 +103,65 @@ public:
 
     constexpr
     bool is_deterministic() const noexcept {
-        return !type()->is_volatile();
+        return !_type->is_volatile_qualified();
     }
 
 
     constexpr
     bool has_comment() const {
-        return;
+        return _comment != nullptr;
     }
 
 
     /// The comment associated with the variable
     constexpr
     const MjComment *comment() const noexcept {
-        return;
+        return _comment;
     }
 
 
     /// The comment associated with the variable
     constexpr
     MjComment *comment() noexcept {
-        return;
+        return _comment;
     }
 
 
     /// The variable name
     constexpr
     const MjToken *name() const noexcept {
-        return;
+        return &_name;
     }
 
 
     constexpr
     const MjType *type() const noexcept {
-        return;
+        return _type;
     }
 
 
     constexpr
     MjType *type() noexcept {
-        return;
+        return _type;
     }
 
 
-    /// The absolute address of the variable storage
     constexpr
-    u64 address() const noexcept {
-        return;
+    bool has_value() const noexcept {
+        return _value != nullptr;
     }
 
 
-    /// The absolute address of the variable storage
+    /// The expression initializing the variable, such as `1` in `u32 a = 1`.
     constexpr
-    u64 offset() const noexcept {
-        return;
+    MjExpression *value() const noexcept {
+        return _value;
     }
 
 
-    /// The absolute address of the variable storage
-    constexpr
+    /// The size of the variable storage in bytes. It includes padding once the layout of its type is computed.
     u64 size() const noexcept {
-        return;
+        return _type->size();
     }
 
 
@@ -146,4 +169,13 @@ public:
     /// Methods
     ///
 
+
+    void set_comment(MjComment *comment) noexcept {
+        _comment = comment;
+    }
+
+
+    void set_value(MjExpression *value) noexcept {
+        _value = value;
+    }
 };
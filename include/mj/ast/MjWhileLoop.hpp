@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mj/ast/MjBlockStatement.hpp>
+#include <mj/ast/MjExpression.hpp>
 
 
 class MjWhileLoop : public MjStatement {
@@ -16,7 +17,11 @@ public:
 
 
     constexpr
-    MjWhileLoop(Slice<const MjToken> tokens = nullptr) noexcept : MjStatement(tokens) {}
+    MjWhileLoop(Slice<const MjToken> tokens = nullptr) noexcept :
+        MjStatement(MjItemKind::WHILE_LOOP, tokens),
+        _condition(nullptr),
+        _block(nullptr)
+    {}
 
 
     constexpr
@@ -25,12 +30,24 @@ public:
         MjBlockStatement *block,
         Slice<const MjToken> tokens = nullptr
     ) noexcept :
-        MjStatement(tokens),
+        MjStatement(MjItemKind::WHILE_LOOP, tokens),
         _condition(condition),
         _block(block)
     {}
 
 
+    ///
+    /// Shared Properties
+    ///
+
+
+    static
+    constexpr
+    bool is_type_of(const MjItem *item) {
+        return item->item_kind() == MjItemKind::WHILE_LOOP;
+    }
+
+
     ///
     /// Properties
     ///
@@ -38,10 +55,6 @@ public:
 
     constexpr
     bool is_deterministic() const noexcept final {
-        if (false) {
-            return _is_deterministic;
-        }
-
         return (
             (_condition == nullptr || _condition->is_deterministic()) &&
             (_block == nullptr || _block->is_deterministic())
@@ -74,13 +87,13 @@ public:
 
 
     constexpr
-    const MjStatement *block() const noexcept {
+    const MjBlockStatement *block() const noexcept {
         return _block;
     }
 
 
     constexpr
-    MjStatement *block() noexcept {
+    MjBlockStatement *block() noexcept {
         return _block;
     }
 
@@ -96,6 +109,6 @@ public:
 
 
     void set_block(MjBlockStatement *block_statement) {
-        block = block_statement;
+        _block = block_statement;
     }
 };
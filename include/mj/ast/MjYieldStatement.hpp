@@ -1,6 +1,6 @@
 #pragma once
 
-#include <mj/ast/MjStatement.hpp>
+#include <mj/ast/MjExpression.hpp>
 
 
 // A statement is a structured unit of execution.
@@ -16,17 +16,12 @@ public:
 
 
     constexpr
-    MjYieldStatement(Slice<const MjToken> tokens = nullptr) noexcept : MjStatement(tokens) {}
-
-
-    constexpr
-    MjYieldStatement(MjExpression *result, Slice<const MjToken> tokens = nullptr) noexcept :
-        MjStatement(tokens),
+    MjYieldStatement(MjExpression *result = nullptr, Slice<const MjToken> tokens = nullptr) noexcept :
+        MjStatement(MjItemKind::YIELD_STATEMENT, tokens),
         _result(result)
     {}
 
 
-
     ///
     /// Properties
     ///
@@ -34,10 +29,6 @@ public:
 
     constexpr
     bool is_deterministic() const noexcept final {
-        if (false) {
-            return _is_deterministic;
-        }
-
         return _result == nullptr || _result->is_deterministic();
     }
 
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <ir/IrRegisterAllocator.hpp>
+#include <x64/X64Encoder.hpp>
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+/// Emits x86-64 machine code for a function in SSA form, following the System V calling
+/// convention.
+///
+/// Values get registers by linear scan. `rax`, `rcx`, `rdx` and `r11` are never assigned, as
+/// they hold the operands of division, shifts and moves. The frame keeps the callee saved
+/// registers in use and the spilled values below the saved `rbp`.
+///
+/// The moves into phi instructions are resolved on the edges into their block as parallel moves,
+/// breaking cycles through `rax`. A comparison used only by the branch ending its block becomes a
+/// compare and jump, and constants which fit in 32 bits are immediates of arithmetic and
+/// comparisons.
+class X64Emitter {
+private:
+
+    struct Fixup {
+        u32 displacement_offset;
+        u32 label;               // A block, or an edge block after the blocks
+    };
+
+
+    struct Edge {
+        u32 block;
+        u32 successor;
+    };
+
+
+    using Move = std::pair<X64Operand, X64Operand>; // The destination and the source
+
+
+    const IrFunction &_function;
+    const std::unordered_map<u32, u32> &_symbols;
+    X64Encoder &_encoder;
+    IrRegisterAllocator _allocator;
+    std::vector<u32> _use_counts;
+    std::vector<u32> _labels;
+    std::vector<Fixup> _fixups;
+    std::vector<Edge> _edges;
+    std::vector<X64Register> _saved_registers;
+    u32 _next_block = NONE;
+    Error _error = Error::SUCCESS;
+public:
+
+
+    static constexpr u32 NONE = 0xFFFFFFFFu;
+
+
+    static constexpr X64Register CALLER_SAVED_REGISTERS[] = {X64Register::RSI, X64Register::RDI, X64Register::R8, X64Register::R9, X64Register::R10};
+    static constexpr X64Register CALLEE_SAVED_REGISTERS[] = {X64Register::RBX, X64Register::R12, X64Register::R13, X64Register::R14, X64Register::R15};
+    static constexpr X64Register ARGUMENT_REGISTERS[] = {X64Register::RDI, X64Register::RSI, X64Register::RDX, X64Register::RCX, X64Register::R8, X64Register::R9};
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    /// Create an emitter. Calls resolve the ID of their function to a symbol in `symbols`.
+    X64Emitter(const IrFunction &function, const std::unordered_map<u32, u32> &symbols, X64Encoder &encoder) noexcept :
+        _function(function),
+        _symbols(symbols),
+        _encoder(encoder),
+        _allocator(function, std::size(CALLER_SAVED_REGISTERS), std::size(CALLEE_SAVED_REGISTERS))
+    {}
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// Append the function to the code of the encoder.
+    Error emit() noexcept;
+
+
+private:
+
+
+    /// Count the uses of every value, except as immediates.
+    void count_uses() noexcept;
+
+
+    /// Return true if the value is a constant which fits in a 32-bit immediate.
+    bool is_immediate(u32 value) const noexcept;
+
+
+    /// Return true if the value is a comparison fused into the branch ending its block.
+    bool is_fused_comparison(u32 value) const noexcept;
+
+
+    X64Operand operand(u32 value) const noexcept;
+
+
+    void emit_block(u32 block) noexcept;
+
+
+    void emit_instruction(u32 value) noexcept;
+
+
+    void emit_terminator(u32 block) noexcept;
+
+
+    /// Compare two values, the second of which may be an immediate.
+    void emit_comparison(u32 lhs, u32 rhs) noexcept;
+
+
+    void emit_edge_moves(u32 block, u32 successor) noexcept;
+
+
+    /// Return the label of an edge: the successor, or an edge block if the edge has moves.
+    u32 edge_label(u32 block, u32 successor) noexcept;
+
+
+    void emit_jump(u32 label) noexcept;
+
+
+    void emit_jump(X64Condition condition, u32 label) noexcept;
+
+
+    void emit_move(X64Operand destination, X64Operand source) noexcept;
+
+
+    /// Perform moves as if they happened at once.
+    void emit_parallel_moves(std::vector<Move> &moves) noexcept;
+
+
+    void error(const char *message) noexcept;
+};
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <core/Common.hpp>
+#include <core/Enum.hpp>
+#include <core/Slice.hpp>
+
+#include <initializer_list>
+#include <vector>
+
+
+template<class X64Register>
+struct X64RegisterValues {
+    static constexpr X64Register RAX{0};
+    static constexpr X64Register RCX{1};
+    static constexpr X64Register RDX{2};
+    static constexpr X64Register RBX{3};
+    static constexpr X64Register RSP{4};
+    static constexpr X64Register RBP{5};
+    static constexpr X64Register RSI{6};
+    static constexpr X64Register RDI{7};
+    static constexpr X64Register R8{8};
+    static constexpr X64Register R9{9};
+    static constexpr X64Register R10{10};
+    static constexpr X64Register R11{11};
+    static constexpr X64Register R12{12};
+    static constexpr X64Register R13{13};
+    static constexpr X64Register R14{14};
+    static constexpr X64Register R15{15};
+};
+
+
+struct X64Register : public Enum<u8>, public X64RegisterValues<X64Register> {
+
+    constexpr
+    explicit
+    X64Register(u8 id) noexcept : Enum(id) {}
+
+
+    /// The low three bits of the register number, encoded in the instruction.
+    constexpr
+    u8 low_bits() const noexcept {
+        return _id & 7;
+    }
+
+
+    /// Return true if the register needs a REX prefix bit.
+    constexpr
+    bool is_extended() const noexcept {
+        return _id >= 8;
+    }
+};
+
+
+/// The condition codes of conditional jumps and `setcc`, in encoding order.
+template<class X64Condition>
+struct X64ConditionValues {
+    static constexpr X64Condition O{0x0};
+    static constexpr X64Condition NO{0x1};
+    static constexpr X64Condition B{0x2};
+    static constexpr X64Condition AE{0x3};
+    static constexpr X64Condition E{0x4};
+    static constexpr X64Condition NE{0x5};
+    static constexpr X64Condition BE{0x6};
+    static constexpr X64Condition A{0x7};
+    static constexpr X64Condition S{0x8};
+    static constexpr X64Condition NS{0x9};
+    static constexpr X64Condition P{0xA};
+    static constexpr X64Condition NP{0xB};
+    static constexpr X64Condition L{0xC};
+    static constexpr X64Condition GE{0xD};
+    static constexpr X64Condition LE{0xE};
+    static constexpr X64Condition G{0xF};
+};
+
+
+struct X64Condition : public Enum<u8>, public X64ConditionValues<X64Condition> {
+
+    constexpr
+    explicit
+    X64Condition(u8 id) noexcept : Enum(id) {}
+
+
+    /// The condition which holds when this one does not.
+    constexpr
+    X64Condition inverse() const noexcept {
+        return X64Condition(_id ^ 1);
+    }
+};
+
+
+/// The arithmetic operations sharing the encodings of `add`.
+template<class X64AluOperation>
+struct X64AluOperationValues {
+    static constexpr X64AluOperation ADD{0};
+    static constexpr X64AluOperation OR{1};
+    static constexpr X64AluOperation AND{2};
+    static constexpr X64AluOperation SUB{3};
+    static constexpr X64AluOperation XOR{4};
+    static constexpr X64AluOperation CMP{5};
+};
+
+
+struct X64AluOperation : public Enum<u8>, public X64AluOperationValues<X64AluOperation> {
+
+    constexpr
+    explicit
+    X64AluOperation(u8 id) noexcept : Enum(id) {}
+};
+
+
+/// A register, or a memory operand addressed by a base register and a displacement.
+struct X64Operand {
+    X64Register base;
+    bool is_memory;
+    i32 displacement;
+
+
+    constexpr
+    X64Operand(X64Register base) noexcept : base(base), is_memory(false), displacement(0) {}
+
+
+    constexpr
+    X64Operand(X64Register base, i32 displacement) noexcept : base(base), is_memory(true), displacement(displacement) {}
+
+
+    constexpr
+    bool operator==(const X64Operand &other) const noexcept {
+        return base == other.base && is_memory == other.is_memory && displacement == other.displacement;
+    }
+};
+
+
+/// A reference from the code to a symbol, resolved by the linker.
+struct X64Relocation {
+    u32 offset;  // The offset of the 32-bit field in the code
+    u32 symbol;
+    i32 addend;
+};
+
+
+/// Encodes x86-64 instructions with 64-bit operands into a code buffer.
+///
+/// The arithmetic operations and the condition codes are encoded from tables. Jumps take 32-bit
+/// displacements, patched once their target is known.
+class X64Encoder {
+private:
+    std::vector<u8> _code;
+    std::vector<X64Relocation> _relocations;
+public:
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    X64Encoder() noexcept {}
+
+
+    ///
+    /// Properties
+    ///
+
+
+    u32 size() const noexcept {
+        return _code.size();
+    }
+
+
+    Slice<const u8> code() const noexcept {
+        return {_code.data(), u32(_code.size())};
+    }
+
+
+    Slice<const X64Relocation> relocations() const noexcept {
+        return {_relocations.data(), u32(_relocations.size())};
+    }
+
+
+    ///
+    /// Methods
+    ///
+
+
+    /// `mov destination, source`
+    void mov(X64Register destination, X64Operand source) noexcept;
+
+
+    /// `mov destination, source`
+    void mov(X64Operand destination, X64Register source) noexcept;
+
+
+    /// `mov destination, immediate`, in the shortest encoding.
+    void mov_immediate(X64Register destination, i64 immediate) noexcept;
+
+
+    /// `mov destination, immediate`, sign extending the immediate.
+    void mov_sign_extended(X64Operand destination, i32 immediate) noexcept;
+
+
+    /// `op destination, source`
+    void alu(X64AluOperation operation, X64Register destination, X64Operand source) noexcept;
+
+
+    /// `op destination, immediate`
+    void alu(X64AluOperation operation, X64Operand destination, i32 immediate) noexcept;
+
+
+    /// `imul destination, source`
+    void imul(X64Register destination, X64Operand source) noexcept;
+
+
+    /// `idiv source`, dividing `rdx:rax`
+    void idiv(X64Operand source) noexcept;
+
+
+    void neg(X64Operand operand) noexcept;
+
+
+    void not_(X64Operand operand) noexcept;
+
+
+    /// `shl operand, cl`
+    void shl(X64Operand operand) noexcept;
+
+
+    /// `sar operand, cl`
+    void sar(X64Operand operand) noexcept;
+
+
+    /// Sign extend `rax` into `rdx`.
+    void cqo() noexcept;
+
+
+    /// Set `rax` to 1 if the condition holds, else 0.
+    void set(X64Condition condition) noexcept;
+
+
+    void push(X64Register operand) noexcept;
+
+
+    void pop(X64Register operand) noexcept;
+
+
+    /// Emit a jump and return the offset of its displacement.
+    u32 jmp() noexcept;
+
+
+    /// Emit a conditional jump and return the offset of its displacement.
+    u32 jcc(X64Condition condition) noexcept;
+
+
+    /// Call a symbol through a relocation.
+    void call(u32 symbol) noexcept;
+
+
+    void ret() noexcept;
+
+
+    void ud2() noexcept;
+
+
+    /// Point the displacement of a jump to an offset in the code.
+    void patch(u32 displacement_offset, u32 target) noexcept;
+
+
+private:
+
+
+    /// Emit a REX prefix if needed, the opcode, and the ModRM byte addressing `operand` with `reg` as the register field.
+    void emit_rm(std::initializer_list<u8> opcode, u8 reg, X64Operand operand, bool is_wide = true) noexcept;
+
+
+    void emit32(u32 value) noexcept;
+};
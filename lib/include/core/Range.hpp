@@ -22,7 +22,7 @@ public:
 
     constexpr
     explicit
-    RangeIterator(int value, int step, bool inclusive) noexcept : _value(value), _step(step) {}
+    RangeIterator(T value, u32 step) noexcept : _value(value), _step(step) {}
 
 
     ///
@@ -38,7 +38,7 @@ public:
 
     constexpr
     value_type operator[](difference_type n) const noexcept {
-        return *(this + n);
+        return T(_value + n * _step);
     }
 
 
@@ -143,7 +143,7 @@ public:
 
 
     constexpr
-    T end() const noexcept {
+    T stop() const noexcept {
         return _end;
     }
 
@@ -166,13 +166,13 @@ public:
 
 
     constexpr
-    RangeIterator begin() const noexcept {
-        return RangeIterator(_start, _step);
+    RangeIterator<T> begin() const noexcept {
+        return RangeIterator<T>(_start, _step);
     }
 
 
     constexpr
-    RangeIterator end() const noexcept {
-        return RangeIterator(_end, _step);
+    RangeIterator<T> end() const noexcept {
+        return RangeIterator<T>(_end, _step);
     }
 };
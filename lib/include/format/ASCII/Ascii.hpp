@@ -17,28 +17,28 @@ namespace Ascii {
     /// @brief Return true if the character is a digit.
     constexpr
     bool is_digit(u8 ch, u8 base = 10) noexcept {
-        return ch - '0' < base;
+        return u32(ch - '0') < (base < 10 ? base : 10);
     }
 
 
     /// @brief Return true if the given character is a digit using the given numeric base.
     constexpr
     bool is_alnum_digit(u8 ch, u32 base) noexcept {
-        return is_digit(ch, base) || u32(ch | 0x20u) - u32('a' + 10) < base;
+        return is_digit(ch, base) || (base > 10 && u32((ch | 0x20u) - 'a') < base - 10);
     }
 
 
     /// @brief Return true if the given character is a digit using the given numeric base.
     constexpr
     bool is_uppercase_alnum_digit(u8 ch, u32 base) noexcept {
-        return is_digit(ch, base) || ch - u32('A' + 10) < base;
+        return is_digit(ch, base) || (base > 10 && u32(ch - 'A') < base - 10);
     }
 
 
     /// @brief Return true if the given character is a digit using the given numeric base.
     constexpr
     bool is_lowercase_alnum_digit(u8 ch, u32 base) noexcept {
-        return is_digit(ch, base) || ch - u32('a' + 10) < base;
+        return is_digit(ch, base) || (base > 10 && u32(ch - 'a') < base - 10);
     }
 
 
@@ -87,21 +87,21 @@ namespace Ascii {
     /// @brief Return true if the character is .
     constexpr
     bool is_upper(u8 ch) noexcept {
-        return ch - 'A' < 26;
+        return u32(ch - 'A') < 26;
     }
 
 
     /// @brief Return true if the character is .
     constexpr
     bool is_lower(u8 ch) noexcept {
-        return ch - 'a' < 26;
+        return u32(ch - 'a') < 26;
     }
 
 
     /// @brief Return true if the character is .
     constexpr
     bool is_letter(u8 ch) noexcept {
-        return (ch | 0x20u) < 26;
+        return (ch | 0x20u) - 'a' < 26;
     }
 
 
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <core/Common.hpp>
+
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+/// @brief Vectorized character class scanning over null-terminated, padded buffers.
+///
+/// Every scan advances past the longest run of characters in the requested classes and returns a
+/// pointer to the first character outside of them. The null character is never a member of any
+/// class, so a scan always stops at the sentinel of the buffer. Because whole vectors are loaded,
+/// the buffer must be readable for `SCAN_PADDING` bytes past the sentinel.
+namespace Ascii {
+
+
+    /// @brief The character classes which may be combined for a scan.
+    namespace ScanClass {
+        static constexpr u8 LOWER      = 1u << 0; // `[a-z]`
+        static constexpr u8 UPPER      = 1u << 1; // `[A-Z]`
+        static constexpr u8 DIGIT      = 1u << 2; // `[0-9]`
+        static constexpr u8 UNDERSCORE = 1u << 3; // `_`
+        static constexpr u8 SPACE      = 1u << 4; // ` `
+    }
+
+
+#if defined(__AVX2__)
+    static constexpr u32 SCAN_WIDTH = 32;
+#elif defined(__SSE2__)
+    static constexpr u32 SCAN_WIDTH = 16;
+#else
+    static constexpr u32 SCAN_WIDTH = 1;
+#endif
+
+
+    /// @brief The number of readable bytes required after the null sentinel of a scanned buffer.
+    static constexpr u32 SCAN_PADDING = SCAN_WIDTH;
+
+
+    namespace internal {
+
+
+        /// The class table used by the scalar fallback.
+        static constexpr
+        struct ScanTable {
+            u8 classes[256] = {};
+
+            constexpr
+            ScanTable() noexcept {
+                for (u32 ch = 'a'; ch <= 'z'; ++ch) {
+                    classes[ch] |= ScanClass::LOWER;
+                }
+
+                for (u32 ch = 'A'; ch <= 'Z'; ++ch) {
+                    classes[ch] |= ScanClass::UPPER;
+                }
+
+                for (u32 ch = '0'; ch <= '9'; ++ch) {
+                    classes[ch] |= ScanClass::DIGIT;
+                }
+
+                classes[u32('_')] |= ScanClass::UNDERSCORE;
+                classes[u32(' ')] |= ScanClass::SPACE;
+            }
+        } SCAN_TABLE{};
+
+
+#if defined(__AVX2__)
+
+        /// Return the lanes of the chunk in the range [first, first + count).
+        ///
+        /// The range is biased to the bottom of the signed range so that a single signed compare
+        /// tests both bounds.
+        inline
+        __m256i in_range(__m256i chunk, u8 first, u8 count) noexcept {
+            __m256i biased = _mm256_sub_epi8(chunk, _mm256_set1_epi8(i8(first + 0x80u)));
+            return _mm256_cmpgt_epi8(_mm256_set1_epi8(i8(count + 0x80u)), biased);
+        }
+
+
+        template<u8 CLASSES>
+        inline
+        u32 scan_mask(const u8 *ch) noexcept {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ch));
+            __m256i mask = _mm256_setzero_si256();
+
+            if constexpr (CLASSES & ScanClass::LOWER) {
+                mask = _mm256_or_si256(mask, in_range(chunk, 'a', 26));
+            }
+
+            if constexpr (CLASSES & ScanClass::UPPER) {
+                mask = _mm256_or_si256(mask, in_range(chunk, 'A', 26));
+            }
+
+            if constexpr (CLASSES & ScanClass::DIGIT) {
+                mask = _mm256_or_si256(mask, in_range(chunk, '0', 10));
+            }
+
+            if constexpr (CLASSES & ScanClass::UNDERSCORE) {
+                mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('_')));
+            }
+
+            if constexpr (CLASSES & ScanClass::SPACE) {
+                mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')));
+            }
+
+            // Set a bit for each lane that is not a member of the classes.
+            return ~u32(_mm256_movemask_epi8(mask));
+        }
+
+#elif defined(__SSE2__)
+
+        /// Return the lanes of the chunk in the range [first, first + count).
+        ///
+        /// The range is biased to the bottom of the signed range so that a single signed compare
+        /// tests both bounds.
+        inline
+        __m128i in_range(__m128i chunk, u8 first, u8 count) noexcept {
+            __m128i biased = _mm_sub_epi8(chunk, _mm_set1_epi8(i8(first + 0x80u)));
+            return _mm_cmplt_epi8(biased, _mm_set1_epi8(i8(count + 0x80u)));
+        }
+
+
+        template<u8 CLASSES>
+        inline
+        u32 scan_mask(const u8 *ch) noexcept {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ch));
+            __m128i mask = _mm_setzero_si128();
+
+            if constexpr (CLASSES & ScanClass::LOWER) {
+                mask = _mm_or_si128(mask, in_range(chunk, 'a', 26));
+            }
+
+            if constexpr (CLASSES & ScanClass::UPPER) {
+                mask = _mm_or_si128(mask, in_range(chunk, 'A', 26));
+            }
+
+            if constexpr (CLASSES & ScanClass::DIGIT) {
+                mask = _mm_or_si128(mask, in_range(chunk, '0', 10));
+            }
+
+            if constexpr (CLASSES & ScanClass::UNDERSCORE) {
+                mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('_')));
+            }
+
+            if constexpr (CLASSES & ScanClass::SPACE) {
+                mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')));
+            }
+
+            // Set a bit for each lane that is not a member of the classes.
+            return ~u32(_mm_movemask_epi8(mask)) & 0xFFFFu;
+        }
+
+#endif
+    }
+
+
+    /// @brief Return a pointer to the first character at or after `ch` which is not a member of
+    /// any of the given classes.
+    template<u8 CLASSES>
+    inline
+    const u8 *scan(const u8 *ch) noexcept {
+#if defined(__AVX2__) || defined(__SSE2__)
+
+        // The first character decides most short runs, so test it before loading a vector.
+        if (!(internal::SCAN_TABLE.classes[u32(*ch)] & CLASSES)) {
+            return ch;
+        }
+
+        while (true) {
+            u32 mask = internal::scan_mask<CLASSES>(ch);
+
+            if (mask != 0) {
+                return ch + std::countr_zero(mask);
+            }
+
+            ch += SCAN_WIDTH;
+        }
+#else
+        for (; internal::SCAN_TABLE.classes[u32(*ch)] & CLASSES; ++ch);
+        return ch;
+#endif
+    }
+
+
+    /// @brief Skip `[ ]*`.
+    inline
+    const u8 *scan_spaces(const u8 *ch) noexcept {
+        return scan<ScanClass::SPACE>(ch);
+    }
+
+
+    /// @brief Skip `[0-9]*`.
+    inline
+    const u8 *scan_decimal_digits(const u8 *ch) noexcept {
+        return scan<ScanClass::DIGIT>(ch);
+    }
+
+
+    /// @brief Skip `[a-z]*`.
+    inline
+    const u8 *scan_lower(const u8 *ch) noexcept {
+        return scan<ScanClass::LOWER>(ch);
+    }
+
+
+    /// @brief Skip `[a-z0-9]*`.
+    inline
+    const u8 *scan_lowercase_alnum(const u8 *ch) noexcept {
+        return scan<ScanClass::LOWER | ScanClass::DIGIT>(ch);
+    }
+
+
+    /// @brief Skip `[a-z0-9_]*`.
+    inline
+    const u8 *scan_lowercase_word(const u8 *ch) noexcept {
+        return scan<ScanClass::LOWER | ScanClass::DIGIT | ScanClass::UNDERSCORE>(ch);
+    }
+
+
+    /// @brief Skip `[A-Z0-9_]*`.
+    inline
+    const u8 *scan_uppercase_word(const u8 *ch) noexcept {
+        return scan<ScanClass::UPPER | ScanClass::DIGIT | ScanClass::UNDERSCORE>(ch);
+    }
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <core/String.hpp>
+#include <core/StringView.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+
+#include <sys/uio.h>
+
+
+/// @brief An output buffer collects generated text in large chunks and writes it to a file with
+/// few system calls.
+///
+/// Chunks are written together by one vectored write once they are all full, and when flushed.
+/// Output at an offset is written with `pwritev`, otherwise at the file position with `writev`.
+/// Indentation is copied from a precomputed string rather than written one level at a time.
+class OutputBuffer {
+public:
+    static constexpr u32 CHUNK_SIZE = 64 * 1024;
+    static constexpr u32 CHUNK_COUNT = 16; // The number of chunks written by one system call
+private:
+    i32 _fd;
+    i64 _offset;                        // The offset of the next write, or -1 for the file position
+    std::unique_ptr<u8[]> _chunks[CHUNK_COUNT];
+    u32 _chunk_index = 0;               // The chunk being filled
+    u32 _size = 0;                      // The size of the data in the chunk being filled
+    String _tab;
+    String _indentation;                // A newline followed by the tabs of the deepest level used
+    Error _error = Error::SUCCESS;
+public:
+
+
+    ///
+    /// Constructors
+    ///
+
+
+    OutputBuffer(
+        i32 fd,
+        StringView tab = "    ",
+        i64 offset = -1
+    ) noexcept :
+        _fd(fd),
+        _offset(offset),
+        _tab(reinterpret_cast<const char *>(tab.data()), tab.size()),
+        _indentation("\n")
+    {
+        _chunks[0] = std::make_unique<u8[]>(CHUNK_SIZE);
+    }
+
+
+    OutputBuffer(const OutputBuffer &) = delete;
+
+
+    /// The output must be flushed first, so that write errors are not lost.
+    ~OutputBuffer() {
+        assert(_chunk_index + _size == 0 && "Output buffer destroyed before it was flushed!");
+    }
+
+
+    ///
+    /// Properties
+    ///
+
+
+    /// @brief Return the error of the first failed write, if any.
+    Error error() const noexcept {
+        return _error;
+    }
+
+
+    ///
+    /// Methods
+    ///
+
+
+    void write(const u8 *data, u32 size) noexcept {
+        // Most writes fit in the current chunk.
+        if (CHUNK_SIZE - _size >= size) {
+            std::memcpy(_chunks[_chunk_index].get() + _size, data, size);
+            _size += size;
+            return;
+        }
+
+        write_chunks(data, size);
+    }
+
+
+    void write(StringView string) noexcept {
+        write(string.data(), string.size());
+    }
+
+
+    void write(const char *string) noexcept {
+        write(reinterpret_cast<const u8 *>(string), std::strlen(string));
+    }
+
+
+    void write(u8 ch) noexcept {
+        write(&ch, 1);
+    }
+
+
+    /// @brief Write line breaks followed by the indentation of a depth.
+    /// @param count The number of line breaks
+    /// @param depth The number of tabs
+    void newline(u32 count, u32 depth) noexcept {
+        u32 size = 1 + depth * _tab.size();
+
+        for (u32 i = 1; i < count; i++) {
+            write('\n');
+        }
+
+        if (_indentation.size() < size) {
+            extend_indentation(depth);
+        }
+
+        write(reinterpret_cast<const u8 *>(_indentation.data()), size);
+    }
+
+
+    /// @brief Write all pending data.
+    /// @return The error of the first failed write, if any
+    Error flush() noexcept;
+
+
+private:
+
+
+    /// Write data across chunks, flushing them when they are all full.
+    void write_chunks(const u8 *data, u32 size) noexcept;
+
+
+    /// Write every buffer, continuing after partial writes. The buffers are advanced past the data
+    /// written.
+    Error write_buffers(iovec *buffers, u32 count) noexcept;
+
+
+    void extend_indentation(u32 depth) noexcept;
+};
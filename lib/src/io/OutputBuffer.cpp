@@ -0,0 +1,99 @@
+#include <io/OutputBuffer.hpp>
+
+#include <algorithm>
+#include <cerrno>
+
+#include <sys/uio.h>
+
+
+Error OutputBuffer::flush() noexcept {
+    iovec buffers[CHUNK_COUNT];
+    u32 count = _chunk_index + 1;
+
+    if (_chunk_index + _size == 0) {
+        return _error;
+    }
+
+    for (u32 i = 0; i < _chunk_index; i++) {
+        buffers[i] = {_chunks[i].get(), CHUNK_SIZE};
+    }
+
+    buffers[_chunk_index] = {_chunks[_chunk_index].get(), _size};
+
+    // The chunks are kept for the following output.
+    if (_error == Error::SUCCESS) {
+        _error = write_buffers(buffers, count);
+    }
+
+    _chunk_index = 0;
+    _size = 0;
+    return _error;
+}
+
+
+Error OutputBuffer::write_buffers(iovec *buffers, u32 count) noexcept {
+    while (count) {
+        // Output at an offset is advanced only by the data written.
+        ssize_t size = _offset < 0 ? ::writev(_fd, buffers, count) : ::pwritev(_fd, buffers, count, _offset);
+
+        if (size < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return Error::FAILURE;
+        }
+
+        if (_offset >= 0) {
+            _offset += size;
+        }
+
+        // Continue after a partial write.
+        while (count && size_t(size) >= buffers->iov_len) {
+            size -= buffers->iov_len;
+            buffers += 1;
+            count -= 1;
+        }
+
+        if (count) {
+            buffers->iov_base = static_cast<u8 *>(buffers->iov_base) + size;
+            buffers->iov_len -= size;
+        }
+    }
+
+    return Error::SUCCESS;
+}
+
+
+void OutputBuffer::write_chunks(const u8 *data, u32 size) noexcept {
+    while (size) {
+        if (_size == CHUNK_SIZE) {
+            if (_chunk_index + 1 == CHUNK_COUNT) {
+                flush();
+            } else {
+                _chunk_index += 1;
+                _size = 0;
+
+                if (!_chunks[_chunk_index]) {
+                    _chunks[_chunk_index] = std::make_unique<u8[]>(CHUNK_SIZE);
+                }
+            }
+        }
+
+        u32 part = std::min(size, CHUNK_SIZE - _size);
+        std::memcpy(_chunks[_chunk_index].get() + _size, data, part);
+        _size += part;
+        data += part;
+        size -= part;
+    }
+}
+
+
+void OutputBuffer::extend_indentation(u32 depth) noexcept {
+    // Extend by several levels at once, so that deeper nesting rarely extends it again.
+    u32 level_count = (_indentation.size() - 1) / std::max<u32>(_tab.size(), 1);
+
+    for (u32 level = level_count; level < depth + 8; level++) {
+        _indentation += _tab;
+    }
+}
@@ -0,0 +1,49 @@
+#include <c/ast/COperator.hpp>
+
+
+const COperator COperator::INC{"++", 1, 1, false};
+const COperator COperator::DEC{"--", 1, 1, false};
+const COperator COperator::CALL{"()", 1, 2, false};
+const COperator COperator::SUBSCRIPT{"[]", 1, 2, false};
+const COperator COperator::DOT{".", 1, 2, false};
+const COperator COperator::PTR{"->", 1, 2, false};
+const COperator COperator::PRE_INC{"++", 2, 1, true};
+const COperator COperator::PRE_DEC{"--", 2, 1, true};
+const COperator COperator::INV{"~", 2, 1, true};
+const COperator COperator::NOT{"!", 2, 1, true};
+const COperator COperator::POS{"+", 2, 1, true};
+const COperator COperator::NEG{"-", 2, 1, true};
+const COperator COperator::REF{"&", 2, 1, true};
+const COperator COperator::DEREF{"*", 2, 1, true};
+const COperator COperator::CAST{"()", 2, 1, true};
+const COperator COperator::MUL{"*", 3, 2, false};
+const COperator COperator::DIV{"/", 3, 2, false};
+const COperator COperator::MOD{"%", 3, 2, false};
+const COperator COperator::ADD{"+", 4, 2, false};
+const COperator COperator::SUB{"-", 4, 2, false};
+const COperator COperator::LSL{"<<", 5, 2, false};
+const COperator COperator::ASR{">>", 5, 2, false};
+const COperator COperator::LES{"<", 6, 2, false};
+const COperator COperator::GTR{">", 6, 2, false};
+const COperator COperator::LEQ{"<=", 6, 2, false};
+const COperator COperator::GEQ{">=", 6, 2, false};
+const COperator COperator::EQU{"==", 7, 2, false};
+const COperator COperator::NEQ{"!=", 7, 2, false};
+const COperator COperator::AND{"&", 8, 2, false};
+const COperator COperator::XOR{"^", 9, 2, false};
+const COperator COperator::OR{"|", 10, 2, false};
+const COperator COperator::LAND{"&&", 11, 2, false};
+const COperator COperator::LOR{"||", 12, 2, false};
+const COperator COperator::TERNARY{"?:", 13, 3, true};
+const COperator COperator::SET{"=", 14, 2, true};
+const COperator COperator::MUL_SET{"*=", 14, 2, true};
+const COperator COperator::DIV_SET{"/=", 14, 2, true};
+const COperator COperator::MOD_SET{"%=", 14, 2, true};
+const COperator COperator::ADD_SET{"+=", 14, 2, true};
+const COperator COperator::SUB_SET{"-=", 14, 2, true};
+const COperator COperator::LSL_SET{"<<=", 14, 2, true};
+const COperator COperator::ASR_SET{">>=", 14, 2, true};
+const COperator COperator::AND_SET{"&=", 14, 2, true};
+const COperator COperator::XOR_SET{"^=", 14, 2, true};
+const COperator COperator::OR_SET{"|=", 14, 2, true};
+const COperator COperator::COMMA{",", 15, 2, false};
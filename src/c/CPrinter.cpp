@@ -1,58 +1,621 @@
 #include <c/CPrinter.hpp>
 
+#include <algorithm>
+#include <charconv>
 
 
+/// Return true if an operator of the precedence level takes operands of other binary operators in
+/// parentheses, as suggested by `-Wparentheses`: shifts, bitwise operators and `||`.
+static bool is_parenthesizing(u32 precedence) noexcept {
+    return precedence == 5 || (precedence >= 8 && precedence <= 10) || precedence == 12;
+}
+
+
+static void append(String &string, StringView text) noexcept {
+    string.append(reinterpret_cast<const char *>(text.data()), text.size());
+}
+
+
+static void append_qualifiers(String &string, CTypeFlags flags) noexcept {
+    if (flags.is_const) {
+        string += string.empty() || string.back() == '*' ? "const" : " const";
+    }
+
+    if (flags.is_volatile) {
+        string += string.empty() || string.back() == '*' ? "volatile" : " volatile";
+    }
+
+    if (flags.is_restrict) {
+        string += string.empty() || string.back() == '*' ? "restrict" : " restrict";
+    }
+}
+
+
+void CPrinter::write(i64 value) {
+    char buffer[24];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    _out.write(reinterpret_cast<const u8 *>(buffer), result.ptr - buffer);
+}
+
+
+void CPrinter::print_declaration(const CType &type, StringView name) {
+    String declaration = declaration_of(type, name);
+    _out.write(reinterpret_cast<const u8 *>(declaration.data()), declaration.size());
+}
+
+
+String CPrinter::declaration_of(const CType &type, StringView name) {
+    String declarator;
+    const CType *base = &type;
+    bool is_pointer = false; // The declarator starts with a pointer
+    append(declarator, name);
+
+    // The declarator is built from the name outward: pointers are prefixes, and arrays and
+    // functions are suffixes which bind tighter than the pointers before them.
+    while (base->type().is_derived()) {
+        const CDerivedType &derived = static_cast<const CDerivedType &>(*base);
+
+        if (base->type() == CTypeKind::POINTER) {
+            String prefix = "*";
+            append_qualifiers(prefix, base->flags());
+
+            if (prefix.size() > 1 && !declarator.empty()) {
+                prefix += ' ';
+            }
+
+            declarator = prefix + declarator;
+            is_pointer = true;
+        } else {
+            if (is_pointer) {
+                declarator = "(" + declarator + ")";
+            }
+
+            if (base->type() == CTypeKind::ARRAY) {
+                declarator += '[' + std::to_string(static_cast<const CArrayType &>(derived).array_size()) + ']';
+            } else {
+                const CFunctionType &function_type = static_cast<const CFunctionType &>(derived);
+                declarator += '(';
+
+                for (u32 i = 0; i < function_type.parameter_types().size(); ++i) {
+                    declarator += i > 0 ? ", " : "";
+                    declarator += declaration_of(*function_type.parameter_types()[i], "");
+                }
+
+                declarator += function_type.parameter_types().empty() ? "void)" : ")";
+            }
+
+            is_pointer = false;
+        }
+
+        base = &derived.base_type();
+    }
+
+    String declaration;
+    append_qualifiers(declaration, base->flags());
+    declaration += declaration.empty() ? "" : " ";
+    append(declaration, static_cast<const CBasicType *>(base)->name());
+
+    if (!declarator.empty()) {
+        declaration += ' ';
+        declaration += declarator;
+    }
+
+    return declaration;
+}
+
+
+void CPrinter::print(const CExpression &expression) {
+    print(expression, 15);
+}
+
+
+void CPrinter::print(const CExpression &expression, u32 precedence) {
+    if (expression.is_terminal()) {
+        write(expression.text());
+        return;
+    }
+
+    const COperator &op = expression.op();
+    const std::vector<CExpression> &terms = expression.terms();
+    bool is_parenthesized = op.precedence > precedence;
 
+    if (is_parenthesized) {
+        write("(");
+    }
+
+    if (&op == &COperator::CALL) {
+        print(terms[0], 1);
+        write("(");
+
+        for (u32 i = 1; i < terms.size(); ++i) {
+            if (i > 1) {
+                write(", ");
+            }
+
+            print(terms[i], 14);
+        }
+
+        write(")");
+    } else if (&op == &COperator::SUBSCRIPT) {
+        print(terms[0], 1);
+        write("[");
+        print(terms[1], 15);
+        write("]");
+    } else if (&op == &COperator::DOT || &op == &COperator::PTR) {
+        print(terms[0], 1);
+        write(op.name);
+        print(terms[1], 0);
+    } else if (&op == &COperator::CAST) {
+        write("(");
+        print_type_name(expression.type());
+        write(")");
+        print(terms[0], 2);
+    } else if (&op == &COperator::TERNARY) {
+        print(terms[0], 12);
+        write(" ? ");
+        print(terms[1], 15);
+        write(" : ");
+        print(terms[2], 13);
+    } else if (op.is_postfix()) {
+        print(terms[0], 1);
+        write(op.name);
+    } else if (op.arity == 1) {
+        write(op.name);
+
+        // A sign before a sign or an increment would read as one token.
+        const CExpression &term = terms[0];
+        bool is_sign = &op == &COperator::NEG || &op == &COperator::POS || &op == &COperator::PRE_DEC || &op == &COperator::PRE_INC;
+        print(term, is_sign && !term.is_terminal() && term.op().precedence == 2 ? 1 : 2);
+    } else {
+        u32 lhs_precedence = op.is_right_associative ? op.precedence - 1 : op.precedence;
+        u32 rhs_precedence = op.is_right_associative ? op.precedence : op.precedence - 1;
+
+        // Binary operands of shifts, bitwise operators and `||` are parenthesized unless they are
+        // the same operator level, as in `a | b | c`.
+        if (is_parenthesizing(op.precedence)) {
+            auto clarify = [&](const CExpression &term, u32 &term_precedence) {
+                if (!term.is_terminal() && term.op().arity == 2 && term.op().precedence >= 3 && term.op().precedence != op.precedence) {
+                    term_precedence = std::min(term_precedence, u32(term.op().precedence) - 1);
+                }
+            };
+
+            clarify(terms[0], lhs_precedence);
+            clarify(terms[1], rhs_precedence);
+        }
+
+        print(terms[0], lhs_precedence);
+        write(&op == &COperator::COMMA ? ", " : " ");
+
+        if (&op != &COperator::COMMA) {
+            write(op.name);
+            write(" ");
+        }
+
+        print(terms[1], rhs_precedence);
+    }
+
+    if (is_parenthesized) {
+        write(")");
+    }
+}
+
+
+void CPrinter::print(const CStatement &statement) {
+    switch (statement.statement_type()) {
+    case CStatementType::BLOCK:
+        print(static_cast<const CBlockStatement &>(statement));
+        break;
+    case CStatementType::BREAK:
+        write("break;");
+        break;
+    case CStatementType::CONTINUE:
+        write("continue;");
+        break;
+    case CStatementType::DECLARATION:
+        print(static_cast<const CDeclarationStatement &>(statement));
+        break;
+    case CStatementType::DO_WHILE:
+        print(static_cast<const CDoWhileStatement &>(statement));
+        break;
+    case CStatementType::EXPRESSION:
+        print(static_cast<const CExpression &>(statement));
+        write(";");
+        break;
+    case CStatementType::FOR:
+        print(static_cast<const CForStatement &>(statement));
+        break;
+    case CStatementType::GOTO:
+        write("goto ");
+        write(static_cast<const CGotoStatement &>(statement).label());
+        write(";");
+        break;
+    case CStatementType::IF:
+        print(static_cast<const CIfStatement &>(statement));
+        break;
+    case CStatementType::LABEL:
+        // The empty statement lets the label end a block.
+        write(static_cast<const CLabelStatement &>(statement).label());
+        write(":;");
+        break;
+    case CStatementType::SWITCH:
+        print(static_cast<const CSwitchStatement &>(statement));
+        break;
+    case CStatementType::RETURN:
+        print(static_cast<const CReturnStatement &>(statement));
+        break;
+    case CStatementType::WHILE:
+        print(static_cast<const CWhileStatement &>(statement));
+        break;
+    }
+}
+
+
+void CPrinter::print(const CBlockStatement &statement) {
+    if (statement.is_empty()) {
+        write("{}");
+        return;
+    }
 
+    write("{");
+    indent();
 
-void CPrinter::print_type_declaration(const CType &type) {
-    switch (type.type()) {
-    case CTypeKind::VOID:
-    case CTypeKind::ARRAY:
-    case CTypeKind::POINTER:
-    case CTypeKind::FUNCTION:
-    case CTypeKind::ENUMERATION:
-    case CTypeKind::STRUCTURE:
-        print_structure_type_declaration(type);
-    default:
+    for (const std::unique_ptr<CStatement> &child : statement.statements()) {
+        newline();
+        print(*child);
     }
+
+    undent();
+    newline();
+    write("}");
 }
 
 
-void CPrinter::print_type_definition(const CType &type) {
+void CPrinter::print(const CDeclarationStatement &statement) {
+    print(statement.variable());
 }
 
 
-void CPrinter::print_type_name(const CType &type) {
+void CPrinter::print(const CDoWhileStatement &statement) {
+    write("do ");
+    print(statement.block());
+    write(" while (");
+    print(statement.condition());
+    write(");");
 }
 
 
+void CPrinter::print(const CForStatement &statement) {
+    write("for (");
+    print(statement.initializer());
+    write(statement.condition().is_empty() ? ";" : "; ");
+    print(statement.condition());
+    write(statement.expression().is_empty() ? ";" : "; ");
+    print(statement.expression());
+    write(") ");
+    print(statement.block());
+}
+
 
+void CPrinter::print(const CIfStatement &statement) {
+    write("if (");
+    print(statement.condition());
+    write(") ");
+    print(statement.if_block());
 
+    const CBlockStatement &else_block = statement.else_block();
 
+    if (else_block.is_empty()) {
+        return;
+    }
+
+    write(" else ");
+
+    // An else block of a single if statement is printed as `else if`.
+    if (else_block.statements().size() == 1 && else_block.statements()[0]->statement_type() == CStatementType::IF) {
+        print(*else_block.statements()[0]);
+    } else {
+        print(else_block);
+    }
+}
 
-void CPrinter::print_structure_type_declaration(const CStructureType &type) {
-    print(
-        "typedef struct {} {};\n"
-        "struct {} {{\n",
-        type.name(),
-        type.name(),
-        type.name()
-    );
+
+void CPrinter::print(const CSwitchStatement &statement) {
+    write("switch (");
+    print(statement.expression());
+    write(") {");
     indent();
 
-    for () {
-        ;
+    for (const CWhenStatement &when : statement.cases()) {
+        newline();
+
+        if (when.value.is_empty()) {
+            write("default: ");
+        } else {
+            write("case ");
+            print(when.value);
+            write(": ");
+        }
+
+        print(when.block);
     }
 
     undent();
-    write("}};\n");
+    newline();
+    write("}");
+}
+
+
+void CPrinter::print(const CReturnStatement &statement) {
+    if (statement.value().is_empty()) {
+        write("return;");
+        return;
+    }
+
+    write("return ");
+    print(statement.value());
+    write(";");
 }
 
 
-void CPrinter::print_structure_type_definition(const CStructureType &type) {
+void CPrinter::print(const CWhileStatement &statement) {
+    write("while (");
+    print(statement.condition());
+    write(") ");
+    print(statement.block());
 }
 
 
-void CPrinter::print_structure_type_name(const CStructureType &type) {
+void CPrinter::print(const CVariable &variable) {
+    if (variable.is_static()) {
+        write("static ");
+    }
+
+    print_declaration(variable.type(), variable.name());
+
+    if (variable.has_initializer()) {
+        write(" = ");
+        print(variable.initializer(), 14);
+    }
+
+    write(";");
+}
+
+
+void CPrinter::print_function_declaration(const CFunction &function) {
+    if (function.is_static()) {
+        write("static ");
+    }
+
+    if (function.is_inline()) {
+        write("inline ");
+    }
+
+    String signature(reinterpret_cast<const char *>(function.name().data()), function.name().size());
+    signature += '(';
+
+    for (u32 i = 0; i < function.parameters().size(); ++i) {
+        const CVariable &parameter = function.parameters()[i];
+        signature += i > 0 ? ", " : "";
+        signature += declaration_of(parameter.type(), parameter.name());
+    }
+
+    signature += function.parameters().empty() ? "void)" : ")";
+
+    // The return type is printed around the signature, as for a function returning a pointer to
+    // an array.
+    const CType &return_type = function.return_type();
+
+    if (return_type.type() == CTypeKind::POINTER || return_type.type() == CTypeKind::ARRAY) {
+        signature = "(" + signature + ")";
+    }
+
+    print_declaration(return_type, StringView(reinterpret_cast<const u8 *>(signature.data()), signature.size()));
+}
+
+
+void CPrinter::print(const CFunction &function) {
+    print_function_declaration(function);
+    write(" ");
+    print(function.body());
+}
+
+
+void CPrinter::print(const CEnumerationType &enum_type) {
+    write("typedef ");
+    print_declaration(enum_type.index_type(), enum_type.name());
+    write(";");
+
+    if (enum_type.values().empty()) {
+        return;
+    }
+
+    newline();
+    write("enum {");
+    indent();
+
+    for (const CEnumerator &value : enum_type.values()) {
+        newline();
+        write(StringView(reinterpret_cast<const u8 *>(value.name.data()), value.name.size()));
+        write(" = ");
+        write(value.value);
+        write(",");
+    }
+
+    undent();
+    newline();
+    write("};");
+}
+
+
+void CPrinter::print_type_declaration(const CBasicType &type) {
+    write(type.type() == CTypeKind::UNION ? "typedef union " : "typedef struct ");
+    write(type.name());
+    write(" ");
+    write(type.name());
+    write(";");
+}
+
+
+void CPrinter::print(const CStructureType &structure_type) {
+    bool is_packed = false;
+
+    for (const CMember &member : structure_type.members()) {
+        is_packed |= member.offset % member.type->alignment() != 0;
+    }
+
+    write("struct ");
+
+    // Packing keeps the compiler from moving a misaligned member, and the alignment attribute
+    // restores the alignment of the structure.
+    if (is_packed) {
+        write("__attribute__((packed, aligned(");
+        write(i64(structure_type.alignment()));
+        write("))) ");
+    }
+
+    write(structure_type.name());
+    write(" {");
+    print_members(structure_type, structure_type.members(), is_packed);
+    write("};");
+    print_layout_assertions(structure_type);
+}
+
+
+void CPrinter::print(const CUnionType &union_type) {
+    write("union ");
+    write(union_type.name());
+    write(" {");
+    print_members(union_type, union_type.members(), false);
+    write("};");
+    print_layout_assertions(union_type);
+}
+
+
+void CPrinter::print_members(const CBasicType &type, const std::vector<CMember> &members, bool is_packed) {
+    u32 offset = 0;
+    u32 padding_count = 0;
+    u32 member_alignment = 1;
+    indent();
+
+    auto print_padding = [&](u32 size) {
+        newline();
+        write("uint8_t _padding");
+        write(i64(padding_count++));
+        write("[");
+        write(i64(size));
+        write("];");
+    };
+
+    for (const CMember &member : members) {
+        member_alignment = std::max(member_alignment, member.type->alignment());
+    }
+
+    for (u32 i = 0; i < members.size(); ++i) {
+        const CMember &member = members[i];
+
+        if (member.offset > offset) {
+            print_padding(member.offset - offset);
+        }
+
+        newline();
+
+        // Raise the alignment of the aggregate to its declared alignment through its first member.
+        if (i == 0 && !is_packed && type.alignment() > member_alignment) {
+            write("_Alignas(");
+            write(i64(type.alignment()));
+            write(") ");
+        }
+
+        print_declaration(*member.type, StringView(reinterpret_cast<const u8 *>(member.name.data()), member.name.size()));
+        write(";");
+        offset = std::max(offset, member.offset + member.type->size());
+    }
+
+    // The compiler pads the aggregate to a multiple of its alignment, and explicit padding covers
+    // the rest of its declared size. The padding of a union overlaps its members.
+    u32 alignment = members.empty() ? 1 : type.alignment();
+
+    if ((offset + alignment - 1) / alignment * alignment < type.size()) {
+        print_padding(type.type() == CTypeKind::UNION ? type.size() : type.size() - offset);
+    }
+
+    undent();
+    newline();
+}
+
+
+void CPrinter::print_layout_assertions(const CBasicType &type) {
+    newline();
+    write("_Static_assert(sizeof(");
+    write(type.name());
+    write(") == ");
+    write(i64(type.size()));
+    write(", \"");
+    write(type.name());
+    write(" has a fixed size\");");
+    newline();
+    write("_Static_assert(_Alignof(");
+    write(type.name());
+    write(") == ");
+    write(i64(type.alignment()));
+    write(", \"");
+    write(type.name());
+    write(" has a fixed alignment\");");
+}
+
+
+void CPrinter::print(const CTranslationUnit &translation_unit) {
+    write("/* Generated from the module ");
+    write(translation_unit.name());
+    write(". */");
+    newline();
+
+    for (const String &header : translation_unit.includes()) {
+        newline();
+        write("#include <");
+        write(StringView(reinterpret_cast<const u8 *>(header.data()), header.size()));
+        write(">");
+    }
+
+    // Aggregates are declared first, so that they may refer to each other through pointers.
+    bool is_first = true;
+
+    for (const std::unique_ptr<CType> &type : translation_unit.types()) {
+        if (dynamic_cast<const CStructureType *>(type.get()) || dynamic_cast<const CUnionType *>(type.get())) {
+            newline(is_first ? 3 : 1);
+            print_type_declaration(static_cast<const CBasicType &>(*type));
+            is_first = false;
+        }
+    }
+
+    for (const std::unique_ptr<CType> &type : translation_unit.types()) {
+        if (const CStructureType *structure_type = dynamic_cast<const CStructureType *>(type.get())) {
+            newline(3);
+            print(*structure_type);
+        } else if (const CUnionType *union_type = dynamic_cast<const CUnionType *>(type.get())) {
+            newline(3);
+            print(*union_type);
+        } else if (const CEnumerationType *enum_type = dynamic_cast<const CEnumerationType *>(type.get())) {
+            newline(3);
+            print(*enum_type);
+        }
+    }
+
+    is_first = true;
+
+    for (const std::unique_ptr<CFunction> &function : translation_unit.functions()) {
+        newline(is_first ? 3 : 1);
+        print_function_declaration(*function);
+        write(";");
+        is_first = false;
+    }
+
+    for (const std::unique_ptr<CFunction> &function : translation_unit.functions()) {
+        if (!function->is_external()) {
+            newline(3);
+            print(*function);
+        }
+    }
+
+    newline();
 }
@@ -0,0 +1,178 @@
+#include <elf/ElfObjectWriter.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+
+struct ElfHeader {
+    u8 ident[16];
+    u16 type;
+    u16 machine;
+    u32 version;
+    u64 entry;
+    u64 program_header_offset;
+    u64 section_header_offset;
+    u32 flags;
+    u16 header_size;
+    u16 program_header_size;
+    u16 program_header_count;
+    u16 section_header_size;
+    u16 section_header_count;
+    u16 section_name_section;
+};
+
+
+struct ElfSectionHeader {
+    u32 name;
+    u32 type;
+    u64 flags;
+    u64 address;
+    u64 offset;
+    u64 size;
+    u32 link;
+    u32 info;
+    u64 alignment;
+    u64 entry_size;
+};
+
+
+struct ElfSymbol {
+    u32 name;
+    u8 info;
+    u8 other;
+    u16 section;
+    u64 value;
+    u64 size;
+};
+
+
+struct ElfRelocation {
+    u64 offset;
+    u64 info;
+    i64 addend;
+};
+
+
+static_assert(sizeof(ElfHeader) == 64 && sizeof(ElfSectionHeader) == 64 && sizeof(ElfSymbol) == 24 && sizeof(ElfRelocation) == 24);
+
+
+// The sections of the object, in order.
+enum : u16 {
+    SECTION_NULL,
+    SECTION_TEXT,
+    SECTION_SYMBOLS,
+    SECTION_STRINGS,
+    SECTION_RELOCATIONS,
+    SECTION_STACK_NOTE,
+    SECTION_SECTION_NAMES,
+    SECTION_COUNT,
+};
+
+
+static constexpr u32 SHT_PROGBITS = 1;
+static constexpr u32 SHT_SYMTAB = 2;
+static constexpr u32 SHT_STRTAB = 3;
+static constexpr u32 SHT_RELA = 4;
+static constexpr u64 SHF_ALLOC = 0x2;
+static constexpr u64 SHF_EXECINSTR = 0x4;
+static constexpr u64 SHF_INFO_LINK = 0x40;
+static constexpr u8 STB_LOCAL = 0;
+static constexpr u8 STB_GLOBAL = 1;
+static constexpr u8 STT_NOTYPE = 0;
+static constexpr u8 STT_FUNC = 2;
+static constexpr u8 STT_SECTION = 3;
+
+
+u32 ElfObjectWriter::add_symbol(StringView name) noexcept {
+    _symbols.push_back({std::string(reinterpret_cast<const char *>(name.data()), name.size()), 0, 0, false});
+    return _symbols.size() - 1;
+}
+
+
+Error ElfObjectWriter::write(const std::filesystem::path &file_path) const noexcept {
+    std::vector<u8> data(sizeof(ElfHeader));
+    std::vector<ElfSectionHeader> sections(SECTION_COUNT);
+    std::string section_names(1, '\0');
+    std::string strings(1, '\0');
+    std::vector<ElfSymbol> symbols;
+    std::vector<ElfRelocation> relocations;
+
+    auto append = [&](const void *bytes, u64 size, u64 alignment) {
+        data.resize((data.size() + alignment - 1) / alignment * alignment);
+        data.insert(data.end(), static_cast<const u8 *>(bytes), static_cast<const u8 *>(bytes) + size);
+        return data.size() - size;
+    };
+
+    auto add_section = [&](u16 index, const char *name, ElfSectionHeader section, const void *bytes) {
+        section.name = section_names.size();
+        section.offset = append(bytes, section.size, section.alignment);
+        section_names += name;
+        section_names += '\0';
+        sections[index] = section;
+    };
+
+    // The local section symbol comes first, then the global symbols of the writer in order.
+    symbols.push_back({});
+    symbols.push_back({0, STB_LOCAL << 4 | STT_SECTION, 0, SECTION_TEXT, 0, 0});
+
+    for (const Symbol &symbol : _symbols) {
+        u8 type = symbol.is_defined ? STT_FUNC : STT_NOTYPE;
+        symbols.push_back({u32(strings.size()), u8(STB_GLOBAL << 4 | type), 0, symbol.is_defined ? u16(SECTION_TEXT) : u16(SECTION_NULL), symbol.offset, symbol.size});
+        strings += symbol.name;
+        strings += '\0';
+    }
+
+    for (const Relocation &relocation : _relocations) {
+        relocations.push_back({relocation.offset, u64(relocation.symbol + 2) << 32 | relocation.type, relocation.addend});
+    }
+
+    add_section(SECTION_TEXT, ".text", {0, SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, 0, 0, _text.size(), 0, 0, 16, 0}, _text.data());
+    add_section(SECTION_SYMBOLS, ".symtab", {0, SHT_SYMTAB, 0, 0, 0, symbols.size() * sizeof(ElfSymbol), SECTION_STRINGS, 2, 8, sizeof(ElfSymbol)}, symbols.data());
+    add_section(SECTION_STRINGS, ".strtab", {0, SHT_STRTAB, 0, 0, 0, strings.size(), 0, 0, 1, 0}, strings.data());
+    add_section(SECTION_RELOCATIONS, ".rela.text", {0, SHT_RELA, SHF_INFO_LINK, 0, 0, relocations.size() * sizeof(ElfRelocation), SECTION_SYMBOLS, SECTION_TEXT, 8, sizeof(ElfRelocation)}, relocations.data());
+
+    // An empty note marks the stack as not executable.
+    add_section(SECTION_STACK_NOTE, ".note.GNU-stack", {0, SHT_PROGBITS, 0, 0, 0, 0, 0, 0, 1, 0}, nullptr);
+
+    // The section names include their own.
+    u32 section_names_name = section_names.size();
+    section_names += ".shstrtab";
+    section_names += '\0';
+    u64 section_names_offset = append(section_names.data(), section_names.size(), 1);
+    sections[SECTION_SECTION_NAMES] = {section_names_name, SHT_STRTAB, 0, 0, section_names_offset, section_names.size(), 0, 0, 1, 0};
+
+    ElfHeader header = {
+        .ident = {0x7F, 'E', 'L', 'F', 2, 1, 1}, // 64-bit, little endian, version 1
+        .type = 1,                               // Relocatable
+        .machine = 62,                           // x86-64
+        .version = 1,
+        .entry = 0,
+        .program_header_offset = 0,
+        .section_header_offset = append(sections.data(), sections.size() * sizeof(ElfSectionHeader), 8),
+        .flags = 0,
+        .header_size = sizeof(ElfHeader),
+        .program_header_size = 0,
+        .program_header_count = 0,
+        .section_header_size = sizeof(ElfSectionHeader),
+        .section_header_count = SECTION_COUNT,
+        .section_name_section = SECTION_SECTION_NAMES,
+    };
+
+    std::copy_n(reinterpret_cast<const u8 *>(&header), sizeof(header), data.begin());
+    std::ofstream file_stream(file_path, std::ios::binary | std::ios::trunc);
+
+    if (!file_stream.is_open()) {
+        printf("Failed to open file! '%s'\n", file_path.c_str());
+        return Error::FAILURE;
+    }
+
+    file_stream.write(reinterpret_cast<const char *>(data.data()), data.size());
+
+    if (!file_stream) {
+        printf("Failed to write file data! '%s'\n", file_path.c_str());
+        return Error::FAILURE;
+    }
+
+    return Error::SUCCESS;
+}
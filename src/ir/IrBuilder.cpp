@@ -0,0 +1,274 @@
+#include <ir/IrBuilder.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+
+IrBuilder::IrBuilder() noexcept {
+    create_block();
+    _blocks[0].is_sealed = true;
+}
+
+
+u32 IrBuilder::create_block() noexcept {
+    _blocks.emplace_back();
+    return _blocks.size() - 1;
+}
+
+
+void IrBuilder::seal_block(u32 block) noexcept {
+    std::vector<std::pair<u32, u32>> incomplete_phis = std::move(_blocks[block].incomplete_phis);
+    _blocks[block].incomplete_phis.clear();
+
+    for (auto [variable, phi] : incomplete_phis) {
+        add_phi_operands(variable, phi);
+    }
+
+    _blocks[block].is_sealed = true;
+}
+
+
+u32 IrBuilder::parameter() noexcept {
+    return append(0, {IrOpcode::PARAMETER, IrValueType::I64, 0, _parameter_count++, 0}, true);
+}
+
+
+u32 IrBuilder::constant(i64 immediate) noexcept {
+    return append(_block, {IrOpcode::CONSTANT, IrValueType::I64, 0, u32(u64(immediate)), u32(u64(immediate) >> 32)});
+}
+
+
+u32 IrBuilder::undefined() noexcept {
+    return append(_block, {IrOpcode::UNDEFINED, IrValueType::I64, 0, 0, 0}, true);
+}
+
+
+u32 IrBuilder::unary(IrOpcode opcode, u32 value) noexcept {
+    return append(_block, {opcode, IrValueType::I64, 0, value, 0});
+}
+
+
+u32 IrBuilder::binary(IrOpcode opcode, u32 lhs, u32 rhs) noexcept {
+    return append(_block, {opcode, opcode.is_comparison() ? IrValueType::I1 : IrValueType::I64, 0, lhs, rhs});
+}
+
+
+u32 IrBuilder::call(u32 function_id, std::vector<u32> arguments) noexcept {
+    u32 value = append(_block, {IrOpcode::CALL, IrValueType::I64, u16(arguments.size()), function_id, 0});
+    _operands[value] = std::move(arguments);
+    return value;
+}
+
+
+void IrBuilder::jump(u32 target) noexcept {
+    append(_block, {IrOpcode::JUMP, IrValueType::VOID, 0, NONE, 0});
+    _blocks[_block].successors[0] = target;
+    add_edge(target);
+}
+
+
+void IrBuilder::branch(u32 condition, u32 true_target, u32 false_target) noexcept {
+    append(_block, {IrOpcode::BRANCH, IrValueType::VOID, 0, condition, 0});
+    _blocks[_block].successors[0] = true_target;
+    _blocks[_block].successors[1] = false_target;
+    add_edge(true_target);
+    add_edge(false_target);
+}
+
+
+void IrBuilder::return_value(u32 value) noexcept {
+    append(_block, {IrOpcode::RETURN, IrValueType::VOID, 0, value, 0});
+}
+
+
+u32 IrBuilder::append(u32 block, IrInstruction instruction, bool is_head) noexcept {
+    u32 value = _values.size();
+    _values.push_back(instruction);
+    _operands.emplace_back();
+    _replacements.push_back(value);
+    _value_blocks.push_back(block);
+    (is_head ? _blocks[block].head : _blocks[block].body).push_back(value);
+    return value;
+}
+
+
+void IrBuilder::add_edge(u32 successor) noexcept {
+    assert(!_blocks[successor].is_sealed && "Edge to a sealed block!");
+    _blocks[successor].predecessors.push_back(_block);
+}
+
+
+u32 IrBuilder::read_variable(u32 variable, u32 block) noexcept {
+    auto it = _definitions.find(u64(variable) << 32 | block);
+
+    if (it != _definitions.end()) {
+        return resolve(it->second);
+    }
+
+    return read_variable_recursive(variable, block);
+}
+
+
+u32 IrBuilder::read_variable_recursive(u32 variable, u32 block) noexcept {
+    u32 value;
+
+    if (!_blocks[block].is_sealed) {
+        value = append(block, {IrOpcode::PHI, IrValueType::I64, 0, 0, 0}, true);
+        _blocks[block].incomplete_phis.push_back({variable, value});
+    } else if (_blocks[block].predecessors.size() == 1) {
+        value = read_variable(variable, _blocks[block].predecessors[0]);
+    } else if (_blocks[block].predecessors.empty()) {
+        value = append(block, {IrOpcode::UNDEFINED, IrValueType::I64, 0, 0, 0}, true);
+    } else {
+        // Define the phi before reading the operands to break cycles through loops.
+        value = append(block, {IrOpcode::PHI, IrValueType::I64, 0, 0, 0}, true);
+        write_variable(variable, block, value);
+        add_phi_operands(variable, value);
+    }
+
+    write_variable(variable, block, value);
+    return value;
+}
+
+
+void IrBuilder::add_phi_operands(u32 variable, u32 phi) noexcept {
+    u32 block = _value_blocks[phi];
+
+    for (u32 i = 0; i < _blocks[block].predecessors.size(); ++i) {
+        u32 operand = read_variable(variable, _blocks[block].predecessors[i]);
+        _operands[phi].push_back(operand);
+    }
+}
+
+
+u32 IrBuilder::resolve(u32 value) noexcept {
+    while (_replacements[value] != value) {
+        _replacements[value] = _replacements[_replacements[value]];
+        value = _replacements[value];
+    }
+
+    return value;
+}
+
+
+IrFunction IrBuilder::finish() noexcept {
+
+    // Replace the phi instructions whose operands are all the same value, or the phi itself, by that
+    // value. Removing one may make others trivial.
+    for (bool is_changed = true; is_changed;) {
+        is_changed = false;
+
+        for (u32 value = 0; value < _values.size(); ++value) {
+            if (_values[value].opcode != IrOpcode::PHI || _replacements[value] != value) {
+                continue;
+            }
+
+            u32 same = NONE;
+            bool is_trivial = true;
+
+            for (u32 &operand : _operands[value]) {
+                operand = resolve(operand);
+
+                if (operand == same || operand == value) {
+                    continue;
+                }
+
+                if (same != NONE) {
+                    is_trivial = false;
+                    break;
+                }
+
+                same = operand;
+            }
+
+            if (is_trivial) {
+                if (same == NONE) {
+                    same = append(_value_blocks[value], {IrOpcode::UNDEFINED, IrValueType::I64, 0, 0, 0}, true);
+                }
+
+                _replacements[value] = same;
+                is_changed = true;
+            }
+        }
+    }
+
+    for (u32 block = 0; block < _blocks.size(); ++block) {
+        _block = block;
+
+        if (!is_terminated()) {
+            append(block, {IrOpcode::UNREACHABLE, IrValueType::VOID, 0, NONE, 0});
+        }
+    }
+
+    // Lay out the remaining values block by block, phi instructions first.
+    IrFunction function;
+    std::vector<u32> indices(_values.size(), NONE);
+
+    for (Block &block : _blocks) {
+        std::stable_partition(block.head.begin(), block.head.end(), [this](u32 value) {
+            return _values[value].opcode == IrOpcode::PHI;
+        });
+    }
+
+    for (Block &block : _blocks) {
+        for (const std::vector<u32> *values : {&block.head, &block.body}) {
+            for (u32 value : *values) {
+                if (_replacements[value] == value) {
+                    indices[value] = function._instructions.size();
+                    function._instructions.push_back(_values[value]);
+                }
+            }
+        }
+    }
+
+    auto index_of = [&](u32 value) {
+        return value == NONE ? NONE : indices[resolve(value)];
+    };
+
+    for (u32 value = 0; value < _values.size(); ++value) {
+        if (indices[value] == NONE) {
+            continue;
+        }
+
+        IrInstruction &instruction = function._instructions[indices[value]];
+
+        if (instruction.opcode.has_value_a()) {
+            instruction.a = index_of(instruction.a);
+        }
+
+        if (instruction.opcode.has_value_b()) {
+            instruction.b = index_of(instruction.b);
+        }
+
+        if (instruction.opcode.has_operand_array()) {
+            instruction.b = function._operands.size();
+            instruction.operand_count = _operands[value].size();
+
+            for (u32 operand : _operands[value]) {
+                function._operands.push_back(index_of(operand));
+            }
+        }
+    }
+
+    u32 first_instruction = 0;
+
+    for (const Block &block : _blocks) {
+        IrBasicBlock basic_block = {first_instruction, 0, 0, u32(function._predecessors.size()), u32(block.predecessors.size()), {block.successors[0], block.successors[1]}};
+
+        for (const std::vector<u32> *values : {&block.head, &block.body}) {
+            for (u32 value : *values) {
+                if (indices[value] != NONE) {
+                    basic_block.instruction_count += 1;
+                    basic_block.phi_count += _values[value].opcode == IrOpcode::PHI;
+                }
+            }
+        }
+
+        function._predecessors.insert(function._predecessors.end(), block.predecessors.begin(), block.predecessors.end());
+        function._blocks.push_back(basic_block);
+        first_instruction += basic_block.instruction_count;
+    }
+
+    function._parameter_count = _parameter_count;
+    return function;
+}
@@ -0,0 +1,334 @@
+#include <ir/IrByteCodeCompiler.hpp>
+
+#include <algorithm>
+#include <cstdio>
+
+
+Error IrByteCodeCompiler::compile(IrByteCodeFunction &byte_code) noexcept {
+    Slice<const IrBasicBlock> blocks = _function.blocks();
+    count_uses();
+    assign_registers();
+
+    if (_error != Error::SUCCESS) {
+        return _error;
+    }
+
+    // Lay out the reachable blocks in order, then the edge blocks.
+    _labels.assign(blocks.size(), NONE);
+
+    for (u32 block = 0; block != NONE; block = _next_block) {
+        _next_block = block + 1;
+
+        while (_next_block < blocks.size() && blocks[_next_block].predecessor_count == 0) {
+            _next_block += 1;
+        }
+
+        if (_next_block == blocks.size()) {
+            _next_block = NONE;
+        }
+
+        _labels[block] = _byte_code._code.size();
+        compile_block(block);
+    }
+
+    _next_block = NONE;
+
+    for (u32 i = 0; i < _edges.size(); ++i) {
+        Edge edge = _edges[i];
+        _labels.push_back(_byte_code._code.size());
+        compile_edge_moves(edge.block, edge.successor);
+        emit_jump(IrByteCodeOpcode::JUMP, 0, 0, blocks[edge.block].successors[edge.successor]);
+    }
+
+    if (_byte_code._code.size() > IrByteCodeFunction::MAX_SIZE || _byte_code._constants.size() > IrByteCodeFunction::MAX_SIZE) {
+        error("Too many instructions");
+        return _error;
+    }
+
+    for (Fixup fixup : _fixups) {
+        _byte_code._code[fixup.offset].c = _labels[fixup.label];
+    }
+
+    byte_code = std::move(_byte_code);
+    return _error;
+}
+
+
+void IrByteCodeCompiler::count_uses() noexcept {
+    Slice<const IrInstruction> instructions = _function.instructions();
+    _use_counts.assign(instructions.size(), 0);
+
+    for (const IrInstruction &instruction : instructions) {
+        if (instruction.opcode.has_value_a() && instruction.a != IrInstruction::NONE) {
+            _use_counts[instruction.a] += 1;
+        }
+
+        if (instruction.opcode.has_value_b()) {
+            _use_counts[instruction.b] += 1;
+        }
+
+        if (instruction.opcode.has_operand_array()) {
+            for (u32 operand : _function.operands(instruction)) {
+                _use_counts[operand] += 1;
+            }
+        }
+    }
+
+    // Constants added as immediates are only loaded if they have other uses.
+    for (const IrInstruction &instruction : instructions) {
+        if (instruction.opcode == IrOpcode::ADD || instruction.opcode == IrOpcode::SUB) {
+            if (is_small_constant(instruction.b)) {
+                _use_counts[instruction.b] -= 1;
+            } else if (instruction.opcode == IrOpcode::ADD && is_small_constant(instruction.a)) {
+                _use_counts[instruction.a] -= 1;
+            }
+        }
+    }
+}
+
+
+void IrByteCodeCompiler::assign_registers() noexcept {
+    Slice<const IrInstruction> instructions = _function.instructions();
+    u32 register_count = _function.parameter_count();
+    u32 temporary_count = 0;
+    u32 argument_count = 0;
+    _registers.assign(instructions.size(), NONE);
+
+    for (u32 value = 0; value < instructions.size(); ++value) {
+        const IrInstruction &instruction = instructions[value];
+
+        if (instruction.opcode == IrOpcode::PARAMETER) {
+            _registers[value] = instruction.a;
+        } else if (instruction.opcode == IrOpcode::CALL) {
+            _registers[value] = register_count++;
+            argument_count = std::max<u32>(argument_count, instruction.operand_count);
+        } else if (!instruction.opcode.is_terminator() && _use_counts[value] != 0 && !is_fused_comparison(value)) {
+            _registers[value] = register_count++;
+        }
+    }
+
+    for (const IrBasicBlock &block : _function.blocks()) {
+        temporary_count = std::max(temporary_count, block.phi_count);
+    }
+
+    _temporary_register = register_count;
+    _argument_register = _temporary_register + temporary_count;
+    register_count = _argument_register + argument_count;
+
+    if (register_count > IrByteCodeFunction::MAX_SIZE) {
+        error("Too many registers");
+    }
+
+    _byte_code._parameter_count = _function.parameter_count();
+    _byte_code._register_count = register_count;
+}
+
+
+bool IrByteCodeCompiler::is_small_constant(u32 value) const noexcept {
+    const IrInstruction &instruction = _function.instruction(value);
+
+    // The range is symmetric so that subtractions can add the negated immediate.
+    return instruction.opcode == IrOpcode::CONSTANT && instruction.immediate() >= -0x7FFF && instruction.immediate() <= 0x7FFF;
+}
+
+
+bool IrByteCodeCompiler::is_fused_comparison(u32 value) const noexcept {
+    Slice<const IrInstruction> instructions = _function.instructions();
+
+    // Terminators end the block of the instruction before them, so the branch is in the same block.
+    return instructions[value].opcode.is_comparison() &&
+        _use_counts[value] == 1 &&
+        value + 1 < instructions.size() &&
+        instructions[value + 1].opcode == IrOpcode::BRANCH &&
+        instructions[value + 1].a == value;
+}
+
+
+void IrByteCodeCompiler::compile_block(u32 block) noexcept {
+    const IrBasicBlock &basic_block = _function.block(block);
+
+    for (u32 value = basic_block.first_instruction + basic_block.phi_count; value < basic_block.terminator(); ++value) {
+        compile_instruction(value);
+    }
+
+    compile_terminator(block);
+}
+
+
+void IrByteCodeCompiler::compile_instruction(u32 value) noexcept {
+    const IrInstruction &instruction = _function.instruction(value);
+    IrOpcode opcode = instruction.opcode;
+    u32 result = _registers[value];
+
+    if (result == NONE || opcode == IrOpcode::PARAMETER || opcode == IrOpcode::UNDEFINED) {
+        return;
+    }
+
+    if (opcode == IrOpcode::CONSTANT) {
+        i64 immediate = instruction.immediate();
+
+        if (immediate >= -0x8000 && immediate <= 0x7FFF) {
+            emit(IrByteCodeOpcode::LOAD_INTEGER, result, u16(immediate), 0);
+        } else {
+            emit(IrByteCodeOpcode::LOAD_CONSTANT, result, _byte_code._constants.size(), 0);
+            _byte_code._constants.push_back(immediate);
+        }
+    } else if (opcode.is_unary()) {
+        emit(IrByteCodeOpcode(IrByteCodeOpcode::NEG + (opcode - IrOpcode::NEG)), result, _registers[instruction.a], 0);
+    } else if ((opcode == IrOpcode::ADD || opcode == IrOpcode::SUB) && is_small_constant(instruction.b)) {
+        i64 immediate = _function.instruction(instruction.b).immediate();
+        emit(IrByteCodeOpcode::ADD_INTEGER, result, _registers[instruction.a], u16(opcode == IrOpcode::ADD ? immediate : -immediate));
+    } else if (opcode == IrOpcode::ADD && is_small_constant(instruction.a)) {
+        i64 immediate = _function.instruction(instruction.a).immediate();
+        emit(IrByteCodeOpcode::ADD_INTEGER, result, _registers[instruction.b], u16(immediate));
+    } else if (opcode.is_binary()) {
+        emit(IrByteCodeOpcode(IrByteCodeOpcode::ADD + (opcode - IrOpcode::ADD)), result, _registers[instruction.a], _registers[instruction.b]);
+    } else if (opcode == IrOpcode::CALL) {
+        auto it = _function_indices.find(instruction.a);
+
+        if (it == _function_indices.end() || it->second >= IrByteCodeFunction::MAX_SIZE) {
+            error("Unknown function");
+            return;
+        }
+
+        Slice<const u32> arguments = _function.operands(instruction);
+
+        for (u32 i = 0; i < arguments.size(); ++i) {
+            emit(IrByteCodeOpcode::MOVE, _argument_register + i, _registers[arguments[i]], 0);
+        }
+
+        emit(IrByteCodeOpcode::CALL, result, _argument_register, it->second);
+    } else {
+        error("Unsupported instruction");
+    }
+}
+
+
+void IrByteCodeCompiler::compile_terminator(u32 block) noexcept {
+    const IrBasicBlock &basic_block = _function.block(block);
+    const IrInstruction &terminator = _function.instruction(basic_block.terminator());
+
+    if (terminator.opcode == IrOpcode::JUMP) {
+        compile_edge_moves(block, 0);
+
+        if (basic_block.successors[0] != _next_block) {
+            emit_jump(IrByteCodeOpcode::JUMP, 0, 0, basic_block.successors[0]);
+        }
+    } else if (terminator.opcode == IrOpcode::BRANCH) {
+        u32 true_label = edge_label(block, 0);
+        u32 false_label = edge_label(block, 1);
+        IrByteCodeOpcode opcode = IrByteCodeOpcode::BRANCH_TRUE;
+        IrByteCodeOpcode inverse_opcode = IrByteCodeOpcode::BRANCH_FALSE;
+        u32 a = _registers[terminator.a];
+        u32 b = 0;
+
+        if (is_fused_comparison(terminator.a)) {
+            const IrInstruction &comparison = _function.instruction(terminator.a);
+            opcode = IrByteCodeOpcode(IrByteCodeOpcode::BRANCH_EQ + (comparison.opcode - IrOpcode::EQ));
+            inverse_opcode = opcode.inverse_branch();
+            a = _registers[comparison.a];
+            b = _registers[comparison.b];
+        }
+
+        if (true_label == _next_block) {
+            emit_jump(inverse_opcode, a, b, false_label);
+        } else {
+            emit_jump(opcode, a, b, true_label);
+
+            if (false_label != _next_block) {
+                emit_jump(IrByteCodeOpcode::JUMP, 0, 0, false_label);
+            }
+        }
+    } else if (terminator.opcode == IrOpcode::RETURN) {
+        if (terminator.a == IrInstruction::NONE) {
+            emit(IrByteCodeOpcode::RETURN_VOID, 0, 0, 0);
+        } else {
+            emit(IrByteCodeOpcode::RETURN, _registers[terminator.a], 0, 0);
+        }
+    } else {
+        emit(IrByteCodeOpcode::UNREACHABLE, 0, 0, 0);
+    }
+}
+
+
+void IrByteCodeCompiler::compile_edge_moves(u32 block, u32 successor) noexcept {
+    const IrBasicBlock &basic_block = _function.block(block);
+    const IrBasicBlock &target = _function.block(basic_block.successors[successor]);
+    Slice<const u32> predecessors = _function.predecessors(target);
+    u32 predecessor = 0;
+
+    // A branch with both successors in the same block is two predecessors of the block, in order.
+    u32 skipped_count = successor == 1 && basic_block.successors[0] == basic_block.successors[1];
+
+    for (;; ++predecessor) {
+        if (predecessors[predecessor] == block) {
+            if (skipped_count == 0) {
+                break;
+            }
+
+            skipped_count -= 1;
+        }
+    }
+
+    std::vector<std::pair<u32, u32>> moves;
+    bool is_overlapping = false;
+
+    for (u32 phi = target.first_instruction; phi < target.first_instruction + target.phi_count; ++phi) {
+        u32 operand = _function.operands(_function.instruction(phi))[predecessor];
+
+        if (_registers[phi] != NONE && _registers[phi] != _registers[operand] && _function.instruction(operand).opcode != IrOpcode::UNDEFINED) {
+            moves.push_back({_registers[phi], _registers[operand]});
+        }
+    }
+
+    for (auto [destination, source] : moves) {
+        for (auto [other_destination, other_source] : moves) {
+            is_overlapping |= source == other_destination;
+        }
+    }
+
+    if (!is_overlapping) {
+        for (auto [destination, source] : moves) {
+            emit(IrByteCodeOpcode::MOVE, destination, source, 0);
+        }
+
+        return;
+    }
+
+    for (u32 i = 0; i < moves.size(); ++i) {
+        emit(IrByteCodeOpcode::MOVE, _temporary_register + i, moves[i].second, 0);
+    }
+
+    for (u32 i = 0; i < moves.size(); ++i) {
+        emit(IrByteCodeOpcode::MOVE, moves[i].first, _temporary_register + i, 0);
+    }
+}
+
+
+u32 IrByteCodeCompiler::edge_label(u32 block, u32 successor) noexcept {
+    u32 target = _function.block(block).successors[successor];
+
+    if (_function.block(target).phi_count == 0) {
+        return target;
+    }
+
+    _edges.push_back({block, successor});
+    return _function.blocks().size() + _edges.size() - 1;
+}
+
+
+void IrByteCodeCompiler::emit(IrByteCodeOpcode opcode, u32 a, u32 b, u32 c) noexcept {
+    _byte_code._code.push_back({opcode, 0, u16(a), u16(b), u16(c)});
+}
+
+
+void IrByteCodeCompiler::emit_jump(IrByteCodeOpcode opcode, u32 a, u32 b, u32 label) noexcept {
+    _fixups.push_back({u32(_byte_code._code.size()), label});
+    emit(opcode, a, b, 0);
+}
+
+
+void IrByteCodeCompiler::error(const char *message) noexcept {
+    printf("Failed to compile byte code! %s\n", message);
+    _error = Error::FAILURE;
+}
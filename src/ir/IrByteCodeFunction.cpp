@@ -0,0 +1,38 @@
+#include <ir/ast/IrByteCodeFunction.hpp>
+
+#include <cstdio>
+
+
+void IrByteCodeFunction::print() const noexcept {
+    printf("function (%u parameters, %u registers)\n", _parameter_count, _register_count);
+
+    for (u32 i = 0; i < _code.size(); ++i) {
+        const IrByteCodeInstruction &instruction = _code[i];
+        IrByteCodeOpcode opcode = instruction.opcode;
+        printf("%5u    %s", i, opcode.name());
+
+        if (opcode == IrByteCodeOpcode::LOAD_INTEGER) {
+            printf(" r%u, %d", instruction.a, i16(instruction.b));
+        } else if (opcode == IrByteCodeOpcode::LOAD_CONSTANT) {
+            printf(" r%u, %ld", instruction.a, _constants[instruction.b]);
+        } else if (opcode == IrByteCodeOpcode::MOVE || opcode == IrByteCodeOpcode::NEG || opcode == IrByteCodeOpcode::NOT) {
+            printf(" r%u, r%u", instruction.a, instruction.b);
+        } else if (opcode == IrByteCodeOpcode::ADD_INTEGER) {
+            printf(" r%u, r%u, %d", instruction.a, instruction.b, i16(instruction.c));
+        } else if (opcode.is_fused_branch()) {
+            printf(" r%u, r%u, @%u", instruction.a, instruction.b, instruction.c);
+        } else if (opcode == IrByteCodeOpcode::JUMP) {
+            printf(" @%u", instruction.c);
+        } else if (opcode == IrByteCodeOpcode::BRANCH_TRUE || opcode == IrByteCodeOpcode::BRANCH_FALSE) {
+            printf(" r%u, @%u", instruction.a, instruction.c);
+        } else if (opcode == IrByteCodeOpcode::CALL) {
+            printf(" r%u, f%u(r%u...)", instruction.a, instruction.c, instruction.b);
+        } else if (opcode == IrByteCodeOpcode::RETURN) {
+            printf(" r%u", instruction.a);
+        } else if (opcode != IrByteCodeOpcode::RETURN_VOID && opcode != IrByteCodeOpcode::UNREACHABLE) {
+            printf(" r%u, r%u, r%u", instruction.a, instruction.b, instruction.c);
+        }
+
+        printf("\n");
+    }
+}
@@ -0,0 +1,65 @@
+#include <ir/ast/IrFunction.hpp>
+
+#include <cstdio>
+
+
+void IrFunction::print() const noexcept {
+    printf("function (%u parameters)\n", _parameter_count);
+
+    for (u32 i = 0; i < _blocks.size(); ++i) {
+        const IrBasicBlock &block = _blocks[i];
+        Slice<const u32> block_predecessors = predecessors(block);
+        printf("b%u:", i);
+
+        for (u32 j = 0; j < block_predecessors.size(); ++j) {
+            printf("%s b%u", j == 0 ? " ; from" : ",", block_predecessors[j]);
+        }
+
+        printf("\n");
+
+        for (u32 index = block.first_instruction; index < block.end_instruction(); ++index) {
+            const IrInstruction &instruction = _instructions[index];
+            IrOpcode opcode = instruction.opcode;
+            printf("    ");
+
+            if (!opcode.is_terminator()) {
+                printf("%%%u = ", index);
+            }
+
+            printf("%s", opcode.name());
+
+            if (opcode == IrOpcode::PARAMETER) {
+                printf(" %u", instruction.a);
+            } else if (opcode == IrOpcode::CONSTANT) {
+                printf(" %ld", instruction.immediate());
+            } else if (opcode == IrOpcode::PHI) {
+                Slice<const u32> phi_operands = operands(instruction);
+
+                for (u32 j = 0; j < phi_operands.size(); ++j) {
+                    printf("%s [%%%u, b%u]", j == 0 ? "" : ",", phi_operands[j], block_predecessors[j]);
+                }
+            } else if (opcode == IrOpcode::CALL) {
+                Slice<const u32> arguments = operands(instruction);
+                printf(" @%u(", instruction.a);
+
+                for (u32 j = 0; j < arguments.size(); ++j) {
+                    printf("%s%%%u", j == 0 ? "" : ", ", arguments[j]);
+                }
+
+                printf(")");
+            } else if (opcode.has_value_b()) {
+                printf(" %%%u, %%%u", instruction.a, instruction.b);
+            } else if (opcode.has_value_a() && instruction.a != IrInstruction::NONE) {
+                printf(" %%%u", instruction.a);
+            }
+
+            if (opcode == IrOpcode::JUMP) {
+                printf(" b%u", block.successors[0]);
+            } else if (opcode == IrOpcode::BRANCH) {
+                printf(", b%u, b%u", block.successors[0], block.successors[1]);
+            }
+
+            printf("\n");
+        }
+    }
+}
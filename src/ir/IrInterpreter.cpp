@@ -0,0 +1,186 @@
+#include <ir/IrInterpreter.hpp>
+
+#include <cstdio>
+
+
+#if defined(__GNUC__)
+#define IR_THREADED_DISPATCH
+#endif
+
+
+Error IrInterpreter::run(u32 function, Slice<const i64> arguments, i64 &result, IrDispatch dispatch) noexcept {
+    const IrByteCodeFunction *callee = &_functions[function];
+
+    if (arguments.size() != callee->parameter_count()) {
+        printf("Failed to run byte code! Expected %u arguments, got %u\n", callee->parameter_count(), arguments.size());
+        return Error::FAILURE;
+    }
+
+    if (callee->register_count() > _registers.size()) {
+        printf("Failed to run byte code! Stack overflow\n");
+        return Error::FAILURE;
+    }
+
+    for (u32 i = 0; i < arguments.size(); ++i) {
+        _registers[i] = arguments[i];
+    }
+
+    _frames.clear();
+
+    if (dispatch == IrDispatch::SWITCH) {
+        return execute<IrDispatch::SWITCH>(callee, result);
+    }
+
+    return execute<IrDispatch::THREADED>(callee, result);
+}
+
+
+#ifdef IR_THREADED_DISPATCH
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+
+// Each instruction is both a case of the switch and a label of the table, so that both dispatches
+// share one body.
+#define CASE(OPCODE) case IrByteCodeOpcode::OPCODE: OPCODE_##OPCODE:
+#define DISPATCH_INSTRUCTION() if constexpr (DISPATCH == IrDispatch::THREADED) { goto *LABELS[pc->opcode]; } else { continue; }
+#else
+#define CASE(OPCODE) case IrByteCodeOpcode::OPCODE:
+#define DISPATCH_INSTRUCTION() continue
+#endif
+
+#define NEXT_INSTRUCTION() ++pc; DISPATCH_INSTRUCTION()
+#define JUMP_TO(OFFSET) pc = code + (OFFSET); DISPATCH_INSTRUCTION()
+#define FAIL(MESSAGE) message = MESSAGE; goto fail
+
+
+template<u8 DISPATCH>
+Error IrInterpreter::execute(const IrByteCodeFunction *function, i64 &result) noexcept {
+    const IrByteCodeInstruction *code = function->code().data();
+    const IrByteCodeInstruction *pc = code;
+    const i64 *constants = function->constants().data();
+    const i64 *registers_end = _registers.data() + _registers.size();
+    i64 *r = _registers.data();
+    const char *message;
+
+#ifdef IR_THREADED_DISPATCH
+    [[maybe_unused]] static const void *const LABELS[IrByteCodeOpcode::COUNT] = {
+        &&OPCODE_MOVE, &&OPCODE_LOAD_INTEGER, &&OPCODE_LOAD_CONSTANT, &&OPCODE_NEG, &&OPCODE_NOT,
+        &&OPCODE_ADD, &&OPCODE_SUB, &&OPCODE_MUL, &&OPCODE_DIV, &&OPCODE_REM, &&OPCODE_AND, &&OPCODE_OR,
+        &&OPCODE_XOR, &&OPCODE_SHL, &&OPCODE_SHR, &&OPCODE_EQ, &&OPCODE_NE, &&OPCODE_LT, &&OPCODE_LE,
+        &&OPCODE_GT, &&OPCODE_GE, &&OPCODE_ADD_INTEGER, &&OPCODE_BRANCH_EQ, &&OPCODE_BRANCH_NE,
+        &&OPCODE_BRANCH_LT, &&OPCODE_BRANCH_LE, &&OPCODE_BRANCH_GT, &&OPCODE_BRANCH_GE, &&OPCODE_JUMP,
+        &&OPCODE_BRANCH_TRUE, &&OPCODE_BRANCH_FALSE, &&OPCODE_CALL, &&OPCODE_RETURN,
+        &&OPCODE_RETURN_VOID, &&OPCODE_UNREACHABLE,
+    };
+
+    if constexpr (DISPATCH == IrDispatch::THREADED) {
+        goto *LABELS[pc->opcode];
+    }
+#endif
+
+    for (;;) {
+        switch (pc->opcode) {
+        CASE(MOVE) r[pc->a] = r[pc->b]; NEXT_INSTRUCTION();
+        CASE(LOAD_INTEGER) r[pc->a] = i16(pc->b); NEXT_INSTRUCTION();
+        CASE(LOAD_CONSTANT) r[pc->a] = constants[pc->b]; NEXT_INSTRUCTION();
+
+        // Arithmetic wraps around, as on the machines the IR is compiled for.
+        CASE(NEG) r[pc->a] = i64(0 - u64(r[pc->b])); NEXT_INSTRUCTION();
+        CASE(NOT) r[pc->a] = ~r[pc->b]; NEXT_INSTRUCTION();
+        CASE(ADD) r[pc->a] = i64(u64(r[pc->b]) + u64(r[pc->c])); NEXT_INSTRUCTION();
+        CASE(SUB) r[pc->a] = i64(u64(r[pc->b]) - u64(r[pc->c])); NEXT_INSTRUCTION();
+        CASE(MUL) r[pc->a] = i64(u64(r[pc->b]) * u64(r[pc->c])); NEXT_INSTRUCTION();
+        CASE(DIV)
+            if (r[pc->c] == 0) {
+                FAIL("Division by zero");
+            }
+
+            r[pc->a] = r[pc->c] == -1 ? i64(0 - u64(r[pc->b])) : r[pc->b] / r[pc->c];
+            NEXT_INSTRUCTION();
+        CASE(REM)
+            if (r[pc->c] == 0) {
+                FAIL("Division by zero");
+            }
+
+            r[pc->a] = r[pc->c] == -1 ? 0 : r[pc->b] % r[pc->c];
+            NEXT_INSTRUCTION();
+        CASE(AND) r[pc->a] = r[pc->b] & r[pc->c]; NEXT_INSTRUCTION();
+        CASE(OR) r[pc->a] = r[pc->b] | r[pc->c]; NEXT_INSTRUCTION();
+        CASE(XOR) r[pc->a] = r[pc->b] ^ r[pc->c]; NEXT_INSTRUCTION();
+        CASE(SHL) r[pc->a] = i64(u64(r[pc->b]) << (r[pc->c] & 63)); NEXT_INSTRUCTION();
+        CASE(SHR) r[pc->a] = r[pc->b] >> (r[pc->c] & 63); NEXT_INSTRUCTION();
+        CASE(EQ) r[pc->a] = r[pc->b] == r[pc->c]; NEXT_INSTRUCTION();
+        CASE(NE) r[pc->a] = r[pc->b] != r[pc->c]; NEXT_INSTRUCTION();
+        CASE(LT) r[pc->a] = r[pc->b] < r[pc->c]; NEXT_INSTRUCTION();
+        CASE(LE) r[pc->a] = r[pc->b] <= r[pc->c]; NEXT_INSTRUCTION();
+        CASE(GT) r[pc->a] = r[pc->b] > r[pc->c]; NEXT_INSTRUCTION();
+        CASE(GE) r[pc->a] = r[pc->b] >= r[pc->c]; NEXT_INSTRUCTION();
+
+        // Superinstructions
+        CASE(ADD_INTEGER) r[pc->a] = i64(u64(r[pc->b]) + u64(i16(pc->c))); NEXT_INSTRUCTION();
+        CASE(BRANCH_EQ) if (r[pc->a] == r[pc->b]) { JUMP_TO(pc->c); } NEXT_INSTRUCTION();
+        CASE(BRANCH_NE) if (r[pc->a] != r[pc->b]) { JUMP_TO(pc->c); } NEXT_INSTRUCTION();
+        CASE(BRANCH_LT) if (r[pc->a] < r[pc->b]) { JUMP_TO(pc->c); } NEXT_INSTRUCTION();
+        CASE(BRANCH_LE) if (r[pc->a] <= r[pc->b]) { JUMP_TO(pc->c); } NEXT_INSTRUCTION();
+        CASE(BRANCH_GT) if (r[pc->a] > r[pc->b]) { JUMP_TO(pc->c); } NEXT_INSTRUCTION();
+        CASE(BRANCH_GE) if (r[pc->a] >= r[pc->b]) { JUMP_TO(pc->c); } NEXT_INSTRUCTION();
+
+        // Control
+        CASE(JUMP) JUMP_TO(pc->c);
+        CASE(BRANCH_TRUE) if (r[pc->a] != 0) { JUMP_TO(pc->c); } NEXT_INSTRUCTION();
+        CASE(BRANCH_FALSE) if (r[pc->a] == 0) { JUMP_TO(pc->c); } NEXT_INSTRUCTION();
+        CASE(CALL) {
+            const IrByteCodeFunction *callee = &_functions[pc->c];
+            i64 *callee_registers = r + pc->b;
+
+            if (callee_registers + callee->register_count() > registers_end) {
+                FAIL("Stack overflow");
+            }
+
+            _frames.push_back({function, pc, r});
+            function = callee;
+            code = function->code().data();
+            constants = function->constants().data();
+            r = callee_registers;
+            pc = code;
+            DISPATCH_INSTRUCTION();
+        }
+        CASE(RETURN)
+        CASE(RETURN_VOID) {
+            i64 value = pc->opcode == IrByteCodeOpcode::RETURN ? r[pc->a] : 0;
+
+            if (_frames.empty()) {
+                result = value;
+                return Error::SUCCESS;
+            }
+
+            Frame frame = _frames.back();
+            _frames.pop_back();
+            function = frame.function;
+            code = function->code().data();
+            constants = function->constants().data();
+            r = frame.registers;
+            pc = frame.return_address;
+            r[pc->a] = value;
+            NEXT_INSTRUCTION();
+        }
+        CASE(UNREACHABLE) FAIL("Reached unreachable code");
+        default: FAIL("Invalid opcode");
+        }
+    }
+
+fail:
+    printf("Failed to run byte code! %s\n", message);
+    return Error::FAILURE;
+}
+
+
+#undef CASE
+#undef DISPATCH_INSTRUCTION
+#undef NEXT_INSTRUCTION
+#undef JUMP_TO
+#undef FAIL
+
+#ifdef IR_THREADED_DISPATCH
+#pragma GCC diagnostic pop
+#endif
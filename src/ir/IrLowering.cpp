@@ -0,0 +1,399 @@
+#include <ir/IrLowering.hpp>
+#include <mj/ast/MjBlockStatement.hpp>
+#include <mj/ast/MjIfStatement.hpp>
+#include <mj/ast/MjReturnStatement.hpp>
+#include <mj/ast/MjVariable.hpp>
+#include <mj/ast/MjWhileLoop.hpp>
+
+#include <cstdio>
+
+
+/// Parse a decimal, hexadecimal (`0x`) or binary (`0b`) integer literal with an optional sign and
+/// optional `_` separators. The lexer reads the sign of a number as part of the literal.
+static bool parse_integer(StringView text, i64 &value) noexcept {
+    const u8 *data = text.data();
+    u32 size = text.size();
+    u64 base = 10;
+    u64 result = 0;
+    u32 i = 0;
+    bool is_negative = size > 0 && data[0] == '-';
+
+    if (size > 0 && (data[0] == '-' || data[0] == '+')) {
+        i = 1;
+    }
+
+    if (size > i + 2 && data[i] == '0' && (data[i + 1] == 'x' || data[i + 1] == 'b')) {
+        base = data[i + 1] == 'x' ? 16 : 2;
+        i += 2;
+    }
+
+    if (i == size) {
+        return false;
+    }
+
+    for (; i < size; ++i) {
+        u8 ch = data[i];
+        u64 digit;
+
+        if (ch == '_') {
+            continue;
+        } else if (ch >= '0' && ch <= '9') {
+            digit = ch - '0';
+        } else if (ch >= 'a' && ch <= 'f') {
+            digit = ch - 'a' + 10;
+        } else if (ch >= 'A' && ch <= 'F') {
+            digit = ch - 'A' + 10;
+        } else {
+            return false;
+        }
+
+        if (digit >= base) {
+            return false;
+        }
+
+        result = result * base + digit;
+    }
+
+    value = is_negative ? -i64(result) : i64(result);
+    return true;
+}
+
+
+/// Return the opcode of an arithmetic, bitwise or comparison operator, or of the operation of a
+/// compound assignment, or `NONE`.
+static u32 opcode_of(MjOperatorKind kind) noexcept {
+    switch (kind) {
+    case MjOperatorKind::MUL_SET:
+    case MjOperatorKind::MULTIPLICATION: return IrOpcode::MUL;
+    case MjOperatorKind::DIV_SET:
+    case MjOperatorKind::DIVISION: return IrOpcode::DIV;
+    case MjOperatorKind::MOD_SET:
+    case MjOperatorKind::REMAINDER: return IrOpcode::REM;
+    case MjOperatorKind::ADD_SET:
+    case MjOperatorKind::ADDITION: return IrOpcode::ADD;
+    case MjOperatorKind::SUB_SET:
+    case MjOperatorKind::SUBTRACTION: return IrOpcode::SUB;
+    case MjOperatorKind::LSL_SET:
+    case MjOperatorKind::SHIFT_LEFT: return IrOpcode::SHL;
+    case MjOperatorKind::ASR_SET:
+    case MjOperatorKind::SHIFT_RIGHT: return IrOpcode::SHR;
+    case MjOperatorKind::AND_SET:
+    case MjOperatorKind::BITWISE_AND: return IrOpcode::AND;
+    case MjOperatorKind::XOR_SET:
+    case MjOperatorKind::BITWISE_XOR: return IrOpcode::XOR;
+    case MjOperatorKind::OR_SET:
+    case MjOperatorKind::BITWISE_OR: return IrOpcode::OR;
+    case MjOperatorKind::EQUAL: return IrOpcode::EQ;
+    case MjOperatorKind::NOT_EQUAL: return IrOpcode::NE;
+    case MjOperatorKind::GREATER_THAN: return IrOpcode::GT;
+    case MjOperatorKind::GREATER_THAN_OR_EQUAL: return IrOpcode::GE;
+    case MjOperatorKind::LESS_THAN: return IrOpcode::LT;
+    case MjOperatorKind::LESS_THAN_OR_EQUAL: return IrOpcode::LE;
+    default: return IrBuilder::NONE;
+    }
+}
+
+
+Error IrLowering::lower(Slice<const MjVariable *const> parameters, const MjBlockStatement &body, IrFunction &function) noexcept {
+    for (const MjVariable *parameter : parameters) {
+        _builder.write_variable(parameter->name()->string_id(), _builder.parameter());
+    }
+
+    lower_block(&body);
+
+    if (!_builder.is_terminated()) {
+        _builder.return_value(IrBuilder::NONE);
+    }
+
+    function = _builder.finish();
+    return _error;
+}
+
+
+void IrLowering::lower_statement(const MjStatement *statement) noexcept {
+    MjItemKind kind = statement->item_kind();
+
+    if (kind == MjItemKind::BLOCK_STATEMENT) {
+        lower_block(static_cast<const MjBlockStatement *>(statement));
+    } else if (kind == MjItemKind::IF_STATEMENT) {
+        lower_if(static_cast<const MjIfStatement *>(statement));
+    } else if (kind == MjItemKind::WHILE_LOOP) {
+        lower_while(static_cast<const MjWhileLoop *>(statement));
+    } else if (kind == MjItemKind::RETURN_STATEMENT) {
+        const MjReturnStatement *return_statement = static_cast<const MjReturnStatement *>(statement);
+        u32 value = IrBuilder::NONE;
+
+        if (return_statement->has_return_value()) {
+            const MjTreeExpression *expression = static_cast<const MjTreeExpression *>(return_statement->return_value());
+            value = lower_node(expression->tree(), expression->index());
+        }
+
+        _builder.return_value(value);
+        start_unreachable_block();
+    } else if (kind == MjItemKind::BREAK_STATEMENT || kind == MjItemKind::CONTINUE_STATEMENT) {
+        if (_loops.empty()) {
+            printf("Failed to lower statement! '%s' outside of a loop\n", kind == MjItemKind::BREAK_STATEMENT ? "break" : "continue");
+            _error = Error::FAILURE;
+            return;
+        }
+
+        _builder.jump(kind == MjItemKind::BREAK_STATEMENT ? _loops.back().break_block : _loops.back().continue_block);
+        start_unreachable_block();
+    } else if (kind.is_expression()) {
+        const MjTreeExpression *expression = static_cast<const MjTreeExpression *>(statement);
+        lower_node(expression->tree(), expression->index());
+    } else {
+        printf("Failed to lower statement! Unsupported statement\n");
+        _error = Error::FAILURE;
+    }
+}
+
+
+void IrLowering::lower_block(const MjBlockStatement *block) noexcept {
+    for (const MjStatement *statement : block->statements()) {
+        lower_statement(statement);
+    }
+}
+
+
+void IrLowering::lower_if(const MjIfStatement *statement) noexcept {
+    const MjTreeExpression *condition = static_cast<const MjTreeExpression *>(statement->condition());
+    u32 value = lower_node(condition->tree(), condition->index());
+    u32 then_block = _builder.create_block();
+    u32 merge_block = _builder.create_block();
+    u32 else_block = statement->has_else_statement() ? _builder.create_block() : merge_block;
+
+    _builder.branch(value, then_block, else_block);
+    _builder.seal_block(then_block);
+    _builder.set_block(then_block);
+    lower_statement(statement->then_statement()->body());
+    jump(merge_block);
+
+    if (statement->has_else_statement()) {
+        _builder.seal_block(else_block);
+        _builder.set_block(else_block);
+        lower_statement(statement->else_statement()->body());
+        jump(merge_block);
+    }
+
+    _builder.seal_block(merge_block);
+    _builder.set_block(merge_block);
+}
+
+
+void IrLowering::lower_while(const MjWhileLoop *loop) noexcept {
+    u32 header_block = _builder.create_block();
+    u32 body_block = header_block;
+    u32 exit_block = _builder.create_block();
+
+    // The header is sealed once the back edges of the body and of `continue` statements are known.
+    _builder.jump(header_block);
+    _builder.set_block(header_block);
+
+    if (loop->has_condition()) {
+        const MjTreeExpression *condition = static_cast<const MjTreeExpression *>(loop->condition());
+        u32 value = lower_node(condition->tree(), condition->index());
+        body_block = _builder.create_block();
+        _builder.branch(value, body_block, exit_block);
+        _builder.seal_block(body_block);
+        _builder.set_block(body_block);
+    }
+
+    _loops.push_back({header_block, exit_block});
+
+    if (loop->has_block()) {
+        lower_statement(loop->block());
+    }
+
+    jump(header_block);
+    _loops.pop_back();
+    _builder.seal_block(header_block);
+    _builder.seal_block(exit_block);
+    _builder.set_block(exit_block);
+}
+
+
+void IrLowering::jump(u32 target) noexcept {
+    if (!_builder.is_terminated()) {
+        _builder.jump(target);
+    }
+}
+
+
+void IrLowering::start_unreachable_block() noexcept {
+    u32 block = _builder.create_block();
+    _builder.seal_block(block);
+    _builder.set_block(block);
+}
+
+
+u32 IrLowering::lower_node(const MjExpressionTree &tree, u32 index) noexcept {
+    const MjExpressionNode &node = tree.node(index);
+
+    switch (node.kind) {
+    case MjExpressionNodeKind::VARIABLE:
+    case MjExpressionNodeKind::CONSTANT:
+        return _builder.read_variable(variable_of(tree, index));
+    case MjExpressionNodeKind::LITERAL:
+        return lower_literal(node);
+    case MjExpressionNodeKind::NULL_:
+        return _builder.constant(0);
+    case MjExpressionNodeKind::UNINITIALIZED:
+        return _builder.undefined();
+    case MjExpressionNodeKind::UNARY:
+        return lower_unary(tree, node);
+    case MjExpressionNodeKind::BINARY:
+        return lower_binary(tree, node);
+    case MjExpressionNodeKind::CALL:
+        return lower_call(tree, node);
+    case MjExpressionNodeKind::CAST:
+        return lower_node(tree, node.lhs);
+    default:
+        return error(node, "Unsupported expression");
+    }
+}
+
+
+u32 IrLowering::lower_literal(const MjExpressionNode &node) noexcept {
+    MjTokenKind kind = _tokens.kind(node.token_index);
+    i64 value;
+
+    if (kind == MjTokenKind::TRUE || kind == MjTokenKind::FALSE) {
+        return _builder.constant(kind == MjTokenKind::TRUE);
+    }
+
+    if (!parse_integer(_file.text_of(_tokens.token(node.token_index)), value)) {
+        return error(node, "Unsupported literal");
+    }
+
+    return _builder.constant(value);
+}
+
+
+u32 IrLowering::lower_unary(const MjExpressionTree &tree, const MjExpressionNode &node) noexcept {
+    switch (node.operator_kind) {
+    case MjOperatorKind::NEGATION:
+        return _builder.unary(IrOpcode::NEG, lower_node(tree, node.lhs));
+    case MjOperatorKind::INVERSION:
+        return _builder.unary(IrOpcode::NOT, lower_node(tree, node.lhs));
+    case MjOperatorKind::NOT:
+        return _builder.binary(IrOpcode::EQ, lower_node(tree, node.lhs), _builder.constant(0));
+    case MjOperatorKind::POST_INCREMENT:
+    case MjOperatorKind::POST_DECREMENT: {
+        u32 variable = variable_of(tree, node.lhs);
+
+        if (variable == IrBuilder::NONE) {
+            return error(node, "Expected a variable");
+        }
+
+        u32 value = _builder.read_variable(variable);
+        IrOpcode opcode = node.operator_kind == MjOperatorKind::POST_INCREMENT ? IrOpcode::ADD : IrOpcode::SUB;
+        _builder.write_variable(variable, _builder.binary(opcode, value, _builder.constant(1)));
+        return value;
+    }
+    default:
+        return error(node, "Unsupported operator");
+    }
+}
+
+
+u32 IrLowering::lower_binary(const MjExpressionTree &tree, const MjExpressionNode &node) noexcept {
+    MjOperatorKind kind = node.operator_kind;
+    u32 opcode = opcode_of(kind);
+
+    if (kind == MjOperatorKind::LOGICAL_AND || kind == MjOperatorKind::LOGICAL_OR) {
+        return lower_logical(tree, node);
+    }
+
+    if (kind == MjOperatorKind::LOGICAL_XOR) {
+        u32 lhs = _builder.binary(IrOpcode::NE, lower_node(tree, node.lhs), _builder.constant(0));
+        u32 rhs = _builder.binary(IrOpcode::NE, lower_node(tree, node.rhs), _builder.constant(0));
+        return _builder.binary(IrOpcode::NE, lhs, rhs);
+    }
+
+    if (kind.is_assignment()) {
+        u32 variable = variable_of(tree, node.lhs);
+
+        if (variable == IrBuilder::NONE) {
+            return error(node, "Unsupported assignment target");
+        }
+
+        if (kind != MjOperatorKind::SET && opcode == IrBuilder::NONE) {
+            return error(node, "Unsupported operator");
+        }
+
+        u32 value = lower_node(tree, node.rhs);
+
+        if (kind != MjOperatorKind::SET) {
+            value = _builder.binary(IrOpcode(opcode), _builder.read_variable(variable), value);
+        }
+
+        _builder.write_variable(variable, value);
+        return value;
+    }
+
+    if (opcode == IrBuilder::NONE) {
+        return error(node, "Unsupported operator");
+    }
+
+    u32 lhs = lower_node(tree, node.lhs);
+    u32 rhs = lower_node(tree, node.rhs);
+    return _builder.binary(IrOpcode(opcode), lhs, rhs);
+}
+
+
+u32 IrLowering::lower_call(const MjExpressionTree &tree, const MjExpressionNode &node) noexcept {
+    u32 function_id = variable_of(tree, node.lhs);
+
+    if (function_id == IrBuilder::NONE) {
+        return error(node, "Unsupported callee");
+    }
+
+    std::vector<u32> arguments;
+    arguments.reserve(node.argument_count);
+
+    for (u32 argument = node.rhs; argument != MjExpressionTree::NONE; argument = tree.node(argument).next) {
+        arguments.push_back(lower_node(tree, argument));
+    }
+
+    return _builder.call(function_id, std::move(arguments));
+}
+
+
+u32 IrLowering::lower_logical(const MjExpressionTree &tree, const MjExpressionNode &node) noexcept {
+    bool is_and = node.operator_kind == MjOperatorKind::LOGICAL_AND;
+    u32 result = TEMPORARY | _temporary_count++;
+    u32 lhs = _builder.binary(IrOpcode::NE, lower_node(tree, node.lhs), _builder.constant(0));
+    u32 rhs_block = _builder.create_block();
+    u32 merge_block = _builder.create_block();
+
+    // The result is the left operand unless the right operand is evaluated.
+    _builder.write_variable(result, lhs);
+    _builder.branch(lhs, is_and ? rhs_block : merge_block, is_and ? merge_block : rhs_block);
+    _builder.seal_block(rhs_block);
+    _builder.set_block(rhs_block);
+    _builder.write_variable(result, _builder.binary(IrOpcode::NE, lower_node(tree, node.rhs), _builder.constant(0)));
+    _builder.jump(merge_block);
+    _builder.seal_block(merge_block);
+    _builder.set_block(merge_block);
+    return _builder.read_variable(result);
+}
+
+
+u32 IrLowering::variable_of(const MjExpressionTree &tree, u32 index) const noexcept {
+    MjExpressionNodeKind kind = tree.node(index).kind;
+
+    if (kind != MjExpressionNodeKind::VARIABLE && kind != MjExpressionNodeKind::CONSTANT && kind != MjExpressionNodeKind::FUNCTION) {
+        return IrBuilder::NONE;
+    }
+
+    return _tokens.string_id(tree.node(index).token_index);
+}
+
+
+u32 IrLowering::error(const MjExpressionNode &node, const char *message) noexcept {
+    StringView text = _file.text_of(_tokens.token(node.token_index));
+    printf("Failed to lower expression! %s: '%.*s'\n", message, int(text.size()), text.data());
+    _error = Error::FAILURE;
+    return _builder.undefined();
+}
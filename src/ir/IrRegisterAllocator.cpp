@@ -0,0 +1,193 @@
+#include <ir/IrRegisterAllocator.hpp>
+
+#include <algorithm>
+#include <bit>
+
+
+void IrRegisterAllocator::allocate() noexcept {
+    Slice<const IrInstruction> instructions = _function.instructions();
+    std::vector<Interval> caller_saved_intervals;
+    std::vector<Interval> callee_saved_intervals;
+    compute_intervals();
+    _locations.assign(instructions.size(), {});
+
+    for (u32 value = 0; value < instructions.size(); ++value) {
+        if (instructions[value].opcode.is_terminator() || _starts[value] == IrLocation::NONE) {
+            continue;
+        }
+
+        Interval interval = {value, _starts[value], _ends[value]};
+        (is_live_across_call(value) ? callee_saved_intervals : caller_saved_intervals).push_back(interval);
+    }
+
+    scan(caller_saved_intervals, 0, _caller_saved_count);
+    scan(callee_saved_intervals, _caller_saved_count, _callee_saved_count);
+}
+
+
+void IrRegisterAllocator::compute_intervals() noexcept {
+    Slice<const IrInstruction> instructions = _function.instructions();
+    Slice<const IrBasicBlock> blocks = _function.blocks();
+    u32 word_count = (instructions.size() + 63) / 64;
+    std::vector<std::vector<u64>> live_ins(blocks.size(), std::vector<u64>(word_count));
+    std::vector<std::vector<u64>> live_outs(blocks.size(), std::vector<u64>(word_count));
+    std::vector<u64> live(word_count);
+
+    auto set = [&](u32 value) { live[value / 64] |= u64(1) << value % 64; };
+    auto clear = [&](u32 value) { live[value / 64] &= ~(u64(1) << value % 64); };
+
+    auto for_each_use = [&](const IrInstruction &instruction, auto function) {
+        if (instruction.opcode.has_value_a() && instruction.a != IrInstruction::NONE) {
+            function(instruction.a);
+        }
+
+        if (instruction.opcode.has_value_b()) {
+            function(instruction.b);
+        }
+
+        if (instruction.opcode == IrOpcode::CALL) {
+            for (u32 argument : _function.operands(instruction)) {
+                function(argument);
+            }
+        }
+    };
+
+    // Iterate the liveness of the blocks to a fixed point, in reverse order so that most values
+    // propagate in one pass. The operands of phi instructions are live out of their predecessor.
+    for (bool is_changed = true; is_changed;) {
+        is_changed = false;
+
+        for (u32 block = blocks.size(); block-- > 0;) {
+            const IrBasicBlock &basic_block = blocks[block];
+            std::fill(live.begin(), live.end(), 0);
+
+            for (u32 i = 0; i < basic_block.successor_count(); ++i) {
+                u32 successor = basic_block.successors[i];
+                const IrBasicBlock &successor_block = blocks[successor];
+                Slice<const u32> predecessors = _function.predecessors(successor_block);
+
+                for (u32 word = 0; word < word_count; ++word) {
+                    live[word] |= live_ins[successor][word];
+                }
+
+                for (u32 j = 0; j < predecessors.size(); ++j) {
+                    if (predecessors[j] != block) {
+                        continue;
+                    }
+
+                    for (u32 phi = successor_block.first_instruction; phi < successor_block.first_instruction + successor_block.phi_count; ++phi) {
+                        set(_function.operands(_function.instruction(phi))[j]);
+                    }
+                }
+            }
+
+            live_outs[block] = live;
+
+            for (u32 value = basic_block.end_instruction(); value-- > basic_block.first_instruction;) {
+                clear(value);
+
+                if (value >= basic_block.first_instruction + basic_block.phi_count) {
+                    for_each_use(instructions[value], set);
+                }
+            }
+
+            if (live != live_ins[block]) {
+                live_ins[block] = live;
+                is_changed = true;
+            }
+        }
+    }
+
+    _starts.assign(instructions.size(), IrLocation::NONE);
+    _ends.assign(instructions.size(), 0);
+    _call_positions.clear();
+
+    for (u32 block = 0; block < blocks.size(); ++block) {
+        const IrBasicBlock &basic_block = blocks[block];
+        Slice<const u32> predecessors = _function.predecessors(basic_block);
+
+        for (u32 word = 0; word < word_count; ++word) {
+            for (u64 bits = live_ins[block][word]; bits != 0; bits &= bits - 1) {
+                extend(word * 64 + std::countr_zero(bits), basic_block.first_instruction);
+            }
+
+            for (u64 bits = live_outs[block][word]; bits != 0; bits &= bits - 1) {
+                extend(word * 64 + std::countr_zero(bits), basic_block.terminator());
+            }
+        }
+
+        for (u32 value = basic_block.first_instruction; value < basic_block.end_instruction(); ++value) {
+            const IrInstruction &instruction = instructions[value];
+
+            if (!instruction.opcode.is_terminator()) {
+                extend(value, value);
+            }
+
+            if (instruction.opcode == IrOpcode::CALL) {
+                _call_positions.push_back(value);
+            }
+
+            if (instruction.opcode == IrOpcode::PHI) {
+                for (u32 j = 0; j < predecessors.size(); ++j) {
+                    extend(value, blocks[predecessors[j]].terminator());
+                }
+            } else {
+                for_each_use(instruction, [&](u32 operand) { extend(operand, value); });
+            }
+        }
+    }
+}
+
+
+bool IrRegisterAllocator::is_live_across_call(u32 value) const noexcept {
+    auto it = std::upper_bound(_call_positions.begin(), _call_positions.end(), _starts[value]);
+    return it != _call_positions.end() && *it < _ends[value];
+}
+
+
+void IrRegisterAllocator::scan(std::vector<Interval> &intervals, u32 first_register, u32 register_count) noexcept {
+    std::vector<Interval> active; // Sorted by end
+    std::vector<u32> free_registers;
+
+    for (u32 i = register_count; i-- > 0;) {
+        free_registers.push_back(first_register + i);
+    }
+
+    std::stable_sort(intervals.begin(), intervals.end(), [](const Interval &a, const Interval &b) {
+        return a.start < b.start;
+    });
+
+    auto activate = [&](Interval interval) {
+        auto it = std::upper_bound(active.begin(), active.end(), interval, [](const Interval &a, const Interval &b) {
+            return a.end < b.end;
+        });
+
+        active.insert(it, interval);
+    };
+
+    auto spill = [&](u32 value) {
+        _locations[value] = {_stack_slot_count++, true};
+    };
+
+    for (Interval interval : intervals) {
+        while (!active.empty() && active.front().end < interval.start) {
+            free_registers.push_back(_locations[active.front().value].index);
+            active.erase(active.begin());
+        }
+
+        if (!free_registers.empty()) {
+            _locations[interval.value] = {free_registers.back(), false};
+            _used_registers |= u32(1) << free_registers.back();
+            free_registers.pop_back();
+            activate(interval);
+        } else if (!active.empty() && active.back().end > interval.end) {
+            Interval spilled = active.back();
+            active.pop_back();
+            _locations[interval.value] = _locations[spilled.value];
+            spill(spilled.value);
+            activate(interval);
+        } else {
+            spill(interval.value);
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#include <mj/MjAssembler.hpp>
+#include <elf/ElfObjectWriter.hpp>
+#include <x64/X64Emitter.hpp>
+
+#include <cstdio>
+
+
+Error MjAssembler::assemble(const std::filesystem::path &path) noexcept {
+    ElfObjectWriter writer;
+    X64Encoder encoder;
+
+    // The symbols of the writer are in the order of declaration.
+    for (const std::string &name : _names) {
+        writer.add_symbol(StringView(reinterpret_cast<const u8 *>(name.data()), name.size()));
+    }
+
+    for (const Function &function : _functions) {
+        auto it = _symbols.find(function.id);
+
+        if (it == _symbols.end()) {
+            printf("Failed to assemble function! Function %u is not declared.\n", function.id);
+            return Error::FAILURE;
+        }
+
+        u32 offset = encoder.size();
+
+        if (X64Emitter(*function.body, _symbols, encoder).emit() != Error::SUCCESS) {
+            return Error::FAILURE;
+        }
+
+        writer.define_symbol(it->second, offset, encoder.size() - offset);
+    }
+
+    for (const X64Relocation &relocation : encoder.relocations()) {
+        writer.add_relocation(relocation.offset, relocation.symbol, ElfObjectWriter::R_X86_64_PLT32, relocation.addend);
+    }
+
+    writer.set_text(encoder.code());
+    return writer.write(path);
+}
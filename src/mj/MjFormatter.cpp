@@ -9,34 +9,50 @@ std::string MjFormatter::format_file(const MjSourceFile &file, const MjFormatter
 
 
 void MjFormatter::print_tokens() noexcept {
-    MjToken token = &_file.tokens().front();
-    MjToken end = &_file.tokens().back();
+    MjTokenView tokens(_file);
     MjTokenKind last_token_kind = MjTokenKind::NONE;
+    u32 i = 0;
 
     // Handle this case outside the loop since this condition can only be true on the first token.
-    if (token.kind() == MjTokenKind::INDENT) {
-        write(' ', _config.indent_width * token.indent());
-        last_token_kind = token.kind();
-        token += token.size();
+    if (tokens.kind(0) == MjTokenKind::INDENT) {
+        write(' ', _config.indent_width * tokens.payload(0));
+        last_token_kind = MjTokenKind::INDENT;
+        i += 1;
     }
 
-    while (token < end) {
-        if (token.kind().has_whitespace(last_token_kind)) {
+    for (; i < tokens.size(); ++i) {
+        MjTokenKind kind = tokens.kind(i);
+
+        // Subtokens annotate the text of the preceding token.
+        if (kind.encoding() == MjTokenEncoding::SUBTOKEN) {
+            continue;
+        }
+
+        if (kind.has_whitespace(last_token_kind)) {
             write(' ');
         }
 
-        if (token.kind() == MjTokenKind::INDENT) {
+        if (kind == MjTokenKind::INDENT) {
             write('\n');
-            write(' ', _config.indent_width * token.indent());
-        } else if (token.kind() == MjTokenKind::WHITESPACE) {
-            write(' ', token.spaces());
-        } else if (token.has_builtin_text()) {
-            write(token.builtin_text());
+            write(' ', _config.indent_width * tokens.payload(i));
+        } else if (kind == MjTokenKind::WHITESPACE) {
+            write(' ', tokens.payload(i));
+        } else if (kind.has_builtin_text()) {
+            write(kind.builtin_text());
+        } else if (kind == MjTokenKind::LINE_COMMENT || kind == MjTokenKind::FORMATTED_LINE_COMMENT) {
+            write("// ");
+            write(_file.text_of(tokens.token(i)));
+        } else if (kind == MjTokenKind::BLOCK_COMMENT || kind == MjTokenKind::FORMATTED_BLOCK_COMMENT) {
+            write("/// ");
+            write(_file.text_of(tokens.token(i)));
+        } else if (kind == MjTokenKind::RAW_STRING_LITERAL) {
+            write('\'');
+            write(_file.text_of(tokens.token(i)));
+            write('\'');
         } else {
-            write(_file.text_of(token));
+            write(_file.text_of(tokens.token(i)));
         }
 
-        last_token_kind = token.kind();
-        token += token.size();
+        last_token_kind = kind;
     }
 }
@@ -0,0 +1,85 @@
+#include <mj/MjItemArena.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+
+
+void MjItemArena::deallocate(void *data, u32 size) noexcept {
+    if (size > MAX_SMALL_SIZE) {
+        auto it = std::find(_large_objects.begin(), _large_objects.end(), data);
+
+        if (it != _large_objects.end()) {
+            *it = _large_objects.back();
+            _large_objects.pop_back();
+            std::free(data);
+        }
+
+        return;
+    }
+
+    SizeClass &size_class = _classes[SIZE_CLASS_TABLE.classes[(size + ALIGNMENT - 1) / ALIGNMENT]];
+    FreeSlot *slot = static_cast<FreeSlot *>(data);
+    slot->next = size_class.free_slots;
+    size_class.free_slots = slot;
+}
+
+
+void MjItemArena::clear() noexcept {
+
+    // Destroy the objects in reverse order of creation, as a stack of scopes would.
+    for (u32 i = _destructors.size(); i-- > 0;) {
+        if (_destructors[i].object != nullptr) {
+            _destructors[i].destroy(_destructors[i].object);
+        }
+    }
+
+    _destructors.clear();
+
+    for (void *object : _large_objects) {
+        std::free(object);
+    }
+
+    _large_objects.clear();
+
+    while (_pages != nullptr) {
+        Page *next = _pages->next;
+        std::free(_pages);
+        _pages = next;
+    }
+
+    for (SizeClass &size_class : _classes) {
+        size_class = SizeClass();
+    }
+
+    _page_count = 0;
+}
+
+
+void MjItemArena::allocate_page(SizeClass &size_class, u32 slot_size) noexcept {
+    Page *page = static_cast<Page *>(std::aligned_alloc(ALIGNMENT, PAGE_SIZE));
+
+    if (page == nullptr) {
+        std::abort();
+    }
+
+    page->next = _pages;
+    _pages = page;
+    _page_count += 1;
+
+    // The slots fill the page after the header. The remainder is too small for another slot.
+    u8 *data = reinterpret_cast<u8 *>(page) + PAGE_HEADER_SIZE;
+    size_class.cursor = data;
+    size_class.end = data + (PAGE_SIZE - PAGE_HEADER_SIZE) / slot_size * slot_size;
+}
+
+
+void *MjItemArena::allocate_large(u32 size) noexcept {
+    void *data = std::aligned_alloc(ALIGNMENT, (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+
+    if (data == nullptr) {
+        std::abort();
+    }
+
+    _large_objects.push_back(data);
+    return data;
+}
@@ -0,0 +1,61 @@
+#include <mj/MjItemManager.hpp>
+
+#include <atomic>
+
+
+// Manager IDs are never reused, so a thread's cached arena cannot outlive its manager unnoticed.
+static std::atomic<u64> next_manager_id = 1;
+
+
+thread_local MjItemManager::ArenaCache MjItemManager::_arena_cache;
+
+
+MjItemManager::MjItemManager() noexcept :
+    _id(next_manager_id++)
+{}
+
+
+u64 MjItemManager::reserved_size() noexcept {
+    std::lock_guard lock(_arenas_mutex);
+    u64 size = 0;
+
+    for (ThreadArena &thread_arena : _arenas) {
+        size += thread_arena.arena->reserved_size();
+    }
+
+    return size;
+}
+
+
+void MjItemManager::clear(u32 module_id) noexcept {
+    std::lock_guard lock(_arenas_mutex);
+
+    // The arenas are kept, since threads may still cache them.
+    for (ThreadArena &thread_arena : _arenas) {
+        if (thread_arena.module_id == module_id) {
+            thread_arena.arena->clear();
+        }
+    }
+}
+
+
+MjItemArena &MjItemManager::attach_arena(u32 module_id) noexcept {
+    std::lock_guard lock(_arenas_mutex);
+    std::thread::id thread_id = std::this_thread::get_id();
+    MjItemArena *arena = nullptr;
+
+    for (ThreadArena &thread_arena : _arenas) {
+        if (thread_arena.module_id == module_id && thread_arena.thread_id == thread_id) {
+            arena = thread_arena.arena.get();
+            break;
+        }
+    }
+
+    if (arena == nullptr) {
+        _arenas.push_back({module_id, thread_id, std::make_unique<MjItemArena>()});
+        arena = _arenas.back().arena.get();
+    }
+
+    _arena_cache = {_id, module_id, arena};
+    return *arena;
+}
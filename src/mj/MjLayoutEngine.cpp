@@ -0,0 +1,383 @@
+#include <mj/MjLayoutEngine.hpp>
+#include <mj/MjSourceManager.hpp>
+#include <mj/ast/MjArrayType.hpp>
+#include <mj/ast/MjBitfieldType.hpp>
+#include <mj/ast/MjConstantType.hpp>
+#include <mj/ast/MjEnumerationType.hpp>
+#include <mj/ast/MjMember.hpp>
+#include <mj/ast/MjSafeType.hpp>
+#include <mj/ast/MjTypeAlias.hpp>
+#include <mj/ast/MjTypeName.hpp>
+
+#include <algorithm>
+#include <bit>
+
+
+/// Return the offset rounded up to a multiple of the alignment, which is a power of two.
+static u32 align_up(u32 offset, u32 alignment) noexcept {
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+
+/// Parse a decimal, hexadecimal (`0x`) or binary (`0b`) integer with optional `_` separators.
+static bool parse_integer(StringView text, u32 &value) noexcept {
+    const u8 *data = text.data();
+    u32 size = text.size();
+    u32 base = 10;
+    u32 i = 0;
+
+    if (size > 2 && data[0] == '0' && (data[1] == 'x' || data[1] == 'b')) {
+        base = data[1] == 'x' ? 16 : 2;
+        i = 2;
+    }
+
+    u64 result = 0;
+    bool has_digits = false;
+
+    for (; i < size; ++i) {
+        u8 ch = data[i];
+        u32 digit;
+
+        if (ch == '_') {
+            continue;
+        } else if (ch >= '0' && ch <= '9') {
+            digit = ch - '0';
+        } else if (ch >= 'a' && ch <= 'f') {
+            digit = ch - 'a' + 10;
+        } else if (ch >= 'A' && ch <= 'F') {
+            digit = ch - 'A' + 10;
+        } else {
+            return false;
+        }
+
+        if (digit >= base) {
+            return false;
+        }
+
+        result = result * base + digit;
+        has_digits = true;
+
+        if (result > 0xFFFFFFFFu) {
+            return false;
+        }
+    }
+
+    value = result;
+    return has_digits;
+}
+
+
+u32 MjType::declared_size() const noexcept {
+    if (is_structure_type() || is_class_type() || is_union_type()) {
+        u32 size = 0;
+
+        for (const MjMember *member : members()) {
+            size = is_union_type() ? std::max(size, member->type()->size()) : size + member->type()->size();
+        }
+
+        return size;
+    } else if (is_bitfield_type()) {
+        return static_cast<const MjBitfieldType *>(this)->base_type()->size();
+    } else if (is_enumeration_type()) {
+        return static_cast<const MjEnumerationType *>(this)->index_type()->size();
+    } else if (is_type_alias()) {
+        const MjTypeAlias *type_alias = static_cast<const MjTypeAlias *>(this);
+        return type_alias->is_resolved() ? type_alias->base_type()->size() : 0;
+    } else if (is_const_qualified()) {
+        return static_cast<const MjConstantType *>(this)->base_type()->size();
+    } else if (is_safe_qualified()) {
+        return static_cast<const MjSafeType *>(this)->non_constant_type()->size();
+    } else if (is_array_type()) {
+        const MjArrayType *array_type = static_cast<const MjArrayType *>(this);
+        return array_type->base_type()->size() * array_type->array_size();
+    } else if (is_pointer_type() || is_function_type() || is_method_type()) {
+        return MjLayoutEngine::POINTER_SIZE;
+    } else if (is_slice_type()) {
+        return 2 * MjLayoutEngine::POINTER_SIZE;
+    }
+
+    return _size;
+}
+
+
+Error MjLayoutEngine::layout(MjType *type) noexcept {
+    if (type->_layout_state == MjLayoutState::COMPLETE) {
+        return Error::SUCCESS;
+    }
+
+    if (type->_layout_state == MjLayoutState::INVALID) {
+        return Error::FAILURE;
+    }
+
+    if (type->_layout_state == MjLayoutState::IN_PROGRESS) {
+        error(type, "Recursive layout");
+        return Error::FAILURE;
+    }
+
+    type->_layout_state = MjLayoutState::IN_PROGRESS;
+    _stack.push_back(type);
+    Error result = Error::SUCCESS;
+
+    if (type->is_structure_type() || type->is_class_type()) {
+        result = layout_aggregate(type);
+    } else if (type->is_union_type()) {
+        result = layout_union(type);
+    } else if (type->is_bitfield_type()) {
+        result = layout_as(type, static_cast<MjBitfieldType *>(type)->base_type());
+    } else if (type->is_enumeration_type()) {
+        result = layout_as(type, static_cast<MjEnumerationType *>(type)->index_type());
+    } else if (type->is_type_alias()) {
+        MjTypeAlias *type_alias = static_cast<MjTypeAlias *>(type);
+
+        if (type_alias->is_resolved()) {
+            result = layout_as(type, type_alias->base_type());
+        } else {
+            error(type, "Unresolved type name");
+            result = Error::FAILURE;
+        }
+    } else if (type->is_const_qualified()) {
+        result = layout_as(type, static_cast<MjConstantType *>(type)->base_type());
+    } else if (type->is_safe_qualified()) {
+        result = layout_as(type, static_cast<MjSafeType *>(type)->constant_type());
+    } else if (type->is_array_type()) {
+        MjArrayType *array_type = static_cast<MjArrayType *>(type);
+        result = layout(array_type->base_type());
+
+        if (result == Error::SUCCESS) {
+            type->_size = array_type->base_type()->_size * array_type->array_size();
+            type->_alignment = array_type->base_type()->_alignment;
+        }
+    } else if (type->is_pointer_type() || type->is_function_type() || type->is_method_type()) {
+        type->_size = POINTER_SIZE;
+        type->_alignment = POINTER_SIZE;
+    } else if (type->is_slice_type()) {
+        type->_size = 2 * POINTER_SIZE;
+        type->_alignment = POINTER_SIZE;
+    } else {
+        // Builtin types are created with their size. They are aligned to their size by default.
+        type->_alignment = std::max(type->_alignment, std::bit_ceil(std::max(type->_size, 1u)));
+    }
+
+    _stack.pop_back();
+    type->_layout_state = result == Error::SUCCESS ? MjLayoutState::COMPLETE : MjLayoutState::INVALID;
+    return result;
+}
+
+
+Error MjLayoutEngine::layout_aggregate(MjType *type) noexcept {
+    std::vector<Placement> placements;
+    bool is_pinned = false;
+
+    for (MjMember *member : type->members()) {
+        MjType *member_type = member->type();
+
+        if (layout(member_type) != Error::SUCCESS) {
+            return Error::FAILURE;
+        }
+
+        Placement placement = {member, member_type->_size, member_type->_alignment, NONE};
+        u32 value;
+        Error result = Error::SUCCESS;
+
+        if (find_annotation(member->annotations(), "alignment", value, result)) {
+            if (result != Error::SUCCESS || !std::has_single_bit(value)) {
+                error(type, "Member alignment is not a power of two");
+                return Error::FAILURE;
+            }
+
+            placement.alignment = std::max(placement.alignment, value);
+        }
+
+        if (find_annotation(member->annotations(), "offset", value, result)) {
+            if (result != Error::SUCCESS) {
+                error(type, "Invalid member offset");
+                return Error::FAILURE;
+            }
+
+            placement.offset = value;
+            is_pinned = true;
+        }
+
+        placements.push_back(placement);
+    }
+
+    u32 used_size;
+
+    if (place(type, placements, used_size) != Error::SUCCESS || apply_type_annotations(type, used_size) != Error::SUCCESS) {
+        return Error::FAILURE;
+    }
+
+    if (!_reorder_members || is_pinned || placements.size() < 2) {
+        return Error::SUCCESS;
+    }
+
+    // Members of decreasing alignment need no padding between them, since the size of a type is a
+    // multiple of its alignment. Keep the declaration order unless the type becomes smaller.
+    u32 declared_size = type->_size;
+    std::vector<Placement> reordered = placements;
+
+    std::stable_sort(reordered.begin(), reordered.end(), [](const Placement &a, const Placement &b) {
+        return a.alignment > b.alignment;
+    });
+
+    place(type, reordered, used_size);
+    apply_type_annotations(type, used_size);
+
+    if (type->_size < declared_size) {
+        _savings.push_back({type, declared_size, type->_size});
+        return Error::SUCCESS;
+    }
+
+    place(type, placements, used_size);
+    return apply_type_annotations(type, used_size);
+}
+
+
+Error MjLayoutEngine::place(MjType *type, const std::vector<Placement> &placements, u32 &used_size) noexcept {
+    u32 offset = 0;
+    u32 alignment = 1;
+    u32 padding = 0;
+
+    for (const Placement &placement : placements) {
+        u32 member_offset = align_up(offset, placement.alignment);
+
+        if (placement.offset != NONE) {
+            if (placement.offset < offset || placement.offset % placement.alignment != 0) {
+                error(type, "Member offset overlaps the previous member or is misaligned");
+                return Error::FAILURE;
+            }
+
+            member_offset = placement.offset;
+        }
+
+        padding += member_offset - offset;
+        placement.member->_offset = member_offset;
+        offset = member_offset + placement.size;
+        alignment = std::max(alignment, placement.alignment);
+    }
+
+    type->_alignment = alignment;
+    type->_padding = padding;
+    used_size = offset;
+    return Error::SUCCESS;
+}
+
+
+Error MjLayoutEngine::layout_union(MjType *type) noexcept {
+    u32 size = 0;
+    u32 alignment = 1;
+
+    for (MjMember *member : type->members()) {
+        if (layout(member->type()) != Error::SUCCESS) {
+            return Error::FAILURE;
+        }
+
+        member->_offset = 0;
+        size = std::max(size, member->type()->_size);
+        alignment = std::max(alignment, member->type()->_alignment);
+    }
+
+    type->_alignment = alignment;
+    type->_padding = 0;
+    return apply_type_annotations(type, size);
+}
+
+
+Error MjLayoutEngine::layout_as(MjType *type, MjType *base_type) noexcept {
+    if (layout(base_type) != Error::SUCCESS) {
+        return Error::FAILURE;
+    }
+
+    type->_size = base_type->_size;
+    type->_alignment = base_type->_alignment;
+    type->_padding = base_type->_padding;
+    return Error::SUCCESS;
+}
+
+
+Error MjLayoutEngine::apply_type_annotations(MjType *type, u32 used_size) noexcept {
+    u32 value;
+    Error result = Error::SUCCESS;
+
+    if (find_annotation(type->annotations(), "alignment", value, result)) {
+        if (result != Error::SUCCESS || !std::has_single_bit(value)) {
+            error(type, "Type alignment is not a power of two");
+            return Error::FAILURE;
+        }
+
+        type->_alignment = std::max(type->_alignment, value);
+    }
+
+    u32 size = align_up(used_size, type->_alignment);
+
+    if (find_annotation(type->annotations(), "size", value, result)) {
+        if (result != Error::SUCCESS || value < size || value % type->_alignment != 0) {
+            error(type, "Type size is smaller than its members or is not a multiple of its alignment");
+            return Error::FAILURE;
+        }
+
+        size = value;
+    }
+
+    type->_padding += size - used_size;
+    type->_size = size;
+    return Error::SUCCESS;
+}
+
+
+bool MjLayoutEngine::find_annotation(Slice<MjAnnotation *const> annotations, StringView name, u32 &value, Error &error) const noexcept {
+    for (const MjAnnotation *annotation : annotations) {
+        const MjSourceFile *source = _sources.source_of(annotation);
+
+        if (!source->text_of(*annotation->name()).is_equal(name)) {
+            continue;
+        }
+
+        const MjAnnotationArgumentList &argument_list = annotation->argument_list();
+
+        if (argument_list.size() != 1 || !parse_integer(source->text_of(argument_list[0]), value)) {
+            error = Error::FAILURE;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+
+void MjLayoutEngine::error(const MjType *type, const char *message) const noexcept {
+    printf("Failed to lay out type! %s: ", message);
+    const char *separator = "";
+
+    // A resolved type alias is followed by the type it names.
+    for (u32 i = 0; i < _stack.size(); ++i) {
+        if (_stack[i]->is_type_alias() && static_cast<const MjTypeAlias *>(_stack[i])->is_resolved()) {
+            continue;
+        }
+
+        StringView name = _stack[i]->has_name() ? _stack[i]->name()->text() : StringView("<anonymous>");
+        printf("%s'%.*s'", separator, name.size(), name.data());
+        separator = " -> ";
+    }
+
+    if (_stack.empty() || _stack.back() != type) {
+        StringView name = type->has_name() ? type->name()->text() : StringView("<anonymous>");
+        printf("%s'%.*s'", separator, name.size(), name.data());
+    }
+
+    printf("\n");
+}
+
+
+void MjLayoutEngine::print_savings() const noexcept {
+    u64 saved_size = 0;
+
+    for (const Saving &saving : _savings) {
+        StringView name = saving.type->has_name() ? saving.type->name()->text() : StringView("<anonymous>");
+        printf("%.*s: %u -> %u bytes (%u saved)\n", name.size(), name.data(), saving.declared_size, saving.size, saving.declared_size - saving.size);
+        saved_size += saving.declared_size - saving.size;
+    }
+
+    printf("Reordered %zu types, saving %lu bytes\n", _savings.size(), saved_size);
+}
@@ -1,152 +1,300 @@
 #include <mj/MjLexer.hpp>
 #include <format/ASCII/Ascii.hpp>
+#include <format/ASCII/AsciiScanner.hpp>
 #include <format/UTF-8/Utf8.hpp>
 
-#include <fstream>
+#include <algorithm>
 
 
+/// A perfect hash table of the reserved names, which are the keywords, the type qualifiers, and
+/// the named literals, generated at compile time.
+///
+/// A word of up to `MAX_SIZE` characters is packed little endian into two 64 bit blocks, which
+/// are both the key of the table and its hash input. The multiplier is searched for at compile
+/// time until no two keywords share a slot, so a lookup is one multiply and one compare.
+class MjKeywordTable {
+public:
+    static constexpr u32 MAX_SIZE = 16;
+private:
+    static constexpr u32 SLOT_BITS = 7;
+    static constexpr u32 SLOT_COUNT = 1u << SLOT_BITS;
+
+    struct Slot {
+        u64 blocks[2] = {};
+        MjTokenKind token_kind = MjTokenKind::NONE;
+    };
 
-template<class MjKeywordKind>
-struct MjKeywordKindValues {
+    Slot _slots[SLOT_COUNT];
+    u64 _multiplier = 0;
+public:
 
-    static constexpr MjKeywordKind NONE{0};
 
-    /// These keywords are safe to use as variable or function names, but they
-    /// may not be used as generic function names.
-    ///
-    /// bitfield
-    /// enum
-    /// impl
-    /// type
-    /// union
-    /// unit
-    /// where
-    static constexpr MjKeywordKind LOWERCASE{1};
-
-    /// for
-    /// if
-    /// match
-    /// until
-    /// while
-    static constexpr MjKeywordKind MIXEDCASE{3};
-
-    /// These keywords are not safe to use as variable or function names.
-    ///
-    /// and
-    /// break
-    /// const
-    /// continue
-    /// fail
-    /// false
-    /// mutable
-    /// null
-    /// or
-    /// return
-    /// safe
-    /// true
-    /// uninitialized
-    /// volatile
-    /// yield
-    static constexpr MjKeywordKind PURE{3};
-
-    /// These keywords are followed by an open brace '{'.
     ///
-    /// These keywords are safe to use as variable or function names.
+    /// Constructors
     ///
-    /// do
-    static constexpr MjKeywordKind MIXEDCASE{3};
 
-    /// These keywords are followed by a type name, a variable name, or an open brace '{'.
-    ///
-    /// If they are followed by the keywords 'as' or 'is', then those keywords
-    /// must be followed by type expressions. If neither 'as' nor 'is' is
-    /// followed by a type expression, then they are not keyword operators, and
-    /// the potential match is a keyword.
-    ///
-    /// These keywords are safe to use as variable or function names.
-    ///
-    /// asm
-    /// class
-    /// else
-    /// import
-    /// interface
-    /// struct
-    /// union
-    static constexpr MjKeywordKind SCOPED{3};
-
-    /// These keywords are binary operators that require a type as the right
-    /// hand operand. In situations where they may be confused as unit
-    /// expressions, the following token will determine their type. If followed
-    /// by a type expression, they are keywords, otherwise they are subject to
-    /// default parsing rules.
+
+    constexpr
+    MjKeywordTable() noexcept {
+        for (u64 seed = 1; _multiplier == 0; ++seed) {
+            u64 multiplier = seed * 0x9E3779B97F4A7C15u | 1;
+            bool is_used[SLOT_COUNT] = {};
+            bool is_perfect = true;
+
+            for (u8 id = MjTokenKind::AND; is_perfect && id <= MjTokenKind::UNINITIALIZED; ++id) {
+                u64 blocks[2] = {};
+                pack(MjTokenKind(id).builtin_text(), blocks);
+                u32 slot_index = hash(blocks, multiplier);
+                is_perfect = !is_used[slot_index];
+                is_used[slot_index] = true;
+            }
+
+            if (is_perfect) {
+                _multiplier = multiplier;
+            }
+        }
+
+        for (u8 id = MjTokenKind::AND; id <= MjTokenKind::UNINITIALIZED; ++id) {
+            u64 blocks[2] = {};
+            pack(MjTokenKind(id).builtin_text(), blocks);
+            Slot &slot = _slots[hash(blocks, _multiplier)];
+            slot.blocks[0] = blocks[0];
+            slot.blocks[1] = blocks[1];
+            slot.token_kind = MjTokenKind(id);
+        }
+    }
+
+
     ///
-    /// These keywords are safe to use as variable or function names.
+    /// Methods
     ///
-    /// as
-    /// is
-    static constexpr MjKeywordKind BINARY_TYPE_OPERATOR{3};
-};
 
 
-struct MjKeywordKind : public Enum<u8>, public MjKeywordKindValues<MjKeywordKind> {
+    /// Append a character to the packed blocks of a word.
+    static
+    constexpr
+    void append(u64 blocks[2], u32 index, u8 ch) noexcept {
+        blocks[index >> 3] |= u64(ch) << ((index & 7) * 8);
+    }
+
 
+    /// Find the keyword of the packed blocks of a word of at most `MAX_SIZE` characters.
     constexpr
-    explicit
-    MjKeywordKind(u8 id) noexcept : Enum(id) {}
-};
+    MjTokenKind find(const u64 blocks[2]) const noexcept {
+        const Slot &slot = _slots[hash(blocks, _multiplier)];
+
+        if (slot.blocks[0] == blocks[0] && slot.blocks[1] == blocks[1]) {
+            return slot.token_kind;
+        }
+
+        return MjTokenKind::NONE;
+    }
+
 
+private:
+
+
+    static
+    constexpr
+    void pack(StringView text, u64 blocks[2]) noexcept {
+        for (u32 i = 0; i < text.size(); ++i) {
+            append(blocks, i, text[i]);
+        }
+    }
 
 
-struct MjKeywordInfo {
-    const StringView text;
-    MjTokenKind token_kind;
-    MjKeywordKind keyword_kind;
+    static
+    constexpr
+    u32 hash(const u64 blocks[2], u64 multiplier) noexcept {
+        return ((blocks[0] ^ blocks[1] * 0xFF51AFD7ED558CCDu) * multiplier) >> (64 - SLOT_BITS);
+    }
 };
 
 
-MjSourceFile *MjLexer::parse_file(std::filesystem::path file_path, bool emit_subtokens) noexcept {
-    std::vector<u8> data(load_file_data(file_path));
+static constexpr MjKeywordTable KEYWORD_TABLE{};
+
 
-    if (data.empty()) {
+MjSourceFile *MjLexer::parse_file(std::filesystem::path file_path, bool emit_subtokens, bool records_line_starts) noexcept {
+    MjSourceText text;
+
+    if (text.load(file_path).is_failure()) {
         return nullptr;
     }
 
-    MjSourceFile *file = new MjSourceFile(file_path, data.size());
+    return parse_text(file_path, std::move(text), emit_subtokens, records_line_starts);
+}
+
+
+MjSourceFile *MjLexer::parse_text(
+    std::filesystem::path file_path,
+    MjSourceText &&text,
+    bool emit_subtokens,
+    bool records_line_starts
+) noexcept {
+    MjSourceFile *file = new MjSourceFile(file_path, std::move(text));
+    MjLexer lexer(*file, emit_subtokens, records_line_starts);
 
-    for (MjTokenKind token_kind : MjTokenKind::keywords()) {
-        file->append_string_token(token_kind, token_kind.builtin_text());
+    if (lexer.parse().is_failure()) {
+        delete file;
+        return nullptr;
     }
 
-    MjLexer(*file, emit_subtokens).parse();
+    lexer.print_errors();
     return file;
 }
 
 
-std::vector<u8> MjLexer::load_file_data(std::filesystem::path file_path) noexcept {
-    std::basic_ifstream<u8> file_stream(file_path, std::ios::binary | std::ios::ate);
+Error MjLexer::parse_edit(MjSourceFile &file, const MjTextEdit &edit, bool emit_subtokens) noexcept {
+    if (!file.has_line_starts() || !file.text().is_loaded() || edit.end() > file.text().size()) {
+        printf("Failed to apply edit! '%s'\n", file.path().c_str());
+        return Error::FAILURE;
+    }
+
+    // Resume one line start before the one containing the edit, since the tokens before a line
+    // start may have looked ahead into the text after it.
+    u32 line_start_index = file.find_line_start(edit.offset);
+
+    if (line_start_index > 0) {
+        line_start_index -= 1;
+    }
+
+    MjLexerCheckpoint resume = file.line_starts()[line_start_index];
+    file.replace_text(edit);
+
+    if (resume.text_offset > edit.offset) {
+
+        // The edit is before the first line start, so the whole file is lexed again.
+        file.clear_tokens();
+        return MjLexer(file, emit_subtokens, true).parse();
+    }
+
+    // Lex the edited lines into a file sharing the text, after the last token byte before them
+    // which the lexer may inspect. They replace the old lines in place once the state matches.
+    MjSourceFile lines(file.path(), file.text().view());
+    lines.record_string_tokens();
+    lines.tokens().push_back(resume.last_token_byte);
+
+    MjLexerCheckpoint start = resume;
+    start.token_offset = 1;
+    start.line_count = 0;
+
+    MjLexer lexer(lines, emit_subtokens, true);
+    lexer.restore(start);
+    lines.append_line_start(start);
+
+    const std::vector<MjLexerCheckpoint> &old_line_starts = file.line_starts();
+    i64 text_delta = edit.size_delta();
+    u32 old_index = line_start_index + 1;
+
+    while (!lexer.is_eof() && lexer._error.is_success()) {
+        if (lexer.record_line_start()) {
+            const MjLexerCheckpoint &line_start = lines.line_starts().back();
+
+            // Skip the old line starts inside or before the edit, or behind the lexer.
+            while (
+                old_index < old_line_starts.size() && (
+                    old_line_starts[old_index].text_offset <= edit.end() ||
+                    old_line_starts[old_index].text_offset + text_delta < line_start.text_offset
+                )
+            ) {
+                old_index += 1;
+            }
+
+            if (old_index == old_line_starts.size()) {
+                break;
+            }
+
+            const MjLexerCheckpoint &old_line_start = old_line_starts[old_index];
+
+            if (old_line_start.text_offset + text_delta == line_start.text_offset && line_start.has_same_state(old_line_start)) {
+
+                // The state re-synchronized, so the old lines from here on are unchanged.
+                lines.truncate(lines.line_starts().size() - 1);
+                return file.replace_lines(lines, line_start_index, old_index, text_delta);
+            }
+        }
+
+        lexer.parse_token();
+    }
+
+    // No unchanged line start is left to re-synchronize with, so lex to the end of the file.
+    while (!lexer.is_eof() && lexer._error.is_success()) {
+        lexer.record_line_start();
+        lexer.parse_token();
+    }
+
+    if (lexer._error.is_failure()) {
+        return lexer._error;
+    }
+
+    return file.replace_lines(lines, line_start_index, old_line_starts.size(), text_delta);
+}
+
+
+Error MjLexer::parse_chunk(MjSourceFile &chunk, u32 begin, u32 end, bool emit_subtokens) noexcept {
+    return MjLexer(chunk, emit_subtokens, true).parse_range(begin, end);
+}
+
+
+Error MjLexer::merge_chunk(MjSourceFile &file, const MjSourceFile &chunk, bool &is_merged, bool emit_subtokens) noexcept {
+    is_merged = true;
+    const std::vector<MjLexerCheckpoint> &chunk_line_starts = chunk.line_starts();
 
-    if (!file_stream.is_open()) {
-        printf("Failed to open file! '%s'\n", file_path.c_str());
-        return {};
+    if (!file.has_line_starts() || !chunk.has_line_starts()) {
+        return Error::FAILURE;
     }
 
-    std::streamsize file_size = file_stream.tellg();
+    // Look for a line start past the start of the chunk which the file was lexed up to.
+    u32 chunk_index = 0;
+
+    for (u32 i = file.find_line_start(chunk_line_starts[0].text_offset); i < file.line_starts().size(); ++i) {
+        const MjLexerCheckpoint &line_start = file.line_starts()[i];
 
-    if (file_size < 0) {
-        printf("Failed to get file size! '%s'\n", file_path.c_str());
-        return {};
+        while (chunk_index < chunk_line_starts.size() && chunk_line_starts[chunk_index].text_offset < line_start.text_offset) {
+            chunk_index += 1;
+        }
+
+        if (chunk_index == chunk_line_starts.size()) {
+            break;
+        }
+
+        if (chunk_line_starts[chunk_index].text_offset == line_start.text_offset && line_start.has_same_state(chunk_line_starts[chunk_index])) {
+            file.truncate(i);
+            return file.append_chunk(chunk, chunk_index);
+        }
     }
 
-    std::vector<u8> data(file_size + 1);
-    file_stream.seekg(0, std::ios::beg);
+    // The chunk started in a different state, so lex on serially until the states agree again or
+    // the chunk is passed, in which case the next chunk overlaps with the file instead.
+    MjLexer lexer(file, emit_subtokens, true);
+    lexer.restore(file.line_starts().back());
+    lexer._recorded_line_count = file.line_count();
+    chunk_index = 0;
+
+    while (!lexer.is_eof() && lexer._error.is_success()) {
+        if (lexer.record_line_start()) {
+            const MjLexerCheckpoint &line_start = file.line_starts().back();
+
+            while (chunk_index < chunk_line_starts.size() && chunk_line_starts[chunk_index].text_offset < line_start.text_offset) {
+                chunk_index += 1;
+            }
+
+            if (chunk_index == chunk_line_starts.size()) {
+                is_merged = false;
+                return lexer._error;
+            }
+
+            if (chunk_line_starts[chunk_index].text_offset == line_start.text_offset && line_start.has_same_state(chunk_line_starts[chunk_index])) {
+                file.truncate(file.line_starts().size() - 1);
+                return file.append_chunk(chunk, chunk_index);
+            }
+        }
 
-    if (!file_stream.read(data.data(), file_size)) {
-        printf("Failed to read file data! '%s'\n", file_path.c_str());
-        return {};
+        lexer.parse_token();
     }
 
-    data.back() = 0;
-    return data;
+    is_merged = false;
+    return lexer._error;
 }
 
 
@@ -158,64 +306,149 @@ std::vector<u8> MjLexer::load_file_data(std::filesystem::path file_path) noexcep
 Error MjLexer::parse() noexcept {
     _line_index = 0;
     _line_indent = 0;
-    _ch = _data.data();
+    _ch = _file.text().data();
+    parse_indent();
+
+    while (!is_eof() && _error.is_success()) {
+        if (_records_line_starts) {
+            record_line_start();
+        }
+
+        parse_token();
+    }
+
+    return _error;
+}
+
+
+Error MjLexer::parse_range(u32 begin, u32 end) noexcept {
+    _ch = _file.text().data() + begin;
     parse_indent();
+    u32 overlap_line_count = 0;
+
+    while (!is_eof() && _error.is_success()) {
+        if (record_line_start() && _file.line_starts().back().text_offset >= end) {
+            overlap_line_count += 1;
+
+            if (overlap_line_count > CHUNK_OVERLAP_LINE_COUNT) {
+                break;
+            }
+        }
 
-    while (!is_eof()) {
         parse_token();
     }
 
-    return Error::SUCCESS;
+    return _error;
 }
 
 
-Error MjLexer::parse_token(MjTokenKind token_kind) noexcept {
-    if (parse_token().is_failure() || token().kind() != token_kind) {
-        return Error::FAILURE;
+bool MjLexer::record_line_start() noexcept {
+    if (_recorded_line_count == _file.line_count()) {
+        return false;
     }
 
-    return Error::SUCCESS;
+    _recorded_line_count = _file.line_count();
+    _file.append_line_start(save());
+    return true;
 }
 
 
-Error MjLexer::parse_token() noexcept {
+namespace {
 
-    // Consume any leading whitespace.
-    parse_whitespace();
 
-    //
-    if (!_has_leading_whitespace && token().kind() != MjTokenKind::OPEN_CURLY_BRACE) {
-        return Error::FAILURE;
+/// Find the reserved name of a word, or return `NONE` if it is not one.
+MjTokenKind find_reserved_name(const u8 *begin, const u8 *end) noexcept {
+    u32 size = end - begin;
+
+    if (size > MjKeywordTable::MAX_SIZE) {
+        return MjTokenKind::NONE;
     }
 
-    // Numeric literals have priority over several operator/name patterns, so they are tested first.
-    if (parse_numeric_literal().is_success()) {
-        return Error::SUCCESS;
+    u64 blocks[2] = {};
+
+    for (u32 i = 0; i < size; ++i) {
+        MjKeywordTable::append(blocks, i, begin[i]);
+    }
+
+    return KEYWORD_TABLE.find(blocks);
+}
+
+
+/// Return true if the character can start an operand, so that an operator attached to both sides
+/// is an infix operator.
+bool is_operand_start(u8 ch) noexcept {
+    return Ascii::is_alnum(ch) || ch == '_' || ch == '(' || ch == '[' || ch == '"' || ch == '\'' || ch == '$';
+}
+
+
+/// Scan up to `count` digits which satisfy the predicate, and return true if there were `count`.
+template<class Predicate>
+bool scan_digits(const u8 *&ch, u32 count, Predicate is_digit) noexcept {
+    for (; count > 0 && is_digit(*ch); --count) {
+        ch += 1;
     }
 
-    // Check if the token is an identifier.
-    if (parse_identifier().is_success()) {
+    return count == 0;
+}
+
+
+/// Scan the digits of a numeric literal, which may be delimited by single underscores, and
+/// return true if there was at least one digit.
+template<class Predicate>
+bool scan_delimited_digits(const u8 *&ch, Predicate is_digit) noexcept {
+    if (!is_digit(*ch)) {
+        return false;
+    }
+
+    for (ch += 1; is_digit(*ch) || (*ch == '_' && is_digit(ch[1])); ++ch);
+    return true;
+}
+
+
+}
+
+
+Error MjLexer::parse_token() noexcept {
+    parse_whitespace();
+
+    if (is_end_of_line()) {
+        parse_newline();
         return Error::SUCCESS;
     }
 
-    // Check if the token is an operator.
-    StringView error_message;
+    Error error = Error::SUCCESS;
+    u8 ch = *_ch;
+
+    if (Ascii::is_lower(ch) || ch == '_') {
+        error = parse_identifier();
+    } else if (Ascii::is_upper(ch)) {
+        error = parse_type_name();
+    } else if (Ascii::is_digit(ch)) {
+        error = parse_numeric_literal();
+    } else {
+        error = parse_operator();
+    }
+
+    _has_leading_whitespace = false;
+    return error;
+}
+
+
+Error MjLexer::parse_operator() noexcept {
+    const u8 *token_data = _ch;
     MjTokenKind token_kind = MjTokenKind::NONE;
 
     switch (*_ch) {
     case '@': {
-        token_kind = MjTokenKind::AT;
-        push_state(MjLexerState::IN_ANNOTATION);
-        break;
+        _ch += 1;
+        _file.append_token(MjTokenKind::AT);
+        return parse_annotation_name();
     } case ';': {
         token_kind = MjTokenKind::SEMICOLON;
         break;
     } case ',': {
         token_kind = MjTokenKind::COMMA;
         break;
-    } case '$': {
-        token_kind = MjTokenKind::DOLLAR_SIGN;
-        break;
     } case '#': {
         token_kind = MjTokenKind::HASH;
         break;
@@ -225,19 +458,27 @@ Error MjLexer::parse_token() noexcept {
     } case '~': {
         token_kind = MjTokenKind::INVERT;
         break;
+    } case '$': {
+        _ch += 1;
+        _file.append_token(MjTokenKind::DOLLAR_SIGN);
+
+        // A subshell is closed by its parenthesis, and a shell statement by the end of the line.
+        if (*_ch == '(') {
+            _ch += 1;
+            _file.append_token(MjTokenKind::OPEN_PARENTHESIS);
+            push_state(MjLexerState::IN_SUBSHELL);
+        } else if ((*_ch == ' ' || is_end_of_line()) && !_state.in_shell()) {
+            push_state(MjLexerState::IN_SHELL);
+        }
+
+        return Error::SUCCESS;
     } case '[': {
         token_kind = MjTokenKind::OPEN_SQUARE_BRACKET;
         push_state(MjLexerState::IN_SQUARE_BRACKETS);
         break;
     } case ']': {
         token_kind = MjTokenKind::CLOSE_SQUARE_BRACKET;
-
-        if (_state.in_square_brackets()) {
-            pop_state();
-        } else {
-            error_message = "Unmatched square bracket!";
-        }
-
+        close_bracket(MjLexerState::IN_SQUARE_BRACKETS, "Unmatched square bracket!");
         break;
     } case '(': {
         token_kind = MjTokenKind::OPEN_PARENTHESIS;
@@ -245,15 +486,7 @@ Error MjLexer::parse_token() noexcept {
         break;
     } case ')': {
         token_kind = MjTokenKind::CLOSE_PARENTHESIS;
-
-        if (_state.in_parentheses()) {
-            pop_state();
-        } else if (_state.in_subshell()) {
-            pop_state();
-        } else {
-            error_message = "Unmatched parenthesis!";
-        }
-
+        close_bracket(_state.in_subshell() ? MjLexerState::IN_SUBSHELL : MjLexerState::IN_PARENTHESES, "Unmatched parenthesis!");
         break;
     } case '{': {
         token_kind = MjTokenKind::OPEN_CURLY_BRACE;
@@ -261,144 +494,94 @@ Error MjLexer::parse_token() noexcept {
         break;
     } case '}': {
         token_kind = MjTokenKind::CLOSE_CURLY_BRACE;
-
-        if (_state.in_curly_braces()) {
-            pop_state();
-        } else {
-            error_message = "Unmatched curly brace!";
-        }
-
+        close_bracket(MjLexerState::IN_CURLY_BRACES, "Unmatched curly brace!");
         break;
     } case '?': {
-        if (_state.in_type_expression()) {
+        if (follows_operand()) {
             token_kind = MjTokenKind::FALLIBLE_TYPE_MODIFIER;
         }
 
         break;
     } case '!': {
-        if (_state.in_type_expression()) {
-            token_kind = MjTokenKind::NO_RETURN_TYPE_MODIFIER;
-        } else if (_ch[1] == '=') {
+        if (_ch[1] == '=') {
             token_kind = MjTokenKind::NOT_EQUAL;
+        } else if (follows_operand()) {
+            token_kind = MjTokenKind::NO_RETURN_TYPE_MODIFIER;
         }
 
         break;
     } case '*': {
-        if (_state.in_type_expression()) {
-            token_kind = MjTokenKind::POINTER_TYPE_MODIFIER;
-        } else if (_ch[1] == '=') {
+        if (_ch[1] == '=') {
             token_kind = MjTokenKind::MULTIPLY_SET;
+        } else if (follows_operand()) {
+            token_kind = is_operand_start(_ch[1]) ? MjTokenKind::MULTIPLY : MjTokenKind::POINTER_TYPE_MODIFIER;
         } else {
-            if (_has_trailing_whitespace) {
-                token_kind = MjTokenKind::MULTIPLY;
-            } else {
-                token_kind = MjTokenKind::DEREFERENCE;
-            }
+            token_kind = _ch[1] == ' ' ? MjTokenKind::MULTIPLY : MjTokenKind::DEREFERENCE;
         }
 
         break;
-    } case '/': {
-        if (_ch[1] == '/') {
-            _ch += 2;
-
-            if (_skip_comments) {
-                for (; *_ch >= ' '; ++_ch);
-                return Error::SUCCESS;
-            }
-
-            if (*_ch == '/') {
-                token_kind = MjTokenKind::BLOCK_COMMENT;
-                _ch += 1;
-            } else {
-                token_kind = MjTokenKind::LINE_COMMENT;
-            }
-
-            if (*_ch == ' ') {
-                _ch += 1;
-            }
-
-            const u8 *token_data = _ch;
-            for (; *_ch >= ' '; ++_ch) {
-                if (*_ch == '`') {
-                    token_kind += 1; // Get the formatted version of the token kind.
-                    for (; *_ch >= ' '; ++_ch);
-                }
-            }
-
-            u32 token_size = _ch - token_data;
-            //for (; _ch[token_size] == ' '; --token_size);
-            _file.append_inline_token(token_kind, {token_data, token_size});
-            return Error::SUCCESS;
+    } case '&': {
+        if (_ch[1] == '&') {
+            token_kind = MjTokenKind::LOGICAL_AND;
+        } else if (_ch[1] == '=') {
+            token_kind = MjTokenKind::BITWISE_AND_SET;
+        } else if (follows_operand()) {
+            token_kind = is_operand_start(_ch[1]) ? MjTokenKind::BITWISE_AND : MjTokenKind::REFERENCE_TYPE_MODIFIER;
+        } else {
+            token_kind = _ch[1] == ' ' ? MjTokenKind::BITWISE_AND : MjTokenKind::REFERENCE;
         }
 
-        if (_ch[1] == '=') {
-            token_kind = MjTokenKind::DIVIDE_SET;
+        break;
+    } case '|': {
+        if (_ch[1] == '|') {
+            token_kind = MjTokenKind::LOGICAL_OR;
+        } else if (_ch[1] == '=') {
+            token_kind = MjTokenKind::BITWISE_OR_SET;
         } else {
-            token_kind = MjTokenKind::DIVIDE;
+            token_kind = MjTokenKind::BITWISE_OR;
         }
 
+        break;
+    } case '^': {
+        token_kind = _ch[1] == '=' ? MjTokenKind::BITWISE_XOR_SET : MjTokenKind::BITWISE_XOR;
         break;
     } case '%': {
-        token_kind = MjTokenKind::REMAINDER;
-
-        if (_ch[1] == '=') {
-            token_kind += 1;
-        }
-
-        if (_ch[1] == '=') {
-            token_kind = MjTokenKind::REMAINDER_SET;
-        } else {
-            token_kind = MjTokenKind::REMAINDER;
+        token_kind = _ch[1] == '=' ? MjTokenKind::REMAINDER_SET : MjTokenKind::REMAINDER;
+        break;
+    } case '/': {
+        if (_ch[1] == '/') {
+            return parse_comment();
         }
 
+        token_kind = _ch[1] == '=' ? MjTokenKind::DIVIDE_SET : MjTokenKind::DIVIDE;
         break;
     } case '+': {
         if (_ch[1] == '=') {
             token_kind = MjTokenKind::PLUS_SET;
-        } else if (parse_numeric_literal().is_success()) {
-            return Error::SUCCESS;
+        } else if (_ch[1] == '+') {
+            token_kind = MjTokenKind::INCREMENT;
+        } else if (Ascii::is_digit(_ch[1]) && !follows_operand()) {
+            return parse_numeric_literal();
         } else {
             token_kind = MjTokenKind::PLUS;
         }
 
         break;
     } case '-': {
+        bool is_shell_option = (_state.in_shell() || _state.in_subshell()) && !follows_operand();
+
         if (_ch[1] == '=') {
             token_kind = MjTokenKind::MINUS_SET;
-        } else if (parse_numeric_literal().is_success()) {
-            return Error::SUCCESS;
-        } else if (_state.in_shell() || _state.in_subshell()) {
-            if (parse_shell_option().is_success()) {
-                return Error::SUCCESS;
-            }
-        } else {
+        } else if (_ch[1] == '-') {
+            token_kind = is_shell_option && Ascii::is_alnum(_ch[2]) ? MjTokenKind::SHELL_LONG_OPTION : MjTokenKind::DECREMENT;
+        } else if (is_shell_option && Ascii::is_alnum(_ch[1])) {
+            token_kind = MjTokenKind::SHELL_SHORT_OPTION;
+        } else if (Ascii::is_digit(_ch[1]) && !follows_operand()) {
+            return parse_numeric_literal();
+        } else if (follows_operand() || _ch[1] == ' ') {
             token_kind = MjTokenKind::MINUS;
-        }
-
-        break;
-    } case '&': {
-        if (_state.in_type_expression()) {
-            token_kind = MjTokenKind::REFERENCE_TYPE_MODIFIER;
-        } else if (_ch[1] == '=') {
-            token_kind = MjTokenKind::BITWISE_AND_SET;
-        } else {
-            token_kind = MjTokenKind::BITWISE_AND;
-        }
-
-        break;
-    } case '^': {
-        if (_ch[1] == '=') {
-            token_kind = MjTokenKind::BITWISE_XOR_SET;
-        } else {
-            token_kind = MjTokenKind::BITWISE_XOR;
-        }
-
-        break;
-    } case '|': {
-        if (_ch[1] == '=') {
-            token_kind = MjTokenKind::BITWISE_OR_SET;
         } else {
-            token_kind = MjTokenKind::BITWISE_OR;
+            token_kind = MjTokenKind::NEGATE;
         }
 
         break;
@@ -413,46 +596,26 @@ Error MjLexer::parse_token() noexcept {
 
         break;
     } case ':': {
-        if (_ch[1] == ':') {
-            token_kind = MjTokenKind::SCOPE;
-        } else {
-            token_kind = MjTokenKind::COLON;
-        }
-
+        token_kind = _ch[1] == ':' ? MjTokenKind::SCOPE : MjTokenKind::COLON;
         break;
     } case '<': {
         if (_ch[1] == '<') {
-            if (_ch[2] == '=') {
-                token_kind = MjTokenKind::LEFT_SHIFT_SET;
-            } else {
-                token_kind = MjTokenKind::LEFT_SHIFT;
-            }
+            token_kind = _ch[2] == '=' ? MjTokenKind::LEFT_SHIFT_SET : MjTokenKind::LEFT_SHIFT;
         } else if (_ch[1] == '=') {
-            if (_ch[2] == '>') {
-                token_kind = MjTokenKind::SPACESHIP;
-            } else {
-                token_kind = MjTokenKind::LESS_THAN_OR_EQUAL;
-            }
+            token_kind = _ch[2] == '>' ? MjTokenKind::SPACESHIP : MjTokenKind::LESS_THAN_OR_EQUAL;
         } else {
             token_kind = MjTokenKind::LESS_THAN;
         }
 
         break;
     } case '>': {
-        if (token().kind() == MjTokenKind::INDENT || token().kind() == MjTokenKind::CLOSE_ANGLE_BRACKET) {
-            token_kind = MjTokenKind::CLOSE_ANGLE_BRACKET;
 
-            if (_state.in_angle_brackets()) {
-                pop_state();
-            } else {
-                error_message = "Unmatched angle bracket!";
-            }
+        // A template argument list is closed by an attached angle bracket, as in `Vector<u32>`.
+        if (_state.in_angle_brackets() && !_has_leading_whitespace) {
+            token_kind = MjTokenKind::CLOSE_ANGLE_BRACKET;
+            pop_state();
         } else if (_ch[1] == '>') {
-            if (_ch[2] == '=') {
-                token_kind = MjTokenKind::RIGHT_SHIFT_SET;
-            } else {
-                token_kind = MjTokenKind::RIGHT_SHIFT;
-            }
+            token_kind = _ch[2] == '=' ? MjTokenKind::RIGHT_SHIFT_SET : MjTokenKind::RIGHT_SHIFT;
         } else if (_ch[1] == '=') {
             token_kind = MjTokenKind::GREATER_THAN_OR_EQUAL;
         } else {
@@ -461,1066 +624,298 @@ Error MjLexer::parse_token() noexcept {
 
         break;
     } case '\'': {
-        token_kind = MjTokenKind::RAW_STRING_LITERAL;
-        _ch += 1;
-        const u8 *token_data = _ch;
-        u32 token_size = 0;
-
-        for (; *_ch >= ' '; ++_ch) {
-            if (*_ch == '\'') {
-                token_size = _ch - token_data;
-            }
-        }
-
-        if (token_size == 0) {
-            error("Unterminated string literal!");
-            return Error::FAILURE;
-        }
-
-        _ch -= (_ch - token_data) - token_size;
-        _file.append_inline_token(token_kind, {token_data, token_size - 1});
-        return Error::SUCCESS;
+        return parse_raw_string_literal();
     } case '"': {
-        return parse_interpolated_string_literal();
-    } default: {
-        _file.append_inline_token(MjTokenKind::INVALID, {_ch, UTF_8::size(*_ch)});
-        error("Invalid UTF-8 character!");
-        return Error::FAILURE;
-    }
-    }
-
-    if (MjTokenKind::whitespace(token_kind, token_kind)) {
-        // check for continuing operator tokens.
-    }
-
-    if (token_kind.requires_leading_whitespace()) {
-        // is binary operator or nested prefix operator
-    }
-
-    if (token_kind.requires_trailing_whitespace()) {
-        // is binary operator or nested postfix operator
-    }
-
-    _file.append_token(token_kind);
-    return Error::SUCCESS;
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-Error MjLexer::parse_type_expression() noexcept {
-
-    // Parse the base type.
-    while (parse_token().is_success() && token().kind().is_type_qualifier());
-
-    if (parse_token(MjTokenKind::TYPE_NAME).is_failure()) {
-        return Error::FAILURE;
-    }
-
-    // Parse the type modifiers.
-    while (parse_token().is_success()) {
-        switch (token().kind()) {
-        case MjTokenKind::POINTER_TYPE_MODIFIER: {
-            break;
-        } case MjTokenKind::REFERENCE_TYPE_MODIFIER: {
-            break;
-        } case MjTokenKind::OPEN_ANGLE_BRACKET: {
-            break;
-        } case MjTokenKind::OPEN_SQUARE_BRACKET: {
-            break;
-        } case MjTokenKind::OPEN_PARENTHESIS: {
-            break;
-        } case MjTokenKind::COLON: {
-            if (_state.in_type_cast()) {
-                pop_state();
-            }
-            // fall-through
-        } default: {
-            pop_state();
-            return Error::SUCCESS;
-        }
-        }
-    }
-
-    return Error::SUCCESS;
-}
-
-
-Error MjLexer::parse_shell_token() noexcept {
-    parse_whitespace();
-
-    if (!_has_leading_whitespace && token().kind() != MjTokenKind::OPEN_CURLY_BRACE) {
-        return Error::FAILURE;
-    }
-
-    StringView token_text;
-    StringView error_message;
-    MjTokenKind token_kind = MjTokenKind::NONE;
-
-    switch (*_ch) {
-    case '-': {
-        if (_ch[1] == '=') {
-            token_kind = MjTokenKind::MINUS_SET;
-            break;
-        }
-
-        if (parse_numeric_literal().is_success()) {
-            return Error::SUCCESS;
-        }
-
-        if (_state.in_shell() || _state.in_subshell()) {
-            if (parse_shell_option().is_success()) {
-                return Error::SUCCESS;
-            }
-        }
-
-        token_kind = MjTokenKind::MINUS;
-        break;
-    } case '(': {
-    } case '$': {
-    }
-    }
-
-
-
-
-    while (parse_token().is_success() && token().kind() != MjTokenKind::INDENT) {
-        if (_state.in_subshell()) {
-            if (token().kind() != MjTokenKind::INDENT) {
-                error("Expected ')' to close subshell!");
-                return Error::FAILURE;
-            }
-
-            pop_state();
-            break;
-        }
-    }
-
-    if (_state.in_subshell()) {
-        if (token().kind() == MjTokenKind::INDENT) {
-            error("Expected ')' to close subshell!");
-            return Error::FAILURE;
-        }
-
-        pop_state();
-    }
-
-    return Error::SUCCESS;
-}
-
-
-Error MjLexer::parse_shell_option() noexcept {
-    return Error::FAILURE;
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-Error MjLexer::parse_identifier() noexcept {
-    StringView token_text{_ch, 1};
-
-    if (parse_type_name().is_success()) {
+        return parse_string_literal();
+    } case '\t': {
+        for (_ch += 1; *_ch == '\t'; ++_ch);
+        _file.append_inline_token(MjTokenKind::INVALID, {token_data, u32(_ch - token_data)});
+        error(token_data, _ch - token_data, "Invalid indentation! Tabs are not allowed.");
         return Error::SUCCESS;
     }
-
-    // Parse a lowercase word
-    while (Ascii::is_lower(*_ch)) {
-        _ch += 1;
-    }
-
-    // Check for word boundary.
-    if (!(Ascii::is_upper(*_ch) || Ascii::is_digit(*_ch) || *_ch == '_')) {
-        token_text.set_end(_ch);
-
-        if (parse_keyword().is_success()) {
-            return Error::SUCCESS;
-        }
-    }
-
-
-    // Check for word boundary.
-    if (!(Ascii::is_upper(*_ch) || Ascii::is_digit(*_ch) || *_ch == '_')) {
-        token_text.set_end(_ch);
-
-        // Early exit if module name.
-        if (*_ch == ':' && _ch[1] == ':') {
-            _ch += 2;
-            _file.append_string_token(MjTokenKind::TYPE_NAME, token_text);
-            _file.append_token(MjTokenKind::SCOPE);
-            return Error::SUCCESS;
-        }
-
-        if (parse_keyword().is_success()) {
-            return Error::SUCCESS;
-        }
     }
 
+    if (token_kind == MjTokenKind::NONE) {
+        u32 token_size = std::max<u32>(UTF_8::size(*_ch), 1);
 
-    ///
-    /// Check for user defined identifier
-    ///
-
-
-    if (Ascii::is_upper(*_ch)) {
-        _ch += 1;
-
-        while (Ascii::is_upper(*_ch) || Ascii::is_digit(*_ch) || *_ch == '_') {
-            _ch += 1;
-        }
-
-        if (Ascii::is_lower(*_ch)) {
-        }
-
-        token_kind = token_size > 1 ? MjTokenKind::CONSTANT_NAME : MjTokenKind::TYPE_NAME;
-    } else if (Ascii::is_lower(*_ch)) {
-        _ch += 1;
-
-        while (Ascii::is_lower(*_ch) || Ascii::is_digit(*_ch) || *_ch == '_') {
-            _ch += 1;
-        }
-
-        StringView token_text{token_data, _ch - token_data};
-
-        if (*_ch == '(') {
-            trailing_token_kind = MjTokenKind::OPEN_PARENTHESIS;
-            push_state(MjLexerState::IN_PARENTHESES);
-        } else if (*_ch == '<') {
-            trailing_token_kind = MjTokenKind::OPEN_ANGLE_BRACKET;
-            push_state(MjLexerState::IN_ANGLE_BRACKETS);
-        } else if (*_ch == '&') {
-            trailing_token_kind = MjTokenKind::FUNCTION_REFERENCE;
-        }
-
-        if (trailing_token_kind != MjTokenKind::NONE) {
-            _file.append_string_token(MjTokenKind::FUNCTION_NAME, token_text);
-            _file.append_token(trailing_token_kind);
-            _ch += 1;
-        } else {
-            _file.append_string_token(MjTokenKind::VARIABLE_NAME, token_text);
+        // Stop at the end of the text, since a truncated character may be followed by the sentinel.
+        for (u32 i = 1; i < token_size; ++i) {
+            if (!_ch[i]) {
+                token_size = i;
+                break;
+            }
         }
-    } else {
-    }
-
-    return Error::SUCCESS;
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
 
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-Error MjLexer::parse_constant_name() noexcept {
-    const u8 *token_data = _ch;
-    _ch -= 1;
-
-    do {
-        for (_ch += 1; Ascii::is_upper(*_ch) || Ascii::is_digit(*_ch); _ch += 1);
-    } while (*_ch == '_');
-
-    if (Ascii::is_lower(*_ch)) {
-    }
-
-    MjTokenKind token_kind = _ch - token_data > 1 ? MjTokenKind::CONSTANT_NAME : MjTokenKind::TYPE_NAME;
-
-
-    ///
-    /// Module Name - [0-9A-Za-z][0-9A-Za-z+-]*(?=::)
-    ///
-
-    StringView token_text = {token_data, _ch - token_data};
-
-    // (?=::)
-    if (*_ch == ':' && _ch[1] == ':') {
-        _ch += 2;
-        _file.append_string_token(MjTokenKind::TYPE_NAME, token_text);
-        _file.append_token(MjTokenKind::SCOPE);
+        _ch += token_size;
+        _file.append_inline_token(MjTokenKind::INVALID, {token_data, token_size});
+        error(token_data, token_size, "Invalid character!");
         return Error::SUCCESS;
     }
 
-
-    _file.append_string_token(MjTokenKind::VARIABLE_NAME, token_text);
-    return Error::SUCCESS;
-}
-
-
-Error MjLexer::parse_variable_name() noexcept {
-    const u8 *token_data = _ch;
-
-    do {
-        for (_ch += 1; Ascii::is_lower(*_ch) || Ascii::is_digit(*_ch); _ch += 1);
-    } while (*_ch == '_');
-
-    if (Ascii::is_upper(*_ch) || *_ch == '_') {
-        return Error::FAILURE;
-    }
-
-    MjTokenKind token_kind = MjTokenKind::FUNCTION_NAME;
-    MjTokenKind trailing_token_kind = MjTokenKind::NONE;
-
-    if (*_ch == '(') {
-        trailing_token_kind = MjTokenKind::OPEN_PARENTHESIS;
-    } else if (*_ch == '<') {
-        trailing_token_kind = MjTokenKind::OPEN_ANGLE_BRACKET;
-    } else if (*_ch == '&') {
-        trailing_token_kind = MjTokenKind::FUNCTION_REFERENCE;
-    } else if (*_ch == ':' && _ch[1] == ':') {
-        _ch += 2;
-        token_kind = MjTokenKind::TYPE_NAME;
-        trailing_token_kind = MjTokenKind::SCOPE;
-    } else {
-        token_kind = MjTokenKind::VARIABLE_NAME;
-    }
-
-    _file.append_string_token(token_kind, {token_data, _ch - token_data});
-
-    if (trailing_token_kind != MjTokenKind::NONE) {
-        _ch += 1;
-        _file.append_token(trailing_token_kind);
-    }
-
-    return Error::SUCCESS;
-}
-
-
-
-
-
-
-
-
-
-
-
-
-Error MjLexer::parse_annotation() noexcept {
-    if (*_ch != '@') {
-        return Error::FAILURE;
-    }
-
-    _ch += 1;
-    _file.append_token(MjTokenKind::AT);
-
-    if (parse_annotation_name().is_failure()) {
-        return Error::FAILURE;
-    }
-
-    if (*_ch != '(') {
-        return Error::SUCCESS;
-    }
-
-    _ch += 1;
-    _file.append_token(MjTokenKind::OPEN_PARENTHESIS);
-
-    while (parse_token().is_success()) {
-        if (token().kind() == MjTokenKind::CLOSE_PARENTHESIS) {
-            return Error::SUCCESS;
-        }
-    }
-
-    return Error::FAILURE;
-}
-
-
-Error MjLexer::parse_annotation_name() noexcept {
-    const u8 *token_data = _ch;
-
-    while (Ascii::is_lower(*_ch) || Ascii::is_digit(*_ch) || *_ch == '_') {
-        _ch += 1;
-    }
-
-    // Check for word boundary.
-    if (Ascii::is_upper(*_ch)) {
-        return Error::FAILURE;
-    }
-
-    _file.append_string_token(MjTokenKind::ANNOTATION_NAME, {token_data, _ch - token_data});
+    _ch += token_kind.size();
+    _file.append_token(token_kind);
     return Error::SUCCESS;
 }
 
 
+Error MjLexer::parse_comment() noexcept {
+    MjTokenKind token_kind = MjTokenKind::LINE_COMMENT;
+    _ch += 2;
 
-
-
-
-
-
-
-
-
-
-
-
-Error MjLexer::parse_keyword() noexcept {
-    const u8 *token_data = _ch;
-    u32 blocks[4];
-    MjTokenKind token_kind = MjTokenKind::NONE;
-
-    while (Ascii::is_lower(*_ch)) {
-        u32 block_index = (_ch - token_data) >> 2;
-
-        if (block_index == 4) {
-            _ch = token_data;
-            return Error::FAILURE;
-        }
-
-        blocks[block_index] = (blocks[block_index] << 8) | *_ch;
+    if (*_ch == '/') {
+        token_kind = MjTokenKind::BLOCK_COMMENT;
         _ch += 1;
-    }
-
-
-
-    StringView token_text{token_data, _ch - token_data};
-
-    // Check for word boundary.
-    if (Ascii::is_alnum(*_ch) || *_ch == '_') {
-        
-    }
-
-
-
-    u16 id = _file.insert_string(token_text);
-
-    if (id < 32) {
-        // keyword
-        token_kind = MjTokenKind::keyword(id);
-    } else {
-        _file.append_string_token(token_kind, id);
-    }
-
-
-
-
-
-
-
-
-
-    // Test priority names
-
-    if (*_ch == '(') {
-        _file.append_string_token(MjTokenKind::FUNCTION_NAME, token_text);
-        _file.append_token(MjTokenKind::OPEN_PARENTHESIS);
-        push_state(MjLexerState::IN_PARENTHESES);
-        return Error::SUCCESS;
-    }
-
-    if (*_ch == '&') {
-        _file.append_string_token(MjTokenKind::FUNCTION_NAME, token_text);
-        _file.append_token(MjTokenKind::FUNCTION_REFERENCE);
-        return Error::SUCCESS;
-    }
-
-    if (*_ch == '<') {
-
-        // These keywords are safe to use as variable or function names, but they
-        // may not be used as generic function names.
-        static
-        const MjKeywordInfo KEYWORDS[] = {
-            {"bitfield", MjTokenKind::BITFIELD},
-            {"enum", MjTokenKind::ENUM},
-            {"impl", MjTokenKind::IMPL},
-            {"type", MjTokenKind::TYPE},
-            {"union", MjTokenKind::UNION},
-            {"unit", MjTokenKind::UNIT},
-            {"where", MjTokenKind::WHERE},
-        };
-
-        MjTokenKind token_kind = MjTokenKind::FUNCTION_NAME;
-
-        for (const MjKeywordInfo &info : KEYWORDS) {
-            if (token_text == info.text) {
-                token_kind = info.token_kind;
-                break;
-            }
-        }
-
-        if (token_kind == MjTokenKind::FUNCTION_NAME) {
-            _file.append_string_token(token_kind, token_text);
-        } else {
-            _file.append_token(token_kind);
-        }
-
-        _file.append_token(MjTokenKind::OPEN_ANGLE_BRACKET);
-        push_state(MjLexerState::IN_ANGLE_BRACKETS);
-
-        if (token_kind == MjTokenKind::UNIT) {
-            parse_unit_expression();
-        }
-
-        return Error::SUCCESS;
-    }
-
-    if (*_ch == ' ' && _ch[1] == '(') {
-        static
-        const MjKeywordInfo KEYWORDS[] = {
-            {"for", MjTokenKind::FOR},
-            {"if", MjTokenKind::IF},
-            {"match", MjTokenKind::MATCH},
-            {"until", MjTokenKind::UNTIL},
-            {"while", MjTokenKind::WHILE},
-        };
-
-        MjTokenKind token_kind = MjTokenKind::VARIABLE_NAME;
-
-        for (const MjKeywordInfo &info : KEYWORDS) {
-            if (token_text == info.text) {
-                token_kind = info.token_kind;
-                break;
-            }
-        }
-
-        if (token_kind == MjTokenKind::VARIABLE_NAME) {
-            _file.append_string_token(token_kind, token_text);
-        } else {
-            _file.append_token(token_kind);
-        }
+    }
 
+    if (*_ch == ' ') {
         _ch += 1;
-        _file.append_token(MjTokenKind::OPEN_PARENTHESIS);
-        push_state(MjLexerState::IN_PARENTHESES);
-        return Error::SUCCESS;
     }
 
-    if (*_ch == '&') {
-        trailing_token_kind = MjTokenKind::FUNCTION_REFERENCE;
-    } else if (Ascii::is_upper(*_ch) || Ascii::is_digit(*_ch)) {
-
-        // These keywords are not safe to use as variable or function names.
-        static
-        const MjKeywordInfo PURE_KEYWORDS[] = {
-            {"break", MjTokenKind::BREAK},
-            {"bool", MjTokenKind::TYPE_NAME},
-            {"const", MjTokenKind::CONST},
-            {"continue", MjTokenKind::CONTINUE},
-            {"fail", MjTokenKind::FAIL},
-            {"false", MjTokenKind::CONSTANT_NAME},
-            {"mutable", MjTokenKind::MUTABLE},
-            {"null", MjTokenKind::CONSTANT_NAME},
-            {"return", MjTokenKind::RETURN},
-            {"safe", MjTokenKind::SAFE},
-            {"true", MjTokenKind::CONSTANT_NAME},
-            {"uninitialized", MjTokenKind::CONSTANT_NAME},
-            {"void", MjTokenKind::TYPE_NAME},
-            {"volatile", MjTokenKind::VOLATILE},
-            {"yield", MjTokenKind::YIELD},
-        };
-
-        for (const MjKeywordInfo &info : PURE_KEYWORDS) {
-            if (token_text == info.text) {
-                return Error::SUCCESS;
-            }
+    const u8 *token_data = _ch;
+
+    for (; !is_end_of_line(); ++_ch) {
+        if (*_ch == '`') {
+            token_kind = token_kind == MjTokenKind::LINE_COMMENT ? MjTokenKind::FORMATTED_LINE_COMMENT : MjTokenKind::FORMATTED_BLOCK_COMMENT;
         }
+    }
 
-        // These keywords are followed by an open brace '{'.
-        //
-        // These keywords are safe to use as variable or function names.
-        static
-        const MjKeywordInfo BRACED_KEYWORDS[] = {
-            {"do", MjTokenKind::DO},
-        };
-
-
-        // These keywords are followed by a type name, a variable name, or an open brace '{'.
-        //
-        // If they are followed by the keywords 'as' or 'is', then those keywords
-        // must be followed by type expressions. If neither 'as' nor 'is' is
-        // followed by a type expression, then they are not keyword operators, and
-        // the potential match is a keyword.
-        //
-        // These keywords are safe to use as variable or function names.
-        static
-        const MjKeywordInfo SCOPED_KEYWORDS[] = {
-            {"asm", MjTokenKind::ASM},
-            {"class", MjTokenKind::CLASS},
-            {"else", MjTokenKind::ELSE},
-            {"import", MjTokenKind::IMPORT},
-            {"interface", MjTokenKind::INTERFACE},
-            {"struct", MjTokenKind::STRUCT},
-            {"union", MjTokenKind::UNION},
-        };
-
-        for (const MjKeywordInfo &info : SCOPED_KEYWORDS) {
-            if (token_text == info.text) {
-                if (*_ch == ' ') {
-                    parse_whitespace();
-
-                    if (*_ch == '{' || (*_ch | 0x20u) - 'a' < 26 || *_ch - '0' < 10 || *_ch == '_') {
-                        return Error::SUCCESS;
-                    }
-                }
+    u32 token_size = _ch - token_data;
 
-                return Error::FAILURE;
-            }
-        }
+    if (token_size > U16_MAX) {
+        error(token_data, token_size, "Comment is too long!");
+        token_size = U16_MAX;
+    }
 
+    _file.append_inline_token(token_kind, {token_data, token_size});
+    return Error::SUCCESS;
+}
 
-        // These keywords are binary operators that require a type as the right
-        // hand operand. In situations where they may be confused as unit
-        // expressions, the following token will determine their type. If followed
-        // by a type expression, they are keywords, otherwise they are subject to
-        // default parsing rules.
-        //
-        // These keywords are safe to use as variable or function names.
-        static
-        const MjKeywordInfo TYPE_OP_KEYWORDS[] = {
-            {"as", MjTokenKind::AS},                 // 'as (type)'
-            {"is", MjTokenKind::IS},                 // 'is (type)'
-        };
-
-        for (const MjKeywordInfo &info : TYPE_OP_KEYWORDS) {
-            if (token_text == info.text) {
-                if (_has_trailing_whitespace) {
-                    return Error::SUCCESS;
-                }
 
-                return Error::FAILURE;
-            }
-        }
+Error MjLexer::parse_annotation_name() noexcept {
+    const u8 *token_data = _ch;
 
-        _file.append_string_token(MjTokenKind::VARIABLE_NAME, token_text);
+    // [a-z0-9][a-z0-9.+-]*
+    if (Ascii::is_lowercase_alnum(*_ch)) {
+        for (_ch += 1; Ascii::is_lowercase_alnum(*_ch) || *_ch == '.' || *_ch == '+' || *_ch == '-'; ++_ch);
     }
 
-    if (trailing_token_kind != MjTokenKind::NONE) {
-        token_kind = MjTokenKind::FUNCTION_NAME;
-    } else {
-        token_kind = MjTokenKind::VARIABLE_NAME;
+    if (_ch == token_data) {
+        error(token_data - 1, 1, "Expected an annotation name!");
+        return Error::SUCCESS;
     }
 
+    append_string_token(MjTokenKind::ANNOTATION_NAME, {token_data, u32(_ch - token_data)});
+    return Error::SUCCESS;
 }
 
 
-Error MjLexer::parse_type_name() noexcept {
+Error MjLexer::parse_identifier() noexcept {
     const u8 *token_data = _ch;
+    _ch = Ascii::scan_lowercase_word(_ch);
 
-    ///
-    /// Builtin Type Name - number/void/bool
-    ///
+    // Names are either lowercase, uppercase, or capitalized.
+    if (Ascii::is_upper(*_ch)) {
+        for (_ch += 1; Ascii::is_alnum(*_ch) || *_ch == '_'; ++_ch);
+        append_string_token(MjTokenKind::INVALID_IDENTIFIER, {token_data, u32(_ch - token_data)});
+        error(token_data, _ch - token_data, "Invalid identifier! Lowercase names can not contain uppercase letters.");
+        return Error::SUCCESS;
+    }
 
-    // First check for a numeric type name.
-    _ch += peek_numeric_type_name_size();
+    StringView token_text{token_data, u32(_ch - token_data)};
 
-    // Check for - (numeric, bool, or void)
-    if (_ch != token_data) {
-        if (*_ch == 'x') {
-            // vectorized register
-        }
-    } else if (*_ch == 'b') {
-        _ch += 4;
-    } else if (*_ch == 'v') {
-        _ch += 4;
+    // A module name is followed by the scope operator.
+    if (*_ch == ':' && _ch[1] == ':') {
+        _ch += 2;
+        append_string_token(MjTokenKind::MODULE_NAME, token_text);
+        _file.append_token(MjTokenKind::SCOPE);
+        return Error::SUCCESS;
     }
 
-    // Check for word boundary.
-    if (_ch != token_data && (Ascii::is_alnum(*_ch) || *_ch == '_')) {
-        _ch = token_data;
+    // A function call, even of a function named like a keyword.
+    if (*_ch == '(') {
+        _ch += 1;
+        append_string_token(MjTokenKind::FUNCTION_NAME, token_text);
+        _file.append_token(MjTokenKind::OPEN_PARENTHESIS);
+        push_state(MjLexerState::IN_PARENTHESES);
+        return Error::SUCCESS;
     }
 
-    if (Ascii::is_upper(*_ch)) {
+    MjTokenKind token_kind = find_reserved_name(token_data, _ch);
 
-        ///
-        /// User-defined Type Name - (?:[0-9][0-9+-]*)?[A-Z][A-Z0-9+-]*[a-z][A-Za-z0-9+-]*|[A-Z]
-        ///
+    if (token_kind != MjTokenKind::NONE) {
+        _file.append_token(token_kind);
+        return Error::SUCCESS;
+    }
 
-        if (_ch == token_data) {
+    // The builtin type names: the numeric types, `bool`, and `void`.
+    if (
+        (token_text.size() > 1 && peek_numeric_type_name_size(token_data) == token_text.size()) ||
+        token_text == StringView("bool") ||
+        token_text == StringView("void")
+    ) {
+        append_string_token(MjTokenKind::TYPE_NAME, token_text);
+        return Error::SUCCESS;
+    }
 
-            // (?:[0-9][0-9+-]*)?
-            if (Ascii::is_digit(*_ch)) {
-                for (_ch += 1; Ascii::is_digit(*_ch) || *_ch == '+' || *_ch == '-'; ++_ch);
-            }
+    // A function template, as in `cast<u8>(x)`.
+    if (*_ch == '<' && is_operand_start(_ch[1])) {
+        _ch += 1;
+        append_string_token(MjTokenKind::FUNCTION_NAME, token_text);
+        _file.append_token(MjTokenKind::OPEN_ANGLE_BRACKET);
+        push_state(MjLexerState::IN_ANGLE_BRACKETS);
+        return Error::SUCCESS;
+    }
 
-            // [A-Z]
-            if (Ascii::is_upper(*_ch)) {
+    // A function reference, as in `sort(items, compare&)`.
+    if (*_ch == '&' && !is_operand_start(_ch[1]) && _ch[1] != '&' && _ch[1] != '=') {
+        _ch += 1;
+        append_string_token(MjTokenKind::FUNCTION_NAME, token_text);
+        _file.append_token(MjTokenKind::FUNCTION_REFERENCE);
+        return Error::SUCCESS;
+    }
 
-                // [A-Z0-9+-]*
-                for (_ch += 1; Ascii::is_uppercase_alnum(*_ch) || *_ch == '+' || *_ch == '-'; ++_ch);
+    append_string_token(MjTokenKind::VARIABLE_NAME, token_text);
+    return Error::SUCCESS;
+}
 
-                // [a-z]
-                if (Ascii::is_lower(*_ch)) {
 
-                    // [A-Za-z0-9+-]*
-                    for (_ch += 1; Ascii::is_alnum(*_ch) || *_ch == '+' || *_ch == '-'; ++_ch);
+Error MjLexer::parse_type_name() noexcept {
+    const u8 *token_data = _ch;
+    MjTokenKind token_kind = MjTokenKind::TYPE_NAME;
 
-                    // Check for word boundary.
-                    if (*_ch == '_') {
-                        _ch = token_data;
-                    }
-                } else {
+    // [A-Z][A-Z0-9_]*
+    _ch = Ascii::scan_uppercase_word(_ch + 1);
 
-                    // Special Case: [A-Z]
-                    if (_ch - 1 == token_data && *_ch != '_') {
-                    } else {
-                        _ch = token_data;
-                    }
-                }
-            } else if (_ch == token_data) {
-                return Error::FAILURE;
-            }
-        }
+    if (Ascii::is_lower(*_ch)) {
 
-        _ch = token_data;
+        // A capitalized name may not contain underscores: [A-Z][A-Z0-9]*[a-z][A-Za-z0-9]*
+        bool has_underscore = std::find(token_data, _ch, '_') != _ch;
+        for (_ch += 1; Ascii::is_alnum(*_ch); ++_ch);
 
-        ///
-        /// Module Name - [0-9A-Za-z][0-9A-Za-z+-]*(?=::)
-        ///
+        if (has_underscore || *_ch == '_') {
+            for (; Ascii::is_alnum(*_ch) || *_ch == '_'; ++_ch);
+            token_kind = MjTokenKind::INVALID_IDENTIFIER;
+            error(token_data, _ch - token_data, "Invalid identifier! Capitalized names can not contain underscores.");
+        }
+    } else if (_ch - token_data > 1) {
+        token_kind = MjTokenKind::CONSTANT_NAME;
+    }
 
-        if (Ascii::is_alnum(*_ch)) {
-            for (_ch += 1; Ascii::is_alnum(*_ch) || *_ch == '+' || *_ch == '-'; ++_ch);
+    append_string_token(token_kind, {token_data, u32(_ch - token_data)});
 
-            if (!(*_ch == ':' && _ch[1] == ':')) {
-                _ch = token_data;
-            }
-        }
+    if (token_kind != MjTokenKind::TYPE_NAME) {
+        return Error::SUCCESS;
     }
 
-    if (_ch == token_data) {
-        return Error::FAILURE;
+    // A type scope, as in `Type::member`, or a template argument list, as in `Vector<u32>`.
+    if (*_ch == ':' && _ch[1] == ':') {
+        _ch += 2;
+        _file.append_token(MjTokenKind::SCOPE);
+    } else if (*_ch == '<' && is_operand_start(_ch[1])) {
+        _ch += 1;
+        _file.append_token(MjTokenKind::OPEN_ANGLE_BRACKET);
+        push_state(MjLexerState::IN_ANGLE_BRACKETS);
     }
 
-    _file.append_string_token(MjTokenKind::TYPE_NAME, {token_data, _ch - token_data});
     return Error::SUCCESS;
 }
 
 
 Error MjLexer::parse_numeric_literal() noexcept {
     const u8 *token_data = _ch;
-    const u8 *checkpoint = nullptr;
 
     // Parse the sign.
     bool has_sign = *_ch == '+' || *_ch == '-';
     _ch += has_sign;
 
     // Parse the base prefix.
+    bool has_prefix = false;
+
     switch (*_ch == '0' ? _ch[1] : 0) {
     case 'x': {
+        has_prefix = true;
         _ch += 2;
 
-        // Check that there is an integer portion.
-        if (!Ascii::is_uppercase_hexadecimal_digit(*_ch)) {
-            _ch = token_data;
-            return Error::FAILURE;
-        }
-
-        // Parse the integer portion.
-        for (_ch += 1; Ascii::is_uppercase_hexadecimal_digit(*_ch); ++_ch);
-
-        // Parse the optional delimited integer portions.
-        while (*_ch == '_' && Ascii::is_uppercase_hexadecimal_digit(_ch[1])) {
-            for (_ch += 2; Ascii::is_uppercase_hexadecimal_digit(*_ch); ++_ch);
+        if (!scan_delimited_digits(_ch, Ascii::is_uppercase_hexadecimal_digit)) {
+            break;
         }
 
         // Parse the optional fractional portion.
-        if (*_ch == '.') {
-            checkpoint = _ch;
-
-            if (Ascii::is_uppercase_hexadecimal_digit(_ch[1])) {
-                for (_ch += 2; Ascii::is_uppercase_hexadecimal_digit(*_ch); ++_ch);
-            }
-        }
-
-        // Parse the optional exponent portion.
-        if (*_ch == 'p') {
+        if (*_ch == '.' && Ascii::is_uppercase_hexadecimal_digit(_ch[1])) {
             _ch += 1;
+            scan_delimited_digits(_ch, Ascii::is_uppercase_hexadecimal_digit);
+        }
 
-            // Parse the optional exponent sign.
-            if (*_ch == '+' || *_ch == '-') {
-                _ch += 1;
-            }
-
-            if (!Ascii::is_decimal_digit(*_ch)) {
-                if (!checkpoint) {
-                    _ch = token_data;
-                    return Error::FAILURE;
-                }
-
-                _ch = checkpoint;
-                break;
-            }
+        // Parse the optional binary exponent portion.
+        u32 sign_size = _ch[1] == '+' || _ch[1] == '-';
 
-            for (_ch += 1; Ascii::is_decimal_digit(*_ch); ++_ch);
+        if (*_ch == 'p' && Ascii::is_decimal_digit(_ch[1 + sign_size])) {
+            _ch = Ascii::scan_decimal_digits(_ch + 1 + sign_size);
         }
 
         break;
     } case 'o': {
+        has_prefix = true;
         _ch += 2;
-
-        // Check that there is an integer portion.
-        if (!Ascii::is_octal_digit(*_ch)) {
-            _ch = token_data;
-            return Error::FAILURE;
-        }
-
-        // Parse the integer portion.
-        for (_ch += 1; Ascii::is_octal_digit(*_ch); ++_ch);
-
-        // Parse the optional delimited integer portions.
-        while (*_ch == '_' && Ascii::is_octal_digit(_ch[1])) {
-            for (_ch += 2; Ascii::is_octal_digit(*_ch); ++_ch);
-        }
-
+        scan_delimited_digits(_ch, Ascii::is_octal_digit);
         break;
     } case 'b': {
+        has_prefix = true;
         _ch += 2;
-
-        // Check that there is an integer portion.
-        if (!Ascii::is_binary_digit(*_ch)) {
-            _ch = token_data;
-            return Error::FAILURE;
-        }
-
-        // Parse the integer portion.
-        for (_ch += 1; Ascii::is_binary_digit(*_ch); ++_ch);
-
-        // Parse the optional delimited integer portions.
-        while (*_ch == '_' && Ascii::is_binary_digit(_ch[1])) {
-            for (_ch += 2; Ascii::is_binary_digit(*_ch); ++_ch);
-        }
-
+        scan_delimited_digits(_ch, Ascii::is_binary_digit);
         break;
     } default: {
-
-        // Check that there is an integer portion.
-        if (!Ascii::is_decimal_digit(*_ch)) {
-            _ch = token_data;
-            return Error::FAILURE;
-        }
-
-        // Parse the integer portion.
-        for (_ch += 1; Ascii::is_decimal_digit(*_ch); ++_ch);
-
-        // Parse the optional delimited integer portions.
-        while (*_ch == ',') {
-            checkpoint = _ch;
-            _ch += 1;
-
-            if (Ascii::is_decimal_digit(_ch[1])) {
-                _ch -= 1;
-                break;
-            }
-
-            for (_ch += 2; Ascii::is_decimal_digit(*_ch); ++_ch);
-        }
+        scan_delimited_digits(_ch, Ascii::is_decimal_digit);
 
         // Parse the optional fractional portion.
-        if (*_ch == '.') {
-            checkpoint = _ch;
+        if (*_ch == '.' && Ascii::is_decimal_digit(_ch[1])) {
             _ch += 1;
-
-            if (!Ascii::is_decimal_digit(*_ch)) {
-                _ch -= 1;
-                break;
-            }
-
-            for (_ch += 2; Ascii::is_decimal_digit(*_ch); ++_ch);
+            scan_delimited_digits(_ch, Ascii::is_decimal_digit);
         }
 
         // Parse the optional exponent portion.
-        if (*_ch == 'e') {
-            _ch += 1;
-
-            // Parse the optional exponent sign.
-            if (*_ch == '+' || *_ch == '-') {
-                _ch += 1;
-            }
-
-            if (!Ascii::is_decimal_digit(*_ch)) {
-                if (!checkpoint) {
-                    _ch = token_data;
-                    return Error::FAILURE;
-                }
-
-                _ch = checkpoint;
-                break;
-            }
+        u32 sign_size = _ch[1] == '+' || _ch[1] == '-';
 
-            for (_ch += 1; Ascii::is_decimal_digit(*_ch); ++_ch);
+        if (*_ch == 'e' && Ascii::is_decimal_digit(_ch[1 + sign_size])) {
+            _ch = Ascii::scan_decimal_digits(_ch + 1 + sign_size);
         }
     }
     }
 
-    // Parse the type suffix.
-    u32 type_suffix_size = peek_numeric_type_name_size();
-    _ch += type_suffix_size;
+    // Parse the type suffix, which must end the word.
+    u32 type_suffix_size = peek_numeric_type_name_size(_ch);
 
-    // Check for word boundary.
-    if ((Ascii::is_alnum(*_ch) || *_ch == '_')) {
-        if (!checkpoint) {
-            _ch = token_data;
-            return Error::FAILURE;
-        }
+    if (Ascii::is_alnum(_ch[type_suffix_size]) || _ch[type_suffix_size] == '_') {
+        type_suffix_size = 0;
+    }
+
+    _ch += type_suffix_size;
 
-        _ch = checkpoint;
+    // Anything else attached to the number makes it invalid, as does a prefix without digits.
+    if (Ascii::is_alnum(*_ch) || *_ch == '_' || (has_prefix && _ch == token_data + has_sign + 2)) {
+        for (; Ascii::is_alnum(*_ch) || *_ch == '_'; ++_ch);
+        error(token_data, _ch - token_data, "Invalid numeric literal!");
         type_suffix_size = 0;
     }
 
     // Emit tokens.
-    _file.append_string_token(MjTokenKind::NUMERIC_LITERAL, {token_data, _ch - token_data});
+    u32 token_size = _ch - token_data;
+    append_string_token(MjTokenKind::NUMERIC_LITERAL, {token_data, token_size});
 
-    if (_emit_subtokens) {
-        if (!Ascii::is_decimal_digit(token_data[1])) {
+    if (_emit_subtokens && token_size <= U8_MAX) {
+        if (has_prefix) {
             _file.append_subtoken(MjTokenKind::NUMERIC_LITERAL_PREFIX, has_sign, 2);
         }
 
         if (type_suffix_size > 0) {
-            _file.append_subtoken(MjTokenKind::NUMERIC_LITERAL_SUFFIX, u8(_ch - token_data) - type_suffix_size, type_suffix_size);
+            _file.append_subtoken(MjTokenKind::NUMERIC_LITERAL_SUFFIX, token_size - type_suffix_size, type_suffix_size);
         }
     }
 
     // Check for a unit expression after a numeric literal.
     if (*_ch == ' ') {
         _ch += 1;
+
         if (parse_unit_expression().is_failure()) {
             _ch -= 1;
         }
@@ -1530,34 +925,29 @@ Error MjLexer::parse_numeric_literal() noexcept {
 }
 
 
-u32 MjLexer::peek_numeric_type_name_size() noexcept {
-    if (*_ch != 'u' && *_ch != 'f' && *_ch != 'i') {
+u32 MjLexer::peek_numeric_type_name_size(const u8 *ch) noexcept {
+    if (*ch != 'u' && *ch != 'f' && *ch != 'i') {
         return 0;
     }
 
-    // Two-character suffixes: [iu]8
-    u32 packed = (*_ch << 8) | _ch[1];
-
-    if (packed == 0x7538u || packed == 0x6938u) { // "u8" or "i8"
-        return 2;
+    // Two-character names: [iu]8
+    if (ch[1] == '8') {
+        return *ch != 'f' ? 2 : 1;
     }
 
-    if (_ch[1]) {
-
-        // Three-character suffixes: [fiu](16|32|64)
-        packed = ((packed & 0xFFu) << 8) | _ch[2];
+    // Three-character names: [fiu](16|32|64)
+    u32 packed = u32(ch[1]) << 8 | ch[2];
 
-        if (packed == 0x3136u || packed == 0x3332u || packed == 0x3634u) { // "16", "32", or "64"
-            return 3;
-        }
+    if (packed == 0x3136u || packed == 0x3332u || packed == 0x3634u) { // "16", "32", or "64"
+        return 3;
+    }
 
-        // Four-character suffixes: [fiu]128
-        if (_ch[2] && (packed << 8) | _ch[3] == 0x313238u) { // "128"
-            return 4;
-        }
+    // Four-character names: [fiu]128
+    if (ch[1] == '1' && ch[2] == '2' && ch[3] == '8') {
+        return 4;
     }
 
-    // One-character suffixes: [fiu]
+    // One-character names: [fiu]
     return 1;
 }
 
@@ -1566,42 +956,25 @@ Error MjLexer::parse_unit_expression() noexcept {
     const u8 *token_data = _ch;
 
     // Match the first portion: [A-Za-zµΩÅ°'"]|^g|1/
-    while (true) {
-        if (!*_ch) {
-            return Error::FAILURE;
-        }
-
-        u16 value = *_ch;
-
-        if (
-            (value | 0x20u) - 'a' < 26 ||
-            value == '\'' ||
-            value == '"'
-        ) {
-            _ch += 1;
-            break;
-        }
-
-        if (!_ch[1]) {
-            return Error::FAILURE;
-        }
+    u16 value = *_ch;
 
-        value = (value << 8) | _ch[1];
+    if ((value | 0x20u) - 'a' < 26 || value == '\'' || value == '"') {
+        _ch += 1;
+    } else {
+        value = value << 8 | _ch[1];
 
         if (
-            value == (('^' << 8) | 'g') || // '^g'
-            value == (('1' << 8) | '/') || // '1/'
+            value == ('^' << 8 | 'g') || // '^g'
+            value == ('1' << 8 | '/') || // '1/'
             value == 0xC2B0u || // '°'
             value == 0xC2B5u || // 'µ'
-            value == 0xC2B7u || // '·'
             value == 0xC385u || // 'Å'
             value == 0xCEA9u    // 'Ω'
         ) {
             _ch += 2;
-            break;
+        } else {
+            return Error::FAILURE;
         }
-
-        return Error::FAILURE;
     }
 
     // [A-Za-z0-9µΩÅ°'"⁰¹²³⁴⁵⁶⁷⁸⁹⁻⸍·^*/-]*
@@ -1621,7 +994,7 @@ Error MjLexer::parse_unit_expression() noexcept {
             continue;
         }
 
-        value = (value << 8) | _ch[1];
+        value = value << 8 | _ch[1];
 
         if (
             value == 0xC2B0u || // '°'
@@ -1641,7 +1014,7 @@ Error MjLexer::parse_unit_expression() noexcept {
             break;
         }
 
-        value = (value << 8) | _ch[2];
+        value = value << 8 | _ch[2];
 
         if (
             value == 0xE281B0u || // '⁰'
@@ -1661,136 +1034,135 @@ Error MjLexer::parse_unit_expression() noexcept {
         break;
     }
 
-    // check for word boundary.
-
-    // Check for an "as" or "is" keyword because they take priority over a unit expression.
-    if ((token_data[0] == 'a' || token_data[0] == 'i') && token_data[1] == 's' && token_data[2] == ' ') {
+    // Reserved names after a number take priority over a unit expression, as in `x as u8`, and a
+    // unit must end the word.
+    if (find_reserved_name(token_data, _ch) != MjTokenKind::NONE || *_ch == '_' || *_ch == '(') {
         _ch = token_data;
         return Error::FAILURE;
     }
 
-    _file.append_string_token(MjTokenKind::UNIT_EXPRESSION, {token_data, _ch - token_data});
+    append_string_token(MjTokenKind::UNIT_EXPRESSION, {token_data, u32(_ch - token_data)});
     return Error::SUCCESS;
 }
 
 
-Error MjLexer::parse_interpolated_string_literal() noexcept {
-    const u8 *token_data = _ch;
-
-    if (*_ch != '"') {
-        return Error::FAILURE;
-    }
-
-    _ch += 1;
-
+Error MjLexer::parse_string_literal() noexcept {
     struct SubToken {
         MjTokenKind kind;
         u8 offset;
         u8 size;
     };
 
-    std::vector<SubToken> escape_sequences;
-    SubToken escape_sequence{MjTokenKind::CHARACTER_ESCAPE_SEQUENCE, _token_offset, 2};
+    const u8 *token_data = _ch;
     MjTokenKind token_kind = MjTokenKind::STRING_LITERAL;
+    std::vector<SubToken> escape_sequences;
+    u32 brace_depth = 0; // The nesting depth of interpolated `{}` blocks.
 
-    while (*_ch != '"') {
-        if (*_ch == '\0') {
-            error("Unterminated string literal!");
+    for (_ch += 1; ;) {
+        if (is_end_of_line()) {
+            error(token_data, _ch - token_data, "Unterminated string literal!");
             break;
         }
 
-        if (*_ch == '\\') {
+        if (*_ch == '"' && brace_depth == 0) {
             _ch += 1;
+            break;
+        }
+
+        if (*_ch == '{') {
+            brace_depth += 1;
             token_kind = MjTokenKind::INTERPOLATED_STRING_LITERAL;
+        } else if (*_ch == '}' && brace_depth > 0) {
+            brace_depth -= 1;
+        } else if (*_ch == '"') {
 
-            switch (*_ch) {
-            case '\0': {
-                error("Unterminated escape sequence in string literal!");
-                break;
+            // A string nested in an interpolated block, which ends on the same line.
+            for (_ch += 1; *_ch != '"' && !is_end_of_line(); ++_ch) {
+                _ch += *_ch == '\\' && _ch[1] != '\n' && _ch[1] != '\0';
+            }
+
+            if (*_ch != '"') {
+                continue;
             }
+        } else if (*_ch == '\\') {
+            const u8 *escape_data = _ch;
+            StringView message;
+            _ch += 2;
+            token_kind = MjTokenKind::INTERPOLATED_STRING_LITERAL;
+
+            switch (escape_data[1]) {
             case '\\': // '\\'
-            case '"': // '\"'
-            case 'e': // '\e'
-            case 'n': // '\n'
-            case 'r': // '\r'
-            case 't': // '\t'
-            case '0': // '\0'
+            case '"':  // '\"'
+            case '{':  // '\{'
+            case '}':  // '\}'
+            case 'e':  // '\e'
+            case 'n':  // '\n'
+            case 'r':  // '\r'
+            case 't':  // '\t'
+            case '0':  // '\0'
                 break;
             case 'o': { // '\o377'
-                for (const u8 *end = _ch + 3; _ch < end; ++_ch) {
-                    if (!Ascii::is_octal_digit(*_ch)) {
-                        escape_sequence.kind = MjTokenKind::INVALID_ESCAPE_SEQUENCE;
-                        escape_sequence.size = 5 - (end - _ch);
-                        error(escape_sequence, "Invalid string escape sequence! '\\o' requires 3 octal digits!");
-                        break;
-                    }
-                }
-
-                if (_ch[-3] > '3') {
-                    escape_sequence.kind = MjTokenKind::INVALID_ESCAPE_SEQUENCE;
-                    escape_sequence.size = 5;
-                    error(escape_sequence, "Invalid string escape sequence! Max value is \"\\o377\"!");
+                if (!scan_digits(_ch, 3, Ascii::is_octal_digit)) {
+                    message = "Invalid string escape sequence! '\\o' requires 3 octal digits!";
+                } else if (escape_data[2] > '3') {
+                    message = "Invalid string escape sequence! Max value is \"\\o377\"!";
                 }
 
                 break;
             } case 'x': { // '\x7F'
-                for (const u8 *end = _ch + 2; _ch < end; ++_ch) {
-                    if (!Ascii::is_uppercase_hexadecimal_digit(*_ch)) {
-                        escape_sequence.kind = MjTokenKind::INVALID_ESCAPE_SEQUENCE;
-                        escape_sequence.size = 4 - (end - _ch);
-                        error(escape_sequence, "Invalid string escape sequence! '\\x' requires 2 hexadecimal digits!");
-                        break;
-                    }
-                }
-
-                if (_ch[-1] > '7') {
-                    escape_sequence.kind = MjTokenKind::INVALID_ESCAPE_SEQUENCE;
-                    escape_sequence.size = 4;
-                    error(escape_sequence, "Invalid string escape sequence! Max value is \"\\x7F\"!");
+                if (!scan_digits(_ch, 2, Ascii::is_uppercase_hexadecimal_digit)) {
+                    message = "Invalid string escape sequence! '\\x' requires 2 hexadecimal digits!";
+                } else if (escape_data[2] > '7') {
+                    message = "Invalid string escape sequence! Max value is \"\\x7F\"!";
                 }
 
                 break;
             } case 'u': { // '\uFFFF'
-                for (const u8 *end = _ch + 4; _ch < end; ++_ch) {
-                    if (!Ascii::is_uppercase_hexadecimal_digit(*_ch)) {
-                        escape_sequence.kind = MjTokenKind::INVALID_ESCAPE_SEQUENCE;
-                        escape_sequence.size = 6 - (end - _ch);
-                        error(escape_sequence, "Invalid Unicode string escape sequence! '\\u' requires 4 hexadecimal digits!");
-                        break;
-                    }
+                if (!scan_digits(_ch, 4, Ascii::is_uppercase_hexadecimal_digit)) {
+                    message = "Invalid Unicode string escape sequence! '\\u' requires 4 hexadecimal digits!";
                 }
 
                 break;
             } case 'U': { // '\U10FFFF'
-                for (const u8 *end = _ch + 6; _ch < end; ++_ch) {
-                    if (!Ascii::is_uppercase_hexadecimal_digit(*_ch)) {
-                        escape_sequence.kind = MjTokenKind::INVALID_ESCAPE_SEQUENCE;
-                        escape_sequence.size = 8 - (end - _ch);
-                        error(escape_sequence, "Invalid Unicode string escape sequence! '\\U' requires 6 hexadecimal digits!");
-                        break;
-                    }
+                if (!scan_digits(_ch, 6, Ascii::is_uppercase_hexadecimal_digit)) {
+                    message = "Invalid Unicode string escape sequence! '\\U' requires 6 hexadecimal digits!";
+                } else if (escape_data[2] > '1' || (escape_data[2] == '1' && escape_data[3] > '0')) {
+                    message = "Invalid string escape sequence! Max value is \"\\U10FFFF\"!";
                 }
 
-                if (_ch[-6] > '1' || (_ch[-6] == '1' && _ch[-5] > '0')) {
-                    escape_sequence.kind = MjTokenKind::INVALID_ESCAPE_SEQUENCE;
-                    escape_sequence.size = 8;
-                    error(escape_sequence, "Invalid string escape sequence! Max value is \"\\U10FFFF\"!");
-                }
+                break;
+            } case '\r':
+              case '\n':
+              case '\0': {
 
+                // The line ends inside the escape sequence, which is reported as unterminated.
+                _ch -= 1;
+                message = "Invalid string escape sequence!";
                 break;
             } default: {
-                escape_sequence.kind = MjTokenKind::INVALID_ESCAPE_SEQUENCE;
-                error(escape_sequence, "Invalid string escape sequence!");
+                message = "Invalid string escape sequence!";
+            }
+            }
+
+            if (!message.is_empty()) {
+                error(escape_data, _ch - escape_data, message);
             }
+
+            u32 offset = escape_data - token_data;
+            u32 size = _ch - escape_data;
+
+            if (_emit_subtokens && offset + size <= U8_MAX) {
+                MjTokenKind kind = message.is_empty() ? MjTokenKind::CHARACTER_ESCAPE_SEQUENCE : MjTokenKind::INVALID_ESCAPE_SEQUENCE;
+                escape_sequences.push_back({kind, u8(offset), u8(size)});
             }
 
-            escape_sequences.emplace_back(escape_sequence);
+            continue;
         }
 
         _ch += 1;
     }
 
-    _file.append_string_token(token_kind, {token_data, _ch - token_data});
+    append_string_token(token_kind, {token_data, u32(_ch - token_data)});
 
     for (SubToken escape_sequence : escape_sequences) {
         _file.append_subtoken(escape_sequence.kind, escape_sequence.offset, escape_sequence.size);
@@ -1800,65 +1172,107 @@ Error MjLexer::parse_interpolated_string_literal() noexcept {
 }
 
 
+Error MjLexer::parse_raw_string_literal() noexcept {
+    const u8 *token_data = _ch;
+
+    for (_ch += 1; *_ch != '\'' && !is_end_of_line(); ++_ch);
+
+    if (*_ch != '\'') {
+        _file.append_inline_token(MjTokenKind::INVALID, {token_data, u32(_ch - token_data)});
+        error(token_data, _ch - token_data, "Unterminated string literal!");
+        return Error::SUCCESS;
+    }
+
+    _ch += 1;
+    u32 token_size = _ch - token_data - 2;
+
+    if (token_size > U16_MAX) {
+        error(token_data, _ch - token_data, "String literal is too long!");
+        token_size = U16_MAX;
+    }
+
+    _file.append_inline_token(MjTokenKind::RAW_STRING_LITERAL, {token_data + 1, token_size});
+    return Error::SUCCESS;
+}
+
+
 ///
 /// Line Control and Whitespace Parsing
 ///
 
 
 void MjLexer::parse_whitespace() noexcept {
-    for (; *_ch == ' '; ++_ch);
-
-    if (*_ch == '\n') {
-        parse_indent();
-        _file.append_indent_token(_ch - _file.line(_line_index).ptr());
-        _line_index += 1;
-
-        if (*_ch) {
-            _ch += 1;
-        }
-    } else {
-        _has_leading_whitespace = _ch[-1] == ' ';
+    if (*_ch == ' ') {
+        _ch = Ascii::scan_spaces(_ch);
+        _has_leading_whitespace = true;
     }
 }
 
 
 void MjLexer::parse_indent() noexcept {
-    const u8 *token_data;
+    const u8 *token_data = _ch;
+    _ch = Ascii::scan_spaces(_ch);
 
-    do {
-        for (token_data = _ch; *_ch == ' '; ++_ch);
-    } while (parse_newline());
+    // Spaces at the end of a line are not stored, so a line without tokens is not indented.
+    u32 indent_size = is_end_of_line() ? 0 : _ch - token_data;
 
-    u32 indent_size = _ch - token_data;
     _last_indent = _line_indent;
-    _line_indent = indent_size / INDENT_WIDTH;
+    _line_indent = std::min<u32>(indent_size / INDENT_WIDTH, U8_MAX);
     _file.append_indent_token(_line_indent);
     _line_index += 1;
-    _ch += indent_size % INDENT_WIDTH;
+
+    for (u32 spaces = indent_size - _line_indent * INDENT_WIDTH; spaces > 0;) {
+        u32 size = std::min<u32>(spaces, U8_MAX);
+        _file.append_whitespace_token(size);
+        spaces -= size;
+    }
 
     // Reset line dependent parsing states.
     _has_leading_whitespace = true;
+}
 
-    if (_state.in_annotation() || _state.in_shell()) {
+
+void MjLexer::parse_newline() noexcept {
+
+    // Shell statements and template argument lists end with the line.
+    while (_state.in_shell() || _state.in_angle_brackets()) {
         pop_state();
     }
+
+    if (is_eof()) {
+        return;
+    }
+
+    _ch += *_ch == '\r' ? 2 : 1;
+    parse_indent();
 }
 
 
-bool MjLexer::parse_newline() noexcept {
-    if (*_ch != '\n') {
+bool MjLexer::follows_operand() const noexcept {
+    if (_has_leading_whitespace) {
         return false;
     }
 
-    _file.append_indent_token(_ch - _file.line(_line_index).ptr());
-    _line_index += 1;
+    u8 ch = _ch[-1];
+    return Ascii::is_alnum(ch) || ch == '_' || ch == ')' || ch == ']' || ch == '}' || ch == '>' || ch == '"' || ch == '\'' || ch == '*' || ch == '&' || ch == '?' || ch == '!';
+}
 
-    if (!*_ch) {
-        return false;
+
+///
+/// State Control
+///
+
+
+void MjLexer::close_bracket(MjLexerState state, StringView message) noexcept {
+    while (_state.in_angle_brackets() && state != MjLexerState::IN_ANGLE_BRACKETS) {
+        pop_state();
     }
 
-    _ch += 1;
-    return true;
+    if (_state == state) {
+        pop_state();
+    } else {
+        error(_ch, 1, message);
+    }
 }
 
 
@@ -1867,13 +1281,35 @@ bool MjLexer::parse_newline() noexcept {
 ///
 
 
-void MjLexer::error(MjToken token, StringView message) noexcept {
-    printf(
-        "%s:%u:%u: \x1B[31;1mError:\x1B[m %.*s\n"
-        "%.*s\n"
-        "\x1B[35;1m%*.*s\x1B[m\n",
-        _file.path().c_str(), _line_offsets[token.] + 1, token.offset, message.size(), message.data(),
-        _file.line(token.line).size(), _file.line(token.line).ptr(),
-        token.offset, token.size, "^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^"
-    );
+void MjLexer::print_errors() const noexcept {
+    const u8 *text = _file.text().data();
+    const u8 *line_data = text;
+    u32 line_number = 1;
+
+    for (const MjLexerError &error : _errors) {
+        const u8 *error_data = text + error.text_offset();
+
+        // The errors are recorded in text order, so the lines are counted from the last error.
+        for (const u8 *ch = line_data; ch < error_data; ++ch) {
+            if (*ch == '\n') {
+                line_data = ch + 1;
+                line_number += 1;
+            }
+        }
+
+        const u8 *line_end = line_data;
+        for (; *line_end && *line_end != '\n'; ++line_end);
+
+        u32 column = error_data - line_data;
+        u32 marker_size = std::clamp<u32>(error.size(), 1, 32);
+
+        printf(
+            "%s:%u:%u: \x1B[31;1mError:\x1B[m %.*s\n"
+            "%.*s\n"
+            "%*s\x1B[35;1m%.*s\x1B[m\n",
+            _file.path().c_str(), line_number, column + 1, error.message().size(), error.message().data(),
+            u32(line_end - line_data), line_data,
+            column, "", marker_size, "^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^"
+        );
+    }
 }
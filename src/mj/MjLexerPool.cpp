@@ -0,0 +1,222 @@
+#include <mj/MjLexerPool.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+
+std::vector<MjSourceFile *> MjLexerPool::parse_files(
+    const std::vector<std::filesystem::path> &file_paths,
+    u32 thread_count,
+    const MjTokenCache *cache,
+    MjStringInterner *interner,
+    bool emit_subtokens,
+    std::vector<u64> *durations
+) noexcept {
+    return MjLexerPool(file_paths, thread_count, cache, interner, emit_subtokens, durations).run();
+}
+
+
+MjSourceFile *MjLexerPool::parse_file_chunks(
+    const std::filesystem::path &file_path,
+    u32 thread_count,
+    bool emit_subtokens,
+    u32 *relexed_chunk_count
+) noexcept {
+    MjSourceText text;
+
+    if (text.load(file_path).is_failure()) {
+        return nullptr;
+    }
+
+    std::vector<u32> offsets = chunk_offsets(text, thread_count);
+
+    if (relexed_chunk_count != nullptr) {
+        *relexed_chunk_count = 0;
+    }
+
+    if (offsets.size() <= 2) {
+        return MjLexer::parse_text(file_path, std::move(text), emit_subtokens);
+    }
+
+    // The first chunk is lexed into the file itself, and the others into files sharing its text.
+    MjSourceFile *file = new MjSourceFile(file_path, std::move(text));
+    std::vector<MjSourceFile *> chunks(offsets.size() - 1, file);
+    std::vector<Error> errors(chunks.size(), Error::SUCCESS);
+    std::vector<std::thread> threads;
+    threads.reserve(chunks.size() - 1);
+
+    for (u32 i = 1; i < chunks.size(); ++i) {
+        chunks[i] = new MjSourceFile(file_path, file->text().view(), true);
+        chunks[i]->record_string_tokens();
+        threads.emplace_back([&, i] {
+            errors[i] = MjLexer::parse_chunk(*chunks[i], offsets[i], offsets[i + 1], emit_subtokens);
+        });
+    }
+
+    Error error = MjLexer::parse_chunk(*file, offsets[0], offsets[1], emit_subtokens);
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    for (u32 i = 1; i < chunks.size(); ++i) {
+        bool is_merged = true;
+
+        if (error.is_success()) {
+            error = errors[i].is_success() ? MjLexer::merge_chunk(*file, *chunks[i], is_merged, emit_subtokens) : errors[i];
+        }
+
+        if (!is_merged && relexed_chunk_count != nullptr) {
+            *relexed_chunk_count += 1;
+        }
+
+        delete chunks[i];
+    }
+
+    if (error.is_failure()) {
+        printf("Failed to lex file in chunks! '%s'\n", file_path.c_str());
+        delete file;
+        return nullptr;
+    }
+
+    file->clear_line_starts();
+    return file;
+}
+
+
+std::vector<u32> MjLexerPool::chunk_offsets(const MjSourceText &text, u32 thread_count) noexcept {
+    u32 chunk_count = std::min(thread_count, text.size() / MIN_CHUNK_SIZE);
+    std::vector<u32> offsets = {0};
+    const u8 *data = text.data();
+
+    for (u32 i = 1; i < chunk_count; ++i) {
+        u32 offset = std::max<u32>(u64(text.size()) * i / chunk_count, offsets.back() + 1);
+
+        // Find the next line which is neither indented nor empty.
+        while (offset < text.size()) {
+            const u8 *newline = static_cast<const u8 *>(std::memchr(data + offset, '\n', text.size() - offset));
+
+            if (newline == nullptr) {
+                offset = text.size();
+                break;
+            }
+
+            offset = newline - data + 1;
+
+            if (data[offset] != ' ' && data[offset] != '\n' && data[offset] != '\0') {
+                break;
+            }
+        }
+
+        if (offset >= text.size()) {
+            break;
+        }
+
+        offsets.push_back(offset);
+    }
+
+    offsets.push_back(text.size());
+    return offsets;
+}
+
+
+std::vector<MjSourceFile *> MjLexerPool::run() noexcept {
+    schedule();
+
+    if (_durations != nullptr) {
+        _durations->assign(_file_paths.size(), 0);
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(_queues.size() - 1);
+
+    for (u32 i = 1; i < _queues.size(); ++i) {
+        threads.emplace_back(&MjLexerPool::work, this, i);
+    }
+
+    work(0);
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    return std::move(_files);
+}
+
+
+void MjLexerPool::schedule() noexcept {
+    std::vector<std::pair<u64, u32>> sizes;
+    sizes.reserve(_file_paths.size());
+
+    for (u32 i = 0; i < _file_paths.size(); ++i) {
+        std::error_code error;
+        u64 size = std::filesystem::file_size(_file_paths[i], error);
+        sizes.emplace_back(error ? 0 : size, i);
+    }
+
+    // Largest first, and by path order among equal sizes so the schedule is repeatable.
+    std::sort(sizes.begin(), sizes.end(), [](const auto &a, const auto &b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+
+    for (u32 i = 0; i < sizes.size(); ++i) {
+        _queues[i % _queues.size()].file_indices.push_back(sizes[i].second);
+    }
+}
+
+
+void MjLexerPool::work(u32 worker_index) noexcept {
+    u32 file_index;
+
+    while (take(worker_index, file_index)) {
+        auto start = std::chrono::steady_clock::now();
+        MjSourceFile *file;
+
+        if (_cache != nullptr) {
+            file = _cache->parse_file(_file_paths[file_index]);
+        } else {
+            file = MjLexer::parse_file(_file_paths[file_index], _emit_subtokens);
+        }
+
+        if (file != nullptr && _interner != nullptr) {
+            file->intern(*_interner);
+        }
+
+        _files[file_index] = file;
+
+        if (_durations != nullptr) {
+            auto end = std::chrono::steady_clock::now();
+            (*_durations)[file_index] = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        }
+    }
+}
+
+
+bool MjLexerPool::take(u32 worker_index, u32 &file_index) noexcept {
+    WorkQueue &own = _queues[worker_index];
+
+    {
+        std::lock_guard lock(own.mutex);
+
+        if (!own.file_indices.empty()) {
+            file_index = own.file_indices.front();
+            own.file_indices.pop_front();
+            return true;
+        }
+    }
+
+    // No work is ever added once lexing starts, so a full pass over empty queues means we are done.
+    for (u32 i = 1; i < _queues.size(); ++i) {
+        WorkQueue &victim = _queues[(worker_index + i) % _queues.size()];
+        std::lock_guard lock(victim.mutex);
+
+        if (!victim.file_indices.empty()) {
+            file_index = victim.file_indices.back();
+            victim.file_indices.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,342 @@
+#include <mj/MjModuleGraph.hpp>
+#include <mj/ast/MjTokenView.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+std::vector<std::filesystem::path> MjModuleGraph::file_paths() const noexcept {
+    std::vector<std::filesystem::path> file_paths;
+
+    for (const Module &module : _modules) {
+        file_paths.insert(file_paths.end(), module.file_paths.begin(), module.file_paths.end());
+    }
+
+    return file_paths;
+}
+
+
+Error MjModuleGraph::load(const std::filesystem::path &root_path) noexcept {
+    if (!std::filesystem::is_directory(root_path)) {
+        printf("Failed to open module directory! '%s'\n", root_path.c_str());
+        return Error::FAILURE;
+    }
+
+    _modules.clear();
+    _order.clear();
+    add_module(root_path, "", NONE);
+    return Error::SUCCESS;
+}
+
+
+void MjModuleGraph::add_module(const std::filesystem::path &directory_path, std::string name, u32 parent) noexcept {
+    u32 module_index = _modules.size();
+    _modules.push_back({std::move(name), directory_path, {}, {}, {}, {}, parent});
+
+    std::vector<std::filesystem::path> subdirectory_paths;
+    std::error_code error;
+
+    for (const auto &entry : std::filesystem::directory_iterator(directory_path, error)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".mj") {
+            _modules[module_index].file_paths.push_back(entry.path());
+        } else if (entry.is_directory() && entry.path().filename() == "@internal") {
+            for (const auto &internal_entry : std::filesystem::recursive_directory_iterator(entry.path(), error)) {
+                if (internal_entry.is_regular_file() && internal_entry.path().extension() == ".mj") {
+                    _modules[module_index].file_paths.push_back(internal_entry.path());
+                }
+            }
+        } else if (entry.is_directory()) {
+            subdirectory_paths.push_back(entry.path());
+        }
+    }
+
+    // Module indices follow the path order, independent of the directory order.
+    std::sort(_modules[module_index].file_paths.begin(), _modules[module_index].file_paths.end());
+    std::sort(subdirectory_paths.begin(), subdirectory_paths.end());
+
+    for (const std::filesystem::path &subdirectory_path : subdirectory_paths) {
+        const std::string &parent_name = _modules[module_index].name;
+        std::string subdirectory_name = subdirectory_path.filename().string();
+        add_module(subdirectory_path, parent_name.empty() ? subdirectory_name : parent_name + "::" + subdirectory_name, module_index);
+    }
+}
+
+
+Error MjModuleGraph::resolve(const std::vector<MjSourceFile *> &files) noexcept {
+    u32 file_index = 0;
+
+    for (u32 i = 0; i < _modules.size(); ++i) {
+        Module &module = _modules[i];
+        module.files.assign(files.begin() + file_index, files.begin() + file_index + module.file_paths.size());
+        file_index += module.file_paths.size();
+
+        for (const MjSourceFile *file : module.files) {
+            if (file == nullptr) {
+                continue;
+            }
+
+            module.weight += file->size();
+            MjTokenView tokens(*file);
+
+            // An import directive names a module by its names separated by `::` or `.`.
+            for (u32 j = 0; j < tokens.size(); ++j) {
+                if (tokens.kind(j) != MjTokenKind::IMPORT) {
+                    continue;
+                }
+
+                std::string name;
+
+                while (true) {
+                    j += 1;
+
+                    if (tokens.kind(j) == MjTokenKind::WHITESPACE) {
+                        continue;
+                    }
+
+                    if (tokens.kind(j).encoding() != MjTokenEncoding::STRING) {
+                        break;
+                    }
+
+                    StringView text = file->text_of(tokens.token(j));
+                    name.append(reinterpret_cast<const char *>(text.data()), text.size());
+
+                    if (tokens.kind(j + 1) != MjTokenKind::SCOPE && tokens.kind(j + 1) != MjTokenKind::DOT) {
+                        break;
+                    }
+
+                    name.append("::");
+                    j += 1;
+                }
+
+                u32 dependency = resolve_import(i, name);
+
+                if (dependency != NONE && dependency != i && std::find(module.dependencies.begin(), module.dependencies.end(), dependency) == module.dependencies.end()) {
+                    module.dependencies.push_back(dependency);
+                    _modules[dependency].dependents.push_back(i);
+                }
+            }
+        }
+    }
+
+    // Order the modules with Kahn's algorithm. Any module left over is part of a cycle.
+    std::vector<u32> pending(_modules.size());
+    _order.clear();
+
+    for (u32 i = 0; i < _modules.size(); ++i) {
+        pending[i] = _modules[i].dependencies.size();
+
+        if (pending[i] == 0) {
+            _order.push_back(i);
+        }
+    }
+
+    for (u32 i = 0; i < _order.size(); ++i) {
+        for (u32 dependent : _modules[_order[i]].dependents) {
+            if (--pending[dependent] == 0) {
+                _order.push_back(dependent);
+            }
+        }
+    }
+
+    if (_order.size() != _modules.size()) {
+        for (u32 i = 0; i < _modules.size(); ++i) {
+            if (pending[i] != 0) {
+                printf("Failed to order modules! Import cycle through '%s'\n", _modules[i].name.c_str());
+                break;
+            }
+        }
+
+        return Error::FAILURE;
+    }
+
+    // Weigh each module with its heaviest chain of dependents, last modules first.
+    for (u32 i = _order.size(); i-- > 0;) {
+        Module &module = _modules[_order[i]];
+        u64 dependents_weight = 0;
+
+        for (u32 dependent : module.dependents) {
+            dependents_weight = std::max(dependents_weight, _modules[dependent].weight);
+        }
+
+        module.weight += dependents_weight;
+    }
+
+    return Error::SUCCESS;
+}
+
+
+void MjModuleGraph::run(u32 thread_count, const std::function<void(Module &)> &phase) noexcept {
+    std::mutex mutex;
+    std::condition_variable ready_condition;
+    std::vector<u32> ready;
+    std::vector<u32> pending(_modules.size());
+    u32 remaining_count = _modules.size();
+
+    auto is_lighter = [this](u32 a, u32 b) {
+        return _modules[a].weight != _modules[b].weight ? _modules[a].weight < _modules[b].weight : a > b;
+    };
+
+    for (u32 i = 0; i < _modules.size(); ++i) {
+        pending[i] = _modules[i].dependencies.size();
+
+        if (pending[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+
+    std::make_heap(ready.begin(), ready.end(), is_lighter);
+
+    auto work = [&]() {
+        std::unique_lock lock(mutex);
+
+        while (true) {
+            ready_condition.wait(lock, [&]() { return !ready.empty() || remaining_count == 0; });
+
+            if (ready.empty()) {
+                return;
+            }
+
+            std::pop_heap(ready.begin(), ready.end(), is_lighter);
+            u32 module_index = ready.back();
+            ready.pop_back();
+            lock.unlock();
+
+            auto start = std::chrono::steady_clock::now();
+            phase(_modules[module_index]);
+            auto end = std::chrono::steady_clock::now();
+
+            lock.lock();
+            _modules[module_index].duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            remaining_count -= 1;
+
+            for (u32 dependent : _modules[module_index].dependents) {
+                if (--pending[dependent] == 0) {
+                    ready.push_back(dependent);
+                    std::push_heap(ready.begin(), ready.end(), is_lighter);
+                }
+            }
+
+            if (!ready.empty() || remaining_count == 0) {
+                ready_condition.notify_all();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(std::max(thread_count, 1u) - 1);
+
+    for (u32 i = 1; i < thread_count; ++i) {
+        threads.emplace_back(work);
+    }
+
+    work();
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+
+void MjModuleGraph::add_file_durations(const std::vector<u64> &durations) noexcept {
+    u32 file_index = 0;
+
+    for (Module &module : _modules) {
+        for (u32 i = 0; i < module.file_paths.size() && file_index < durations.size(); ++i) {
+            module.duration += durations[file_index];
+            file_index += 1;
+        }
+    }
+}
+
+
+u32 MjModuleGraph::find_module(const std::string &name) const noexcept {
+    for (u32 i = 0; i < _modules.size(); ++i) {
+        if (_modules[i].name == name) {
+            return i;
+        }
+    }
+
+    return NONE;
+}
+
+
+u32 MjModuleGraph::resolve_import(u32 module_index, const std::string &name) const noexcept {
+    if (name.empty()) {
+        return NONE;
+    }
+
+    for (u32 i = module_index; i != NONE; i = _modules[i].parent) {
+        const std::string &scope = _modules[i].name;
+        u32 dependency = find_module(scope.empty() ? name : scope + "::" + name);
+
+        if (dependency != NONE) {
+            return dependency;
+        }
+    }
+
+    return NONE;
+}
+
+
+MjModuleGraph::CriticalPath MjModuleGraph::critical_path() const noexcept {
+    CriticalPath path;
+
+    if (_order.empty()) {
+        return path;
+    }
+
+    // The longest chain of durations ending at each module, and the dependency it continues.
+    std::vector<u64> finish(_modules.size());
+    std::vector<u32> previous(_modules.size(), NONE);
+    u32 last = _order.front();
+
+    for (u32 module_index : _order) {
+        u64 start = 0;
+
+        for (u32 dependency : _modules[module_index].dependencies) {
+            if (previous[module_index] == NONE || finish[dependency] > start) {
+                start = finish[dependency];
+                previous[module_index] = dependency;
+            }
+        }
+
+        finish[module_index] = start + _modules[module_index].duration;
+
+        if (finish[module_index] > finish[last]) {
+            last = module_index;
+        }
+    }
+
+    for (u32 i = last; i != NONE; i = previous[i]) {
+        path.module_indices.push_back(i);
+    }
+
+    std::reverse(path.module_indices.begin(), path.module_indices.end());
+    path.duration = finish[last];
+    return path;
+}
+
+
+void MjModuleGraph::print() const noexcept {
+    for (u32 module_index : _order) {
+        const Module &module = _modules[module_index];
+        printf("%s (%zu files, %.3f ms)\n", module.name.empty() ? "<root>" : module.name.c_str(), module.files.size(), module.duration / 1e6);
+
+        for (u32 dependency : module.dependencies) {
+            printf("    import %s\n", _modules[dependency].name.c_str());
+        }
+    }
+
+    CriticalPath path = critical_path();
+    printf("Critical path (%.3f ms):", path.duration / 1e6);
+
+    for (u32 i = 0; i < path.module_indices.size(); ++i) {
+        const std::string &name = _modules[path.module_indices[i]].name;
+        printf("%s %s", i == 0 ? "" : " ->", name.empty() ? "<root>" : name.c_str());
+    }
+
+    printf("\n");
+}
@@ -1,1326 +1,1122 @@
 #include <mj/MjParser.hpp>
 
-#include <mj/ast/MjBitfieldType.hpp>
-#include <mj/ast/MjClassType.hpp>
-#include <mj/ast/MjFunction.hpp>
-
-#include <mj/ast/MjImportDirective.hpp>
-
-// Expressions
-#include <mj/ast/MjBlockExpression.hpp>
-
-// Statements
+#include <mj/ast/MjAnnotation.hpp>
+#include <mj/ast/MjArrayType.hpp>
 #include <mj/ast/MjBlockStatement.hpp>
 #include <mj/ast/MjBreakStatement.hpp>
+#include <mj/ast/MjBuiltinType.hpp>
+#include <mj/ast/MjClassType.hpp>
+#include <mj/ast/MjComment.hpp>
+#include <mj/ast/MjConstantType.hpp>
 #include <mj/ast/MjContinueStatement.hpp>
-#include <mj/ast/MjDoLoop.hpp>
-#include <mj/ast/MjDoUntilLoop.hpp>
-#include <mj/ast/MjDoWhileLoop.hpp>
-#include <mj/ast/MjForLoop.hpp>
+#include <mj/ast/MjElseStatement.hpp>
+#include <mj/ast/MjExpressionTree.hpp>
 #include <mj/ast/MjIfStatement.hpp>
+#include <mj/ast/MjIntegerType.hpp>
+#include <mj/ast/MjMember.hpp>
+#include <mj/ast/MjPointerType.hpp>
 #include <mj/ast/MjReturnStatement.hpp>
-#include <mj/ast/MjUntilLoop.hpp>
+#include <mj/ast/MjSafeType.hpp>
+#include <mj/ast/MjSliceType.hpp>
+#include <mj/ast/MjStructureType.hpp>
+#include <mj/ast/MjThenStatement.hpp>
+#include <mj/ast/MjTypeAlias.hpp>
+#include <mj/ast/MjTypeName.hpp>
+#include <mj/ast/MjUnionType.hpp>
 #include <mj/ast/MjWhileLoop.hpp>
 #include <mj/ast/MjYieldStatement.hpp>
 
-#include <filesystem>
-
-
-void MjParser::error(StringView message) noexcept {
-    _errors.append(_token, message);
-}
+#include <cstdio>
 
 
-MjProgram MjParser::parse(MjItemManager &item_manager, const MjSourceFile &file) noexcept {
-    MjProgram program{file};
-    program.parse_module();
-    return program;
+static std::string_view to_string_view(StringView text) noexcept {
+    return {reinterpret_cast<const char *>(text.data()), text.size()};
 }
 
 
+/// Parse the decimal size of an array type, such as the `4` of `u32[4]`, with optional `_` separators.
+static bool parse_array_size(StringView text, u32 &size) noexcept {
+    u64 result = 0;
+    bool has_digits = false;
 
+    for (u8 ch : to_string_view(text)) {
+        if (ch == '_') {
+            continue;
+        }
 
+        if (ch < '0' || ch > '9') {
+            return false;
+        }
 
+        result = result * 10 + (ch - '0');
+        has_digits = true;
 
-
-
-
-
-
-
-
-
-
-MjModule *MjParser::parse_module(std::filesystem::path path) noexcept {
-    if (!std::filesystem::is_directory(path)) {
-        error("Invalid module path! '{}'", path);
-        return;
+        if (result > 0xFFFFFFFFu) {
+            return false;
+        }
     }
 
-    MjModule *mod = new_item<MjModule>();
-    std::vector<std::filesystem::path> file_paths = std::filesystem::list_directory(path);
+    size = result;
+    return has_digits;
+}
+
 
-    // Verify module path.
-    for (std::filesystem::path &path : file_paths) {
-        if (std::filesystem::is_regular_file(path) && path.extension() == "mj") {
-            parse_file(*mod, path);
-        } else if (std::filesystem::is_directory(path)) {
-            mod->modules().push_back(parse_module(path));
+/// Return the kind of an annotation known to the compiler by name.
+static MjItemKind annotation_kind_of(StringView name) noexcept {
+    static constexpr struct {
+        std::string_view name;
+        MjItemKind item_kind;
+    } ANNOTATIONS[] = {
+        {"alignment", MjItemKind::ALIGNMENT_ANNOTATION},
+        {"api",       MjItemKind::API_ANNOTATION},
+        {"internal",  MjItemKind::INTERNAL_ANNOTATION},
+        {"offset",    MjItemKind::OFFSET_ANNOTATION},
+        {"pure",      MjItemKind::PURE_ANNOTATION},
+        {"shared",    MjItemKind::SHARED_ANNOTATION},
+        {"size",      MjItemKind::SIZE_ANNOTATION},
+    };
+
+    for (const auto &annotation : ANNOTATIONS) {
+        if (annotation.name == to_string_view(name)) {
+            return annotation.item_kind;
         }
     }
 
+    return MjItemKind::ANNOTATION;
+}
 
-    // List files and directories.
-
-    // list internal
-
-    // list external
 
-    // parse files
-    for (std::filesystem::path &path : file_paths) {
-        if (std::filesystem::is_regular_file(path) && path.extension() == "mj") {
-            parse_file(*mod, path);
-        }
+MjModule *MjParser::parse(MjItemManager &item_manager, u32 module_id, const MjSourceFile &file) noexcept {
+    MjParser parser(item_manager, module_id, file);
+    parser.parse_module();
 
-        if (std::filesystem::is_directory(path) && path.filename() == "@internal") {
-            std::vector<std::filesystem::path> file_paths = std::filesystem::list_directory(path);
-        }
+    if (!parser._errors.empty()) {
+        parser.print_errors();
+        return nullptr;
     }
 
-    // parse submodules
-    for (std::filesystem::path &path : file_paths) {
-        if (std::filesystem::is_directory(path)) {
-            mod->modules().push_back(parse_module(path));
-        }
-    }
+    return parser._module;
 }
 
 
+MjParser::MjParser(MjItemManager &item_manager, u32 module_id, const MjSourceFile &file) noexcept :
+    _item_manager(item_manager),
+    _module_id(module_id),
+    _source_id(item_manager.add_source_file(&file)),
+    _file(file),
+    _tokens(file)
+{
+    if (is_trivia(kind())) {
+        skip_token();
+    }
+}
 
 
+void MjParser::print_errors() const noexcept {
+    for (const MjParseError &error : _errors) {
+        MjToken token = _tokens.token(error.token_index());
+        u32 line_number = _file.line_index(token) + 1;
 
+        // Errors at the end of a line have no token text to show.
+        if (token.kind() == MjTokenKind::INDENT || token.kind() == MjTokenKind::NONE) {
+            printf("%s:%u: \x1B[31;1mError:\x1B[m %s\n", _file.path().c_str(), line_number, error.message());
+            continue;
+        }
 
+        StringView text = _file.text_of(token);
+        printf("%s:%u: \x1B[31;1mError:\x1B[m %s '%.*s'\n", _file.path().c_str(), line_number, error.message(), text.size(), text.data());
+    }
+}
 
-MjItem *MjParser::parse_item() noexcept {
-    MjToken start = _token;
-    u32 indent = 0;
-    MjStatement *statement = nullptr;
-
-    switch (_token.kind()) {
-    case MjTokenKind::OPEN_CURLY_BRACE: {
-        skip_token();
 
-        MjBlockStatement *block_statement = new_item<MjBlockStatement>();
+void MjParser::recover() noexcept {
+    u32 depth = 0;
 
-        while (true) {
-            if (parse_token(MjTokenKind::INDENT)) {
-                if (_token.indent() == indent + 1) {
-                    // body
-                } else {
-                    // end
-                }
-            }
-            MjStatement *s = parse_statement();
+    while (!match_token(MjTokenKind::NONE)) {
+        if (match_token(MjTokenKind::OPEN_CURLY_BRACE)) {
+            depth += 1;
+        } else if (match_token(MjTokenKind::CLOSE_CURLY_BRACE)) {
 
-            if (s == nullptr) {
-                break;
+            // The brace closes the enclosing block, which its parser consumes.
+            if (depth == 0) {
+                return;
             }
 
-            block_statement->add_item(s);
-        }
+            depth -= 1;
 
-        parse_token(MjTokenKind::CLOSE_CURLY_BRACE);
-        block_statement->set_tokens(tokens_since(start));
-        return block_statement;
-    } case MjTokenKind::BREAK: {
-        MjBreakStatement *statement = new_item<MjBreakStatement>();
-
-        if (match_token(MjTokenKind::INDENT)) {
-            MjExpression *depth = parse_expression();
-
-            if (depth != nullptr) {
-                if (depth->result_type() != MjBuiltinTypes::INT) {
-                    error("Expected an expression!");
-                } else {
-                    statement->set_depth(depth);
-                }
+            if (depth == 0) {
+                skip_token();
+                return;
             }
+        } else if (depth == 0 && is_line_end()) {
+            return;
         }
 
-        statement->set_tokens(tokens_since(start));
-        return statement;
-    } case MjTokenKind::CONTINUE: {
-        MjContinueStatement *statement = new_item<MjContinueStatement>();
-        MjExpression *depth = parse_expression();
-        statement->set_depth(depth);
-        statement->set_tokens(tokens_since(start));
-        return statement;
-    } case MjTokenKind::CLASS: {
-        MjClassType *statement = new_item<MjClassType>();
-
-        // Consume the 'class' token.
-        MjToken class_start = parse_token(MjTokenKind::CLASS);
-
-        // Parse the name of the class type.
-        MjToken class_name = parse_token(MjTokenKind::TYPE_NAME);
-
-        if (class_name == nullptr) {
-            error("Expected a type name after 'class'!");
-            reset(start);
-            return nullptr;
-        }
-
-        // Parse either a template argument list, or a template, or a partial specialization.
-        if (parse_token(MjTokenKind::OPEN_ANGLE_BRACKET)) {
-            MjTemplateArgumentList *template_argument_list = parse_template_argument_list();
-
-            if (template_argument_list == nullptr) {
-                // Non-template class type definitition.
-            } else if (template_argument_list->is_pure()) {
-                // Full class type template definition.
-            } else if () {
-                // Partial class type template definition.
-            }
-        }
+        skip_token();
+    }
+}
 
-        // Parse the optional inline variable declaration.
-        if (match_token(MjTokenKind::VARIABLE_NAME) || match_token(MjTokenKind::CONSTANT_NAME)) {
-            MjToken instance_name = parse_token();
-        }
 
-        // Parse the class type definition.
-        while (true) {
-            MjStatement *s = parse_statement();
+u32 MjParser::skip_type(u32 token_index) const noexcept {
+    while (kind(token_index) == MjTokenKind::CONST || kind(token_index) == MjTokenKind::SAFE) {
+        token_index = next_index(token_index);
+    }
 
-            switch (s->item_kind()) {
-            case MjItemKind::STRUCTURE_TYPE:
-                break;
-            case MjItemKind::UNION_TYPE:
-                break;
-            case MjItemKind::CLASS_TYPE:
-                break;
-            case MjItemKind::ENUMERATION_TYPE:
-                break;
-            }
+    if (kind(token_index) != MjTokenKind::TYPE_NAME) {
+        return U32_MAX;
+    }
 
-            statement->add_item(s);
-        }
+    token_index = next_index(token_index);
+    u32 depth = 0;
 
-        statement->set_tokens(tokens_since(start));
-        return statement;
-    } case MjTokenKind::DO: {
-        if (!match_token(MjTokenKind::OPEN_CURLY_BRACE)) {
-            error("Expected '{' after 'do'!");
-            return nullptr;
+    // Skip the template arguments and the modifiers, along with anything within their brackets.
+    for (MjTokenKind kind = this->kind(token_index); depth > 0 || kind == MjTokenKind::OPEN_ANGLE_BRACKET || kind == MjTokenKind::OPEN_SQUARE_BRACKET || kind == MjTokenKind::POINTER_TYPE_MODIFIER; kind = this->kind(token_index)) {
+        if (kind == MjTokenKind::INDENT || kind == MjTokenKind::NONE) {
+            return U32_MAX;
         }
 
-        MjBlockStatement *body_statement = parse_statement();
-        Slice<MjToken> tokens = Slice<MjToken>(_token, 1);
-        MjStatement *statement = new_item<MjDoLoop>(body_statement, tokens);
-    } case MjTokenKind::ELSE: {
-        // should not get here!
-        error("Keyword 'else' must follow 'if' block!");
-
-        if (match_token(MjTokenKind::OPEN_CURLY_BRACE)) {
-            parse_statement();
-        }
-    } case MjTokenKind::ENUM: {
-        return parse_type_enumeration();
-    } case MjTokenKind::FAIL: {
-        return parse_fail_statement();
-    } case MjTokenKind::FOR: {
-        // for-in statement
-        MjForStatement for_statement = new_item<MjForLoop>();
-    } case MjTokenKind::IF: {
-
-        // This is either an if-expression or an if-statement.
-
-        // `if` keyword is guaranteed to be followed by something that looks like an expression.
-        MjExpression *condition = parse_expression();
-
-        if (condition == nullptr) {
-            error("Missing condition!");
-            return nullptr;
+        if (kind == MjTokenKind::OPEN_ANGLE_BRACKET || kind == MjTokenKind::OPEN_SQUARE_BRACKET) {
+            depth += 1;
+        } else if (kind == MjTokenKind::CLOSE_ANGLE_BRACKET || kind == MjTokenKind::CLOSE_SQUARE_BRACKET) {
+            depth -= 1;
         }
 
-        MjThenStatement *then_statement = parse_then_statement();
+        token_index = next_index(token_index);
+    }
 
-        if (then_statement == nullptr) {
-            error("Missing if-then statement!");
-            return nullptr;
-        }
+    return token_index;
+}
 
-        MjElseStatement *else_statement = nullptr;
 
-        if (parse_token(MjTokenKind::ELSE)) {
-            else_statement = parse_else_statement();
+///
+/// Declarations
+///
 
-            if (else_statement == nullptr) {
-                else_statement = parse_if_statement();
-            }
 
-            if (else_statement == nullptr) {
-                error("Expected an 'if' statement or a 'block' statement after 'else'!");
-                return nullptr;
-            }
-        }
+void MjParser::parse_module() noexcept {
+    _module = new_item<MjModule>(_token_index);
 
-        return new_item<MjIfStatement>(condition, then_statement, else_statement);
-    } case MjTokenKind::IMPL: {
-        // 
-    } case MjTokenKind::IMPORT: {
-        // Scope dictates the import type (public/private)
-        std::filesystem::path path(".");
-
-        // Parse module imports
-        while (parse_token(MjTokenKind::IMPORT)) {
-            while (parse_token(MjTokenKind::SEMICOLON)) {
-                MjToken token = parse_token();
-
-                switch (token.kind()) {
-                case MjTokenKind::IDENTIFIER:
-                    path.append(token.string_id());
-                    break;
-                case MjTokenKind::MINUS:
-                    path.append('-', true);
-                    break;
-                case MjTokenKind::DOT:
-                    path.append('/', true);
-                    break;
-                default:
-                    error("Invalid module path!");
-                    return nullptr;
-                }
-            }
-        }
+    // The initial values of the variables outside of functions share a tree.
+    _expressions = _item_manager.new_expression_tree(_module_id);
 
-        MjModule mod(path);
+    while (!match_token(MjTokenKind::NONE)) {
+        parse_declaration(_module);
+    }
+}
 
-        // Parse module global scope
-        return new_item<MjImportDirective>();
-    } case MjTokenKind::INTERFACE: {
-        // Only at module scope!
-    } case MjTokenKind::MATCH: {
-        // 
 
-        // Parse all the cases.
-        while () {
-            ;
-        }
-    } case MjTokenKind::RETURN: {
-        return new_item<MjReturnStatement>(parse_expression());
-    } case MjTokenKind::STRUCT: {
-        // 
-    } case MjTokenKind::TYPE: {
+void MjParser::parse_declaration(MjDeclaration *owner) noexcept {
+    switch (kind()) {
+    case MjTokenKind::INDENT: {
         skip_token();
-        parse_token(MjTokenKind::OPEN_ANGLE_BRACKET);
-
-        MjType *type = parse_type_expression();
-
-        if (type == nullptr) {
-            error("Missing type expression!");
-        }
-
-        parse_token(MjTokenKind::CLOSE_ANGLE_BRACKET);
-
-        if (type == nullptr) {
-            error("Missing type expression!");
-        }
+        return;
+    }
 
-        MjToken type_name = parse_token(MjTokenKind::TYPE_NAME);
+    case MjTokenKind::BLOCK_COMMENT:
+    case MjTokenKind::FORMATTED_BLOCK_COMMENT: {
+        parse_comment();
+        return;
+    }
 
-        if (type == nullptr) {
-            error("Missing type expression!");
-        }
+    case MjTokenKind::AT: {
+        parse_annotation();
+        return;
+    }
 
-        return new_item<MjTypeAlias>(type_name, type);
-    } case MjTokenKind::UNION: {
-        // 
-    } case MjTokenKind::UNTIL: {
-        // 
-    } case MjTokenKind::WHILE: {
-        if (parse_token(MjTokenKind::OPEN_PARENTHESIS) == nullptr) {
-            ;
-        }
+    // Imports are resolved by the module graph rather than by the parser.
+    case MjTokenKind::IMPORT: {
+        skip_line();
+        return;
+    }
 
-        MjExpression *loop_condition = parse_expression();
+    case MjTokenKind::STRUCT:
+    case MjTokenKind::CLASS:
+    case MjTokenKind::UNION: {
+        MjType *type = parse_type_definition();
 
-        if (parse_token(MjTokenKind::CLOSE_PARENTHESIS) == nullptr) {
-            ;
+        if (type != nullptr) {
+            owner->append(type);
         }
 
-        MjStatement *loop_body = parse_block_statement();
-        return new_item<MjWhileStatement>(loop_condition, loop_body);
-    } case MjTokenKind::YIELD: {
-        MjExpression *return_value = parse_expression();
+        return;
+    }
 
-        if (return_value == nullptr) {
-            ;
-        }
+    case MjTokenKind::CONST:
+    case MjTokenKind::SAFE:
+    case MjTokenKind::TYPE_NAME: {
+        parse_variable_or_function(owner);
+        return;
+    }
 
-        return new_item<MjYieldStatement>(return_value);
+    default: {
+        error("Expected a declaration!");
+        skip_token();
+        recover();
     }
     }
-
-    // Check for an expression.
-    return parse_expression();
 }
 
 
+void MjParser::parse_comment() noexcept {
+    bool is_formatted = match_token(MjTokenKind::FORMATTED_BLOCK_COMMENT);
+    _comments.push_back(new_item<MjComment>(_token_index, token_text(_token_index), is_formatted));
+    skip_token();
+}
 
 
+void MjParser::parse_annotation() noexcept {
+    u32 start = _token_index;
+    skip_token();
 
+    if (!match_token(MjTokenKind::ANNOTATION_NAME)) {
+        error("Expected an annotation name!");
+        recover();
+        return;
+    }
 
+    MjToken name = token();
+    MjAnnotationArgumentList argument_list;
+    skip_token();
 
+    // The arguments are single tokens, which the annotation interprets.
+    if (parse_token(MjTokenKind::OPEN_PARENTHESIS) && !parse_token(MjTokenKind::CLOSE_PARENTHESIS)) {
+        do {
+            if (is_line_end()) {
+                break;
+            }
 
+            argument_list.push_back(token());
+            skip_token();
+        } while (parse_token(MjTokenKind::COMMA));
 
+        if (!parse_token(MjTokenKind::CLOSE_PARENTHESIS)) {
+            error("Expected ')'!");
+            recover();
+            return;
+        }
+    }
 
+    _annotations.push_back(new_item<MjAnnotation>(start, annotation_kind_of(_file.text_of(name)), name, argument_list));
+}
 
 
+void MjParser::attach_prefix(MjDeclaration *declaration) noexcept {
+    for (MjComment *comment : _comments) {
+        declaration->append(comment);
+    }
 
+    for (MjAnnotation *annotation : _annotations) {
+        declaration->append(annotation);
+    }
 
+    _comments.clear();
+    _annotations.clear();
+}
 
 
+MjType *MjParser::parse_type_definition() noexcept {
+    u32 start = _token_index;
+    MjTokenKind keyword = kind();
+    skip_token();
 
-
-MjExpression *MjParser::parse_expression(u32 min_bp) {
-    /// This is a Pratt parser implementation.
-    ///
-    /// We consider the binding power of an operator to convey both associativity and precedence.
-    /// Binding power is the edge of a graph where both operators and terminals are the nodes.
-    /// Terminals are bound to only one operator at a time and the greatest binding power
-    /// wins.
-    ///
-    /// 
-    MjExpression *lhs = nullptr;
-    MjToken start = _token;
-
-    switch (_token.kind()) {
-
-    case MjTokenKind::OPEN_CAST: {
-        parse_token();
-        MjType *type = parse_type();
-        parse_token(MjTokenKind::COLON);
-        lhs = parse_expression();
-        parse_token(MjTokenKind::CLOSE_CAST);
+    if (!match_token(MjTokenKind::TYPE_NAME)) {
+        error("Expected a type name!");
+        recover();
+        return nullptr;
     }
 
-    case MjTokenKind::TYPE_NAME: {
-        MjType *type = parse_type();
+    MjType *type;
 
-        switch (_token.kind()) {
-        case MjTokenKind::OPEN_PARENTHESIS: {
-            MjFunctionParameterList *fpl = parse_function_parameter_list();
-            lhs = new_item<MjExpression>(tokens_since(start), type, fpl);
-            break;
-        }
+    if (keyword == MjTokenKind::STRUCT) {
+        type = new_item<MjStructureType>(start);
+    } else if (keyword == MjTokenKind::CLASS) {
+        type = new_item<MjClassType>(start);
+    } else {
+        type = new_item<MjUnionType>(start);
+    }
 
-        case MjTokenKind::OPEN_CURLY_BRACE: {
-            MjStatement *statement = parse_statement();
-            lhs = new_item<MjExpression>(tokens_since(start), type, statement);
-            break;
-        }
-        default:
-            error("Expected '(', '{', or '::' after type name!");
-        }
+    type->append(new_item<MjTypeName>(_token_index, token(), token_text(_token_index)));
+    define_type(_token_index, type);
+    attach_prefix(type);
+    skip_token();
 
-        break;
+    if (!parse_token(MjTokenKind::OPEN_CURLY_BRACE)) {
+        error("Expected '{'!");
+        recover();
+        return type;
     }
 
-    case MjTokenKind::MODULE_NAME: {
-        MjType *type = parse_type();
-
-        switch (_token.kind()) {
-        case MjTokenKind::SCOPE: {
-            lhs = new_item<MjExpression>(tokens_since(start), type);
+    while (!parse_token(MjTokenKind::CLOSE_CURLY_BRACE)) {
+        if (match_token(MjTokenKind::NONE)) {
+            error("Expected '}'!");
             break;
         }
-        default:
-            error("Expected '::' after module name!");
-        }
-
-        break;
-    }
 
-    case MjTokenKind::UNINITIALIZED: {
-        parse_token();
-        lhs = new_item<MjExpression>(tokens_since(start), new_item<MjVariable>());
-        break;
+        parse_declaration(type);
     }
 
-    case MjTokenKind::TRUE:
-    case MjTokenKind::FALSE:
-    case MjTokenKind::NULL_: {
-        parse_token();
-        lhs = new_item<MjExpression>(tokens_since(start), new_item<MjVariable>());
-        break;
-    }
+    return type;
+}
 
-    case MjTokenKind::STRING_LITERAL:
-    case MjTokenKind::RAW_STRING_LITERAL:
-    case MjTokenKind::INTERPOLATED_STRING_LITERAL: {
-        String string = token_text();
-        MjVariable *string_literal = new_item<MjStringLiteral>(parse_token(), std::move(string));
-        lhs = new_item<MjExpression>(tokens_since(start), string_literal);
-        break;
-    }
 
-    case MjTokenKind::NUMERIC_LITERAL: {
-        MjVariable *number_literal = new_item<MjNumberLiteral>(parse_token());
-        lhs = new_item<MjExpression>(tokens_since(start), number_literal);
-        break;
-    }
+void MjParser::parse_variable_or_function(MjDeclaration *owner) noexcept {
+    u32 start = _token_index;
+    MjType *type = parse_type();
 
-    case MjTokenKind::OPEN_PARENTHESIS: {
-        parse_token();
-        lhs = parse_expression();
-        parse_token(MjTokenKind::CLOSE_PARENTHESIS);
-        break;
+    if (type == nullptr) {
+        recover();
+        return;
     }
 
-    case MjTokenKind::VARIABLE_NAME: {
-        MjVariable *variable = new_item<MjVariable>(parse_token());
-        lhs = new_item<MjExpression>(tokens_since(start), variable);
-        break;
+    if (match_token(MjTokenKind::FUNCTION_NAME)) {
+        owner->append(parse_function(start, type));
+        return;
     }
 
-    case MjTokenKind::CONSTANT_NAME: {
-        MjVariable *constant = new_item<MjVariable>(parse_token());
-        lhs = new_item<MjExpression>(tokens_since(start), constant);
-        break;
+    if (!match_token(MjTokenKind::VARIABLE_NAME) && !match_token(MjTokenKind::CONSTANT_NAME)) {
+        error("Expected a name!");
+        recover();
+        return;
     }
 
-    case MjTokenKind::FUNCTION_NAME: {
-        const MjToken *function_name = parse_token();
-        MjTemplateArgumentList *template_argument_list = nullptr;
-        MjFunctionArgumentList *function_argument_list = nullptr;
+    // The variables of types are members, which are stored in every object of the type.
+    MjVariable *variable;
 
-        if (_token.kind() == MjTokenKind::OPEN_ANGLE_BRACKET) {
-            template_argument_list = parse_template_argument_list();
-        }
+    if (owner == _module) {
+        variable = new_item<MjVariable>(start, token(), type);
+    } else {
+        MjMember *member = new_item<MjMember>(start, token(), type);
 
-        if (_token.kind() == MjTokenKind::OPEN_PARENTHESIS) {
-            function_argument_list = parse_function_argument_list();
+        for (MjAnnotation *annotation : _annotations) {
+            member->append(annotation);
         }
 
-        MjFunction *function = new_item<MjFunction>(tokens_since(start), function_name, template_argument_list);
-        lhs = new_item<MjExpression>(tokens_since(start), function, function_argument_list);
-        break;
+        _annotations.clear();
+        variable = member;
     }
 
-    default:
-        // fallthrough
+    if (!_annotations.empty()) {
+        error(start, "Variables outside of types do not support annotations!");
+        _annotations.clear();
     }
 
-    // 
-    while (true) {
-        if (_token.kind() == MjTokenKind::NONE) {
-            break;
-        }
-
-        if (!_token.kind().is_operator()) {
-            error("Expected an operator!");
-            return nullptr;
-        }
-
-        MjOperatorKind op = MjOperatorKind::MULTIPLICATION;
+    if (!_comments.empty()) {
+        variable->set_comment(_comments[0]);
+        _comments.clear();
+    }
 
-        if (op.left_bp() < min_bp) {
-            break;
-        }
+    owner->append(variable);
+    skip_token();
 
-        parse_token();
-        MjExpression *rhs = parse_expression(op.right_bp());
-        lhs = new MjExpression(op, lhs, rhs);
+    if (parse_token(MjTokenKind::SET)) {
+        variable->set_value(parse_expression());
     }
 
-    return lhs;
+    if (!is_line_end() && !match_token(MjTokenKind::CLOSE_CURLY_BRACE)) {
+        error("Expected the end of the line!");
+        recover();
+    }
 }
 
 
+MjFunction *MjParser::parse_function(u32 token_index, MjType *return_type) noexcept {
+    MjFunction *function = new_item<MjFunction>(token_index, token(), return_type);
+    attach_prefix(function);
+    skip_token();
 
+    if (!parse_token(MjTokenKind::OPEN_PARENTHESIS)) {
+        error("Expected '('!");
+        recover();
+        return function;
+    }
 
+    skip_line_ends();
 
+    // The parameters are the variables of the function.
+    if (!parse_token(MjTokenKind::CLOSE_PARENTHESIS)) {
+        do {
+            skip_line_ends();
+            u32 start = _token_index;
+            MjType *type = parse_type();
 
+            if (type == nullptr) {
+                recover();
+                return function;
+            }
 
+            if (!match_token(MjTokenKind::VARIABLE_NAME)) {
+                error("Expected a parameter name!");
+                recover();
+                return function;
+            }
 
+            function->append(new_item<MjVariable>(start, token(), type));
+            skip_token();
+            skip_line_ends();
+        } while (parse_token(MjTokenKind::COMMA));
 
+        if (!parse_token(MjTokenKind::CLOSE_PARENTHESIS)) {
+            error("Expected ')'!");
+            recover();
+            return function;
+        }
+    }
 
+    if (!match_token(MjTokenKind::OPEN_CURLY_BRACE)) {
+        error("Expected '{'!");
+        recover();
+        return function;
+    }
 
+    parse_function_body(function);
+    return function;
+}
 
 
+///
+/// Types
+///
 
 
+MjType *MjParser::parse_type() noexcept {
+    u32 start = _token_index;
+    bool is_constant = false;
+    bool is_safe = false;
 
+    for (;; skip_token()) {
+        if (match_token(MjTokenKind::CONST)) {
+            is_constant = true;
+        } else if (match_token(MjTokenKind::SAFE)) {
+            is_safe = true;
+        } else {
+            break;
+        }
+    }
 
+    if (!match_token(MjTokenKind::TYPE_NAME)) {
+        error("Expected a type!");
+        return nullptr;
+    }
 
+    MjType *type = named_type(_token_index);
+    skip_token();
 
+    if (match_token(MjTokenKind::OPEN_ANGLE_BRACKET)) {
+        parse_template_argument_list();
+    }
 
+    // Safe types are constant types which may also be shared between threads.
+    if (is_safe) {
+        type = new_item<MjSafeType>(start, new_item<MjConstantType>(start, type));
+    } else if (is_constant) {
+        type = new_item<MjConstantType>(start, type);
+    }
 
+    for (;;) {
+        if (parse_token(MjTokenKind::POINTER_TYPE_MODIFIER)) {
+            type = new_item<MjPointerType>(start, type);
+        } else if (match_token(MjTokenKind::OPEN_SQUARE_BRACKET) && kind(next_index(_token_index)) == MjTokenKind::CLOSE_SQUARE_BRACKET) {
+            skip_token();
+            skip_token();
+            type = new_item<MjSliceType>(start, type);
+        } else if (match_token(MjTokenKind::OPEN_SQUARE_BRACKET) && kind(next_index(_token_index)) == MjTokenKind::NUMERIC_LITERAL && kind(next_index(next_index(_token_index))) == MjTokenKind::CLOSE_SQUARE_BRACKET) {
+            skip_token();
+            u32 array_size;
+
+            if (!parse_array_size(token_text(_token_index), array_size)) {
+                error("Expected a decimal array size!");
+                return nullptr;
+            }
 
+            skip_token();
+            skip_token();
+            type = new_item<MjArrayType>(start, type, array_size);
+        } else {
+            return type;
+        }
+    }
+}
 
 
+MjType *MjParser::named_type(u32 token_index) noexcept {
+    static constexpr struct {
+        std::string_view name;
+        MjItemKind item_kind;
+        u32 size;
+        bool is_unsigned;
+    } BUILTIN_TYPES[] = {
+        {"void", MjItemKind::VOID_TYPE,    0, false},
+        {"bool", MjItemKind::INTEGER_TYPE, 1, true},
+        {"u8",   MjItemKind::INTEGER_TYPE, 1, true},
+        {"u16",  MjItemKind::INTEGER_TYPE, 2, true},
+        {"u32",  MjItemKind::INTEGER_TYPE, 4, true},
+        {"u64",  MjItemKind::INTEGER_TYPE, 8, true},
+        {"i8",   MjItemKind::INTEGER_TYPE, 1, false},
+        {"i16",  MjItemKind::INTEGER_TYPE, 2, false},
+        {"i32",  MjItemKind::INTEGER_TYPE, 4, false},
+        {"i64",  MjItemKind::INTEGER_TYPE, 8, false},
+        {"f32",  MjItemKind::FLOAT_TYPE,   4, false},
+        {"f64",  MjItemKind::FLOAT_TYPE,   8, false},
+    };
+
+    StringView text = token_text(token_index);
+    MjType *&type = _types[to_string_view(text)];
+
+    if (type != nullptr) {
+        return type;
+    }
 
+    for (const auto &builtin_type : BUILTIN_TYPES) {
+        if (builtin_type.name != to_string_view(text)) {
+            continue;
+        }
 
+        if (builtin_type.item_kind == MjItemKind::INTEGER_TYPE) {
+            type = new_item<MjIntegerType>(token_index, builtin_type.is_unsigned, builtin_type.size);
+        } else {
+            type = new_item<MjBuiltinType>(token_index, builtin_type.item_kind, builtin_type.size);
+        }
 
+        return type;
+    }
 
+    MjTypeAlias *type_alias = new_item<MjTypeAlias>(token_index, nullptr);
+    type_alias->append(new_item<MjTypeName>(token_index, _tokens.token(token_index), text));
+    type = type_alias;
+    return type;
+}
 
 
+void MjParser::define_type(u32 token_index, MjType *type) noexcept {
+    MjType *named_type = this->named_type(token_index);
 
+    if (!named_type->is_type_alias()) {
+        error(token_index, "Builtin types can not be defined!");
+        return;
+    }
 
+    // A type defined twice is resolved to its first definition. Redefinitions are not diagnosed yet.
+    MjTypeAlias *type_alias = named_type->as<MjTypeAlias>();
 
+    if (!type_alias->is_resolved()) {
+        type_alias->set_base_type(type);
+    }
+}
 
 
+void MjParser::parse_template_argument_list() noexcept {
+    skip_token();
 
+    if (parse_token(MjTokenKind::CLOSE_ANGLE_BRACKET)) {
+        return;
+    }
 
+    do {
+        if (parse_type() == nullptr) {
+            return;
+        }
+    } while (parse_token(MjTokenKind::COMMA));
 
+    if (!parse_token(MjTokenKind::CLOSE_ANGLE_BRACKET)) {
+        error("Expected '>'!");
+    }
+}
 
 
+///
+/// Statements
+///
 
 
+MjBlockStatement *MjParser::parse_function_body(MjFunction *function) noexcept {
 
+    // A nested function body has its own tree, after which the enclosing tree is resumed.
+    MjFunction *enclosing_function = _function;
+    MjExpressionTree *expressions = _expressions;
+    _function = function;
+    _expressions = _item_manager.new_expression_tree(_module_id);
 
+    MjBlockStatement *body = parse_block_statement();
+    function->set_body(body, _expressions);
+    _function = enclosing_function;
+    _expressions = expressions;
+    return body;
+}
 
 
+MjBlockStatement *MjParser::parse_block_statement() noexcept {
+    MjBlockStatement *block = new_item<MjBlockStatement>(_token_index);
 
+    if (!parse_token(MjTokenKind::OPEN_CURLY_BRACE)) {
+        error("Expected '{'!");
+        return block;
+    }
 
+    while (!parse_token(MjTokenKind::CLOSE_CURLY_BRACE)) {
+        if (match_token(MjTokenKind::NONE)) {
+            error("Expected '}'!");
+            break;
+        }
 
+        if (parse_token(MjTokenKind::INDENT)) {
+            continue;
+        }
 
+        u32 error_count = _errors.size();
+        MjStatement *statement = parse_statement();
 
+        if (statement != nullptr) {
+            block->statements().push_back(statement);
+        }
 
+        if (_errors.size() != error_count) {
+            recover();
+        } else if (!is_line_end() && !match_token(MjTokenKind::CLOSE_CURLY_BRACE)) {
+            error("Expected the end of the line!");
+            recover();
+        }
+    }
 
+    return block;
+}
 
 
+MjStatement *MjParser::parse_statement() noexcept {
+    u32 start = _token_index;
 
+    switch (kind()) {
 
-
-
-
-
-MjTemplateParameterList *MjParser::parse_template_parameter_list() {
-    if (!parse_token(MjTokenKind::OPEN_ANGLE_BRACKET)) {
+    // Comments within bodies document the code rather than an item.
+    case MjTokenKind::BLOCK_COMMENT:
+    case MjTokenKind::FORMATTED_BLOCK_COMMENT: {
+        skip_token();
         return nullptr;
     }
 
-    MjTemplateParameterList *template_parameter_list;
-
-    if (allocate(template_parameter_list)) {
+    // Shell statements run to the end of the line. They are not represented in the AST yet.
+    case MjTokenKind::DOLLAR_SIGN: {
+        skip_line();
         return nullptr;
     }
 
-    do {
-        if (!parse_type_expression()) {
-            break;
-        }
-    } while (parse_token(MjTokenKind::COMMA));
+    case MjTokenKind::OPEN_CURLY_BRACE: {
+        return parse_block_statement();
+    }
 
-    if (!parse_token(MjTokenKind::CLOSE_ANGLE_BRACKET)) {
-        return nullptr;
+    case MjTokenKind::IF: {
+        return parse_if_statement();
     }
 
-    return template_parameter_list;
-}
+    case MjTokenKind::WHILE: {
+        return parse_while_loop();
+    }
 
+    case MjTokenKind::RETURN: {
+        skip_token();
+        return new_item<MjReturnStatement>(start, parse_optional_expression());
+    }
 
-MjTemplateArgument *MjParser::parse_template_argument() {
-    MjTemplateArgument *template_argument = new MjTemplateArgument();
+    case MjTokenKind::BREAK: {
+        skip_token();
+        return new_item<MjBreakStatement>(start, parse_optional_expression());
+    }
 
-    if (parse_token(MjTokenKind::TYPE)) {
-        if (!parse_type_name()) {
-            error("Missing type name!");
-        }
+    case MjTokenKind::CONTINUE: {
+        skip_token();
+        return new_item<MjContinueStatement>(start, parse_optional_expression());
+    }
 
-        if (parse_token(MjTokenKind::SET)) {
-            if (parse_type_expression()) {
-                error("Missing default type expression!");
-            }
-        }
-    } else if (parse_type_expression()) {
-        if (!parse_variable_name()) {
-            error("Missing variable name!");
-        }
+    case MjTokenKind::YIELD: {
+        skip_token();
+        return new_item<MjYieldStatement>(start, parse_expression());
+    }
 
-        if (parse_token(MjTokenKind::SET)) {
-            if (!parse_expression()) {
-                error("Missing default expression!");
-            }
+    // A type followed by a name declares a variable. Otherwise the type starts an expression, such
+    // as a constructor call.
+    case MjTokenKind::CONST:
+    case MjTokenKind::SAFE:
+    case MjTokenKind::TYPE_NAME: {
+        u32 name_index = skip_type(_token_index);
+
+        if (name_index != U32_MAX && (kind(name_index) == MjTokenKind::VARIABLE_NAME || kind(name_index) == MjTokenKind::CONSTANT_NAME)) {
+            return parse_local_variable();
         }
-    } else {
-        error("Invalid template argument!");
-        // Look for another ',' or '>' to synchronize, but we might be missing those...
-        // See what's next and go from there.
+
+        break;
     }
 
-    return template_argument;
+    default: {
+        break;
+    }
+    }
+
+    return parse_expression();
 }
 
 
-MjTemplateArgumentList *MjParser::parse_template_argument_list() {
-    MjTemplateArgumentList *template_argument_list = new MjTemplateArgumentList();
+MjStatement *MjParser::parse_if_statement() noexcept {
+    u32 start = _token_index;
+    skip_token();
+    MjExpression *condition = parse_expression();
 
-    if (!parse_token(MjTokenKind::OPEN_ANGLE_BRACKET)) {
+    if (condition == nullptr) {
         return nullptr;
     }
 
-    do {
-        if (parse_token(MjTokenKind::TYPE)) {
-            if (!parse_type_name()) {
-                error("Missing type name!");
-            }
+    u32 then_start = _token_index;
+    MjThenStatement *then_statement = new_item<MjThenStatement>(then_start, parse_block_statement());
+    MjIfStatement *if_statement = new_item<MjIfStatement>(start, condition, then_statement);
 
-            if (parse_token(MjTokenKind::SET)) {
-                if (parse_type_expression()) {
-                    error("Missing default type expression!");
-                }
-            }
-        } else if (parse_type_expression()) {
-            if (!parse_variable_name()) {
-                error("Missing variable name!");
-            }
+    // The else statement may start the line following the then statement.
+    u32 else_start = _token_index;
 
-            if (parse_token(MjTokenKind::SET)) {
-                if (!parse_expression()) {
-                    error("Missing default expression!");
-                }
-            }
-        } else {
-            error("Invalid template argument!");
-            // Look for another ',' or '>' to synchronize, but we might be missing those...
-            // See what's next and go from there.
-        }
-    } while (parse_token(MjTokenKind::COMMA));
+    if (match_token(MjTokenKind::INDENT) && kind(next_index(_token_index)) == MjTokenKind::ELSE) {
+        else_start = next_index(_token_index);
+    }
 
-    if (!parse_token(MjTokenKind::CLOSE_ANGLE_BRACKET)) {
-        return nullptr;
+    if (kind(else_start) == MjTokenKind::ELSE) {
+        _token_index = else_start;
+        skip_token();
+        MjStatement *body = match_token(MjTokenKind::IF) ? parse_if_statement() : parse_block_statement();
+        if_statement->set_else_statement(new_item<MjElseStatement>(else_start, body));
     }
 
-    return template_argument_list;
+    return if_statement;
 }
 
 
-MjFunctionParameterList *MjParser::parse_function_parameter_list() {
-
-    if (!parse_token(MjTokenKind::OPEN_PARENTHESIS)) {
-        return nullptr;
-    }
-
-    do {
-        if (parse_type_expression()) {
-        }
-    } while (parse_token(MjTokenKind::COMMA));
+MjStatement *MjParser::parse_while_loop() noexcept {
+    u32 start = _token_index;
+    skip_token();
+    MjExpression *condition = parse_expression();
 
-    if (!parse_token(MjTokenKind::CLOSE_PARENTHESIS)) {
-        restore(pos);
+    if (condition == nullptr) {
         return nullptr;
     }
 
-    return nullptr;
+    return new_item<MjWhileLoop>(start, condition, parse_block_statement());
 }
 
 
-MjFunctionArgumentList *MjParser::parse_function_argument_list() {
+MjStatement *MjParser::parse_local_variable() noexcept {
+    u32 start = _token_index;
+    MjType *type = parse_type();
 
-    if (!parse_token(MjTokenKind::OPEN_PARENTHESIS)) {
+    if (type == nullptr) {
         return nullptr;
     }
 
-    do {
-        if (!parse_type_expression()) {
-            break;
-        }
-    } while (parse_token(MjTokenKind::COMMA));
+    u32 name_index = _token_index;
+    _function->append_local(new_item<MjVariable>(start, token(), type));
 
-    if (!parse_token(MjTokenKind::CLOSE_PARENTHESIS)) {
-        restore(pos);
+    // A variable declared without a value is initialized by its first assignment.
+    if (kind(next_index(name_index)) != MjTokenKind::SET) {
+        skip_token();
         return nullptr;
     }
 
-    return nullptr;
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-MjType *MjParser::parse_type_definition() noexcept {
-    return nullptr;
+    return parse_expression();
 }
 
 
-
-MjBitfieldType *MjParser::parse_bitfield_type_definition() noexcept {
-    parse_token(MjTokenKind::BITFIELD);
-    MjToken name = parse_token(MjTokenKind::TYPE_NAME);
-    //templates;
-    parse_token(MjTokenKind::OPEN_ANGLE_BRACKET);
-
-    //types;
-    //members;
-    //methods;
-
-    // Scan the definition body.
-    while (!parse_token(MjTokenKind::CLOSE_CURLY_BRACE)) {
-
-        // Parse comment.
-        field_comment = parse_comment();
-
-        // Parse attributes.
-        while (peek_token().kind() == MjTokenKind::AT) {
-            field_annotation = parse_annotation();
-
-            if (!field_annotation) {
-                return nullptr;
-            }
-
-            field_annotations.append(field_annotation);
-        }
-
-        // Parse field definition.
-        if (parse_token(MjTokenKind::OPEN_SQUARE_BRACKET)) {
-
-            // Parse field ID.
-            MjExpression *field_id = parse_expression();
-
-            if (!parse_token(MjTokenKind::CLOSE_SQUARE_BRACKET)) {
-                error("Expected ']'!");
-                break;
-            }
-
-            // Parse optional field type.
-            field_type = parse_type_name();
-
-            // Parse optional field name.
-            field_name = parse_variable_name();
-
-            // Parse optional field default value.
-            if (parse_token(MjTokenKind::SET)) {
-                field_value = parse_expression();
-            }
-
-            if (field_name == nullptr && field_value == nullptr) {
-                error("Anonymous bitfield without default value!");
-                break;
-            }
-
-            bitfield.fields.append({field_name, field_comment, field_annotations, field_type, field_value});
-        } else {
-            error("Expected a field definition!");
-        }
+MjExpression *MjParser::parse_optional_expression() noexcept {
+    if (is_line_end() || match_token(MjTokenKind::CLOSE_CURLY_BRACE)) {
+        return nullptr;
     }
 
-    return nullptr;
+    return parse_expression();
 }
 
 
-bool MjParser::verify_bitfield_type_definition(const MjBitfieldType &bitfield) noexcept {
-    if (bitfield.) {
+///
+/// Expressions
+///
 
-    }
-    return true;
-}
 
+MjExpression *MjParser::parse_expression(u32 min_bp) noexcept {
+    u32 first_index = _expressions->size();
+    u32 index = parse_expression_node(min_bp);
 
-// Parse a class definition:
-//
-// - Parse the class type declaration (class Name<>)
-// - Parse the class definition scope ({...})
-//     - Parse import statements
-//     - Parse type aliases
-//     - Parse the member, shared, and implementation declarations (everything before '{', '=', or ';')
-//     - Verify type references
-//     - Parse the member, shared, and implementation definitions
-MjClassType *MjParser::parse_class_type_definition() noexcept {
-    parse_token(MjTokenKind::CLASS);
-    MjToken name = parse_token(MjTokenKind::TYPE_NAME);
-    //templates;
-    parse_token(MjTokenKind::OPEN_ANGLE_BRACKET);
-
-    //types;
-    //members;
-    //methods;
-
-    // Scan the class.
-    while (true) {
-        MjToken token = peek_token();
-
-        if (token.kind() == MjTokenKind::CLOSE_CURLY_BRACE) {
-            break;
-        } else if (token.kind() == MjTokenKind::SHARED) {
-            ;
-        } else if (token.kind() == MjTokenKind::IMPLEMENTS) {
-            ;
-        } else if (token.kind() == MjTokenKind::TYPE) {
-            next_token();
-            typevar = parse_variable();
-            types.append(MjType(typevar.name, ));
-        } else {
-            type = parse_type();
-
-            if (isinstance(type, MjFunctionType)) {
-                methods.append(type);
-
-                if (parse_token(MjTokenKind::OPEN_CURLY_BRACE)) {
-                    depth = 1;
-
-                    while (depth) {
-                        token = next_token();
-
-                        if (token.kind() == MjTokenKind::OPEN_CURLY_BRACE) {
-                            depth += 1;
-                        } else if (token.kind() == MjTokenKind::OPEN_CURLY_BRACE) {
-                            depth -= 1;
-                        }
-
-                        method_body.append(token);
-                    }
-                } else if (token.kind() == MjTokenKind::SET) {
-                    ;
-                } else if (token.kind() == MjTokenKind::SEMICOLON) {
-                    // Method declarations belong in interfaces!
-                    raise SyntaxError("Classes may not contain method declarations!");
-                }
-            }
-
-            members.append(type);
-        }
+    if (index == MjExpressionTree::NONE) {
+        return nullptr;
     }
-}
-
 
-void MjParser::parse_interface_type_definition(MjType &type) {
+    return new_item<MjTreeExpression>(_expressions->node(index).token_index, _expressions, first_index, index);
 }
 
 
+u32 MjParser::parse_expression_node(u32 min_bp) noexcept {
+    /// This is a Pratt parser implementation.
+    ///
+    /// We consider the binding power of an operator to convey both associativity and precedence.
+    /// Binding power is the edge of a graph where both operators and terminals are the nodes.
+    /// Terminals are bound to only one operator at a time and the greatest binding power
+    /// wins.
+    ///
+    /// The nodes are appended to the expression tree after their operands, so no item is created
+    /// for the operands and operators of the expression.
+    u32 start = _token_index;
+    u32 lhs = MjExpressionTree::NONE;
 
+    switch (kind()) {
 
-MjStructureType *MjParser::parse_structure_type_definition() {
-    if (!parse_token(MjTokenKind::STRUCT)) {
-        return;
+    case MjTokenKind::OPEN_CAST: {
+        skip_token();
+        MjType *type = parse_type();
+        parse_token(MjTokenKind::COLON);
+        u32 operand = parse_expression_node(0);
+        parse_token(MjTokenKind::CLOSE_CAST);
+        lhs = append_expression_node(MjExpressionNodeKind::CAST, MjOperatorKind::BITWISE_CAST, start, operand, _expressions->append_type(type));
+        break;
     }
 
-    MjToken name = parse_token(MjTokenKind::TYPE_NAME);
-
-    if (name != nullptr) {
-        // Check for either a template argument list or a template parameter list.
-        // If we find a template argument list, then this is a new structure type template or a partial specialization.
-        // If we find a template parameter list, then this is a structure type template specialization.
-        MjTemplateArgumentList *template_argument_list;
-
-        if (template_argument_list != nullptr) {
-            if (template_argument_list->is_partial_specialization()) {
-                ;
-            }
-        } else {
-            MjTemplateParameterList *template_parameter_list;
-            if (template_parameter_list != nullptr) {
-                ;
-            }
-        }
+    case MjTokenKind::TYPE_NAME: {
+        MjType *type = parse_type();
+        lhs = append_expression_node(MjExpressionNodeKind::TYPE, MjOperatorKind::NONE, start, MjExpressionTree::NONE, _expressions->append_type(type));
+        break;
     }
 
-    MjType structure_type = MjType(MjTypeType::STRUCTURE, name, comment, annotations);
-
-    // Check for an optional inline instance declaration.
-    MjToken instance_name = parse_token(MjTokenKind::VARIABLE_NAME);
-
-    if (instance_name == nullptr) {
-        instance_name = parse_token(MjTokenKind::CONSTANT_NAME);
+    case MjTokenKind::UNINITIALIZED: {
+        skip_token();
+        lhs = append_expression_node(MjExpressionNodeKind::UNINITIALIZED, MjOperatorKind::NONE, start, MjExpressionTree::NONE, MjExpressionTree::NONE);
+        break;
     }
 
-    // Parse the declaration body.
-    if (!parse_token(MjTokenKind::OPEN_CURLY_BRACE)) {
-        error("Missing opening curly brace!");
-        return;
+    case MjTokenKind::NULL_: {
+        skip_token();
+        lhs = append_expression_node(MjExpressionNodeKind::NULL_, MjOperatorKind::NONE, start, MjExpressionTree::NONE, MjExpressionTree::NONE);
+        break;
     }
 
-    while (true) {
-        MjItem *item = parse_item();
-
-        if (!parse_token(MjTokenKind::OPEN_CURLY_BRACE)) {
-            error("Missing opening curly brace!");
-            return nullptr;
-        }
+    // The unit of a quantity such as `1.5 Hz` is part of its literal.
+    case MjTokenKind::NUMERIC_LITERAL: {
+        skip_token();
+        parse_token(MjTokenKind::UNIT_EXPRESSION);
+        lhs = append_expression_node(MjExpressionNodeKind::LITERAL, MjOperatorKind::NONE, start, MjExpressionTree::NONE, MjExpressionTree::NONE);
+        break;
     }
 
-    // Parse the optional, inline instance variable declaration statement.
-    if (instance_name != nullptr) {
-        MjLocalVariable instance_variable(instance_name);
-        MjVariableDeclarationStatement instance_declaration(instance_variable);
+    case MjTokenKind::TRUE:
+    case MjTokenKind::FALSE:
+    case MjTokenKind::STRING_LITERAL:
+    case MjTokenKind::RAW_STRING_LITERAL:
+    case MjTokenKind::INTERPOLATED_STRING_LITERAL: {
+        skip_token();
+        lhs = append_expression_node(MjExpressionNodeKind::LITERAL, MjOperatorKind::NONE, start, MjExpressionTree::NONE, MjExpressionTree::NONE);
+        break;
     }
-}
-
-
-void MjParser::parse_union_type_definition(MjType &type) {
-}
-
-
-void MjParser::parse_variant_type_definition(MjType &type) {
-}
-
 
-MjComment *MjParser::parse_comment() {
-    bool is_formatted = false;
-
-    switch (_token->kind()) {
-    case MjTokenKind::FORMATTED_LINE_COMMENT:
-        is_formatted = true;
-        // fallthrough
-    case MjTokenKind::LINE_COMMENT:
-        return new MjComment(token_text().slice(3).data(), is_formatted);
-    case MjTokenKind::FORMATTED_BLOCK_COMMENT:
-        is_formatted = true;
-        // fallthrough
-    case MjTokenKind::BLOCK_COMMENT: {
-        String text;
+    // The output of a shell command such as `$(ls -a)` is a string literal evaluated at run time.
+    case MjTokenKind::DOLLAR_SIGN: {
+        skip_token();
 
-        do {
-            text.append(token_text().slice(4).data(), token_text().slice(4).size());
-            parse_token(MjTokenKind::INDENT);
-        } while (parse_token(MjTokenKind::BLOCK_COMMENT) || parse_token(MjTokenKind::FORMATTED_BLOCK_COMMENT));
+        if (!parse_token(MjTokenKind::OPEN_PARENTHESIS)) {
+            error("Expected '('!");
+            return MjExpressionTree::NONE;
+        }
 
-        return new MjComment(text, is_formatted);
-    }
-    default:
-        return nullptr;
-    }
-}
+        for (u32 depth = 1; depth > 0; skip_token()) {
+            if (is_line_end()) {
+                error("Expected ')'!");
+                return MjExpressionTree::NONE;
+            }
 
+            depth += match_token(MjTokenKind::OPEN_PARENTHESIS);
+            depth -= match_token(MjTokenKind::CLOSE_PARENTHESIS);
+        }
 
-void MjParser::parse_type_alias(MjType &type_alias) {
-    if (!parse_token(MjTokenKind::TYPE)) {
-        return;
+        lhs = append_expression_node(MjExpressionNodeKind::LITERAL, MjOperatorKind::NONE, start, MjExpressionTree::NONE, MjExpressionTree::NONE);
+        break;
     }
 
-    MjTemplateArgumentList *template_argument_list = parse_template_argument_list();
+    // A parenthesis followed by a type and a colon starts a cast such as `(u8: a)`.
+    case MjTokenKind::OPEN_PARENTHESIS: {
+        skip_token();
+        skip_line_ends();
+        u32 colon_index = skip_type(_token_index);
 
-    if (template_argument_list == nullptr) {
-        return;
-    }
+        if (colon_index != U32_MAX && kind(colon_index) == MjTokenKind::COLON) {
+            MjType *type = parse_type();
+            skip_token();
+            u32 operand = parse_expression_node(0);
+            skip_line_ends();
 
-    const MjToken *name = parse_token(MjTokenKind::TYPE_NAME);
+            if (!parse_token(MjTokenKind::CLOSE_PARENTHESIS)) {
+                error("Expected ')'!");
+            }
 
-    if (name == nullptr) {
-        return;
-    }
+            lhs = append_expression_node(MjExpressionNodeKind::CAST, MjOperatorKind::BITWISE_CAST, start, operand, _expressions->append_type(type));
+            break;
+        }
 
-    type_alias = MjType(MjTypeType::ALIAS, name);
-}
+        lhs = parse_expression_node(0);
+        skip_line_ends();
 
+        if (!parse_token(MjTokenKind::CLOSE_PARENTHESIS)) {
+            error("Expected ')'!");
+        }
 
-void MjParser::parse_type_alias_template(MjTypeTemplate &type_alias_definition) {
-    if (!parse_token(MjTokenKind::TYPE)) {
-        return;
+        break;
     }
 
-    MjTemplateArgumentList *template_argument_list = parse_template_argument_list();
-
-    if (template_argument_list == nullptr) {
-        return;
+    case MjTokenKind::OPEN_SQUARE_BRACKET: {
+        skip_token();
+        lhs = parse_array(start);
+        break;
     }
 
-    const MjToken *name = parse_token(MjTokenKind::TYPE_NAME);
-
-    if (name == nullptr) {
-        return;
+    case MjTokenKind::VARIABLE_NAME: {
+        skip_token();
+        lhs = append_expression_node(MjExpressionNodeKind::VARIABLE, MjOperatorKind::NONE, start, MjExpressionTree::NONE, MjExpressionTree::NONE);
+        break;
     }
 
-    MjTemplateParameterList *template_parameter_list = parse_template_parameter_list();
-
-    if (template_parameter_list == nullptr) {
-        return;
+    case MjTokenKind::CONSTANT_NAME: {
+        skip_token();
+        lhs = append_expression_node(MjExpressionNodeKind::CONSTANT, MjOperatorKind::NONE, start, MjExpressionTree::NONE, MjExpressionTree::NONE);
+        break;
     }
 
-    type_alias_definition = MjType(MjTypeTemplateType::ALIAS, name, template_parameter_list);
-}
-
-
-void MjParser::parse_type_enumeration(MjType &type) {
-    MjType *type_enumeration = new MjType();
-    parse_token(MjTokenKind::ENUM);
-    parse_token(MjTokenKind::OPEN_ANGLE_BRACKET);
-    MjType *index_type = parse_type_name();
-
-    if (index_type == nullptr) {
-        return nullptr;
-    }
+    case MjTokenKind::FUNCTION_NAME: {
+        skip_token();
 
-    MjVariable *index_variable = parse_variable_declaration();
+        if (match_token(MjTokenKind::OPEN_ANGLE_BRACKET)) {
+            parse_template_argument_list();
+        }
 
-    if (index_variable == nullptr) {
-        ;
+        lhs = append_expression_node(MjExpressionNodeKind::FUNCTION, MjOperatorKind::NONE, start, MjExpressionTree::NONE, MjExpressionTree::NONE);
+        break;
     }
 
-    parse_token(MjTokenKind::CLOSE_ANGLE_BRACKET);
-    const MjToken *name = parse_token(MjTokenKind::TYPE_NAME);
-    return type_enumeration;
-}
-
+    default: {
+        MjOperatorKind op = MjOperatorKind::from_prefix_token(kind());
 
-MjType *MjParser::parse_type_implementation() {
-    MjTypeImplementation *type_implementation;
-    return type_implementation;
-}
+        if (op == MjOperatorKind::NONE) {
+            error("Expected an expression!");
+            return MjExpressionTree::NONE;
+        }
 
+        skip_token();
+        u32 operand = parse_expression_node(op.right_bp());
 
-MjAnnotation *MjParser::parse_annotation() {
-    if (!parse_token(MjTokenKind::AT)) {
-        return nullptr;
-    }
+        if (operand == MjExpressionTree::NONE) {
+            return MjExpressionTree::NONE;
+        }
 
-    if (match_token(MjTokenKind::ANNOTATION_NAME)) {
-        error("Expected annotation name after '@'!");
-        return nullptr;
+        lhs = append_expression_node(MjExpressionNodeKind::UNARY, op, start, operand, MjExpressionTree::NONE);
     }
-
-    const MjToken *name = parse_token();
-
-    if (!parse_token(MjTokenKind::OPEN_PARENTHESIS)) {
-        return new MjAnnotation(name);
     }
 
-    MjAnnotationArgumentList argument_list;
+    // Bind operators following the operand for as long as they bind tighter than the enclosing operator.
+    while (lhs != MjExpressionTree::NONE) {
+        MjOperatorKind op = MjOperatorKind::from_infix_token(kind());
 
-    do {
-        if (!match_token(MjTokenKind::ANNOTATION_NAME)) {
-            error("Expected annotation argument!");
-            return nullptr;
+        if (op == MjOperatorKind::NONE || op.left_bp() < min_bp) {
+            break;
         }
 
-        argument_list.append(parse_token());
+        skip_token();
 
-        if (parse_token(MjTokenKind::CLOSE_PARENTHESIS)) {
-            break;
-        }
-    } while (!parse_token(MjTokenKind::COMMA));
+        if (op == MjOperatorKind::FUNCTION_CALL) {
+            bool is_constructor = _expressions->node(lhs).kind == MjExpressionNodeKind::TYPE;
+            lhs = parse_call_arguments(is_constructor ? MjOperatorKind::CONSTRUCTOR_CALL : op, start, lhs);
+        } else if (op == MjOperatorKind::SUBSCRIPT) {
+            u32 index = parse_expression_node(0);
 
-    return new MjAnnotation(name, argument_list);
-}
+            if (index == MjExpressionTree::NONE) {
+                return MjExpressionTree::NONE;
+            }
 
+            if (!parse_token(MjTokenKind::CLOSE_SQUARE_BRACKET)) {
+                error("Expected ']'!");
+            }
 
-MjStatement *MjParser::parse_variable_declaration() {
-    MjStatement *statement = new MjStatement();
-    MjType *type = parse_type_expression();
+            lhs = append_expression_node(MjExpressionNodeKind::BINARY, op, start, lhs, index);
+        } else if (op.is_postfix()) {
+            lhs = append_expression_node(MjExpressionNodeKind::UNARY, op, start, lhs, MjExpressionTree::NONE);
+        } else {
+            u32 rhs = parse_expression_node(op.right_bp());
 
-    // Check for initialization.
-    if (parse_token(MjTokenKind::SET)) {
-        statement->set_initial_value(parse_expression());
+            if (rhs == MjExpressionTree::NONE) {
+                return MjExpressionTree::NONE;
+            }
 
-        if (!parse_token(MjTokenKind::INDENT)) {
-            // not the end of statement?
+            lhs = append_expression_node(MjExpressionNodeKind::BINARY, op, start, lhs, rhs);
         }
     }
 
-    return statement;
+    return lhs;
 }
 
 
+u32 MjParser::parse_call_arguments(MjOperatorKind operator_kind, u32 token_index, u32 callee) noexcept {
+    u32 first_argument = MjExpressionTree::NONE;
+    u32 last_argument = MjExpressionTree::NONE;
+    u16 argument_count = 0;
+    skip_line_ends();
 
+    if (!parse_token(MjTokenKind::CLOSE_PARENTHESIS)) {
+        do {
+            skip_line_ends();
+            u32 argument = parse_expression_node(0);
 
+            if (argument == MjExpressionTree::NONE) {
+                return MjExpressionTree::NONE;
+            }
 
+            // The arguments are linked in order through their root nodes.
+            if (last_argument == MjExpressionTree::NONE) {
+                first_argument = argument;
+            } else {
+                _expressions->node(last_argument).next = argument;
+            }
 
+            last_argument = argument;
+            argument_count += 1;
+            skip_line_ends();
+        } while (parse_token(MjTokenKind::COMMA));
 
-
-
-
-
-
-
-
-
-
-MjUnit *MjParser::parse_unit_expression() {
-    MjUnit &unit = _units.allocate();
-    // parse an expression
-    // operators: /*^+-()
-    // identifiers + special unicode characters
-
-    while (true) {
-        if (ch >= '0' && ch <= '9') {
-            ;// digit
+        if (!parse_token(MjTokenKind::CLOSE_PARENTHESIS)) {
+            error("Expected ')'!");
         }
     }
-    return unit;
-}
-
-
 
+    u32 call = append_expression_node(MjExpressionNodeKind::CALL, operator_kind, token_index, callee, first_argument);
+    _expressions->node(call).argument_count = argument_count;
+    return call;
+}
 
 
+u32 MjParser::parse_array(u32 token_index) noexcept {
+    u32 first_element = MjExpressionTree::NONE;
+    u32 last_element = MjExpressionTree::NONE;
+    u16 element_count = 0;
 
-bool MjParser::parse_unit_exponent() {
-    u32 i = 0;
+    // The elements are linked like the arguments of a call, and may end with a comma.
+    for (skip_line_ends(); !parse_token(MjTokenKind::CLOSE_SQUARE_BRACKET); skip_line_ends()) {
+        u32 element = parse_expression_node(0);
 
-    if (_line[i] == '^') {
-        i += 1;
-        // ^-?[0-9]+(/[0-9]+)?
-        for (u32 state = 0; state < 4;) {
-            switch (state) {
-            case 0: // -(?=\d)
-                break;
-            case 1: // \d+
-                break;
-            case 2: // /(?=\d)
-                break;
-            case 3: // \d+
-                break;
-            }
+        if (element == MjExpressionTree::NONE) {
+            return MjExpressionTree::NONE;
         }
-    } else {
-
-        // ⁻?[⁰¹²³⁴⁵⁶⁷⁸⁹]+(⸍[⁰¹²³⁴⁵⁶⁷⁸⁹]+)?
-        for (u32 state = 0; state < 4;) {
-
-            // Get the codepoint.
-            if (i + 1u == _line.size()) {
-                break;
-            }
-
-            u32 value = (_line[i] << 8) | _line[i + 1];
-            i += 2;
-
-            switch (value) {
-            case 0xC2B2u: // '²'
-            case 0xC2B3u: // '³'
-            case 0xC2B9u: // '¹'
-                value &= 0x37u;
-                break;
-            default:
-                if (i == _line.size()) {
-                    i -= 2;
-                    break;
-                }
-
-                value = (value << 8) | _line[i];
-                i += 1;
-
-                switch (value) {
-                case 0xE281B0u: // '⁰'
-                case 0xE281B4u: // '⁴'
-                case 0xE281B5u: // '⁵'
-                case 0xE281B6u: // '⁶'
-                case 0xE281B7u: // '⁷'
-                case 0xE281B8u: // '⁸'
-                case 0xE281B9u: // '⁹'
-                    value &= 0x3Fu;
-                    break;
-                case 0xE281BBu: // '⁻'
-                    value = '-';
-                    break;
-                case 0xE2B88Du: // '⸍'
-                    value = '/';
-                    break;
-                default:
-                    i -= 3;
-                }
-            }
 
-            switch (state) {
-            case 0: // -
-                break;
-            case 1: // [⁰¹²³⁴⁵⁶⁷⁸⁹]+
-                break;
-            case 2: // ⸍
-                break;
-            case 3: // [⁰¹²³⁴⁵⁶⁷⁸⁹]+
-                break;
-            }
+        if (last_element == MjExpressionTree::NONE) {
+            first_element = element;
+        } else {
+            _expressions->node(last_element).next = element;
         }
-    }
 
-    // -?[0-9]+(/[0-9]+)?
-    for (u32 state = 0; state < 4;) {
-        u32 value = 0;
-
-        switch (state) {
-        case 0: // -(?=\d)
-            if (value == '-') {
-            }
+        last_element = element;
+        element_count += 1;
+        skip_line_ends();
 
-            state = 1;
-            break;
-        case 1: // \d+
-            if (value - '0' >= 10) {
-                state = 2;
-            }
-
-            break;
-        case 2: // /(?=\d)
-            if (value == '/') {
-                state = 3;
-            }
-
-            break;
-        case 3: // \d+
-            break;
+        if (!parse_token(MjTokenKind::COMMA) && !match_token(MjTokenKind::CLOSE_SQUARE_BRACKET)) {
+            error("Expected ']'!");
+            return MjExpressionTree::NONE;
         }
     }
 
-    if (value == '-' || value == '/') {
-        // missing numerator or denominator of exponent.
-        return false;
-    }
-
-    append_token(MjTokenKind::UNIT, i);
-    return true;
+    u32 array = append_expression_node(MjExpressionNodeKind::ARRAY, MjOperatorKind::NONE, token_index, MjExpressionTree::NONE, first_element);
+    _expressions->node(array).argument_count = element_count;
+    return array;
 }
@@ -0,0 +1,71 @@
+#include <mj/MjStringInterner.hpp>
+
+#include <algorithm>
+
+
+u32 MjStringInterner::size() noexcept {
+    u32 size = 0;
+
+    for (Shard &shard : _shards) {
+        std::lock_guard lock(shard.mutex);
+        size += shard.strings.size();
+    }
+
+    return size;
+}
+
+
+u32 MjStringInterner::insert(StringView string) noexcept {
+    u32 shard_index = shard_of(string);
+    Shard &shard = _shards[shard_index];
+    std::lock_guard lock(shard.mutex);
+    return shard.strings.insert(string) << LOG2_SHARD_COUNT | shard_index;
+}
+
+
+void MjStringInterner::insert(const StringView *strings, u32 *ids, u32 size) noexcept {
+    std::vector<u32> shard_indices(size);
+    u32 shard_sizes[SHARD_COUNT] = {};
+
+    for (u32 i = 0; i < size; ++i) {
+        shard_indices[i] = shard_of(strings[i]);
+        shard_sizes[shard_indices[i]] += 1;
+    }
+
+    // Sort the string indices by shard with a counting sort.
+    u32 shard_offsets[SHARD_COUNT + 1] = {};
+
+    for (u32 shard_index = 0; shard_index < SHARD_COUNT; ++shard_index) {
+        shard_offsets[shard_index + 1] = shard_offsets[shard_index] + shard_sizes[shard_index];
+    }
+
+    std::vector<u32> order(size);
+    u32 shard_ends[SHARD_COUNT];
+    std::copy(shard_offsets, shard_offsets + SHARD_COUNT, shard_ends);
+
+    for (u32 i = 0; i < size; ++i) {
+        order[shard_ends[shard_indices[i]]++] = i;
+    }
+
+    for (u32 shard_index = 0; shard_index < SHARD_COUNT; ++shard_index) {
+        if (shard_sizes[shard_index] == 0) {
+            continue;
+        }
+
+        Shard &shard = _shards[shard_index];
+        std::lock_guard lock(shard.mutex);
+
+        for (u32 i = shard_offsets[shard_index]; i < shard_offsets[shard_index + 1]; ++i) {
+            ids[order[i]] = shard.strings.insert(strings[order[i]]) << LOG2_SHARD_COUNT | shard_index;
+        }
+    }
+}
+
+
+u32 MjStringInterner::search(StringView string) const noexcept {
+    u32 shard_index = shard_of(string);
+    const Shard &shard = _shards[shard_index];
+    std::lock_guard lock(shard.mutex);
+    u32 id = shard.strings.search(string);
+    return shard.strings.has_string_id(id) ? id << LOG2_SHARD_COUNT | shard_index : U32_MAX;
+}
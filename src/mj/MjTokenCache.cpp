@@ -0,0 +1,64 @@
+#include <mj/MjTokenCache.hpp>
+
+#include <atomic>
+#include <cinttypes>
+
+#include <unistd.h>
+
+
+MjTokenCache::MjTokenCache(std::filesystem::path dir, bool emit_subtokens) noexcept :
+    _dir(dir),
+    _emit_subtokens(emit_subtokens)
+{
+    std::error_code error;
+    std::filesystem::create_directories(_dir, error);
+}
+
+
+MjSourceFile *MjTokenCache::parse_file(std::filesystem::path file_path) const noexcept {
+    MjSourceText text;
+
+    if (text.load(file_path).is_failure()) {
+        return nullptr;
+    }
+
+    std::filesystem::path path = entry_path(text.hash());
+    std::error_code error;
+
+    if (std::filesystem::is_regular_file(path, error)) {
+        MjSourceFile *file = MjSourceFile::decode(path, file_path, std::move(text));
+
+        if (file != nullptr) {
+            return file;
+        }
+
+        // The entry is stale or damaged. Lex the file again and replace it.
+    }
+
+    MjSourceFile *file = MjLexer::parse_text(file_path, std::move(text), _emit_subtokens);
+
+    // Write to a name unique to this process and thread so that a reader never sees a partial entry.
+    static std::atomic<u32> temp_id = 0;
+    std::filesystem::path temp_path = path;
+    temp_path += "." + std::to_string(getpid()) + "." + std::to_string(temp_id++) + ".tmp";
+
+    if (file->encode(temp_path).is_failure()) {
+        std::filesystem::remove(temp_path, error);
+        return file;
+    }
+
+    std::filesystem::rename(temp_path, path, error);
+
+    if (error) {
+        std::filesystem::remove(temp_path, error);
+    }
+
+    return file;
+}
+
+
+std::filesystem::path MjTokenCache::entry_path(u64 hash) const noexcept {
+    char name[32];
+    snprintf(name, sizeof(name), "%016" PRIx64 "%s.mjt", hash, _emit_subtokens ? ".sub" : "");
+    return _dir / name;
+}
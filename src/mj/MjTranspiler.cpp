@@ -0,0 +1,599 @@
+#include <mj/MjTranspiler.hpp>
+#include <mj/ast/MjArrayType.hpp>
+#include <mj/ast/MjBlockStatement.hpp>
+#include <mj/ast/MjConstantType.hpp>
+#include <mj/ast/MjEnumerationType.hpp>
+#include <mj/ast/MjFunction.hpp>
+#include <mj/ast/MjIfStatement.hpp>
+#include <mj/ast/MjIntegerType.hpp>
+#include <mj/ast/MjMember.hpp>
+#include <mj/ast/MjPointerType.hpp>
+#include <mj/ast/MjReturnStatement.hpp>
+#include <mj/ast/MjSafeType.hpp>
+#include <mj/ast/MjTypeAlias.hpp>
+#include <mj/ast/MjVariable.hpp>
+#include <mj/ast/MjWhileLoop.hpp>
+#include <c/CPrinter.hpp>
+
+#include <bit>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+static StringView view_of(const std::string &string) noexcept {
+    return StringView(reinterpret_cast<const u8 *>(string.data()), string.size());
+}
+
+
+/// Return the C operator of an Mj operator with the same meaning, or null.
+static const COperator *operator_of(MjOperatorKind kind) noexcept {
+    switch (kind) {
+    case MjOperatorKind::SET: return &COperator::SET;
+    case MjOperatorKind::MUL_SET: return &COperator::MUL_SET;
+    case MjOperatorKind::DIV_SET: return &COperator::DIV_SET;
+    case MjOperatorKind::MOD_SET: return &COperator::MOD_SET;
+    case MjOperatorKind::ADD_SET: return &COperator::ADD_SET;
+    case MjOperatorKind::SUB_SET: return &COperator::SUB_SET;
+    case MjOperatorKind::LSL_SET: return &COperator::LSL_SET;
+    case MjOperatorKind::ASR_SET: return &COperator::ASR_SET;
+    case MjOperatorKind::AND_SET: return &COperator::AND_SET;
+    case MjOperatorKind::XOR_SET: return &COperator::XOR_SET;
+    case MjOperatorKind::OR_SET: return &COperator::OR_SET;
+    case MjOperatorKind::SUBSCRIPT: return &COperator::SUBSCRIPT;
+    case MjOperatorKind::SHIFT_LEFT:
+    case MjOperatorKind::SLIDE_LEFT: return &COperator::LSL;
+    case MjOperatorKind::SHIFT_RIGHT: return &COperator::ASR;
+    case MjOperatorKind::MULTIPLICATION: return &COperator::MUL;
+    case MjOperatorKind::DIVISION: return &COperator::DIV;
+    case MjOperatorKind::REMAINDER: return &COperator::MOD;
+    case MjOperatorKind::ADDITION: return &COperator::ADD;
+    case MjOperatorKind::SUBTRACTION: return &COperator::SUB;
+    case MjOperatorKind::BITWISE_AND: return &COperator::AND;
+    case MjOperatorKind::BITWISE_XOR: return &COperator::XOR;
+    case MjOperatorKind::BITWISE_OR: return &COperator::OR;
+    case MjOperatorKind::LOGICAL_AND: return &COperator::LAND;
+    case MjOperatorKind::LOGICAL_OR: return &COperator::LOR;
+    case MjOperatorKind::EQUAL: return &COperator::EQU;
+    case MjOperatorKind::NOT_EQUAL: return &COperator::NEQ;
+    case MjOperatorKind::GREATER_THAN: return &COperator::GTR;
+    case MjOperatorKind::GREATER_THAN_OR_EQUAL: return &COperator::GEQ;
+    case MjOperatorKind::LESS_THAN: return &COperator::LES;
+    case MjOperatorKind::LESS_THAN_OR_EQUAL: return &COperator::LEQ;
+    default: return nullptr;
+    }
+}
+
+
+u32 MjTranspiler::add_translation_unit(StringView module_name) noexcept {
+    CTranslationUnit &translation_unit = _program.add_translation_unit(module_name);
+    translation_unit.add_include("stddef.h");
+    translation_unit.add_include("stdint.h");
+    _units.push_back({&translation_unit, {}, {}});
+    return _units.size() - 1;
+}
+
+
+Error MjTranspiler::add_type(u32 unit, const MjType &type, StringView name, const MjSourceFile &file) noexcept {
+    _unit = &_units[unit];
+
+    if (!type.has_layout()) {
+        printf("Failed to transpile type! The layout of '%.*s' is not computed.\n", int(name.size()), name.data());
+        return Error::FAILURE;
+    }
+
+    if (!type.is_structure_type() && !type.is_class_type() && !type.is_union_type()) {
+        printf("Failed to transpile type! '%.*s' is not a structure, class or union.\n", int(name.size()), name.data());
+        return Error::FAILURE;
+    }
+
+    CTranslationUnit &translation_unit = *_unit->translation_unit;
+    CStructureType *structure_type = nullptr;
+    CUnionType *union_type = nullptr;
+
+    if (!type.is_union_type()) {
+        structure_type = &translation_unit.add_type<CStructureType>(name, type.size(), type.alignment());
+    } else {
+        union_type = &translation_unit.add_type<CUnionType>(name, type.size(), type.alignment());
+    }
+
+    for (const MjMember *member : type.members()) {
+        StringView member_name = file.text_of(*member->name());
+        const CType *member_type = lower_type(member->type());
+
+        if (member_type == nullptr) {
+            printf("Failed to transpile member! The type of '%.*s' has no C type.\n", int(member_name.size()), member_name.data());
+            return Error::FAILURE;
+        }
+
+        if (structure_type) {
+            structure_type->add_member(member_name, *member_type, member->offset());
+        } else {
+            union_type->add_member(member_name, *member_type);
+        }
+    }
+
+    _unit->types[&type] = structure_type ? static_cast<const CType *>(structure_type) : union_type;
+    return Error::SUCCESS;
+}
+
+
+Error MjTranspiler::add_function(
+    u32 unit,
+    const MjFunction &function,
+    Slice<const MjVariable *const> parameters,
+    const MjSourceFile &file,
+    const MjTokenView &tokens,
+    bool is_exported
+) noexcept {
+    _unit = &_units[unit];
+    _file = &file;
+    _tokens = &tokens;
+    _names.clear();
+    _locals.clear();
+    _loop_depth = 0;
+    _error = Error::SUCCESS;
+
+    CFunction *c_function = create_function(function, parameters, false, is_exported);
+
+    if (c_function == nullptr) {
+        return Error::FAILURE;
+    }
+
+    if (function.body() == nullptr) {
+        printf("Failed to transpile function! The function has no body.\n");
+        return Error::FAILURE;
+    }
+
+    // A local variable declared in several blocks of the body is declared once, with its first type.
+    for (const MjVariable *local : function.locals()) {
+        StringView local_name = file.text_of(*local->name());
+        const CType *local_type = lower_type(local->type());
+
+        if (local_type == nullptr) {
+            printf("Failed to transpile local variable! The type of '%.*s' has no C type.\n", int(local_name.size()), local_name.data());
+            return Error::FAILURE;
+        }
+
+        if (_names.emplace(reinterpret_cast<const char *>(local_name.data()), local_name.size()).second) {
+            _locals.emplace_back(*local_type, local_name, CExpression("0"));
+        }
+    }
+
+    lower_body(function.body(), c_function->body());
+
+    // Local variables are declared at the start of the body, since they may be declared in a
+    // nested block and used after it, or introduced by their first assignment.
+    for (auto it = _locals.rbegin(); it != _locals.rend(); ++it) {
+        c_function->body().prepend<CDeclarationStatement>(std::move(*it));
+    }
+
+    return _error;
+}
+
+
+Error MjTranspiler::declare_function(
+    u32 unit,
+    const MjFunction &function,
+    Slice<const MjVariable *const> parameters,
+    const MjSourceFile &file
+) noexcept {
+    _unit = &_units[unit];
+    _file = &file;
+    _names.clear();
+    return create_function(function, parameters, true, true) ? Error::SUCCESS : Error::FAILURE;
+}
+
+
+Error MjTranspiler::transpile(const std::filesystem::path &directory) noexcept {
+    for (const std::unique_ptr<CTranslationUnit> &translation_unit : _program.translation_units()) {
+        StringView name = translation_unit->name();
+        std::filesystem::path file_path = directory / (std::string(reinterpret_cast<const char *>(name.data()), name.size()) + ".c");
+        i32 fd = ::open(file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+        if (fd < 0) {
+            printf("Failed to open file! '%s'\n", file_path.c_str());
+            return Error::FAILURE;
+        }
+
+        // The unit is written in batches of chunks while it is printed.
+        OutputBuffer out(fd);
+        CPrinter(out).print(*translation_unit);
+        Error result = out.flush();
+        ::close(fd);
+
+        if (result != Error::SUCCESS) {
+            printf("Failed to write file data! '%s'\n", file_path.c_str());
+            return Error::FAILURE;
+        }
+    }
+
+    return Error::SUCCESS;
+}
+
+
+CFunction *MjTranspiler::create_function(const MjFunction &function, Slice<const MjVariable *const> parameters, bool is_external, bool is_exported) noexcept {
+    StringView name = _file->text_of(*function.name());
+    const CType *return_type = function.return_type() ? lower_type(function.return_type()) : &CBasicType::VOID;
+
+    if (return_type == nullptr) {
+        printf("Failed to transpile function! The return type of '%.*s' has no C type.\n", int(name.size()), name.data());
+        return nullptr;
+    }
+
+    CFunction &c_function = _unit->translation_unit->add_function(name, *return_type, !is_exported, !is_exported, is_external);
+    bool is_restrict = this->is_restrict(function);
+
+    for (const MjVariable *parameter : parameters) {
+        StringView parameter_name = _file->text_of(*parameter->name());
+        const CType *parameter_type = lower_type(parameter->type(), is_restrict);
+
+        if (parameter_type == nullptr) {
+            printf("Failed to transpile parameter! The type of '%.*s' has no C type.\n", int(parameter_name.size()), parameter_name.data());
+            return nullptr;
+        }
+
+        c_function.add_parameter(*parameter_type, parameter_name);
+        _names.emplace(reinterpret_cast<const char *>(parameter_name.data()), parameter_name.size());
+    }
+
+    return &c_function;
+}
+
+
+const CType *MjTranspiler::lower_type(const MjType *type, bool is_restrict) noexcept {
+    auto &types = is_restrict && type->is_pointer_type() ? _unit->restrict_pointer_types : _unit->types;
+    auto it = types.find(type);
+
+    if (it != types.end()) {
+        return it->second;
+    }
+
+    CTranslationUnit &translation_unit = *_unit->translation_unit;
+    const CType *c_type = nullptr;
+
+    if (type->is_void_type()) {
+        c_type = &CBasicType::VOID;
+    } else if (type->is<MjIntegerType>()) {
+        c_type = &integer_type(type->size(), type->as<MjIntegerType>()->is_signed());
+    } else if (type->is_enumeration_type()) {
+        c_type = lower_type(static_cast<const MjEnumerationType *>(type)->index_type());
+    } else if (type->is_type_alias()) {
+        const MjTypeAlias *type_alias = static_cast<const MjTypeAlias *>(type);
+
+        if (type_alias->is_resolved()) {
+            c_type = lower_type(type_alias->base_type(), is_restrict);
+        }
+    } else if (type->is_const_qualified()) {
+        // Only integers and pointers keep their qualifier, as the layout of aggregates is shared.
+        const CType *base = lower_type(static_cast<const MjConstantType *>(type)->base_type());
+
+        if (const CIntegerType *integer = dynamic_cast<const CIntegerType *>(base)) {
+            c_type = &translation_unit.add_type<CIntegerType>(integer->name(), integer->size(), integer->is_signed(), CTypeFlags{.is_const = true});
+        } else if (const CPointerType *pointer = dynamic_cast<const CPointerType *>(base)) {
+            c_type = &translation_unit.add_type<CPointerType>(pointer->base_type(), CTypeFlags{.is_const = true});
+        } else {
+            c_type = base;
+        }
+    } else if (type->is_safe_qualified()) {
+        c_type = lower_type(static_cast<const MjSafeType *>(type)->constant_type());
+    } else if (type->is_pointer_type()) {
+        const CType *base = lower_type(static_cast<const MjPointerType *>(type)->base_type());
+
+        if (base) {
+            c_type = &translation_unit.add_type<CPointerType>(*base, CTypeFlags{.is_restrict = is_restrict});
+        }
+    } else if (type->is_array_type()) {
+        const MjArrayType *array_type = static_cast<const MjArrayType *>(type);
+        const CType *base = lower_type(array_type->base_type());
+
+        if (base) {
+            c_type = &translation_unit.add_type<CArrayType>(*base, array_type->array_size());
+        }
+    }
+
+    // Floating point, slice and function types have no C type yet.
+    if (c_type) {
+        types[type] = c_type;
+    }
+
+    return c_type;
+}
+
+
+bool MjTranspiler::is_restrict(const MjFunction &function) const noexcept {
+    for (const MjAnnotation *annotation : function.annotations()) {
+        if (_file->text_of(*annotation->name()).is_equal("restrict")) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+const CType &MjTranspiler::integer_type(u32 size, bool is_signed) noexcept {
+    u32 index = std::countr_zero(std::bit_ceil(std::clamp(size, 1u, 8u)));
+    const CType *&type = _unit->integer_types[is_signed][index];
+
+    if (type == nullptr) {
+        static const char *const NAMES[2][4] = {
+            {"uint8_t", "uint16_t", "uint32_t", "uint64_t"},
+            {"int8_t", "int16_t", "int32_t", "int64_t"},
+        };
+
+        const char *name = NAMES[is_signed][index];
+        type = &_unit->translation_unit->add_type<CIntegerType>(StringView(reinterpret_cast<const u8 *>(name), strlen(name)), 1u << index, is_signed);
+    }
+
+    return *type;
+}
+
+
+void MjTranspiler::lower_statement(const MjStatement *statement, CBlockStatement &block) noexcept {
+    MjItemKind kind = statement->item_kind();
+
+    if (kind == MjItemKind::BLOCK_STATEMENT) {
+        lower_body(statement, block.append<CBlockStatement>());
+    } else if (kind == MjItemKind::IF_STATEMENT) {
+        lower_if(static_cast<const MjIfStatement *>(statement), block);
+    } else if (kind == MjItemKind::WHILE_LOOP) {
+        lower_while(static_cast<const MjWhileLoop *>(statement), block);
+    } else if (kind == MjItemKind::RETURN_STATEMENT) {
+        const MjReturnStatement *return_statement = static_cast<const MjReturnStatement *>(statement);
+        CExpression value;
+
+        if (return_statement->has_return_value()) {
+            const MjTreeExpression *expression = static_cast<const MjTreeExpression *>(return_statement->return_value());
+            value = lower_node(expression->tree(), expression->index());
+        }
+
+        block.append<CReturnStatement>(std::move(value));
+    } else if (kind == MjItemKind::BREAK_STATEMENT || kind == MjItemKind::CONTINUE_STATEMENT) {
+        if (_loop_depth == 0) {
+            printf("Failed to transpile statement! '%s' outside of a loop\n", kind == MjItemKind::BREAK_STATEMENT ? "break" : "continue");
+            _error = Error::FAILURE;
+            return;
+        }
+
+        if (kind == MjItemKind::BREAK_STATEMENT) {
+            block.append<CBreakStatement>();
+        } else {
+            block.append<CContinueStatement>();
+        }
+    } else if (kind.is_expression()) {
+        const MjTreeExpression *expression = static_cast<const MjTreeExpression *>(statement);
+        block.append<CExpression>(lower_node(expression->tree(), expression->index()));
+    } else {
+        printf("Failed to transpile statement! Unsupported statement\n");
+        _error = Error::FAILURE;
+    }
+}
+
+
+void MjTranspiler::lower_body(const MjStatement *statement, CBlockStatement &block) noexcept {
+    if (statement->item_kind() != MjItemKind::BLOCK_STATEMENT) {
+        lower_statement(statement, block);
+        return;
+    }
+
+    for (const MjStatement *child : static_cast<const MjBlockStatement *>(statement)->statements()) {
+        lower_statement(child, block);
+    }
+}
+
+
+void MjTranspiler::lower_if(const MjIfStatement *statement, CBlockStatement &block) noexcept {
+    const MjTreeExpression *condition = static_cast<const MjTreeExpression *>(statement->condition());
+    CIfStatement &if_statement = block.append<CIfStatement>(lower_node(condition->tree(), condition->index()));
+    lower_body(statement->then_statement()->body(), if_statement.if_block());
+
+    if (statement->has_else_statement()) {
+        lower_body(statement->else_statement()->body(), if_statement.else_block());
+    }
+}
+
+
+void MjTranspiler::lower_while(const MjWhileLoop *loop, CBlockStatement &block) noexcept {
+    CExpression condition("1");
+
+    if (loop->has_condition()) {
+        const MjTreeExpression *expression = static_cast<const MjTreeExpression *>(loop->condition());
+        condition = lower_node(expression->tree(), expression->index());
+    }
+
+    CWhileStatement &while_statement = block.append<CWhileStatement>(std::move(condition));
+    _loop_depth += 1;
+
+    if (loop->has_block()) {
+        lower_body(loop->block(), while_statement.block());
+    }
+
+    _loop_depth -= 1;
+}
+
+
+CExpression MjTranspiler::lower_node(const MjExpressionTree &tree, u32 index) noexcept {
+    const MjExpressionNode &node = tree.node(index);
+
+    switch (node.kind) {
+    case MjExpressionNodeKind::VARIABLE:
+    case MjExpressionNodeKind::CONSTANT:
+        return variable(node);
+    case MjExpressionNodeKind::FUNCTION:
+        return CExpression(_file->text_of(_tokens->token(node.token_index)));
+    case MjExpressionNodeKind::LITERAL:
+        return lower_literal(node);
+    case MjExpressionNodeKind::NULL_:
+        return CExpression("NULL");
+    case MjExpressionNodeKind::UNINITIALIZED:
+        return CExpression("0");
+    case MjExpressionNodeKind::UNARY:
+        return lower_unary(tree, node);
+    case MjExpressionNodeKind::BINARY:
+        return lower_binary(tree, node);
+    case MjExpressionNodeKind::CALL:
+        return lower_call(tree, node);
+    case MjExpressionNodeKind::CAST:
+        // The operands are `int64_t` without semantic analysis, so the cast has no C type.
+        return lower_node(tree, node.lhs);
+    default:
+        return error(node, "Unsupported expression");
+    }
+}
+
+
+CExpression MjTranspiler::lower_literal(const MjExpressionNode &node) noexcept {
+    MjTokenKind kind = _tokens->kind(node.token_index);
+    StringView text = _file->text_of(_tokens->token(node.token_index));
+
+    if (kind == MjTokenKind::TRUE || kind == MjTokenKind::FALSE) {
+        return CExpression(kind == MjTokenKind::TRUE ? "1" : "0");
+    }
+
+    // C has no digit separators, and no binary literals before C23.
+    if (text.size() > 2 && text[0] == '0' && text[1] == 'b') {
+        u64 value = 0;
+
+        for (u32 i = 2; i < text.size(); ++i) {
+            if (text[i] == '0' || text[i] == '1') {
+                value = value * 2 + (text[i] - '0');
+            } else if (text[i] != '_') {
+                return error(node, "Unsupported literal");
+            }
+        }
+
+        std::string digits = std::to_string(value) + "u";
+        return CExpression(view_of(digits));
+    }
+
+    std::string digits;
+
+    for (u32 i = 0; i < text.size(); ++i) {
+        if (text[i] != '_' || text[0] == '"' || text[0] == '\'') {
+            digits += char(text[i]);
+        }
+    }
+
+    return CExpression(view_of(digits));
+}
+
+
+CExpression MjTranspiler::lower_unary(const MjExpressionTree &tree, const MjExpressionNode &node) noexcept {
+    const COperator *op = nullptr;
+
+    switch (node.operator_kind) {
+    case MjOperatorKind::REFERENCE: op = &COperator::REF; break;
+    case MjOperatorKind::DEREFERENCE: op = &COperator::DEREF; break;
+    case MjOperatorKind::NEGATION: op = &COperator::NEG; break;
+    case MjOperatorKind::INVERSION: op = &COperator::INV; break;
+    case MjOperatorKind::NOT: op = &COperator::NOT; break;
+    case MjOperatorKind::POST_INCREMENT: op = &COperator::INC; break;
+    case MjOperatorKind::POST_DECREMENT: op = &COperator::DEC; break;
+    default: return error(node, "Unsupported operator");
+    }
+
+    return CExpression(*op, {lower_node(tree, node.lhs)});
+}
+
+
+CExpression MjTranspiler::lower_binary(const MjExpressionTree &tree, const MjExpressionNode &node) noexcept {
+    MjOperatorKind kind = node.operator_kind;
+
+    if (kind == MjOperatorKind::MEMBER_ACCESS) {
+        return CExpression(COperator::DOT, {lower_node(tree, node.lhs), CExpression(_file->text_of(_tokens->token(tree.node(node.rhs).token_index)))});
+    }
+
+    CExpression lhs = lower_node(tree, node.lhs);
+    CExpression rhs = lower_node(tree, node.rhs);
+
+    // `a ^^ b` is true if exactly one operand is true.
+    if (kind == MjOperatorKind::LOGICAL_XOR) {
+        CExpression lhs_value(COperator::NOT, {CExpression(COperator::NOT, {std::move(lhs)})});
+        CExpression rhs_value(COperator::NOT, {CExpression(COperator::NOT, {std::move(rhs)})});
+        return CExpression(COperator::NEQ, {std::move(lhs_value), std::move(rhs_value)});
+    }
+
+    // The logical shift right of a signed integer shifts its unsigned value.
+    if (kind == MjOperatorKind::SLIDE_RIGHT || kind == MjOperatorKind::LSR_SET) {
+        // The target of `a >>>= b` is lowered twice, so it must be evaluated without side effects.
+        if (kind == MjOperatorKind::LSR_SET && has_side_effects(tree, node.lhs)) {
+            return error(node, "Unsupported side effects in the target of '>>>='");
+        }
+
+        CExpression value(integer_type(8, false), lhs);
+        CExpression shift(COperator::ASR, {std::move(value), std::move(rhs)});
+
+        if (kind == MjOperatorKind::SLIDE_RIGHT) {
+            return shift;
+        }
+
+        return CExpression(COperator::SET, {std::move(lhs), CExpression(integer_type(8, true), std::move(shift))});
+    }
+
+    const COperator *op = operator_of(kind);
+
+    if (op == nullptr) {
+        return error(node, "Unsupported operator");
+    }
+
+    return CExpression(*op, {std::move(lhs), std::move(rhs)});
+}
+
+
+CExpression MjTranspiler::lower_call(const MjExpressionTree &tree, const MjExpressionNode &node) noexcept {
+    std::vector<CExpression> terms;
+    terms.reserve(node.argument_count + 1);
+
+    // The callee names a function rather than a local variable.
+    terms.emplace_back(_file->text_of(_tokens->token(tree.node(node.lhs).token_index)));
+
+    for (u32 argument = node.rhs; argument != MjExpressionTree::NONE; argument = tree.node(argument).next) {
+        terms.push_back(lower_node(tree, argument));
+    }
+
+    return CExpression(COperator::CALL, std::move(terms));
+}
+
+
+CExpression MjTranspiler::variable(const MjExpressionNode &node) noexcept {
+    StringView name = _file->text_of(_tokens->token(node.token_index));
+
+    if (_names.emplace(reinterpret_cast<const char *>(name.data()), name.size()).second) {
+        _locals.emplace_back(integer_type(8, true), name, CExpression("0"));
+    }
+
+    return CExpression(name);
+}
+
+
+bool MjTranspiler::has_side_effects(const MjExpressionTree &tree, u32 index) const noexcept {
+    const MjExpressionNode &node = tree.node(index);
+
+    switch (node.kind) {
+    case MjExpressionNodeKind::UNARY:
+        return node.operator_kind.has_side_effects() || has_side_effects(tree, node.lhs);
+    case MjExpressionNodeKind::BINARY:
+        if (node.operator_kind == MjOperatorKind::MEMBER_ACCESS) {
+            return has_side_effects(tree, node.lhs);
+        }
+
+        return node.operator_kind.has_side_effects() || has_side_effects(tree, node.lhs) || has_side_effects(tree, node.rhs);
+    case MjExpressionNodeKind::CALL:
+        return true;
+    case MjExpressionNodeKind::CAST:
+        return has_side_effects(tree, node.lhs);
+    default:
+        return false;
+    }
+}
+
+
+CExpression MjTranspiler::error(const MjExpressionNode &node, const char *message) noexcept {
+    StringView text = _file->text_of(_tokens->token(node.token_index));
+    printf("Failed to transpile expression! %s: '%.*s'\n", message, int(text.size()), text.data());
+    _error = Error::FAILURE;
+    return CExpression("0");
+}
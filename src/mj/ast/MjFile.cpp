@@ -1,38 +1,550 @@
 #include <mj/ast/MjSourceFile.hpp>
+#include <mj/MjLexer.hpp>
 
 #include <fstream>
 
 
+namespace {
+
+
+/// Return true if every token in the encoded token data lies within it and refers to a string of
+/// the encoded string table, and every line offset is the offset of an indent token, so that the
+/// tokens can be read without further checks.
+bool is_valid_token_data(
+    const u8 *token_data,
+    u32 token_data_size,
+    const u8 *line_offsets,
+    u32 line_count,
+    const u8 *string_sizes,
+    u32 string_count
+) noexcept {
+    u32 line_index = 0;
+    u32 parent_size = 0; // The size of the text of the last string token, which contains any subtokens after it.
+
+    for (u32 offset = 0; offset < token_data_size;) {
+        const u8 *ptr = token_data + offset;
+        u32 remaining_size = token_data_size - offset;
+        MjTokenKind kind(ptr[0]);
+
+        if (!kind.is_valid() || remaining_size < kind.encoded_size()) {
+            return false;
+        }
+
+        u32 size = kind.encoded_size();
+
+        switch (kind.encoding()) {
+        case MjTokenEncoding::STRING: {
+            u32 id = u32(ptr[1]) | u32(ptr[2] & 0x7Fu) << 8;
+
+            if (ptr[2] & 0x80u) {
+                if (remaining_size < 4) {
+                    return false;
+                }
+
+                id |= u32(ptr[3]) << 15;
+                size = 4;
+            }
+
+            if (id >= string_count) {
+                return false;
+            }
+
+            std::memcpy(&parent_size, string_sizes + id * sizeof(u32), sizeof(u32));
+            break;
+        }
+        case MjTokenEncoding::INLINE:
+            size += u32(ptr[1]) | u32(ptr[2]) << 8;
+
+            if (remaining_size < size) {
+                return false;
+            }
+
+            break;
+        case MjTokenEncoding::SUBTOKEN:
+            if (u32(ptr[1]) + ptr[2] > parent_size) {
+                return false;
+            }
+
+            break;
+        }
+
+        if (kind.encoding() != MjTokenEncoding::STRING && kind.encoding() != MjTokenEncoding::SUBTOKEN) {
+            parent_size = 0;
+        }
+
+        if (kind == MjTokenKind::INDENT) {
+            u32 line_offset;
+
+            if (line_index == line_count) {
+                return false;
+            }
+
+            std::memcpy(&line_offset, line_offsets + line_index * sizeof(u32), sizeof(u32));
+
+            if (line_offset != offset) {
+                return false;
+            }
+
+            line_index += 1;
+        }
+
+        offset += size;
+    }
+
+    return line_index == line_count;
+}
+
+
+}
+
 
 Error MjSourceFile::load(std::filesystem::path file_path) noexcept {
+    if (_text.load(file_path).is_failure()) {
+        return Error::FAILURE;
+    }
 
-    // Open file in binary mode and position the cursor at the end to determine file size
-    std::basic_ifstream<u8> file_stream(file_path, std::ios::binary | std::ios::ate);
+    _path = file_path;
+    _size = _text.size();
+    return Error::SUCCESS;
+}
+
+
+Error MjSourceFile::encode(std::filesystem::path file_path) const noexcept {
+    std::vector<u32> string_sizes;
+    std::vector<u8> string_data;
+    string_sizes.reserve(string_count());
+
+    for (u32 id = 0; id < string_count(); ++id) {
+        StringView string = this->string(id);
+        string_sizes.push_back(string.size());
+        string_data.insert(string_data.end(), string.begin(), string.end());
+    }
+
+    EncodingHeader header = {
+        .magic = {ENCODING_MAGIC[0], ENCODING_MAGIC[1], ENCODING_MAGIC[2], ENCODING_MAGIC[3]},
+        .version = ENCODING_VERSION,
+        .flags = 0,
+        .source_size = _size,
+        .line_count = u32(_line_offsets.size()),
+        .string_count = u32(string_sizes.size()),
+        .string_data_size = u32(string_data.size()),
+        .token_data_size = u32(_tokens.size()),
+        .reserved = 0,
+        .source_hash = _text.is_loaded() ? _text.hash() : 0,
+    };
+
+    std::basic_ofstream<u8> file_stream(file_path, std::ios::binary | std::ios::trunc);
 
     if (!file_stream.is_open()) {
+        printf("Failed to open file! '%s'\n", file_path.c_str());
         return Error::FAILURE;
     }
 
-    // Get file size
-    std::streamsize file_size = file_stream.tellg();
+    file_stream.write(reinterpret_cast<const u8 *>(&header), sizeof(header));
+    file_stream.write(reinterpret_cast<const u8 *>(_line_offsets.data()), _line_offsets.size() * sizeof(_line_offsets[0]));
+    file_stream.write(reinterpret_cast<const u8 *>(string_sizes.data()), string_sizes.size() * sizeof(string_sizes[0]));
+    file_stream.write(string_data.data(), string_data.size());
+    file_stream.write(_tokens.data(), _tokens.size());
 
-    if (file_size < 0) {
+    if (!file_stream) {
+        printf("Failed to write file data! '%s'\n", file_path.c_str());
         return Error::FAILURE;
     }
 
-    _path = file_path;
+    return Error::SUCCESS;
+}
 
-    // Resize the vector to hold the file content
-    _size = u32(file_size) + 1;
-    _data.resize(_size);
 
-    // Rewind the cursor to the beginning and read the data into the vector
-    file_stream.seekg(0, std::ios::beg);
+MjSourceFile *MjSourceFile::decode(
+    std::filesystem::path file_path,
+    std::filesystem::path source_path,
+    MjSourceText &&text
+) noexcept {
+    MjSourceText encoding;
 
-    if (!file_stream.read(_data.data(), file_size)) {
-        return Error::FAILURE;
+    if (encoding.load(file_path).is_failure()) {
+        return nullptr;
     }
 
-    _data[_size - 1] = 0;
+    const u8 *data = encoding.data();
+    EncodingHeader header;
+
+    if (encoding.size() < sizeof(header)) {
+        printf("Invalid tokenized file! '%s'\n", file_path.c_str());
+        return nullptr;
+    }
+
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, ENCODING_MAGIC, sizeof(ENCODING_MAGIC)) != 0) {
+        printf("Invalid tokenized file! '%s'\n", file_path.c_str());
+        return nullptr;
+    }
+
+    // Files from other versions are stale rather than invalid.
+    if (header.version != ENCODING_VERSION) {
+        return nullptr;
+    }
+
+    u64 encoding_size =
+        sizeof(header) +
+        u64(header.line_count) * sizeof(u32) +
+        u64(header.string_count) * sizeof(u32) +
+        header.string_data_size +
+        header.token_data_size;
+
+    if (encoding_size != encoding.size()) {
+        printf("Invalid tokenized file! '%s'\n", file_path.c_str());
+        return nullptr;
+    }
+
+    if (text.is_loaded() && (text.size() != header.source_size || text.hash() != header.source_hash)) {
+        return nullptr;
+    }
+
+    const u8 *line_offsets = data + sizeof(header);
+    const u8 *string_sizes = line_offsets + header.line_count * sizeof(u32);
+    const u8 *string_data = string_sizes + header.string_count * sizeof(u32);
+    const u8 *token_data = string_data + header.string_data_size;
+    u64 string_data_size = 0;
+
+    for (u32 id = 0; id < header.string_count; ++id) {
+        u32 string_size;
+        std::memcpy(&string_size, string_sizes + id * sizeof(u32), sizeof(u32));
+        string_data_size += string_size;
+    }
+
+    if (string_data_size != header.string_data_size) {
+        printf("Invalid tokenized file! '%s'\n", file_path.c_str());
+        return nullptr;
+    }
+
+    if (!is_valid_token_data(token_data, header.token_data_size, line_offsets, header.line_count, string_sizes, header.string_count)) {
+        printf("Invalid tokenized file! '%s'\n", file_path.c_str());
+        return nullptr;
+    }
+
+    MjSourceFile *file = text.is_loaded() ?
+        new MjSourceFile(source_path, std::move(text)) :
+        new MjSourceFile(source_path, header.source_size);
+
+    // The string IDs in the token data are the insertion order of the string table.
+    if (file->_has_large_strings) {
+        file->_large_strings.reserve(header.string_count);
+    } else {
+        file->_strings.reserve(header.string_count);
+    }
+
+    for (u32 id = 0; id < header.string_count; ++id) {
+        u32 string_size;
+        std::memcpy(&string_size, string_sizes + id * sizeof(u32), sizeof(u32));
+
+        if (file->_has_large_strings) {
+            file->_large_strings.insert_unique({string_data, string_size});
+        } else {
+            file->_strings.insert_unique({string_data, string_size});
+        }
+
+        string_data += string_size;
+    }
+
+    file->_line_offsets.resize(header.line_count);
+    std::memcpy(file->_line_offsets.data(), line_offsets, header.line_count * sizeof(u32));
+    file->_tokens.assign(token_data, token_data + header.token_data_size);
+    return file;
+}
+
+
+Error MjSourceFile::edit(const MjTextEdit &edit, bool emit_subtokens) noexcept {
+    return MjLexer::parse_edit(*this, edit, emit_subtokens);
+}
+
+
+void MjSourceFile::truncate(u32 line_start_index) noexcept {
+    const MjLexerCheckpoint &line_start = _line_starts[line_start_index];
+    truncate_tokens(line_start.token_offset, line_start.line_count);
+    _line_starts.erase(_line_starts.begin() + line_start_index, _line_starts.end());
+}
+
+
+/// Replace the elements from `begin` to `end` with the given elements, moving the elements after
+/// them only if the sizes differ.
+template<class T>
+static void replace_range(std::vector<T> &vector, u32 begin, u32 end, const std::vector<T> &elements) noexcept {
+    u32 size = end - begin;
+
+    if (elements.size() > size) {
+        std::copy(elements.begin(), elements.begin() + size, vector.begin() + begin);
+        vector.insert(vector.begin() + end, elements.begin() + size, elements.end());
+    } else {
+        std::copy(elements.begin(), elements.end(), vector.begin() + begin);
+        vector.erase(vector.begin() + begin + elements.size(), vector.begin() + end);
+    }
+}
+
+
+Error MjSourceFile::replace_lines(const MjSourceFile &lines, u32 begin, u32 end, i64 text_delta) noexcept {
+    if (_string_refs.size() != string_count()) {
+        count_string_refs();
+    }
+
+    u32 token_begin = _line_starts[begin].token_offset;
+    u32 line_begin = _line_starts[begin].line_count;
+    u32 token_end = end < _line_starts.size() ? _line_starts[end].token_offset : _tokens.size();
+    u32 line_end = end < _line_starts.size() ? _line_starts[end].line_count : _line_offsets.size();
+
+    // Re-encode the lexed lines with the string IDs of this file, skipping the leading byte.
+    std::vector<u8> tokens;
+    std::vector<u32> line_offsets;
+    std::vector<MjLexerCheckpoint> line_starts;
+    std::vector<u32> string_ids(lines.string_count(), U32_MAX);
+    tokens.reserve(lines._tokens.size());
+
+    auto string_token = lines._string_token_offsets.begin();
+    auto line_offset = lines._line_offsets.begin();
+    auto line_start = lines._line_starts.begin();
+    i64 token_delta = i64(token_begin) - 1;
+    u32 token_offset = 1;
+
+    while (true) {
+        u32 run_end = string_token != lines._string_token_offsets.end() ? *string_token : lines._tokens.size();
+
+        for (; line_offset != lines._line_offsets.end() && *line_offset < run_end; ++line_offset) {
+            line_offsets.push_back(*line_offset + token_delta);
+        }
+
+        for (; line_start != lines._line_starts.end() && line_start->token_offset <= run_end; ++line_start) {
+            MjLexerCheckpoint checkpoint = *line_start;
+            checkpoint.token_offset += token_delta;
+            checkpoint.line_count += line_begin;
+            line_starts.push_back(checkpoint);
+        }
+
+        tokens.insert(tokens.end(), lines._tokens.begin() + token_offset, lines._tokens.begin() + run_end);
+
+        if (string_token == lines._string_token_offsets.end()) {
+            break;
+        }
+
+        MjToken token = lines.token_at(run_end);
+        u32 id = token.string_id();
+
+        if (string_ids[id] == U32_MAX && insert_string(lines.string(id), string_ids[id]).is_failure()) {
+            return Error::FAILURE;
+        }
+
+        // A new string has no references yet, and a dead string is revived.
+        if (string_ids[id] == _string_refs.size()) {
+            _string_refs.push_back(0);
+        } else if (_string_refs[string_ids[id]] == 0) {
+            _dead_string_count -= 1;
+        }
+
+        _string_refs[string_ids[id]] += 1;
+
+        u32 size = id < SHORT_STRING_ID_LIMIT ? 3 : 4;
+        encode_string_token(tokens, token.kind(), string_ids[id]);
+        token_delta += i64(string_ids[id] < SHORT_STRING_ID_LIMIT ? 3 : 4) - size;
+        token_offset = run_end + size;
+        ++string_token;
+    }
+
+    // The removed tokens release their strings.
+    for (u32 offset = token_begin; offset < token_end; offset += token_at(offset).size()) {
+        MjToken token = token_at(offset);
+
+        if (token.kind().encoding() == MjTokenEncoding::STRING && --_string_refs[token.string_id()] == 0) {
+            _dead_string_count += 1;
+        }
+    }
+
+    // Move the records after the replaced lines, then replace the lines in place.
+    i64 size_delta = i64(tokens.size()) - (token_end - token_begin);
+    i64 line_delta = i64(line_offsets.size()) - (line_end - line_begin);
+
+    for (u32 i = line_end; i < _line_offsets.size(); ++i) {
+        _line_offsets[i] += size_delta;
+    }
+
+    for (u32 i = end; i < _line_starts.size(); ++i) {
+        _line_starts[i].text_offset += text_delta;
+        _line_starts[i].token_offset += size_delta;
+        _line_starts[i].line_count += line_delta;
+    }
+
+    replace_range(_tokens, token_begin, token_end, tokens);
+    replace_range(_line_offsets, line_begin, line_end, line_offsets);
+    replace_range(_line_starts, begin, end, line_starts);
+    _has_line_index.store(false, std::memory_order_release);
+
+    if (_dead_string_count * 100 > u64(string_count()) * MAX_DEAD_STRING_PERCENT) {
+        compact_strings();
+    }
+
+    return Error::SUCCESS;
+}
+
+
+Error MjSourceFile::append_chunk(const MjSourceFile &chunk, u32 line_start_index) noexcept {
+    const MjLexerCheckpoint &first = chunk._line_starts[line_start_index];
+    std::vector<u32> string_ids(chunk.string_count(), U32_MAX);
+
+    auto string_token = std::lower_bound(chunk._string_token_offsets.begin(), chunk._string_token_offsets.end(), first.token_offset);
+    auto line_offset = chunk._line_offsets.begin() + first.line_count;
+    auto line_start = chunk._line_starts.begin() + line_start_index;
+
+    // The offset of a chunk token in this file. It changes when a remapped string ID changes size.
+    i64 token_delta = i64(_tokens.size()) - first.token_offset;
+    i64 line_delta = i64(_line_offsets.size()) - first.line_count;
+    u32 token_offset = first.token_offset;
+
+    while (true) {
+        u32 end = string_token != chunk._string_token_offsets.end() ? *string_token : chunk._tokens.size();
+
+        for (; line_offset != chunk._line_offsets.end() && *line_offset < end; ++line_offset) {
+            _line_offsets.push_back(*line_offset + token_delta);
+        }
+
+        for (; line_start != chunk._line_starts.end() && line_start->token_offset <= end; ++line_start) {
+            MjLexerCheckpoint checkpoint = *line_start;
+            checkpoint.token_offset += token_delta;
+            checkpoint.line_count += line_delta;
+            _line_starts.push_back(checkpoint);
+        }
+
+        _tokens.insert(_tokens.end(), chunk._tokens.begin() + token_offset, chunk._tokens.begin() + end);
+
+        if (string_token == chunk._string_token_offsets.end()) {
+            break;
+        }
+
+        MjToken token = chunk.token_at(end);
+        u32 id = token.string_id();
+
+        if (string_ids[id] == U32_MAX && insert_string(chunk.string(id), string_ids[id]).is_failure()) {
+            return Error::FAILURE;
+        }
+
+        u32 size = id < SHORT_STRING_ID_LIMIT ? 3 : 4;
+        append_string_token(token.kind(), string_ids[id]);
+        token_delta += i64(string_ids[id] < SHORT_STRING_ID_LIMIT ? 3 : 4) - size;
+        token_offset = end + size;
+        ++string_token;
+    }
+
+    _has_line_index.store(false, std::memory_order_release);
     return Error::SUCCESS;
 }
+
+
+void MjSourceFile::use_large_strings() noexcept {
+    _large_strings.reserve(_strings.size());
+
+    for (u32 id = 0; id < _strings.size(); ++id) {
+        _large_strings.insert_unique(_strings[id]);
+    }
+
+    _strings.clear();
+    _has_large_strings = true;
+}
+
+
+void MjSourceFile::count_string_refs() noexcept {
+    _string_refs.assign(string_count(), 0);
+
+    for (u32 offset = 0; offset < _tokens.size(); offset += token_at(offset).size()) {
+        MjToken token = token_at(offset);
+
+        if (token.kind().encoding() == MjTokenEncoding::STRING) {
+            _string_refs[token.string_id()] += 1;
+        }
+    }
+
+    _dead_string_count = std::count(_string_refs.begin(), _string_refs.end(), 0u);
+}
+
+
+void MjSourceFile::compact_strings() noexcept {
+    std::vector<u32> string_ids(string_count(), U32_MAX);
+    MjLargeStringSet live_strings(string_count() - _dead_string_count);
+    std::vector<u32> string_refs;
+
+    for (u32 id = 0; id < string_count(); ++id) {
+        if (_string_refs[id] != 0) {
+            string_ids[id] = live_strings.insert_unique(string(id));
+            string_refs.push_back(_string_refs[id]);
+        }
+    }
+
+    // The live strings are pieces of the text or keywords, so they fit in the set for its size.
+    _strings.clear();
+    _large_strings.clear();
+    _has_large_strings = _text.size() >= LARGE_STRINGS_MIN_SIZE;
+
+    for (u32 id = 0; id < live_strings.size(); ++id) {
+        if (_has_large_strings) {
+            _large_strings.insert_unique(live_strings[id]);
+        } else {
+            _strings.insert_unique(live_strings[id]);
+        }
+    }
+
+    // Re-encode the string tokens, whose IDs may shrink, and move the line records with them.
+    std::vector<u8> tokens;
+    tokens.reserve(_tokens.size());
+    u32 line_index = 0;
+    u32 line_start_index = 0;
+
+    for (u32 offset = 0; offset < _tokens.size(); offset += token_at(offset).size()) {
+        MjToken token = token_at(offset);
+
+        for (; line_index < _line_offsets.size() && _line_offsets[line_index] == offset; ++line_index) {
+            _line_offsets[line_index] = tokens.size();
+        }
+
+        for (; line_start_index < _line_starts.size() && _line_starts[line_start_index].token_offset == offset; ++line_start_index) {
+            _line_starts[line_start_index].token_offset = tokens.size();
+        }
+
+        if (token.kind().encoding() == MjTokenEncoding::STRING) {
+            encode_string_token(tokens, token.kind(), string_ids[token.string_id()]);
+        } else {
+            tokens.insert(tokens.end(), token.ptr(), token.ptr() + token.size());
+        }
+    }
+
+    for (; line_start_index < _line_starts.size(); ++line_start_index) {
+        _line_starts[line_start_index].token_offset = tokens.size();
+    }
+
+    _tokens = std::move(tokens);
+    _string_refs = std::move(string_refs);
+    _dead_string_count = 0;
+    _global_string_ids.clear();
+    _has_line_index.store(false, std::memory_order_release);
+}
+
+
+void MjSourceFile::build_line_index() const noexcept {
+    std::lock_guard lock(_line_index_mutex);
+
+    if (_has_line_index.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    u32 block_count = (_tokens.size() + LINE_INDEX_BLOCK_SIZE - 1) / LINE_INDEX_BLOCK_SIZE + 1;
+    _line_index.resize(block_count);
+    u32 line_index = 0;
+
+    for (u32 block_index = 0; block_index < block_count; ++block_index) {
+        u32 offset = block_index * LINE_INDEX_BLOCK_SIZE;
+
+        while (line_index + 1 < _line_offsets.size() && _line_offsets[line_index + 1] <= offset) {
+            line_index += 1;
+        }
+
+        _line_index[block_index] = line_index;
+    }
+
+    _has_line_index.store(true, std::memory_order_release);
+}
@@ -1,18 +1,24 @@
 #include <mj/ast/MjFunction.hpp>
-#include <mj/ast/MjSliceType.hpp>
+#include <mj/ast/MjFunctionArgument.hpp>
 
 
 bool MjFunction::is_deterministic(const MjFunctionArgumentList &argument_list) const noexcept {
-    if () {
-        // deterministic for all arguments...
-        return true;
+
+    // Only functions annotated as `@pure` are known to depend on nothing but their arguments.
+    bool is_pure = false;
+
+    for (const MjAnnotation *annotation : annotations()) {
+        if (annotation->item_kind() == MjItemKind::PURE_ANNOTATION) {
+            is_pure = true;
+            break;
+        }
     }
 
-    if (is_method()) {
+    if (!is_pure) {
         return false;
     }
 
-    for (MjFunctionArgument *argument : argument_list) {
+    for (const MjFunctionArgument *argument : argument_list) {
         if (!argument->is_deterministic()) {
             return false;
         }
@@ -22,42 +28,9 @@ bool MjFunction::is_deterministic(const MjFunctionArgumentList &argument_list) c
 }
 
 
+bool MjFunction::supports_arguments(const MjFunctionArgumentList &argument_list) const noexcept {
 
-bool MjFunction::supports_arguments(const MjFunctionArgumentList &function_argument_list) const noexcept {
-
-    // Too few arguments and not enough default values.
-    if (function_argument_list.size() < _definition->parameter_list()->size()) {
-        return false;
-    }
-
-    const MjType *variadic_type = (*_definition->parameter_list())[_definition->parameter_list()->size() - 1]->variable()->type();
-
-    if (variadic_type->is_slice()) {
-        variadic_type = dynamic_cast<const MjSliceType *>(variadic_type)->base_type();
-    } else {
-        variadic_type = nullptr;
-    }
-
-    // Too many arguments and not a variadic function.
-    if (_definition->parameter_list()->size() != function_argument_list.size() && variadic_type) {
-        return false;
-    }
-
-    // Check if each argument has the correct type or can be cast to the correct type.
-    for (const MjFunctionParameter *parameter : *_definition->parameter_list()) {
-        if (parameter->variable()->type()) {
-            if (!last && !variadic_type) {
-                return false;
-            }
-
-            // Handle inline slice type expansion.
-            for (u32 i = 0; i < function_argument_list.size(); ++i) {
-                if (variadic_type->has_comment()) {
-                    return false;
-                }
-            }
-        }
-    }
-
-    return true;
+    // Parameters have no default values and functions are not variadic yet, so every parameter
+    // takes exactly one argument.
+    return argument_list.size() == arity();
 }
@@ -0,0 +1,44 @@
+#include <mj/ast/MjMemberIndex.hpp>
+
+#include <algorithm>
+#include <bit>
+
+
+void MjMemberIndex::build(std::vector<Entry> entries) noexcept {
+    clear();
+
+    // Group the items by key, keeping the declaration order of overloads.
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.key < b.key;
+    });
+
+    u32 key_count = 0;
+
+    for (u32 i = 0; i < entries.size(); ++i) {
+        key_count += i == 0 || entries[i].key != entries[i - 1].key;
+    }
+
+    // Keep the load factor at or below one half so that probe sequences stay short.
+    u32 slot_count = std::max(std::bit_ceil(key_count * 2), MIN_SLOT_COUNT);
+    _slots.assign(slot_count, {EMPTY_KEY, 0, 0});
+    _items.reserve(entries.size());
+    _shift = 64 - std::countr_zero(slot_count);
+
+    for (u32 i = 0; i < entries.size();) {
+        u64 key = entries[i].key;
+        u32 first_item = _items.size();
+
+        while (i < entries.size() && entries[i].key == key) {
+            _items.push_back(entries[i].item);
+            i += 1;
+        }
+
+        u32 slot_index = hash(key);
+
+        while (_slots[slot_index].key != EMPTY_KEY) {
+            slot_index = (slot_index + 1) & (slot_count - 1);
+        }
+
+        _slots[slot_index] = {key, first_item, u32(_items.size()) - first_item};
+    }
+}
@@ -0,0 +1,166 @@
+#include <mj/ast/MjSourceText.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+Error MjSourceText::load(const std::filesystem::path &path) noexcept {
+    unload();
+
+    i32 fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd == -1) {
+        printf("Failed to open file! '%s'\n", path.c_str());
+        return Error::FAILURE;
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0) {
+        printf("Failed to get file size! '%s'\n", path.c_str());
+        ::close(fd);
+        return Error::FAILURE;
+    }
+
+    // Only regular files can be mapped. Pipes, devices, and oversized files are read instead.
+    Error error = Error::FAILURE;
+
+    if (S_ISREG(st.st_mode) && u64(st.st_size) < U32_MAX - 2 * PADDING) {
+        error = map(fd, u32(st.st_size));
+    }
+
+    if (error.is_failure()) {
+        error = read(fd, path);
+    }
+
+    ::close(fd);
+    return error;
+}
+
+
+Error MjSourceText::map(i32 fd, u32 size) noexcept {
+    u32 page_size = sysconf(_SC_PAGESIZE);
+    u32 file_mapped_size = (size + page_size - 1) & ~(page_size - 1);
+    u32 mapped_size = (size + 1 + PADDING + page_size - 1) & ~(page_size - 1);
+
+    // Reserve zeroed memory for the text, the sentinel, and the padding.
+    void *data = mmap(nullptr, mapped_size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (data == MAP_FAILED) {
+        return Error::FAILURE;
+    }
+
+    // Map the file over the front of the reservation. The kernel zero-fills the remainder of the last
+    // partial page, and any whole page after it is still part of the anonymous reservation.
+    if (size > 0) {
+        if (mmap(data, file_mapped_size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            munmap(data, mapped_size);
+            return Error::FAILURE;
+        }
+
+        // The lexer makes a single forward pass over the text.
+        madvise(data, file_mapped_size, MADV_SEQUENTIAL);
+    }
+
+    _data = reinterpret_cast<const u8 *>(data);
+    _size = size;
+    _mapped_size = mapped_size;
+    return Error::SUCCESS;
+}
+
+
+Error MjSourceText::read(i32 fd, const std::filesystem::path &path) noexcept {
+    static constexpr u32 CHUNK_SIZE = 64 * 1024;
+
+    std::vector<u8> buffer;
+    u64 size = 0;
+
+    // The size of a pipe is unknown, so the buffer grows by a chunk until the end of the file.
+    while (true) {
+        if (size + CHUNK_SIZE + 1 + PADDING >= U32_MAX) {
+            printf("Failed to read file data, the file is too large! '%s'\n", path.c_str());
+            return Error::FAILURE;
+        }
+
+        buffer.resize(size + CHUNK_SIZE);
+        ssize_t read_size = ::read(fd, buffer.data() + size, CHUNK_SIZE);
+
+        if (read_size < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            printf("Failed to read file data! '%s'\n", path.c_str());
+            return Error::FAILURE;
+        }
+
+        if (read_size == 0) {
+            break;
+        }
+
+        size += read_size;
+    }
+
+    // The sentinel and padding are zero initialized.
+    buffer.resize(size);
+    buffer.resize(size + 1 + PADDING, 0);
+    _buffer = std::move(buffer);
+    _data = _buffer.data();
+    _size = size;
+    return Error::SUCCESS;
+}
+
+
+u64 MjSourceText::hash() const noexcept {
+    u64 hash = 0xCBF29CE484222325u;
+
+    for (u32 i = 0; i < _size; ++i) {
+        hash = (hash ^ _data[i]) * 0x00000100000001B3u;
+    }
+
+    return hash;
+}
+
+
+void MjSourceText::replace(u32 offset, u32 size, StringView text) noexcept {
+    u32 new_size = _size - size + text.size();
+
+    // A mapped or viewed text is copied into the buffer on the first edit only.
+    if (_data != _buffer.data()) {
+        u32 old_size = _size;
+        std::vector<u8> buffer;
+        buffer.reserve(new_size + 1 + PADDING);
+        buffer.assign(_data, _data + old_size);
+        unload();
+        _buffer = std::move(buffer);
+        _size = old_size;
+    }
+
+    // Move the text after the range in place, then zero the sentinel and padding after its new end.
+    _buffer.resize(std::max<u32>(_buffer.size(), new_size + 1 + PADDING));
+    std::memmove(_buffer.data() + offset + text.size(), _buffer.data() + offset + size, _size - offset - size);
+    std::memcpy(_buffer.data() + offset, text.data(), text.size());
+    std::memset(_buffer.data() + new_size, 0, 1 + PADDING);
+    _buffer.resize(new_size + 1 + PADDING);
+
+    _data = _buffer.data();
+    _size = new_size;
+}
+
+
+void MjSourceText::unload() noexcept {
+    if (_mapped_size != 0) {
+        munmap(const_cast<u8 *>(_data), _mapped_size);
+    }
+
+    _buffer.clear();
+    _data = nullptr;
+    _size = 0;
+    _mapped_size = 0;
+}
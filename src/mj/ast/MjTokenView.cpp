@@ -0,0 +1,82 @@
+#include <mj/ast/MjTokenView.hpp>
+#include <mj/ast/MjSourceFile.hpp>
+
+#include <algorithm>
+
+
+namespace {
+
+
+/// The encoding of every token kind, so that decoding does not repeat the range checks.
+struct MjTokenEncodingTable {
+    u8 encodings[256] = {};
+
+    constexpr
+    MjTokenEncodingTable() noexcept {
+        for (u32 i = 0; i < 256; ++i) {
+            encodings[i] = MjTokenKind(i).encoding();
+        }
+    }
+};
+
+
+constexpr MjTokenEncodingTable TOKEN_ENCODING_TABLE{};
+
+
+}
+
+
+MjTokenView::MjTokenView(const MjSourceFile &file) noexcept : _stream(file.tokens().data()) {
+    const u8 *data = _stream;
+    u32 stream_size = file.tokens().size();
+
+    // Every token takes at least one byte, so the stream size bounds the token count.
+    _kinds.reserve(stream_size + LOOKAHEAD_SIZE);
+    _payloads.reserve(stream_size + LOOKAHEAD_SIZE);
+    _offsets.reserve(stream_size);
+
+    for (u32 offset = 0; offset < stream_size;) {
+        const u8 *ptr = data + offset;
+        u32 payload = 0;
+        u32 size = 1;
+
+        switch (TOKEN_ENCODING_TABLE.encodings[ptr[0]]) {
+        case MjTokenEncoding::BYTE:
+            payload = ptr[1];
+            size = 2;
+            break;
+        case MjTokenEncoding::STRING:
+            payload = u32(ptr[1]) | u32(ptr[2] & 0x7Fu) << 8;
+
+            if (ptr[2] & 0x80u) {
+                payload |= u32(ptr[3]) << 15;
+                size = 4;
+            } else {
+                size = 3;
+            }
+
+            break;
+        case MjTokenEncoding::INLINE:
+            payload = u32(ptr[1]) | u32(ptr[2]) << 8;
+            size = 3 + payload;
+            break;
+        case MjTokenEncoding::SUBTOKEN:
+            payload = u32(ptr[1]) | u32(ptr[2]) << 8;
+            size = 3;
+            break;
+        }
+
+        _kinds.push_back(ptr[0]);
+        _payloads.push_back(payload);
+        _offsets.push_back(offset);
+        offset += size;
+    }
+
+    _kinds.resize(_kinds.size() + LOOKAHEAD_SIZE, MjTokenKind::NONE);
+    _payloads.resize(_payloads.size() + LOOKAHEAD_SIZE, 0);
+}
+
+
+u32 MjTokenView::index_of(u32 offset) const noexcept {
+    return std::lower_bound(_offsets.begin(), _offsets.end(), offset) - _offsets.begin();
+}
@@ -4,81 +4,157 @@
 
 #include <mj/ast/MjExpression.hpp>
 #include <mj/ast/MjFunction.hpp>
+#include <mj/ast/MjMember.hpp>
 #include <mj/ast/MjVariable.hpp>
 #include <mj/ast/MjMethod.hpp>
+#include <mj/ast/MjTypeName.hpp>
 #include <mj/ast/MjTypeTemplate.hpp>
+#include <mj/MjSourceManager.hpp>
 
 
-const MjType *MjType::find_type(const MjToken *name) const noexcept {
-    for (const MjType *type : types()) {
-        if (type->name() == name) {
-            return type;
-        }
+/// Return the global string ID of the name token of an item.
+static u32 name_id_of(const MjSourceManager &sources, const MjItem *item, MjToken name) noexcept {
+    return sources.global_string_id_of(sources.source_id_of(item), name);
+}
+
+
+void MjType::clear_member_index() noexcept {
+    MemberIndexState *state = _member_index_state.load(std::memory_order_acquire);
+
+    if (state == nullptr) {
+        return;
     }
 
-    return nullptr;
+    std::lock_guard lock(state->mutex);
+    u32 generation = _member_index_generation.load(std::memory_order_acquire);
+
+    // Indexes replaced before the last quiescent point have no readers left.
+    std::erase_if(state->retired_indexes, [&](const MemberIndexState::RetiredIndex &retired_index) {
+        return retired_index.generation != generation;
+    });
+
+    if (state->owned_index != nullptr) {
+        state->index.store(nullptr, std::memory_order_release);
+        state->retired_indexes.push_back({std::move(state->owned_index), generation});
+    }
 }
 
 
-const MjType *MjType::find_type_template(const MjToken *name, const MjTemplateArgumentList &argument_list) const noexcept {
-    for (const MjTypeTemplate *type_template : type_templates()) {
-        if (type_template->name() == name) {
-            return type_template;
-        }
+MjType::MemberIndexState *MjType::member_index_state() const noexcept {
+    MemberIndexState *state = _member_index_state.load(std::memory_order_acquire);
+
+    if (state != nullptr) {
+        return state;
+    }
+
+    MemberIndexState *new_state = new MemberIndexState();
+
+    if (!_member_index_state.compare_exchange_strong(state, new_state, std::memory_order_acq_rel)) {
+        delete new_state;
+        return state;
     }
 
-    return nullptr;
+    return new_state;
 }
 
 
-const MjVariable *MjType::find_variable(const MjToken *name) const noexcept {
+const MjMemberIndex *MjType::build_member_index(const MjSourceManager &sources) const noexcept {
+    MemberIndexState *state = member_index_state();
+    std::lock_guard lock(state->mutex);
+    const MjMemberIndex *member_index = state->index.load(std::memory_order_relaxed);
 
-    // Look for a member variable.
-    for (const MjVariable *variable : members()) {
-        if (variable->name() == name) {
-            return variable;
-        }
+    if (member_index != nullptr) {
+        return member_index;
     }
 
-    // Look for a shared member variable.
-    for (const MjVariable *variable : variables()) {
-        if (variable->name() == name) {
-            return variable;
+    std::vector<MjMemberIndex::Entry> entries;
+
+    // Type names are keyed by global string ID like every other name. A name which was never
+    // interned can not be looked up.
+    for (MjType *type : types()) {
+        u32 name_id = type->has_name() ? sources.strings().search(type->name()->text()) : U32_MAX;
+
+        if (name_id != U32_MAX) {
+            entries.push_back({MjMemberIndex::key(MjMemberKind::TYPE, name_id), type});
         }
     }
 
-    return nullptr;
-}
+    for (MjTypeTemplate *type_template : type_templates()) {
+        entries.push_back({MjMemberIndex::key(MjMemberKind::TYPE_TEMPLATE, name_id_of(sources, type_template, type_template->template_name())), type_template});
+    }
+
+    for (MjVariable *variable : members()) {
+        entries.push_back({MjMemberIndex::key(MjMemberKind::MEMBER, name_id_of(sources, variable, *variable->name())), variable});
+    }
+
+    for (MjVariable *variable : variables()) {
+        entries.push_back({MjMemberIndex::key(MjMemberKind::VARIABLE, name_id_of(sources, variable, *variable->name())), variable});
+    }
 
+    // Functions named by an operator token are operators, keyed by their operator kind.
+    for (MjFunction *function : functions()) {
+        MjToken name = *function->name();
+        u32 arity = function->arity();
 
-const MjFunction *MjType::find_function(const MjToken *name, const MjFunctionArgumentList &argument_list) const noexcept {
-    for (const MjFunction *function : functions()) {
-        if (function->name() == name) {
-            return function;
+        if (name.kind().encoding() == MjTokenEncoding::STRING) {
+            entries.push_back({MjMemberIndex::key(MjMemberKind::FUNCTION, name_id_of(sources, function, name), arity), function});
+        } else {
+            MjOperatorKind kind = arity == 1 ? MjOperatorKind::from_prefix_token(name.kind()) : MjOperatorKind::from_infix_token(name.kind());
+            entries.push_back({MjMemberIndex::key(MjMemberKind::OPERATOR, kind, arity), function});
         }
     }
 
-    return nullptr;
+    for (MjMethod *method : methods()) {
+        entries.push_back({MjMemberIndex::key(MjMemberKind::METHOD, name_id_of(sources, method, *method->name()), method->arity()), method});
+    }
+
+    std::unique_ptr<MjMemberIndex> new_index = std::make_unique<MjMemberIndex>();
+    new_index->build(std::move(entries));
+    member_index = new_index.get();
+    state->owned_index = std::move(new_index);
+    state->index.store(member_index, std::memory_order_release);
+    return member_index;
 }
 
 
-const MjMethod *MjType::find_method(const MjToken *name, const MjFunctionArgumentList &argument_list) const noexcept {
-    for (const MjMethod *method : methods()) {
-        if (method->name() == name) {
-            return method;
-        }
-    }
+const MjType *MjType::find_type(const MjSourceManager &sources, u32 name_id) const noexcept {
+    return static_cast<const MjType *>(member_index(sources).find_first(MjMemberIndex::key(MjMemberKind::TYPE, name_id)));
+}
+
 
-    return nullptr;
+const MjType *MjType::find_type_template(const MjSourceManager &sources, u32 name_id, const MjTemplateArgumentList &argument_list) const noexcept {
+    return static_cast<const MjTypeTemplate *>(member_index(sources).find_first(MjMemberIndex::key(MjMemberKind::TYPE_TEMPLATE, name_id)));
 }
 
 
-const MjFunction *MjType::find_operator(MjOperatorKind kind, const MjFunctionArgumentList &argument_list) const noexcept {
-    for (const MjFunction *function : operators()) {
-        if (function->name() == name) {
-            return function;
-        }
+const MjVariable *MjType::find_variable(const MjSourceManager &sources, u32 name_id) const noexcept {
+
+    // Look for a member variable, then for a shared member variable.
+    const MjVariable *variable = find_member(sources, name_id);
+
+    if (variable != nullptr) {
+        return variable;
     }
 
-    return nullptr;
+    return static_cast<const MjVariable *>(member_index(sources).find_first(MjMemberIndex::key(MjMemberKind::VARIABLE, name_id)));
+}
+
+
+const MjVariable *MjType::find_member(const MjSourceManager &sources, u32 name_id) const noexcept {
+    return static_cast<const MjVariable *>(member_index(sources).find_first(MjMemberIndex::key(MjMemberKind::MEMBER, name_id)));
+}
+
+
+const MjFunction *MjType::find_function(const MjSourceManager &sources, u32 name_id, const MjFunctionArgumentList &argument_list) const noexcept {
+    return static_cast<const MjFunction *>(member_index(sources).find_first(MjMemberIndex::key(MjMemberKind::FUNCTION, name_id, argument_list.size())));
+}
+
+
+const MjMethod *MjType::find_method(const MjSourceManager &sources, u32 name_id, const MjFunctionArgumentList &argument_list) const noexcept {
+    return static_cast<const MjMethod *>(member_index(sources).find_first(MjMemberIndex::key(MjMemberKind::METHOD, name_id, argument_list.size())));
+}
+
+
+const MjFunction *MjType::find_operator(const MjSourceManager &sources, MjOperatorKind kind, const MjFunctionArgumentList &argument_list) const noexcept {
+    return static_cast<const MjFunction *>(member_index(sources).find_first(MjMemberIndex::key(MjMemberKind::OPERATOR, kind, argument_list.size())));
 }
@@ -0,0 +1,1370 @@
+#include <ir/IrBuilder.hpp>
+#include <ir/IrByteCodeCompiler.hpp>
+#include <ir/IrInterpreter.hpp>
+#include <ir/IrLowering.hpp>
+#include <mj/MjFormatter.hpp>
+#include <mj/MjLexer.hpp>
+#include <mj/MjLayoutEngine.hpp>
+#include <mj/MjLexerPool.hpp>
+#include <mj/MjParser.hpp>
+#include <mj/MjStringSet.hpp>
+#include <mj/ast/MjBlockStatement.hpp>
+#include <mj/ast/MjElseStatement.hpp>
+#include <mj/ast/MjExpressionTree.hpp>
+#include <mj/ast/MjFunction.hpp>
+#include <mj/ast/MjIfStatement.hpp>
+#include <mj/ast/MjMember.hpp>
+#include <mj/ast/MjReturnStatement.hpp>
+#include <mj/ast/MjThenStatement.hpp>
+#include <mj/ast/MjTokenView.hpp>
+#include <mj/ast/MjWhileLoop.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+// Throughput benchmarks for the lexer, the string set, the formatter, and the byte code
+// interpreter.
+//
+// The corpus is generated from a seed so that every run measures the same input. Each benchmark
+// is run several times and the fastest run is reported, one JSON object per line:
+//
+//     {"benchmark":"lexer","bytes":...,"tokens":...,"seconds":...,"mb_per_s":...,"tokens_per_s":...}
+//
+// Token counts come from the generator, which counts every lexeme it writes other than spaces.
+//
+// The chunk-parallel lexer is also checked against the serial lexer, and the benchmark fails if
+// their tokens, line offsets, or strings differ, or if any chunk was lexed again serially. The
+// interpreter runs the same byte code with threaded and switch dispatch, and the benchmark fails if
+// their results differ.
+//
+// With `--check chunks`, only the check of the chunk-parallel lexer is run, once and without
+// measuring, and the exit status reports whether it passed. The corpus contains tables whose
+// elements continue on unindented lines, so chunks start inside brackets and interpolated strings.
+// With `--check edits`, random edits are applied to the corpus and re-lexed incrementally, and
+// each result is compared with lexing the edited text from scratch. With `--check parse`, the corpus
+// is parsed, and the check fails on syntax errors or unless the expressions of every function body
+// were parsed into the expression tree of the function. With `--check layout`, the types of the
+// corpus are laid out with their members in declaration order and reordered, and the check fails
+// unless every layout is consistent and reordering never makes a type larger. With `--check lower`,
+// a fixed program is lowered to SSA form, compiled to byte code and run, and the check fails unless
+// every function returns the expected results.
+
+
+struct Args {
+    u32 size = 4 << 20;
+    u64 seed = 1;
+    u32 iterations = 5;
+    u32 threads = std::max(std::thread::hardware_concurrency(), 1u);
+    std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const char *check = nullptr;
+} args;
+
+
+///
+/// Corpus Generation
+///
+
+
+/// A generator of syntactically plausible Mjolnir source text.
+class CorpusGenerator {
+private:
+    std::string _out;
+    std::vector<std::string> _identifiers;
+    u64 _state;
+    u64 _token_count = 0;
+    u32 _depth = 0;
+
+    static constexpr u32 MAX_DEPTH = 12;
+
+    static constexpr const char *TYPES[] = {
+        "u8", "u16", "u32", "u64", "i32", "i64", "f32", "f64", "bool", "StringView", "Vector<u32>",
+    };
+
+    static constexpr const char *SUFFIXES[] = {"", "", "", "u", "u8", "u32", "i64", "f"};
+    static constexpr const char *UNITS[] = {"Hz", "km", "ms", "1/mV", "kg"};
+    static constexpr const char *ESCAPES[] = {"\\n", "\\t", "\\\"", "\\x41", "\\u00E9", "\\o177"};
+    static constexpr const char *OPERATORS[] = {
+        "+", "-", "*", "/", "%", "&", "|", "^", "<<", ">>", "&&", "||", "==", "!=", "<", "<=", ">", ">=",
+    };
+    static constexpr const char *ASSIGNMENTS[] = {"=", "+=", "-=", "*=", "/=", "&=", "|=", "^="};
+    static constexpr const char *COMMANDS[] = {"ls", "grep", "cp", "mkdir", "git", "make"};
+public:
+
+
+    CorpusGenerator(u64 seed) noexcept :
+        _state(seed * 0x9E3779B97F4A7C15u | 1)
+    {}
+
+
+    /// Generate at least `size` bytes of source text.
+    std::string generate(u32 size) noexcept {
+        while (_identifiers.size() < 512) {
+            std::string identifier = make_identifier();
+
+            if (!is_reserved_name(identifier)) {
+                _identifiers.push_back(std::move(identifier));
+            }
+        }
+
+        library_types();
+
+        while (_out.size() < size) {
+            if (below(4) == 0) {
+                table_definition();
+            } else {
+                type_definition();
+            }
+        }
+
+        return std::move(_out);
+    }
+
+
+    u64 token_count() const noexcept {
+        return _token_count;
+    }
+
+
+    const std::vector<std::string> &identifiers() const noexcept {
+        return _identifiers;
+    }
+
+
+private:
+
+
+    ///
+    /// Randomness
+    ///
+
+
+    u64 next() noexcept {
+        _state ^= _state >> 12;
+        _state ^= _state << 25;
+        _state ^= _state >> 27;
+        return _state * 0x2545F4914F6CDD1Du;
+    }
+
+
+    u32 below(u32 n) noexcept {
+        return next() % n;
+    }
+
+
+    template<class T, u32 N>
+    const T &pick(const T (&items)[N]) noexcept {
+        return items[below(N)];
+    }
+
+
+    /// Return true if the lexer reads the word as a reserved name, such as the keyword `do`.
+    static bool is_reserved_name(std::string_view word) noexcept {
+        for (u8 id = MjTokenKind::AND; id <= MjTokenKind::UNINITIALIZED; ++id) {
+            StringView text = MjTokenKind(id).builtin_text();
+
+            if (word == std::string_view(reinterpret_cast<const char *>(text.data()), text.size())) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+
+    std::string make_identifier() noexcept {
+        std::string identifier;
+        u32 size = 2 + below(14);
+
+        for (u32 i = 0; i < size; ++i) {
+            identifier += char(i > 0 && below(6) == 0 ? '_' : 'a' + below(26));
+        }
+
+        return identifier;
+    }
+
+
+    ///
+    /// Output
+    ///
+
+
+    void token(std::string_view text) noexcept {
+        _out += text;
+        _token_count += 1;
+    }
+
+
+    void space() noexcept {
+        _out += ' ';
+    }
+
+
+    void newline() noexcept {
+        _out += '\n';
+        _out.append(4 * _depth, ' ');
+        _token_count += 1;
+    }
+
+
+    void blank_line() noexcept {
+        _out += '\n';
+    }
+
+
+    void variable_name() noexcept {
+        token(_identifiers[below(_identifiers.size())]);
+    }
+
+
+    void type_name() noexcept {
+        const std::string &identifier = _identifiers[below(_identifiers.size())];
+        std::string name = identifier;
+        name[0] = name[0] - 'a' + 'A';
+
+        for (u32 i = 1; i < name.size(); ++i) {
+            if (name[i] == '_') {
+                name[i] = 'X';
+            }
+        }
+
+        // Names without lowercase letters, such as `AX`, are constant names.
+        if (std::none_of(name.begin(), name.end(), [](char ch) { return ch >= 'a' && ch <= 'z'; })) {
+            name += 'x';
+        }
+
+        token(name);
+    }
+
+
+    void constant_name() noexcept {
+        std::string name = _identifiers[below(_identifiers.size())];
+
+        for (char &ch : name) {
+            ch = ch == '_' ? '_' : ch - 'a' + 'A';
+        }
+
+        token(name);
+    }
+
+
+    void numeric_literal() noexcept {
+        char text[48];
+
+        switch (below(4)) {
+        case 0: snprintf(text, sizeof(text), "%u%s", below(100000), pick(SUFFIXES)); break;
+        case 1: snprintf(text, sizeof(text), "0x%X%s", u32(next()), pick(SUFFIXES)); break;
+        case 2: {
+            i32 exponent = i32(below(40)) - 20;
+            snprintf(text, sizeof(text), "%u.%ue%d%s", below(1000), below(1000), exponent, pick(SUFFIXES));
+            break;
+        }
+        case 3: snprintf(text, sizeof(text), "0b%s", below(2) ? "1011001" : "110"); break;
+        }
+
+        token(text);
+    }
+
+
+    void unit_expression() noexcept {
+        char text[32];
+        snprintf(text, sizeof(text), "%u.%u", below(1000), below(100));
+        token(text);
+        space();
+        token(pick(UNITS));
+    }
+
+
+    void string_literal() noexcept {
+        std::string text = "\"";
+        u32 parts = 1 + below(4);
+
+        for (u32 i = 0; i < parts; ++i) {
+            text += _identifiers[below(_identifiers.size())];
+            text += below(2) ? " " : pick(ESCAPES);
+        }
+
+        text += '"';
+        token(text);
+    }
+
+
+    /// A string with an interpolated expression, which may contain nested strings and braces.
+    void interpolated_string_literal() noexcept {
+        u32 depth = 1 + below(2);
+        std::string text = "\"";
+        text += _identifiers[below(_identifiers.size())];
+        text += ' ';
+        text.append(depth, '{');
+        text += _identifiers[below(_identifiers.size())];
+        text += below(2) ? " + 1" : ".join(\", \")";
+        text.append(depth, '}');
+        text += '"';
+        token(text);
+    }
+
+
+    /// The arguments of a shell command: short and long options, and operands.
+    void shell_arguments() noexcept {
+        token(pick(COMMANDS));
+
+        for (u32 i = below(4); i > 0; --i) {
+            space();
+
+            switch (below(3)) {
+            case 0: {
+                char option[2] = {char('a' + below(26)), 0};
+                token("-");
+                token(option);
+                break;
+            } case 1: {
+                token("--");
+                variable_name();
+                break;
+            } default: {
+                variable_name();
+            }
+            }
+        }
+    }
+
+
+    void operand() noexcept {
+        switch (below(9)) {
+        case 0: numeric_literal(); break;
+        case 1: unit_expression(); break;
+        case 2: string_literal(); break;
+        case 3: interpolated_string_literal(); break;
+        case 4: constant_name(); break;
+        case 5: {
+            token("$");
+            token("(");
+            shell_arguments();
+            token(")");
+            break;
+        } default: variable_name(); break;
+        }
+    }
+
+
+    void expression(u32 depth = 0) noexcept {
+        operand();
+
+        for (u32 i = below(3); i > 0; --i) {
+            space();
+            token(pick(OPERATORS));
+            space();
+
+            if (depth < 3 && below(4) == 0) {
+                token("(");
+                expression(depth + 1);
+                token(")");
+            } else {
+                operand();
+            }
+        }
+    }
+
+
+    ///
+    /// Structure
+    ///
+
+
+    void alignment_annotation(u32 alignment) noexcept {
+        token("@");
+        token("alignment");
+        token("(");
+        token(std::to_string(alignment));
+        token(")");
+        newline();
+    }
+
+
+    /// The types of `TYPES` which are not builtin, so that every member of the corpus has a layout.
+    void library_types() noexcept {
+        static constexpr const char *LIBRARY_TYPES[][3] = {
+            {"StringView", "u8* data", "u64 size"},
+            {"Vector", "u32* data", "u64 size"},
+        };
+
+        for (const auto &library_type : LIBRARY_TYPES) {
+            token("struct");
+            space();
+            token(library_type[0]);
+            space();
+            token("{");
+            _depth += 1;
+
+            for (u32 i = 1; i < 3; ++i) {
+                newline();
+                _out += library_type[i];
+                _token_count += 3;
+            }
+
+            _depth -= 1;
+            newline();
+            token("}");
+            blank_line();
+            newline();
+        }
+    }
+
+
+    void type_definition() noexcept {
+        if (below(8) == 0) {
+            alignment_annotation(16);
+        }
+
+        token("class");
+        space();
+        type_name();
+        space();
+        token("{");
+        _depth += 1;
+
+        for (u32 i = 1 + below(6); i > 0; --i) {
+            newline();
+
+            if (below(8) == 0) {
+                alignment_annotation(8);
+            }
+
+            token(pick(TYPES));
+
+            if (below(6) == 0) {
+                token("[");
+                token(std::to_string(1 + below(7)));
+                token("]");
+            }
+
+            space();
+            variable_name();
+            space();
+            token("=");
+            space();
+            expression();
+        }
+
+        for (u32 i = 1 + below(4); i > 0; --i) {
+            blank_line();
+            newline();
+            function_definition();
+        }
+
+        _depth -= 1;
+        newline();
+        token("}");
+        blank_line();
+        newline();
+    }
+
+
+    /// A constant table whose elements continue on unindented lines, so that chunks of the file
+    /// may start inside its brackets.
+    void table_definition() noexcept {
+        token(pick(TYPES));
+        space();
+        constant_name();
+        space();
+        token("=");
+        space();
+        token("[");
+
+        for (u32 i = 1 + below(6); i > 0; --i) {
+            newline();
+
+            if (below(3) == 0) {
+                token("[");
+                expression();
+                token(",");
+                space();
+                interpolated_string_literal();
+                token("]");
+            } else {
+                interpolated_string_literal();
+            }
+
+            token(",");
+        }
+
+        newline();
+        token("]");
+        blank_line();
+        newline();
+    }
+
+
+    void function_definition() noexcept {
+        token(pick(TYPES));
+        space();
+        variable_name();
+        token("(");
+
+        for (u32 i = below(4); i > 0; --i) {
+            token(pick(TYPES));
+            space();
+            variable_name();
+
+            if (i > 1) {
+                token(",");
+                space();
+            }
+        }
+
+        token(")");
+        space();
+        block();
+    }
+
+
+    void block() noexcept {
+        token("{");
+        _depth += 1;
+
+        for (u32 i = 1 + below(5); i > 0; --i) {
+            newline();
+            statement();
+        }
+
+        _depth -= 1;
+        newline();
+        token("}");
+    }
+
+
+    void statement() noexcept {
+
+        // Nest deeper while the indent allows, to exercise long runs of leading spaces.
+        if (_depth < MAX_DEPTH && below(3) == 0) {
+            token(below(2) ? "if" : "while");
+            space();
+            token("(");
+            expression();
+            token(")");
+            space();
+            block();
+            return;
+        }
+
+        // A shell statement, which runs to the end of the line.
+        if (below(8) == 0) {
+            token("$");
+            space();
+            shell_arguments();
+            return;
+        }
+
+        variable_name();
+        space();
+        token(pick(ASSIGNMENTS));
+        space();
+        expression();
+    }
+};
+
+
+///
+/// Measurement
+///
+
+
+struct Measurement {
+    const char *benchmark;
+    u64 bytes;
+    u64 items;
+    f64 seconds;
+};
+
+
+/// Run the function `args.iterations` times and return the fastest time in seconds.
+template<class Function>
+f64 measure(Function function) noexcept {
+    f64 best = 0;
+
+    for (u32 i = 0; i < args.iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        auto end = std::chrono::steady_clock::now();
+        f64 seconds = std::chrono::duration<f64>(end - start).count();
+
+        if (i == 0 || seconds < best) {
+            best = seconds;
+        }
+    }
+
+    return best;
+}
+
+
+void report(const char *item_name, Measurement measurement) noexcept {
+    printf(
+        "{\"benchmark\":\"%s\",\"bytes\":%lu,\"%s\":%lu,\"seconds\":%.6f,\"mb_per_s\":%.2f,\"%s_per_s\":%.0f}\n",
+        measurement.benchmark,
+        measurement.bytes,
+        item_name,
+        measurement.items,
+        measurement.seconds,
+        measurement.bytes / measurement.seconds / 1e6,
+        item_name,
+        measurement.items / measurement.seconds
+    );
+
+    fflush(stdout);
+}
+
+
+/// Return true if both files were lexed into the same tokens, line offsets, and strings.
+bool is_same_lexing(const MjSourceFile &a, const MjSourceFile &b) noexcept {
+    if (a.tokens() != b.tokens() || a.line_count() != b.line_count() || a.string_count() != b.string_count()) {
+        return false;
+    }
+
+    for (u32 i = 0; i < a.line_count(); ++i) {
+        if (a.line_offset(i) != b.line_offset(i)) {
+            return false;
+        }
+    }
+
+    for (u32 id = 0; id < a.string_count(); ++id) {
+        if (a.string(id) != b.string(id)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/// Lex the file serially and in chunks, and return false if the results differ or if any chunk
+/// had to be lexed again serially.
+///
+/// If `requires_nested_chunk` is set, also return false unless a chunk starts inside brackets, which
+/// is where the lexer state of a chunk differs from the serial lexer until the brackets close.
+bool check_chunked_lexing(const std::filesystem::path &path, bool requires_nested_chunk) noexcept {
+    MjSourceFile *file = MjLexer::parse_file(path, false, requires_nested_chunk);
+    u32 relexed_chunk_count = 0;
+    MjSourceFile *chunked_file = MjLexerPool::parse_file_chunks(path, args.threads, false, &relexed_chunk_count);
+    bool is_same = file != nullptr && chunked_file != nullptr && is_same_lexing(*file, *chunked_file);
+    u32 nested_chunk_count = 0;
+
+    if (is_same && requires_nested_chunk) {
+        std::vector<u32> offsets = MjLexerPool::chunk_offsets(file->text(), args.threads);
+
+        for (u32 i = 1; i + 1 < offsets.size(); ++i) {
+            const MjLexerCheckpoint &line_start = file->line_starts()[file->find_line_start(offsets[i])];
+            nested_chunk_count += line_start.state != MjLexerState::NONE;
+        }
+    }
+
+    delete file;
+    delete chunked_file;
+
+    if (!is_same) {
+        printf("Chunked lexing differs from serial lexing!\n");
+        return false;
+    }
+
+    if (relexed_chunk_count != 0) {
+        printf("Failed to merge %u chunks! They were lexed again serially.\n", relexed_chunk_count);
+        return false;
+    }
+
+    if (requires_nested_chunk && nested_chunk_count == 0) {
+        printf("No chunk starts inside brackets! Use a larger corpus or more threads.\n");
+        return false;
+    }
+
+    return true;
+}
+
+
+/// Return true if both files have the same token kinds and texts, and their lines start at the same
+/// tokens. Unlike `is_same_lexing()`, string IDs may differ, since an edited file keeps the IDs of
+/// its earlier strings.
+bool is_same_edited_lexing(const MjSourceFile &a, const MjSourceFile &b) noexcept {
+    MjTokenView a_tokens(a);
+    MjTokenView b_tokens(b);
+
+    if (a_tokens.size() != b_tokens.size() || a.line_count() != b.line_count()) {
+        return false;
+    }
+
+    for (u32 i = 0; i < a_tokens.size(); ++i) {
+        MjTokenKind kind = a_tokens.kind(i);
+
+        if (kind != b_tokens.kind(i)) {
+            return false;
+        }
+
+        if (kind.encoding() == MjTokenEncoding::STRING || kind.encoding() == MjTokenEncoding::INLINE) {
+            if (a.text_of(a_tokens.token(i)) != b.text_of(b_tokens.token(i))) {
+                return false;
+            }
+        } else if (a_tokens.payload(i) != b_tokens.payload(i)) {
+            return false;
+        }
+    }
+
+    for (u32 i = 0; i < a.line_count(); ++i) {
+        if (a_tokens.index_of(a.line_offset(i)) != b_tokens.index_of(b.line_offset(i))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/// Apply random edits to the file, which are re-lexed incrementally, and return false unless each
+/// edited file matches lexing its text from scratch. The edits insert and delete brackets, line
+/// breaks, and indentation, so that the lexer state at the following lines changes.
+bool check_incremental_lexing(const std::filesystem::path &path) noexcept {
+    static constexpr u32 EDIT_COUNT = 2000;
+    static constexpr std::string_view INSERTIONS[] = {
+        "", "(", ")", "[", "]", "{", "}", "\n", "\n    ", "    ", " ", "x", "Type", "\"{a + (b)}\"", "\"",
+        "'", "$ ls -l\n", "$(", "0x1F", "// note\n", "<", ">", "*", "&",
+    };
+
+    MjSourceFile *file = MjLexer::parse_file(path, false, true);
+
+    if (file == nullptr) {
+        return false;
+    }
+
+    std::mt19937_64 random(args.seed);
+    bool is_same = true;
+
+    for (u32 i = 0; i < EDIT_COUNT && is_same; ++i) {
+        u32 text_size = file->text().size();
+        u32 offset = random() % (text_size + 1);
+        u32 size = std::min<u32>(random() % 8, text_size - offset);
+        std::string_view insertion = INSERTIONS[random() % std::size(INSERTIONS)];
+        StringView text = {reinterpret_cast<const u8 *>(insertion.data()), u32(insertion.size())};
+
+        if (file->edit({offset, size, text}).is_failure()) {
+            delete file;
+            return false;
+        }
+
+        MjSourceFile fresh_file(path, file->text().view());
+
+        if (MjLexer::parse_chunk(fresh_file, 0, fresh_file.text().size(), false).is_failure()) {
+            delete file;
+            return false;
+        }
+
+        is_same = is_same_edited_lexing(*file, fresh_file);
+
+        if (!is_same) {
+            printf("Incremental lexing differs from lexing from scratch after edit %u at offset %u!\n", i, offset);
+        }
+    }
+
+    delete file;
+    return is_same;
+}
+
+
+/// Count the expressions of a statement and its nested statements, and return false if any of them
+/// is not part of the expression tree of its function.
+bool check_statement_expressions(const MjStatement *statement, const MjExpressionTree *expressions, u32 &expression_count) noexcept {
+    if (statement == nullptr) {
+        return true;
+    }
+
+    MjItemKind item_kind = statement->item_kind();
+
+    if (item_kind.is_expression()) {
+        const MjTreeExpression *expression = static_cast<const MjTreeExpression *>(statement);
+        expression_count += 1;
+        return &expression->tree() == expressions && item_kind != MjItemKind::INVALID_EXPRESSION;
+    }
+
+    if (item_kind == MjItemKind::BLOCK_STATEMENT) {
+        for (const MjStatement *nested_statement : static_cast<const MjBlockStatement *>(statement)->statements()) {
+            if (!check_statement_expressions(nested_statement, expressions, expression_count)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    if (item_kind == MjItemKind::IF_STATEMENT) {
+        const MjIfStatement *if_statement = static_cast<const MjIfStatement *>(statement);
+        const MjStatement *else_body = if_statement->has_else_statement() ? if_statement->else_statement()->body() : nullptr;
+
+        return
+            check_statement_expressions(if_statement->condition(), expressions, expression_count) &&
+            check_statement_expressions(if_statement->then_statement()->body(), expressions, expression_count) &&
+            check_statement_expressions(else_body, expressions, expression_count);
+    }
+
+    if (item_kind == MjItemKind::WHILE_LOOP) {
+        const MjWhileLoop *while_loop = static_cast<const MjWhileLoop *>(statement);
+
+        return
+            check_statement_expressions(while_loop->condition(), expressions, expression_count) &&
+            check_statement_expressions(while_loop->block(), expressions, expression_count);
+    }
+
+    if (item_kind == MjItemKind::RETURN_STATEMENT) {
+        return check_statement_expressions(static_cast<const MjReturnStatement *>(statement)->return_value(), expressions, expression_count);
+    }
+
+    return true;
+}
+
+
+/// Parse the file, and return false if it has syntax errors or unless every function of its types
+/// has a body whose expressions were parsed into the expression tree of the function.
+bool check_parsing(const std::filesystem::path &path) noexcept {
+    MjSourceFile *file = MjLexer::parse_file(path);
+
+    if (file == nullptr) {
+        return false;
+    }
+
+    MjItemManager item_manager;
+    MjModule *module = MjParser::parse(item_manager, 0, *file);
+    bool is_passed = module != nullptr;
+    u32 function_count = 0;
+    u32 expression_count = 0;
+
+    for (u32 i = 0; is_passed && i < module->types().size(); ++i) {
+        for (const MjFunction *function : module->types()[i]->functions()) {
+            function_count += 1;
+
+            if (function->body() == nullptr || !check_statement_expressions(function->body(), function->expressions(), expression_count)) {
+                printf("Failed to parse the body of a function into its expression tree!\n");
+                is_passed = false;
+                break;
+            }
+        }
+    }
+
+    if (is_passed && (function_count == 0 || expression_count == 0)) {
+        printf("The corpus has no function bodies! Use a larger corpus.\n");
+        is_passed = false;
+    }
+
+    delete file;
+    return is_passed;
+}
+
+
+/// Return true if the members of a laid out structure or class are aligned, do not overlap, and fit
+/// in the type, and the padding of the type accounts for the rest of it.
+bool check_type_layout(const MjType *type) noexcept {
+    std::vector<const MjMember *> members(type->members().begin(), type->members().end());
+    u32 end = 0;
+    u32 member_size = 0;
+
+    std::sort(members.begin(), members.end(), [](const MjMember *a, const MjMember *b) {
+        return a->offset() < b->offset();
+    });
+
+    for (const MjMember *member : members) {
+        if (member->offset() < end || member->offset() % member->type()->alignment() != 0) {
+            return false;
+        }
+
+        end = member->offset() + member->type()->size();
+        member_size += member->type()->size();
+    }
+
+    return end <= type->size() && type->size() % type->alignment() == 0 && type->padding() == type->size() - member_size;
+}
+
+
+/// Lay out the types of the file, once with the members in declaration order and once reordered.
+/// Return false if a type has no layout or an inconsistent one, if reordering made a type larger,
+/// or if the size of a type before its layout is not the sum of its member sizes.
+bool check_layout(const std::filesystem::path &path) noexcept {
+    MjSourceFile *file = MjLexer::parse_file(path);
+
+    if (file == nullptr) {
+        return false;
+    }
+
+    MjItemManager item_managers[2];
+    MjModule *modules[2] = {MjParser::parse(item_managers[0], 0, *file), MjParser::parse(item_managers[1], 0, *file)};
+    bool is_passed = modules[0] != nullptr && modules[1] != nullptr;
+    u32 padded_count = 0;
+
+    if (is_passed) {
+        MjLayoutEngine layout_engine(item_managers[0].source_manager());
+        MjLayoutEngine reordering_layout_engine(item_managers[1].source_manager());
+        reordering_layout_engine.set_reorder_members(true);
+
+        for (u32 i = 0; is_passed && i < modules[0]->types().size(); ++i) {
+            MjType *type = modules[0]->types()[i];
+            MjType *reordered_type = modules[1]->types()[i];
+            u32 member_size = 0;
+
+            for (const MjMember *member : type->members()) {
+                member_size += member->type()->size();
+            }
+
+            if (!type->has_layout() && type->size() != member_size) {
+                printf("The size of a type before its layout is not the sum of its member sizes!\n");
+                is_passed = false;
+            } else if (layout_engine.layout(type) != Error::SUCCESS || reordering_layout_engine.layout(reordered_type) != Error::SUCCESS) {
+                is_passed = false;
+            } else if (!check_type_layout(type) || !check_type_layout(reordered_type)) {
+                printf("Inconsistent layout of a type!\n");
+                is_passed = false;
+            } else if (reordered_type->size() > type->size()) {
+                printf("Reordering the members of a type made it larger!\n");
+                is_passed = false;
+            }
+
+            padded_count += type->padding() > 0;
+        }
+    }
+
+    if (is_passed && padded_count == 0) {
+        printf("The corpus has no padded types! Use a larger corpus.\n");
+        is_passed = false;
+    }
+
+    delete file;
+    return is_passed;
+}
+
+
+/// Functions lowered, compiled to byte code and run by `--check lower`, with their expected results.
+static constexpr const char LOWERING_PROGRAM[] = R"(i64 fib(i64 n) {
+    if n < 2 {
+        return n
+    }
+
+    return fib(n - 1) + fib(n - 2)
+}
+
+
+i64 sum_squares(i64 n) {
+    i64 sum = 0
+    i64 i = 0
+
+    while i < n {
+        sum += i * i % 7
+        i++
+    }
+
+    return sum
+}
+
+
+i64 collatz_steps(i64 n) {
+    i64 steps = 0
+
+    while n != 1 {
+        if n % 2 == 0 {
+            n /= 2
+        } else {
+            n = 3 * n + 1
+        }
+
+        steps += 1
+    }
+
+    return steps
+}
+
+
+i64 gcd(i64 a, i64 b) {
+    while b != 0 {
+        i64 t = b
+        b = a % b
+        a = t
+    }
+
+    return a
+}
+
+
+i64 first_multiple(i64 n, i64 k) {
+    i64 i = 1
+
+    while true {
+        if i < n || i % k != 0 {
+            i += 1
+            continue
+        }
+
+        break
+    }
+
+    return i
+}
+
+
+i64 sign(i64 x) {
+    if x < 0 && -x > 0 {
+        return -1
+    } else if x == 0 {
+        return 0
+    }
+
+    return 1
+}
+
+
+i64 bits(i64 x) {
+    return (x & 0xF0) >> 4 | (x ^ 0b11) << 8
+}
+)";
+
+
+struct LoweringCase {
+    const char *function;
+    std::vector<i64> arguments;
+    i64 result;
+};
+
+
+/// Parse `LOWERING_PROGRAM` from a file in the directory, lower its functions to SSA form, compile
+/// them to byte code and run them with both dispatches. Return false unless every function is
+/// lowered and returns the expected results.
+bool check_lowering(const std::filesystem::path &dir) noexcept {
+    static const LoweringCase CASES[] = {
+        {"fib", {20}, 6765},
+        {"sum_squares", {100}, 197},
+        {"collatz_steps", {27}, 111},
+        {"gcd", {1071, 462}, 21},
+        {"first_multiple", {10, 7}, 14},
+        {"sign", {-5}, -1},
+        {"sign", {0}, 0},
+        {"sign", {9}, 1},
+        {"bits", {0x5A}, 0x5905},
+    };
+
+    std::filesystem::path path = dir / "mjbench-lowering.mj";
+
+    {
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+        stream << LOWERING_PROGRAM;
+    }
+
+    MjSourceFile *file = MjLexer::parse_file(path);
+    std::filesystem::remove(path);
+
+    if (file == nullptr) {
+        return false;
+    }
+
+    MjItemManager item_manager;
+    MjModule *module = MjParser::parse(item_manager, 0, *file);
+    bool is_passed = module != nullptr;
+    MjTokenView tokens(*file);
+    std::unordered_map<u32, u32> function_indices;
+    std::unordered_map<std::string_view, u32> function_names;
+    std::vector<IrByteCodeFunction> functions;
+
+    for (u32 i = 0; is_passed && i < module->functions().size(); ++i) {
+        const MjFunction *function = module->functions()[i];
+        StringView name = file->text_of(*function->name());
+        function_indices.emplace(function->name()->string_id(), i);
+        function_names.emplace(std::string_view(reinterpret_cast<const char *>(name.data()), name.size()), i);
+    }
+
+    for (u32 i = 0; is_passed && i < module->functions().size(); ++i) {
+        const MjFunction *function = module->functions()[i];
+        IrFunction ir_function;
+
+        if (IrLowering(*file, tokens).lower(function->parameters(), *function->body(), ir_function) != Error::SUCCESS) {
+            is_passed = false;
+            break;
+        }
+
+        functions.emplace_back();
+
+        if (IrByteCodeCompiler(ir_function, function_indices).compile(functions.back()) != Error::SUCCESS) {
+            is_passed = false;
+        }
+    }
+
+    IrInterpreter interpreter({functions.data(), u32(functions.size())});
+
+    for (const LoweringCase &lowering_case : CASES) {
+        if (!is_passed) {
+            break;
+        }
+
+        auto function = function_names.find(lowering_case.function);
+        Slice<const i64> arguments = {lowering_case.arguments.data(), u32(lowering_case.arguments.size())};
+        i64 results[2] = {};
+
+        for (u8 dispatch : {IrDispatch::THREADED, IrDispatch::SWITCH}) {
+            if (function == function_names.end() || interpreter.run(function->second, arguments, results[dispatch], IrDispatch(dispatch)) != Error::SUCCESS) {
+                printf("Failed to run the lowered function! '%s'\n", lowering_case.function);
+                is_passed = false;
+            }
+        }
+
+        if (is_passed && (results[0] != lowering_case.result || results[1] != lowering_case.result)) {
+            printf("The lowered function returned a wrong result! %s = %ld and %ld, expected %ld\n", lowering_case.function, results[0], results[1], lowering_case.result);
+            is_passed = false;
+        }
+    }
+
+    delete file;
+    return is_passed;
+}
+
+
+template<class StringSet>
+void benchmark_string_set(const char *insert_name, const char *search_name, const std::vector<StringView> &words, u64 bytes) noexcept {
+    f64 insert_seconds = measure([&] {
+        StringSet strings;
+
+        for (StringView word : words) {
+            strings.insert(word);
+        }
+    });
+
+    StringSet strings;
+
+    for (StringView word : words) {
+        strings.insert(word);
+    }
+
+    u64 found = 0;
+
+    f64 search_seconds = measure([&] {
+        for (StringView word : words) {
+            found += strings.has_string_id(strings.search(word));
+        }
+    });
+
+    if (found == 0) {
+        printf("String set search found nothing!\n");
+    }
+
+    report("ops", {insert_name, bytes, words.size(), insert_seconds});
+    report("ops", {search_name, bytes, words.size(), search_seconds});
+}
+
+
+///
+/// Byte Code
+///
+
+
+/// Build `f(n)`, which sums `i * i % 7` for `i` from 0 to `n`.
+IrFunction build_loop_function() noexcept {
+    static constexpr u32 N = 0;
+    static constexpr u32 I = 1;
+    static constexpr u32 SUM = 2;
+    IrBuilder builder;
+    u32 header_block = builder.create_block();
+    u32 body_block = builder.create_block();
+    u32 exit_block = builder.create_block();
+
+    builder.write_variable(N, builder.parameter());
+    builder.write_variable(I, builder.constant(0));
+    builder.write_variable(SUM, builder.constant(0));
+    builder.jump(header_block);
+    builder.set_block(header_block);
+    builder.branch(builder.binary(IrOpcode::LT, builder.read_variable(I), builder.read_variable(N)), body_block, exit_block);
+    builder.seal_block(body_block);
+    builder.set_block(body_block);
+    u32 square = builder.binary(IrOpcode::MUL, builder.read_variable(I), builder.read_variable(I));
+    u32 remainder = builder.binary(IrOpcode::REM, square, builder.constant(7));
+    builder.write_variable(SUM, builder.binary(IrOpcode::ADD, builder.read_variable(SUM), remainder));
+    builder.write_variable(I, builder.binary(IrOpcode::ADD, builder.read_variable(I), builder.constant(1)));
+    builder.jump(header_block);
+    builder.seal_block(header_block);
+    builder.seal_block(exit_block);
+    builder.set_block(exit_block);
+    builder.return_value(builder.read_variable(SUM));
+    return builder.finish();
+}
+
+
+/// Build the naive recursive Fibonacci function, which calls the function with ID `function_id`.
+IrFunction build_fibonacci_function(u32 function_id) noexcept {
+    IrBuilder builder;
+    u32 n = builder.parameter();
+    u32 base_block = builder.create_block();
+    u32 recursive_block = builder.create_block();
+
+    builder.branch(builder.binary(IrOpcode::LT, n, builder.constant(2)), base_block, recursive_block);
+    builder.seal_block(base_block);
+    builder.seal_block(recursive_block);
+    builder.set_block(base_block);
+    builder.return_value(n);
+    builder.set_block(recursive_block);
+    u32 a = builder.call(function_id, {builder.binary(IrOpcode::SUB, n, builder.constant(1))});
+    u32 b = builder.call(function_id, {builder.binary(IrOpcode::SUB, n, builder.constant(2))});
+    builder.return_value(builder.binary(IrOpcode::ADD, a, b));
+    return builder.finish();
+}
+
+
+/// Run a function with both dispatches and report them. Return false if their results differ.
+bool benchmark_interpreter(const char *name, const std::vector<IrByteCodeFunction> &functions, u32 function, i64 argument, u64 items) noexcept {
+    IrInterpreter interpreter({functions.data(), u32(functions.size())});
+    u64 code_size = functions[function].code().size() * sizeof(IrByteCodeInstruction);
+    i64 results[2] = {};
+    Error errors[2] = {Error::SUCCESS, Error::SUCCESS};
+
+    for (u8 dispatch : {IrDispatch::THREADED, IrDispatch::SWITCH}) {
+        f64 seconds = measure([&] {
+            errors[dispatch] = interpreter.run(function, {&argument, 1}, results[dispatch], IrDispatch(dispatch));
+        });
+
+        std::string benchmark = std::string(name) + (dispatch == IrDispatch::THREADED ? "_threaded" : "_switch");
+        report("items", {benchmark.c_str(), code_size, items, seconds});
+    }
+
+    return errors[0] == Error::SUCCESS && errors[1] == Error::SUCCESS && results[0] == results[1];
+}
+
+
+int main(int argc, const char *argv[]) {
+    for (i32 i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--size") == 0) {
+            args.size = std::atoi(argv[i + 1]) << 10;
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            args.seed = std::strtoull(argv[i + 1], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--iterations") == 0) {
+            args.iterations = std::max(std::atoi(argv[i + 1]), 1);
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            args.threads = std::max(std::atoi(argv[i + 1]), 1);
+        } else if (std::strcmp(argv[i], "--dir") == 0) {
+            args.dir = argv[i + 1];
+        } else if (
+            std::strcmp(argv[i], "--check") == 0 &&
+            (std::strcmp(argv[i + 1], "chunks") == 0 || std::strcmp(argv[i + 1], "edits") == 0 || std::strcmp(argv[i + 1], "parse") == 0 || std::strcmp(argv[i + 1], "layout") == 0 ||
+            std::strcmp(argv[i + 1], "lower") == 0)
+        ) {
+            args.check = argv[i + 1];
+        } else {
+            printf("Usage: mjbench [--size KiB] [--seed N] [--iterations N] [--threads N] [--dir DIR] [--check chunks|edits|parse|layout|lower]\n");
+            return 1;
+        }
+    }
+
+    CorpusGenerator generator(args.seed);
+    std::string corpus = generator.generate(args.size);
+    std::filesystem::path corpus_path = args.dir / ("mjbench-" + std::to_string(args.seed) + ".mj");
+
+    {
+        std::ofstream corpus_stream(corpus_path, std::ios::binary | std::ios::trunc);
+        corpus_stream.write(corpus.data(), corpus.size());
+
+        if (!corpus_stream) {
+            printf("Failed to write corpus! '%s'\n", corpus_path.c_str());
+            return 1;
+        }
+    }
+
+    // Differential checks, which lex the corpus once instead of measuring, and the parser check.
+    if (args.check != nullptr) {
+        bool is_passed;
+
+        if (std::strcmp(args.check, "edits") == 0) {
+            is_passed = check_incremental_lexing(corpus_path);
+        } else if (std::strcmp(args.check, "parse") == 0) {
+            is_passed = check_parsing(corpus_path);
+        } else if (std::strcmp(args.check, "layout") == 0) {
+            is_passed = check_layout(corpus_path);
+        } else if (std::strcmp(args.check, "lower") == 0) {
+            is_passed = check_lowering(args.dir);
+        } else {
+            is_passed = check_chunked_lexing(corpus_path, true);
+        }
+
+        std::filesystem::remove(corpus_path);
+        return !is_passed;
+    }
+
+    // Lexer
+    MjSourceFile *file = nullptr;
+
+    f64 lexer_seconds = measure([&] {
+        delete file;
+        file = MjLexer::parse_file(corpus_path);
+    });
+
+    if (file == nullptr) {
+        return 1;
+    }
+
+    report("tokens", {"lexer", corpus.size(), generator.token_count(), lexer_seconds});
+
+    // Chunk-parallel lexer, which must match the serial lexer exactly.
+    f64 chunked_lexer_seconds = measure([&] {
+        delete MjLexerPool::parse_file_chunks(corpus_path, args.threads, false);
+    });
+
+    if (!check_chunked_lexing(corpus_path, false)) {
+        return 1;
+    }
+
+    report("tokens", {"chunked_lexer", corpus.size(), generator.token_count(), chunked_lexer_seconds});
+
+    // String set, over the vocabulary of the generator with every identifier repeated.
+    std::vector<StringView> words;
+    u64 word_bytes = 0;
+
+    for (u32 i = 0; i < 64; ++i) {
+        for (const std::string &identifier : generator.identifiers()) {
+            words.push_back({reinterpret_cast<const u8 *>(identifier.data()), u32(identifier.size())});
+            word_bytes += identifier.size();
+        }
+    }
+
+    benchmark_string_set<MjStringSet>("string_set_insert", "string_set_search", words, word_bytes);
+    benchmark_string_set<MjLargeStringSet>("large_string_set_insert", "large_string_set_search", words, word_bytes);
+
+    // Formatter
+    u64 formatted_size = 0;
+
+    f64 formatter_seconds = measure([&] {
+        formatted_size = MjFormatter::format_file(*file, {}).size();
+    });
+
+    report("tokens", {"formatter", corpus.size(), generator.token_count(), formatter_seconds});
+
+    // Byte code interpreter, with threaded and switch dispatch. The items are loop iterations and
+    // calls.
+    static constexpr u32 FIBONACCI_ID = 0;
+    static constexpr i64 LOOP_COUNT = 10000000;
+    static constexpr i64 FIBONACCI_ARGUMENT = 27;
+    static constexpr u64 FIBONACCI_CALLS = 635621;
+    std::unordered_map<u32, u32> function_indices = {{FIBONACCI_ID, 1}};
+    std::vector<IrByteCodeFunction> functions(2);
+
+    if (
+        IrByteCodeCompiler(build_loop_function(), function_indices).compile(functions[0]) != Error::SUCCESS ||
+        IrByteCodeCompiler(build_fibonacci_function(FIBONACCI_ID), function_indices).compile(functions[1]) != Error::SUCCESS
+    ) {
+        return 1;
+    }
+
+    if (
+        !benchmark_interpreter("interpreter_loop", functions, 0, LOOP_COUNT, LOOP_COUNT) ||
+        !benchmark_interpreter("interpreter_calls", functions, 1, FIBONACCI_ARGUMENT, FIBONACCI_CALLS)
+    ) {
+        printf("Threaded dispatch differs from switch dispatch!\n");
+        return 1;
+    }
+
+    delete file;
+    std::filesystem::remove(corpus_path);
+    return formatted_size == 0;
+}
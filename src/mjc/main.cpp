@@ -1,9 +1,20 @@
 //#include <mj/MjCompiler.hpp>
+#include <mj/MjLayoutEngine.hpp>
 #include <mj/MjLexer.hpp>
-//#include <mj/MjParser.hpp>
+#include <mj/MjLexerPool.hpp>
+#include <mj/MjModuleGraph.hpp>
+#include <mj/MjSourceManager.hpp>
+#include <mj/MjTokenCache.hpp>
+#include <mj/MjTranspiler.hpp>
+#include <mj/MjParser.hpp>
+#include <mj/ast/MjFunction.hpp>
+#include <mj/ast/MjTypeName.hpp>
+#include <mj/ast/MjTokenView.hpp>
 
-#include <system/ProgramCommand.hpp>
-#include <system/Program.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <filesystem>
 
 
@@ -11,12 +22,15 @@ struct Args {
     std::filesystem::path build_dir;
     std::filesystem::path source_dir;
     std::filesystem::path output_file;
+    std::filesystem::path transpile_dir; // The directory of the C files of the modules, if any.
     std::vector<std::filesystem::path> include_dirs;
 
     StringView target_name;
     StringView arch_name;
     StringView cpu_name;
 
+    u32 jobs; // The number of lexer threads, or zero to lex only `Test.mj`.
+
     bool debug;
     bool asm_only;
     bool obj_only;
@@ -27,13 +41,183 @@ struct Args {
     bool quiet;
     bool verbose;
     bool dep;
+    bool pack; // Reorder the members of structure and class types to minimize padding.
 } args;
 
 
+/// Return true if the function is annotated `@api`, which exports it from its module.
+bool is_exported(const MjFunction &function, const MjSourceFile &file) noexcept {
+    for (const MjAnnotation *annotation : function.annotations()) {
+        if (file.text_of(*annotation->name()).is_equal("api")) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/// Write each parsed module as a C file in `args.transpile_dir`, named after its source file.
+Error transpile_modules(const std::vector<MjSourceFile *> &files, const std::vector<MjModule *> &modules) noexcept {
+    MjProgram program;
+    MjTranspiler transpiler(program);
+    std::error_code error_code;
+
+    if (!std::filesystem::create_directories(args.transpile_dir, error_code) && error_code) {
+        printf("Failed to create directory! '%s'\n", args.transpile_dir.c_str());
+        return Error::FAILURE;
+    }
+
+    for (u32 i = 0; i < modules.size(); ++i) {
+        const MjSourceFile &file = *files[i];
+        std::string name = file.path().stem().string();
+        u32 unit = transpiler.add_translation_unit(StringView(reinterpret_cast<const u8 *>(name.data()), name.size()));
+        MjTokenView tokens(file);
+
+        // The types of members must be declared before the types containing them.
+        for (const MjType *type : modules[i]->types()) {
+            if (transpiler.add_type(unit, *type, type->name()->text(), file).is_failure()) {
+                return Error::FAILURE;
+            }
+        }
+
+        for (const MjFunction *function : modules[i]->functions()) {
+            if (transpiler.add_function(unit, *function, function->parameters(), file, tokens, is_exported(*function, file)).is_failure()) {
+                return Error::FAILURE;
+            }
+        }
+    }
+
+    return transpiler.transpile(args.transpile_dir);
+}
+
+
+/// Parse the source files and lay out their types. With `--pack`, the members of structures and
+/// classes are reordered and the bytes saved by each reordered type are reported. With
+/// `--transpile`, the modules are then written as C files.
+Error compile_modules(const std::vector<MjSourceFile *> &files) noexcept {
+    MjItemManager item_manager;
+    std::vector<MjModule *> modules;
+    Error error = Error::SUCCESS;
+
+    for (u32 i = 0; i < files.size(); ++i) {
+        MjModule *module = files[i] != nullptr ? MjParser::parse(item_manager, i, *files[i]) : nullptr;
+
+        if (module == nullptr) {
+            error = Error::FAILURE;
+            continue;
+        }
+
+        modules.push_back(module);
+    }
+
+    MjLayoutEngine layout_engine(item_manager.source_manager());
+    layout_engine.set_reorder_members(args.pack);
+
+    for (MjModule *module : modules) {
+        for (MjType *type : module->types()) {
+            if (layout_engine.layout(type) != Error::SUCCESS) {
+                error = Error::FAILURE;
+            }
+        }
+    }
+
+    if (args.pack) {
+        layout_engine.print_savings();
+    }
+
+    if (!args.transpile_dir.empty() && error == Error::SUCCESS) {
+        return transpile_modules(files, modules);
+    }
+
+    return error;
+}
+
+
+/// Lex every source file in the module tree on `args.jobs` threads, then intern the strings of the
+/// modules in dependency order. The time spent lexing each file is added to its module, so that
+/// `--dep` reports the critical path of both.
+Error lex_module_tree() noexcept {
+    MjModuleGraph graph;
+
+    if (graph.load(args.source_dir).is_failure()) {
+        return Error::FAILURE;
+    }
+
+    // Source IDs follow the module order, independent of the directory order and of the schedule.
+    std::vector<std::filesystem::path> file_paths = graph.file_paths();
+    MjSourceManager source_manager;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<MjSourceFile *> files;
+    std::vector<u64> lex_durations;
+
+    // Unchanged files are decoded from the token cache in the build directory.
+    if (!args.build_dir.empty()) {
+        MjTokenCache cache(args.build_dir / "tokens");
+        files = MjLexerPool::parse_files(file_paths, args.jobs, &cache, nullptr, false, &lex_durations);
+    } else {
+        files = MjLexerPool::parse_files(file_paths, args.jobs, nullptr, nullptr, false, &lex_durations);
+    }
+
+    if (graph.resolve(files).is_failure()) {
+        return Error::FAILURE;
+    }
+
+    graph.run(args.jobs, [&](MjModuleGraph::Module &module) {
+        for (MjSourceFile *file : module.files) {
+            if (file != nullptr) {
+                file->intern(source_manager.strings());
+            }
+        }
+    });
+
+    // The critical path covers lexing as well as interning.
+    graph.add_file_durations(lex_durations);
+
+    auto end = std::chrono::steady_clock::now();
+    Error error = Error::SUCCESS;
+    u64 byte_count = 0;
+    u64 token_count = 0;
+
+    for (const MjSourceFile *file : files) {
+        if (file == nullptr) {
+            error = Error::FAILURE;
+            continue;
+        }
+
+        source_manager.add_source_file(file);
+        byte_count += file->size();
+        token_count += file->tokens().size();
+    }
+
+    if (!args.quiet) {
+        printf(
+            "Lexed %u files (%lu bytes, %lu token bytes, %u strings) on %u threads in %.3f ms\n",
+            source_manager.sources().size(),
+            byte_count,
+            token_count,
+            source_manager.strings().size(),
+            args.jobs,
+            std::chrono::duration<double, std::milli>(end - start).count()
+        );
+    }
+
+    if (args.dep) {
+        graph.print();
+    }
+
+    if ((args.pack || !args.transpile_dir.empty()) && compile_modules(files).is_failure()) {
+        return Error::FAILURE;
+    }
+
+    return error;
+}
+
+
 Error compile() noexcept {
 
     if (!std::filesystem::is_directory(args.source_dir)) {
-        printf("Invalid source file path: {}\n", args.source_dir);
+        printf("Invalid source file path: '%s'\n", args.source_dir.c_str());
         return Error::FAILURE;
     }
 
@@ -45,14 +229,28 @@ Error compile() noexcept {
 
     //std::filesystem::create_directories(args.build_dir);
 
+    if (args.jobs != 0) {
+        return lex_module_tree();
+    }
+
     //MjParser parser(src);
     //MjProgram program = parser.parse();
 
     MjSourceFile *file = MjLexer::parse_file(args.source_dir / "Test.mj");
 
-    for (auto token : file->tokens()) {
-        StringView text = file->token_text(token);
-        Program::STDOUT.print("{}\n", text);
+    if (file == nullptr) {
+        return Error::FAILURE;
+    }
+
+    if (args.pack || !args.transpile_dir.empty()) {
+        return compile_modules({file});
+    }
+
+    MjTokenView tokens(*file);
+
+    for (u32 i = 0; i < tokens.size(); ++i) {
+        StringView text = file->text_of(tokens.token(i));
+        printf("%.*s\n", text.size(), text.data());
     }
 
     return Error::SUCCESS;
@@ -77,6 +275,8 @@ const ProgramOption compile_opts[] {
     ProgramOption('q', "quiet",       &args.quiet),
     ProgramOption('v', "verbose",     &args.verbose),
     ProgramOption(     "dep",         &args.dep),
+    ProgramOption(     "pack",        &args.pack),
+    ProgramOption(     "transpile",   &args.transpile_dir),
 };
 
 
@@ -110,10 +310,13 @@ const ProgramCommand program_cmd{
     "      --arch=NAME      The target architecture name\n"
     "      --cpu=NAME       The target cpu name\n"
     "  -O LEVEL             The optimization level (0, 1, 2, size)\n"
+    "  -j N                 Lex the source files on N threads\n"
     "  -g, --debug          Build in debug mode\n"
     "  -c, --asm-only       Compile only. Do not assemble or link\n"
     "  -S, --obj-only       Compile and assemble. Do not link\n"
     "  -m, --shared         Compile as a shared module\n"
+    "      --pack           Reorder structure members to minimize padding and report the bytes saved\n"
+    "      --transpile=DIR  Write each module as a C file in DIR\n"
     "\n"
     "Output Options:\n"
     "      --color          Output color in console mode\n"
@@ -123,7 +326,7 @@ const ProgramCommand program_cmd{
     "  -v, --verbose        Build in verbose mode\n"
     "\n"
     "Miscellaneous:\n"
-    "      --dep            Display the module dependency tree and exit\n"
+    "      --dep            Display the module dependency graph and its critical path\n"
     "      --help           Display this message and exit\n"
     "      --version        Display the application name and version and exit\n"
     "\n"
@@ -144,6 +347,23 @@ int main(int argc, const char *argv[]) {
     return program_cmd.parse_and_run({args.data(), args.size()});
     */
 
-    args.source_dir = argv[1];
-    return compile();
+    for (i32 i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            args.build_dir = argv[++i];
+        } else if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            args.jobs = std::max(std::atoi(argv[++i]), 1);
+        } else if (std::strncmp(argv[i], "-j", 2) == 0) {
+            args.jobs = std::max(std::atoi(argv[i] + 2), 1);
+        } else if (std::strcmp(argv[i], "--dep") == 0) {
+            args.dep = true;
+        } else if (std::strcmp(argv[i], "--pack") == 0) {
+            args.pack = true;
+        } else if (std::strcmp(argv[i], "--transpile") == 0 && i + 1 < argc) {
+            args.transpile_dir = argv[++i];
+        } else {
+            args.source_dir = argv[i];
+        }
+    }
+
+    return compile().is_failure();
 }
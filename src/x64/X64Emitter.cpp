@@ -0,0 +1,437 @@
+#include <x64/X64Emitter.hpp>
+
+#include <cstdio>
+
+
+/// The condition of each comparison opcode, from `IrOpcode::EQ`.
+static constexpr X64Condition CONDITIONS[] = {X64Condition::E, X64Condition::NE, X64Condition::L, X64Condition::LE, X64Condition::G, X64Condition::GE};
+
+
+/// The operation of each arithmetic opcode with an `add` encoding, from `IrOpcode::ADD` to
+/// `IrOpcode::SHR`, or `0xFF`.
+static constexpr u8 ALU_OPERATIONS[] = {X64AluOperation::ADD, X64AluOperation::SUB, 0xFF, 0xFF, 0xFF, X64AluOperation::AND, X64AluOperation::OR, X64AluOperation::XOR, 0xFF, 0xFF};
+
+
+Error X64Emitter::emit() noexcept {
+    Slice<const IrBasicBlock> blocks = _function.blocks();
+
+    if (_function.parameter_count() > std::size(ARGUMENT_REGISTERS)) {
+        error("Too many parameters");
+        return _error;
+    }
+
+    count_uses();
+    _allocator.allocate();
+
+    for (u32 i = 0; i < std::size(CALLEE_SAVED_REGISTERS); ++i) {
+        if (_allocator.used_registers() >> (std::size(CALLER_SAVED_REGISTERS) + i) & 1) {
+            _saved_registers.push_back(CALLEE_SAVED_REGISTERS[i]);
+        }
+    }
+
+    // The frame is a multiple of 16 bytes, keeping the stack aligned for calls.
+    u32 frame_size = (_saved_registers.size() + _allocator.stack_slot_count()) * 8;
+    frame_size = (frame_size + 15) & ~15u;
+    _encoder.push(X64Register::RBP);
+    _encoder.mov(X64Operand(X64Register::RBP), X64Register::RSP);
+
+    if (frame_size != 0) {
+        _encoder.alu(X64AluOperation::SUB, X64Operand(X64Register::RSP), frame_size);
+    }
+
+    for (u32 i = 0; i < _saved_registers.size(); ++i) {
+        _encoder.mov(X64Operand(X64Register::RBP, -8 * i32(i + 1)), _saved_registers[i]);
+    }
+
+    std::vector<Move> parameter_moves;
+
+    for (u32 value = blocks[0].first_instruction; value < blocks[0].end_instruction(); ++value) {
+        const IrInstruction &instruction = _function.instruction(value);
+
+        if (instruction.opcode == IrOpcode::PARAMETER && !_allocator.location(value).is_none()) {
+            parameter_moves.push_back({operand(value), X64Operand(ARGUMENT_REGISTERS[instruction.a])});
+        }
+    }
+
+    emit_parallel_moves(parameter_moves);
+
+    // Lay out the reachable blocks in order, then the edge blocks.
+    _labels.assign(blocks.size(), NONE);
+
+    for (u32 block = 0; block != NONE; block = _next_block) {
+        _next_block = block + 1;
+
+        while (_next_block < blocks.size() && blocks[_next_block].predecessor_count == 0) {
+            _next_block += 1;
+        }
+
+        if (_next_block == blocks.size()) {
+            _next_block = NONE;
+        }
+
+        _labels[block] = _encoder.size();
+        emit_block(block);
+    }
+
+    for (u32 i = 0; i < _edges.size(); ++i) {
+        Edge edge = _edges[i];
+        _labels.push_back(_encoder.size());
+        emit_edge_moves(edge.block, edge.successor);
+        emit_jump(blocks[edge.block].successors[edge.successor]);
+    }
+
+    for (Fixup fixup : _fixups) {
+        _encoder.patch(fixup.displacement_offset, _labels[fixup.label]);
+    }
+
+    return _error;
+}
+
+
+void X64Emitter::count_uses() noexcept {
+    Slice<const IrInstruction> instructions = _function.instructions();
+    _use_counts.assign(instructions.size(), 0);
+
+    for (const IrInstruction &instruction : instructions) {
+        if (instruction.opcode.has_value_a() && instruction.a != IrInstruction::NONE) {
+            _use_counts[instruction.a] += 1;
+        }
+
+        if (instruction.opcode.has_value_b()) {
+            _use_counts[instruction.b] += 1;
+        }
+
+        if (instruction.opcode.has_operand_array()) {
+            for (u32 operand : _function.operands(instruction)) {
+                _use_counts[operand] += 1;
+            }
+        }
+    }
+
+    // Constants used as immediates are only loaded if they have other uses.
+    for (const IrInstruction &instruction : instructions) {
+        bool has_immediate_form = instruction.opcode.is_comparison() || (instruction.opcode.is_binary() && ALU_OPERATIONS[instruction.opcode - IrOpcode::ADD] != 0xFF);
+
+        if (has_immediate_form && is_immediate(instruction.b)) {
+            _use_counts[instruction.b] -= 1;
+        }
+    }
+}
+
+
+bool X64Emitter::is_immediate(u32 value) const noexcept {
+    const IrInstruction &instruction = _function.instruction(value);
+    return instruction.opcode == IrOpcode::CONSTANT && instruction.immediate() >= -0x80000000ll && instruction.immediate() <= 0x7FFFFFFFll;
+}
+
+
+bool X64Emitter::is_fused_comparison(u32 value) const noexcept {
+    Slice<const IrInstruction> instructions = _function.instructions();
+
+    // Terminators end the block of the instruction before them, so the branch is in the same block.
+    return instructions[value].opcode.is_comparison() &&
+        _use_counts[value] == 1 &&
+        value + 1 < instructions.size() &&
+        instructions[value + 1].opcode == IrOpcode::BRANCH &&
+        instructions[value + 1].a == value;
+}
+
+
+X64Operand X64Emitter::operand(u32 value) const noexcept {
+    const IrLocation &location = _allocator.location(value);
+
+    if (location.is_stack) {
+        return X64Operand(X64Register::RBP, -8 * i32(_saved_registers.size() + location.index + 1));
+    }
+
+    if (location.index < std::size(CALLER_SAVED_REGISTERS)) {
+        return X64Operand(CALLER_SAVED_REGISTERS[location.index]);
+    }
+
+    return X64Operand(CALLEE_SAVED_REGISTERS[location.index - std::size(CALLER_SAVED_REGISTERS)]);
+}
+
+
+void X64Emitter::emit_block(u32 block) noexcept {
+    const IrBasicBlock &basic_block = _function.block(block);
+
+    for (u32 value = basic_block.first_instruction + basic_block.phi_count; value < basic_block.terminator(); ++value) {
+        emit_instruction(value);
+    }
+
+    emit_terminator(block);
+}
+
+
+void X64Emitter::emit_instruction(u32 value) noexcept {
+    const IrInstruction &instruction = _function.instruction(value);
+    IrOpcode opcode = instruction.opcode;
+
+    if (opcode == IrOpcode::PARAMETER || opcode == IrOpcode::UNDEFINED || (_use_counts[value] == 0 && opcode != IrOpcode::CALL) || is_fused_comparison(value)) {
+        return;
+    }
+
+    X64Operand destination = operand(value);
+
+    // Compute into the destination if it is a register the second operand is not in, else into `rax`.
+    bool is_rhs_in_destination = opcode.has_value_b() && !is_immediate(instruction.b) && operand(instruction.b) == destination;
+    X64Register target = !destination.is_memory && !is_rhs_in_destination ? destination.base : X64Register::RAX;
+
+    if (opcode == IrOpcode::CONSTANT) {
+        i64 immediate = instruction.immediate();
+
+        if (!destination.is_memory) {
+            _encoder.mov_immediate(destination.base, immediate);
+        } else if (is_immediate(value)) {
+            _encoder.mov_sign_extended(destination, immediate);
+        } else {
+            _encoder.mov_immediate(X64Register::R11, immediate);
+            _encoder.mov(destination, X64Register::R11);
+        }
+
+        return;
+    } else if (opcode == IrOpcode::NEG || opcode == IrOpcode::NOT) {
+        emit_move(X64Operand(target), operand(instruction.a));
+        opcode == IrOpcode::NEG ? _encoder.neg(X64Operand(target)) : _encoder.not_(X64Operand(target));
+    } else if (opcode.is_binary() && !opcode.is_comparison() && ALU_OPERATIONS[opcode - IrOpcode::ADD] != 0xFF) {
+        X64AluOperation operation(ALU_OPERATIONS[opcode - IrOpcode::ADD]);
+        emit_move(X64Operand(target), operand(instruction.a));
+
+        if (is_immediate(instruction.b)) {
+            _encoder.alu(operation, X64Operand(target), _function.instruction(instruction.b).immediate());
+        } else {
+            _encoder.alu(operation, target, operand(instruction.b));
+        }
+    } else if (opcode == IrOpcode::MUL) {
+        emit_move(X64Operand(target), operand(instruction.a));
+        _encoder.imul(target, operand(instruction.b));
+    } else if (opcode == IrOpcode::DIV || opcode == IrOpcode::REM) {
+        emit_move(X64Operand(X64Register::RAX), operand(instruction.a));
+        _encoder.cqo();
+        _encoder.idiv(operand(instruction.b));
+        target = opcode == IrOpcode::DIV ? X64Register::RAX : X64Register::RDX;
+    } else if (opcode == IrOpcode::SHL || opcode == IrOpcode::SHR) {
+        emit_move(X64Operand(X64Register::RCX), operand(instruction.b));
+        target = !destination.is_memory ? destination.base : X64Register::RAX;
+        emit_move(X64Operand(target), operand(instruction.a));
+        opcode == IrOpcode::SHL ? _encoder.shl(X64Operand(target)) : _encoder.sar(X64Operand(target));
+    } else if (opcode.is_comparison()) {
+        emit_comparison(instruction.a, instruction.b);
+        _encoder.set(CONDITIONS[opcode - IrOpcode::EQ]);
+        target = X64Register::RAX;
+    } else if (opcode == IrOpcode::CALL) {
+        Slice<const u32> arguments = _function.operands(instruction);
+        auto it = _symbols.find(instruction.a);
+
+        if (it == _symbols.end()) {
+            error("Unknown function");
+            return;
+        }
+
+        if (arguments.size() > std::size(ARGUMENT_REGISTERS)) {
+            error("Too many arguments");
+            return;
+        }
+
+        std::vector<Move> moves;
+
+        for (u32 i = 0; i < arguments.size(); ++i) {
+            moves.push_back({X64Operand(ARGUMENT_REGISTERS[i]), operand(arguments[i])});
+        }
+
+        emit_parallel_moves(moves);
+        _encoder.call(it->second);
+
+        if (_allocator.location(value).is_none()) {
+            return;
+        }
+
+        target = X64Register::RAX;
+    } else {
+        error("Unsupported instruction");
+        return;
+    }
+
+    emit_move(destination, X64Operand(target));
+}
+
+
+void X64Emitter::emit_terminator(u32 block) noexcept {
+    const IrBasicBlock &basic_block = _function.block(block);
+    const IrInstruction &terminator = _function.instruction(basic_block.terminator());
+
+    if (terminator.opcode == IrOpcode::JUMP) {
+        emit_edge_moves(block, 0);
+
+        if (basic_block.successors[0] != _next_block) {
+            emit_jump(basic_block.successors[0]);
+        }
+    } else if (terminator.opcode == IrOpcode::BRANCH) {
+        u32 true_label = edge_label(block, 0);
+        u32 false_label = edge_label(block, 1);
+        X64Condition condition = X64Condition::NE;
+
+        if (is_fused_comparison(terminator.a)) {
+            const IrInstruction &comparison = _function.instruction(terminator.a);
+            emit_comparison(comparison.a, comparison.b);
+            condition = CONDITIONS[comparison.opcode - IrOpcode::EQ];
+        } else {
+            _encoder.alu(X64AluOperation::CMP, operand(terminator.a), 0);
+        }
+
+        if (true_label == _next_block) {
+            emit_jump(condition.inverse(), false_label);
+        } else {
+            emit_jump(condition, true_label);
+
+            if (false_label != _next_block) {
+                emit_jump(false_label);
+            }
+        }
+    } else if (terminator.opcode == IrOpcode::RETURN) {
+        if (terminator.a != IrInstruction::NONE) {
+            emit_move(X64Operand(X64Register::RAX), operand(terminator.a));
+        }
+
+        for (u32 i = 0; i < _saved_registers.size(); ++i) {
+            _encoder.mov(_saved_registers[i], X64Operand(X64Register::RBP, -8 * i32(i + 1)));
+        }
+
+        _encoder.mov(X64Operand(X64Register::RSP), X64Register::RBP);
+        _encoder.pop(X64Register::RBP);
+        _encoder.ret();
+    } else {
+        _encoder.ud2();
+    }
+}
+
+
+void X64Emitter::emit_comparison(u32 lhs, u32 rhs) noexcept {
+    X64Operand left = operand(lhs);
+
+    if (is_immediate(rhs)) {
+        _encoder.alu(X64AluOperation::CMP, left, _function.instruction(rhs).immediate());
+        return;
+    }
+
+    if (left.is_memory) {
+        emit_move(X64Operand(X64Register::RAX), left);
+        left = X64Operand(X64Register::RAX);
+    }
+
+    _encoder.alu(X64AluOperation::CMP, left.base, operand(rhs));
+}
+
+
+void X64Emitter::emit_edge_moves(u32 block, u32 successor) noexcept {
+    const IrBasicBlock &basic_block = _function.block(block);
+    const IrBasicBlock &target = _function.block(basic_block.successors[successor]);
+    Slice<const u32> predecessors = _function.predecessors(target);
+    u32 predecessor = 0;
+
+    // A branch with both successors in the same block is two predecessors of the block, in order.
+    u32 skipped_count = successor == 1 && basic_block.successors[0] == basic_block.successors[1];
+
+    for (;; ++predecessor) {
+        if (predecessors[predecessor] == block) {
+            if (skipped_count == 0) {
+                break;
+            }
+
+            skipped_count -= 1;
+        }
+    }
+
+    std::vector<Move> moves;
+
+    for (u32 phi = target.first_instruction; phi < target.first_instruction + target.phi_count; ++phi) {
+        u32 source = _function.operands(_function.instruction(phi))[predecessor];
+
+        if (!_allocator.location(phi).is_none() && _function.instruction(source).opcode != IrOpcode::UNDEFINED) {
+            moves.push_back({operand(phi), operand(source)});
+        }
+    }
+
+    emit_parallel_moves(moves);
+}
+
+
+u32 X64Emitter::edge_label(u32 block, u32 successor) noexcept {
+    u32 target = _function.block(block).successors[successor];
+
+    if (_function.block(target).phi_count == 0) {
+        return target;
+    }
+
+    _edges.push_back({block, successor});
+    return _function.blocks().size() + _edges.size() - 1;
+}
+
+
+void X64Emitter::emit_jump(u32 label) noexcept {
+    _fixups.push_back({_encoder.jmp(), label});
+}
+
+
+void X64Emitter::emit_jump(X64Condition condition, u32 label) noexcept {
+    _fixups.push_back({_encoder.jcc(condition), label});
+}
+
+
+void X64Emitter::emit_move(X64Operand destination, X64Operand source) noexcept {
+    if (destination == source) {
+        return;
+    }
+
+    if (!destination.is_memory) {
+        _encoder.mov(destination.base, source);
+    } else if (!source.is_memory) {
+        _encoder.mov(destination, source.base);
+    } else {
+        _encoder.mov(X64Register::R11, source);
+        _encoder.mov(destination, X64Register::R11);
+    }
+}
+
+
+void X64Emitter::emit_parallel_moves(std::vector<Move> &moves) noexcept {
+    std::erase_if(moves, [](const Move &move) { return move.first == move.second; });
+
+    while (!moves.empty()) {
+        bool is_moved = false;
+
+        // Perform a move whose destination is not the source of another move.
+        for (u32 i = 0; i < moves.size() && !is_moved; ++i) {
+            bool is_blocked = false;
+
+            for (u32 j = 0; j < moves.size(); ++j) {
+                is_blocked |= j != i && moves[j].second == moves[i].first;
+            }
+
+            if (!is_blocked) {
+                emit_move(moves[i].first, moves[i].second);
+                moves.erase(moves.begin() + i);
+                is_moved = true;
+            }
+        }
+
+        // Every destination is the source of another move, so the moves form cycles. Saving one
+        // destination in `rax` breaks its cycle.
+        if (!is_moved) {
+            X64Operand saved = moves[0].first;
+            emit_move(X64Operand(X64Register::RAX), saved);
+
+            for (Move &move : moves) {
+                if (move.second == saved) {
+                    move.second = X64Operand(X64Register::RAX);
+                }
+            }
+        }
+    }
+}
+
+
+void X64Emitter::error(const char *message) noexcept {
+    printf("Failed to emit x86-64 code! %s\n", message);
+    _error = Error::FAILURE;
+}
@@ -0,0 +1,225 @@
+#include <x64/X64Encoder.hpp>
+
+
+/// The encodings of an arithmetic operation: the opcodes of the `r/m, reg` and `reg, r/m` forms,
+/// and the ModRM extension of the immediate forms.
+struct X64AluEncoding {
+    u8 rm_reg_opcode;
+    u8 reg_rm_opcode;
+    u8 extension;
+};
+
+
+static constexpr X64AluEncoding ALU_ENCODINGS[] = {
+    {0x01, 0x03, 0}, // add
+    {0x09, 0x0B, 1}, // or
+    {0x21, 0x23, 4}, // and
+    {0x29, 0x2B, 5}, // sub
+    {0x31, 0x33, 6}, // xor
+    {0x39, 0x3B, 7}, // cmp
+};
+
+
+static constexpr bool is_i8(i64 value) noexcept {
+    return value >= -0x80 && value <= 0x7F;
+}
+
+
+static constexpr bool is_i32(i64 value) noexcept {
+    return value >= -0x80000000ll && value <= 0x7FFFFFFFll;
+}
+
+
+void X64Encoder::mov(X64Register destination, X64Operand source) noexcept {
+    emit_rm({0x8B}, destination, source);
+}
+
+
+void X64Encoder::mov(X64Operand destination, X64Register source) noexcept {
+    emit_rm({0x89}, source, destination);
+}
+
+
+void X64Encoder::mov_immediate(X64Register destination, i64 immediate) noexcept {
+
+    // Writing the low 32 bits of a register clears the high bits.
+    if (immediate >= 0 && immediate <= 0xFFFFFFFFll) {
+        if (destination.is_extended()) {
+            _code.push_back(0x41);
+        }
+
+        _code.push_back(0xB8 + destination.low_bits());
+        emit32(immediate);
+    } else if (is_i32(immediate)) {
+        mov_sign_extended(destination, i32(immediate));
+    } else {
+        _code.push_back(0x48 | destination.is_extended());
+        _code.push_back(0xB8 + destination.low_bits());
+        emit32(u64(immediate));
+        emit32(u64(immediate) >> 32);
+    }
+}
+
+
+void X64Encoder::mov_sign_extended(X64Operand destination, i32 immediate) noexcept {
+    emit_rm({0xC7}, 0, destination);
+    emit32(immediate);
+}
+
+
+void X64Encoder::alu(X64AluOperation operation, X64Register destination, X64Operand source) noexcept {
+    emit_rm({ALU_ENCODINGS[operation].reg_rm_opcode}, destination, source);
+}
+
+
+void X64Encoder::alu(X64AluOperation operation, X64Operand destination, i32 immediate) noexcept {
+    if (is_i8(immediate)) {
+        emit_rm({0x83}, ALU_ENCODINGS[operation].extension, destination);
+        _code.push_back(immediate);
+    } else {
+        emit_rm({0x81}, ALU_ENCODINGS[operation].extension, destination);
+        emit32(immediate);
+    }
+}
+
+
+void X64Encoder::imul(X64Register destination, X64Operand source) noexcept {
+    emit_rm({0x0F, 0xAF}, destination, source);
+}
+
+
+void X64Encoder::idiv(X64Operand source) noexcept {
+    emit_rm({0xF7}, 7, source);
+}
+
+
+void X64Encoder::neg(X64Operand operand) noexcept {
+    emit_rm({0xF7}, 3, operand);
+}
+
+
+void X64Encoder::not_(X64Operand operand) noexcept {
+    emit_rm({0xF7}, 2, operand);
+}
+
+
+void X64Encoder::shl(X64Operand operand) noexcept {
+    emit_rm({0xD3}, 4, operand);
+}
+
+
+void X64Encoder::sar(X64Operand operand) noexcept {
+    emit_rm({0xD3}, 7, operand);
+}
+
+
+void X64Encoder::cqo() noexcept {
+    _code.push_back(0x48);
+    _code.push_back(0x99);
+}
+
+
+void X64Encoder::set(X64Condition condition) noexcept {
+
+    // `setcc al` then `movzx eax, al`
+    emit_rm({0x0F, u8(0x90 + condition)}, 0, X64Register::RAX, false);
+    emit_rm({0x0F, 0xB6}, 0, X64Register::RAX, false);
+}
+
+
+void X64Encoder::push(X64Register operand) noexcept {
+    if (operand.is_extended()) {
+        _code.push_back(0x41);
+    }
+
+    _code.push_back(0x50 + operand.low_bits());
+}
+
+
+void X64Encoder::pop(X64Register operand) noexcept {
+    if (operand.is_extended()) {
+        _code.push_back(0x41);
+    }
+
+    _code.push_back(0x58 + operand.low_bits());
+}
+
+
+u32 X64Encoder::jmp() noexcept {
+    _code.push_back(0xE9);
+    emit32(0);
+    return _code.size() - 4;
+}
+
+
+u32 X64Encoder::jcc(X64Condition condition) noexcept {
+    _code.push_back(0x0F);
+    _code.push_back(0x80 + condition);
+    emit32(0);
+    return _code.size() - 4;
+}
+
+
+void X64Encoder::call(u32 symbol) noexcept {
+    _code.push_back(0xE8);
+    _relocations.push_back({u32(_code.size()), symbol, -4});
+    emit32(0);
+}
+
+
+void X64Encoder::ret() noexcept {
+    _code.push_back(0xC3);
+}
+
+
+void X64Encoder::ud2() noexcept {
+    _code.push_back(0x0F);
+    _code.push_back(0x0B);
+}
+
+
+void X64Encoder::patch(u32 displacement_offset, u32 target) noexcept {
+    u32 displacement = target - (displacement_offset + 4);
+
+    for (u32 i = 0; i < 4; ++i) {
+        _code[displacement_offset + i] = displacement >> 8 * i;
+    }
+}
+
+
+void X64Encoder::emit_rm(std::initializer_list<u8> opcode, u8 reg, X64Operand operand, bool is_wide) noexcept {
+    u8 rex = 0x40 | is_wide << 3 | (reg >= 8) << 2 | operand.base.is_extended();
+
+    if (rex != 0x40) {
+        _code.push_back(rex);
+    }
+
+    _code.insert(_code.end(), opcode.begin(), opcode.end());
+
+    if (!operand.is_memory) {
+        _code.push_back(0xC0 | (reg & 7) << 3 | operand.base.low_bits());
+        return;
+    }
+
+    // A base of `rbp` or `r13` without a displacement encodes a RIP relative operand, and a base of
+    // `rsp` or `r12` needs a SIB byte.
+    u8 mode = operand.displacement == 0 && operand.base.low_bits() != 5 ? 0 : is_i8(operand.displacement) ? 1 : 2;
+    _code.push_back(mode << 6 | (reg & 7) << 3 | operand.base.low_bits());
+
+    if (operand.base.low_bits() == 4) {
+        _code.push_back(0x24);
+    }
+
+    if (mode == 1) {
+        _code.push_back(operand.displacement);
+    } else if (mode == 2) {
+        emit32(operand.displacement);
+    }
+}
+
+
+void X64Encoder::emit32(u32 value) noexcept {
+    for (u32 i = 0; i < 4; ++i) {
+        _code.push_back(value >> 8 * i);
+    }
+}
@@ -0,0 +1,79 @@
+#include "Test.c"
+
+#include <stdio.h>
+#include <string.h>
+
+
+// Runs the functions transpiled from `Test.mj`, which is included so that its `static inline`
+// functions and its structures are visible, and checks where the C file uses `restrict`.
+
+
+static int failures = 0;
+
+
+static void check(const char *name, long value, long expected) {
+    if (value != expected) {
+        printf("%s returned %ld, expected %ld\n", name, value, expected);
+        failures += 1;
+    }
+}
+
+
+/// Only the pointer parameters of `scale`, which is annotated `@restrict`, may be `restrict`.
+static void check_restrict(const char *path) {
+    FILE *file = fopen(path, "r");
+    char line[256];
+    int restrict_count = 0;
+
+    if (file == NULL) {
+        printf("Failed to open file! '%s'\n", path);
+        failures += 1;
+        return;
+    }
+
+    while (fgets(line, sizeof(line), file)) {
+        if (strstr(line, "restrict") == NULL) {
+            continue;
+        }
+
+        if (strstr(line, " scale(") == NULL) {
+            printf("Unexpected 'restrict': %s", line);
+            failures += 1;
+        }
+
+        restrict_count += 1;
+    }
+
+    fclose(file);
+    check("the number of lines with 'restrict'", restrict_count, 2);
+}
+
+
+int main(int argc, const char *argv[]) {
+    if (argc != 2) {
+        printf("Usage: transpile_check FILE\n");
+        return 1;
+    }
+
+    check("offsetof(Header, offset)", offsetof(Header, offset), 8);
+    check("offsetof(Header, size)", offsetof(Header, size), 20);
+    check("offsetof(Record, count)", offsetof(Record, count), 8);
+    check("header_end", header_end((Header){.offset = 100, .size = 20}), 120);
+
+    int64_t input[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    int64_t output[8] = {0};
+    scale(output, input, 8, 3);
+    check("scale", output[0] + output[7], 27);
+
+    // Overlapping pointers are valid arguments of functions which are not annotated `@restrict`.
+    shift_down(input, input + 1, 7);
+    check("shift_down", input[0] * 100 + input[6] * 10 + input[7], 288);
+
+    check("fib(20)", fib(20), 6765);
+    check("fib_sum(10)", fib_sum(10), 143);
+    check("gcd(1071, 462)", gcd(1071, 462), 21);
+    check("bits(0x5A)", bits(0x5A), 0x5905);
+
+    check_restrict(argv[1]);
+    return failures != 0;
+}
@@ -0,0 +1,164 @@
+#include <ir/IrBuilder.hpp>
+#include <mj/MjAssembler.hpp>
+
+#include <cstdio>
+#include <cstring>
+
+
+// Writes an x86-64 object with the functions checked by `main.c`, which is linked with it.
+//
+// The functions cover loops with phi edges, recursive calls, calls to a function defined by the
+// driver, every argument register, and more live values than there are registers.
+
+
+enum FunctionId : u32 {
+    LOOP_SUM,
+    FIB,
+    SWAP,
+    SIX,
+    SPILL,
+    EXT3, // Defined by the driver
+};
+
+
+/// `loop_sum(n)` sums `i * i % 7` for `i` from 0 to `n`.
+IrFunction build_loop_sum() noexcept {
+    static constexpr u32 N = 0;
+    static constexpr u32 I = 1;
+    static constexpr u32 SUM = 2;
+    IrBuilder builder;
+    u32 header_block = builder.create_block();
+    u32 body_block = builder.create_block();
+    u32 exit_block = builder.create_block();
+
+    builder.write_variable(N, builder.parameter());
+    builder.write_variable(I, builder.constant(0));
+    builder.write_variable(SUM, builder.constant(0));
+    builder.jump(header_block);
+    builder.set_block(header_block);
+    builder.branch(builder.binary(IrOpcode::LT, builder.read_variable(I), builder.read_variable(N)), body_block, exit_block);
+    builder.seal_block(body_block);
+    builder.set_block(body_block);
+    u32 square = builder.binary(IrOpcode::MUL, builder.read_variable(I), builder.read_variable(I));
+    builder.write_variable(SUM, builder.binary(IrOpcode::ADD, builder.read_variable(SUM), builder.binary(IrOpcode::REM, square, builder.constant(7))));
+    builder.write_variable(I, builder.binary(IrOpcode::ADD, builder.read_variable(I), builder.constant(1)));
+    builder.jump(header_block);
+    builder.seal_block(header_block);
+    builder.seal_block(exit_block);
+    builder.set_block(exit_block);
+    builder.return_value(builder.read_variable(SUM));
+    return builder.finish();
+}
+
+
+/// `fib(n)` is the naive recursive Fibonacci function.
+IrFunction build_fib() noexcept {
+    IrBuilder builder;
+    u32 n = builder.parameter();
+    u32 base_block = builder.create_block();
+    u32 recursive_block = builder.create_block();
+
+    builder.branch(builder.binary(IrOpcode::LT, n, builder.constant(2)), base_block, recursive_block);
+    builder.seal_block(base_block);
+    builder.seal_block(recursive_block);
+    builder.set_block(base_block);
+    builder.return_value(n);
+    builder.set_block(recursive_block);
+    u32 a = builder.call(FIB, {builder.binary(IrOpcode::SUB, n, builder.constant(1))});
+    u32 b = builder.call(FIB, {builder.binary(IrOpcode::SUB, n, builder.constant(2))});
+    builder.return_value(builder.binary(IrOpcode::ADD, a, b));
+    return builder.finish();
+}
+
+
+/// `swap(k)` swaps `a = 5` and `b = 9` `k` times and returns `a - b`, so that the phi edges of the
+/// loop header move two values into each other's registers.
+IrFunction build_swap() noexcept {
+    static constexpr u32 K = 0;
+    static constexpr u32 A = 1;
+    static constexpr u32 B = 2;
+    IrBuilder builder;
+    u32 header_block = builder.create_block();
+    u32 body_block = builder.create_block();
+    u32 exit_block = builder.create_block();
+
+    builder.write_variable(K, builder.parameter());
+    builder.write_variable(A, builder.constant(5));
+    builder.write_variable(B, builder.constant(9));
+    builder.jump(header_block);
+    builder.set_block(header_block);
+    builder.branch(builder.binary(IrOpcode::GT, builder.read_variable(K), builder.constant(0)), body_block, exit_block);
+    builder.seal_block(body_block);
+    builder.set_block(body_block);
+    u32 a = builder.read_variable(A);
+    u32 b = builder.read_variable(B);
+    builder.write_variable(A, b);
+    builder.write_variable(B, a);
+    builder.write_variable(K, builder.binary(IrOpcode::SUB, builder.read_variable(K), builder.constant(1)));
+    builder.jump(header_block);
+    builder.seal_block(header_block);
+    builder.seal_block(exit_block);
+    builder.set_block(exit_block);
+    builder.return_value(builder.binary(IrOpcode::SUB, builder.read_variable(A), builder.read_variable(B)));
+    return builder.finish();
+}
+
+
+/// `six(a, b, c, d, e, f)` returns the decimal digits of its parameters as a number. Each parameter
+/// is added after arithmetic on the previous ones, so every argument register must be preserved.
+IrFunction build_six() noexcept {
+    IrBuilder builder;
+    u32 value = builder.parameter();
+
+    for (u32 i = 0; i < 5; ++i) {
+        value = builder.binary(IrOpcode::ADD, builder.binary(IrOpcode::MUL, value, builder.constant(10)), builder.parameter());
+    }
+
+    builder.return_value(value);
+    return builder.finish();
+}
+
+
+/// `spill(n)` keeps 14 values live across a call of `ext3`, so that some of them are spilled.
+IrFunction build_spill() noexcept {
+    IrBuilder builder;
+    u32 n = builder.parameter();
+    std::vector<u32> values;
+
+    for (i64 i = 1; i <= 14; ++i) {
+        values.push_back(builder.binary(IrOpcode::ADD, builder.binary(IrOpcode::MUL, n, builder.constant(i)), builder.constant(i)));
+    }
+
+    u32 sum = builder.call(EXT3, {values[0], values[1], values[2]});
+
+    for (u32 value : values) {
+        sum = builder.binary(IrOpcode::ADD, sum, value);
+    }
+
+    sum = builder.binary(IrOpcode::DIV, sum, builder.binary(IrOpcode::SHL, builder.constant(1), builder.constant(1)));
+    builder.return_value(builder.binary(IrOpcode::SUB, sum, builder.binary(IrOpcode::REM, n, builder.constant(3))));
+    return builder.finish();
+}
+
+
+int main(int argc, const char *argv[]) {
+    if (argc != 2) {
+        printf("Usage: x64_emit OBJECT\n");
+        return 1;
+    }
+
+    static constexpr const char *NAMES[] = {"loop_sum", "fib", "swap", "six", "spill", "ext3"};
+    IrFunction functions[] = {build_loop_sum(), build_fib(), build_swap(), build_six(), build_spill()};
+    MjProgram program;
+    MjAssembler assembler(program);
+
+    for (u32 id = 0; id < std::size(NAMES); ++id) {
+        assembler.declare_function(id, StringView(reinterpret_cast<const u8 *>(NAMES[id]), std::strlen(NAMES[id])));
+    }
+
+    for (u32 id = 0; id < std::size(functions); ++id) {
+        assembler.add_function(id, functions[id]);
+    }
+
+    return assembler.assemble(argv[1]).is_failure();
+}
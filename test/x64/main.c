@@ -0,0 +1,77 @@
+#include <stdio.h>
+
+
+// Runs the functions written by `emit.cpp` and compares them with the same functions in C.
+
+
+long loop_sum(long n);
+long fib(long n);
+long swap(long k);
+long six(long a, long b, long c, long d, long e, long f);
+long spill(long n);
+
+
+long ext3(long a, long b, long c) {
+    return a * 100 + b * 10 + c;
+}
+
+
+static long loop_sum_ref(long n) {
+    long sum = 0;
+
+    for (long i = 0; i < n; ++i) {
+        sum += i * i % 7;
+    }
+
+    return sum;
+}
+
+
+static long fib_ref(long n) {
+    return n < 2 ? n : fib_ref(n - 1) + fib_ref(n - 2);
+}
+
+
+static long spill_ref(long n) {
+    long values[14];
+
+    for (long i = 1; i <= 14; ++i) {
+        values[i - 1] = n * i + i;
+    }
+
+    long sum = ext3(values[0], values[1], values[2]);
+
+    for (int i = 0; i < 14; ++i) {
+        sum += values[i];
+    }
+
+    return sum / 2 - n % 3;
+}
+
+
+static int failures = 0;
+
+
+static void check(const char *name, long value, long expected) {
+    if (value != expected) {
+        printf("%s returned %ld, expected %ld\n", name, value, expected);
+        failures += 1;
+    }
+}
+
+
+int main(void) {
+    check("loop_sum(0)", loop_sum(0), 0);
+    check("loop_sum(1000)", loop_sum(1000), loop_sum_ref(1000));
+    check("fib(27)", fib(27), fib_ref(27));
+    check("swap(3)", swap(3), 4);
+    check("swap(4)", swap(4), -4);
+    check("six(6, 5, 4, 3, 2, 1)", six(6, 5, 4, 3, 2, 1), 654321);
+    check("six(1, 0, 9, 0, 8, 0)", six(1, 0, 9, 0, 8, 0), 109080);
+
+    for (long n = -7; n <= 7; ++n) {
+        check("spill(n)", spill(n), spill_ref(n));
+    }
+
+    return failures != 0;
+}